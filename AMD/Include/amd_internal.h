@@ -153,7 +153,7 @@
 
 #include "amd.h"
 
-#if defined (DLONG) || defined (ZLONG)
+#if defined (DLONG) || defined (ZLONG) || defined (SLONG) || defined (CLONG)
 
 #define Int SuiteSparse_long
 #define ID  SuiteSparse_long_id
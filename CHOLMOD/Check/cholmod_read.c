@@ -12,6 +12,10 @@
  * (http://www.nist.gov/MatrixMarket).  The format supported by these routines
  * also allow other formats, where the Matrix Market header is optional.
  *
+ * When the file is a regular file, the triplets of a sparse matrix are read
+ * from a memory map of the file by multiple threads, instead of one line at a
+ * time (see read_triplet_mmap, below).  The result is the same either way.
+ *
  * Although the Matrix Market header is optional, I recommend that users stick
  * with the strict Matrix Market format.  The optional format appears here to
  * support the reading of symmetric matrices stored with just their upper
@@ -149,6 +153,10 @@
 #include <string.h>
 #include <ctype.h>
 
+/* Triplets are read from a memory map of the file, if possible (HAVE_MMAP is
+ * defined in cholmod_internal.h).  Compile with -DNMMAP to always read the
+ * file one line at a time instead. */
+
 /* The MatrixMarket format specificies a maximum line length of 1024 */
 #define MAXLINE 1030
 
@@ -486,6 +494,561 @@ static int read_header	/* returns TRUE if successful, FALSE on error */
 }
 
 
+#ifdef HAVE_MMAP
+
+/* ========================================================================== */
+/* === parse_number ========================================================= */
+/* ========================================================================== */
+
+/* Parse a number starting at p, in the same way as sscanf with "%lg" would.
+ * Returns a pointer to the first character after the number, or NULL if no
+ * number starts at p.  The line ends at eol (it is not null-terminated).
+ *
+ * Decimal numbers with at most 15 significant digits and a power of ten in the
+ * range -22 to 22 are parsed here.  Their value is the product or quotient of
+ * two doubles that are exact, so it is correctly rounded and identical to the
+ * result of strtod (Clinger's fast path).  Anything else (more digits, large
+ * exponents, Inf, NaN, hexadecimal, ...) is passed to strtod.
+ */
+
+static const double exact_power10 [23] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+} ;
+
+static const char *parse_number
+(
+    const char *p,	/* start of the number */
+    const char *eol,	/* end of the line */
+    double *x		/* the number */
+)
+{
+    char buf [MAXLINE+1] ;
+    const char *s, *t ;
+    char *q ;
+    double m ;
+    int neg, eneg, ndigits, nsig, d, e, ex ;
+    size_t len ;
+
+    /* ---------------------------------------------------------------------- */
+    /* sign, integer part, and fraction */
+    /* ---------------------------------------------------------------------- */
+
+    s = p ;
+    neg = FALSE ;
+    if (s < eol && (*s == '-' || *s == '+'))
+    {
+	neg = (*s == '-') ;
+	s++ ;
+    }
+    m = 0 ;
+    e = 0 ;
+    ndigits = 0 ;
+    nsig = 0 ;
+    while (s < eol && isdigit ((unsigned char) *s))
+    {
+	d = (*s++) - '0' ;
+	ndigits++ ;
+	if (nsig > 0 || d > 0)
+	{
+	    /* leading zeros are not significant */
+	    nsig++ ;
+	    m = 10 * m + d ;
+	}
+    }
+    if (s < eol && *s == '.')
+    {
+	s++ ;
+	while (s < eol && isdigit ((unsigned char) *s))
+	{
+	    d = (*s++) - '0' ;
+	    ndigits++ ;
+	    e-- ;
+	    if (nsig > 0 || d > 0)
+	    {
+		nsig++ ;
+		m = 10 * m + d ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* exponent */
+    /* ---------------------------------------------------------------------- */
+
+    if (ndigits > 0 && s < eol && (*s == 'e' || *s == 'E'))
+    {
+	t = s + 1 ;
+	eneg = FALSE ;
+	if (t < eol && (*t == '-' || *t == '+'))
+	{
+	    eneg = (*t == '-') ;
+	    t++ ;
+	}
+	if (t < eol && isdigit ((unsigned char) *t))
+	{
+	    /* the exponent is present; otherwise the number ends at the 'e' */
+	    ex = 0 ;
+	    while (t < eol && isdigit ((unsigned char) *t))
+	    {
+		ex = MIN (10 * ex + ((*t++) - '0'), 100000) ;
+	    }
+	    e += eneg ? (-ex) : ex ;
+	    s = t ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the value if it can be done exactly */
+    /* ---------------------------------------------------------------------- */
+
+    if (ndigits > 0 && nsig <= 15 && !(s < eol && (*s == 'x' || *s == 'X')))
+    {
+	if (nsig == 0)
+	{
+	    /* the number is zero */
+	    *x = neg ? (-0.0) : 0.0 ;
+	    return (s) ;
+	}
+	if (e >= -22 && e <= 22)
+	{
+	    m = (e >= 0) ? (m * exact_power10 [e]) : (m / exact_power10 [-e]) ;
+	    *x = neg ? (-m) : m ;
+	    return (s) ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* use strtod for all other cases */
+    /* ---------------------------------------------------------------------- */
+
+    len = MIN ((size_t) (eol - p), (size_t) MAXLINE) ;
+    memcpy (buf, p, len) ;
+    buf [len] = '\0' ;
+    *x = strtod (buf, &q) ;
+    return ((q == buf) ? NULL : (p + (q - buf))) ;
+}
+
+
+/* ========================================================================== */
+/* === parse_line =========================================================== */
+/* ========================================================================== */
+
+/* Parse up to four numbers from a single line, in the same way as sscanf with
+ * "%lg %lg %lg %lg\n" would.  Returns the number of items found. */
+
+static int parse_line
+(
+    const char *p,	/* start of the line */
+    const char *eol,	/* end of the line (not null-terminated) */
+    double *v		/* size 4, numbers found on the line */
+)
+{
+    int nitems ;
+    for (nitems = 0 ; nitems < 4 ; nitems++)
+    {
+	while (p < eol && isspace ((unsigned char) *p))
+	{
+	    p++ ;
+	}
+	if (p >= eol)
+	{
+	    break ;
+	}
+	p = parse_number (p, eol, &v [nitems]) ;
+	if (p == NULL)
+	{
+	    break ;
+	}
+    }
+    return (nitems) ;
+}
+
+
+/* ========================================================================== */
+/* === is_blank_range ======================================================= */
+/* ========================================================================== */
+
+/* Same as is_blank_line, for a line that is not null-terminated */
+
+static int is_blank_range
+(
+    const char *p,	/* start of the line */
+    const char *eol	/* end of the line */
+)
+{
+    if (p < eol && *p == '%')
+    {
+	/* a comment line */
+	return (TRUE) ;
+    }
+    for ( ; p < eol ; p++)
+    {
+	if (!isspace ((unsigned char) *p))
+	{
+	    /* non-space character */
+	    return (FALSE) ;
+	}
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === next_line ============================================================ */
+/* ========================================================================== */
+
+/* Find the end of the line starting at p, and the start of the next line */
+
+static const char *next_line
+(
+    const char *p,	/* start of the line */
+    const char *end,	/* end of the chunk */
+    const char **eol	/* end of the line (its '\n', or end) */
+)
+{
+    const char *nl = memchr (p, '\n', (size_t) (end - p)) ;
+    if (nl == NULL)
+    {
+	/* last line of the file, with no trailing newline */
+	*eol = end ;
+	return (end) ;
+    }
+    *eol = nl ;
+    return (nl + 1) ;
+}
+
+
+/* ========================================================================== */
+/* === read_triplet_mmap ==================================================== */
+/* ========================================================================== */
+
+/* Read the triplets of a sparse matrix from a memory map of the file f, in
+ * parallel.  The part of the file after the header is split into chunks at
+ * line boundaries.  In the first pass, the data lines (lines that are not
+ * blank or comments) in each chunk are counted.  A cumulative sum of these
+ * counts gives the position in the triplet matrix of the first entry in each
+ * chunk, and the second pass then parses each chunk directly into place.  The
+ * file position of f is left just after the last triplet read, just as it
+ * would be after reading it one line at a time with fgets.
+ *
+ * Returns FALSE if the file cannot be mapped (it is not a regular file, for
+ * example); the caller must then read it with fgets and sscanf.  Otherwise,
+ * returns TRUE, with the new triplet matrix in *Thandle (NULL on error).
+ */
+
+typedef struct
+{
+    const char *start ;	/* first character of the chunk */
+    const char *end ;	/* one past the last character of the chunk */
+    const char *last ;	/* start of the line after the last triplet read */
+    Int k ;		/* position of first triplet of the chunk in T */
+    Int nlines ;	/* # of data lines in the chunk */
+    Int imax ;		/* largest row index in the chunk */
+    Int jmax ;		/* largest column index in the chunk */
+    int is_lower ;	/* TRUE if no entry in the chunk is in triu(A,1) */
+    int is_upper ;	/* TRUE if no entry in the chunk is in tril(A,-1) */
+    int one_based ;	/* FALSE if a zero index appears in the chunk */
+    int ok ;		/* FALSE if the chunk has an invalid line */
+} read_chunk ;
+
+static int read_triplet_mmap
+(
+    /* ---- input ---- */
+    FILE *f,		/* file to read from, must already be open */
+    size_t nrow,	/* number of rows */
+    size_t ncol,	/* number of columns */
+    size_t nnz,		/* number of triplets in file to read */
+    size_t nnz2,	/* space to allocate in T */
+    int stype,		/* stype of T */
+    /* ---- output --- */
+    cholmod_triplet **Thandle,	/* the triplet matrix, NULL on error */
+    Int *p_xtype,	/* xtype of the file (CHOLMOD_PATTERN if no values) */
+    Int *p_is_lower,	/* TRUE if all entries in tril(A) */
+    Int *p_is_upper,	/* TRUE if all entries in triu(A) */
+    Int *p_one_based,	/* TRUE if no zero indices */
+    Int *p_imax,	/* largest row index */
+    Int *p_jmax,	/* largest column index */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    double v [4] ;
+    double x, z ;
+    struct stat st ;
+    cholmod_triplet *T ;
+    read_chunk *Chunk ;
+    const char *base, *data, *end, *p, *eol, *next ;
+    double *Tx ;
+    Int *Ti, *Tj ;
+    Int c, nchunks, nitems, nshould, xtype, ntotal, k, i, j ;
+    off_t pos ;
+    size_t len, filesize ;
+    void *map ;
+    int fd, nthreads, ok ;
+
+    *Thandle = NULL ;
+
+    /* ---------------------------------------------------------------------- */
+    /* map the file, if possible */
+    /* ---------------------------------------------------------------------- */
+
+    fd = fileno (f) ;
+    pos = ftello (f) ;
+    if (fd < 0 || pos < 0 || fstat (fd, &st) != 0 || !S_ISREG (st.st_mode)
+	|| st.st_size <= pos)
+    {
+	/* not a regular file, or nothing left to read: use fgets instead */
+	return (FALSE) ;
+    }
+    filesize = (size_t) st.st_size ;
+    map = mmap (NULL, filesize, PROT_READ, MAP_PRIVATE, fd, 0) ;
+    if (map == MAP_FAILED)
+    {
+	return (FALSE) ;
+    }
+#ifdef MADV_SEQUENTIAL
+    (void) madvise (map, filesize, MADV_SEQUENTIAL) ;
+#endif
+    base = (const char *) map ;
+    data = base + pos ;
+    end = base + filesize ;
+    len = (size_t) (end - data) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the first data line and determine the xtype */
+    /* ---------------------------------------------------------------------- */
+
+    for (p = data ; p < end ; p = next)
+    {
+	next = next_line (p, end, &eol) ;
+	if (!is_blank_range (p, eol))
+	{
+	    break ;
+	}
+    }
+    if (p >= end)
+    {
+	/* premature end of file - no triplets in the file */
+	munmap (map, filesize) ;
+	ERROR (CHOLMOD_INVALID, "premature EOF") ;
+	return (TRUE) ;
+    }
+    nshould = parse_line (p, eol, v) ;
+    if (nshould < 2)
+    {
+	/* invalid matrix */
+	munmap (map, filesize) ;
+	ERROR (CHOLMOD_INVALID, "invalid format") ;
+	return (TRUE) ;
+    }
+    /* nshould cannot exceed 4 */
+    xtype = (nshould == 2) ? CHOLMOD_PATTERN :
+	    ((nshould == 3) ? CHOLMOD_REAL : CHOLMOD_COMPLEX) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the triplet matrix and the chunks */
+    /* ---------------------------------------------------------------------- */
+
+    nthreads = CHOLMOD(nthreads) ((double) len, Common) ;
+    nchunks = (nthreads == 1) ? 1 : (4 * nthreads) ;
+
+    T = CHOLMOD(allocate_triplet) (nrow, ncol, nnz2, stype,
+	    (xtype == CHOLMOD_PATTERN ? CHOLMOD_REAL : xtype), Common) ;
+    Chunk = CHOLMOD(malloc) (nchunks, sizeof (read_chunk), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free_triplet) (&T, Common) ;
+	CHOLMOD(free) (nchunks, sizeof (read_chunk), Chunk, Common) ;
+	munmap (map, filesize) ;
+	return (TRUE) ;
+    }
+    Ti = T->i ;
+    Tj = T->j ;
+    Tx = T->x ;
+    T->nnz = nnz ;
+
+    /* ---------------------------------------------------------------------- */
+    /* split the data into chunks at line boundaries */
+    /* ---------------------------------------------------------------------- */
+
+    p = data ;
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	Chunk [c].start = p ;
+	if (c == nchunks - 1)
+	{
+	    p = end ;
+	}
+	else
+	{
+	    next = data + (size_t) (((double) len * (c+1)) / nchunks) ;
+	    if (next > p)
+	    {
+		p = next_line (next, end, &eol) ;
+	    }
+	}
+	Chunk [c].end = p ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* pass 1: count the data lines in each chunk */
+    /* ---------------------------------------------------------------------- */
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+	private (p, eol, next)
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	Int nlines = 0 ;
+	for (p = Chunk [c].start ; p < Chunk [c].end ; p = next)
+	{
+	    next = next_line (p, Chunk [c].end, &eol) ;
+	    if (!is_blank_range (p, eol))
+	    {
+		nlines++ ;
+	    }
+	}
+	Chunk [c].nlines = nlines ;
+    }
+
+    ntotal = 0 ;
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	Chunk [c].k = ntotal ;
+	ntotal += Chunk [c].nlines ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* pass 2: parse the first nnz data lines, in place */
+    /* ---------------------------------------------------------------------- */
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+	private (p, eol, next, v, x, z, nitems, k, i, j)
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	read_chunk *Ch = &Chunk [c] ;
+	Ch->last = NULL ;
+	Ch->imax = 0 ;
+	Ch->jmax = 0 ;
+	Ch->is_lower = TRUE ;
+	Ch->is_upper = TRUE ;
+	Ch->one_based = TRUE ;
+	Ch->ok = TRUE ;
+	k = Ch->k ;
+	for (p = Ch->start ; p < Ch->end && k < (Int) nnz ; p = next)
+	{
+	    next = next_line (p, Ch->end, &eol) ;
+	    if (is_blank_range (p, eol))
+	    {
+		/* blank line or comment */
+		continue ;
+	    }
+	    v [0] = EMPTY ;
+	    v [1] = EMPTY ;
+	    v [2] = 0 ;
+	    v [3] = 0 ;
+	    nitems = parse_line (p, eol, v) ;
+	    i = v [0] ;
+	    j = v [1] ;
+	    x = fix_inf (v [2]) ;
+	    z = fix_inf (v [3]) ;
+	    if (nitems != nshould || i < 0 || j < 0)
+	    {
+		/* wrong format or negative indices */
+		Ch->ok = FALSE ;
+		break ;
+	    }
+	    Ti [k] = i ;
+	    Tj [k] = j ;
+	    if (i < j)
+	    {
+		/* this entry is in the upper triangular part */
+		Ch->is_lower = FALSE ;
+	    }
+	    if (i > j)
+	    {
+		/* this entry is in the lower triangular part */
+		Ch->is_upper = FALSE ;
+	    }
+	    if (xtype == CHOLMOD_REAL)
+	    {
+		Tx [k] = x ;
+	    }
+	    else if (xtype == CHOLMOD_COMPLEX)
+	    {
+		Tx [2*k  ] = x ;	/* real part */
+		Tx [2*k+1] = z ;	/* imaginary part */
+	    }
+	    if (i == 0 || j == 0)
+	    {
+		Ch->one_based = FALSE ;
+	    }
+	    Ch->imax = MAX (i, Ch->imax) ;
+	    Ch->jmax = MAX (j, Ch->jmax) ;
+	    k++ ;
+	    Ch->last = next ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* combine the results from each chunk */
+    /* ---------------------------------------------------------------------- */
+
+    ok = TRUE ;
+    *p_xtype = xtype ;
+    *p_is_lower = TRUE ;
+    *p_is_upper = TRUE ;
+    *p_one_based = TRUE ;
+    *p_imax = 0 ;
+    *p_jmax = 0 ;
+    p = data ;
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	if (Chunk [c].k >= (Int) nnz)
+	{
+	    /* this chunk and all that follow are past the last triplet */
+	    break ;
+	}
+	ok = ok && Chunk [c].ok ;
+	*p_is_lower = *p_is_lower && Chunk [c].is_lower ;
+	*p_is_upper = *p_is_upper && Chunk [c].is_upper ;
+	*p_one_based = *p_one_based && Chunk [c].one_based ;
+	*p_imax = MAX (*p_imax, Chunk [c].imax) ;
+	*p_jmax = MAX (*p_jmax, Chunk [c].jmax) ;
+	if (Chunk [c].last != NULL)
+	{
+	    p = Chunk [c].last ;
+	}
+    }
+
+    CHOLMOD(free) (nchunks, sizeof (read_chunk), Chunk, Common) ;
+    munmap (map, filesize) ;
+
+    if (!ok)
+    {
+	/* wrong format or negative indices */
+	CHOLMOD(free_triplet) (&T, Common) ;
+	ERROR (CHOLMOD_INVALID, "invalid matrix file") ;
+	return (TRUE) ;
+    }
+    if (ntotal < (Int) nnz)
+    {
+	/* premature end of file - not enough triplets read in */
+	CHOLMOD(free_triplet) (&T, Common) ;
+	ERROR (CHOLMOD_INVALID, "premature EOF") ;
+	return (TRUE) ;
+    }
+
+    /* leave the file just after the last triplet, as fgets would */
+    (void) fseeko (f, pos + (off_t) (p - data), SEEK_SET) ;
+    *Thandle = T ;
+    return (TRUE) ;
+}
+#endif
+
+
 /* ========================================================================== */
 /* === read_triplet ========================================================= */
 /* ========================================================================== */
@@ -514,7 +1077,7 @@ static cholmod_triplet *read_triplet
     cholmod_triplet *T ;
     double l1, l2 ;
     Int nitems, xtype, unknown, k, nshould, is_lower, is_upper, one_based, i, j,
-	imax, jmax, skew_symmetric, p, complex_symmetric ;
+	imax, jmax, skew_symmetric, p, complex_symmetric, nread ;
     size_t s, nnz2, extra ;
     int ok = TRUE ;
 
@@ -582,8 +1145,26 @@ static cholmod_triplet *read_triplet
     Tj = NULL ;
     xtype = 999 ;
     nshould = 0 ;
+    nread = 0 ;
+
+#ifdef HAVE_MMAP
+    if (read_triplet_mmap (f, nrow, ncol, nnz, nnz2, stype, &T, &xtype,
+	&is_lower, &is_upper, &one_based, &imax, &jmax, Common))
+    {
+	/* all triplets have been read from a memory map of the file */
+	if (T == NULL)
+	{
+	    /* invalid file, or out of memory */
+	    return (NULL) ;
+	}
+	Ti = T->i ;
+	Tj = T->j ;
+	Tx = T->x ;
+	nread = nnz ;
+    }
+#endif
 
-    for (k = 0 ; k < (Int) nnz ; k++)
+    for (k = nread ; k < (Int) nnz ; k++)
     {
 
 	/* ------------------------------------------------------------------ */
@@ -0,0 +1,595 @@
+/* ========================================================================== */
+/* === Check/cholmod_save =================================================== */
+/* ========================================================================== */
+
+/* Save a factor to a binary file, and load it back.
+ *
+ * cholmod_save_factor writes a symbolic or numeric factor L (simplicial or
+ * supernodal) to a file, and cholmod_load_factor reads it back, so that an
+ * application can restart without repeating the analysis and factorization.
+ *
+ * The file is laid out so that the arrays of L can be used directly from a
+ * memory map of the file.  On POSIX systems (unless compiled with -DNMMAP),
+ * cholmod_load_factor maps the file into memory (copy-on-write) and returns a
+ * factor whose arrays point into the map.  Loading is then nearly
+ * instantaneous, pages are brought in only when used, and processes that load
+ * the same file share the same pages of the operating system's page cache.
+ * Otherwise, or if the file cannot be mapped, the arrays are read into space
+ * obtained from cholmod_malloc.  In both cases the factor is freed with
+ * cholmod_free_factor as usual, and it can be used in any CHOLMOD routine.  A
+ * routine that would free or reallocate part of a memory-mapped factor first
+ * copies it into malloc'd space (see cholmod_unmap_factor).
+ *
+ * File format (version 1).  All integers are SuiteSparse_long, in the byte
+ * order of the machine that wrote the file:
+ *
+ *	"CHOLMODF"	8-byte magic string
+ *	H [0..63]	header (see the H_* definitions below)
+ *	arrays		Perm, ColCount, p, i, nz, next, prev, pi, px, super, s,
+ *			x, and z, in that order.  Arrays that are not present
+ *			in L are not written.  Each array starts at an offset
+ *			(from the start of the magic string) that is a
+ *			multiple of 64 bytes, given in the header.
+ *
+ * The integer arrays are stored in the integer type of L (int for
+ * cholmod_save_factor, SuiteSparse_long for cholmod_l_save_factor), and a file
+ * can only be loaded with the matching cholmod_load_factor or
+ * cholmod_l_load_factor.  The file need not start at the beginning of f; on
+ * output, f is positioned just after the factor.
+ *
+ * The header and array sizes are checked when the factor is loaded, but the
+ * contents of the arrays are not (that would require reading every page of
+ * the file).  Use cholmod_check_factor if the file is not trusted.
+ *
+ * The file must be opened in binary mode ("wb" and "rb").  L->IPerm is not
+ * saved (it is recreated by cholmod_solve2 as needed).
+ */
+
+#ifndef NCHECK
+
+#include "cholmod_internal.h"
+#include "cholmod_check.h"
+#include <string.h>
+
+#define MAGIC "CHOLMODF"
+#define MAGIC_LEN 8
+#define VERSION 1
+#define BYTE_ORDER_MARK 0x01020304
+
+/* file positions beyond 2GB, where available */
+#ifdef HAVE_MMAP
+#define FILE_OFFSET off_t
+#define FTELL ftello
+#define FSEEK fseeko
+#else
+#define FILE_OFFSET long
+#define FTELL ftell
+#define FSEEK fseek
+#endif
+
+/* alignment of each array in the file, in bytes */
+#define ALIGNMENT 64
+
+/* contents of the header */
+#define H_VERSION 0		/* VERSION */
+#define H_BYTE_ORDER 1		/* BYTE_ORDER_MARK */
+#define H_INT_SIZE 2		/* sizeof (Int) */
+#define H_DOUBLE_SIZE 3		/* sizeof (double) */
+#define H_N 4			/* L->n */
+#define H_MINOR 5		/* L->minor */
+#define H_ORDERING 6		/* L->ordering */
+#define H_IS_LL 7		/* L->is_ll */
+#define H_IS_SUPER 8		/* L->is_super */
+#define H_IS_MONOTONIC 9	/* L->is_monotonic */
+#define H_XTYPE 10		/* L->xtype */
+#define H_NZMAX 11		/* L->nzmax */
+#define H_NSUPER 12		/* L->nsuper */
+#define H_SSIZE 13		/* L->ssize */
+#define H_XSIZE 14		/* L->xsize */
+#define H_MAXCSIZE 15		/* L->maxcsize */
+#define H_MAXESIZE 16		/* L->maxesize */
+#define H_TOTAL 17		/* total size of the saved factor, in bytes */
+#define H_IS_INCOMPLETE 18	/* L->is_incomplete */
+#define H_OFFSET 24		/* H [H_OFFSET+k]: offset of kth array, or 0 */
+#define HEADER_LEN 64
+
+/* the arrays of L, in the order they appear in the file */
+#define PERM 0
+#define COLCOUNT 1
+#define LP 2
+#define LI 3
+#define LNZ 4
+#define LNEXT 5
+#define LPREV 6
+#define LPI 7
+#define LPX 8
+#define LSUPER 9
+#define LS 10
+#define LX 11
+#define LZ 12
+#define NARRAYS 13
+
+
+/* ========================================================================== */
+/* === get_arrays =========================================================== */
+/* ========================================================================== */
+
+/* Return a pointer to each array of L, and the number and size of its entries,
+ * as they are passed to cholmod_malloc and cholmod_free (and thus as they are
+ * freed by cholmod_free_factor).  The sizes are computed from the scalar
+ * fields of L, which may have been read from a file, so the size of each array
+ * in bytes is also checked for integer overflow.  Returns FALSE on overflow.
+ */
+
+static int get_arrays
+(
+    cholmod_factor *L,
+    void **Item [ ],	    /* size NARRAYS, Item [k] is the kth array of L */
+    size_t Count [ ],	    /* size NARRAYS, # of entries in kth array */
+    size_t Esize [ ],	    /* size NARRAYS, size of each entry of kth array */
+    size_t Bytes [ ]	    /* size NARRAYS, size of kth array in bytes */
+)
+{
+    size_t n, s, xs ;
+    int k, ok = TRUE ;
+
+    n = L->n ;
+    s = L->nsuper + 1 ;
+    xs = (L->is_super) ? L->xsize : L->nzmax ;
+
+    Item [PERM]     = &(L->Perm) ;	Count [PERM]     = n ;
+    Item [COLCOUNT] = &(L->ColCount) ;	Count [COLCOUNT] = n ;
+    Item [LP]       = &(L->p) ;		Count [LP]       = n+1 ;
+    Item [LI]       = &(L->i) ;		Count [LI]       = L->nzmax ;
+    Item [LNZ]      = &(L->nz) ;	Count [LNZ]      = n ;
+    Item [LNEXT]    = &(L->next) ;	Count [LNEXT]    = n+2 ;
+    Item [LPREV]    = &(L->prev) ;	Count [LPREV]    = n+2 ;
+    Item [LPI]      = &(L->pi) ;	Count [LPI]      = s ;
+    Item [LPX]      = &(L->px) ;	Count [LPX]      = s ;
+    Item [LSUPER]   = &(L->super) ;	Count [LSUPER]   = s ;
+    Item [LS]       = &(L->s) ;		Count [LS]       = L->ssize ;
+    Item [LX]       = &(L->x) ;		Count [LX]       = xs ;
+    Item [LZ]       = &(L->z) ;		Count [LZ]       = xs ;
+
+    for (k = 0 ; k < NARRAYS ; k++)
+    {
+	Esize [k] = sizeof (Int) ;
+    }
+    Esize [LX] = ((L->xtype == CHOLMOD_COMPLEX) ? 2 : 1) * sizeof (double) ;
+    Esize [LZ] = sizeof (double) ;
+
+    for (k = 0 ; k < NARRAYS ; k++)
+    {
+	Bytes [k] = CHOLMOD(mult_size_t) (Count [k], Esize [k], &ok) ;
+    }
+    return (ok) ;
+}
+
+
+/* ========================================================================== */
+/* === required ============================================================= */
+/* ========================================================================== */
+
+/* Return TRUE if the kth array must be present in a factor of this type */
+
+static int required
+(
+    int k,
+    cholmod_factor *L
+)
+{
+    switch (k)
+    {
+	case PERM:
+	case COLCOUNT:
+	    return (TRUE) ;
+
+	case LP:
+	case LI:
+	case LNZ:
+	case LNEXT:
+	case LPREV:
+	    return (!(L->is_super) && L->xtype != CHOLMOD_PATTERN) ;
+
+	case LPI:
+	case LPX:
+	case LSUPER:
+	case LS:
+	    return (L->is_super) ;
+
+	case LX:
+	    return (L->xtype != CHOLMOD_PATTERN) ;
+
+	case LZ:
+	    return (L->xtype == CHOLMOD_ZOMPLEX) ;
+    }
+    return (FALSE) ;
+}
+
+
+/* ========================================================================== */
+/* === round_up ============================================================= */
+/* ========================================================================== */
+
+static size_t round_up (size_t s, int *ok)
+{
+    size_t t = CHOLMOD(add_size_t) (s, ALIGNMENT - 1, ok) ;
+    return (t - (t % ALIGNMENT)) ;
+}
+
+
+/* ========================================================================== */
+/* === write_padding ======================================================== */
+/* ========================================================================== */
+
+/* write zero bytes to the file until position reaches the given offset */
+
+static int write_padding
+(
+    FILE *f,
+    size_t position,
+    size_t offset
+)
+{
+    char zeros [ALIGNMENT] ;
+    memset (zeros, 0, ALIGNMENT) ;
+    return (offset - position < ALIGNMENT &&
+	fwrite (zeros, 1, offset - position, f) == offset - position) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_save_factor ================================================== */
+/* ========================================================================== */
+
+/* Write a factor to a binary file.  Returns TRUE if successful, FALSE
+ * otherwise.  L is not modified.
+ *
+ * workspace: none
+ */
+
+int CHOLMOD(save_factor)
+(
+    /* ---- input ---- */
+    FILE *f,		/* file to write to, must already be open */
+    cholmod_factor *L,	/* factor to write */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    SuiteSparse_long H [HEADER_LEN] ;
+    void **Item [NARRAYS] ;
+    size_t Count [NARRAYS], Esize [NARRAYS], Bytes [NARRAYS] ;
+    size_t position ;
+    int k, ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (f, FALSE) ;
+    RETURN_IF_NULL (L, FALSE) ;
+    RETURN_IF_XTYPE_INVALID (L, CHOLMOD_PATTERN, CHOLMOD_ZOMPLEX, FALSE) ;
+    if (L->itype != ITYPE || L->dtype != DTYPE)
+    {
+	ERROR (CHOLMOD_INVALID, "integer or numeric type of L invalid") ;
+	return (FALSE) ;
+    }
+    Common->status = CHOLMOD_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the header */
+    /* ---------------------------------------------------------------------- */
+
+    memset (H, 0, HEADER_LEN * sizeof (SuiteSparse_long)) ;
+    H [H_VERSION]      = VERSION ;
+    H [H_BYTE_ORDER]   = BYTE_ORDER_MARK ;
+    H [H_INT_SIZE]     = sizeof (Int) ;
+    H [H_DOUBLE_SIZE]  = sizeof (double) ;
+    H [H_N]            = L->n ;
+    H [H_MINOR]        = L->minor ;
+    H [H_ORDERING]     = L->ordering ;
+    H [H_IS_LL]        = L->is_ll ;
+    H [H_IS_SUPER]     = L->is_super ;
+    H [H_IS_MONOTONIC] = L->is_monotonic ;
+    H [H_XTYPE]        = L->xtype ;
+    H [H_NZMAX]        = L->nzmax ;
+    H [H_NSUPER]       = L->nsuper ;
+    H [H_SSIZE]        = L->ssize ;
+    H [H_XSIZE]        = L->xsize ;
+    H [H_MAXCSIZE]     = L->maxcsize ;
+    H [H_MAXESIZE]     = L->maxesize ;
+    H [H_IS_INCOMPLETE] = L->is_incomplete ;
+
+    /* find the offset of each array in the file */
+    ok = get_arrays (L, Item, Count, Esize, Bytes) ;
+    position = MAGIC_LEN + HEADER_LEN * sizeof (SuiteSparse_long) ;
+    for (k = 0 ; k < NARRAYS ; k++)
+    {
+	if (*(Item [k]) != NULL && required (k, L))
+	{
+	    position = round_up (position, &ok) ;
+	    H [H_OFFSET + k] = position ;
+	    position = CHOLMOD(add_size_t) (position, Bytes [k], &ok) ;
+	}
+	else if (required (k, L))
+	{
+	    ERROR (CHOLMOD_INVALID, "L invalid") ;
+	    return (FALSE) ;
+	}
+    }
+    H [H_TOTAL] = round_up (position, &ok) ;
+    if (!ok)
+    {
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+	return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write the header and each array */
+    /* ---------------------------------------------------------------------- */
+
+    ok = (fwrite (MAGIC, 1, MAGIC_LEN, f) == MAGIC_LEN) ;
+    ok = ok && (fwrite (H, sizeof (SuiteSparse_long), HEADER_LEN, f)
+	== HEADER_LEN) ;
+    position = MAGIC_LEN + HEADER_LEN * sizeof (SuiteSparse_long) ;
+    for (k = 0 ; ok && k < NARRAYS ; k++)
+    {
+	if (H [H_OFFSET + k] != 0)
+	{
+	    ok = write_padding (f, position, H [H_OFFSET + k]) ;
+	    ok = ok && (fwrite (*(Item [k]), 1, Bytes [k], f) == Bytes [k]) ;
+	    position = H [H_OFFSET + k] + Bytes [k] ;
+	}
+    }
+    ok = ok && write_padding (f, position, H [H_TOTAL]) ;
+
+    if (!ok)
+    {
+	ERROR (CHOLMOD_INVALID, "error writing file") ;
+	return (FALSE) ;
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === map_factor =========================================================== */
+/* ========================================================================== */
+
+/* Map the saved factor (total bytes starting at position start in f) into
+ * memory, and point the arrays of L into the map.  Returns FALSE if the file
+ * cannot be mapped, in which case L is not modified. */
+
+#ifdef HAVE_MMAP
+static int map_factor
+(
+    FILE *f,
+    size_t start,
+    size_t total,
+    SuiteSparse_long H [ ],
+    void **Item [ ],
+    cholmod_factor *L,
+    cholmod_common *Common
+)
+{
+    struct stat st ;
+    char *base ;
+    size_t offset, page, len ;
+    int fd, k ;
+
+    fd = fileno (f) ;
+    page = (size_t) sysconf (_SC_PAGESIZE) ;
+    if (fd < 0 || start % ALIGNMENT != 0 || page == 0 || page % ALIGNMENT != 0
+	|| fstat (fd, &st) != 0 || !S_ISREG (st.st_mode)
+	|| (size_t) st.st_size < start + total)
+    {
+	/* not a regular file, or the file is too short, or the arrays would
+	 * not be properly aligned in memory */
+	return (FALSE) ;
+    }
+
+    /* the map must start on a page boundary */
+    offset = start - (start % page) ;
+    len = total + (start - offset) ;
+    base = mmap (NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+	(off_t) offset) ;
+    if (base == MAP_FAILED)
+    {
+	return (FALSE) ;
+    }
+
+    /* Perm and ColCount were allocated by cholmod_allocate_factor */
+    L->Perm = CHOLMOD(free) (L->n, sizeof (Int), L->Perm, Common) ;
+    L->ColCount = CHOLMOD(free) (L->n, sizeof (Int), L->ColCount, Common) ;
+
+    L->mmap_base = base ;
+    L->mmap_size = len ;
+    base += (start - offset) ;
+    for (k = 0 ; k < NARRAYS ; k++)
+    {
+	if (H [H_OFFSET + k] != 0)
+	{
+	    *(Item [k]) = base + H [H_OFFSET + k] ;
+	}
+    }
+    return (TRUE) ;
+}
+#endif
+
+
+/* ========================================================================== */
+/* === cholmod_load_factor ================================================== */
+/* ========================================================================== */
+
+/* Read a factor written by cholmod_save_factor.  Returns the factor if
+ * successful, or NULL otherwise.
+ *
+ * workspace: none
+ */
+
+cholmod_factor *CHOLMOD(load_factor)
+(
+    /* ---- input ---- */
+    FILE *f,		/* file to read from, must already be open */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    char magic [MAGIC_LEN] ;
+    SuiteSparse_long H [HEADER_LEN] ;
+    void **Item [NARRAYS] ;
+    size_t Count [NARRAYS], Esize [NARRAYS], Bytes [NARRAYS] ;
+    size_t start, total, hsize, offset ;
+    cholmod_factor *L ;
+    int k, ok = TRUE, mapped = FALSE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (f, NULL) ;
+    Common->status = CHOLMOD_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* read and check the header */
+    /* ---------------------------------------------------------------------- */
+
+    start = (size_t) FTELL (f) ;
+    hsize = MAGIC_LEN + HEADER_LEN * sizeof (SuiteSparse_long) ;
+    if (fread (magic, 1, MAGIC_LEN, f) != MAGIC_LEN ||
+	strncmp (magic, MAGIC, MAGIC_LEN) != 0 ||
+	fread (H, sizeof (SuiteSparse_long), HEADER_LEN, f) != HEADER_LEN)
+    {
+	ERROR (CHOLMOD_INVALID, "invalid factor file") ;
+	return (NULL) ;
+    }
+    if (H [H_VERSION] < 1 || H [H_VERSION] > VERSION)
+    {
+	ERROR (CHOLMOD_INVALID, "unsupported factor file version") ;
+	return (NULL) ;
+    }
+    if (H [H_BYTE_ORDER] != BYTE_ORDER_MARK || H [H_INT_SIZE] != sizeof (Int)
+	|| H [H_DOUBLE_SIZE] != sizeof (double))
+    {
+	ERROR (CHOLMOD_INVALID, "factor file has wrong byte order or type") ;
+	return (NULL) ;
+    }
+    if (H [H_N] < 0 || H [H_N] > Int_max || H [H_NZMAX] < 0
+	|| H [H_NSUPER] < 0 || H [H_NSUPER] > H [H_N] || H [H_SSIZE] < 0
+	|| H [H_XSIZE] < 0 || H [H_MAXCSIZE] < 0 || H [H_MAXESIZE] < 0
+	|| H [H_MINOR] < 0 || H [H_MINOR] > H [H_N]
+	|| H [H_XTYPE] < CHOLMOD_PATTERN || H [H_XTYPE] > CHOLMOD_ZOMPLEX
+	|| (H [H_IS_SUPER] && H [H_XTYPE] == CHOLMOD_ZOMPLEX)
+	|| H [H_TOTAL] < (SuiteSparse_long) hsize)
+    {
+	ERROR (CHOLMOD_INVALID, "invalid factor file") ;
+	return (NULL) ;
+    }
+    total = H [H_TOTAL] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate a simplicial symbolic factor, and fill in its scalar fields */
+    /* ---------------------------------------------------------------------- */
+
+    L = CHOLMOD(allocate_factor) (H [H_N], Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	return (NULL) ;	    /* out of memory */
+    }
+    L->minor        = H [H_MINOR] ;
+    L->ordering     = (int) H [H_ORDERING] ;
+    L->is_ll        = (H [H_IS_LL] != 0) ;
+    L->is_super     = (H [H_IS_SUPER] != 0) ;
+    L->is_monotonic = (H [H_IS_MONOTONIC] != 0) ;
+    L->xtype        = (int) H [H_XTYPE] ;
+    L->nzmax        = H [H_NZMAX] ;
+    L->nsuper       = H [H_NSUPER] ;
+    L->ssize        = H [H_SSIZE] ;
+    L->xsize        = H [H_XSIZE] ;
+    L->maxcsize     = H [H_MAXCSIZE] ;
+    L->maxesize     = H [H_MAXESIZE] ;
+    L->is_incomplete = (H [H_IS_INCOMPLETE] != 0) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check the location and size of each array */
+    /* ---------------------------------------------------------------------- */
+
+    ok = get_arrays (L, Item, Count, Esize, Bytes) ;
+    for (k = 0 ; ok && k < NARRAYS ; k++)
+    {
+	offset = H [H_OFFSET + k] ;
+	if (offset == 0)
+	{
+	    ok = !required (k, L) ;
+	}
+	else
+	{
+	    ok = required (k, L) && offset >= hsize && offset % ALIGNMENT == 0
+		&& offset <= total && Bytes [k] <= total - offset ;
+	}
+    }
+    if (!ok)
+    {
+	CHOLMOD(free_factor) (&L, Common) ;
+	ERROR (CHOLMOD_INVALID, "invalid factor file") ;
+	return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* map the arrays into memory, if possible */
+    /* ---------------------------------------------------------------------- */
+
+#ifdef HAVE_MMAP
+    mapped = map_factor (f, start, total, H, Item, L, Common) ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* otherwise, read each array into malloc'd space */
+    /* ---------------------------------------------------------------------- */
+
+    if (!mapped)
+    {
+	for (k = 0 ; k < NARRAYS ; k++)
+	{
+	    if (H [H_OFFSET + k] != 0 && k != PERM && k != COLCOUNT)
+	    {
+		/* Perm and ColCount are already allocated */
+		*(Item [k]) = CHOLMOD(malloc) (Count [k], Esize [k], Common) ;
+	    }
+	}
+	ok = (Common->status == CHOLMOD_OK) ;
+	for (k = 0 ; ok && k < NARRAYS ; k++)
+	{
+	    if (H [H_OFFSET + k] != 0)
+	    {
+		ok = (FSEEK (f, (FILE_OFFSET) (start + H [H_OFFSET + k]),
+		    SEEK_SET) == 0) &&
+		    (fread (*(Item [k]), 1, Bytes [k], f) == Bytes [k]) ;
+	    }
+	}
+	if (!ok)
+	{
+	    CHOLMOD(free_factor) (&L, Common) ;
+	    if (Common->status == CHOLMOD_OK)
+	    {
+		ERROR (CHOLMOD_INVALID, "error reading file") ;
+	    }
+	    return (NULL) ;
+	}
+    }
+
+    /* position the file just after the factor */
+    if (FSEEK (f, (FILE_OFFSET) (start + total), SEEK_SET) != 0)
+    {
+	CHOLMOD(free_factor) (&L, Common) ;
+	ERROR (CHOLMOD_INVALID, "error reading file") ;
+	return (NULL) ;
+    }
+
+    DEBUG (CHOLMOD(dump_factor) (L, "loaded", Common)) ;
+    return (L) ;
+}
+#endif
@@ -17,7 +17,11 @@
  * data line.  Ignored if an empty string or not present.
  *
  * Except for the workspace used by cholmod_symmetry (ncol integers) for
- * the sparse case, these routines use no workspace at all.
+ * the sparse case, these routines use no workspace in Common.  If more than
+ * one thread is used, a sparse matrix is written by formatting blocks of at
+ * most BLOCK_TRIPLETS entries each into memory in parallel, and then writing
+ * each block with a single call to fwrite.  The output is identical to what
+ * would be written one entry at a time with fprintf.
  */
 
 #ifndef NCHECK
@@ -32,6 +36,25 @@
 #define MMLEN 1024
 #define MAXLINE MMLEN+6
 
+/* upper bound on the length of a single line holding one triplet (two indices
+ * of at most 20 digits and two values of at most 27 characters each, plus
+ * three spaces and the newline) */
+#define MAXTRIPLET 128
+
+/* maximum number of triplets formatted in each block */
+#define BLOCK_TRIPLETS 16384
+
+/* number of triplets formatted at a time if the blocks cannot be allocated */
+#define SERIAL_TRIPLETS 32
+
+/* a block of triplets to format, starting at A(:,j) and Z(:,j) with entries
+ * p and q, and ending at the start of the next block */
+typedef struct
+{
+    Int j, p, q ;	/* the first column, and positions in A and Z */
+    size_t len ;	/* # of characters written by format_columns */
+} write_block ;
+
 /* ========================================================================== */
 /* === include_comments ===================================================== */
 /* ========================================================================== */
@@ -108,30 +131,31 @@ static void get_value
 
 
 /* ========================================================================== */
-/* === print_value ========================================================== */
+/* === format_value ========================================================= */
 /* ========================================================================== */
 
-/* Print a numeric value to the file, using the shortest format that ensures
- * the value is written precisely.  Returns TRUE if successful, FALSE otherwise.
+/* Format a numeric value into the string s (of size MAXLINE), using the
+ * shortest format that ensures the value is written precisely.  Returns a
+ * pointer to the null-terminated result, which is held in s.
  */ 
 
-static int print_value
+static char *format_value
 (
-    FILE *f,	    /* file to print to */
+    char *s,	    /* string to hold the result */
     double x,	    /* value to print */
     Int is_integer  /* TRUE if printing as an integer */
 )
 {
     double y ;
-    char s [MAXLINE], *p ;
+    char *p ;
     Int i, dest = 0, src = 0 ;
-    int width, ok ;
+    int width ;
 
     if (is_integer)
     {
 	i = (Int) x ;
-	ok = (fprintf (f, ID, i) > 0) ;
-	return (ok) ;
+	sprintf (s, ID, i) ;
+	return (s) ;
     }
 
     /* ---------------------------------------------------------------------- */
@@ -155,7 +179,7 @@ static int print_value
     for (width = 6 ; width < 20 ; width++)
     {
 	sprintf (s, "%.*g", width, x) ;
-	sscanf (s, "%lg", &y) ;
+	y = strtod (s, NULL) ;
 	if (x == y) break ;
     }
 
@@ -221,38 +245,71 @@ static int print_value
 	p = s + 1 ;
     }
 
-#if 0
-    /* double-check */
-    i = sscanf (p, "%lg", &z) ;
-    if (i != 1 || y != z)
-    {
-	/* oops! something went wrong in the "e+0" edit, above. */
-	/* this "cannot" happen */
-	sprintf (s, "%.*g", width, x) ;
-	p = s ;
-    }
-#endif
+    return (p) ;
+}
 
-    /* ---------------------------------------------------------------------- */
-    /* print the value to the file */
-    /* ---------------------------------------------------------------------- */
 
-    ok = (fprintf (f, "%s", p) > 0) ;
-    return (ok) ;
+/* ========================================================================== */
+/* === print_value ========================================================== */
+/* ========================================================================== */
+
+/* Print a numeric value to the file, using the shortest format that ensures
+ * the value is written precisely.  Returns TRUE if successful, FALSE otherwise.
+ */ 
+
+static int print_value
+(
+    FILE *f,	    /* file to print to */
+    double x,	    /* value to print */
+    Int is_integer  /* TRUE if printing as an integer */
+)
+{
+    char s [MAXLINE] ;
+    return (fprintf (f, "%s", format_value (s, x, is_integer)) > 0) ;
 }
 
 
 /* ========================================================================== */
-/* === print_triplet ======================================================== */
+/* === format_index ========================================================= */
 /* ========================================================================== */
 
-/* Print a triplet, converting it to one-based.  Returns TRUE if successful,
- * FALSE otherwise.
+/* Write a non-negative integer into s (not null-terminated), and return the
+ * number of characters written.  Gives the same result as sprintf with ID. */
+
+static size_t format_index
+(
+    char *s,	    /* string to hold the result */
+    Int i	    /* integer to print, must be >= 0 */
+)
+{
+    char t [32] ;
+    size_t n = 0, len = 0 ;
+    do
+    {
+	t [n++] = (char) ('0' + (i % 10)) ;
+	i /= 10 ;
+    }
+    while (i > 0) ;
+    while (n > 0)
+    {
+	s [len++] = t [--n] ;
+    }
+    return (len) ;
+}
+
+
+/* ========================================================================== */
+/* === format_triplet ======================================================= */
+/* ========================================================================== */
+
+/* Format a triplet into s, converting it to one-based.  Returns the number of
+ * characters written (at most MAXTRIPLET), in the same format as print_triplet
+ * would write to a file.  s is not null-terminated.
  */
 
-static int print_triplet
+static size_t format_triplet
 (
-    FILE *f,		/* file to print to */
+    char *s,		/* string to hold the result */
     Int is_binary,	/* TRUE if file is "pattern" */
     Int is_complex,	/* TRUE if file is "complex" */
     Int is_integer,	/* TRUE if file is "integer" */
@@ -262,20 +319,223 @@ static int print_triplet
     double z		/* imaginary part */
 )
 {
-    int ok ; 
-    ok = (fprintf (f, ID " " ID, 1+i, 1+j) > 0) ;
+    char t [MAXLINE], *v ;
+    size_t len, vlen ;
+    len = format_index (s, 1+i) ;
+    s [len++] = ' ' ;
+    len += format_index (s + len, 1+j) ;
     if (!is_binary)
     {
-	fprintf (f, " ") ;
-	ok = ok && print_value (f, x, is_integer) ;
+	s [len++] = ' ' ;
+	v = format_value (t, x, is_integer) ;
+	vlen = strlen (v) ;
+	memcpy (s + len, v, vlen) ;
+	len += vlen ;
 	if (is_complex)
 	{
-	    fprintf (f, " ") ;
-	    ok = ok && print_value (f, z, is_integer) ;
+	    s [len++] = ' ' ;
+	    v = format_value (t, z, is_integer) ;
+	    vlen = strlen (v) ;
+	    memcpy (s + len, v, vlen) ;
+	    len += vlen ;
 	}
     }
-    ok = ok && (fprintf (f, "\n") > 0) ;
-    return (ok) ;
+    s [len++] = '\n' ;
+    return (len) ;
+}
+
+
+/* ========================================================================== */
+/* === format_columns ======================================================= */
+/* ========================================================================== */
+
+/* Format the triplets of A and Z into the string s, starting at entries p1 of
+ * A and q1 of Z in column j1, and stopping just before entries p2 of A and q2
+ * of Z in column j2 (all of A(:,j1:ncol-1) and Z(:,j1:ncol-1) if j2 is ncol).
+ * s must have space for MAXTRIPLET characters for each of those entries.
+ * Returns the number of characters written.
+ */
+
+static size_t format_columns
+(
+    char *s,		/* string to hold the result */
+    Int j1,		/* first column to format */
+    Int p1,		/* first entry of A(:,j1) to format */
+    Int q1,		/* first entry of Z(:,j1) to format */
+    Int j2,		/* last column to format */
+    Int p2,		/* A(:,j2) is formatted up to entry p2-1 */
+    Int q2,		/* Z(:,j2) is formatted up to entry q2-1 */
+    cholmod_sparse *A,	/* matrix to print */
+    cholmod_sparse *Z,	/* optional matrix with pattern of explicit zeros */
+    Int is_sym,		/* TRUE if the file is symmetric (lower part only) */
+    Int asym,		/* symmetry of the file (CHOLMOD_MM_*) */
+    Int is_binary,	/* TRUE if file is "pattern" */
+    Int is_complex,	/* TRUE if file is "complex" */
+    Int is_integer	/* TRUE if file is "integer" */
+)
+{
+    double x = 0, z = 0 ;
+    double *Ax, *Az ;
+    Int *Ap, *Ai, *Anz, *Zp, *Zi, *Znz ;
+    Int nrow, ncol, i, j, q, iz, p, stype, xtype, apacked, zpacked, pend,
+	qend ;
+    size_t len = 0 ;
+
+    Ap = A->p ;
+    Ai = A->i ;
+    Ax = A->x ;
+    Az = A->z ;
+    Anz = A->nz ;
+    nrow = A->nrow ;
+    ncol = A->ncol ;
+    xtype = A->xtype ;
+    apacked = A->packed ;
+    stype = A->stype ;
+    Zp = (Z == NULL) ? NULL : Z->p ;
+    Zi = (Z == NULL) ? NULL : Z->i ;
+    Znz = (Z == NULL) ? NULL : Z->nz ;
+    zpacked = (Z == NULL) ? TRUE : Z->packed ;
+
+    for (j = j1 ; j <= j2 && j < ncol ; j++)
+    {
+	/* merge column of A and Z */
+	p = Ap [j] ;
+	pend = (apacked) ? Ap [j+1] : p + Anz [j] ;
+	q = (Z == NULL) ? 0 : Zp [j] ;
+	qend = (Z == NULL) ? 0 : ((zpacked) ? Zp [j+1] : q + Znz [j]) ;
+	if (j == j1)
+	{
+	    p = p1 ;
+	    q = q1 ;
+	}
+	if (j == j2)
+	{
+	    pend = p2 ;
+	    qend = q2 ;
+	}
+	for ( ; ; )
+	{
+	    /* get the next row index from A and Z */
+	    i  = (p < pend) ? Ai [p] : (nrow+1) ;
+	    iz = (q < qend) ? Zi [q] : (nrow+2) ;
+	    if (i <= iz)
+	    {
+		/* get A(i,j), or quit if both A and Z are exhausted */
+		if (i == nrow+1) break ;
+		get_value (Ax, Az, p, xtype, &x, &z) ;
+		p++ ;
+	    }
+	    else
+	    {
+		/* get Z(i,j) */
+		i = iz ;
+		x = 0 ;
+		z = 0 ;
+		q++ ;
+	    }
+	    if ((stype < 0 && i >= j) || (stype == 0 && (i >= j || !is_sym)))
+	    {
+		/* CHOLMOD matrix is symmetric-lower (and so is the file);
+		 * or CHOLMOD matrix is unsymmetric and either A(i,j) is in
+		 * the lower part or the file is unsymmetric. */
+		len += format_triplet (s + len, is_binary, is_complex,
+		    is_integer, i,j, x,z) ;
+	    }
+	    else if (stype > 0 && i <= j)
+	    {
+		/* CHOLMOD matrix is symmetric-upper, but the file is
+		 * symmetric-lower.  Need to transpose the entry.   If the
+		 * matrix is real, the complex part is ignored.  If the matrix
+		 * is complex, it Hermitian.
+		 */
+		ASSERT (IMPLIES (is_complex, asym == CHOLMOD_MM_HERMITIAN)) ;
+		if (z != 0)
+		{
+		    z = -z ;
+		}
+		len += format_triplet (s + len, is_binary, is_complex,
+		    is_integer, j,i, x,z) ;
+	    }
+	}
+    }
+    return (len) ;
+}
+
+
+/* ========================================================================== */
+/* === next_block =========================================================== */
+/* ========================================================================== */
+
+/* Advance the position j, p, q (entry p of A(:,j) and entry q of Z(:,j)) past
+ * at most nmax triplets of A and Z, in the order format_columns merges them.
+ * A block may start and end in the middle of a column.  On output, j is ncol
+ * if the end of the matrix has been reached. */
+
+static void next_block
+(
+    Int *pj,		/* column of the current position */
+    Int *pp,		/* entry of A(:,j) at the current position */
+    Int *pq,		/* entry of Z(:,j) at the current position */
+    Int nmax,		/* maximum number of triplets to skip */
+    cholmod_sparse *A,
+    cholmod_sparse *Z
+)
+{
+    Int *Ap, *Ai, *Anz, *Zp, *Zi, *Znz ;
+    Int nrow, ncol, apacked, zpacked, i, iz, j, p, q, pend, qend, bnz ;
+
+    Ap = A->p ;
+    Ai = A->i ;
+    Anz = A->nz ;
+    nrow = A->nrow ;
+    ncol = A->ncol ;
+    apacked = A->packed ;
+    Zp = (Z == NULL) ? NULL : Z->p ;
+    Zi = (Z == NULL) ? NULL : Z->i ;
+    Znz = (Z == NULL) ? NULL : Z->nz ;
+    zpacked = (Z == NULL) ? TRUE : Z->packed ;
+    j = *pj ;
+    p = *pp ;
+    q = *pq ;
+
+    for (bnz = 0 ; j < ncol && bnz < nmax ; )
+    {
+	pend = (apacked) ? Ap [j+1] : Ap [j] + Anz [j] ;
+	qend = (Z == NULL) ? 0 : ((zpacked) ? Zp [j+1] : Zp [j] + Znz [j]) ;
+	if (bnz + (pend - p) + (qend - q) <= nmax)
+	{
+	    /* the rest of A(:,j) and Z(:,j) fits in this block */
+	    bnz += (pend - p) + (qend - q) ;
+	    j++ ;
+	    if (j < ncol)
+	    {
+		p = Ap [j] ;
+		q = (Z == NULL) ? 0 : Zp [j] ;
+	    }
+	}
+	else
+	{
+	    /* split the column, merging A and Z as format_columns does,
+	     * until the block is full */
+	    for ( ; bnz < nmax ; bnz++)
+	    {
+		i  = (p < pend) ? Ai [p] : (nrow+1) ;
+		iz = (q < qend) ? Zi [q] : (nrow+2) ;
+		if (i <= iz)
+		{
+		    p++ ;
+		}
+		else
+		{
+		    q++ ;
+		}
+	    }
+	}
+    }
+
+    *pj = j ;
+    *pp = p ;
+    *pq = q ;
 }
 
 
@@ -360,12 +620,17 @@ int CHOLMOD(write_sparse)
     cholmod_common *Common
 )
 {
+    char line [SERIAL_TRIPLETS * MAXTRIPLET] ;
     double x = 0, z = 0 ;
-    double *Ax, *Az ;
-    Int *Ap, *Ai, *Anz, *Zp, *Zi, *Znz ;
-    Int nrow, ncol, is_complex, symmetry, i, j, q, iz, p, nz, is_binary, stype,
-	is_integer, asym, is_sym, xtype, apacked, zpacked, pend, qend, zsym ;
-    int ok ;
+    double *Ax ;
+    Int *Ap, *Anz, *Zp ;
+    Int nrow, ncol, is_complex, symmetry, i, j, p, nz, is_binary, stype,
+	is_integer, asym, is_sym, xtype, apacked, pend, zsym, b, nb, nblocks,
+	q, j1, p1, q1 ;
+    write_block *Block ;
+    size_t len ;
+    char *S ;
+    int ok, nthreads ;
 
     /* ---------------------------------------------------------------------- */
     /* check inputs */
@@ -396,9 +661,7 @@ int CHOLMOD(write_sparse)
     /* ---------------------------------------------------------------------- */
 
     Ap = A->p ;
-    Ai = A->i ;
     Ax = A->x ;
-    Az = A->z ;
     Anz = A->nz ;
     nrow = A->nrow ;
     ncol = A->ncol ;
@@ -451,17 +714,7 @@ int CHOLMOD(write_sparse)
     /* get the Z matrix (only consider the pattern) */
     /* ---------------------------------------------------------------------- */
 
-    Zp = NULL ;
-    Zi = NULL ;
-    Znz = NULL ;
-    zpacked = TRUE ;
-    if (Z != NULL)
-    {
-	Zp = Z->p ;
-	Zi = Z->i ;
-	Znz = Z->nz ;
-	zpacked = Z->packed ;
-    }
+    Zp = (Z == NULL) ? NULL : Z->p ;
 
     /* ---------------------------------------------------------------------- */
     /* determine the symmetry of A and Z */
@@ -577,59 +830,89 @@ int CHOLMOD(write_sparse)
     /* write the first data line, with nrow, ncol, and # of triplets */
     ok = ok && (fprintf (f, ID " " ID " " ID "\n", nrow, ncol, nz) > 0) ;
 
-    for (j = 0 ; ok && j < ncol ; j++)
+    /* The triplets are split into blocks of at most BLOCK_TRIPLETS entries
+     * each, which may start and end in the middle of a column.  In each pass,
+     * up to nthreads blocks are formatted in parallel into the string S, and
+     * then written to the file in order.  The workspace is allocated with
+     * SuiteSparse_malloc, so that if it is not available, the matrix is
+     * written one triplet at a time without reporting an error. */
+    nthreads = CHOLMOD(nthreads) ((double) nz, Common) ;
+    nblocks = nthreads ;
+    Block = NULL ;
+    S = NULL ;
+    if (nthreads > 1)
     {
-	/* merge column of A and Z */
-	p = Ap [j] ;
-	pend = (apacked) ? Ap [j+1] : p + Anz [j] ;
-	q = (Z == NULL) ? 0 : Zp [j] ;
-	qend = (Z == NULL) ? 0 : ((zpacked) ? Zp [j+1] : q + Znz [j]) ;
-	while (ok)
+	Block = SuiteSparse_malloc (nblocks+1, sizeof (write_block)) ;
+	S = SuiteSparse_malloc (nblocks, BLOCK_TRIPLETS * MAXTRIPLET) ;
+    }
+
+    if (Block == NULL || S == NULL)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* write the matrix a few triplets at a time */
+	/* ------------------------------------------------------------------ */
+
+	j = 0 ;
+	p = Ap [0] ;
+	q = (Z == NULL) ? 0 : Zp [0] ;
+	while (ok && j < ncol)
 	{
-	    /* get the next row index from A and Z */
-	    i  = (p < pend) ? Ai [p] : (nrow+1) ;
-	    iz = (q < qend) ? Zi [q] : (nrow+2) ;
-	    if (i <= iz)
-	    {
-		/* get A(i,j), or quit if both A and Z are exhausted */
-		if (i == nrow+1) break ;
-		get_value (Ax, Az, p, xtype, &x, &z) ;
-		p++ ;
-	    }
-	    else
+	    j1 = j ;
+	    p1 = p ;
+	    q1 = q ;
+	    next_block (&j, &p, &q, SERIAL_TRIPLETS, A, Z) ;
+	    len = format_columns (line, j1, p1, q1, j, p, q, A, Z, is_sym,
+		asym, is_binary, is_complex, is_integer) ;
+	    ok = (fwrite (line, sizeof (char), len, f) == len) ;
+	}
+    }
+    else
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* format blocks of triplets in parallel */
+	/* ------------------------------------------------------------------ */
+
+	j = 0 ;
+	p = Ap [0] ;
+	q = (Z == NULL) ? 0 : Zp [0] ;
+	while (ok && j < ncol)
+	{
+
+	    /* find the start of each block */
+	    for (b = 0 ; b < nblocks && j < ncol ; b++)
 	    {
-		/* get Z(i,j) */
-		i = iz ;
-		x = 0 ;
-		z = 0 ;
-		q++ ;
+		Block [b].j = j ;
+		Block [b].p = p ;
+		Block [b].q = q ;
+		next_block (&j, &p, &q, BLOCK_TRIPLETS, A, Z) ;
 	    }
-	    if ((stype < 0 && i >= j) || (stype == 0 && (i >= j || !is_sym)))
+	    Block [b].j = j ;
+	    Block [b].p = p ;
+	    Block [b].q = q ;
+	    nb = b ;
+
+	    /* format each block in parallel, then write them in order */
+	    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+	    for (b = 0 ; b < nb ; b++)
 	    {
-		/* CHOLMOD matrix is symmetric-lower (and so is the file);
-		 * or CHOLMOD matrix is unsymmetric and either A(i,j) is in
-		 * the lower part or the file is unsymmetric. */
-		ok = ok && print_triplet (f, is_binary, is_complex, is_integer,
-		    i,j, x,z) ;
+		Block [b].len = format_columns (S + b * BLOCK_TRIPLETS *
+		    MAXTRIPLET, Block [b].j, Block [b].p, Block [b].q,
+		    Block [b+1].j, Block [b+1].p, Block [b+1].q, A, Z, is_sym,
+		    asym, is_binary, is_complex, is_integer) ;
 	    }
-	    else if (stype > 0 && i <= j)
+	    for (b = 0 ; ok && b < nb ; b++)
 	    {
-		/* CHOLMOD matrix is symmetric-upper, but the file is
-		 * symmetric-lower.  Need to transpose the entry.   If the
-		 * matrix is real, the complex part is ignored.  If the matrix
-		 * is complex, it Hermitian.
-		 */
-		ASSERT (IMPLIES (is_complex, asym == CHOLMOD_MM_HERMITIAN)) ;
-		if (z != 0)
-		{
-		    z = -z ;
-		}
-		ok = ok && print_triplet (f, is_binary, is_complex, is_integer,
-		    j,i, x,z) ;
+		ok = (fwrite (S + b * BLOCK_TRIPLETS * MAXTRIPLET, sizeof (char),
+		    Block [b].len, f) == Block [b].len) ;
 	    }
 	}
     }
 
+    SuiteSparse_free (Block) ;
+    SuiteSparse_free (S) ;
+
     if (!ok)
     {
 	ERROR (CHOLMOD_INVALID, "error reading/writing file") ;
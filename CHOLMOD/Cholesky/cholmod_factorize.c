@@ -138,6 +138,13 @@ int CHOLMOD(factorize_p)
     DEBUG (CHOLMOD(dump_sparse) (A, "A for cholmod_factorize", Common)) ;
     Common->status = CHOLMOD_OK ;
 
+    /* the numerical values of L are replaced, and its arrays may be freed or
+     * reallocated, so L cannot be left in a memory map */
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
+
     /* ---------------------------------------------------------------------- */
     /* allocate workspace */
     /* ---------------------------------------------------------------------- */
@@ -0,0 +1,691 @@
+/* ========================================================================== */
+/* === Cholesky/cholmod_ichol =============================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Cholesky Module.  Copyright (C) 2005-2013, Timothy A. Davis
+ * -------------------------------------------------------------------------- */
+
+/* Incomplete Cholesky factorization of a symmetric positive definite matrix,
+ * for use as a preconditioner.  The inputs are a sparse matrix A and a factor
+ * L from cholmod_analyze (or a prior factorization), which provides the
+ * fill-reducing permutation L->Perm.  An incomplete factorization
+ * L*D*L' ~= A(p,p)+beta*I is computed, where beta is real.  Only the
+ * permutation of L is used; its symbolic pattern and column counts are
+ * discarded, so the space for L is only what the incomplete factor needs.
+ *
+ * Three rules, set in the Common object, control which entries are kept:
+ *
+ *	Common->ichol_level:  an entry with a level of fill greater than this
+ *	    value is dropped.  Entries of A have level 0.  A fill-in entry
+ *	    L(i,k) created by L(i,j) and L(k,j) has level lev(i,j)+lev(k,j)+1.
+ *	    No limit if negative.  The default is 0.
+ *
+ *	Common->ichol_droptol:  L(i,k) is dropped if |L(i,k)| < droptol *
+ *	    norm (A(k:n,k),1), where L(i,k) is scaled as in the LL'
+ *	    factorization.  The default is 0.
+ *
+ *	Common->ichol_maxfill:  column k of L keeps at most nnz (A(k+1:n,k)) +
+ *	    maxfill off-diagonal entries, those largest in magnitude.  No limit
+ *	    if negative.  The default is -1.
+ *
+ * The defaults give IC(0), with L having the same pattern as tril(A(p,p)).
+ * Setting ichol_level to k gives IC(k).  Setting ichol_level to -1 and
+ * ichol_droptol > 0 gives a threshold-based incomplete Cholesky (ICT).  The
+ * diagonal is never dropped, and D(k,k) is computed from only the entries
+ * of L that are kept.  Dropped entries are not used to compute later columns
+ * of L.
+ *
+ * L is computed one column at a time (a left-looking method, which unlike the
+ * up-looking cholmod_rowfac only appends entries to L), and returned as a
+ * simplicial LDL' factor.  It is then converted to the form given by the
+ * Common->final_* parameters, as in cholmod_factorize (a supernodal form is
+ * not possible).  The result can be used by cholmod_solve and cholmod_solve2.
+ *
+ * The pattern of an incomplete factor is not chordal, so L->is_incomplete is
+ * set and cholmod_solve does not look for supernodes in L.  L must not be
+ * passed to cholmod_updown, cholmod_rowadd, cholmod_rowdel, or
+ * cholmod_resymbol, and it must not be passed to cholmod_factorize: use a new
+ * symbolic factor from cholmod_analyze (or from cholmod_copy_factor) for a
+ * complete factorization instead.
+ *
+ * If the incomplete factorization breaks down (D(k,k) <= 0), the routine
+ * returns TRUE, but sets Common->status to CHOLMOD_NOT_POSDEF and L->minor to
+ * k.  Columns L->minor to n-1 of L are then set to zero (with D(k,k) = 0).
+ * Setting beta to a positive value (a diagonal shift) can avoid a breakdown.
+ * So can Common->dbound: as in the LDL' factorization of cholmod_factorize,
+ * |D(k,k)| is then raised to at least dbound, keeping its sign, and a negative
+ * D(k,k) is kept rather than treated as a breakdown.  The LDL' factor is then
+ * indefinite, and converting it to LL' sets L->minor to the first negative
+ * D(k,k) (see cholmod_change_factor).  If L is too large for the available
+ * memory, it is returned as a simplicial symbolic factor.
+ *
+ * workspace: Flag (nrow), Head (nrow+1), Iwork (4*nrow), W (nrow).
+ *	Allocates up to two temporary copies of its input matrix (including
+ *	both pattern and numerical values).
+ *
+ * A must be real and symmetric (A->stype nonzero).
+ */
+
+#ifndef NCHOLESKY
+
+#include "cholmod_internal.h"
+#include "cholmod_cholesky.h"
+
+
+/* ========================================================================== */
+/* === icomp ================================================================ */
+/* ========================================================================== */
+
+/* for sorting by qsort */
+static int icomp (Int *i, Int *j)
+{
+    if (*i < *j)
+    {
+	return (-1) ;
+    }
+    else
+    {
+	return (1) ;
+    }
+}
+
+
+/* ========================================================================== */
+/* === heapify ============================================================== */
+/* ========================================================================== */
+
+/* Restore the min-heap property of Heap [0..m-1] at position p, where the key
+ * of Heap [t] is |W [Heap [t]]|. */
+
+static void heapify
+(
+    Int *Heap,
+    Int p,
+    Int m,
+    double *W
+)
+{
+    double a ;
+    Int i, c, e ;
+    i = Heap [p] ;
+    a = fabs (W [i]) ;
+    for ( ; ; )
+    {
+	c = 2*p + 1 ;
+	if (c >= m)
+	{
+	    break ;
+	}
+	e = c + 1 ;
+	if (e < m && fabs (W [Heap [e]]) < fabs (W [Heap [c]]))
+	{
+	    c = e ;
+	}
+	if (a <= fabs (W [Heap [c]]))
+	{
+	    break ;
+	}
+	Heap [p] = Heap [c] ;
+	p = c ;
+    }
+    Heap [p] = i ;
+}
+
+
+/* ========================================================================== */
+/* === keep_largest ========================================================= */
+/* ========================================================================== */
+
+/* Permute Wi [0..cnt-1] so that Wi [0..m-1] are the m entries i with largest
+ * |W [i]|, where 0 < m < cnt.  Takes O(cnt log m) time. */
+
+static void keep_largest
+(
+    Int *Wi,
+    Int cnt,
+    Int m,
+    double *W
+)
+{
+    Int t, i ;
+    for (t = m/2 - 1 ; t >= 0 ; t--)
+    {
+	heapify (Wi, t, m, W) ;
+    }
+    for (t = m ; t < cnt ; t++)
+    {
+	i = Wi [t] ;
+	if (fabs (W [i]) > fabs (W [Wi [0]]))
+	{
+	    /* replace the smallest entry kept so far with i */
+	    Wi [t] = Wi [0] ;
+	    Wi [0] = i ;
+	    heapify (Wi, 0, m, W) ;
+	}
+    }
+}
+
+
+/* ========================================================================== */
+/* === grow_ichol =========================================================== */
+/* ========================================================================== */
+
+/* Ensure Li, Lev, and Lx have room for at least need entries.  Returns FALSE
+ * if out of memory, in which case the arrays are unchanged. */
+
+static int grow_ichol
+(
+    size_t need,
+    int nint,		/* 2 if Lev is present, 1 otherwise */
+    Int **Li,
+    Int **Lev,
+    double **Lx,
+    size_t *lnzmax,
+    cholmod_common *Common
+)
+{
+    double xneed, *Lz = NULL ;
+    if (need <= *lnzmax)
+    {
+	return (TRUE) ;
+    }
+    /* use double to avoid integer overflow */
+    xneed = (double) need ;
+    if (Common->grow0 < 1.2)	    /* fl. pt. compare, false if NaN */
+    {
+	/* if grow0 is less than 1.2 or NaN, don't use it */
+	xneed *= 1.2 ;
+    }
+    else
+    {
+	xneed *= Common->grow0 ;
+    }
+    xneed = MIN (xneed, Size_max) ;
+    xneed = MAX (xneed, (double) need) ;
+    return (CHOLMOD(realloc_multiple) ((size_t) xneed, nint, CHOLMOD_REAL,
+	(void **) Li, (void **) Lev, (void **) Lx, (void **) &Lz, lnzmax,
+	Common)) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_ichol ======================================================== */
+/* ========================================================================== */
+
+int CHOLMOD(ichol)
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* matrix to factorize */
+    double beta [2],	/* factorize beta*I+A (beta [0] only) */
+    /* ---- in/out --- */
+    cholmod_factor *L,	/* resulting incomplete factorization */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    double droptol, dk, y, tol, anorm, b ;
+    double *Sx, *Lx, *Wx ;
+    Int *Sp, *Si, *Snz, *Lp, *Li, *Lev, *Lnz, *ColCount, *Flag, *Head,
+	*Iwork, *Wi, *Wlev, *Next, *First ;
+    cholmod_sparse *S, *A1, *A2 ;
+    Int n, k, i, j, jnext, p, pend, t, len, cnt, anz, lev, levk, level,
+	maxfill, mark, packed, use_level, use_dbound, minor, grow2, status ;
+    size_t s, lnzmax ;
+    int ok = TRUE, nint ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (A, FALSE) ;
+    RETURN_IF_NULL (L, FALSE) ;
+    RETURN_IF_XTYPE_INVALID (A, CHOLMOD_REAL, CHOLMOD_REAL, FALSE) ;
+    RETURN_IF_XTYPE_INVALID (L, CHOLMOD_PATTERN, CHOLMOD_ZOMPLEX, FALSE) ;
+    n = L->n ;
+    if (L->n != A->nrow)
+    {
+	ERROR (CHOLMOD_INVALID, "A and L dimensions do not match") ;
+	return (FALSE) ;
+    }
+    if (A->stype == 0 || A->nrow != A->ncol)
+    {
+	ERROR (CHOLMOD_INVALID, "matrix must be symmetric") ;
+	return (FALSE) ;
+    }
+    DEBUG (CHOLMOD(dump_sparse) (A, "A for cholmod_ichol", Common)) ;
+    Common->status = CHOLMOD_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the parameters */
+    /* ---------------------------------------------------------------------- */
+
+    b = (beta == NULL) ? 0 : beta [0] ;
+    droptol = Common->ichol_droptol ;
+    droptol = (IS_NAN (droptol) || droptol < 0) ? 0 : droptol ;
+    level = Common->ichol_level ;
+    use_level = (level >= 0) ;
+    maxfill = Common->ichol_maxfill ;
+    use_dbound = IS_GT_ZERO (Common->dbound) ;
+    nint = use_level ? 2 : 1 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* ---------------------------------------------------------------------- */
+
+    s = CHOLMOD(mult_size_t) (n, 4, &ok) ;
+    if (!ok)
+    {
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+	return (FALSE) ;
+    }
+    CHOLMOD(allocate_work) (n, s, n, Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* discard the pattern and values of L, keeping just its permutation */
+    /* ---------------------------------------------------------------------- */
+
+    /* any factor can be converted into a simplicial symbolic one */
+    CHOLMOD(change_factor) (CHOLMOD_PATTERN, FALSE, FALSE, TRUE, TRUE, L,
+	    Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* S = tril (A(p,p)) */
+    /* ---------------------------------------------------------------------- */
+
+    A1 = NULL ;
+    A2 = NULL ;
+    if (L->ordering == CHOLMOD_NATURAL)
+    {
+	if (A->stype > 0)
+	{
+	    /* S = tril (A') */
+	    /* workspace: Iwork (nrow) */
+	    A1 = CHOLMOD(ptranspose) (A, 2, NULL, NULL, 0, Common) ;
+	    S = A1 ;
+	}
+	else
+	{
+	    S = A ;
+	}
+    }
+    else
+    {
+	if (A->stype > 0)
+	{
+	    /* S = tril (PAP') */
+	    /* workspace: Iwork (2*nrow) */
+	    A1 = CHOLMOD(ptranspose) (A, 2, L->Perm, NULL, 0, Common) ;
+	    S = A1 ;
+	}
+	else
+	{
+	    /* A2 = triu (PAP') */
+	    /* workspace: Iwork (2*nrow) */
+	    A2 = CHOLMOD(ptranspose) (A, 2, L->Perm, NULL, 0, Common) ;
+	    /* S = tril (A2') */
+	    /* workspace: Iwork (nrow) */
+	    A1 = CHOLMOD(ptranspose) (A2, 2, NULL, NULL, 0, Common) ;
+	    S = A1 ;
+	    CHOLMOD(free_sparse) (&A2, Common) ;
+	}
+    }
+    if (Common->status < CHOLMOD_OK)
+    {
+	CHOLMOD(free_sparse) (&A1, Common) ;
+	return (FALSE) ;
+    }
+
+    Sp = S->p ;
+    Si = S->i ;
+    Sx = S->x ;
+    Snz = S->nz ;
+    packed = S->packed ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate L, with an initial guess of nnz (tril (S)) entries */
+    /* ---------------------------------------------------------------------- */
+
+    Lp = CHOLMOD(malloc) (n+1, sizeof (Int), Common) ;
+    Li = NULL ;
+    Lev = NULL ;
+    Lx = NULL ;
+    lnzmax = 0 ;
+    if (Common->status == CHOLMOD_OK)
+    {
+	grow_ichol (MAX (1, CHOLMOD(nnz) (S, Common)), nint, &Li, &Lev, &Lx,
+	    &lnzmax, Common) ;
+    }
+    if (Common->status < CHOLMOD_OK)
+    {
+	CHOLMOD(free_sparse) (&A1, Common) ;
+	CHOLMOD(free) (n+1, sizeof (Int), Lp, Common) ;
+	CHOLMOD(free) (lnzmax, sizeof (Int), Li, Common) ;
+	CHOLMOD(free) (lnzmax, sizeof (Int), Lev, Common) ;
+	CHOLMOD(free) (lnzmax, sizeof (double), Lx, Common) ;
+	return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get workspace */
+    /* ---------------------------------------------------------------------- */
+
+    Flag = Common->Flag ;	/* size n, Flag [i] < mark must hold */
+    Head = Common->Head ;	/* size n+1, all EMPTY */
+    Wx = Common->Xwork ;	/* size n, all zero */
+    Iwork = Common->Iwork ;
+    Wi = Iwork ;		/* size n, pattern of column k */
+    Wlev = Iwork + n ;		/* size n, level of each entry in column k */
+    Next = Iwork + 2*((size_t) n) ;	/* size n, link list of columns */
+    First = Iwork + 3*((size_t) n) ;	/* size n, next entry of each column */
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the incomplete factorization one column at a time */
+    /* ---------------------------------------------------------------------- */
+
+    /* Column j of L is in Head [i], for the row i of its next entry L(i,j)
+     * that has yet to be used, at position First [j] of Li and Lx. */
+
+    Lp [0] = 0 ;
+    minor = n ;
+
+    for (k = 0 ; k < n ; k++)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* scatter S(k:n,k) into W */
+	/* ------------------------------------------------------------------ */
+
+	CHOLMOD_CLEAR_FLAG (Common) ;
+	mark = Common->mark ;
+	Flag [k] = mark ;	/* do not include the diagonal in Wi */
+	len = 0 ;
+	anorm = 0 ;
+	p = Sp [k] ;
+	pend = (packed) ? (Sp [k+1]) : (p + Snz [k]) ;
+	for ( ; p < pend ; p++)
+	{
+	    i = Si [p] ;
+	    if (i < k)
+	    {
+		continue ;
+	    }
+	    Wx [i] += Sx [p] ;
+	    anorm += fabs (Sx [p]) ;
+	    if (Flag [i] < mark)
+	    {
+		Flag [i] = mark ;
+		Wi [len++] = i ;
+		if (use_level)
+		{
+		    Wlev [i] = 0 ;
+		}
+	    }
+	}
+	anz = len ;
+
+	/* ------------------------------------------------------------------ */
+	/* subtract L(k:n,j) * D(j,j) * L(k,j) for each L(k,j) nonzero */
+	/* ------------------------------------------------------------------ */
+
+	for (j = Head [k] ; j != EMPTY ; j = jnext)
+	{
+	    jnext = Next [j] ;
+	    p = First [j] ;
+	    pend = Lp [j+1] ;
+	    ASSERT (Li [p] == k) ;
+	    /* y = L(k,j) * D(j,j) */
+	    y = Lx [p] * Lx [Lp [j]] ;
+	    levk = use_level ? Lev [p] : 0 ;
+	    Wx [k] -= Lx [p] * y ;
+	    for (p++ ; p < pend ; p++)
+	    {
+		i = Li [p] ;
+		Wx [i] -= Lx [p] * y ;
+		if (use_level)
+		{
+		    lev = Lev [p] + levk + 1 ;
+		}
+		if (Flag [i] < mark)
+		{
+		    /* L(i,k) is a new fill-in entry */
+		    Flag [i] = mark ;
+		    Wi [len++] = i ;
+		    if (use_level)
+		    {
+			Wlev [i] = lev ;
+		    }
+		}
+		else if (use_level)
+		{
+		    Wlev [i] = MIN (Wlev [i], lev) ;
+		}
+	    }
+	    /* move column j to the list of its next row */
+	    p = ++(First [j]) ;
+	    if (p < pend)
+	    {
+		i = Li [p] ;
+		Next [j] = Head [i] ;
+		Head [i] = j ;
+	    }
+	}
+	Head [k] = EMPTY ;
+
+	/* ------------------------------------------------------------------ */
+	/* get D(k,k) */
+	/* ------------------------------------------------------------------ */
+
+	dk = Wx [k] + b ;
+	Wx [k] = 0 ;
+	if (use_dbound)
+	{
+	    /* modify the diagonal to force LDL' to exist, keeping its sign */
+	    dk = CHOLMOD(dbound) (dk, Common) ;
+	}
+	if (use_dbound ? (IS_NAN (dk) || IS_ZERO (dk)) : !(dk > 0))
+	{
+	    /* the incomplete factorization has broken down (or dk is NaN) */
+	    for (t = 0 ; t < len ; t++)
+	    {
+		Wx [Wi [t]] = 0 ;
+	    }
+	    minor = k ;
+	    ERROR (CHOLMOD_NOT_POSDEF, "not positive definite") ;
+	    break ;
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* drop entries of L(k+1:n,k) */
+	/* ------------------------------------------------------------------ */
+
+	/* |W [i]| / sqrt (|dk|) is |L(i,k)| for the LL' factorization */
+	tol = droptol * anorm * sqrt (fabs (dk)) ;
+	cnt = 0 ;
+	for (t = 0 ; t < len ; t++)
+	{
+	    i = Wi [t] ;
+	    if ((use_level && Wlev [i] > level) || fabs (Wx [i]) < tol)
+	    {
+		Wx [i] = 0 ;
+	    }
+	    else
+	    {
+		Wi [cnt++] = i ;
+	    }
+	}
+
+	if (maxfill >= 0 && cnt - anz > maxfill)
+	{
+	    /* keep only the anz + maxfill entries largest in magnitude */
+	    len = anz + maxfill ;
+	    if (len > 0)
+	    {
+		keep_largest (Wi, cnt, len, Wx) ;
+	    }
+	    for (t = len ; t < cnt ; t++)
+	    {
+		Wx [Wi [t]] = 0 ;
+	    }
+	    cnt = len ;
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* store column k of L, with D(k,k) on the diagonal */
+	/* ------------------------------------------------------------------ */
+
+	if (!grow_ichol (((size_t) Lp [k]) + cnt + 1, nint, &Li, &Lev, &Lx,
+	    &lnzmax, Common))
+	{
+	    /* out of memory; L is left as a simplicial symbolic factor */
+	    for (t = 0 ; t < cnt ; t++)
+	    {
+		Wx [Wi [t]] = 0 ;
+	    }
+	    for (i = 0 ; i <= n ; i++)
+	    {
+		Head [i] = EMPTY ;
+	    }
+	    CHOLMOD_CLEAR_FLAG (Common) ;
+	    CHOLMOD(free_sparse) (&A1, Common) ;
+	    CHOLMOD(free) (n+1, sizeof (Int), Lp, Common) ;
+	    CHOLMOD(free) (lnzmax, sizeof (Int), Li, Common) ;
+	    CHOLMOD(free) (lnzmax, sizeof (Int), Lev, Common) ;
+	    CHOLMOD(free) (lnzmax, sizeof (double), Lx, Common) ;
+	    ASSERT (CHOLMOD(dump_work) (TRUE, TRUE, n, Common)) ;
+	    return (FALSE) ;
+	}
+
+	/* sort the row indices of column k */
+	qsort (Wi, cnt, sizeof (Int), (int (*) (const void *, const void *))
+	    icomp) ;
+
+	p = Lp [k] ;
+	Li [p] = k ;
+	Lx [p] = dk ;
+	if (use_level)
+	{
+	    Lev [p] = 0 ;
+	}
+	for (t = 0 ; t < cnt ; t++)
+	{
+	    i = Wi [t] ;
+	    p++ ;
+	    Li [p] = i ;
+	    Lx [p] = Wx [i] / dk ;
+	    if (use_level)
+	    {
+		Lev [p] = Wlev [i] ;
+	    }
+	    Wx [i] = 0 ;
+	}
+	Lp [k+1] = p + 1 ;
+
+	if (cnt > 0)
+	{
+	    /* place column k in the list of the row of its first entry */
+	    p = Lp [k] + 1 ;
+	    First [k] = p ;
+	    i = Li [p] ;
+	    Next [k] = Head [i] ;
+	    Head [i] = k ;
+	}
+    }
+
+    CHOLMOD_CLEAR_FLAG (Common) ;
+
+    if (minor < n)
+    {
+	/* columns minor to n-1 of L are zero */
+	for (i = 0 ; i <= n ; i++)
+	{
+	    Head [i] = EMPTY ;
+	}
+	if (!grow_ichol (((size_t) Lp [minor]) + (n - minor), nint, &Li, &Lev,
+	    &Lx, &lnzmax, Common))
+	{
+	    CHOLMOD(free_sparse) (&A1, Common) ;
+	    CHOLMOD(free) (n+1, sizeof (Int), Lp, Common) ;
+	    CHOLMOD(free) (lnzmax, sizeof (Int), Li, Common) ;
+	    CHOLMOD(free) (lnzmax, sizeof (Int), Lev, Common) ;
+	    CHOLMOD(free) (lnzmax, sizeof (double), Lx, Common) ;
+	    return (FALSE) ;
+	}
+	for (k = minor ; k < n ; k++)
+	{
+	    p = Lp [k] ;
+	    Li [p] = k ;
+	    Lx [p] = 0 ;
+	    Lp [k+1] = p + 1 ;
+	}
+    }
+
+    status = Common->status ;
+    CHOLMOD(free_sparse) (&A1, Common) ;
+    CHOLMOD(free) (lnzmax, sizeof (Int), Lev, Common) ;
+    ASSERT (CHOLMOD(dump_work) (TRUE, TRUE, n, Common)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* place Lp, Li, and Lx in L */
+    /* ---------------------------------------------------------------------- */
+
+    /* Convert L to a simplicial numeric identity matrix with space for just
+     * one entry per column, and then replace its arrays. */
+    ColCount = L->ColCount ;
+    for (j = 0 ; j < n ; j++)
+    {
+	ColCount [j] = 1 ;
+    }
+    grow2 = Common->grow2 ;
+    Common->grow2 = 0 ;
+    CHOLMOD(change_factor) (CHOLMOD_REAL, FALSE, FALSE, FALSE, TRUE, L,
+	    Common) ;
+    Common->grow2 = grow2 ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	CHOLMOD(free) (n+1, sizeof (Int), Lp, Common) ;
+	CHOLMOD(free) (lnzmax, sizeof (Int), Li, Common) ;
+	CHOLMOD(free) (lnzmax, sizeof (double), Lx, Common) ;
+	return (FALSE) ;
+    }
+    CHOLMOD(free) (n+1, sizeof (Int), L->p, Common) ;
+    CHOLMOD(free) (L->nzmax, sizeof (Int), L->i, Common) ;
+    CHOLMOD(free) (L->nzmax, sizeof (double), L->x, Common) ;
+    L->p = Lp ;
+    L->i = Li ;
+    L->x = Lx ;
+    L->nzmax = lnzmax ;
+    L->minor = minor ;
+    L->is_incomplete = TRUE ;
+    Lnz = L->nz ;
+    for (j = 0 ; j < n ; j++)
+    {
+	Lnz [j] = Lp [j+1] - Lp [j] ;
+	ColCount [j] = Lnz [j] ;
+    }
+    DEBUG (CHOLMOD(dump_factor) (L, "incomplete L", Common)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* convert to final form, if requested */
+    /* ---------------------------------------------------------------------- */
+
+    if (!(Common->final_asis))
+    {
+	/* workspace: none */
+	CHOLMOD(change_factor) (CHOLMOD_REAL, Common->final_ll, FALSE,
+		Common->final_pack, Common->final_monotonic, L, Common) ;
+    }
+
+    Common->status = MAX (Common->status, status) ;
+    return (Common->status >= CHOLMOD_OK) ;
+}
+#endif
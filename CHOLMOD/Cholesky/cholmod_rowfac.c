@@ -690,6 +690,12 @@ int CHOLMOD(rowfac_mask2)
     Common->status = CHOLMOD_OK ;
     Common->rowfacfl = 0 ;
 
+    /* L is modified, so it cannot be left in a memory map */
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
+
     /* ---------------------------------------------------------------------- */
     /* allocate workspace */
     /* ---------------------------------------------------------------------- */
@@ -972,64 +972,17 @@ cholmod_dense *CHOLMOD(solve)
 
 
 /* ========================================================================== */
-/* === cholmod_solve2 ======================================================= */
+/* === solve_worker ========================================================= */
 /* ========================================================================== */
 
-/* This function acts just like cholmod_solve, except that the solution X and
- * the internal workspace (Y and E) can be passed in preallocated.  If the
- * solution X or any required workspaces are not allocated on input, or if they
- * are the wrong size or type, then this function frees them and reallocates
- * them as the proper size and type.  Thus, if you have a sequence of solves to
- * do, you can let this function allocate X, Y, and E on the first call.
- * Subsequent calls to cholmod_solve2 can then reuse this space.  You must
- * then free the workspaces Y and E (and X if desired) when you are finished.
- * For example, the first call to cholmod_l_solve2, below, will solve the
- * requested system.  The next 2 calls (with different right-hand-sides but
- * the same value of "sys") will resuse the workspace and solution X from the
- * first call.  Finally, when all solves are done, you must free the workspaces
- * Y and E (otherwise you will have a memory leak), and you should also free X
- * when you are done with it.  Note that on input, X, Y, and E must be either
- * valid cholmod_dense matrices, or initialized to NULL.  You cannot pass in an
- * uninitialized X, Y, or E.
- *
- *      cholmod_dense *X = NULL, *Y = NULL, *E = NULL ;
- *      ...
- *      cholmod_l_solve2 (sys, L, B1, NULL, &X, NULL, &Y, &E, Common) ;
- *      cholmod_l_solve2 (sys, L, B2, NULL, &X, NULL, &Y, &E, Common) ;
- *      cholmod_l_solve2 (sys, L, B3, NULL, &X, NULL, &Y, &E, Common) ;
- *      cholmod_l_free_dense (&X, Common) ;
- *      cholmod_l_free_dense (&Y, Common) ;
- *      cholmod_l_free_dense (&E, Common) ;
- *
- * The equivalent when using cholmod_l_solve is:
- *
- *      cholmod_dense *X = NULL, *Y = NULL, *E = NULL ;
- *      ...
- *      X = cholmod_l_solve (sys, L, B1, Common) ;
- *      cholmod_l_free_dense (&X, Common) ;
- *      X = cholmod_l_solve (sys, L, B2, Common) ;
- *      cholmod_l_free_dense (&X, Common) ;
- *      X = cholmod_l_solve (sys, L, B3, Common) ;
- *      cholmod_l_free_dense (&X, Common) ;
- *
- * Both methods work fine, but in the 2nd method with cholmod_solve, the
- * internal workspaces (Y and E) are allocated and freed on each call.
- *
- * Bset is an optional sparse column (pattern only) that specifies a set
- * of row indices.  It is ignored if NULL, or if sys is CHOLMOD_P or
- * CHOLMOD_Pt.  If it is present and not ignored, B must be a dense column
- * vector, and only entries B(i) where i is in the pattern of Bset are
- * considered.  All others are treated as if they were zero (they are not
- * accessed).  L must be a simplicial factorization, not supernodal.  L is
- * converted from supernodal to simplicial if necessary.  The solution X is
- * defined only for entries in the output sparse pattern of Xset.
- * The xtype (real/complex/zomplex) of L and B must match.
- *
- * NOTE: If Bset is present and L is supernodal, it is converted to simplicial
- * on output.
+/* Solve a linear system, for cholmod_solve2 and cholmod_solve_r.  If reentrant
+ * is FALSE, L may be converted from supernodal to simplicial (if Bset is
+ * present), and L->IPerm may be constructed.  If reentrant is TRUE, L is not
+ * modified, and IPermGiven is the inverse permutation of L->Perm (or NULL if
+ * L->Perm is not used).
  */
 
-int CHOLMOD(solve2)         /* returns TRUE on success, FALSE on failure */
+static int solve_worker
 (
     /* ---- input ---- */
     int sys,		            /* system to solve */
@@ -1042,6 +995,9 @@ int CHOLMOD(solve2)         /* returns TRUE on success, FALSE on failure */
     /* ---- workspace  */
     cholmod_dense **Y_Handle,       /* workspace, or NULL */
     cholmod_dense **E_Handle,       /* workspace, or NULL */
+    /* ---- input ---- */
+    int reentrant,		    /* if TRUE, do not modify L */
+    Int *IPermGiven,		    /* inverse of L->Perm, if reentrant */
     /* --------------- */
     cholmod_common *Common
 )
@@ -1091,10 +1047,26 @@ int CHOLMOD(solve2)         /* returns TRUE on success, FALSE on failure */
             ERROR (CHOLMOD_INVALID, "Bset requires xtype of L and B to match") ;
             return (FALSE) ;
         }
+        if (reentrant && L->is_super)
+        {
+            /* L cannot be converted to simplicial */
+            ERROR (CHOLMOD_INVALID, "Bset requires a simplicial factor") ;
+            return (FALSE) ;
+        }
         DEBUG (CHOLMOD(dump_sparse) (Bset, "Bset", Common)) ;
     }
     Common->status = CHOLMOD_OK ;
 
+    if (Bset != NULL && L->is_super && !reentrant)
+    {
+	/* L is converted to simplicial below, so it cannot be left in a
+	 * memory map */
+	if (!CHOLMOD(unmap_factor) (L, Common))
+	{
+	    return (FALSE) ;	/* out of memory */
+	}
+    }
+
     /* ---------------------------------------------------------------------- */
     /* get inputs */
     /* ---------------------------------------------------------------------- */
@@ -1194,7 +1166,12 @@ int CHOLMOD(solve2)         /* returns TRUE on success, FALSE on failure */
 
         DEBUG (CHOLMOD (dump_perm) (Perm,  n,n, "Perm",  Common)) ;
 
-        if ((sys == CHOLMOD_A || sys == CHOLMOD_P) && Perm != NULL)
+        if (reentrant)
+        {
+            /* the inverse permutation is given, and L is not modified */
+            IPerm = (sys == CHOLMOD_A || sys == CHOLMOD_P) ? IPermGiven : NULL;
+        }
+        else if ((sys == CHOLMOD_A || sys == CHOLMOD_P) && Perm != NULL)
         {
             /* The inverse permutation IPerm is used for the c=Pb step,
                which is needed only for solving Ax=b or x=Pb.  No other
@@ -1675,4 +1652,261 @@ int CHOLMOD(solve2)         /* returns TRUE on success, FALSE on failure */
     DEBUG (CHOLMOD(dump_dense) (X, "X result", Common)) ;
     return (TRUE) ;
 }
+
+
+/* ========================================================================== */
+/* === cholmod_solve2 ======================================================= */
+/* ========================================================================== */
+
+/* This function acts just like cholmod_solve, except that the solution X and
+ * the internal workspace (Y and E) can be passed in preallocated.  If the
+ * solution X or any required workspaces are not allocated on input, or if they
+ * are the wrong size or type, then this function frees them and reallocates
+ * them as the proper size and type.  Thus, if you have a sequence of solves to
+ * do, you can let this function allocate X, Y, and E on the first call.
+ * Subsequent calls to cholmod_solve2 can then reuse this space.  You must
+ * then free the workspaces Y and E (and X if desired) when you are finished.
+ * For example, the first call to cholmod_l_solve2, below, will solve the
+ * requested system.  The next 2 calls (with different right-hand-sides but
+ * the same value of "sys") will resuse the workspace and solution X from the
+ * first call.  Finally, when all solves are done, you must free the workspaces
+ * Y and E (otherwise you will have a memory leak), and you should also free X
+ * when you are done with it.  Note that on input, X, Y, and E must be either
+ * valid cholmod_dense matrices, or initialized to NULL.  You cannot pass in an
+ * uninitialized X, Y, or E.
+ *
+ *      cholmod_dense *X = NULL, *Y = NULL, *E = NULL ;
+ *      ...
+ *      cholmod_l_solve2 (sys, L, B1, NULL, &X, NULL, &Y, &E, Common) ;
+ *      cholmod_l_solve2 (sys, L, B2, NULL, &X, NULL, &Y, &E, Common) ;
+ *      cholmod_l_solve2 (sys, L, B3, NULL, &X, NULL, &Y, &E, Common) ;
+ *      cholmod_l_free_dense (&X, Common) ;
+ *      cholmod_l_free_dense (&Y, Common) ;
+ *      cholmod_l_free_dense (&E, Common) ;
+ *
+ * The equivalent when using cholmod_l_solve is:
+ *
+ *      cholmod_dense *X = NULL, *Y = NULL, *E = NULL ;
+ *      ...
+ *      X = cholmod_l_solve (sys, L, B1, Common) ;
+ *      cholmod_l_free_dense (&X, Common) ;
+ *      X = cholmod_l_solve (sys, L, B2, Common) ;
+ *      cholmod_l_free_dense (&X, Common) ;
+ *      X = cholmod_l_solve (sys, L, B3, Common) ;
+ *      cholmod_l_free_dense (&X, Common) ;
+ *
+ * Both methods work fine, but in the 2nd method with cholmod_solve, the
+ * internal workspaces (Y and E) are allocated and freed on each call.
+ *
+ * Bset is an optional sparse column (pattern only) that specifies a set
+ * of row indices.  It is ignored if NULL, or if sys is CHOLMOD_P or
+ * CHOLMOD_Pt.  If it is present and not ignored, B must be a dense column
+ * vector, and only entries B(i) where i is in the pattern of Bset are
+ * considered.  All others are treated as if they were zero (they are not
+ * accessed).  L must be a simplicial factorization, not supernodal.  L is
+ * converted from supernodal to simplicial if necessary.  The solution X is
+ * defined only for entries in the output sparse pattern of Xset.
+ * The xtype (real/complex/zomplex) of L and B must match.
+ *
+ * NOTE: If Bset is present and L is supernodal, it is converted to simplicial
+ * on output.
+ */
+
+int CHOLMOD(solve2)         /* returns TRUE on success, FALSE on failure */
+(
+    /* ---- input ---- */
+    int sys,		            /* system to solve */
+    cholmod_factor *L,	            /* factorization to use */
+    cholmod_dense *B,               /* right-hand-side */
+    cholmod_sparse *Bset,
+    /* ---- output --- */
+    cholmod_dense **X_Handle,       /* solution, allocated if need be */
+    cholmod_sparse **Xset_Handle,
+    /* ---- workspace  */
+    cholmod_dense **Y_Handle,       /* workspace, or NULL */
+    cholmod_dense **E_Handle,       /* workspace, or NULL */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    return (solve_worker (sys, L, B, Bset, X_Handle, Xset_Handle, Y_Handle,
+	E_Handle, FALSE, NULL, Common)) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_allocate_solve_context ======================================= */
+/* ========================================================================== */
+
+/* Create a context for cholmod_solve_r.  A context holds everything that
+ * cholmod_solve2 would otherwise keep in L or in the Common object: its own
+ * private Common (with the workspace for a solve with Bset, and the status of
+ * the most recent solve), the workspace Y and E, and the inverse permutation
+ * of L->Perm (which cholmod_solve2 would construct in L->IPerm).
+ *
+ * Multiple threads can call cholmod_solve_r at the same time with the same
+ * factor L, as long as each thread uses its own context and no thread modifies
+ * L.  cholmod_solve_r never modifies L.  The context is specific to the
+ * permutation of L, so it must be freed and recreated if L is re-analyzed.  A
+ * context can be reused for any number of solves.
+ *
+ * The parameters of the Common object that affect a solve (prefer_zomplex, and
+ * the error handling parameters print, try_catch, and error_handler) are
+ * copied into the private Common of the context.
+ *
+ * workspace: none
+ */
+
+cholmod_solve_context *CHOLMOD(allocate_solve_context)
+(
+    /* ---- input ---- */
+    cholmod_factor *L,	/* factorization to be used by cholmod_solve_r */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    cholmod_solve_context *Context ;
+    Int *Perm, *IPerm ;
+    Int n, k ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (L, NULL) ;
+    RETURN_IF_XTYPE_INVALID (L, CHOLMOD_REAL, CHOLMOD_ZOMPLEX, NULL) ;
+    Common->status = CHOLMOD_OK ;
+    n = L->n ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the context */
+    /* ---------------------------------------------------------------------- */
+
+    Context = CHOLMOD(malloc) (1, sizeof (cholmod_solve_context), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	return (NULL) ;	    /* out of memory */
+    }
+    Context->n = n ;
+    Context->Y = NULL ;
+    Context->E = NULL ;
+    Context->IPerm = NULL ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the inverse permutation */
+    /* ---------------------------------------------------------------------- */
+
+    Perm = L->Perm ;
+    if (Perm != NULL && L->ordering != CHOLMOD_NATURAL)
+    {
+	IPerm = CHOLMOD(malloc) (n, sizeof (Int), Common) ;
+	if (Common->status < CHOLMOD_OK)
+	{
+	    CHOLMOD(free) (1, sizeof (cholmod_solve_context), Context, Common) ;
+	    return (NULL) ;	/* out of memory */
+	}
+	for (k = 0 ; k < n ; k++)
+	{
+	    IPerm [Perm [k]] = k ;
+	}
+	Context->IPerm = IPerm ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* initialize the private Common object */
+    /* ---------------------------------------------------------------------- */
+
+    CHOLMOD(start) (&(Context->Common)) ;
+    Context->Common.prefer_zomplex = Common->prefer_zomplex ;
+    Context->Common.print = Common->print ;
+    Context->Common.try_catch = Common->try_catch ;
+    Context->Common.error_handler = Common->error_handler ;
+    return (Context) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_free_solve_context =========================================== */
+/* ========================================================================== */
+
+/* Free a context created by cholmod_allocate_solve_context.  The Common object
+ * must be the same one used to create it.
+ *
+ * workspace: none
+ */
+
+int CHOLMOD(free_solve_context)
+(
+    /* ---- in/out --- */
+    cholmod_solve_context **ContextHandle,  /* context to free, NULL on output */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    cholmod_solve_context *Context ;
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    if (ContextHandle == NULL || *ContextHandle == NULL)
+    {
+	/* nothing to do */
+	return (TRUE) ;
+    }
+    Context = *ContextHandle ;
+    CHOLMOD(free_dense) (&(Context->Y), &(Context->Common)) ;
+    CHOLMOD(free_dense) (&(Context->E), &(Context->Common)) ;
+    CHOLMOD(finish) (&(Context->Common)) ;
+    CHOLMOD(free) (Context->n, sizeof (Int), Context->IPerm, Common) ;
+    *ContextHandle = CHOLMOD(free) (1, sizeof (cholmod_solve_context), Context,
+	Common) ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_solve_r ====================================================== */
+/* ========================================================================== */
+
+/* A reentrant version of cholmod_solve2.  It solves the same systems, with the
+ * same inputs and outputs, except that its workspace and status are held in
+ * the Context (see cholmod_allocate_solve_context) rather than in a Common
+ * object, and the factor L is never modified.  On output,
+ * Context->Common.status holds the status of the solve.
+ *
+ * If Bset is present, L must be simplicial (cholmod_solve2 would convert a
+ * supernodal L to simplicial; cholmod_solve_r returns an error instead).
+ *
+ * X and Xset are allocated (or reallocated) with &(Context->Common), and
+ * should be freed with that same Common object.  As with cholmod_solve2, they
+ * can be reused for subsequent solves with the same context.
+ */
+
+int CHOLMOD(solve_r)	    /* returns TRUE on success, FALSE on failure */
+(
+    /* ---- input ---- */
+    int sys,		            /* system to solve */
+    cholmod_factor *L,	            /* factorization to use */
+    cholmod_dense *B,               /* right-hand-side */
+    cholmod_sparse *Bset,
+    /* ---- output --- */
+    cholmod_dense **X_Handle,       /* solution, allocated if need be */
+    cholmod_sparse **Xset_Handle,
+    /* ---- workspace  */
+    cholmod_solve_context *Context  /* per-thread context for the solve */
+)
+{
+    if (Context == NULL)
+    {
+	return (FALSE) ;
+    }
+    if (L != NULL && L->n != Context->n)
+    {
+	cholmod_common *Common = &(Context->Common) ;
+	ERROR (CHOLMOD_INVALID, "context does not match L") ;
+	return (FALSE) ;
+    }
+    return (solve_worker (sys, L, B, Bset, X_Handle, Xset_Handle,
+	&(Context->Y), &(Context->E), TRUE, Context->IPerm,
+	&(Context->Common))) ;
+}
 #endif
@@ -65,7 +65,7 @@ static void LSOLVE (PREFIX,1)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = 0 ; j < n ; )
     {
@@ -74,8 +74,8 @@ static void LSOLVE (PREFIX,1)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j+1, and j+2) */
-	if (lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
+	/* find a chain of supernodes (up to j, j+1, and j+2), if L has any */
+	if (!chains || lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
 	{
 
 	    /* -------------------------------------------------------------- */
@@ -184,7 +184,7 @@ static void LSOLVE (PREFIX,2)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = 0 ; j < n ; )
     {
@@ -193,8 +193,8 @@ static void LSOLVE (PREFIX,2)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j+1, and j+2) */
-	if (lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
+	/* find a chain of supernodes (up to j, j+1, and j+2), if L has any */
+	if (!chains || lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
 	{
 
 	    /* -------------------------------------------------------------- */
@@ -338,7 +338,7 @@ static void LSOLVE (PREFIX,3)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = 0 ; j < n ; )
     {
@@ -347,8 +347,8 @@ static void LSOLVE (PREFIX,3)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j+1, and j+2) */
-	if (lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
+	/* find a chain of supernodes (up to j, j+1, and j+2), if L has any */
+	if (!chains || lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
 	{
 
 	    /* -------------------------------------------------------------- */
@@ -533,7 +533,7 @@ static void LSOLVE (PREFIX,4)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = 0 ; j < n ; )
     {
@@ -542,8 +542,8 @@ static void LSOLVE (PREFIX,4)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j+1, and j+2) */
-	if (lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
+	/* find a chain of supernodes (up to j, j+1, and j+2), if L has any */
+	if (!chains || lnz < 4 || lnz != Lnz [j+1] + 1 || Li [p+1] != j+1)
 	{
 
 	    /* -------------------------------------------------------------- */
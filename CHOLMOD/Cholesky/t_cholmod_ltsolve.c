@@ -67,7 +67,7 @@ static void LSOLVE (PREFIX,1)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = n-1 ; j >= 0 ; )
     {
@@ -76,8 +76,8 @@ static void LSOLVE (PREFIX,1)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j-1, and j-2) */
-	if (j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
+	/* find a chain of supernodes (up to j, j-1, and j-2), if L has any */
+	if (!chains || j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
 	{
 
 	    /* -------------------------------------------------------------- */
@@ -210,7 +210,7 @@ static void LSOLVE (PREFIX,2)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = n-1 ; j >= 0 ; )
     {
@@ -219,8 +219,8 @@ static void LSOLVE (PREFIX,2)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j-1, and j-2) */
-	if (j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
+	/* find a chain of supernodes (up to j, j-1, and j-2), if L has any */
+	if (!chains || j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
 	{
 
 	    /* -------------------------------------------------------------- */
@@ -389,7 +389,7 @@ static void LSOLVE (PREFIX,3)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = n-1 ; j >= 0 ; )
     {
@@ -398,8 +398,8 @@ static void LSOLVE (PREFIX,3)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j-1, and j-2) */
-	if (j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
+	/* find a chain of supernodes (up to j, j-1, and j-2), if L has any */
+	if (!chains || j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
 	{
 
 	    /* -------------------------------------------------------------- */
@@ -601,7 +601,7 @@ static void LSOLVE (PREFIX,4)
     Int *Li = L->i ;
     Int *Lp = L->p ;
     Int *Lnz = L->nz ;
-    Int j, n = L->n ;
+    Int j, n = L->n, chains = !(L->is_incomplete) ;
 
     for (j = n-1 ; j >= 0 ; )
     {
@@ -610,8 +610,8 @@ static void LSOLVE (PREFIX,4)
 	Int lnz = Lnz [j] ;
 	Int pend = p + lnz ;
 
-	/* find a chain of supernodes (up to j, j-1, and j-2) */
-	if (j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
+	/* find a chain of supernodes (up to j, j-1, and j-2), if L has any */
+	if (!chains || j < 4 || lnz != Lnz [j-1] - 1 || Li [Lp [j-1]+1] != j)
 	{
 
 	    /* -------------------------------------------------------------- */
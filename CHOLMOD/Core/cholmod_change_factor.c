@@ -355,8 +355,11 @@ static void any_to_simplicial_symbolic
     L->pi    = CHOLMOD(free) (s,   sizeof (Int),      L->pi,    Common) ;
     L->px    = CHOLMOD(free) (s,   sizeof (Int),      L->px,    Common) ;
     L->s     = CHOLMOD(free) (ss,  sizeof (Int),      L->s,     Common) ;
+    L->Rmap  = CHOLMOD(free) (L->rmapsize, sizeof (Int), L->Rmap, Common) ;
+    L->rmapsize = 0 ;
     L->nzmax = 0 ;
     L->is_super = FALSE ;
+    L->is_incomplete = FALSE ;
     L->xtype = CHOLMOD_PATTERN ;
     L->dtype = DTYPE ;
     L->minor = n ;
@@ -922,8 +925,10 @@ static void ll_super_to_simplicial_numeric
     L->pi    = CHOLMOD(free) (nsuper+1, sizeof (Int), L->pi, Common) ;
     L->px    = CHOLMOD(free) (nsuper+1, sizeof (Int), L->px, Common) ;
     L->s     = CHOLMOD(free) (L->ssize, sizeof (Int), L->s, Common) ;
+    L->Rmap  = CHOLMOD(free) (L->rmapsize, sizeof (Int), L->Rmap, Common) ;
 
     L->ssize = 0 ;
+    L->rmapsize = 0 ;
     L->xsize = 0 ;
     L->nsuper = 0 ;
     L->maxesize = 0 ;
@@ -1049,6 +1054,13 @@ int CHOLMOD(change_factor)
 	return (FALSE) ;
     }
 
+    /* the arrays of L may be freed or reallocated, so they cannot be left in
+     * a memory map (see cholmod_load_factor) */
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory, L is unchanged */
+    }
+
     /* ---------------------------------------------------------------------- */
     /* convert */
     /* ---------------------------------------------------------------------- */
@@ -149,6 +149,13 @@ int CHOLMOD(start)
 
     Common->blas_ok = TRUE ;    /* false if BLAS int overflow occurs */
 
+    /* the model for Common->relax_auto is set by cholmod_super_calibrate or
+     * by the user, and is not reset by cholmod_defaults */
+    for (k = 0 ; k < 4 ; k++)
+    {
+	Common->relax_model [k] = 0 ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* default SuiteSparseQR knobs and statististics */
     /* ---------------------------------------------------------------------- */
@@ -162,7 +169,9 @@ int CHOLMOD(start)
     Common->SPQR_grain = 1 ;    /* no Intel TBB multitasking, by default */
     Common->SPQR_small = 1e6 ;  /* target min task size for TBB */
     Common->SPQR_shrink = 1 ;   /* controls SPQR shrink realloc */
-    Common->SPQR_nthreads = 0 ; /* 0: let TBB decide how many threads to use */
+    Common->SPQR_nthreads = 0 ; /* 0: let TBB or OpenMP decide how many
+                                 * threads to use */
+    Common->SPQR_scheduler = 0 ; /* TBB, else OpenMP, else sequential */
 
     Common->SPQR_flopcount = 0 ;         /* flop count for SPQR */
     Common->SPQR_analyze_time = 0 ;      /* analysis time for SPQR */
@@ -361,6 +370,33 @@ int CHOLMOD(defaults)
     /* COLAMD for A*A', AMD for A */
     Common->method [8].ordering = CHOLMOD_COLAMD ;
 
+    /* ---------------------------------------------------------------------- */
+    /* OpenMP control */
+    /* ---------------------------------------------------------------------- */
+
+    Common->nthreads_max = 0 ;	/* use omp_get_max_threads ( ) */
+    Common->chunk = 128000 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* incomplete Cholesky factorization */
+    /* ---------------------------------------------------------------------- */
+
+    Common->ichol_droptol = 0 ;
+    Common->ichol_level = 0 ;	/* IC(0) */
+    Common->ichol_maxfill = -1 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* supernodal refactorization */
+    /* ---------------------------------------------------------------------- */
+
+    Common->refactor_cache = FALSE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* automatic supernodal amalgamation */
+    /* ---------------------------------------------------------------------- */
+
+    Common->relax_auto = FALSE ;
+
     /* ---------------------------------------------------------------------- */
     /* GPU configuration and statistics */
     /* ---------------------------------------------------------------------- */
@@ -675,6 +711,44 @@ size_t CHOLMOD(maxrank)	/* returns validated value of Common->maxrank */
 }
 
 
+/* ========================================================================== */
+/* === cholmod_nthreads ===================================================== */
+/* ========================================================================== */
+
+/* Determine the number of OpenMP threads to use for a given amount of work.
+ * Returns MAX (1, MIN (floor (work / Common->chunk), nthreads_max)), where
+ * nthreads_max is Common->nthreads_max, or omp_get_max_threads ( ) if that
+ * parameter is <= 0.  Always returns 1 if CHOLMOD is compiled without OpenMP.
+ * This routine is not meant for the user to call.
+ */
+
+int CHOLMOD(nthreads)	/* returns # of threads to use */
+(
+    /* ---- input ---- */
+    double work,	/* amount of work to do */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    double chunk ;
+    int nthreads_max, nthreads ;
+    RETURN_IF_NULL_COMMON (1) ;
+    nthreads_max = Common->nthreads_max ;
+    if (nthreads_max <= 0)
+    {
+	nthreads_max = CHOLMOD_OMP_MAX_THREADS ;
+    }
+    chunk = Common->chunk ;
+    if (IS_NAN (chunk) || chunk <= 1)
+    {
+	chunk = 1 ;
+    }
+    work = floor (work / chunk) ;
+    nthreads = (work < (double) nthreads_max) ? ((int) work) : nthreads_max ;
+    return (MAX (nthreads, 1)) ;
+}
+
+
 /* ========================================================================== */
 /* === cholmod_dbound ======================================================= */
 /* ========================================================================== */
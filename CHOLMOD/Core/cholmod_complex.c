@@ -477,6 +477,10 @@ int CHOLMOD(factor_xtype)
 	ERROR (CHOLMOD_INVALID, "invalid xtype for supernodal L") ;
 	return (FALSE) ;
     }
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
     ok = change_complexity ((L->is_super ? L->xsize : L->nzmax), L->xtype,
 	    to_xtype, CHOLMOD_REAL, CHOLMOD_ZOMPLEX, &(L->x), &(L->z), Common) ;
     if (ok)
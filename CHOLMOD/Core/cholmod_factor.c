@@ -29,6 +29,7 @@
  * cholmod_reallocate_column	resize a single column of a factor
  * cholmod_factor_to_sparse	create a sparse matrix copy of a factor
  * cholmod_copy_factor		create a copy of a factor
+ * cholmod_unmap_factor		copy a memory-mapped factor into malloc'd space
  *
  * Note that there is no cholmod_sparse_to_factor routine to create a factor
  * as a copy of a sparse matrix.  It could be done, after a fashion, but a
@@ -44,6 +45,95 @@
 
 #include "cholmod_internal.h"
 #include "cholmod_core.h"
+#include <string.h>
+
+/* number of arrays in a cholmod_factor object */
+#define NARRAYS 14
+
+
+/* ========================================================================== */
+/* === get_arrays =========================================================== */
+/* ========================================================================== */
+
+/* Return a pointer to each array of L, and the number and size of its entries,
+ * as they are passed to cholmod_malloc and cholmod_free. */
+
+static void get_arrays
+(
+    cholmod_factor *L,
+    void **Item [ ],	    /* size NARRAYS, Item [k] is the kth array of L */
+    size_t Count [ ],	    /* size NARRAYS, # of entries in kth array */
+    size_t Esize [ ]	    /* size NARRAYS, size of each entry of kth array */
+)
+{
+    size_t n, s, xs ;
+    int k ;
+
+    n = L->n ;
+    s = L->nsuper + 1 ;
+    xs = (L->is_super) ? L->xsize : L->nzmax ;
+
+    Item [ 0] = &(L->Perm) ;	    Count [ 0] = n ;
+    Item [ 1] = &(L->IPerm) ;	    Count [ 1] = n ;
+    Item [ 2] = &(L->ColCount) ;    Count [ 2] = n ;
+    Item [ 3] = &(L->p) ;	    Count [ 3] = n+1 ;
+    Item [ 4] = &(L->i) ;	    Count [ 4] = L->nzmax ;
+    Item [ 5] = &(L->nz) ;	    Count [ 5] = n ;
+    Item [ 6] = &(L->next) ;	    Count [ 6] = n+2 ;
+    Item [ 7] = &(L->prev) ;	    Count [ 7] = n+2 ;
+    Item [ 8] = &(L->pi) ;	    Count [ 8] = s ;
+    Item [ 9] = &(L->px) ;	    Count [ 9] = s ;
+    Item [10] = &(L->super) ;	    Count [10] = s ;
+    Item [11] = &(L->s) ;	    Count [11] = L->ssize ;
+    Item [12] = &(L->x) ;	    Count [12] = xs ;
+    Item [13] = &(L->z) ;	    Count [13] = xs ;
+
+    for (k = 0 ; k < 12 ; k++)
+    {
+	Esize [k] = sizeof (Int) ;
+    }
+    Esize [12] = ((L->xtype == CHOLMOD_COMPLEX) ? 2 : 1) * sizeof (double) ;
+    Esize [13] = sizeof (double) ;
+}
+
+
+/* ========================================================================== */
+/* === is_mapped ============================================================ */
+/* ========================================================================== */
+
+/* Return TRUE if p points into the memory map of L.  An empty array saved at
+ * the very end of the file points just past the end of the map. */
+
+static int is_mapped
+(
+    void *p,
+    cholmod_factor *L
+)
+{
+    char *base = (char *) L->mmap_base ;
+    return (p != NULL && base != NULL &&
+	(char *) p >= base && (char *) p <= base + L->mmap_size) ;
+}
+
+
+/* ========================================================================== */
+/* === release_map ========================================================== */
+/* ========================================================================== */
+
+static void release_map
+(
+    cholmod_factor *L
+)
+{
+#ifdef HAVE_MMAP
+    if (L->mmap_base != NULL)
+    {
+	munmap (L->mmap_base, L->mmap_size) ;
+    }
+#endif
+    L->mmap_base = NULL ;
+    L->mmap_size = 0 ;
+}
 
 
 /* ========================================================================== */
@@ -131,6 +221,17 @@ cholmod_factor *CHOLMOD(allocate_factor)
     L->s = NULL ;
     L->useGPU = 0;
 
+    /* L is not held in a memory map */
+    L->mmap_base = NULL ;
+    L->mmap_size = 0 ;
+
+    /* no refactorization schedule */
+    L->Rmap = NULL ;
+    L->rmapsize = 0 ;
+
+    /* L is not an incomplete factorization */
+    L->is_incomplete = FALSE ;
+
     /* L has not been factorized */
     L->minor = n ;
 
@@ -173,7 +274,9 @@ int CHOLMOD(free_factor)
     cholmod_common *Common
 )
 {
-    Int n, lnz, xs, ss, s ;
+    void **Item [NARRAYS] ;
+    size_t Count [NARRAYS], Esize [NARRAYS] ;
+    Int n, lnz, xs, ss, s, k ;
     cholmod_factor *L ;
 
     RETURN_IF_NULL_COMMON (FALSE) ;
@@ -190,6 +293,20 @@ int CHOLMOD(free_factor)
 	return (TRUE) ;
     }
 
+    if (L->mmap_base != NULL)
+    {
+	/* arrays held in the memory map are released along with the map */
+	get_arrays (L, Item, Count, Esize) ;
+	for (k = 0 ; k < NARRAYS ; k++)
+	{
+	    if (is_mapped (*(Item [k]), L))
+	    {
+		*(Item [k]) = NULL ;
+	    }
+	}
+	release_map (L) ;
+    }
+
     n = L->n ;
     lnz = L->nzmax ;
     s = L->nsuper + 1 ;
@@ -213,6 +330,7 @@ int CHOLMOD(free_factor)
     CHOLMOD(free) (s,   sizeof (Int), L->px,       Common) ;
     CHOLMOD(free) (s,   sizeof (Int), L->super,    Common) ;
     CHOLMOD(free) (ss,  sizeof (Int), L->s,        Common) ;
+    CHOLMOD(free) (L->rmapsize, sizeof (Int), L->Rmap, Common) ;
 
     /* numerical values for both simplicial and supernodal L */
     if (L->xtype == CHOLMOD_REAL)
@@ -270,6 +388,10 @@ int CHOLMOD(reallocate_factor)
     }
     Common->status = CHOLMOD_OK ;
     PRINT1 (("realloc factor %g to %g\n", (double) L->nzmax, (double) nznew)) ;
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
 
     /* ---------------------------------------------------------------------- */
     /* resize (or allocate) the L->i and L->x components of the factor */
@@ -327,6 +449,10 @@ int CHOLMOD(reallocate_column)
 	return (FALSE) ;	    /* j out of range */
     }
     Common->status = CHOLMOD_OK ;
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	    /* out of memory */
+    }
 
     DEBUG (CHOLMOD(dump_factor) (L, "start colrealloc", Common)) ;
 
@@ -927,8 +1053,89 @@ cholmod_factor *CHOLMOD(copy_factor)
 
     L2->minor = L->minor ;
     L2->is_monotonic = L->is_monotonic ;
+    L2->is_incomplete = L->is_incomplete ;
 
     DEBUG (CHOLMOD(dump_factor) (L2, "L2 got copied", Common)) ;
     ASSERT (L2->xtype == L->xtype && L2->is_super == L->is_super) ;
     return (L2) ;
 }
+
+
+/* ========================================================================== */
+/* === cholmod_unmap_factor ================================================= */
+/* ========================================================================== */
+
+/* A factor returned by cholmod_load_factor may hold its arrays in a memory map
+ * of the file it was read from, rather than in malloc'd space.  This routine
+ * copies each such array into space obtained from cholmod_malloc, and then
+ * releases the map.  It does nothing if L is not memory-mapped.  The routines
+ * that free or reallocate parts of L call it first, so a memory-mapped factor
+ * can be used anywhere an ordinary factor can.  If it runs out of memory, L is
+ * returned unchanged.
+ *
+ * workspace: none
+ */
+
+int CHOLMOD(unmap_factor)
+(
+    /* ---- in/out --- */
+    cholmod_factor *L,	/* factor to modify */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    void **Item [NARRAYS] ;
+    void *New [NARRAYS] ;
+    size_t Count [NARRAYS], Esize [NARRAYS] ;
+    int k ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (L, FALSE) ;
+    Common->status = CHOLMOD_OK ;
+    if (L->mmap_base == NULL)
+    {
+	return (TRUE) ;		/* nothing to do */
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate space for each array held in the memory map */
+    /* ---------------------------------------------------------------------- */
+
+    get_arrays (L, Item, Count, Esize) ;
+    for (k = 0 ; k < NARRAYS ; k++)
+    {
+	New [k] = NULL ;
+	if (is_mapped (*(Item [k]), L))
+	{
+	    New [k] = CHOLMOD(malloc) (Count [k], Esize [k], Common) ;
+	}
+    }
+
+    if (Common->status < CHOLMOD_OK)
+    {
+	for (k = 0 ; k < NARRAYS ; k++)
+	{
+	    CHOLMOD(free) (Count [k], Esize [k], New [k], Common) ;
+	}
+	return (FALSE) ;	/* out of memory, L is unchanged */
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* copy the arrays and release the memory map */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < NARRAYS ; k++)
+    {
+	if (New [k] != NULL)
+	{
+	    memcpy (New [k], *(Item [k]), Count [k] * Esize [k]) ;
+	    *(Item [k]) = New [k] ;
+	}
+    }
+    release_map (L) ;
+    return (TRUE) ;
+}
@@ -50,6 +50,11 @@
  *
  * cholmod_write_dense	    write a dense matrix to a Matrix Market file.
  *
+ * cholmod_save_factor	    write a factor to a binary file.
+ *
+ * cholmod_load_factor	    read a factor written by cholmod_save_factor,
+ *			    using a memory map of the file if possible.
+ *
  * cholmod_print_common and cholmod_check_common are the only two routines that
  * you may call after calling cholmod_finish.
  *
@@ -421,4 +426,33 @@ int cholmod_write_dense
 
 int cholmod_l_write_dense (FILE *, cholmod_dense *, const char *,
     cholmod_common *) ;
+
+/* -------------------------------------------------------------------------- */
+/* cholmod_save_factor: write a factor to a binary file */
+/* -------------------------------------------------------------------------- */
+
+int cholmod_save_factor
+(
+    /* ---- input ---- */
+    FILE *f,		    /* file to write to, must already be open */
+    cholmod_factor *L,	    /* factor to write */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_save_factor (FILE *, cholmod_factor *, cholmod_common *) ;
+
+/* -------------------------------------------------------------------------- */
+/* cholmod_load_factor: read a factor written by cholmod_save_factor */
+/* -------------------------------------------------------------------------- */
+
+cholmod_factor *cholmod_load_factor
+(
+    /* ---- input ---- */
+    FILE *f,		    /* file to read from, must already be open */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+cholmod_factor *cholmod_l_load_factor (FILE *, cholmod_common *) ;
 #endif
@@ -25,6 +25,7 @@
  * cholmod_factorize		simplicial or supernodal Cholesky factorization
  * cholmod_solve		solve a linear system (simplicial or supernodal)
  * cholmod_solve2		like cholmod_solve, but reuse workspace
+ * cholmod_solve_r		like cholmod_solve2, but reentrant
  * cholmod_spsolve		solve a linear system (sparse x and b)
  *
  * Secondary routines:
@@ -32,6 +33,7 @@
  *
  * cholmod_analyze_p		analyze, with user-provided permutation or f set
  * cholmod_factorize_p		factorize, with user-provided permutation or f
+ * cholmod_ichol		incomplete Cholesky factorization
  * cholmod_analyze_ordering	analyze a fill-reducing ordering
  * cholmod_etree		find the elimination tree
  * cholmod_rowcolcounts		compute the row/column counts of L
@@ -168,6 +170,29 @@ int cholmod_factorize_p
 int cholmod_l_factorize_p (cholmod_sparse *, double *, SuiteSparse_long *,
     size_t, cholmod_factor *, cholmod_common *) ;
 
+/* -------------------------------------------------------------------------- */
+/* cholmod_ichol:  incomplete Cholesky factorization */
+/* -------------------------------------------------------------------------- */
+
+/* Incomplete LDL' factorization of A(p,p)+beta*I, for use as a preconditioner.
+ * Uses only the permutation of L, and the drop rules Common->ichol_droptol,
+ * Common->ichol_level, and Common->ichol_maxfill.  A must be real and
+ * symmetric.  L is returned as a simplicial factor for cholmod_solve. */
+
+int cholmod_ichol
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* matrix to factorize */
+    double beta [2],	/* factorize beta*I+A (beta [0] only) */
+    /* ---- in/out --- */
+    cholmod_factor *L,	/* resulting incomplete factorization */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_ichol (cholmod_sparse *, double *, cholmod_factor *,
+    cholmod_common *) ;
+
 /* -------------------------------------------------------------------------- */
 /* cholmod_solve:  solve a linear system (simplicial or supernodal) */
 /* -------------------------------------------------------------------------- */
@@ -224,6 +249,63 @@ int cholmod_l_solve2 (int, cholmod_factor *, cholmod_dense *, cholmod_sparse *,
     cholmod_dense **, cholmod_sparse **, cholmod_dense **, cholmod_dense **,
     cholmod_common *) ;
 
+/* -------------------------------------------------------------------------- */
+/* cholmod_solve_r:  like cholmod_solve2, but reentrant */
+/* -------------------------------------------------------------------------- */
+
+/* Each thread that solves with a shared factor L uses its own context, created
+ * by cholmod_allocate_solve_context.  cholmod_solve_r never modifies L. */
+
+typedef struct cholmod_solve_context_struct
+{
+    cholmod_common Common ;	/* private Common object for this context.
+				 * Common.status is the status of the most
+				 * recent call to cholmod_solve_r. */
+    cholmod_dense *Y ;		/* workspace */
+    cholmod_dense *E ;		/* workspace */
+    void *IPerm ;		/* size n, inverse of L->Perm, or NULL */
+    size_t n ;			/* L is n-by-n */
+
+} cholmod_solve_context ;
+
+cholmod_solve_context *cholmod_allocate_solve_context
+(
+    /* ---- input ---- */
+    cholmod_factor *L,	/* factorization to be used by cholmod_solve_r */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+cholmod_solve_context *cholmod_l_allocate_solve_context (cholmod_factor *,
+    cholmod_common *) ;
+
+int cholmod_free_solve_context
+(
+    /* ---- in/out --- */
+    cholmod_solve_context **ContextHandle,  /* context to free, NULL on output */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_free_solve_context (cholmod_solve_context **, cholmod_common *) ;
+
+int cholmod_solve_r	    /* returns TRUE on success, FALSE on failure */
+(
+    /* ---- input ---- */
+    int sys,		            /* system to solve */
+    cholmod_factor *L,	            /* factorization to use */
+    cholmod_dense *B,               /* right-hand-side */
+    cholmod_sparse *Bset,
+    /* ---- output --- */
+    cholmod_dense **X_Handle,       /* solution, allocated if need be */
+    cholmod_sparse **Xset_Handle,
+    /* ---- workspace  */
+    cholmod_solve_context *Context  /* per-thread context for the solve */
+) ;
+
+int cholmod_l_solve_r (int, cholmod_factor *, cholmod_dense *, cholmod_sparse *,
+    cholmod_dense **, cholmod_sparse **, cholmod_solve_context *) ;
+
 /* -------------------------------------------------------------------------- */
 /* cholmod_spsolve:  solve a linear system with a sparse right-hand-side */
 /* -------------------------------------------------------------------------- */
@@ -73,6 +73,7 @@
  * cholmod_clear_flag		clear Flag workspace in Common
  * cholmod_error		called when CHOLMOD encounters an error
  * cholmod_dbound		for internal use in CHOLMOD only
+ * cholmod_nthreads		for internal use in CHOLMOD only
  * cholmod_hypot		compute sqrt (x*x + y*y) accurately
  * cholmod_divcomplex		complex division, c = a/b
  *
@@ -131,6 +132,7 @@
  * cholmod_factor_to_sparse	create a sparse matrix copy of a factor
  * cholmod_copy_factor		create a copy of a factor
  * cholmod_factor_xtype		change the xtype of a factor
+ * cholmod_unmap_factor		copy a memory-mapped factor into malloc'd space
  *
  * Note that there is no cholmod_sparse_to_factor routine to create a factor
  * as a copy of a sparse matrix.  It could be done, after a fashion, but a
@@ -920,7 +922,7 @@ typedef struct cholmod_common_struct
     double SPQR_grain ;      /* task size is >= max (total flops / grain) */
     double SPQR_small ;      /* task size is >= small */
     int SPQR_shrink ;        /* controls stack realloc method */
-    int SPQR_nthreads ;      /* number of TBB threads, 0 = auto */
+    int SPQR_nthreads ;      /* number of threads for the task tree, 0 = auto */
 
     /* ---------------------------------------------------------------------- */
     /* SuiteSparseQR statistics */
@@ -1021,6 +1023,100 @@ typedef struct cholmod_common_struct
     size_t cholmod_gpu_trsm_calls ;
     size_t cholmod_gpu_potrf_calls ;
 
+    /* ---------------------------------------------------------------------- */
+    /* OpenMP control */
+    /* ---------------------------------------------------------------------- */
+
+    int nthreads_max ;	/* maximum number of OpenMP threads that CHOLMOD may
+			 * use outside of the BLAS.  If <= 0, the value
+	* returned by omp_get_max_threads ( ) is used.  Default: 0 */
+
+    double chunk ;	/* chunksize for determining the number of threads to
+			 * use.  Given an amount of work w (typically a number
+	* of entries or bytes to process), CHOLMOD uses
+	* MAX (1, MIN (floor (w / chunk), nthreads_max)) threads.
+	* Default: 128000 */
+
+    /* ---------------------------------------------------------------------- */
+    /* incomplete Cholesky factorization (cholmod_ichol) */
+    /* ---------------------------------------------------------------------- */
+
+    double ichol_droptol ;  /* drop tolerance.  An off-diagonal entry of L,
+			    * scaled as in the LL' factorization, is dropped if
+	* |L(i,j)| < ichol_droptol * norm (A(j:n,j),1).  The diagonal is never
+	* dropped.  Default: 0 (no entry is dropped because of its value). */
+
+    int ichol_level ;	/* level of fill.  Entries of A have level 0, and an
+			 * entry L(i,j) created by L(i,k) and L(j,k) has level
+	* lev(i,k) + lev(j,k) + 1.  Entries with a level greater than
+	* ichol_level are dropped.  If negative, the level of fill is not
+	* limited.  Default: 0, which gives IC(0) when ichol_droptol is zero
+	* (L has the same pattern as tril(A)). */
+
+    int ichol_maxfill ;	/* limit on the fill-in in each column of L.  Column
+			 * j of L keeps at most nnz (A(j+1:n,j)) + ichol_maxfill
+	* off-diagonal entries, those largest in magnitude.  If negative, the
+	* number of entries is not limited.  Default: -1 */
+
+    /* ---------------------------------------------------------------------- */
+    /* supernodal refactorization */
+    /* ---------------------------------------------------------------------- */
+
+    int refactor_cache ;    /* If TRUE, cholmod_super_numeric saves in L->Rmap
+			    * where each entry of A is placed in L, and the
+	* schedule of updates from each descendant supernode, including the
+	* relative map used to assemble each update.  Later factorizations of
+	* the same L reuse them, which avoids most of the integer work of a
+	* supernodal factorization.  The matrix A must then have the same
+	* nonzero pattern each time (only the values may change), and A must be
+	* symmetric (the A*A' and A(:,f)*A(:,f)' cases do not use L->Rmap).
+	* L->Rmap takes O(nnz(A)) space plus one integer for each row of each
+	* descendant update.  Default: FALSE */
+
+    /* ---------------------------------------------------------------------- */
+    /* automatic supernodal amalgamation */
+    /* ---------------------------------------------------------------------- */
+
+    int relax_auto ;	/* If TRUE, cholmod_super_symbolic ignores nrelax and
+			 * zrelax when analyzing for a Cholesky factorization.
+	* Two adjacent supernodes are merged instead if a model of this machine
+	* predicts that factorizing the merged supernode takes less time than
+	* factorizing the two apart, including the explicit zeros the merge
+	* adds.  Supernodes whose merge adds no zeros are always merged.
+	* Default: FALSE */
+
+    double relax_model [4] ;	/* the machine model used if relax_auto is
+				 * TRUE.  A supernode with k columns and m rows
+	* in its leading column is predicted to take
+	*
+	*   relax_model [0] + flops / (relax_model [1] * k / (k+relax_model [2]))
+	*	+ relax_model [3] * (k*m + (m-k)*(m-k+1)/2)
+	*
+	* seconds, where flops = sum ((m-i)^2) for i = 0 to k-1.  [0] is the
+	* fixed cost of each supernode, [1] is the peak flop rate of the
+	* BLAS, [2] is the number of columns at which the BLAS reach half
+	* that rate, and [3] is the time to assemble one entry.  [1] must be
+	* positive, and the others must be nonnegative.  The analysis depends
+	* only on these values, not on any timing at run time.
+	* cholmod_super_calibrate measures the model for this machine; call
+	* it once, then keep or save the model for later analyses.  The
+	* model is cleared by cholmod_start but not by cholmod_defaults.  If
+	* relax_auto is TRUE and the model is not valid, the analysis fails
+	* with CHOLMOD_INVALID.  Default: all zero (not set). */
+
+    /* ---------------------------------------------------------------------- */
+    /* SuiteSparseQR task scheduler */
+    /* ---------------------------------------------------------------------- */
+
+    int SPQR_scheduler ;	/* how the numeric factorization of SuiteSparseQR
+				 * runs the tree of tasks found when SPQR_grain
+	* > 1 (see SuiteSparseQR_definitions.h): SPQR_SCHEDULE_DEFAULT (0)
+	* uses TBB if compiled with -DHAVE_TBB, or else OpenMP tasks if compiled
+	* with OpenMP, or else does the tasks one at a time.  SPQR_SCHEDULE_SERIAL
+	* (1), SPQR_SCHEDULE_TBB (2), and SPQR_SCHEDULE_OPENMP (3) select one of
+	* these explicitly; if it is not available, the default is used.  The
+	* scheduler used is returned in SPQR_istat [8].  Default: 0 */
+
 } cholmod_common ;
 
 /* size_t BLAS statistcs in Common: */
@@ -1177,6 +1273,20 @@ double cholmod_dbound	/* returns modified diagonal entry of D or L */
 
 double cholmod_l_dbound (double, cholmod_common *) ;
 
+/* -------------------------------------------------------------------------- */
+/* cholmod_nthreads:  for internal use in CHOLMOD only */
+/* -------------------------------------------------------------------------- */
+
+int cholmod_nthreads	/* returns # of OpenMP threads to use */
+(
+    /* ---- input ---- */
+    double work,	/* amount of work to do */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_nthreads (double, cholmod_common *) ;
+
 /* -------------------------------------------------------------------------- */
 /* cholmod_hypot:  compute sqrt (x*x + y*y) accurately */
 /* -------------------------------------------------------------------------- */
@@ -1731,6 +1841,39 @@ typedef struct cholmod_factor_struct
     int useGPU; /* Indicates the symbolic factorization supports
 		 * GPU acceleration */
 
+    /* ---------------------------------------------------------------------- */
+    /* memory-mapped factor */
+    /* ---------------------------------------------------------------------- */
+
+    void *mmap_base ;	/* NULL, or the memory map created by
+			 * cholmod_load_factor.  Arrays of L that point into
+			 * [mmap_base, mmap_base+mmap_size) are not malloc'd,
+			 * and are never passed to cholmod_free.  They are
+			 * copied into malloc'd space (by cholmod_unmap_factor)
+			 * before L is modified in any way that would free or
+			 * reallocate them. */
+    size_t mmap_size ;	/* size of the memory map, in bytes */
+
+    /* ---------------------------------------------------------------------- */
+    /* supernodal refactorization (see Common->refactor_cache) */
+    /* ---------------------------------------------------------------------- */
+
+    void *Rmap ;	/* NULL, or the A-to-L map and descendant update
+			 * schedule of a supernodal L, created by
+	* cholmod_super_numeric and reused when L is refactorized.  An integer
+	* array of size rmapsize.  It is freed when L is freed or converted to
+	* simplicial, and is not copied by cholmod_copy_factor. */
+    size_t rmapsize ;
+
+    /* ---------------------------------------------------------------------- */
+    /* incomplete factorization */
+    /* ---------------------------------------------------------------------- */
+
+    int is_incomplete ;	/* TRUE if L is a simplicial incomplete factorization
+			 * from cholmod_ichol.  Its pattern need not be chordal,
+			 * so cholmod_solve must not treat adjacent columns of
+			 * L with nested patterns as a supernode. */
+
 } cholmod_factor ;
 
 
@@ -1866,6 +2009,20 @@ cholmod_factor *cholmod_copy_factor
 
 cholmod_factor *cholmod_l_copy_factor (cholmod_factor *, cholmod_common *) ;
 
+/* -------------------------------------------------------------------------- */
+/* cholmod_unmap_factor:  copy a memory-mapped factor into malloc'd space */
+/* -------------------------------------------------------------------------- */
+
+int cholmod_unmap_factor
+(
+    /* ---- in/out --- */
+    cholmod_factor *L,	/* factor to modify */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_unmap_factor (cholmod_factor *, cholmod_common *) ;
+
 /* -------------------------------------------------------------------------- */
 /* cholmod_factor_xtype: change the xtype of a factor */
 /* -------------------------------------------------------------------------- */
@@ -212,6 +212,30 @@ size_t cholmod_mult_size_t (size_t a, size_t k, int *ok) ;
 size_t cholmod_l_add_size_t (size_t a, size_t b, int *ok) ;
 size_t cholmod_l_mult_size_t (size_t a, size_t k, int *ok) ;
 
+/* -------------------------------------------------------------------------- */
+/* OpenMP */
+/* -------------------------------------------------------------------------- */
+
+#ifdef _OPENMP
+#include <omp.h>
+#define CHOLMOD_OMP_MAX_THREADS omp_get_max_threads ( )
+#else
+#define CHOLMOD_OMP_MAX_THREADS 1
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* memory-mapped files */
+/* -------------------------------------------------------------------------- */
+
+/* Files are read via mmap on POSIX systems, unless compiled with -DNMMAP */
+#if !defined (NMMAP) && (defined (__unix__) || defined (__APPLE__))
+#define HAVE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* double (also complex double), SuiteSparse_long */
 /* -------------------------------------------------------------------------- */
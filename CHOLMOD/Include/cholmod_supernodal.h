@@ -22,6 +22,10 @@
  * cholmod_super_lsolve		supernodal Lx=b solve
  * cholmod_super_ltsolve	supernodal L'x=b solve
  *
+ * Secondary routines:
+ * -------------------
+ * cholmod_super_calibrate	measure the model for automatic amalgamation
+ *
  * Prototypes for the BLAS and LAPACK routines that CHOLMOD uses are listed
  * below, including how they are used in CHOLMOD.
  *
@@ -96,6 +100,24 @@ int cholmod_super_symbolic2
 int cholmod_l_super_symbolic2 (int, cholmod_sparse *, cholmod_sparse *,
     SuiteSparse_long *, cholmod_factor *, cholmod_common *) ;
 
+/* -------------------------------------------------------------------------- */
+/* cholmod_super_calibrate */
+/* -------------------------------------------------------------------------- */
+
+/* Measures the time taken by the dense kernels of a supernodal factorization
+ * on this machine, and saves the model in Common->relax_model.  See
+ * Common->relax_auto.  cholmod_super_symbolic never calls this routine; call
+ * it once and reuse the model for later analyses.
+ */
+
+int cholmod_super_calibrate
+(
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_super_calibrate (cholmod_common *) ;
+
 /* -------------------------------------------------------------------------- */
 /* cholmod_super_numeric */
 /* -------------------------------------------------------------------------- */
@@ -228,11 +228,13 @@ cholmod_src = {
     '../Check/cholmod_check', ...
     '../Check/cholmod_read', ...
     '../Check/cholmod_write', ...
+    '../Check/cholmod_save', ...
     '../Cholesky/cholmod_amd', ...
     '../Cholesky/cholmod_analyze', ...
     '../Cholesky/cholmod_colamd', ...
     '../Cholesky/cholmod_etree', ...
     '../Cholesky/cholmod_factorize', ...
+    '../Cholesky/cholmod_ichol', ...
     '../Cholesky/cholmod_postorder', ...
     '../Cholesky/cholmod_rcond', ...
     '../Cholesky/cholmod_resymbol', ...
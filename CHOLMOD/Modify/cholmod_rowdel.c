@@ -172,6 +172,12 @@ int CHOLMOD(rowdel_mark)
     }
     Common->status = CHOLMOD_OK ;
 
+    /* L is modified, so it cannot be left in a memory map */
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
+
     /* ---------------------------------------------------------------------- */
     /* allocate workspace */
     /* ---------------------------------------------------------------------- */
@@ -485,6 +485,12 @@ int CHOLMOD(updown_mask2)
     Common->status = CHOLMOD_OK ;
     Common->modfl = 0 ;
 
+    /* L is modified, so it cannot be left in a memory map */
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
+
     fl = 0 ;
     use_colmark = (colmark != NULL) ;
 
@@ -41,6 +41,28 @@
 #include "cholmod_partition.h"
 #include "cholmod_cholesky.h"
 
+/* A component of the graph to be partitioned by cholmod_nested_dissection.
+ * Up to nbatch components are partitioned at the same time, each using its own
+ * part of the workspace. */
+
+typedef struct nd_task_struct
+{
+    cholmod_sparse C ;	    /* the subgraph (header only) */
+    cholmod_common Common ; /* private Common, if partitioned in parallel */
+    Int *Map ;		    /* size cn, node cj of C is node Map [cj] of B */
+    Int *Hash ;		    /* size cn, hash keys for compression */
+    Int *Cnw ;		    /* size cn, node weights */
+    Int *Cmap ;		    /* size cn, workspace for partition */
+    Int *Part ;		    /* size cn, the partition of C */
+    Int *Cew ;		    /* size csize, edge weights, all one */
+    Int csize ;		    /* MAX (cn, nnz (C)) */
+    Int cnode ;		    /* the repnode of C */
+    Int cn ;		    /* # of nodes in C */
+    Int total_weight ;	    /* sum of the node weights of C */
+    Int sepsize ;	    /* size of the separator, or -1 if failure */
+
+} nd_task ;
+
 /* ========================================================================== */
 /* === partition ============================================================ */
 /* ========================================================================== */
@@ -1027,10 +1049,18 @@ SuiteSparse_long CHOLMOD(bisect)	/* returns # of nodes in separator */
  * This function also returns a postorderd separator tree (CParent), and a
  * mapping of nodes in the graph to nodes in the separator tree (Cmember).
  *
+ * The components of the graph that remain to be partitioned are independent of
+ * each other.  If cholmod_nthreads returns nthreads > 1 for a graph with
+ * nnz(B) edges, up to 2*nthreads of them are partitioned in parallel (each
+ * METIS call uses a single thread).  The results do not depend on the number
+ * of threads.  The final constrained minimum degree ordering of the whole
+ * graph (CAMD, CSYMAMD, or CCOLAMD) is not parallel.
+ *
  * workspace: Flag (nrow), Head (nrow+1), Iwork (4*nrow + (ncol if unsymmetric))
  *	Allocates a temporary matrix B=A*A' or B=A,
  *	and O(nnz(A)) temporary memory space.
  *	Allocates an additional 3*n*sizeof(Int) temporary workspace
+ *	(plus up to n more if the components are partitioned in parallel).
  */
 
 SuiteSparse_long CHOLMOD(nested_dissection)
@@ -1053,16 +1083,16 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 {
     double prune_dense, nd_oksep ;
     Int *Bp, *Bi, *Bnz, *Cstack, *Imap, *Map, *Flag, *Head, *Next, *Bnw, *Iwork,
-	*Ipost, *NewParent, *Hash, *Cmap, *Cp, *Ci, *Cew, *Cnw, *Part, *Post,
-	*Work3n ;
-    unsigned Int hash ;
+	*Ipost, *NewParent, *Hash, *Cp, *Ci, *Cew, *Cnw, *Part, *Post,
+	*Work3n, *Map0, *Hash0, *Cmap0, *Cp0, *Ci0, *Cnw0, *Part0 ;
     Int n, bnz, top, i, j, k, cnode, cdense, p, cj, cn, ci, cnz, mark, c, uncol,
 	sepsize, parent, ncomponents, threshold, ndense, pstart, pdest, pend,
 	nd_compress, nd_camd, csize, jnext, nd_small, total_weight,
-	nchild, child = EMPTY ;
+	nchild, child = EMPTY, nbatch, ntasks, t, noff, nzoff, ewoff ;
     cholmod_sparse *B, *C ;
-    size_t s ;
-    int ok = TRUE ;
+    nd_task *Task, *T ;
+    size_t s, cewsize, usage ;
+    int ok = TRUE, nthreads ;
     DEBUG (Int cnt) ;
 
     /* ---------------------------------------------------------------------- */
@@ -1133,19 +1163,22 @@ SuiteSparse_long CHOLMOD(nested_dissection)
     Flag = Common->Flag ;	/* size n */
     Head = Common->Head ;	/* size n+1, all equal to -1 */
 
+    /* Map, Hash, Part, Cnw, and Cmap are split into one part for each of the
+     * components being partitioned at the same time (see Task below). */
+
     Iwork = Common->Iwork ;
     Imap = Iwork ;		/* size n, same as Queue in find_components */
-    Map  = Iwork + n ;		/* size n */
+    Map0 = Iwork + n ;		/* size n */
     Bnz  = Iwork + 2*((size_t) n) ;	/* size n */
-    Hash = Iwork + 3*((size_t) n) ;	/* size n */
+    Hash0 = Iwork + 3*((size_t) n) ;	/* size n */
 
     Work3n = CHOLMOD(malloc) (n, 3*sizeof (Int), Common) ;
-    Part = Work3n ;		/* size n */
-    Bnw  = Part + n ;		/* size n */
-    Cnw  = Bnw + n ;		/* size n */
+    Part0 = Work3n ;		/* size n */
+    Bnw  = Part0 + n ;		/* size n */
+    Cnw0 = Bnw + n ;		/* size n */
 
     Cstack = Perm ;		/* size n, use Perm as workspace for Cstack [ */
-    Cmap = Cmember ;		/* size n, use Cmember as workspace [ */
+    Cmap0 = Cmember ;		/* size n, use Cmember as workspace [ */
 
     if (Common->status < CHOLMOD_OK)
     {
@@ -1184,6 +1217,25 @@ SuiteSparse_long CHOLMOD(nested_dissection)
     csize = MAX (n, bnz) ;
     ASSERT (CHOLMOD(dump_sparse) (B, "B for nd:", Common) >= 0) ;
 
+    /* partition up to nbatch components at a time, using nthreads threads */
+    nthreads = CHOLMOD(nthreads) ((double) bnz, Common) ;
+    nbatch = (nthreads > 1) ? (2 * nthreads) : 1 ;
+    cewsize = csize ;
+    if (nbatch > 1)
+    {
+	/* Cew holds the edge weights of all the components in a batch, each
+	 * of size MAX (cn, nnz (C)), for a total of at most n + nnz (B) */
+	cewsize = CHOLMOD(add_size_t) (n, bnz, &ok) ;
+	if (!ok || cewsize >= Int_max)
+	{
+	    /* partition the components one at a time */
+	    nthreads = 1 ;
+	    nbatch = 1 ;
+	    cewsize = csize ;
+	    ok = TRUE ;
+	}
+    }
+
     /* ---------------------------------------------------------------------- */
     /* initializations */
     /* ---------------------------------------------------------------------- */
@@ -1255,17 +1307,21 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 	return (1) ;
     }
 
-    /* Cp and Ci are workspace to construct the subgraphs to partition */
-    C = CHOLMOD(allocate_sparse) (n, n, csize, FALSE, TRUE, 0, CHOLMOD_PATTERN,
-	    Common) ;
-    Cew  = CHOLMOD(malloc) (csize, sizeof (Int), Common) ;
+    /* Cp and Ci are workspace to construct the subgraphs to partition.  Cp
+     * holds the column pointers of up to nbatch subgraphs, with a total of at
+     * most n nodes. */
+    C = CHOLMOD(allocate_sparse) (n, n + nbatch - 1, csize, FALSE, TRUE, 0,
+	    CHOLMOD_PATTERN, Common) ;
+    Cew  = CHOLMOD(malloc) (cewsize, sizeof (Int), Common) ;
+    Task = CHOLMOD(malloc) (nbatch, sizeof (nd_task), Common) ;
 
     if (Common->status < CHOLMOD_OK)
     {
 	/* out of memory */
 	CHOLMOD(free_sparse) (&C, Common) ;
 	CHOLMOD(free_sparse) (&B, Common) ;
-	CHOLMOD(free) (csize, sizeof (Int), Cew, Common) ;
+	CHOLMOD(free) (cewsize, sizeof (Int), Cew, Common) ;
+	CHOLMOD(free) (nbatch, sizeof (nd_task), Task, Common) ;
 	CHOLMOD(free) (3*n, sizeof (Int), Work3n, Common) ;
 	Common->mark = EMPTY ;
 	CHOLMOD_CLEAR_FLAG (Common) ;
@@ -1273,19 +1329,33 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 	return (EMPTY) ;
     }
 
-    Cp = C->p ;
-    Ci = C->i ;
+    Cp0 = C->p ;
+    Ci0 = C->i ;
 
     /* create initial unit node and edge weights */
     for (j = 0 ; j < n ; j++)
     {
 	Bnw [j] = 1 ;
     }
-    for (p = 0 ; p < csize ; p++)
+    for (p = 0 ; p < (Int) cewsize ; p++)
     {
 	Cew [p] = 1 ;
     }
 
+    if (nbatch > 1)
+    {
+	/* each component partitioned in parallel has its own Common object,
+	 * for the memory usage and status of METIS */
+	for (t = 0 ; t < nbatch ; t++)
+	{
+	    CHOLMOD(start) (&(Task [t].Common)) ;
+	    Task [t].Common.metis_memory = Common->metis_memory ;
+	    Task [t].Common.print = Common->print ;
+	    Task [t].Common.try_catch = Common->try_catch ;
+	    Task [t].Common.error_handler = Common->error_handler ;
+	}
+    }
+
     /* push the initial connnected components of B onto the Cstack */
     top = EMPTY ;	/* Cstack is empty */
     /* workspace: Flag (nrow), Iwork (nrow); use Imap as workspace for Queue [*/
@@ -1299,6 +1369,19 @@ SuiteSparse_long CHOLMOD(nested_dissection)
     /* while Cstack is not empty, do: */
     /* ---------------------------------------------------------------------- */
 
+    /* The components on the Cstack are disjoint, and no live edge of B joins
+     * two of them, so they can be partitioned in any order, or at the same
+     * time, without changing the result.  Each iteration pops up to nbatch
+     * components and creates their subgraphs, partitions them (in parallel if
+     * nbatch > 1), and then orders their separators and pushes the new
+     * components onto the Cstack.  With nbatch = 1 this is the usual
+     * depth-first nested dissection. */
+
+    ntasks = 0 ;
+    noff = 0 ;	    /* Map0, Hash0, Cnw0, Part0, Cmap0 [noff..] are free */
+    nzoff = 0 ;	    /* Ci0 [nzoff...] is free */
+    ewoff = 0 ;	    /* Cew [ewoff...] is free */
+
     while (top >= 0)
     {
 
@@ -1307,6 +1390,12 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 
 	DEBUG (for (i = 0 ; i < n ; i++) Imap [i] = EMPTY) ;
 
+	/* the subgraph is placed in the free part of the workspace */
+	Map = Map0 + noff ;
+	Cnw = Cnw0 + noff ;
+	Cp = Cp0 + noff + ntasks ;
+	Ci = Ci0 + nzoff ;
+
 	/* ------------------------------------------------------------------ */
 	/* get node(s) from the top of the Cstack */
 	/* ------------------------------------------------------------------ */
@@ -1396,7 +1485,6 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 	    pstart = Bp [j] ;
 	    pdest = pstart ;
 	    pend = pstart + Bnz [j] ;
-	    hash = cj ;
 	    for (p = pstart ; p < pend ; p++)
 	    {
 		i = Bi [p] ;
@@ -1418,19 +1506,12 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 		    ci = Imap [i] ;
 		    ASSERT (ci >= 0 && ci < cn && ci != cj && cnz < csize) ;
 		    Ci [cnz++] = ci ;
-		    hash += ci ;
 		}
 	    }
 	    /* edges to dead nodes have been removed */
 	    Bnz [j] = pdest - pstart ;
-	    /* finalize the hash key for column j */
-	    hash %= csize ;
-	    Hash [cj] = (Int) hash ;
-	    ASSERT (Hash [cj] >= 0 && Hash [cj] < csize) ;
 	}
 	Cp [cn] = cnz ;
-	C->nrow = cn ;
-	C->ncol = cn ;	/* affects mem stats unless restored when C free'd */
 
 	/* contents of Imap no longer needed ] */
 
@@ -1457,41 +1538,137 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 	PRINT0 (("consider cn %d nd_small %d ", cn, nd_small)) ;
 	if (cn < nd_small)  /* could be 'total_weight < nd_small' instead */
 	{
-	    /* place all nodes in the separator */
+	    /* place all nodes in the separator.  The component remains
+	     * unsplit, and becomes a leaf of the separator tree.  Its part of
+	     * the workspace is reused for the next component. */
 	    PRINT0 ((" too small\n")) ;
-	    sepsize = total_weight ;
+	    for (cj = 0 ; cj < cn ; cj++)
+	    {
+		j = Map [cj] ;
+		Flag [j] = FLIP (cnode) ;
+	    }
+	    ASSERT (Flag [cnode] == FLIP (cnode)) ;
 	}
 	else
 	{
 
 	    /* Cp and Ci now contain the component, with cn nodes and cnz
 	     * nonzeros.  The mapping of a node cj into node j the main graph
-	     * B is given by Map [cj] = j */
+	     * B is given by Map [cj] = j.  Add it to the batch of components
+	     * to partition. */
 	    PRINT0 ((" cut\n")) ;
 
-	    /* -------------------------------------------------------------- */
-	    /* compress and partition the graph C */
-	    /* -------------------------------------------------------------- */
+	    T = Task + ntasks ;
+	    T->C = *C ;
+	    T->C.nrow = cn ;
+	    T->C.ncol = cn ;
+	    T->C.nzmax = MAX (cnz, 1) ;
+	    T->C.p = Cp ;
+	    T->C.i = Ci ;
+	    T->csize = MAX (cn, cnz) ;
+	    T->Map = Map ;
+	    T->Hash = Hash0 + noff ;
+	    T->Cnw = Cnw ;
+	    T->Cmap = Cmap0 + noff ;
+	    T->Part = Part0 + noff ;
+	    T->Cew = Cew + ewoff ;
+	    T->cnode = cnode ;
+	    T->cn = cn ;
+	    T->total_weight = total_weight ;
+	    noff += cn ;
+	    nzoff += cnz ;
+	    ewoff += T->csize ;
+	    ntasks++ ;
+	}
+
+	if (ntasks == 0 || (ntasks < nbatch && top >= 0))
+	{
+	    /* get another component for this batch */
+	    continue ;
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* compress and partition each graph C */
+	/* ------------------------------------------------------------------ */
 
-	    /* The edge weights Cew [0..csize-1] are all 1's on input to and
-	     * output from the partition routine. */
+	/* The edge weights T->Cew [0..T->csize-1] are all 1's on input to and
+	 * output from the partition routine.  Each partition uses only its own
+	 * part of the workspace, and the private Common object of its task if
+	 * nbatch > 1. */
 
-	    sepsize = partition (
+	#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+	for (t = 0 ; t < ntasks ; t++)
+	{
+	    nd_task *Tt = Task + t ;
+	    unsigned Int thash ;
+	    Int *Tp = Tt->C.p, *Ti = Tt->C.i ;
+	    Int tj, tp ;
+	    if (nd_compress)
+	    {
+		/* the hash key of node tj is the sum of tj and its neighbors */
+		for (tj = 0 ; tj < Tt->cn ; tj++)
+		{
+		    thash = tj ;
+		    for (tp = Tp [tj] ; tp < Tp [tj+1] ; tp++)
+		    {
+			thash += Ti [tp] ;
+		    }
+		    Tt->Hash [tj] = (Int) (thash % Tt->csize) ;
+		}
+	    }
+	    if (nbatch > 1)
+	    {
+		Tt->Common.memory_usage = Tt->Common.memory_inuse ;
+	    }
+	    Tt->sepsize = partition (
 #ifndef NDEBUG
-		    csize,
+		    Tt->csize,
 #endif
-		    nd_compress, Hash, C, Cnw, Cew,
-		    Cmap, Part, Common) ;
+		    nd_compress, Tt->Hash, &(Tt->C), Tt->Cnw, Tt->Cew,
+		    Tt->Cmap, Tt->Part, (nbatch > 1) ? &(Tt->Common) : Common) ;
+	}
+
+	if (nbatch > 1)
+	{
+	    /* collect the status and peak memory usage of each partition */
+	    usage = 0 ;
+	    for (t = 0 ; t < ntasks ; t++)
+	    {
+		if (Task [t].Common.status < CHOLMOD_OK)
+		{
+		    Common->status = Task [t].Common.status ;
+		}
+		usage += Task [t].Common.memory_usage ;
+	    }
+	    Common->memory_usage = MAX (Common->memory_usage,
+		Common->memory_inuse + usage) ;
+	}
+
+	/* contents of Cp and Ci no longer needed ] */
+
+	/* ------------------------------------------------------------------ */
+	/* finish each component, in order */
+	/* ------------------------------------------------------------------ */
 
-	    /* contents of Cp and Ci no longer needed ] */
+	for (t = 0 ; t < ntasks ; t++)
+	{
+	    T = Task + t ;
+	    Map = T->Map ;
+	    Hash = T->Hash ;
+	    Cnw = T->Cnw ;
+	    Part = T->Part ;
+	    cnode = T->cnode ;
+	    cn = T->cn ;
+	    total_weight = T->total_weight ;
+	    sepsize = T->sepsize ;
 
 	    if (sepsize < 0)
 	    {
 		/* failed */
-		C->ncol = n ;   /* restore size for memory usage statistics */
 		CHOLMOD(free_sparse) (&C, Common) ;
 		CHOLMOD(free_sparse) (&B, Common) ;
-		CHOLMOD(free) (csize, sizeof (Int), Cew, Common) ;
+		CHOLMOD(free) (cewsize, sizeof (Int), Cew, Common) ;
+		CHOLMOD(free) (nbatch, sizeof (nd_task), Task, Common) ;
 		CHOLMOD(free) (3*n, sizeof (Int), Work3n, Common) ;
 		Common->mark = EMPTY ;
 		CHOLMOD_CLEAR_FLAG (Common) ;
@@ -1526,89 +1703,96 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 
 	    DEBUG (for (cnt = 0, j = 0 ; j < n ; j++) cnt += Bnw [j]) ;
 	    ASSERT (cnt == n) ;
-	}
 
-	/* contents of Cnw [0..cn-1] no longer needed ] */
+	    /* contents of Cnw [0..cn-1] no longer needed ] */
 
-	/* ------------------------------------------------------------------ */
-	/* order the separator, and stack the components when C is split */
-	/* ------------------------------------------------------------------ */
+	    /* -------------------------------------------------------------- */
+	    /* order the separator, and stack the components when C is split */
+	    /* -------------------------------------------------------------- */
 
-	/* one more component has been found: either the separator of C,
-	 * or all of C */
+	    /* one more component has been found: either the separator of C,
+	     * or all of C */
 
-	ASSERT (sepsize >= 0 && sepsize <= total_weight) ;
+	    ASSERT (sepsize >= 0 && sepsize <= total_weight) ;
 
-	PRINT0 (("sepsize %d tot %d : %8.4f ", sepsize, total_weight,
-	    ((double) sepsize) / ((double) total_weight))) ;
+	    PRINT0 (("sepsize %d tot %d : %8.4f ", sepsize, total_weight,
+		((double) sepsize) / ((double) total_weight))) ;
 
-	if (sepsize == total_weight || sepsize == 0 ||
-	    sepsize > nd_oksep * total_weight)
-	{
-	    /* Order the nodes in the component.  The separator is too large,
-	     * or empty.  Note that the partition routine cannot return a
-	     * sepsize of zero, but it can return a separator consisting of the
-	     * whole graph.  The "sepsize == 0" test is kept, above, in case the
-	     * partition routine changes.  In either case, this component
-	     * remains unsplit, and becomes a leaf of the separator tree. */
-	    PRINT2 (("cnode %d sepsize zero or all of graph: "ID"\n",
-		cnode, sepsize)) ;
-	    for (cj = 0 ; cj < cn ; cj++)
+	    if (sepsize == total_weight || sepsize == 0 ||
+		sepsize > nd_oksep * total_weight)
 	    {
-		j = Map [cj] ;
-		Flag [j] = FLIP (cnode) ;
-		PRINT2 (("      node cj: "ID" j: "ID" ordered\n", cj, j)) ;
-	    }
-	    ASSERT (Flag [cnode] == FLIP (cnode)) ;
-	    ASSERT (cnode != EMPTY && Flag [cnode] < EMPTY) ;
-	    PRINT0 (("discarded\n")) ;
-
-	}
-	else
-	{
+		/* Order the nodes in the component.  The separator is too
+		 * large, or empty.  Note that the partition routine cannot
+		 * return a sepsize of zero, but it can return a separator
+		 * consisting of the whole graph.  The "sepsize == 0" test is
+		 * kept, above, in case the partition routine changes.  In
+		 * either case, this component remains unsplit, and becomes a
+		 * leaf of the separator tree. */
+		PRINT2 (("cnode %d sepsize zero or all of graph: "ID"\n",
+		    cnode, sepsize)) ;
+		for (cj = 0 ; cj < cn ; cj++)
+		{
+		    j = Map [cj] ;
+		    Flag [j] = FLIP (cnode) ;
+		    PRINT2 (("      node cj: "ID" j: "ID" ordered\n", cj, j)) ;
+		}
+		ASSERT (Flag [cnode] == FLIP (cnode)) ;
+		ASSERT (cnode != EMPTY && Flag [cnode] < EMPTY) ;
+		PRINT0 (("discarded\n")) ;
 
-	    /* Order the nodes in the separator of C and find a new repnode
-	     * cnode that is in the separator of C.  This requires the separator
-	     * to be non-empty. */
-	    PRINT0 (("sepsize not tiny: "ID"\n", sepsize)) ;
-	    parent = CParent [cnode] ;
-	    ASSERT (parent >= EMPTY && parent < n) ;
-	    CParent [cnode] = -2 ;
-	    cnode = EMPTY ;
-	    for (cj = 0 ; cj < cn ; cj++)
+	    }
+	    else
 	    {
-		j = Map [cj] ;
-		if (Part [cj] == 2)
+
+		/* Order the nodes in the separator of C and find a new
+		 * repnode cnode that is in the separator of C.  This requires
+		 * the separator to be non-empty. */
+		PRINT0 (("sepsize not tiny: "ID"\n", sepsize)) ;
+		parent = CParent [cnode] ;
+		ASSERT (parent >= EMPTY && parent < n) ;
+		CParent [cnode] = -2 ;
+		cnode = EMPTY ;
+		for (cj = 0 ; cj < cn ; cj++)
 		{
-		    /* All nodes in the separator become part of a component
-		     * whose repnode is cnode */
-		    PRINT2 (("node cj: "ID" j: "ID" ordered\n", cj, j)) ;
-		    if (cnode == EMPTY)
+		    j = Map [cj] ;
+		    if (Part [cj] == 2)
+		    {
+			/* All nodes in the separator become part of a component
+			 * whose repnode is cnode */
+			PRINT2 (("node cj: "ID" j: "ID" ordered\n", cj, j)) ;
+			if (cnode == EMPTY)
+			{
+			    PRINT2(("------------new cnode: cj "ID" j "ID"\n",
+					cj, j)) ;
+			    cnode = j ;
+			}
+			Flag [j] = FLIP (cnode) ;
+		    }
+		    else
 		    {
-			PRINT2(("------------new cnode: cj "ID" j "ID"\n",
+			PRINT2 (("      node cj: "ID" j: "ID" not ordered\n",
 				    cj, j)) ;
-			cnode = j ;
 		    }
-		    Flag [j] = FLIP (cnode) ;
-		}
-		else
-		{
-		    PRINT2 (("      node cj: "ID" j: "ID" not ordered\n",
-				cj, j)) ;
 		}
+		ASSERT (cnode != EMPTY && Flag [cnode] < EMPTY) ;
+		ASSERT (CParent [cnode] == -2) ;
+		CParent [cnode] = parent ;
+
+		/* find the connected components when C is split, and push
+		 * them on the Cstack.  Use Imap as workspace for Queue. [ */
+		/* workspace: Flag (nrow) */
+		find_components (B, Map, cn, cnode, Part, Bnz,
+			CParent, Cstack, &top, Imap, Common) ;
+		/* done using Imap as workspace for Queue ] */
 	    }
-	    ASSERT (cnode != EMPTY && Flag [cnode] < EMPTY) ;
-	    ASSERT (CParent [cnode] == -2) ;
-	    CParent [cnode] = parent ;
-
-	    /* find the connected components when C is split, and push
-	     * them on the Cstack.  Use Imap as workspace for Queue. [ */
-	    /* workspace: Flag (nrow) */
-	    find_components (B, Map, cn, cnode, Part, Bnz,
-		    CParent, Cstack, &top, Imap, Common) ;
-	    /* done using Imap as workspace for Queue ] */
+	    /* contents of Map [0..cn-1] no longer needed ] */
 	}
-	/* contents of Map [0..cn-1] no longer needed ] */
+
+	/* the batch is done; all of the workspace is free again */
+	ntasks = 0 ;
+	noff = 0 ;
+	nzoff = 0 ;
+	ewoff = 0 ;
     }
 
     /* done using Cmember as workspace for Cmap ] */
@@ -1688,10 +1872,10 @@ SuiteSparse_long CHOLMOD(nested_dissection)
     /* free workspace */
     /* ---------------------------------------------------------------------- */
 
-    C->ncol = n ;   /* restore size for memory usage statistics */
     CHOLMOD(free_sparse) (&C, Common) ;
     CHOLMOD(free_sparse) (&B, Common) ;
-    CHOLMOD(free) (csize, sizeof (Int), Cew, Common) ;
+    CHOLMOD(free) (cewsize, sizeof (Int), Cew, Common) ;
+    CHOLMOD(free) (nbatch, sizeof (nd_task), Task, Common) ;
     CHOLMOD(free) (3*n, sizeof (Int), Work3n, Common) ;
 
     /* ---------------------------------------------------------------------- */
@@ -51,6 +51,14 @@
  * complex or zomplex.  If L is supernodal numeric on input, its xtype must
  * match A (except that L can be complex and A zomplex).  The xtype of A and F
  * must match.
+ *
+ * If Common->refactor_cache is TRUE and A is symmetric, the first
+ * factorization saves in L->Rmap where each entry of A goes in L, and the
+ * order of the updates from descendant supernodes along with their relative
+ * maps.  Subsequent factorizations of a matrix with the same pattern replay
+ * them, skipping the construction of Map and RelativeMap and the search for
+ * descendants.  L->Rmap is rebuilt if A->nzmax, A->ncol, or A->packed changes,
+ * but other changes to the pattern of A are not detected.
  */
 
 #ifndef NGPL
@@ -63,6 +71,49 @@
 #include "cholmod_gpu.h"
 #endif
 
+/* ========================================================================== */
+/* === refactorization map ================================================== */
+/* ========================================================================== */
+
+/* L->Rmap is a single integer array holding:
+ *
+ *	Rmap [0..RMAP_HEAD-1]	A->nzmax, A->ncol, and A->packed for the A used
+ *				to build the map, and ntask, the number of
+ *				descendant updates
+ *	Amap [0..nzmax-1]	position in L->x of entry p of A, or EMPTY
+ *	Rsp [0..nsuper]		updates to s are Rsp [s] to Rsp [s+1]-1
+ *	Rd [0..ntask-1]		descendant d of each update, in the order used
+ *	Rpos [0..ntask-1]	offset of the first row of d that updates s
+ *	Rn1 [0..ntask-1]	number of rows of d in the columns of s (ndrow1)
+ *	Rp [0..ntask]		relative map of update t is Rrel [Rp [t] ...]
+ *	Rrel [0..Rp[ntask]-1]	row i of the update goes to row Rrel [i] of s
+ */
+
+#define RMAP_HEAD 4
+
+static void get_rmap
+(
+    Int *R,
+    Int nsuper,
+    Int **Amap,
+    Int **Rsp,
+    Int **Rd,
+    Int **Rpos,
+    Int **Rn1,
+    Int **Rp,
+    Int **Rrel
+)
+{
+    Int anz = R [0], ntask = R [3] ;
+    *Amap = R + RMAP_HEAD ;
+    *Rsp  = *Amap + anz ;
+    *Rd   = *Rsp + nsuper + 1 ;
+    *Rpos = *Rd + ntask ;
+    *Rn1  = *Rpos + ntask ;
+    *Rp   = *Rn1 + ntask ;
+    *Rrel = *Rp + ntask + 1 ;
+}
+
 /* ========================================================================== */
 /* === TEMPLATE codes for GPU and regular numeric factorization ============= */
 /* ========================================================================== */
@@ -85,6 +136,177 @@
 #define ZOMPLEX
 #include "t_cholmod_super_numeric.c"
 
+/* ========================================================================== */
+/* === build_rmap =========================================================== */
+/* ========================================================================== */
+
+/* Construct L->Rmap for the symmetric matrix A, by following the same
+ * sequence of descendant updates as t_cholmod_super_numeric, without the
+ * numerical work.  Two passes are made: the first finds the size of L->Rmap
+ * and the second fills it.  SuperMap must already be constructed.  Returns
+ * FALSE if out of memory or if L->Rmap would be too large, in which case
+ * L->Rmap is NULL.
+ *
+ * workspace: Flag (n), Head (n+1), Iwork (2*n + 2*nsuper).  Head is restored
+ *	on output.  Flag is left in an arbitrary state (it is cleared by the
+ *	caller).
+ */
+
+static int build_rmap
+(
+    cholmod_sparse *A,
+    cholmod_factor *L,
+    cholmod_common *Common
+)
+{
+    Int *Ap, *Ai, *Anz, *Super, *Ls, *Lpi, *Lpx, *SuperMap, *Map, *Head,
+	*Next, *Lpos, *R, *Amap, *Rsp, *Rd, *Rpos, *Rn1, *Rp, *Rrel ;
+    Int nsuper, n, s, k, k1, k2, nscol, psi, psx, nsrow, d, dnext, pdi,
+	pdend, pdi1, pdi2, ndrow, ndrow2, p, pend, i, imap, t, dancestor,
+	sparent, pass, packed ;
+    size_t anz, nrel, rsize, w ;
+    int ok = TRUE ;
+
+    nsuper = L->nsuper ;
+    n = L->n ;
+    Super = L->super ;
+    Ls = L->s ;
+    Lpi = L->pi ;
+    Lpx = L->px ;
+
+    Ap = A->p ;
+    Ai = A->i ;
+    Anz = A->nz ;
+    packed = A->packed ;
+    anz = A->nzmax ;
+
+    /* same workspace as t_cholmod_super_numeric */
+    SuperMap = Common->Iwork ;
+    Next = SuperMap + 2*((size_t) n) ;
+    Lpos = SuperMap + 2*((size_t) n) + nsuper ;
+    Map = Common->Flag ;
+    Head = Common->Head ;
+
+    R = NULL ;
+    Amap = NULL ; Rsp = NULL ; Rd = NULL ; Rpos = NULL ; Rn1 = NULL ;
+    Rp = NULL ; Rrel = NULL ;
+    rsize = 0 ;
+    t = 0 ;
+    nrel = 0 ;
+
+    for (pass = 0 ; pass < 2 ; pass++)
+    {
+	t = 0 ;
+	nrel = 0 ;
+	for (s = 0 ; s < nsuper ; s++)
+	{
+	    k1 = Super [s] ;
+	    k2 = Super [s+1] ;
+	    nscol = k2 - k1 ;
+	    psi = Lpi [s] ;
+	    psx = Lpx [s] ;
+	    nsrow = Lpi [s+1] - psi ;
+
+	    if (pass == 1)
+	    {
+		/* construct the scattered Map for supernode s */
+		for (k = 0 ; k < nsrow ; k++)
+		{
+		    Map [Ls [psi + k]] = k ;
+		}
+		/* find where each entry in A(:,k1:k2-1) goes in L->x */
+		for (k = k1 ; k < k2 ; k++)
+		{
+		    p = Ap [k] ;
+		    pend = (packed) ? (Ap [k+1]) : (p + Anz [k]) ;
+		    for ( ; p < pend ; p++)
+		    {
+			i = Ai [p] ;
+			imap = (i >= k) ? Map [i] : EMPTY ;
+			Amap [p] = (imap >= 0 && imap < nsrow) ?
+			    (psx + (k-k1)*nsrow + imap) : EMPTY ;
+		    }
+		}
+		Rsp [s] = t ;
+	    }
+
+	    /* record each update of s by a descendant d */
+	    for (d = Head [s] ; d != EMPTY ; d = dnext)
+	    {
+		dnext = Next [d] ;
+		pdi = Lpi [d] ;
+		pdend = Lpi [d+1] ;
+		ndrow = pdend - pdi ;
+		pdi1 = pdi + Lpos [d] ;
+		for (pdi2 = pdi1 ; pdi2 < pdend && Ls [pdi2] < k2 ; pdi2++) ;
+		ndrow2 = pdend - pdi1 ;
+		if (pass == 1)
+		{
+		    Rd [t] = d ;
+		    Rpos [t] = Lpos [d] ;
+		    Rn1 [t] = pdi2 - pdi1 ;
+		    Rp [t] = nrel ;
+		    for (i = 0 ; i < ndrow2 ; i++)
+		    {
+			Rrel [nrel + i] = Map [Ls [pdi1 + i]] ;
+		    }
+		}
+		t++ ;
+		nrel = CHOLMOD(add_size_t) (nrel, ndrow2, &ok) ;
+
+		/* place d in the link list of its next ancestor */
+		Lpos [d] = pdi2 - pdi ;
+		if (Lpos [d] < ndrow)
+		{
+		    dancestor = SuperMap [Ls [pdi2]] ;
+		    Next [d] = Head [dancestor] ;
+		    Head [dancestor] = d ;
+		}
+	    }
+	    Head [s] = EMPTY ;
+
+	    /* place s in the link list of its parent */
+	    if (nsrow > nscol)
+	    {
+		Lpos [s] = nscol ;
+		sparent = SuperMap [Ls [psi + nscol]] ;
+		Next [s] = Head [sparent] ;
+		Head [sparent] = s ;
+	    }
+	}
+
+	if (pass == 0)
+	{
+	    /* rsize = RMAP_HEAD + anz + (nsuper+1) + 4*ntask + 1 + nrel */
+	    w = CHOLMOD(mult_size_t) (t, 4, &ok) ;
+	    rsize = CHOLMOD(add_size_t) (anz, nsuper + RMAP_HEAD + 2, &ok) ;
+	    rsize = CHOLMOD(add_size_t) (rsize, w, &ok) ;
+	    rsize = CHOLMOD(add_size_t) (rsize, nrel, &ok) ;
+	    if (!ok || rsize > Int_max)
+	    {
+		ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+		return (FALSE) ;
+	    }
+	    R = CHOLMOD(malloc) (rsize, sizeof (Int), Common) ;
+	    if (Common->status < CHOLMOD_OK)
+	    {
+		return (FALSE) ;	/* out of memory */
+	    }
+	    R [0] = anz ;
+	    R [1] = A->ncol ;
+	    R [2] = packed ;
+	    R [3] = t ;
+	    get_rmap (R, nsuper, &Amap, &Rsp, &Rd, &Rpos, &Rn1, &Rp, &Rrel) ;
+	}
+    }
+
+    Rsp [nsuper] = t ;
+    Rp [t] = nrel ;
+    L->Rmap = R ;
+    L->rmapsize = rsize ;
+    return (TRUE) ;
+}
+
 /* ========================================================================== */
 /* === cholmod_super_numeric ================================================ */
 /* ========================================================================== */
@@ -107,10 +329,10 @@ int CHOLMOD(super_numeric)
 )
 {
     cholmod_dense *C ;
-    Int *Super, *Map, *SuperMap ;
+    Int *Super, *Map, *SuperMap, *R ;
     size_t maxcsize ;
     Int nsuper, n, i, k, s, stype, nrow ;
-    int ok = TRUE, symbolic ;
+    int ok = TRUE, symbolic, use_rmap ;
     size_t t, w ;
 
     /* ---------------------------------------------------------------------- */
@@ -174,6 +396,12 @@ int CHOLMOD(super_numeric)
     }
     Common->status = CHOLMOD_OK ;
 
+    /* L is modified, so it cannot be left in a memory map */
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
+
     /* ---------------------------------------------------------------------- */
     /* allocate workspace in Common */
     /* ---------------------------------------------------------------------- */
@@ -274,6 +502,39 @@ int CHOLMOD(super_numeric)
 	}
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* find or construct the refactorization map */
+    /* ---------------------------------------------------------------------- */
+
+    R = L->Rmap ;
+    if (R != NULL && stype != 0 && (R [0] != (Int) A->nzmax ||
+	R [1] != (Int) A->ncol || R [2] != (Int) A->packed))
+    {
+	/* A is not the matrix used to construct L->Rmap */
+	L->Rmap = CHOLMOD(free) (L->rmapsize, sizeof (Int), L->Rmap, Common) ;
+	L->rmapsize = 0 ;
+    }
+
+    use_rmap = (Common->refactor_cache && stype != 0) ;
+#ifdef GPU_BLAS
+    use_rmap = use_rmap && !(Common->useGPU == 1 && L->useGPU) ;
+#endif
+    if (use_rmap && L->Rmap == NULL && !build_rmap (A, L, Common))
+    {
+	int status = Common->status ;
+	Common->mark = EMPTY ;
+	CHOLMOD_CLEAR_FLAG (Common) ;
+	CHOLMOD(free_dense) (&C, Common) ;
+	if (symbolic)
+	{
+	    /* L->x is not initialized; change L back to symbolic */
+	    CHOLMOD(change_factor) (CHOLMOD_PATTERN, TRUE, TRUE, TRUE, TRUE,
+		    L, Common) ;
+	}
+	Common->status = status ;
+	return (FALSE) ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* supernodal numerical factorization, using template routine */
     /* ---------------------------------------------------------------------- */
@@ -146,6 +146,274 @@ static void subtree
 } \
 
 
+/* ========================================================================== */
+/* === supernode_time ======================================================= */
+/* ========================================================================== */
+
+/* Predicted time to factorize a supernode with k columns and m rows in its
+ * leading column, using the machine model in Common->relax_model:
+ *
+ *	model [0]: time for each supernode, regardless of its size (seconds)
+ *	model [1]: peak flop rate of dpotrf/dtrsm/dsyrk (flops per second)
+ *	model [2]: number of columns at which the BLAS reach half that rate
+ *	model [3]: time to assemble one entry of L or of an update (seconds)
+ *
+ * The flop count includes the update the supernode makes to its ancestors,
+ * and the entries moved include the kxm panel itself plus the lower
+ * triangular part of the (m-k)-by-(m-k) update that must be assembled into
+ * the ancestors.
+ */
+
+static double supernode_time
+(
+    double k,
+    double m,
+    double *model
+)
+{
+    double flops, rate, moved ;
+    /* sum of (m-i)^2 for i = 0 to k-1 */
+    flops = k*m*m - m*k*(k-1) + (k-1)*k*(2*k-1) / 6 ;
+    rate = model [1] * k / (k + model [2]) ;
+    moved = k*m + (m-k)*(m-k+1) / 2 ;
+    return (model [0] + flops / rate + model [3] * moved) ;
+}
+
+
+/* ========================================================================== */
+/* === valid_model ========================================================== */
+/* ========================================================================== */
+
+/* Returns TRUE if the machine model is usable */
+
+static int valid_model
+(
+    double *model
+)
+{
+    int k ;
+    for (k = 0 ; k < 4 ; k++)
+    {
+	if (IS_NAN (model [k]) || model [k] < 0)
+	{
+	    return (FALSE) ;
+	}
+    }
+    return (model [1] > 0) ;
+}
+
+
+/* ========================================================================== */
+/* === time_kernel ========================================================== */
+/* ========================================================================== */
+
+/* Measure the time taken by the dense kernel of a supernode with k columns
+ * and m rows (dpotrf of the diagonal block, dtrsm of the rows below it, and
+ * dsyrk to compute the update).  W is m-by-k and C is (m-k)-by-(m-k).  The
+ * best of CALIBRATE_TRIALS trials is returned, the first one being a warm-up
+ * that is discarded.  Zero is returned if dpotrf fails. */
+
+#define CALIBRATE_TIME 1e-3	/* time each trial for at least this long */
+#define CALIBRATE_REPS 10000	/* ... or for at most this many repetitions */
+#define CALIBRATE_TRIALS 4
+
+static double time_kernel
+(
+    Int k,
+    Int m,
+    double *W,
+    double *C,
+    cholmod_common *Common
+)
+{
+    double one [2] = {1,0}, zero [2] = {0,0}, minus_one [2] = {-1,0} ;
+    double tstart, t, tbest = 0 ;
+    Int i, j, reps, info, trial ;
+
+    for (trial = 0 ; trial < CALIBRATE_TRIALS ; trial++)
+    {
+	tstart = SuiteSparse_time ( ) ;
+	reps = 0 ;
+	do
+	{
+	    /* a symmetric positive definite panel */
+	    for (j = 0 ; j < k ; j++)
+	    {
+		for (i = 0 ; i < m ; i++)
+		{
+		    W [i+j*m] = (i == j) ? ((double) m) : (1.0 / (i+j+1)) ;
+		}
+	    }
+	    LAPACK_dpotrf ("L", k, W, m, info) ;
+	    if (info != 0)
+	    {
+		return (0) ;	/* the BLAS failed; cannot calibrate */
+	    }
+	    if (m > k)
+	    {
+		BLAS_dtrsm ("R", "L", "C", "N", m-k, k, one, W, m, W+k, m) ;
+		BLAS_dsyrk ("L", "N", m-k, k, minus_one, W+k, m, zero, C, m-k);
+	    }
+	    reps++ ;
+	    t = SuiteSparse_time ( ) - tstart ;
+	} while (t < CALIBRATE_TIME && reps < CALIBRATE_REPS) ;
+	t /= reps ;
+	if (trial == 1 || (trial > 1 && t < tbest))
+	{
+	    tbest = t ;
+	}
+    }
+    return (tbest) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_super_calibrate ============================================== */
+/* ========================================================================== */
+
+/* Measure the machine model used by cholmod_super_symbolic when
+ * Common->relax_auto is TRUE, and save it in Common->relax_model.  This
+ * takes a few milliseconds.  cholmod_super_symbolic never calls this routine
+ * itself, so the analysis does not depend on any timing.  Call it once, and
+ * keep (or save and restore) Common->relax_model for later analyses;
+ * cholmod_defaults does not reset it.  If the timer cannot resolve the
+ * measurements, Common->relax_model is left unchanged and FALSE is returned.
+ *
+ * workspace: none.  Allocates O(CALIBRATE_M^2) temporary space.
+ */
+
+#define CALIBRATE_M 160		/* # of rows in the dense test panels */
+#define CALIBRATE_K1 4		/* # of columns of a thin panel */
+#define CALIBRATE_K2 64		/* # of columns of a wide panel */
+#define CALIBRATE_R 96		/* size of the update to scatter */
+
+int CHOLMOD(super_calibrate)
+(
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    double *W, *C, model [4] ;
+    double t0, ta, tb, fa, fb, ya, yb, a, b, t, tc, tstart, ka, kb, m ;
+    Int *Map ;
+    Int i, j, k, reps, ld, wsize, csize, trial ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    Common->status = CHOLMOD_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* ---------------------------------------------------------------------- */
+
+    ld = 2 * CALIBRATE_R ;
+    wsize = CALIBRATE_M * CALIBRATE_M ;
+    csize = ld * ld ;
+    W = CHOLMOD(malloc) (wsize, sizeof (double), Common) ;
+    C = CHOLMOD(malloc) (csize, sizeof (double), Common) ;
+    Map = CHOLMOD(malloc) (CALIBRATE_R, sizeof (Int), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free) (wsize, sizeof (double), W, Common) ;
+	CHOLMOD(free) (csize, sizeof (double), C, Common) ;
+	CHOLMOD(free) (CALIBRATE_R, sizeof (Int), Map, Common) ;
+	return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* time the dense kernels */
+    /* ---------------------------------------------------------------------- */
+
+    m = CALIBRATE_M ;
+    ka = CALIBRATE_K1 ;
+    kb = CALIBRATE_K2 ;
+    t0 = time_kernel (1, 2, W, C, Common) ;
+    ta = time_kernel (CALIBRATE_K1, CALIBRATE_M, W, C, Common) ;
+    tb = time_kernel (CALIBRATE_K2, CALIBRATE_M, W, C, Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* time the assembly of an update with a relative map */
+    /* ---------------------------------------------------------------------- */
+
+    for (i = 0 ; i < CALIBRATE_R ; i++)
+    {
+	Map [i] = 2*i + (i % 2) ;
+    }
+    for (i = 0 ; i < csize ; i++)
+    {
+	C [i] = 0 ;
+    }
+    tc = 0 ;
+    for (trial = 0 ; trial < CALIBRATE_TRIALS ; trial++)
+    {
+	tstart = SuiteSparse_time ( ) ;
+	reps = 0 ;
+	do
+	{
+	    for (j = 0 ; j < CALIBRATE_R ; j++)
+	    {
+		for (i = j ; i < CALIBRATE_R ; i++)
+		{
+		    C [Map [i] + Map [j] * ld] -= W [i + j * CALIBRATE_R] ;
+		}
+	    }
+	    reps++ ;
+	    t = SuiteSparse_time ( ) - tstart ;
+	} while (t < CALIBRATE_TIME && reps < CALIBRATE_REPS) ;
+	t /= ((double) reps) * (CALIBRATE_R * (CALIBRATE_R+1) / 2) ;
+	if (trial == 1 || (trial > 1 && t < tc))
+	{
+	    tc = t ;
+	}
+    }
+
+    CHOLMOD(free) (wsize, sizeof (double), W, Common) ;
+    CHOLMOD(free) (csize, sizeof (double), C, Common) ;
+    CHOLMOD(free) (CALIBRATE_R, sizeof (Int), Map, Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* fit the model */
+    /* ---------------------------------------------------------------------- */
+
+    /* The time for k columns is t0 + flops * (a + b/k), where a = 1/rate and
+     * b = kh/rate.  Two panel widths determine a and b. */
+    fa = ka*m*m - m*ka*(ka-1) + (ka-1)*ka*(2*ka-1) / 6 ;
+    fb = kb*m*m - m*kb*(kb-1) + (kb-1)*kb*(2*kb-1) / 6 ;
+    ya = (ta - t0) / fa ;
+    yb = (tb - t0) / fb ;
+    b = (ya - yb) / (1/ka - 1/kb) ;
+    a = yb - b / kb ;
+    if (b < 0 || a <= 0)
+    {
+	/* no measurable dependence on the panel width */
+	a = yb ;
+	b = 0 ;
+    }
+
+    model [0] = t0 ;
+    model [1] = (a > 0) ? (1 / a) : 0 ;
+    model [2] = (a > 0) ? (b / a) : 0 ;
+    model [3] = tc ;
+    PRINT1 (("relax model: t0 %g rate %g kh %g tc %g\n",
+	model [0], model [1], model [2], model [3])) ;
+    if (!valid_model (model) || t0 <= 0 || ta <= 0 || tb <= 0 || tc <= 0)
+    {
+	/* the timer is too coarse to measure the kernels */
+	ERROR (CHOLMOD_INVALID, "unable to calibrate Common->relax_model") ;
+	return (FALSE) ;
+    }
+    for (k = 0 ; k < 4 ; k++)
+    {
+	Common->relax_model [k] = model [k] ;
+    }
+    return (TRUE) ;
+}
+
+
 /* ========================================================================== */
 /* === cholmod_super_symbolic2 ============================================== */
 /* ========================================================================== */
@@ -177,7 +445,7 @@ int CHOLMOD(super_symbolic2)
 	csize, maxcsize, ss, nscol0, nscol1, ns, nfsuper, newzeros, totzeros,
 	merge, snext, esize, maxesize, nrelax0, nrelax1, nrelax2, Asorted ;
     size_t w ;
-    int ok = TRUE, find_xsize ;
+    int ok = TRUE, find_xsize, relax_auto ;
     const char* env_use_gpu;
     const char* env_max_bytes;
     size_t max_bytes;
@@ -212,8 +480,22 @@ int CHOLMOD(super_symbolic2)
 	ERROR (CHOLMOD_INVALID, "L must be symbolic on input") ;
 	return (FALSE) ;
     }
+    relax_auto = Common->relax_auto &&
+	(for_whom == CHOLMOD_ANALYZE_FOR_CHOLESKY) ;
+    if (relax_auto && !valid_model (Common->relax_model))
+    {
+	/* the model must be set by the user or by cholmod_super_calibrate */
+	ERROR (CHOLMOD_INVALID, "invalid Common->relax_model") ;
+	return (FALSE) ;
+    }
     Common->status = CHOLMOD_OK ;
 
+    /* L is modified, so it cannot be left in a memory map */
+    if (!CHOLMOD(unmap_factor) (L, Common))
+    {
+	return (FALSE) ;	/* out of memory */
+    }
+
     /* ---------------------------------------------------------------------- */
     /* allocate workspace */
     /* ---------------------------------------------------------------------- */
@@ -527,7 +809,7 @@ int CHOLMOD(super_symbolic2)
 	lnz1 = (double) (Snz [s+1]) ;	/* # entries in leading column of s+1 */
 
 	/* determine if supernodes s and s+1 should merge */
-	if (ns <= nrelax0)
+	if (ns <= nrelax0 && !relax_auto)
 	{
 	    PRINT2 (("ns is tiny ("ID"), so go ahead and merge\n", ns)) ;
 	    merge = TRUE ;
@@ -568,13 +850,28 @@ int CHOLMOD(super_symbolic2)
 		/* use Int for the final update of Zeros [s] below */
 		totzeros += newzeros ;
 
+		if (relax_auto)
+		{
+		    /* merge if the model predicts that factorizing the merged
+		     * supernode is faster than factorizing s and s+1 apart */
+		    double *model = Common->relax_model ;
+		    double tapart = supernode_time (nscol0, lnz0, model) +
+			supernode_time (nscol1, lnz1, model) ;
+		    double tmerged = supernode_time (xns, nscol0 + lnz1, model) ;
+		    PRINT2 (("tapart %g tmerged %g\n", tapart, tmerged)) ;
+		    merge = (tmerged <= tapart) ;
+		}
+		else
+		{
+		    /* fl.pt. compare, but no NaN's can occur here */
+		    merge = ((ns <= nrelax1 && z < zrelax0) ||
+			     (ns <= nrelax2 && z < zrelax1) ||
+					      (z < zrelax2)) ;
+		}
+
 		/* do not merge if supernode would become too big
 		 * (Int overflow).  Continue computing; not (yet) an error. */
-		/* fl.pt. compare, but no NaN's can occur here */
-		merge = ((ns <= nrelax1 && z < zrelax0) ||
-			 (ns <= nrelax2 && z < zrelax1) ||
-					  (z < zrelax2)) &&
-			(xtotsize < Int_max / sizeof (double)) ;
+		merge = merge && (xtotsize < Int_max / sizeof (double)) ;
 
 	    }
 	}
@@ -108,12 +108,12 @@ static int TEMPLATE (cholmod_super_numeric)
     double *Lx, *Ax, *Fx, *Az, *Fz, *C ;
     Int *Super, *Head, *Ls, *Lpi, *Lpx, *Map, *SuperMap, *RelativeMap, *Next,
         *Lpos, *Fp, *Fi, *Fnz, *Ap, *Ai, *Anz, *Iwork, *Next_save, *Lpos_save,
-        *Previous;
+        *Previous, *Amap, *Rsp, *Rd, *Rpos, *Rn1, *Rp, *Rrel ;
     Int nsuper, n, j, i, k, s, p, pend, k1, k2, nscol, psi, psx, psend, nsrow,
         pj, d, kd1, kd2, info, ndcol, ndrow, pdi, pdx, pdend, pdi1, pdi2, pdx1,
         ndrow1, ndrow2, px, dancestor, sparent, dnext, nsrow2, ndrow3, pk, pf,
         pfend, stype, Apacked, Fpacked, q, imap, repeat_supernode, nscol2, ss,
-        tail, nscol_new = 0;
+        tail, nscol_new = 0, use_rmap, t, tend ;
 
     /* ---------------------------------------------------------------------- */
     /* declarations for the GPU */
@@ -193,6 +193,20 @@ static int TEMPLATE (cholmod_super_numeric)
     /* fprintf (stderr, "local useGPU %d\n", useGPU) ; */
 #endif
 
+    /* replay the A-to-L map and update schedule in L->Rmap, if present */
+    use_rmap = (Common->refactor_cache && L->Rmap != NULL && A->stype != 0) ;
+#ifdef GPU_BLAS
+    use_rmap = use_rmap && !useGPU ;
+#endif
+    Amap = NULL ; Rsp = NULL ; Rd = NULL ; Rpos = NULL ; Rn1 = NULL ;
+    Rp = NULL ; Rrel = NULL ;
+    t = 0 ;
+    tend = 0 ;
+    if (use_rmap)
+    {
+        get_rmap (L->Rmap, nsuper, &Amap, &Rsp, &Rd, &Rpos, &Rn1, &Rp, &Rrel) ;
+    }
+
 #ifndef NTIMER
     /* clear GPU / CPU statistics */
     Common->CHOLMOD_CPU_GEMM_CALLS  = 0 ;
@@ -321,15 +335,23 @@ static int TEMPLATE (cholmod_super_numeric)
         /* ------------------------------------------------------------------ */
 
         /* If row i is the kth row in s, then Map [i] = k.  Similarly, if
-         * column j is the kth column in s, then  Map [j] = k. */
+         * column j is the kth column in s, then  Map [j] = k.  The Map is
+         * not needed if L->Rmap is used (except to check it when debugging).
+         */
+
+#ifdef NDEBUG
+        if (!use_rmap)
+#endif
+        {
 
 #pragma omp parallel for num_threads(CHOLMOD_OMP_NUM_THREADS)   \
     if ( nsrow > 128 )
 
-        for (k = 0 ; k < nsrow ; k++)
-        {
-            PRINT1 (("  "ID" map "ID"\n", Ls [psi+k], k)) ;
-            Map [Ls [psi + k]] = k ;
+            for (k = 0 ; k < nsrow ; k++)
+            {
+                PRINT1 (("  "ID" map "ID"\n", Ls [psi+k], k)) ;
+                Map [Ls [psi + k]] = k ;
+            }
         }
 
         /* ------------------------------------------------------------------ */
@@ -357,7 +379,24 @@ static int TEMPLATE (cholmod_super_numeric)
 
         for (k = k1 ; k < k2 ; k++)
         {
-            if (stype != 0)
+            if (use_rmap)
+            {
+                /* copy the kth column of A into the supernode, using the
+                 * positions saved in L->Rmap */
+                p = Ap [k] ;
+                pend = (Apacked) ? (Ap [k+1]) : (p + Anz [k]) ;
+                for ( ; p < pend ; p++)
+                {
+                    q = Amap [p] ;
+                    if (q != EMPTY)
+                    {
+                        ASSERT (q >= psx && q < psx + nsrow * nscol) ;
+                        /* Lx [q] = Ax [p] ; */
+                        L_ASSIGN (Lx,q, Ax,Az,p) ;
+                    }
+                }
+            }
+            else if (stype != 0)
             {
                 /* copy the kth column of A into the supernode */
                 p = Ap [k] ;
@@ -495,6 +534,14 @@ static int TEMPLATE (cholmod_super_numeric)
         dnext = Head[s];
 #endif
 
+        if (use_rmap)
+        {
+            /* the descendants of s, in the order saved in L->Rmap */
+            t = Rsp [s] ;
+            tend = Rsp [s+1] ;
+            dnext = (t < tend) ? Rd [t] : EMPTY ;
+        }
+
         while
 
 #ifdef GPU_BLAS
@@ -596,7 +643,8 @@ static int TEMPLATE (cholmod_super_numeric)
             /* find the range of rows of d that affect rows k1 to k2-1 of s */
             /* -------------------------------------------------------------- */
 
-            p = Lpos [d] ;          /* offset of 1st row of d affecting s */
+            /* offset of 1st row of d affecting s */
+            p = (use_rmap) ? (Rpos [t]) : (Lpos [d]) ;
             pdi1 = pdi + p ;        /* ptr to 1st row of d affecting s in Ls */
             pdx1 = pdx + p ;        /* ptr to 1st row of d affecting s in Lx */
 
@@ -606,7 +654,14 @@ static int TEMPLATE (cholmod_super_numeric)
                      Lpos[d], pdi1, Ls [pdi1])) ;
             ASSERT (Ls [pdi1] >= k1 && Ls [pdi1] < k2) ;
 
-            for (pdi2 = pdi1 ; pdi2 < pdend && Ls [pdi2] < k2 ; pdi2++) ;
+            if (use_rmap)
+            {
+                pdi2 = pdi1 + Rn1 [t] ;
+            }
+            else
+            {
+                for (pdi2 = pdi1 ; pdi2 < pdend && Ls [pdi2] < k2 ; pdi2++) ;
+            }
             ndrow1 = pdi2 - pdi1 ;      /* # rows in first part of d */
             ndrow2 = pdend - pdi1 ;     /* # rows in remaining d */
 
@@ -740,13 +795,21 @@ static int TEMPLATE (cholmod_super_numeric)
                 DEBUG (CHOLMOD(dump_real) ("C", C, ndrow2, ndrow1, TRUE,
                                            L_ENTRY, Common)) ;
 
+                if (use_rmap)
+                {
+                    RelativeMap = Rrel + Rp [t] ;
+                }
+                else
+                {
+
 #pragma omp parallel for num_threads(CHOLMOD_OMP_NUM_THREADS)   \
     if ( ndrow2 > 64 )
 
-                for (i = 0 ; i < ndrow2 ; i++)
-                {
-                    RelativeMap [i] = Map [Ls [pdi1 + i]] ;
-                    ASSERT (RelativeMap [i] >= 0 && RelativeMap [i] < nsrow) ;
+                    for (i = 0 ; i < ndrow2 ; i++)
+                    {
+                        RelativeMap [i] = Map [Ls [pdi1 + i]] ;
+                        ASSERT (RelativeMap [i] >= 0 && RelativeMap [i] < nsrow);
+                    }
                 }
 
                 /* ---------------------------------------------------------- */
@@ -788,9 +851,18 @@ static int TEMPLATE (cholmod_super_numeric)
             /* prepare this supernode d for its next ancestor */
             /* -------------------------------------------------------------- */
 
-            dnext = Next [d] ;
+            if (use_rmap)
+            {
+                /* the next descendant is given by L->Rmap */
+                t++ ;
+                dnext = (t < tend) ? Rd [t] : EMPTY ;
+            }
+            else
+            {
+                dnext = Next [d] ;
+            }
 
-            if (!repeat_supernode)
+            if (!repeat_supernode && !use_rmap)
             {
                 /* If node s is being repeated, Head [dancestor] has already
                  * been cleared (set to EMPTY).  It must remain EMPTY.  The
@@ -1018,7 +1090,7 @@ static int TEMPLATE (cholmod_super_numeric)
                 ERROR (CHOLMOD_TOO_LARGE, "problem too large for the BLAS") ;
             }
 
-            if (!repeat_supernode)
+            if (!repeat_supernode && !use_rmap)
             {
                 /* Lpos [s] is offset of first row of s affecting its parent */
                 Lpos [s] = nscol ;
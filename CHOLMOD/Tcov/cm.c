@@ -1630,6 +1630,10 @@ int main (int argc, char **argv)
 	MAXERR (maxerr, err, 1) ;
 	printf ("initial solve error %.1g\n", err) ;
 
+	err = solve_r_test (A) ;				/* RAND */
+	MAXERR (maxerr, err, 1) ;
+	printf ("reentrant solve error %.1g\n", err) ;
+
 	/* ------------------------------------------------------------------ */
 	/* CCOLAMD tests */
 	/* ------------------------------------------------------------------ */
@@ -124,6 +124,7 @@ double test_ops (cholmod_sparse *A) ;
 cholmod_dense *xtrue (Int nrow, Int ncol, Int d, Int xtype) ;
 double resid (cholmod_sparse *A, cholmod_dense *X, cholmod_dense *B) ;
 double solve (cholmod_sparse *A) ;
+double solve_r_test (cholmod_sparse *A) ;
 double aug (cholmod_sparse *A) ;
 double do_matrix (cholmod_sparse *A) ;
 cholmod_dense *rhs (cholmod_sparse *A, Int nrhs, Int d) ;
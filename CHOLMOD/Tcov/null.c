@@ -151,9 +151,13 @@ void null_test (cholmod_common *cn)
     L  = CHOLMOD(analyze_p)(A, UserPerm, fset, fsize, cn) ;	NOP (L) ;    
     ok = CHOLMOD(factorize)(A, L, cn) ;				NOT (ok) ;
     ok = CHOLMOD(factorize_p)(A, beta, fset, fsize, L, cn) ;	NOT (ok) ;
+    ok = CHOLMOD(ichol)(A, beta, L, cn) ;			NOT (ok) ;
     rcond = CHOLMOD(rcond)(L, cn) ;				NOT (rcond>=0) ;
     X = CHOLMOD(solve)(sys, L, Y, cn) ;				NOP (X) ;
     C = CHOLMOD(spsolve)(sys, L, B, cn) ;			NOP (C) ;
+    ok = CHOLMOD(solve_r)(sys, L, Y, NULL, &X, NULL, NULL) ;	NOT (ok) ;
+    p = CHOLMOD(allocate_solve_context)(L, cn) ;		NOP (p) ;
+    ok = CHOLMOD(free_solve_context)(NULL, cn) ;		NOT (ok) ;
     ok = CHOLMOD(etree)(A, Parent, cn) ;			NOT (ok) ;
     ok = CHOLMOD(rowcolcounts)(A, fset, fsize, Parent, Post,
 	RowCount, ColCount, First, Level, cn) ;			NOT (ok) ;
@@ -213,6 +217,7 @@ void null_test (cholmod_common *cn)
     ok = CHOLMOD(super_numeric)(A, F, beta, L, cn) ;		NOT (ok) ;
     ok = CHOLMOD(super_lsolve)(L, X, E, cn) ;			NOT (ok) ;
     ok = CHOLMOD(super_ltsolve)(L, X, E, cn) ;			NOT (ok) ;
+    ok = CHOLMOD(super_calibrate)(cn) ;				NOT (ok) ;
 
     /* ---------------------------------------------------------------------- */
     /* Check */
@@ -248,6 +253,11 @@ void null_test (cholmod_common *cn)
     asym = CHOLMOD(write_sparse)((FILE *) 1, NULL, NULL, NULL,
 	    cn) ;						NOT (asym>=0) ;
 
+    ok = CHOLMOD(save_factor)(NULL, NULL, cn) ;			NOT (ok) ;
+    ok = CHOLMOD(save_factor)((FILE *) 1, NULL, cn) ;		NOT (ok) ;
+    L = CHOLMOD(load_factor)(NULL, cn) ;			NOP (L) ;
+    ok = CHOLMOD(unmap_factor)(NULL, cn) ;			NOT (ok) ;
+
     /* ---------------------------------------------------------------------- */
     /* Partition */
     /* ---------------------------------------------------------------------- */
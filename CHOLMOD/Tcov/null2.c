@@ -31,7 +31,9 @@ void null2 (cholmod_triplet *Tok, int do_nantests)
 	*I7, *C2, *R2, *Z ;
     cholmod_dense *Xok, *Bok, *Two, *X, *W, *XX, *YY, *Xbad2, *B, *Scale,
 	*Y, *X1, *B1, *B2, *X7, *B7 ; 
-    cholmod_factor *L, *L2, *L3, *L4, *L5, *L6, *Lcopy, *Lbad, *L7 ;
+    cholmod_factor *L, *L2, *L3, *L4, *L5, *L6, *Lcopy, *Lbad, *L7,
+	*Lload ;
+    cholmod_solve_context *Context ;
     cholmod_triplet *T, *T2, *Tz, *T3 ;
     Int *fsetok, *Pok, *Flag, *Head, *Cp, *Ci, *P2, *Parent, *Lperm,
 	*Lp, *Li, *Lnz, *Lprev, *Lnext, *Ls, *Lpi, *Lpx, *Super, *Tj, *Ti,
@@ -1364,6 +1366,28 @@ void null2 (cholmod_triplet *Tok, int do_nantests)
     ok = CHOLMOD(change_factor)(L->xtype, FALSE, FALSE, TRUE,
 	    TRUE, L3, cm) ;
     ok = CHOLMOD(print_factor)(L3, "L3 OK", cm) ;		    OK (ok) ;
+
+    /* save and load LDL' packed */
+    f = fopen ("temp7.bin", "wb") ;
+    ok = CHOLMOD(save_factor)(f, L3, cm) ;			    OK (ok) ;
+    fclose (f) ;
+    f = fopen ("temp7.bin", "rb") ;
+    Lload = CHOLMOD(load_factor)(f, cm) ;			    OKP (Lload) ;
+    fclose (f) ;
+    ok = CHOLMOD(print_factor)(Lload, "Lload OK", cm) ;	    OK (ok) ;
+    ok = CHOLMOD(change_factor)(L->xtype, FALSE, FALSE, FALSE,
+	    TRUE, Lload, cm) ;					    OK (ok) ;
+    OK (Lload->mmap_base == NULL) ;
+    CHOLMOD(free_factor)(&Lload, cm) ;
+    f = fopen ("temp7.bin", "rb") ;
+    Lload = CHOLMOD(load_factor)(f, cm) ;			    OKP (Lload) ;
+    fclose (f) ;
+    CHOLMOD(free_factor)(&Lload, cm) ;
+    f = fopen ("temp7.bin", "rb") ;
+    fgetc (f) ;
+    Lload = CHOLMOD(load_factor)(f, cm) ;			    NOP (Lload) ;
+    fclose (f) ;
+
     CHOLMOD(free_factor)(&L3, cm) ;				    OK (ok) ;
     ok = CHOLMOD(print_factor)(L2, "L2 OK", cm) ;		    OK (ok) ;
     ok = CHOLMOD(pack_factor)(L2, cm) ;				    OK (ok) ;
@@ -1771,6 +1795,17 @@ void null2 (cholmod_triplet *Tok, int do_nantests)
     X = CHOLMOD(solve)(CHOLMOD_A, L, B, cm) ;			    OKP (X) ;
     ok = CHOLMOD(free_dense)(&X, cm) ;				    OK (ok) ;
 
+    /* reentrant solve */
+    Context = CHOLMOD(allocate_solve_context)(L, cm) ;		    OKP (Context) ;
+    ok = CHOLMOD(solve_r)(CHOLMOD_A, L, B, NULL, &X, NULL, Context) ;
+    OK (ok || Context->Common.status == CHOLMOD_NOT_POSDEF) ;
+    ok = CHOLMOD(solve_r)(CHOLMOD_Pt, L, B, NULL, &X, NULL, Context) ;
+    OK (ok || Context->Common.status == CHOLMOD_NOT_POSDEF) ;
+    ok = CHOLMOD(solve_r)(-1, L, B, NULL, &X, NULL, Context) ;	    NOT (ok) ;
+    ok = CHOLMOD(free_dense)(&X, &(Context->Common)) ;		    OK (ok) ;
+    ok = CHOLMOD(free_solve_context)(&Context, cm) ;		    OK (ok) ;
+    OK (Context == NULL) ;
+
     X = CHOLMOD(solve)(-1, L, B, cm) ;				    NOP (X) ;
     ok = CHOLMOD(free_dense)(&B, cm) ;				    OK (ok) ;
 
@@ -10,6 +10,7 @@
 /* Test CHOLMOD for solving various systems of linear equations. */
 
 #include "cm.h"
+#include <string.h>
 
 #define NFTYPES 17
 Int ll_types [NFTYPES] = { 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0 } ;
@@ -34,8 +35,9 @@ EXTERN int cholmod_dump, cholmod_l_dump ;
 
 double test_solver (cholmod_sparse *A)
 {
-    double err, maxerr = 0 ;
-    int save ;
+    double err, maxerr = 0, model [4] ;
+    cholmod_factor *L1, *L2 ;
+    int save, k ;
 
     for (cm->postorder = 0 ; cm->postorder <= 1 ; cm->postorder++)
     {
@@ -120,6 +122,88 @@ cm->default_nesdis = FALSE ;
 	MAXERR (maxerr, err, 1) ;
 	printf ("test_solver err: %6.2e\n", err) ;
 
+	/* supernodal, with amalgamation from the measured machine model */
+	printf ("test_solver: supernodal, automatic amalgamation\n") ;
+	cm->relax_auto = TRUE ;
+	for (k = 0 ; k < 4 ; k++)
+	{
+	    model [k] = cm->relax_model [k] ;
+	}
+	{
+	    void (*handler) (int, const char *, int, const char *) ;
+	    handler = cm->error_handler ;
+	    cm->error_handler = NULL ;
+	    if (CHOLMOD(super_calibrate) (cm))
+	    {
+		OK (cm->relax_model [1] > 0) ;
+	    }
+	    else
+	    {
+		/* the timer is too coarse, or out of memory; set it by hand */
+		OK (cm->status == CHOLMOD_INVALID
+		    || cm->status == CHOLMOD_OUT_OF_MEMORY) ;
+		cm->relax_model [0] = 1e-6 ;
+		cm->relax_model [1] = 1e9 ;
+		cm->relax_model [2] = 32 ;
+		cm->relax_model [3] = 2e-9 ;
+	    }
+	    cm->error_handler = handler ;
+	}
+	err = solve (A) ;
+	MAXERR (maxerr, err, 1) ;
+	printf ("test_solver err: %6.2e\n", err) ;
+
+	/* the analysis does not time anything, so it is repeatable */
+	L1 = CHOLMOD(analyze) (A, cm) ;
+	L2 = CHOLMOD(analyze) (A, cm) ;
+	if (L1 != NULL && L2 != NULL && L1->is_super)
+	{
+	    OK (L2->is_super && L1->nsuper == L2->nsuper) ;
+	    OK (memcmp (L1->super, L2->super,
+		(L1->nsuper+1) * sizeof (Int)) == 0) ;
+	}
+	CHOLMOD(free_factor) (&L1, cm) ;
+	CHOLMOD(free_factor) (&L2, cm) ;
+
+	/* a model with a high cost per supernode, which merges aggressively */
+	cm->relax_model [0] = 1 ;
+	cm->relax_model [1] = 1e9 ;
+	cm->relax_model [2] = 0 ;
+	cm->relax_model [3] = 0 ;
+	err = solve (A) ;
+	MAXERR (maxerr, err, 1) ;
+	printf ("test_solver err: %6.2e\n", err) ;
+
+	/* an invalid model, or one that was never set, is an error */
+	if (A != NULL)
+	{
+	    void (*handler) (int, const char *, int, const char *) ;
+	    handler = cm->error_handler ;
+	    cm->error_handler = NULL ;
+	    cm->relax_model [1] = 0 ;
+	    L1 = CHOLMOD(analyze) (A, cm) ;
+	    OK (L1 == NULL) ;
+	    OK (cm->status == CHOLMOD_INVALID
+		|| cm->status == CHOLMOD_OUT_OF_MEMORY) ;
+	    CHOLMOD(free_factor) (&L1, cm) ;
+	    for (k = 0 ; k < 4 ; k++)
+	    {
+		cm->relax_model [k] = 0 ;
+	    }
+	    L1 = CHOLMOD(analyze) (A, cm) ;
+	    OK (L1 == NULL) ;
+	    OK (cm->status == CHOLMOD_INVALID
+		|| cm->status == CHOLMOD_OUT_OF_MEMORY) ;
+	    CHOLMOD(free_factor) (&L1, cm) ;
+	    cm->error_handler = handler ;
+	}
+
+	for (k = 0 ; k < 4 ; k++)
+	{
+	    cm->relax_model [k] = model [k] ;
+	}
+	cm->relax_auto = FALSE ;
+
 	/* ------------------------------------------------------------------ */
 	/* restore defaults */
 	/* ------------------------------------------------------------------ */
@@ -144,6 +228,7 @@ cm->default_nesdis = FALSE ;
 	cm->zrelax [0] = 0.8 ;
 	cm->zrelax [1] = 0.1 ;
 	cm->zrelax [2] = 0.05 ;
+	cm->relax_auto = FALSE ;
 
 	/* do not restore these defaults: */
 	/*
@@ -161,6 +246,222 @@ cm->default_nesdis = FALSE ;
 }
 
 
+/* ========================================================================== */
+/* === tril_pattern ========================================================= */
+/* ========================================================================== */
+
+/* Return the pattern of tril (A(p,p)) plus the diagonal, with sorted columns,
+ * for a symmetric matrix A. */
+
+static cholmod_sparse *tril_pattern (cholmod_sparse *A, Int *Perm)
+{
+    cholmod_sparse *F, *C, *T, *I, *G ;
+    Int n = A->nrow ;
+    F = CHOLMOD(copy) (A, 0, 0, cm) ;
+    C = CHOLMOD(submatrix) (F, Perm, n, Perm, n, FALSE, TRUE, cm) ;
+    T = CHOLMOD(band) (C, -n, 0, 0, cm) ;
+    I = CHOLMOD(speye) (n, n, CHOLMOD_PATTERN, cm) ;
+    G = CHOLMOD(add) (T, I, one, one, FALSE, TRUE, cm) ;
+    CHOLMOD(free_sparse) (&F, cm) ;
+    CHOLMOD(free_sparse) (&C, cm) ;
+    CHOLMOD(free_sparse) (&T, cm) ;
+    CHOLMOD(free_sparse) (&I, cm) ;
+    return (G) ;
+}
+
+
+/* ========================================================================== */
+/* === factor_pattern ======================================================= */
+/* ========================================================================== */
+
+/* Return the pattern of a simplicial numeric factor L, with sorted columns.
+ * L is not modified. */
+
+static cholmod_sparse *factor_pattern (cholmod_factor *L)
+{
+    cholmod_factor *Lcopy ;
+    cholmod_sparse *S ;
+    Lcopy = CHOLMOD(copy_factor) (L, cm) ;
+    S = CHOLMOD(factor_to_sparse) (Lcopy, cm) ;
+    CHOLMOD(free_factor) (&Lcopy, cm) ;
+    return (S) ;
+}
+
+
+/* ========================================================================== */
+/* === has_pattern ========================================================== */
+/* ========================================================================== */
+
+/* Return TRUE if every entry in the pattern of G is also in S.  Both must be
+ * packed, with sorted columns. */
+
+static Int has_pattern (cholmod_sparse *S, cholmod_sparse *G)
+{
+    Int *Sp, *Si, *Gp, *Gi ;
+    Int j, p, pg ;
+    if (S == NULL || G == NULL || S->ncol != G->ncol)
+    {
+	return (FALSE) ;
+    }
+    Sp = S->p ;
+    Si = S->i ;
+    Gp = G->p ;
+    Gi = G->i ;
+    for (j = 0 ; j < (Int) G->ncol ; j++)
+    {
+	p = Sp [j] ;
+	for (pg = Gp [j] ; pg < Gp [j+1] ; pg++)
+	{
+	    while (p < Sp [j+1] && Si [p] < Gi [pg])
+	    {
+		p++ ;
+	    }
+	    if (p == Sp [j+1] || Si [p] != Gi [pg])
+	    {
+		return (FALSE) ;
+	    }
+	}
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === pcg ================================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b with the preconditioned conjugate gradient method, with the
+ * preconditioner L (or none if L is NULL), for a real symmetric positive
+ * definite A.  Returns the number of iterations needed to reduce norm (b-A*x)
+ * to 1e-8 * norm (b), or -1 if this takes more than maxit. */
+
+static Int pcg (cholmod_sparse *A, cholmod_factor *L, cholmod_dense *B,
+    Int maxit)
+{
+    cholmod_dense *X, *R, *Z, *P, *Q ;
+    double *Xx, *Rx, *Zx, *Px, *Qx, rz, rz2, alpha, pq, bnorm, rnorm ;
+    Int i, n, iter, result = -1 ;
+
+    n = A->nrow ;
+    X = CHOLMOD(zeros) (n, 1, CHOLMOD_REAL, cm) ;
+    R = CHOLMOD(copy_dense) (B, cm) ;
+    P = CHOLMOD(zeros) (n, 1, CHOLMOD_REAL, cm) ;
+    Q = CHOLMOD(zeros) (n, 1, CHOLMOD_REAL, cm) ;
+    Z = NULL ;
+    Xx = X->x ;
+    Rx = R->x ;
+    Px = P->x ;
+    Qx = Q->x ;
+    bnorm = CHOLMOD(norm_dense) (B, 2, cm) ;
+    rz = 0 ;
+
+    for (iter = 0 ; iter <= maxit ; iter++)
+    {
+	rnorm = CHOLMOD(norm_dense) (R, 2, cm) ;
+	if (rnorm <= 1e-8 * bnorm)
+	{
+	    result = iter ;
+	    break ;
+	}
+
+	/* z = M\r */
+	CHOLMOD(free_dense) (&Z, cm) ;
+	Z = (L == NULL) ? CHOLMOD(copy_dense) (R, cm) :
+	    CHOLMOD(solve) (CHOLMOD_A, L, R, cm) ;
+	Zx = Z->x ;
+	rz2 = rz ;
+	rz = 0 ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    rz += Rx [i] * Zx [i] ;
+	}
+
+	/* p = z + (rz/rz2)*p */
+	for (i = 0 ; i < n ; i++)
+	{
+	    Px [i] = Zx [i] + ((iter == 0) ? 0 : (rz / rz2) * Px [i]) ;
+	}
+
+	/* q = A*p, x = x + alpha*p, r = r - alpha*q */
+	CHOLMOD(sdmult) (A, FALSE, one, zero, P, Q, cm) ;
+	pq = 0 ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    pq += Px [i] * Qx [i] ;
+	}
+	alpha = rz / pq ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    Xx [i] += alpha * Px [i] ;
+	    Rx [i] -= alpha * Qx [i] ;
+	}
+    }
+
+    /* the true residual must be small too */
+    if (result >= 0)
+    {
+	CHOLMOD(copy_dense2) (B, R, cm) ;
+	CHOLMOD(sdmult) (A, FALSE, minusone, one, X, R, cm) ;
+	OK (CHOLMOD(norm_dense) (R, 2, cm) <= 1e-6 * bnorm) ;
+    }
+
+    CHOLMOD(free_dense) (&X, cm) ;
+    CHOLMOD(free_dense) (&R, cm) ;
+    CHOLMOD(free_dense) (&Z, cm) ;
+    CHOLMOD(free_dense) (&P, cm) ;
+    CHOLMOD(free_dense) (&Q, cm) ;
+    return (result) ;
+}
+
+
+/* ========================================================================== */
+/* === laplacian ============================================================ */
+/* ========================================================================== */
+
+/* Return the 2D Laplacian on an m-by-m grid, a symmetric positive definite
+ * matrix of order m^2 with its upper triangular part stored. */
+
+static cholmod_sparse *laplacian (Int m)
+{
+    cholmod_triplet *T ;
+    cholmod_sparse *A ;
+    double *Tx ;
+    Int *Ti, *Tj ;
+    Int i, j, k, nz ;
+    T = CHOLMOD(allocate_triplet) (m*m, m*m, 3*m*m, 1, CHOLMOD_REAL, cm) ;
+    Ti = T->i ;
+    Tj = T->j ;
+    Tx = T->x ;
+    nz = 0 ;
+    for (j = 0 ; j < m ; j++)
+    {
+	for (i = 0 ; i < m ; i++)
+	{
+	    k = i + j*m ;
+	    Ti [nz] = k ;
+	    Tj [nz] = k ;
+	    Tx [nz++] = 4 ;
+	    if (i > 0)
+	    {
+		Ti [nz] = k-1 ;
+		Tj [nz] = k ;
+		Tx [nz++] = -1 ;
+	    }
+	    if (j > 0)
+	    {
+		Ti [nz] = k-m ;
+		Tj [nz] = k ;
+		Tx [nz++] = -1 ;
+	    }
+	}
+    }
+    T->nnz = nz ;
+    A = CHOLMOD(triplet_to_sparse) (T, 0, cm) ;
+    CHOLMOD(free_triplet) (&T, cm) ;
+    return (A) ;
+}
+
+
 /* ========================================================================== */
 /* === solve ================================================================ */
 /* ========================================================================== */
@@ -1609,6 +1910,270 @@ double solve (cholmod_sparse *A)
 	cm->supernodal = save6 ;
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* test supernodal refactorization with L->Rmap */
+    /* ---------------------------------------------------------------------- */
+
+    if (A->stype != 0 && n > 0 && n < NLARGE)
+    {
+	Int save12, save13, save14 ;
+	int ok ;
+	save12 = cm->supernodal ;
+	save13 = cm->refactor_cache ;
+	save14 = cm->final_asis ;
+	cm->supernodal = CHOLMOD_SUPERNODAL ;
+	cm->refactor_cache = TRUE ;
+	cm->final_asis = TRUE ;
+
+	B = rhs (A, 1, n) ;
+	L = CHOLMOD(analyze) (A, cm) ;
+
+	/* the first factorization constructs L->Rmap, the second uses it */
+	for (k = 0 ; k < 2 ; k++)
+	{
+	    ok = CHOLMOD(factorize) (A, L, cm) ;
+	    if (ok)
+	    {
+		OK (L->is_super && L->Rmap != NULL) ;
+	    }
+	    if (cm->status == CHOLMOD_OK)
+	    {
+		X = CHOLMOD(solve) (CHOLMOD_A, L, B, cm) ;
+		r = resid (A, X, B) ;
+		MAXERR (maxerr, r, 1) ;
+		CHOLMOD(free_dense) (&X, cm) ;
+	    }
+	}
+
+	/* A+I has a different pattern, so L->Rmap is rebuilt */
+	if (isreal)
+	{
+	    I = CHOLMOD(speye) (n, n, CHOLMOD_REAL, cm) ;
+	    S = CHOLMOD(add) (A, I, one, one, TRUE, TRUE, cm) ;
+	    if (S != NULL)
+	    {
+		S->stype = A->stype ;
+	    }
+	    CHOLMOD(factorize) (S, L, cm) ;
+	    if (cm->status == CHOLMOD_OK)
+	    {
+		X = CHOLMOD(solve) (CHOLMOD_A, L, B, cm) ;
+		r = resid (S, X, B) ;
+		MAXERR (maxerr, r, 1) ;
+		CHOLMOD(free_dense) (&X, cm) ;
+	    }
+	    CHOLMOD(free_sparse) (&S, cm) ;
+	    CHOLMOD(free_sparse) (&I, cm) ;
+	}
+
+	/* a copy of L does not have L->Rmap, nor does a simplicial L */
+	Lcopy = CHOLMOD(copy_factor) (L, cm) ;
+	OK (Lcopy == NULL || Lcopy->Rmap == NULL) ;
+	CHOLMOD(free_factor) (&Lcopy, cm) ;
+	if (L != NULL)
+	{
+	    ok = CHOLMOD(change_factor) (L->xtype, FALSE, FALSE, TRUE, TRUE, L,
+		cm) ;
+	    OK (!ok || L->Rmap == NULL) ;
+	}
+
+	CHOLMOD(free_factor) (&L, cm) ;
+	CHOLMOD(free_dense) (&B, cm) ;
+
+	cm->supernodal = save12 ;
+	cm->refactor_cache = save13 ;
+	cm->final_asis = save14 ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* test ichol */
+    /* ---------------------------------------------------------------------- */
+
+    if (isreal && A->stype != 0 && n > 0 && n < NLARGE)
+    {
+	double save7, save12, beta [2], *Lx ;
+	Int save8, save9, save10, save11, lnz, it0, it1 ;
+	cholmod_sparse *G ;
+	int ok ;
+	save7 = cm->ichol_droptol ;
+	save8 = cm->ichol_level ;
+	save9 = cm->ichol_maxfill ;
+	save10 = cm->final_asis ;
+	save11 = cm->final_ll ;
+	save12 = cm->dbound ;
+
+	B = rhs (A, 1, n) ;
+	L = CHOLMOD(analyze) (A, cm) ;
+	G = NULL ;
+	beta [0] = 0 ;
+	beta [1] = 0 ;
+
+	/* with no dropping, ichol is a complete factorization */
+	cm->ichol_droptol = 0 ;
+	cm->ichol_level = -1 ;
+	cm->ichol_maxfill = -1 ;
+	cm->final_asis = FALSE ;
+	cm->final_ll = FALSE ;
+	ok = CHOLMOD(ichol) (A, beta, L, cm) ;
+	if (ok && cm->status == CHOLMOD_OK)
+	{
+	    OK (!L->is_super && !L->is_ll && L->minor == (size_t) n) ;
+	    X = CHOLMOD(solve) (CHOLMOD_A, L, B, cm) ;
+	    r = resid (A, X, B) ;
+	    MAXERR (maxerr, r, 1) ;
+	    CHOLMOD(free_dense) (&X, cm) ;
+	}
+
+	/* IC(0), shifted so that it cannot break down */
+	beta [0] = 1 + CHOLMOD(norm_sparse) (A, 1, cm) ;
+	cm->ichol_level = 0 ;
+	cm->final_ll = TRUE ;
+	ok = CHOLMOD(ichol) (A, beta, L, cm) ;
+	if (ok)
+	{
+	    OK (cm->status == CHOLMOD_OK && L->minor == (size_t) n && L->is_ll);
+	    Lp = L->p ;
+	    lnz = Lp [n] ;
+	    OK (lnz <= CHOLMOD(nnz) (A, cm) + n) ;
+	    X = CHOLMOD(solve) (CHOLMOD_A, L, B, cm) ;
+	    CHOLMOD(free_dense) (&X, cm) ;
+
+	    /* turn off memory tests [ */
+	    save3 = my_tries ;
+	    my_tries = -1 ;
+
+	    /* IC(0) has exactly the pattern of tril (A(p,p)) */
+	    OK (L->is_incomplete) ;
+	    G = tril_pattern (A, L->Perm) ;
+	    S = factor_pattern (L) ;
+	    OK (has_pattern (S, G) && has_pattern (G, S)) ;
+	    CHOLMOD(free_sparse) (&S, cm) ;
+
+	    /* IC(1) contains the pattern of IC(0) */
+	    cm->ichol_level = 1 ;
+	    ok = CHOLMOD(ichol) (A, beta, L, cm) ;
+	    OK (ok && cm->status == CHOLMOD_OK && L->minor == (size_t) n) ;
+	    S = factor_pattern (L) ;
+	    OK (has_pattern (S, G)) ;
+	    CHOLMOD(free_sparse) (&S, cm) ;
+
+	    /* with no other dropping, maxfill limits each column of L */
+	    for (k = 0 ; k <= 2 ; k++)
+	    {
+		cm->ichol_level = -1 ;
+		cm->ichol_maxfill = k ;
+		ok = CHOLMOD(ichol) (A, beta, L, cm) ;
+		OK (ok && cm->status == CHOLMOD_OK && L->minor == (size_t) n) ;
+		S = factor_pattern (L) ;
+		OKP (S) ;
+		Lp = S->p ;
+		P = G->p ;
+		for (j = 0 ; j < n ; j++)
+		{
+		    OK (Lp [j+1] - Lp [j] <= P [j+1] - P [j] + k) ;
+		}
+		CHOLMOD(free_sparse) (&S, cm) ;
+	    }
+	    cm->ichol_level = 0 ;
+	    cm->ichol_maxfill = -1 ;
+
+	    /* turn memory tests back on, where we left off ] */
+	    my_tries = save3 ;
+	}
+
+	/* ICT, with at most one fill-in entry per column */
+	cm->ichol_level = -1 ;
+	cm->ichol_droptol = 1e-3 ;
+	cm->ichol_maxfill = 1 ;
+	ok = CHOLMOD(ichol) (A, beta, L, cm) ;
+	OK (!ok || (cm->status == CHOLMOD_OK && L->minor == (size_t) n)) ;
+	if (ok && G != NULL)
+	{
+	    save3 = my_tries ;
+	    my_tries = -1 ;
+	    S = factor_pattern (L) ;
+	    OKP (S) ;
+	    Lp = S->p ;
+	    P = G->p ;
+	    for (j = 0 ; j < n ; j++)
+	    {
+		OK (Lp [j+1] - Lp [j] <= P [j+1] - P [j] + 1) ;
+	    }
+	    CHOLMOD(free_sparse) (&S, cm) ;
+	    my_tries = save3 ;
+	}
+
+	/* IC(1) of the unshifted matrix, which may break down */
+	beta [0] = 0 ;
+	cm->ichol_level = 1 ;
+	cm->ichol_droptol = 0 ;
+	cm->ichol_maxfill = -1 ;
+	cm->final_asis = TRUE ;
+	ok = CHOLMOD(ichol) (A, beta, L, cm) ;
+	OK (!ok || L->minor == (size_t) n || cm->status == CHOLMOD_NOT_POSDEF) ;
+
+	CHOLMOD(free_factor) (&L, cm) ;
+	CHOLMOD(free_dense) (&B, cm) ;
+	CHOLMOD(free_sparse) (&G, cm) ;
+
+	/* turn off memory tests [ */
+	save3 = my_tries ;
+	my_tries = -1 ;
+
+	/* IC(0) reduces the number of PCG iterations for a 2D Laplacian */
+	S = laplacian (20) ;
+	OKP (S) ;
+	save = cm->nmethods ;
+	save2 = cm->method [0].ordering ;
+	cm->nmethods = 1 ;
+	cm->method [0].ordering = CHOLMOD_NATURAL ;
+	L = CHOLMOD(analyze) (S, cm) ;
+	cm->nmethods = save ;
+	cm->method [0].ordering = save2 ;
+	OKP (L) ;
+	B = CHOLMOD(ones) (S->nrow, 1, CHOLMOD_REAL, cm) ;
+	beta [0] = 0 ;
+	cm->ichol_level = 0 ;
+	cm->ichol_droptol = 0 ;
+	cm->ichol_maxfill = -1 ;
+	cm->final_asis = TRUE ;
+	ok = CHOLMOD(ichol) (S, beta, L, cm) ;
+	OK (ok && cm->status == CHOLMOD_OK && L->minor == S->nrow) ;
+	it0 = pcg (S, NULL, B, 10 * S->nrow) ;
+	it1 = pcg (S, L, B, 10 * S->nrow) ;
+	printf ("PCG iterations: %ld without, %ld with IC(0)\n",
+	    (long) it0, (long) it1) ;
+	OK (it0 > 0 && it1 > 0 && it1 < it0) ;
+
+	/* with dbound, the negative pivots of S-8*I keep their sign */
+	beta [0] = -8 ;
+	cm->dbound = 1e-3 ;
+	ok = CHOLMOD(ichol) (S, beta, L, cm) ;
+	OK (ok && cm->status == CHOLMOD_OK && L->minor == S->nrow) ;
+	OK (!L->is_ll) ;
+	Lp = L->p ;
+	Lx = L->x ;
+	OK (Lx [Lp [0]] == -4) ;
+	for (j = 0 ; j < (Int) S->nrow ; j++)
+	{
+	    OK (Lx [Lp [j]] < 0) ;
+	}
+	cm->dbound = save12 ;
+
+	CHOLMOD(free_factor) (&L, cm) ;
+	CHOLMOD(free_dense) (&B, cm) ;
+	CHOLMOD(free_sparse) (&S, cm) ;
+
+	/* turn memory tests back on, where we left off ] */
+	my_tries = save3 ;
+
+	cm->ichol_droptol = save7 ;
+	cm->ichol_level = save8 ;
+	cm->ichol_maxfill = save9 ;
+	cm->final_asis = save10 ;
+	cm->final_ll = save11 ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* free remaining workspace */
     /* ---------------------------------------------------------------------- */
@@ -1617,3 +2182,343 @@ double solve (cholmod_sparse *A)
     progress (0, '.') ;
     return (maxerr) ;
 }
+
+
+/* ========================================================================== */
+/* === same_dense =========================================================== */
+/* ========================================================================== */
+
+/* Return TRUE if X and Y have the same type and size, and bit-for-bit
+ * identical entries. */
+
+static Int same_dense (cholmod_dense *X, cholmod_dense *Y)
+{
+    double *Xx, *Xz, *Yx, *Yz ;
+    Int j, nrow, ex ;
+    if (X == NULL || Y == NULL)
+    {
+	return (X == Y) ;
+    }
+    if (X->nrow != Y->nrow || X->ncol != Y->ncol || X->xtype != Y->xtype)
+    {
+	return (FALSE) ;
+    }
+    nrow = X->nrow ;
+    ex = (X->xtype == CHOLMOD_COMPLEX) ? 2 : 1 ;
+    Xx = X->x ;
+    Xz = X->z ;
+    Yx = Y->x ;
+    Yz = Y->z ;
+    for (j = 0 ; j < (Int) X->ncol ; j++)
+    {
+	if (memcmp (Xx + ex*j*X->d, Yx + ex*j*Y->d, ex*nrow*sizeof (double))
+	    != 0)
+	{
+	    return (FALSE) ;
+	}
+	if (X->xtype == CHOLMOD_ZOMPLEX &&
+	    memcmp (Xz + j*X->d, Yz + j*Y->d, nrow*sizeof (double)) != 0)
+	{
+	    return (FALSE) ;
+	}
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === same_factor ========================================================== */
+/* ========================================================================== */
+
+/* Return TRUE if the numeric factor L is identical to its copy L2 (made by
+ * cholmod_copy_factor, so only the entries in use are compared for a
+ * simplicial factor).  L->IPerm is not compared. */
+
+static Int same_factor (cholmod_factor *L, cholmod_factor *L2)
+{
+    double *Lx, *Lz, *L2x, *L2z ;
+    Int *Lp, *Lnz, *Li, *L2p, *L2i ;
+    Int n, j, ex, s ;
+
+    if (L->n != L2->n || L->xtype != L2->xtype || L->is_super != L2->is_super
+	|| L->is_ll != L2->is_ll || L->minor != L2->minor
+	|| L->ordering != L2->ordering)
+    {
+	return (FALSE) ;
+    }
+    n = L->n ;
+    ex = (L->xtype == CHOLMOD_COMPLEX) ? 2 : 1 ;
+    if (memcmp (L->Perm, L2->Perm, n * sizeof (Int)) != 0 ||
+	memcmp (L->ColCount, L2->ColCount, n * sizeof (Int)) != 0)
+    {
+	return (FALSE) ;
+    }
+    Lx = L->x ;
+    Lz = L->z ;
+    L2x = L2->x ;
+    L2z = L2->z ;
+    if (L->is_super)
+    {
+	s = L->nsuper + 1 ;
+	return (L->nsuper == L2->nsuper && L->xsize == L2->xsize
+	    && L->ssize == L2->ssize
+	    && memcmp (L->super, L2->super, s * sizeof (Int)) == 0
+	    && memcmp (L->pi, L2->pi, s * sizeof (Int)) == 0
+	    && memcmp (L->px, L2->px, s * sizeof (Int)) == 0
+	    && memcmp (L->s, L2->s, L->ssize * sizeof (Int)) == 0
+	    && memcmp (Lx, L2x, ex * L->xsize * sizeof (double)) == 0) ;
+    }
+    Lp = L->p ;
+    Lnz = L->nz ;
+    Li = L->i ;
+    L2p = L2->p ;
+    L2i = L2->i ;
+    if (memcmp (Lp, L2p, (n+1) * sizeof (Int)) != 0 ||
+	memcmp (Lnz, L2->nz, n * sizeof (Int)) != 0 ||
+	memcmp (L->next, L2->next, (n+2) * sizeof (Int)) != 0 ||
+	memcmp (L->prev, L2->prev, (n+2) * sizeof (Int)) != 0)
+    {
+	return (FALSE) ;
+    }
+    for (j = 0 ; j < n ; j++)
+    {
+	if (memcmp (Li + Lp [j], L2i + Lp [j], Lnz [j] * sizeof (Int)) != 0 ||
+	    memcmp (Lx + ex*Lp [j], L2x + ex*Lp [j],
+		ex * Lnz [j] * sizeof (double)) != 0 ||
+	    (L->xtype == CHOLMOD_ZOMPLEX &&
+	    memcmp (Lz + Lp [j], L2z + Lp [j], Lnz [j] * sizeof (double)) != 0))
+	{
+	    return (FALSE) ;
+	}
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === solve_r_test ========================================================= */
+/* ========================================================================== */
+
+/* Test cholmod_solve_r with a simplicial and a supernodal factor.  Several
+ * threads solve every system with the same L at the same time, each with its
+ * own context, and L must be left unchanged.  Every result must be bit-for-bit
+ * identical to cholmod_solve2.  A sparse right-hand-side (Bset) is accepted for
+ * a simplicial L and rejected for a supernodal L.  Returns the residual of the
+ * solution of Ax=b. */
+
+#define NTHREADS 4
+
+double solve_r_test (cholmod_sparse *A)
+{
+    cholmod_factor *L, *Lcopy ;
+    cholmod_dense *B, *B1, *X, *Y, *Ywork, *Ework, *Xref [CHOLMOD_Pt+1],
+	*Xt [NTHREADS] ;
+    cholmod_sparse *Bset, *Xset, *Xset2 ;
+    cholmod_solve_context *Context, *Contexts [NTHREADS] ;
+    double maxerr = 0, r, *B1x, *B1z, *Xx, *Xz, *Yx, *Yz ;
+    Int tok [NTHREADS] ;
+    Int n, sys, t, super, save, save3, ok, p, i, ex, *Bsetp, *Bseti, *Xsetp,
+	*Xseti, *Xset2p, *Xset2i ;
+
+    if (A == NULL || A->xtype == CHOLMOD_PATTERN || A->nrow == 0)
+    {
+	return (0) ;
+    }
+
+    /* turn off memory tests [ */
+    save3 = my_tries ;
+    my_tries = -1 ;
+    save = cm->supernodal ;
+
+    n = A->nrow ;
+    B = rhs (A, NRHS, n) ;					/* RAND */
+    OKP (B) ;
+
+    for (super = 0 ; super <= 1 ; super++)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* factorize */
+	/* ------------------------------------------------------------------ */
+
+	cm->supernodal = super ? CHOLMOD_SUPERNODAL : CHOLMOD_SIMPLICIAL ;
+	L = CHOLMOD(analyze) (A, cm) ;
+	OKP (L) ;
+	CHOLMOD(factorize) (A, L, cm) ;
+	OK (cm->status >= CHOLMOD_OK) ;
+	Lcopy = CHOLMOD(copy_factor) (L, cm) ;
+	OKP (Lcopy) ;
+	Context = CHOLMOD(allocate_solve_context) (L, cm) ;
+	OKP (Context) ;
+
+	/* ------------------------------------------------------------------ */
+	/* solve each system once, with a single thread */
+	/* ------------------------------------------------------------------ */
+
+	for (sys = CHOLMOD_A ; sys <= CHOLMOD_Pt ; sys++)
+	{
+	    Xref [sys] = NULL ;
+	    ok = CHOLMOD(solve_r) (sys, L, B, NULL, &Xref [sys], NULL,
+		Context) ;
+	    OK (ok) ;
+	}
+	r = resid (A, Xref [CHOLMOD_A], B) ;
+	MAXERR (maxerr, r, 1) ;
+
+	/* ------------------------------------------------------------------ */
+	/* solve all systems with the same L, in parallel */
+	/* ------------------------------------------------------------------ */
+
+	for (t = 0 ; t < NTHREADS ; t++)
+	{
+	    Contexts [t] = CHOLMOD(allocate_solve_context) (L, cm) ;
+	    OKP (Contexts [t]) ;
+	    Xt [t] = NULL ;
+	    tok [t] = TRUE ;
+	}
+
+	#pragma omp parallel for num_threads(NTHREADS) schedule(static,1)
+	for (t = 0 ; t < NTHREADS ; t++)
+	{
+	    Int k, s ;
+	    for (k = 0 ; k < 4 ; k++)
+	    {
+		for (s = CHOLMOD_A ; s <= CHOLMOD_Pt ; s++)
+		{
+		    if (!CHOLMOD(solve_r) (s, L, B, NULL, &Xt [t], NULL,
+			Contexts [t]) || !same_dense (Xt [t], Xref [s]))
+		    {
+			tok [t] = FALSE ;
+		    }
+		}
+	    }
+	}
+
+	for (t = 0 ; t < NTHREADS ; t++)
+	{
+	    OK (tok [t]) ;
+	    CHOLMOD(free_dense) (&Xt [t], &(Contexts [t]->Common)) ;
+	    CHOLMOD(free_solve_context) (&Contexts [t], cm) ;
+	}
+
+	/* L is unchanged, and its inverse permutation was not computed */
+	OK (same_factor (L, Lcopy)) ;
+	OK (L->IPerm == NULL) ;
+
+	/* ------------------------------------------------------------------ */
+	/* cholmod_solve2 gives bit-for-bit the same results */
+	/* ------------------------------------------------------------------ */
+
+	X = NULL ;
+	Ywork = NULL ;
+	Ework = NULL ;
+	for (sys = CHOLMOD_A ; sys <= CHOLMOD_Pt ; sys++)
+	{
+	    ok = CHOLMOD(solve2) (sys, L, B, NULL, &X, NULL, &Ywork, &Ework,
+		cm) ;
+	    OK (ok) ;
+	    OK (same_dense (X, Xref [sys])) ;
+	    CHOLMOD(free_dense) (&Xref [sys], &(Context->Common)) ;
+	}
+	CHOLMOD(free_dense) (&X, cm) ;
+
+	/* ------------------------------------------------------------------ */
+	/* sparse right-hand-side, with b(0) the only nonzero */
+	/* ------------------------------------------------------------------ */
+
+	Bset = CHOLMOD(allocate_sparse) (n, 1, 1, FALSE, TRUE, 0,
+	    CHOLMOD_PATTERN, cm) ;
+	B1 = CHOLMOD(zeros) (n, 1, L->xtype, cm) ;
+	OKP (Bset) ;
+	OKP (B1) ;
+	Bsetp = Bset->p ;
+	Bseti = Bset->i ;
+	Bsetp [0] = 0 ;
+	Bsetp [1] = 1 ;
+	Bseti [0] = 0 ;
+	B1x = B1->x ;
+	B1z = B1->z ;
+	if (B1->xtype == CHOLMOD_REAL)
+	{
+	    B1x [0] = 42 ;
+	}
+	else if (B1->xtype == CHOLMOD_COMPLEX)
+	{
+	    B1x [0] = -2 ;
+	    B1x [1] = 1 ;
+	}
+	else
+	{
+	    B1x [0] = 77 ;
+	    B1z [0] = -2 ;
+	}
+	ex = (L->xtype == CHOLMOD_COMPLEX) ? 2 : 1 ;
+
+	X = NULL ;
+	Y = NULL ;
+	Xset = NULL ;
+	Xset2 = NULL ;
+	for (sys = CHOLMOD_A ; sys <= CHOLMOD_D ; sys++)
+	{
+	    if (L->is_super)
+	    {
+		/* a supernodal L cannot be converted to simplicial */
+		Context->Common.error_handler = NULL ;
+		ok = CHOLMOD(solve_r) (sys, L, B1, Bset, &X, &Xset, Context) ;
+		Context->Common.error_handler = cm->error_handler ;
+		NOT (ok) ;
+		OK (Context->Common.status == CHOLMOD_INVALID) ;
+		OK (L->is_super) ;
+		continue ;
+	    }
+
+	    ok = CHOLMOD(solve_r) (sys, L, B1, Bset, &X, &Xset, Context) ;
+	    OK (ok) ;
+	    OK (same_factor (L, Lcopy)) ;
+	    ok = CHOLMOD(solve2) (sys, L, B1, Bset, &Y, &Xset2, &Ywork, &Ework,
+		cm) ;
+	    OK (ok) ;
+
+	    /* same pattern of x, and bit-for-bit the same values in it */
+	    Xsetp = Xset->p ;
+	    Xseti = Xset->i ;
+	    Xset2p = Xset2->p ;
+	    Xset2i = Xset2->i ;
+	    OK (Xsetp [1] == Xset2p [1]) ;
+	    OK (memcmp (Xseti, Xset2i, Xsetp [1] * sizeof (Int)) == 0) ;
+	    OK (X->xtype == Y->xtype) ;
+	    Xx = X->x ;
+	    Xz = X->z ;
+	    Yx = Y->x ;
+	    Yz = Y->z ;
+	    for (p = 0 ; p < Xsetp [1] ; p++)
+	    {
+		i = Xseti [p] ;
+		OK (memcmp (Xx + ex*i, Yx + ex*i, ex * sizeof (double)) == 0) ;
+		OK (X->xtype != CHOLMOD_ZOMPLEX ||
+		    memcmp (Xz + i, Yz + i, sizeof (double)) == 0) ;
+	    }
+	}
+
+	CHOLMOD(free_dense) (&X, &(Context->Common)) ;
+	CHOLMOD(free_sparse) (&Xset, &(Context->Common)) ;
+	CHOLMOD(free_dense) (&Y, cm) ;
+	CHOLMOD(free_sparse) (&Xset2, cm) ;
+	CHOLMOD(free_dense) (&Ywork, cm) ;
+	CHOLMOD(free_dense) (&Ework, cm) ;
+	CHOLMOD(free_dense) (&B1, cm) ;
+	CHOLMOD(free_sparse) (&Bset, cm) ;
+	CHOLMOD(free_solve_context) (&Context, cm) ;
+	CHOLMOD(free_factor) (&Lcopy, cm) ;
+	CHOLMOD(free_factor) (&L, cm) ;
+    }
+
+    CHOLMOD(free_dense) (&B, cm) ;
+    cm->supernodal = save ;
+
+    /* turn memory tests back on, where we left off ] */
+    my_tries = save3 ;
+
+    progress (1, '.') ;
+    return (maxerr) ;
+}
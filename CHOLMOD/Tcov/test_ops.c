@@ -190,6 +190,53 @@ static void check_equality (cholmod_sparse *E, cholmod_sparse *D, Int xtype)
 }
 
 
+/* ========================================================================== */
+/* === check_write ========================================================== */
+/* ========================================================================== */
+
+/* Write A and Z to a file with one thread, and again with four threads, and
+ * ensure the two files are identical. */
+
+static void check_write (cholmod_sparse *A, cholmod_sparse *Z)
+{
+    FILE *f, *g ;
+    Int asym1, asym4 ;
+    int save_nthreads, c1, c4 ;
+    double save_chunk ;
+
+    save_nthreads = cm->nthreads_max ;
+    save_chunk = cm->chunk ;
+
+    cm->nthreads_max = 1 ;
+    f = fopen ("temp7.mtx", "w") ;
+    asym1 = CHOLMOD(write_sparse) (f, A, Z, NULL, cm) ;
+    fclose (f) ;
+
+    cm->nthreads_max = 4 ;
+    cm->chunk = 1 ;
+    f = fopen ("temp8.mtx", "w") ;
+    asym4 = CHOLMOD(write_sparse) (f, A, Z, NULL, cm) ;
+    fclose (f) ;
+
+    cm->nthreads_max = save_nthreads ;
+    cm->chunk = save_chunk ;
+
+    OK (asym1 == asym4) ;
+    OK (IMPLIES (A != NULL, asym1 > EMPTY)) ;
+    f = fopen ("temp7.mtx", "r") ;
+    g = fopen ("temp8.mtx", "r") ;
+    do
+    {
+	c1 = fgetc (f) ;
+	c4 = fgetc (g) ;
+	OK (c1 == c4) ;
+    }
+    while (c1 != EOF) ;
+    fclose (f) ;
+    fclose (g) ;
+}
+
+
 /* ========================================================================== */
 /* === test_ops ============================================================= */
 /* ========================================================================== */
@@ -329,6 +376,38 @@ double test_ops (cholmod_sparse *A)
     printf ("got_sparse3\n") ;
     CHOLMOD(free_sparse) (&C, cm) ;
 
+    /* write A in parallel, with and without explicit zeros */
+    check_write (A, NULL) ;
+    Zs = CHOLMOD(speye) (nrow, ncol, CHOLMOD_PATTERN, cm) ;
+    if (Zs != NULL)
+    {
+	Zs->stype = A->stype ;
+	check_write (A, Zs) ;
+    }
+    CHOLMOD(free_sparse) (&Zs, cm) ;
+
+    /* write a matrix whose columns must be split across blocks */
+    X = CHOLMOD(ones) (20000, 3,
+	(xtype == CHOLMOD_PATTERN) ? CHOLMOD_REAL : xtype, cm) ;
+    if (X != NULL)
+    {
+	Xx = X->x ;
+	for (k = 0 ; k < 20000 ; k++)
+	{
+	    Xx [k] = ((double) k) / 7 ;
+	}
+    }
+    E = CHOLMOD(dense_to_sparse) (X, TRUE, cm) ;
+    Zs = CHOLMOD(speye) (20000, 3, CHOLMOD_PATTERN, cm) ;
+    if (E != NULL && Zs != NULL)
+    {
+	check_write (E, NULL) ;
+	check_write (E, Zs) ;
+    }
+    CHOLMOD(free_sparse) (&Zs, cm) ;
+    CHOLMOD(free_sparse) (&E, cm) ;
+    CHOLMOD(free_dense) (&X, cm) ;
+
     for (i = 0 ; i <= 1 ; i++)
     {
 
@@ -912,6 +991,41 @@ double test_ops (cholmod_sparse *A)
 	    OK (CHOLMOD(check_perm) (Perm, n, n, cm)) ;
 	}
 
+	/* partition the components in batches, as done in parallel; the
+	 * result must not change */
+	if (nc > 0 && n > 0)
+	{
+	    SuiteSparse_long nc2 ;
+	    Int *Cmember2, *CParent2, *Perm2 ;
+	    int save_nthreads = cm->nthreads_max ;
+	    double save_chunk = cm->chunk ;
+	    Cmember2 = CHOLMOD(malloc) (nrow, sizeof (Int), cm) ;
+	    CParent2 = CHOLMOD(malloc) (nrow, sizeof (Int), cm) ;
+	    Perm2 = CHOLMOD(malloc) (nrow, sizeof (Int), cm) ;
+	    cm->nthreads_max = 4 ;
+	    cm->chunk = 1 ;
+	    nc2 = CHOLMOD(nested_dissection) (A, NULL, 0, Perm2, CParent2,
+		Cmember2, cm) ;
+	    cm->nthreads_max = save_nthreads ;
+	    cm->chunk = save_chunk ;
+	    if (nc2 > 0)
+	    {
+		OK (nc2 == nc) ;
+		for (k = 0 ; k < n ; k++)
+		{
+		    OK (Perm2 [k] == Perm [k]) ;
+		    OK (Cmember2 [k] == Cmember [k]) ;
+		}
+		for (k = 0 ; k < nc ; k++)
+		{
+		    OK (CParent2 [k] == CParent [k]) ;
+		}
+	    }
+	    CHOLMOD(free) (nrow, sizeof (Int), Cmember2, cm) ;
+	    CHOLMOD(free) (nrow, sizeof (Int), CParent2, cm) ;
+	    CHOLMOD(free) (nrow, sizeof (Int), Perm2, cm) ;
+	}
+
 	CHOLMOD(free_work) (cm) ;
 
 	/* collapse the septree */
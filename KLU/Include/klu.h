@@ -104,6 +104,28 @@ typedef struct
     void *Offx ;        /* size nzoff, numerical values */
     int nzoff ;
 
+    /* level sets for a multithreaded solve; NULL if not computed */
+    void *Levels ;
+
+    /* workspace for klu_spsolve, allocated by its first call; NULL if not
+     * yet allocated */
+    int *Spwork ;
+
+    /* If the Numeric object was loaded by klu_load_numeric, then Pnum, Pinv,
+     * Lip, Uip, Llen, Ulen, LUsize, Udiag, Offp, Offi, Offx, and the blocks of
+     * LUbx point into a single block, Mapping, of mapping_size bytes, and are
+     * not freed individually.  Mapping is a private (copy-on-write) mapping of
+     * the file if mapped is TRUE, or a malloc'd copy of it otherwise.
+     * Mapping is NULL for a Numeric object computed by klu_factor. */
+    void *Mapping ;
+    size_t mapping_size ;
+    int mapped ;
+
+    /* incremented each time the pattern of L or U changes after klu_factor
+     * (when klu_refactor re-pivots a block, or klu_sort sorts the factors),
+     * so that a Batch object made from this template can detect it */
+    int generation ;
+
 } klu_numeric ;
 
 typedef struct          /* 64-bit version (otherwise same as above) */
@@ -120,9 +142,56 @@ typedef struct          /* 64-bit version (otherwise same as above) */
     SuiteSparse_long *Offp, *Offi ;
     void *Offx ;
     SuiteSparse_long nzoff ;
+    void *Levels ;
+    SuiteSparse_long *Spwork ;
+    void *Mapping ;
+    size_t mapping_size ;
+    SuiteSparse_long mapped ;
+    SuiteSparse_long generation ;
 
 } klu_l_numeric ;
 
+/* -------------------------------------------------------------------------- */
+/* Batch object - factors of many matrices with the same pattern */
+/* -------------------------------------------------------------------------- */
+
+/* The factors of nbatch matrices, all with the pattern of L and U in one
+ * Numeric object (the template).  The nbatch values of each entry are held
+ * next to each other: the value of entry p of matrix b is at
+ * LUx [p*nbatch+b], and likewise for Udiag, Offx, and Rs. */
+
+typedef struct
+{
+    int n ;             /* each matrix is n-by-n */
+    int nbatch ;        /* number of matrices in the batch */
+    int nlu ;           /* # of entries in L and U of each matrix (excl. diag) */
+    int nzoff ;         /* # of entries in the off-diagonal blocks */
+    int *Lxp ;          /* size n.  L(:,k) of each matrix starts at LUx
+                         * [Lxp [k]*nbatch] */
+    int *Uxp ;          /* size n.  U(:,k) starts at LUx [Uxp [k]*nbatch] */
+    void *LUx ;         /* size nlu*nbatch, entries of L and U */
+    void *Udiag ;       /* size n*nbatch, diagonal of U */
+    void *Offx ;        /* size nzoff*nbatch, off-diagonal entries */
+    double *Rs ;        /* size n*nbatch, scale factors; NULL if no scaling */
+    int *Rank ;         /* size nbatch.  Rank [b] is n if matrix b is
+                         * nonsingular, or the first k with U(k,k) zero */
+    void *Xwork ;       /* size n*nbatch, workspace */
+    int generation ;    /* Numeric->generation of the template when the
+                         * batch was created */
+
+} klu_batch ;
+
+typedef struct          /* 64-bit version (otherwise same as above) */
+{
+    SuiteSparse_long n, nbatch, nlu, nzoff, *Lxp, *Uxp ;
+    void *LUx, *Udiag, *Offx ;
+    double *Rs ;
+    SuiteSparse_long *Rank ;
+    void *Xwork ;
+    SuiteSparse_long generation ;
+
+} klu_l_batch ;
+
 /* -------------------------------------------------------------------------- */
 /* KLU control parameters and statistics */
 /* -------------------------------------------------------------------------- */
@@ -133,6 +202,7 @@ typedef struct          /* 64-bit version (otherwise same as above) */
 #define KLU_OUT_OF_MEMORY (-2)
 #define KLU_INVALID (-3)
 #define KLU_TOO_LARGE (-4)          /* integer overflow has occured */
+#define KLU_FILE_IO (-5)            /* file could not be read or written */
 
 typedef struct klu_common_struct
 {
@@ -170,12 +240,44 @@ typedef struct klu_common_struct
         *   Numeric object.  klu_refactor will not free it, but will leave the
         *   numerical values only partially defined.  This is the default. */
 
+    int nthreads ;          /* # of threads for klu_factor and klu_refactor,
+        * which factorize independent diagonal blocks of the BTF form in
+        * parallel if KLU is compiled with OpenMP.  If not 1, klu_factor also
+        * computes level sets so that klu_solve and klu_tsolve can use threads.
+        * 1: do not use threads (the default).  <= 0: use the OpenMP default
+        * (omp_get_max_threads).  The results do not depend on the number of
+        * threads. */
+
+    double dense ;          /* dense block threshold for klu_factor.  A
+        * diagonal block of the BTF form is factorized with a dense LU kernel,
+        * instead of the sparse left-looking kernel, if it is at least 16-by-16
+        * and nnz(L+U) of the block is estimated to be at least dense*nk^2,
+        * where nk is the size of the block.  The estimate comes from AMD, so
+        * it is not available with COLAMD for the first klu_factor.  The
+        * factors are stored in the same form either way.  <= 0: always use
+        * the sparse kernel (the default).  0.3 to 0.5 is a good choice for
+        * circuit matrices with large, fairly dense blocks. */
+
+    int irstep ;            /* max # of steps of iterative refinement done by
+        * klu_refine (default 10).  Refinement stops sooner once the backward
+        * error no longer improves. */
+
+    double repivot ;        /* re-pivoting threshold for klu_refactor.  If > 0,
+        * a diagonal block of the BTF form whose reciprocal pivot growth (see
+        * klu_rgrowth) falls below repivot when it is refactorized with the
+        * prior pivots, or that has a zero pivot, is factorized again with
+        * partial pivoting.  The other blocks are not affected.  Re-pivoting
+        * changes the pattern of L and U, so any Batch object made from the
+        * Numeric object is no longer valid.  <= 0: never re-pivot (the
+        * default). */
+
     /* ---------------------------------------------------------------------- */
     /* statistics */
     /* ---------------------------------------------------------------------- */
 
     int status ;                /* KLU_OK if OK, < 0 if error */
     int nrealloc ;              /* # of reallocations of L and U */
+    int nrepivot ;              /* # of blocks re-pivoted by klu_refactor */
 
     int structural_rank ;       /* 0 to n-1 if the matrix is structurally rank
         * deficient (as determined by maxtrans).  -1 if not computed.  n if the
@@ -200,6 +302,7 @@ typedef struct klu_common_struct
     double condest ;    /* accurate condition est., from klu_condest */
     double rgrowth ;    /* reciprocal pivot rgrowth, from klu_rgrowth */
     double work ;       /* actual work done in BTF, in klu_analyze */
+    double berr ;       /* componentwise backward error, from klu_refine */
 
     size_t memusage ;   /* current memory usage, in bytes */
     size_t mempeak ;    /* peak memory usage, in bytes */
@@ -215,10 +318,13 @@ typedef struct klu_l_common_struct /* 64-bit version (otherwise same as above)*/
         SuiteSparse_long *, SuiteSparse_long *,
         struct klu_l_common_struct *) ;
     void *user_data ;
-    SuiteSparse_long halt_if_singular ;
-    SuiteSparse_long status, nrealloc, structural_rank, numerical_rank,
-        singular_col, noffdiag ;
-    double flops, rcond, condest, rgrowth, work ;
+    SuiteSparse_long halt_if_singular, nthreads ;
+    double dense ;
+    SuiteSparse_long irstep ;
+    double repivot ;
+    SuiteSparse_long status, nrealloc, nrepivot, structural_rank,
+        numerical_rank, singular_col, noffdiag ;
+    double flops, rcond, condest, rgrowth, work, berr ;
     size_t memusage, mempeak ;
 
 } klu_l_common ;
@@ -388,6 +494,107 @@ SuiteSparse_long klu_zl_tsolve (klu_l_symbolic *, klu_l_numeric *,
     klu_l_common * ) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_refine: solves Ax=b with iterative refinement */
+/* -------------------------------------------------------------------------- */
+
+/* The residual is computed in double precision from A, so the solution is
+ * accurate to double precision even if the factors are single precision (see
+ * klu_s_factor below).  B is not modified.  At most Common->irstep steps are
+ * done, and the largest backward error is returned in Common->berr. */
+
+int klu_refine              /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int Ap [ ],             /* size n+1, column pointers */
+    int Ai [ ],             /* size nz, row indices */
+    double Ax [ ],          /* size nz, numerical values */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int ldim,               /* leading dimension of B and X */
+    int nrhs,               /* number of right-hand-sides */
+    double B [ ],           /* size ldim*nrhs, right-hand-side */
+    /* output */
+    double X [ ],           /* size ldim*nrhs, solution to Ax=b */
+    klu_common *Common
+) ;
+
+int klu_z_refine            /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int Ap [ ],             /* size n+1, column pointers */
+    int Ai [ ],             /* size nz, row indices */
+    double Ax [ ],          /* size 2*nz, numerical values */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int ldim,               /* leading dimension of B and X */
+    int nrhs,               /* number of right-hand-sides */
+    double B [ ],           /* size 2*ldim*nrhs, right-hand-side */
+    /* output */
+    double X [ ],           /* size 2*ldim*nrhs, solution to Ax=b */
+    klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_refine (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, SuiteSparse_long,
+    SuiteSparse_long, double *, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_zl_refine (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, SuiteSparse_long,
+    SuiteSparse_long, double *, double *, klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_spsolve: solves Ax=b with a sparse b, returning a sparse x */
+/* -------------------------------------------------------------------------- */
+
+/* Only the blocks of the BTF form, and the columns of L and U within each
+ * block, that are reachable from the nonzeros of b are used, so the time
+ * taken is proportional to the work of the solve with those columns, not to
+ * n.  The first call allocates about 3n+2*nblocks integers of workspace, held
+ * in the Numeric object.  The nonzeros of x are returned in no particular
+ * order (an entry of x can be numerically zero).  Duplicate entries in b are
+ * summed. */
+
+int klu_spsolve             /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int bnz,                /* number of entries in b */
+    int Bi [ ],             /* size bnz, row indices of b */
+    double Bx [ ],          /* size bnz, numerical values of b */
+    /* outputs */
+    int *xnz,               /* number of entries in x */
+    int Xi [ ],             /* size n, row indices of x */
+    double Xx [ ],          /* size n, numerical values of x */
+    klu_common *Common
+) ;
+
+int klu_z_spsolve           /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int bnz,                /* number of entries in b */
+    int Bi [ ],             /* size bnz, row indices of b */
+    double Bx [ ],          /* size 2*bnz, numerical values of b */
+    /* outputs */
+    int *xnz,               /* number of entries in x */
+    int Xi [ ],             /* size n, row indices of x */
+    double Xx [ ],          /* size 2*n, numerical values of x */
+    klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_spsolve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long *, double *, SuiteSparse_long *,
+    SuiteSparse_long *, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_zl_spsolve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long *, double *, SuiteSparse_long *,
+    SuiteSparse_long *, double *, klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_refactor: refactorizes matrix with same ordering as klu_factor */
 /* -------------------------------------------------------------------------- */
@@ -423,6 +630,57 @@ SuiteSparse_long klu_zl_refactor (SuiteSparse_long *, SuiteSparse_long *,
     double *, klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_partial_refactor: klu_refactor, for only the columns that change */
+/* -------------------------------------------------------------------------- */
+
+/* Only the columns of L and U that depend on a changed column of A are
+ * recomputed; the rest of the Numeric object is kept.  The result is the same
+ * as klu_refactor.  The changed columns are given by Changed, or if Changed
+ * is NULL, they are found by comparing Ax with Axold (the values last given
+ * to klu_factor or klu_refactor).  The scale factors are recomputed, and the
+ * columns with an entry in a row whose scale factor changes are recomputed
+ * too.  The columns are done by a single thread. */
+
+int klu_partial_refactor    /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int Ap [ ],         /* size n+1, column pointers */
+    int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz, numerical values */
+    int Changed [ ],    /* size n, Changed [j] nonzero if A(:,j) has changed,
+                         * or NULL */
+    double Axold [ ],   /* size nz, prior numerical values (only used if
+                         * Changed is NULL) */
+    klu_symbolic *Symbolic,
+    /* input, and numerical values modified on output */
+    klu_numeric *Numeric,
+    klu_common *Common
+) ;
+
+int klu_z_partial_refactor  /* return TRUE if successful, FALSE otherwise */
+(
+     /* inputs, not modified */
+     int Ap [ ],        /* size n+1, column pointers */
+     int Ai [ ],        /* size nz, row indices */
+     double Ax [ ],     /* size 2*nz, numerical values */
+     int Changed [ ],   /* size n, or NULL */
+     double Axold [ ],  /* size 2*nz, or NULL */
+     klu_symbolic *Symbolic,
+     /* input, and numerical values modified on output */
+     klu_numeric *Numeric,
+     klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_partial_refactor (SuiteSparse_long *,
+    SuiteSparse_long *, double *, SuiteSparse_long *, double *,
+    klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_zl_partial_refactor (SuiteSparse_long *,
+    SuiteSparse_long *, double *, SuiteSparse_long *, double *,
+    klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_free_symbolic: destroys the Symbolic object */
 /* -------------------------------------------------------------------------- */
@@ -459,6 +717,238 @@ SuiteSparse_long klu_l_free_numeric (klu_l_numeric **, klu_l_common *) ;
 SuiteSparse_long klu_zl_free_numeric (klu_l_numeric **, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_save_symbolic, klu_load_symbolic: write/read a Symbolic object */
+/* -------------------------------------------------------------------------- */
+
+/* klu_save_symbolic writes the Symbolic object to a binary file, and
+ * klu_load_symbolic reads it back in.  Common->status is KLU_FILE_IO if the
+ * file cannot be written or read, or KLU_INVALID if it does not hold a
+ * Symbolic object written by the same version of KLU (int or long). */
+
+int klu_save_symbolic       /* return TRUE if successful, FALSE otherwise */
+(
+    klu_symbolic *Symbolic,
+    const char *filename,
+    klu_common *Common
+) ;
+
+klu_symbolic *klu_load_symbolic     /* returns NULL if error */
+(
+    const char *filename,
+    klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_save_symbolic (klu_l_symbolic *, const char *,
+    klu_l_common *) ;
+
+klu_l_symbolic *klu_l_load_symbolic (const char *, klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_save_numeric, klu_load_numeric: write/read a Numeric object */
+/* -------------------------------------------------------------------------- */
+
+/* klu_save_numeric writes the Numeric object to a binary file.
+ * klu_load_numeric maps that file into memory (with a private, copy-on-write
+ * mapping) and uses the factors in place, without copying them, so that many
+ * processes that solve with the same factors share a single copy of them in
+ * memory.  If the file cannot be mapped, it is read into memory instead.
+ * The Symbolic object must be the one used to compute the Numeric object.
+ * The Numeric object returned may be used with any KLU function, including
+ * klu_refactor, and is freed by klu_free_numeric.  The file must not be
+ * modified or removed while the Numeric object is in use.  Common->status is
+ * KLU_FILE_IO if the file cannot be written or read, or KLU_INVALID if it does
+ * not hold a Numeric object of the same kind (real or complex, int or long)
+ * that matches the Symbolic object. */
+
+int klu_save_numeric        /* return TRUE if successful, FALSE otherwise */
+(
+    klu_numeric *Numeric,
+    const char *filename,
+    klu_common *Common
+) ;
+
+int klu_z_save_numeric      /* return TRUE if successful, FALSE otherwise */
+(
+    klu_numeric *Numeric,
+    const char *filename,
+    klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_save_numeric (klu_l_numeric *, const char *,
+    klu_l_common *) ;
+SuiteSparse_long klu_zl_save_numeric (klu_l_numeric *, const char *,
+    klu_l_common *) ;
+
+klu_numeric *klu_load_numeric       /* returns NULL if error */
+(
+    const char *filename,
+    klu_symbolic *Symbolic,
+    klu_common *Common
+) ;
+
+klu_numeric *klu_z_load_numeric     /* returns NULL if error */
+(
+    const char *filename,
+    klu_symbolic *Symbolic,
+    klu_common *Common
+) ;
+
+klu_l_numeric *klu_l_load_numeric (const char *, klu_l_symbolic *,
+    klu_l_common *) ;
+klu_l_numeric *klu_zl_load_numeric (const char *, klu_l_symbolic *,
+    klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_factor_batch: factorizes many matrices with the pattern of one */
+/* -------------------------------------------------------------------------- */
+
+/* The nbatch matrices all have the pattern Ap and Ai.  The values of matrix b
+ * are in Ax [b*nz ... (b+1)*nz-1], where nz = Ap [n] (twice that for the
+ * complex case).  The pivot ordering and the pattern of L and U are taken
+ * from the Numeric object of one matrix with that pattern, which is not
+ * modified, but must not be freed while the Batch object is in use.  If the
+ * pattern of the template changes (klu_refactor with Common->repivot > 0
+ * re-pivots a block, or klu_sort sorts it), the Batch object is no longer
+ * valid:  klu_refactor_batch and klu_solve_batch then return FALSE with
+ * Common->status KLU_INVALID, and the batch must be freed and created again
+ * with klu_factor_batch.
+ */
+
+klu_batch *klu_factor_batch
+(
+    /* inputs, not modified */
+    int Ap [ ],         /* size n+1, column pointers */
+    int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz*nbatch, numerical values */
+    int nbatch,         /* number of matrices */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* template, from klu_factor */
+    klu_common *Common
+) ;
+
+klu_batch *klu_z_factor_batch
+(
+    /* inputs, not modified */
+    int Ap [ ],         /* size n+1, column pointers */
+    int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size 2*nz*nbatch, numerical values */
+    int nbatch,         /* number of matrices */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* template, from klu_z_factor */
+    klu_common *Common
+) ;
+
+klu_l_batch *klu_l_factor_batch (SuiteSparse_long *, SuiteSparse_long *,
+    double *, SuiteSparse_long, klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+klu_l_batch *klu_zl_factor_batch (SuiteSparse_long *, SuiteSparse_long *,
+    double *, SuiteSparse_long, klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_refactor_batch: refactorizes a batch with new numerical values */
+/* -------------------------------------------------------------------------- */
+
+int klu_refactor_batch      /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int Ap [ ],         /* size n+1, column pointers */
+    int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz*nbatch, numerical values */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* template, from klu_factor */
+    /* input, and numerical values modified on output */
+    klu_batch *Batch,
+    klu_common *Common
+) ;
+
+int klu_z_refactor_batch    /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int Ap [ ],         /* size n+1, column pointers */
+    int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size 2*nz*nbatch, numerical values */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* template, from klu_z_factor */
+    /* input, and numerical values modified on output */
+    klu_batch *Batch,
+    klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_refactor_batch (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, klu_l_batch *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_zl_refactor_batch (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, klu_l_batch *,
+    klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_solve_batch: solves one system with each matrix of a batch */
+/* -------------------------------------------------------------------------- */
+
+int klu_solve_batch
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* template, from klu_factor */
+    klu_batch *Batch,
+    int ldim,               /* leading dimension of B */
+    /* right-hand-sides on input, overwritten with solution to Ax=b on output*/
+    double B [ ],           /* size ldim*nbatch; column b for matrix b */
+    /* --------------- */
+    klu_common *Common
+) ;
+
+int klu_z_solve_batch
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* template, from klu_z_factor */
+    klu_batch *Batch,
+    int ldim,               /* leading dimension of B */
+    /* right-hand-sides on input, overwritten with solution to Ax=b on output*/
+    double B [ ],           /* size 2*ldim*nbatch */
+    /* --------------- */
+    klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_solve_batch (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_batch *, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_zl_solve_batch (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_batch *, SuiteSparse_long, double *, klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_free_batch: destroys the Batch object */
+/* -------------------------------------------------------------------------- */
+
+/* Note that klu_free_batch and klu_z_free_batch are identical; each can
+ * free both kinds of Batch objects (real and complex) */
+
+int klu_free_batch
+(
+    klu_batch **Batch,
+    klu_common *Common
+) ;
+
+int klu_z_free_batch
+(
+    klu_batch **Batch,
+    klu_common *Common
+) ;
+
+SuiteSparse_long klu_l_free_batch (klu_l_batch **, klu_l_common *) ;
+SuiteSparse_long klu_zl_free_batch (klu_l_batch **, klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_sort: sorts the columns of the LU factorization */
 /* -------------------------------------------------------------------------- */
@@ -761,6 +1251,280 @@ SuiteSparse_long klu_zl_extract (klu_l_numeric *, klu_l_symbolic *,
     SuiteSparse_long *, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* single-precision versions */
+/* -------------------------------------------------------------------------- */
+
+/* klu_s_* (real), klu_c_* (complex), klu_sl_* (real, SuiteSparse_long), and
+ * klu_cl_* (complex, SuiteSparse_long) hold the entries of L, U, and the
+ * off-diagonal part in single precision (float, or a pair of floats), which
+ * halves the memory and memory traffic of the numerical factors.  All other
+ * arguments are the same as the double-precision versions: A, B, and all
+ * other numerical arrays are double, and the solves are done in double
+ * precision with the single-precision factors.  Use klu_s_refine to get a
+ * solution accurate to double precision.  A Numeric object from klu_s_factor
+ * (or a Batch object from klu_s_factor_batch) can only be used with the
+ * klu_s_* functions, and likewise for the other three versions.  The Symbolic
+ * and Common objects, and all other functions, are shared with the
+ * double-precision versions. */
+
+klu_numeric *klu_s_factor (int *, int *, double *, klu_symbolic *,
+    klu_common *) ;
+
+int klu_s_refactor (int *, int *, double *, klu_symbolic *, klu_numeric *,
+    klu_common *) ;
+
+int klu_s_partial_refactor (int *, int *, double *, int *, double *,
+    klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_s_solve (klu_symbolic *, klu_numeric *, int, int, double *,
+    klu_common *) ;
+
+int klu_s_tsolve (klu_symbolic *, klu_numeric *, int, int, double *,
+    klu_common *) ;
+
+int klu_s_refine (int *, int *, double *, klu_symbolic *, klu_numeric *, int,
+    int, double *, double *, klu_common *) ;
+
+int klu_s_spsolve (klu_symbolic *, klu_numeric *, int, int *, double *, int *,
+    int *, double *, klu_common *) ;
+
+int klu_s_free_numeric (klu_numeric **, klu_common *) ;
+
+int klu_s_save_numeric (klu_numeric *, const char *, klu_common *) ;
+
+klu_numeric *klu_s_load_numeric (const char *, klu_symbolic *, klu_common *) ;
+
+klu_batch *klu_s_factor_batch (int *, int *, double *, int, klu_symbolic *,
+    klu_numeric *, klu_common *) ;
+
+int klu_s_refactor_batch (int *, int *, double *, klu_symbolic *,
+    klu_numeric *, klu_batch *, klu_common *) ;
+
+int klu_s_solve_batch (klu_symbolic *, klu_numeric *, klu_batch *, int,
+    double *, klu_common *) ;
+
+int klu_s_free_batch (klu_batch **, klu_common *) ;
+
+int klu_s_sort (klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_s_flops (klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_s_rgrowth (int *, int *, double *, klu_symbolic *, klu_numeric *,
+    klu_common *) ;
+
+int klu_s_condest (int *, double *, klu_symbolic *, klu_numeric *,
+    klu_common *) ;
+
+int klu_s_rcond (klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_s_scale (int, int, int *, int *, double *, double *, int *,
+    klu_common *) ;
+
+int klu_s_extract (klu_numeric *, klu_symbolic *, int *, int *, double *,
+    int *, int *, double *, int *, int *, double *, int *, int *, double *,
+    int *, klu_common *) ;
+
+klu_numeric *klu_c_factor (int *, int *, double *, klu_symbolic *,
+    klu_common *) ;
+
+int klu_c_refactor (int *, int *, double *, klu_symbolic *, klu_numeric *,
+    klu_common *) ;
+
+int klu_c_partial_refactor (int *, int *, double *, int *, double *,
+    klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_c_solve (klu_symbolic *, klu_numeric *, int, int, double *,
+    klu_common *) ;
+
+int klu_c_tsolve (klu_symbolic *, klu_numeric *, int, int, double *, int,
+    klu_common *) ;
+
+int klu_c_refine (int *, int *, double *, klu_symbolic *, klu_numeric *, int,
+    int, double *, double *, klu_common *) ;
+
+int klu_c_spsolve (klu_symbolic *, klu_numeric *, int, int *, double *, int *,
+    int *, double *, klu_common *) ;
+
+int klu_c_free_numeric (klu_numeric **, klu_common *) ;
+
+int klu_c_save_numeric (klu_numeric *, const char *, klu_common *) ;
+
+klu_numeric *klu_c_load_numeric (const char *, klu_symbolic *, klu_common *) ;
+
+klu_batch *klu_c_factor_batch (int *, int *, double *, int, klu_symbolic *,
+    klu_numeric *, klu_common *) ;
+
+int klu_c_refactor_batch (int *, int *, double *, klu_symbolic *,
+    klu_numeric *, klu_batch *, klu_common *) ;
+
+int klu_c_solve_batch (klu_symbolic *, klu_numeric *, klu_batch *, int,
+    double *, klu_common *) ;
+
+int klu_c_free_batch (klu_batch **, klu_common *) ;
+
+int klu_c_sort (klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_c_flops (klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_c_rgrowth (int *, int *, double *, klu_symbolic *, klu_numeric *,
+    klu_common *) ;
+
+int klu_c_condest (int *, double *, klu_symbolic *, klu_numeric *,
+    klu_common *) ;
+
+int klu_c_rcond (klu_symbolic *, klu_numeric *, klu_common *) ;
+
+int klu_c_scale (int, int, int *, int *, double *, double *, int *,
+    klu_common *) ;
+
+int klu_c_extract (klu_numeric *, klu_symbolic *, int *, int *, double *,
+    double *, int *, int *, double *, double *, int *, int *, double *,
+    double *, int *, int *, double *, int *, klu_common *) ;
+
+klu_l_numeric *klu_sl_factor (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_refactor (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_partial_refactor (SuiteSparse_long *,
+    SuiteSparse_long *, double *, SuiteSparse_long *, double *,
+    klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_solve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_tsolve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_refine (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, SuiteSparse_long,
+    SuiteSparse_long, double *, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_spsolve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long *, double *, SuiteSparse_long *,
+    SuiteSparse_long *, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_free_numeric (klu_l_numeric **, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_save_numeric (klu_l_numeric *, const char *,
+    klu_l_common *) ;
+
+klu_l_numeric *klu_sl_load_numeric (const char *, klu_l_symbolic *,
+    klu_l_common *) ;
+
+klu_l_batch *klu_sl_factor_batch (SuiteSparse_long *, SuiteSparse_long *,
+    double *, SuiteSparse_long, klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_sl_refactor_batch (SuiteSparse_long *,
+    SuiteSparse_long *, double *, klu_l_symbolic *, klu_l_numeric *,
+    klu_l_batch *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_solve_batch (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_batch *, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_free_batch (klu_l_batch **, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_sort (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_sl_flops (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_sl_rgrowth (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_condest (SuiteSparse_long *, double *,
+    klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_rcond (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_sl_scale (SuiteSparse_long, SuiteSparse_long,
+    SuiteSparse_long *, SuiteSparse_long *, double *, double *,
+    SuiteSparse_long *, klu_l_common *) ;
+
+SuiteSparse_long klu_sl_extract (klu_l_numeric *, klu_l_symbolic *,
+    SuiteSparse_long *, SuiteSparse_long *, double *, SuiteSparse_long *,
+    SuiteSparse_long *, double *, SuiteSparse_long *, SuiteSparse_long *,
+    double *, SuiteSparse_long *, SuiteSparse_long *, double *,
+    SuiteSparse_long *, klu_l_common *) ;
+
+klu_l_numeric *klu_cl_factor (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_refactor (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_partial_refactor (SuiteSparse_long *,
+    SuiteSparse_long *, double *, SuiteSparse_long *, double *,
+    klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_solve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_tsolve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, SuiteSparse_long,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_cl_refine (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, SuiteSparse_long,
+    SuiteSparse_long, double *, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_spsolve (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long *, double *, SuiteSparse_long *,
+    SuiteSparse_long *, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_free_numeric (klu_l_numeric **, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_save_numeric (klu_l_numeric *, const char *,
+    klu_l_common *) ;
+
+klu_l_numeric *klu_cl_load_numeric (const char *, klu_l_symbolic *,
+    klu_l_common *) ;
+
+klu_l_batch *klu_cl_factor_batch (SuiteSparse_long *, SuiteSparse_long *,
+    double *, SuiteSparse_long, klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_cl_refactor_batch (SuiteSparse_long *,
+    SuiteSparse_long *, double *, klu_l_symbolic *, klu_l_numeric *,
+    klu_l_batch *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_solve_batch (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_batch *, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_free_batch (klu_l_batch **, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_sort (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_cl_flops (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_cl_rgrowth (SuiteSparse_long *, SuiteSparse_long *,
+    double *, klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_condest (SuiteSparse_long *, double *,
+    klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_rcond (klu_l_symbolic *, klu_l_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_cl_scale (SuiteSparse_long, SuiteSparse_long,
+    SuiteSparse_long *, SuiteSparse_long *, double *, double *,
+    SuiteSparse_long *, klu_l_common *) ;
+
+SuiteSparse_long klu_cl_extract (klu_l_numeric *, klu_l_symbolic *,
+    SuiteSparse_long *, SuiteSparse_long *, double *, double *,
+    SuiteSparse_long *, SuiteSparse_long *, double *, double *,
+    SuiteSparse_long *, SuiteSparse_long *, double *, double *,
+    SuiteSparse_long *, SuiteSparse_long *, double *, SuiteSparse_long *,
+    klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* KLU memory management routines */
 /* -------------------------------------------------------------------------- */
@@ -83,7 +83,7 @@ size_t KLU_kernel   /* final size of LU on output */
     Int n,              /* A is n-by-n */
     Int Ap [ ],         /* size n+1, column pointers for A */
     Int Ai [ ],         /* size nz = Ap [n], row indices for A */
-    Entry Ax [ ],       /* size nz, values of A */
+    XEntry Ax [ ],      /* size nz, values of A */
     Int Q [ ],          /* size n, optional input permutation */
     size_t lusize,      /* initial size of LU */
 
@@ -129,7 +129,7 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
     Int n,          /* A is n-by-n. n must be > 0. */
     Int Ap [ ],     /* size n+1, column pointers for A */
     Int Ai [ ],     /* size nz = Ap [n], row indices for A */
-    Entry Ax [ ],   /* size nz, values of A */
+    XEntry Ax [ ],  /* size nz, values of A */
     Int Q [ ],      /* size n, optional column permutation */
     double Lsize,   /* initial size of L and U */
 
@@ -160,6 +160,35 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
     KLU_common *Common  /* the control input/output structure */
 ) ;
 
+size_t KLU_dense_factor             /* 0 if failure, size of LU if OK */
+(
+    /* same arguments as KLU_kernel_factor */
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    XEntry Ax [ ],
+    Int Q [ ],
+    double Lsize,
+    Unit **p_LU,
+    Entry Udiag [ ],
+    Int Llen [ ],
+    Int Ulen [ ],
+    Int Lip [ ],
+    Int Uip [ ],
+    Int P [ ],
+    Int *lnz,
+    Int *unz,
+    Entry *X,
+    Int *Work,
+    Int k1,
+    Int PSinv [ ],
+    double Rs [ ],
+    Int Offp [ ],
+    Int Offi [ ],
+    Entry Offx [ ],
+    KLU_common *Common
+) ;
+
 void KLU_lsolve
 (
     /* inputs, not modified: */
@@ -169,7 +198,7 @@ void KLU_lsolve
     Unit LU [ ],
     Int nrhs,
     /* right-hand-side on input, solution to Lx=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 ) ;
 
 void KLU_ltsolve
@@ -184,7 +213,7 @@ void KLU_ltsolve
     Int conj_solve,
 #endif
     /* right-hand-side on input, solution to L'x=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 ) ;
 
 
@@ -198,7 +227,7 @@ void KLU_usolve
     Entry Udiag [ ],
     Int nrhs,
     /* right-hand-side on input, solution to Ux=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 ) ;
 
 void KLU_utsolve
@@ -214,7 +243,7 @@ void KLU_utsolve
     Int conj_solve,
 #endif
     /* right-hand-side on input, solution to U'x=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 ) ;
 
 Int KLU_valid 
@@ -240,4 +269,107 @@ size_t KLU_mult_size_t (size_t a, size_t k, Int *ok) ;
 
 KLU_symbolic *KLU_alloc_symbolic (Int n, Int *Ap, Int *Ai, KLU_common *Common) ;
 
+Int KLU_schedule (Int nblocks, Int R [ ], Int maxblock, Int **p_Order,
+    KLU_common *Common) ;
+
+Int KLU_threads (KLU_common *Common) ;
+
+/* the slices of a batch done by each thread in klu_batch.c are a multiple of
+ * this many matrices wide */
+#define KLU_BATCH_ALIGN 8
+
+/* diagonal blocks smaller than this are never factorized by KLU_dense_factor,
+ * which updates the columns of a block this many at a time */
+#define KLU_DENSE_MIN 16
+#define KLU_DENSE_PANEL 32
+
+/* ========================================================================== */
+/* file format of KLU_save_numeric and KLU_load_numeric */
+/* ========================================================================== */
+
+/* A Numeric file starts with this header, followed by the arrays Pnum, Pinv,
+ * Lip, Uip, Llen, Ulen, LUsize, Udiag, Rs, Offp, Offi, Offx, and then
+ * LUbx [0..nblocks-1], in that order.  Each array starts at a multiple of
+ * KLU_FILE_ALIGN bytes from the start of the file, so that it can be used in
+ * place when the file is mapped into memory.  offset [k] is the offset of the
+ * kth of the first 12 arrays (-1 for Rs if the matrix was not scaled), and
+ * offset [12] is the offset of LUbx [0].  Each block of LUbx follows the
+ * prior one, rounded up to a multiple of KLU_FILE_ALIGN; blocks of size 1 do
+ * not appear in the file. */
+
+#define KLU_NUMERIC_ID "KLU numeric 1"
+#define KLU_SYMBOLIC_ID "KLU symbolic 1"
+#define KLU_FILE_ALIGN 64
+#define KLU_FILE_NOBJECTS 13
+#define KLU_FILE_ROUNDUP(x) \
+    ((((x) + KLU_FILE_ALIGN - 1) / KLU_FILE_ALIGN) * KLU_FILE_ALIGN)
+
+typedef struct
+{
+    char id [16] ;      /* KLU_NUMERIC_ID, zero padded */
+    Int sizeof_int, sizeof_entry, sizeof_unit ;
+    Int n, nblocks, nzoff, lnz, unz, max_lnz_block, max_unz_block ;
+    SuiteSparse_long
+        file_size,      /* total size of the file, in bytes */
+        offset [KLU_FILE_NOBJECTS] ;    /* offset of each array, in bytes */
+
+} KLU_numeric_header ;
+
+/* mmap is not used on Windows, or if NPOSIX is defined */
+#if defined (_WIN32) || defined (_WIN64)
+#ifndef NPOSIX
+#define NPOSIX
+#endif
+#endif
+
+/* ========================================================================== */
+/* level sets for a multithreaded KLU_solve and KLU_tsolve (see klu_levels.c) */
+/* ========================================================================== */
+
+/* # of right-hand-sides solved at a time with the level sets */
+#define KLU_LEVEL_NRHS 16
+
+/* levels with fewer steps than this are done by a single thread */
+#define KLU_LEVEL_MIN 64
+
+typedef struct
+{
+    /* row form of the off-diagonal part, and of L and U.  Orx holds positions
+     * in Numeric->Offx; Lrx and Urx hold positions in LUbx [Block [i]], as an
+     * array of Entry's. */
+    Int *Orp, *Orj, *Orx ;  /* Orp size n+1; Orj, Orx size nzoff */
+    Int *Lrp, *Lrj, *Lrx ;  /* Lrp size n+1; Lrj, Lrx size nl */
+    Int *Urp, *Urj, *Urx ;  /* Urp size n+1; Urj, Urx size nu */
+    Int *Block ;            /* size n, Block [i] is the block containing i */
+
+    /* schedules for KLU_solve [0] and KLU_tsolve [1].  Step i is the first
+     * step for row i (L for KLU_solve, U' for KLU_tsolve), step FLIP (i) is
+     * the second. */
+    Int nsteps [2] ;        /* # of steps */
+    Int nseg [2] ;          /* # of segments */
+    Int *Step [2] ;         /* size nsteps, steps sorted by level */
+    Int *Segp [2] ;         /* size nseg+1, segment s is
+                             * Step [Segp [s] ... Segp [s+1]-1] */
+    Int *Segpar [2] ;       /* size nseg, TRUE if segment s is a single level
+                             * to be done in parallel */
+
+    XEntry *X ;             /* size n*KLU_LEVEL_NRHS, solve workspace */
+    Int n, nzoff, nl, nu ;
+
+} KLU_level_sets ;
+
+Int KLU_levels (KLU_symbolic *Symbolic, KLU_numeric *Numeric,
+    KLU_common *Common) ;
+
+void KLU_free_levels (KLU_numeric *Numeric, KLU_common *Common) ;
+
+#ifdef _OPENMP
+void KLU_level_solve (KLU_symbolic *Symbolic, KLU_numeric *Numeric, Int d,
+    Int nrhs, double B [ ], Int transpose,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    Int nthreads) ;
+#endif
+
 #endif
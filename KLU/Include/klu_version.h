@@ -37,6 +37,164 @@
 }
 
 /* function names */
+#ifdef SINGLE
+
+#ifdef COMPLEX
+
+#ifdef DLONG
+
+#define KLU_scale klu_cl_scale
+#define KLU_solve klu_cl_solve
+#define KLU_tsolve klu_cl_tsolve
+#define KLU_free_numeric klu_cl_free_numeric
+#define KLU_factor klu_cl_factor
+#define KLU_refactor klu_cl_refactor
+#define KLU_partial_refactor klu_cl_partial_refactor
+#define KLU_kernel_factor klu_cl_kernel_factor
+#define KLU_dense_factor klu_cl_dense_factor
+#define KLU_lsolve klu_cl_lsolve
+#define KLU_ltsolve klu_cl_ltsolve
+#define KLU_usolve klu_cl_usolve
+#define KLU_utsolve klu_cl_utsolve
+#define KLU_kernel klu_cl_kernel
+#define KLU_valid klu_cl_valid
+#define KLU_valid_LU klu_cl_valid_LU
+#define KLU_sort klu_cl_sort
+#define KLU_rgrowth klu_cl_rgrowth
+#define KLU_rcond klu_cl_rcond
+#define KLU_extract klu_cl_extract
+#define KLU_condest klu_cl_condest
+#define KLU_flops klu_cl_flops
+#define KLU_levels klu_cl_levels
+#define KLU_free_levels klu_cl_free_levels
+#define KLU_level_solve klu_cl_level_solve
+#define KLU_factor_batch klu_cl_factor_batch
+#define KLU_refactor_batch klu_cl_refactor_batch
+#define KLU_solve_batch klu_cl_solve_batch
+#define KLU_free_batch klu_cl_free_batch
+#define KLU_save_numeric klu_cl_save_numeric
+#define KLU_load_numeric klu_cl_load_numeric
+#define KLU_refine klu_cl_refine
+#define KLU_spsolve klu_cl_spsolve
+
+#else
+
+#define KLU_scale klu_c_scale
+#define KLU_solve klu_c_solve
+#define KLU_tsolve klu_c_tsolve
+#define KLU_free_numeric klu_c_free_numeric
+#define KLU_factor klu_c_factor
+#define KLU_refactor klu_c_refactor
+#define KLU_partial_refactor klu_c_partial_refactor
+#define KLU_kernel_factor klu_c_kernel_factor
+#define KLU_dense_factor klu_c_dense_factor
+#define KLU_lsolve klu_c_lsolve
+#define KLU_ltsolve klu_c_ltsolve
+#define KLU_usolve klu_c_usolve
+#define KLU_utsolve klu_c_utsolve
+#define KLU_kernel klu_c_kernel
+#define KLU_valid klu_c_valid
+#define KLU_valid_LU klu_c_valid_LU
+#define KLU_sort klu_c_sort
+#define KLU_rgrowth klu_c_rgrowth
+#define KLU_rcond klu_c_rcond
+#define KLU_extract klu_c_extract
+#define KLU_condest klu_c_condest
+#define KLU_flops klu_c_flops
+#define KLU_levels klu_c_levels
+#define KLU_free_levels klu_c_free_levels
+#define KLU_level_solve klu_c_level_solve
+#define KLU_factor_batch klu_c_factor_batch
+#define KLU_refactor_batch klu_c_refactor_batch
+#define KLU_solve_batch klu_c_solve_batch
+#define KLU_free_batch klu_c_free_batch
+#define KLU_save_numeric klu_c_save_numeric
+#define KLU_load_numeric klu_c_load_numeric
+#define KLU_refine klu_c_refine
+#define KLU_spsolve klu_c_spsolve
+
+#endif
+
+#else
+
+#ifdef DLONG
+
+#define KLU_scale klu_sl_scale
+#define KLU_solve klu_sl_solve
+#define KLU_tsolve klu_sl_tsolve
+#define KLU_free_numeric klu_sl_free_numeric
+#define KLU_factor klu_sl_factor
+#define KLU_refactor klu_sl_refactor
+#define KLU_partial_refactor klu_sl_partial_refactor
+#define KLU_kernel_factor klu_sl_kernel_factor
+#define KLU_dense_factor klu_sl_dense_factor
+#define KLU_lsolve klu_sl_lsolve
+#define KLU_ltsolve klu_sl_ltsolve
+#define KLU_usolve klu_sl_usolve
+#define KLU_utsolve klu_sl_utsolve
+#define KLU_kernel klu_sl_kernel
+#define KLU_valid klu_sl_valid
+#define KLU_valid_LU klu_sl_valid_LU
+#define KLU_sort klu_sl_sort
+#define KLU_rgrowth klu_sl_rgrowth
+#define KLU_rcond klu_sl_rcond
+#define KLU_extract klu_sl_extract
+#define KLU_condest klu_sl_condest
+#define KLU_flops klu_sl_flops
+#define KLU_levels klu_sl_levels
+#define KLU_free_levels klu_sl_free_levels
+#define KLU_level_solve klu_sl_level_solve
+#define KLU_factor_batch klu_sl_factor_batch
+#define KLU_refactor_batch klu_sl_refactor_batch
+#define KLU_solve_batch klu_sl_solve_batch
+#define KLU_free_batch klu_sl_free_batch
+#define KLU_save_numeric klu_sl_save_numeric
+#define KLU_load_numeric klu_sl_load_numeric
+#define KLU_refine klu_sl_refine
+#define KLU_spsolve klu_sl_spsolve
+
+#else
+
+#define KLU_scale klu_s_scale
+#define KLU_solve klu_s_solve
+#define KLU_tsolve klu_s_tsolve
+#define KLU_free_numeric klu_s_free_numeric
+#define KLU_factor klu_s_factor
+#define KLU_refactor klu_s_refactor
+#define KLU_partial_refactor klu_s_partial_refactor
+#define KLU_kernel_factor klu_s_kernel_factor
+#define KLU_dense_factor klu_s_dense_factor
+#define KLU_lsolve klu_s_lsolve
+#define KLU_ltsolve klu_s_ltsolve
+#define KLU_usolve klu_s_usolve
+#define KLU_utsolve klu_s_utsolve
+#define KLU_kernel klu_s_kernel
+#define KLU_valid klu_s_valid
+#define KLU_valid_LU klu_s_valid_LU
+#define KLU_sort klu_s_sort
+#define KLU_rgrowth klu_s_rgrowth
+#define KLU_rcond klu_s_rcond
+#define KLU_extract klu_s_extract
+#define KLU_condest klu_s_condest
+#define KLU_flops klu_s_flops
+#define KLU_levels klu_s_levels
+#define KLU_free_levels klu_s_free_levels
+#define KLU_level_solve klu_s_level_solve
+#define KLU_factor_batch klu_s_factor_batch
+#define KLU_refactor_batch klu_s_refactor_batch
+#define KLU_solve_batch klu_s_solve_batch
+#define KLU_free_batch klu_s_free_batch
+#define KLU_save_numeric klu_s_save_numeric
+#define KLU_load_numeric klu_s_load_numeric
+#define KLU_refine klu_s_refine
+#define KLU_spsolve klu_s_spsolve
+
+#endif
+
+#endif
+
+#else
+
 #ifdef COMPLEX 
 
 #ifdef DLONG
@@ -47,7 +205,9 @@
 #define KLU_free_numeric klu_zl_free_numeric
 #define KLU_factor klu_zl_factor
 #define KLU_refactor klu_zl_refactor
+#define KLU_partial_refactor klu_zl_partial_refactor
 #define KLU_kernel_factor klu_zl_kernel_factor 
+#define KLU_dense_factor klu_zl_dense_factor
 #define KLU_lsolve klu_zl_lsolve
 #define KLU_ltsolve klu_zl_ltsolve
 #define KLU_usolve klu_zl_usolve
@@ -61,6 +221,17 @@
 #define KLU_extract klu_zl_extract
 #define KLU_condest klu_zl_condest
 #define KLU_flops klu_zl_flops
+#define KLU_levels klu_zl_levels
+#define KLU_free_levels klu_zl_free_levels
+#define KLU_level_solve klu_zl_level_solve
+#define KLU_factor_batch klu_zl_factor_batch
+#define KLU_refactor_batch klu_zl_refactor_batch
+#define KLU_solve_batch klu_zl_solve_batch
+#define KLU_free_batch klu_zl_free_batch
+#define KLU_save_numeric klu_zl_save_numeric
+#define KLU_load_numeric klu_zl_load_numeric
+#define KLU_refine klu_zl_refine
+#define KLU_spsolve klu_zl_spsolve
 
 #else
 
@@ -70,7 +241,9 @@
 #define KLU_free_numeric klu_z_free_numeric
 #define KLU_factor klu_z_factor
 #define KLU_refactor klu_z_refactor
+#define KLU_partial_refactor klu_z_partial_refactor
 #define KLU_kernel_factor klu_z_kernel_factor 
+#define KLU_dense_factor klu_z_dense_factor
 #define KLU_lsolve klu_z_lsolve
 #define KLU_ltsolve klu_z_ltsolve
 #define KLU_usolve klu_z_usolve
@@ -84,6 +257,17 @@
 #define KLU_extract klu_z_extract
 #define KLU_condest klu_z_condest
 #define KLU_flops klu_z_flops
+#define KLU_levels klu_z_levels
+#define KLU_free_levels klu_z_free_levels
+#define KLU_level_solve klu_z_level_solve
+#define KLU_factor_batch klu_z_factor_batch
+#define KLU_refactor_batch klu_z_refactor_batch
+#define KLU_solve_batch klu_z_solve_batch
+#define KLU_free_batch klu_z_free_batch
+#define KLU_save_numeric klu_z_save_numeric
+#define KLU_load_numeric klu_z_load_numeric
+#define KLU_refine klu_z_refine
+#define KLU_spsolve klu_z_spsolve
 
 #endif
 
@@ -97,7 +281,9 @@
 #define KLU_free_numeric klu_l_free_numeric
 #define KLU_factor klu_l_factor
 #define KLU_refactor klu_l_refactor
+#define KLU_partial_refactor klu_l_partial_refactor
 #define KLU_kernel_factor klu_l_kernel_factor 
+#define KLU_dense_factor klu_l_dense_factor
 #define KLU_lsolve klu_l_lsolve
 #define KLU_ltsolve klu_l_ltsolve
 #define KLU_usolve klu_l_usolve
@@ -111,6 +297,17 @@
 #define KLU_extract klu_l_extract
 #define KLU_condest klu_l_condest
 #define KLU_flops klu_l_flops
+#define KLU_levels klu_l_levels
+#define KLU_free_levels klu_l_free_levels
+#define KLU_level_solve klu_l_level_solve
+#define KLU_factor_batch klu_l_factor_batch
+#define KLU_refactor_batch klu_l_refactor_batch
+#define KLU_solve_batch klu_l_solve_batch
+#define KLU_free_batch klu_l_free_batch
+#define KLU_save_numeric klu_l_save_numeric
+#define KLU_load_numeric klu_l_load_numeric
+#define KLU_refine klu_l_refine
+#define KLU_spsolve klu_l_spsolve
 
 #else
 
@@ -120,7 +317,9 @@
 #define KLU_free_numeric klu_free_numeric
 #define KLU_factor klu_factor
 #define KLU_refactor klu_refactor
+#define KLU_partial_refactor klu_partial_refactor
 #define KLU_kernel_factor klu_kernel_factor 
+#define KLU_dense_factor klu_dense_factor
 #define KLU_lsolve klu_lsolve
 #define KLU_ltsolve klu_ltsolve
 #define KLU_usolve klu_usolve
@@ -134,6 +333,19 @@
 #define KLU_extract klu_extract
 #define KLU_condest klu_condest
 #define KLU_flops klu_flops
+#define KLU_levels klu_levels
+#define KLU_free_levels klu_free_levels
+#define KLU_level_solve klu_level_solve
+#define KLU_factor_batch klu_factor_batch
+#define KLU_refactor_batch klu_refactor_batch
+#define KLU_solve_batch klu_solve_batch
+#define KLU_free_batch klu_free_batch
+#define KLU_save_numeric klu_save_numeric
+#define KLU_load_numeric klu_load_numeric
+#define KLU_refine klu_refine
+#define KLU_spsolve klu_spsolve
+
+#endif
 
 #endif
 
@@ -152,9 +364,14 @@
 #define KLU_realloc klu_l_realloc
 #define KLU_add_size_t klu_l_add_size_t
 #define KLU_mult_size_t klu_l_mult_size_t
+#define KLU_schedule klu_l_schedule
+#define KLU_threads klu_l_threads
+#define KLU_save_symbolic klu_l_save_symbolic
+#define KLU_load_symbolic klu_l_load_symbolic
 
 #define KLU_symbolic klu_l_symbolic
 #define KLU_numeric klu_l_numeric
+#define KLU_batch klu_l_batch
 #define KLU_common klu_l_common
 
 #define BTF_order btf_l_order
@@ -176,9 +393,14 @@
 #define KLU_realloc klu_realloc
 #define KLU_add_size_t klu_add_size_t
 #define KLU_mult_size_t klu_mult_size_t
+#define KLU_schedule klu_schedule
+#define KLU_threads klu_threads
+#define KLU_save_symbolic klu_save_symbolic
+#define KLU_load_symbolic klu_load_symbolic
 
 #define KLU_symbolic klu_symbolic
 #define KLU_numeric klu_numeric
+#define KLU_batch klu_batch
 #define KLU_common klu_common
 
 #define BTF_order btf_order
@@ -248,16 +470,29 @@ SCALAR_IS_LTZERO(x):
 /* Real floating-point arithmetic */
 /* -------------------------------------------------------------------------- */
 
+/* In the single-precision versions (compiled with -DSINGLE), the entries of
+ * L, U, the diagonal of U, and the off-diagonal part are held as float
+ * (Entry), while the matrix A, the right-hand sides, and the solve workspace
+ * remain double (XEntry).  The Unit stays double, so the LU factors of a
+ * block still start on a Unit boundary.  In all other versions, XEntry and
+ * Entry are the same type. */
+
 #ifndef COMPLEX
 
 typedef double Unit ;
+#ifdef SINGLE
+#define Entry float
+#else
 #define Entry double
+#endif
+#define XEntry double
 
 #define SPLIT(s)                    (1)
 #define REAL(c)                     (c)
 #define IMAG(c)                     (0.)
 #define ASSIGN(c,s1,s2,p,split)     { (c) = (s1)[p] ; }
 #define CLEAR(c)                    { (c) = 0. ; }
+#define CONVERT(c,a)                { (c) = (a) ; }
 #define CLEAR_AND_INCREMENT(p)      { *p++ = 0. ; }
 #define IS_NAN(a)                   SCALAR_IS_NAN (a)
 #define IS_ZERO(a)                  SCALAR_IS_ZERO (a)
@@ -326,7 +561,17 @@ typedef struct
 } Double_Complex ;
 
 typedef Double_Complex Unit ;
+#ifdef SINGLE
+typedef struct
+{
+    float component [2] ;       /* real and imaginary parts */
+
+} Float_Complex ;
+#define Entry Float_Complex
+#else
 #define Entry Double_Complex
+#endif
+#define XEntry Double_Complex
 #define Real component [0]
 #define Imag component [1]
 
@@ -385,6 +630,15 @@ typedef Double_Complex Unit ;
 
 /* -------------------------------------------------------------------------- */
 
+/* c = a, where c and a can differ in precision (Entry and XEntry) */
+#define CONVERT(c,a) \
+{ \
+    (c).Real = (a).Real ; \
+    (c).Imag = (a).Imag ; \
+}
+
+/* -------------------------------------------------------------------------- */
+
 /* *p++ = 0 */
 #define CLEAR_AND_INCREMENT(p) \
 { \
@@ -206,7 +206,9 @@ klu_src = {
     '../Source/klu_defaults', ...
     '../Source/klu_analyze_given', ...
     '../Source/klu_analyze', ...
-    '../Source/klu_memory' } ;
+    '../Source/klu_memory', ...
+    '../Source/klu_schedule', ...
+    '../Source/klu_save_symbolic' } ;
 
 if (with_cholmod)
     klu_src = [klu_src { '../User/klu_l_cholmod' }] ;                       %#ok
@@ -225,6 +227,13 @@ klu_zlsrc = {
     '../Source/klu_diagnostics', ...
     '../Source/klu_sort', ...
     '../Source/klu_extract', ...
+    '../Source/klu_levels', ...
+    '../Source/klu_batch', ...
+    '../Source/klu_dense', ...
+    '../Source/klu_partial', ...
+    '../Source/klu_save_numeric', ...
+    '../Source/klu_refine', ...
+    '../Source/klu_spsolve', ...
     } ;
 
 klu_lobj = {
@@ -240,6 +249,13 @@ klu_lobj = {
     'klu_l_diagnostics', ...
     'klu_l_sort', ...
     'klu_l_extract', ...
+    'klu_l_levels', ...
+    'klu_l_batch', ...
+    'klu_l_dense', ...
+    'klu_l_partial', ...
+    'klu_l_save_numeric', ...
+    'klu_l_refine', ...
+    'klu_l_spsolve', ...
     } ;
 
 klu_zlobj = {
@@ -255,6 +271,13 @@ klu_zlobj = {
     'klu_zl_diagnostics', ...
     'klu_zl_sort', ...
     'klu_zl_extract', ...
+    'klu_zl_levels', ...
+    'klu_zl_batch', ...
+    'klu_zl_dense', ...
+    'klu_zl_partial', ...
+    'klu_zl_save_numeric', ...
+    'klu_zl_refine', ...
+    'klu_zl_spsolve', ...
     } ;
 
 try
@@ -66,7 +66,7 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
     Int n,          /* A is n-by-n. n must be > 0. */
     Int Ap [ ],     /* size n+1, column pointers for A */
     Int Ai [ ],     /* size nz = Ap [n], row indices for A */
-    Entry Ax [ ],   /* size nz, values of A */
+    XEntry Ax [ ],  /* size nz, values of A */
     Int Q [ ],      /* size n, optional column permutation */
     double Lsize,   /* estimate of number of nonzeros in L */
 
@@ -207,10 +207,11 @@ void KLU_lsolve
     Unit LU [ ],
     Int nrhs,
     /* right-hand-side on input, solution to Lx=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 )
 {
-    Entry x [4], lik ;
+    XEntry x [4] ;
+    Entry lik ;
     Int *Li ;
     Entry *Lx ;
     Int k, p, len, i ;
@@ -311,10 +312,11 @@ void KLU_usolve
     Entry Udiag [ ],
     Int nrhs,
     /* right-hand-side on input, solution to Ux=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 )
 {
-    Entry x [4], uik, ukk ;
+    XEntry x [4] ;
+    Entry uik, ukk ;
     Int *Ui ;
     Entry *Ux ;
     Int k, p, len, i ;
@@ -447,10 +449,11 @@ void KLU_ltsolve
     Int conj_solve,
 #endif
     /* right-hand-side on input, solution to L'x=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 )
 {
-    Entry x [4], lik ;
+    XEntry x [4] ;
+    Entry lik ;
     Int *Li ;
     Entry *Lx ;
     Int k, p, len, i ;
@@ -601,10 +604,11 @@ void KLU_utsolve
     Int conj_solve,
 #endif
     /* right-hand-side on input, solution to Ux=b on output */
-    Entry X [ ]
+    XEntry X [ ]
 )
 {
-    Entry x [4], uik, ukk ;
+    XEntry x [4] ;
+    Entry uik, ukk ;
     Int k, p, len, i ;
     Int *Ui ;
     Entry *Ux ;
@@ -0,0 +1,842 @@
+/* ========================================================================== */
+/* === KLU_batch ============================================================ */
+/* ========================================================================== */
+
+/* Factorize and solve a batch of matrices that all have the same pattern,
+ * using the pivot ordering and the pattern of L and U of one Numeric object
+ * computed by KLU_factor (the template).
+ *
+ * KLU_factor_batch:  creates a Batch object and factorizes nbatch matrices.
+ * KLU_refactor_batch:  refactorizes the batch with new numerical values.
+ * KLU_solve_batch:  solves A_b*x_b = b_b with each matrix A_b of the batch.
+ * KLU_free_batch:  frees a Batch object.
+ *
+ * The nbatch values of each entry of L, U, the off-diagonal part, and the
+ * scale factors are held next to each other, so that the innermost loops of
+ * the refactorization and the solve run across the batch with unit stride,
+ * where they can be vectorized by the compiler.  The work for each matrix is
+ * done in the same order as in KLU_refactor and KLU_solve, so the results for
+ * each matrix are the same as if it had been refactorized and solved on its
+ * own with the template.  If KLU is compiled with OpenMP, the batch is split
+ * into slices that are done in parallel (see Common->nthreads).
+ *
+ * No pivoting is done, so each matrix must be well-conditioned with the
+ * pivot ordering of the template.  A singular matrix does not stop the
+ * others:  Batch->Rank [b] is n if matrix b is nonsingular, or otherwise the
+ * first k for which U(k,k) is zero.  Common->status is KLU_SINGULAR if any
+ * matrix is singular, and Common->numerical_rank is the smallest Rank [b].
+ * Common->halt_if_singular is ignored.
+ *
+ * The template is not modified, but its pattern is used by the Batch object.
+ * It must not be freed while the Batch is in use.  KLU_refactor (if it
+ * re-pivots a block) and KLU_sort change the pattern of the template and
+ * increment Numeric->generation.  KLU_refactor_batch and KLU_solve_batch
+ * compare it with Batch->generation, and return KLU_INVALID if they differ.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === slice_width ========================================================== */
+/* ========================================================================== */
+
+/* Width of the slice of the batch given to each thread.  This is a multiple
+ * of KLU_BATCH_ALIGN, so that threads do not write to the same cache lines. */
+
+static Int slice_width
+(
+    Int nbatch,
+    Int nthreads
+)
+{
+    Int w ;
+    w = (nbatch + nthreads - 1) / nthreads ;
+    w = ((w + KLU_BATCH_ALIGN - 1) / KLU_BATCH_ALIGN) * KLU_BATCH_ALIGN ;
+    return (MIN (w, nbatch)) ;
+}
+
+
+/* ========================================================================== */
+/* === refactor_slice ======================================================= */
+/* ========================================================================== */
+
+/* Refactorize matrices b0 to b1-1 of the batch, with the same operations as
+ * refactor_block in klu_refactor.c, applied across the batch.  The workspace
+ * Batch->Xwork must be zero in columns b0 to b1-1 on input, and is zero on
+ * output.  The scale factors Batch->Rs are in the original row order. */
+
+static void refactor_slice
+(
+    /* inputs, not modified */
+    Int b0,             /* first matrix of the slice */
+    Int b1,             /* last matrix of the slice, plus one */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    XEntry Az [ ],      /* size nz*nbatch */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int scale,
+
+    /* input/output */
+    KLU_batch *Batch
+)
+{
+    Entry *LUx, *Udiag, *Offx, *X, *Xi, *Xk, *Lx, *Ux, *Dk ;
+    double *Rs, *Rsi ;
+    Int *Q, *R, *Pinv, *Lip, *Uip, *Llen, *Ulen, *Lxp, *Uxp, *Li, *Ui, *Rank ;
+    Unit *LU ;
+    Int n, nz, nb, nblocks, nzoff, block, k1, k2, nk, k, oldcol, oldrow,
+        newrow, pend, poff, p, up, ulen, llen, j, b ;
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    nzoff = Symbolic->nzoff ;
+    nz = Ap [n] ;
+    Pinv = Numeric->Pinv ;
+    Lip = Numeric->Lip ;
+    Uip = Numeric->Uip ;
+    Llen = Numeric->Llen ;
+    Ulen = Numeric->Ulen ;
+
+    nb = Batch->nbatch ;
+    Lxp = Batch->Lxp ;
+    Uxp = Batch->Uxp ;
+    LUx = (Entry *) Batch->LUx ;
+    Udiag = (Entry *) Batch->Udiag ;
+    Offx = (Entry *) Batch->Offx ;
+    Rs = Batch->Rs ;
+    Rank = Batch->Rank ;
+    X = (Entry *) Batch->Xwork ;
+
+    for (b = b0 ; b < b1 ; b++)
+    {
+        Rank [b] = n ;
+    }
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* the block is from rows/columns k1 to k2-1 */
+        /* ------------------------------------------------------------------ */
+
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        poff = Numeric->Offp [k1] ;
+        LU = (nk == 1) ? NULL : ((Unit **) Numeric->LUbx) [block] ;
+
+        for (k = k1 ; k < k2 ; k++)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* scatter kth column into X, or into Udiag for a singleton */
+            /* -------------------------------------------------------------- */
+
+            Dk = Udiag + nb*k ;
+            if (nk == 1)
+            {
+                for (b = b0 ; b < b1 ; b++)
+                {
+                    CLEAR (Dk [b]) ;
+                }
+            }
+
+            oldcol = Q [k] ;
+            pend = Ap [oldcol+1] ;
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal part */
+                    Xi = Offx + nb*poff ;
+                    poff++ ;
+                }
+                else if (nk == 1)
+                {
+                    /* singleton */
+                    Xi = Dk ;
+                }
+                else
+                {
+                    /* (newrow,k) is an entry in the block */
+                    Xi = X + nb*newrow ;
+                }
+                if (scale <= 0)
+                {
+                    for (b = b0 ; b < b1 ; b++)
+                    {
+                        CONVERT (Xi [b], Az [nz*b + p]) ;
+                    }
+                }
+                else
+                {
+                    Rsi = Rs + nb*oldrow ;
+                    for (b = b0 ; b < b1 ; b++)
+                    {
+                        /* Xi [b] = Az [nz*b+p] / Rs [oldrow] of matrix b */
+                        SCALE_DIV_ASSIGN (Xi [b], Az [nz*b + p], Rsi [b]) ;
+                    }
+                }
+            }
+
+            if (nk > 1)
+            {
+
+                /* ---------------------------------------------------------- */
+                /* compute kth column of U, and update kth column of A */
+                /* ---------------------------------------------------------- */
+
+                Ui = (Int *) (LU + Uip [k]) ;
+                ulen = Ulen [k] ;
+                Ux = LUx + nb*Uxp [k] ;
+                for (up = 0 ; up < ulen ; up++)
+                {
+                    j = Ui [up] ;
+                    Xk = X + nb*j ;
+                    for (b = b0 ; b < b1 ; b++)
+                    {
+                        Ux [b] = Xk [b] ;
+                        CLEAR (Xk [b]) ;
+                    }
+                    Li = (Int *) (LU + Lip [j+k1]) ;
+                    llen = Llen [j+k1] ;
+                    Lx = LUx + nb*Lxp [j+k1] ;
+                    for (p = 0 ; p < llen ; p++)
+                    {
+                        Xi = X + nb*Li [p] ;
+                        for (b = b0 ; b < b1 ; b++)
+                        {
+                            /* X [Li [p]] -= Lx [p] * ujk, for matrix b */
+                            MULT_SUB (Xi [b], Lx [b], Ux [b]) ;
+                        }
+                        Lx += nb ;
+                    }
+                    Ux += nb ;
+                }
+
+                /* get the diagonal entry of U */
+                Xk = X + nb*(k-k1) ;
+                for (b = b0 ; b < b1 ; b++)
+                {
+                    Dk [b] = Xk [b] ;
+                    CLEAR (Xk [b]) ;
+                }
+
+                /* gather and divide by pivot to get kth column of L */
+                Li = (Int *) (LU + Lip [k]) ;
+                llen = Llen [k] ;
+                Lx = LUx + nb*Lxp [k] ;
+                for (p = 0 ; p < llen ; p++)
+                {
+                    Xi = X + nb*Li [p] ;
+                    for (b = b0 ; b < b1 ; b++)
+                    {
+                        DIV (Lx [b], Xi [b], Dk [b]) ;
+                        CLEAR (Xi [b]) ;
+                    }
+                    Lx += nb ;
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* singular case */
+            /* -------------------------------------------------------------- */
+
+            for (b = b0 ; b < b1 ; b++)
+            {
+                if (IS_ZERO (Dk [b]) && Rank [b] == n)
+                {
+                    /* matrix b is numerically singular */
+                    Rank [b] = k ;
+                }
+            }
+        }
+        ASSERT (poff == Numeric->Offp [k2]) ;
+    }
+}
+
+
+/* ========================================================================== */
+/* === solve_slice ========================================================== */
+/* ========================================================================== */
+
+/* Solve A_b*x_b = b_b for matrices b0 to b1-1 of the batch, with the same
+ * operations as KLU_solve for a single right-hand-side, applied across the
+ * batch.  Uses columns b0 to b1-1 of Batch->Xwork as workspace. */
+
+static void solve_slice
+(
+    /* inputs, not modified */
+    Int b0,             /* first matrix of the slice */
+    Int b1,             /* last matrix of the slice, plus one */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    KLU_batch *Batch,
+    Int d,              /* leading dimension of B */
+
+    /* right-hand-sides on input, solutions on output */
+    XEntry B [ ]        /* size d*nbatch */
+)
+{
+    XEntry *X, *Xi, *Xk ;
+    Entry *LUx, *Udiag, *Offx, *Lx, *Ux, *Ox, *Dk ;
+    double *Rs, *Rsk ;
+    Int *Q, *R, *Pnum, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen, *Lxp, *Uxp,
+        *Li, *Ui ;
+    Unit *LU ;
+    Int n, nb, nblocks, block, k1, k2, nk, k, i, p, pend, len, b ;
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    Pnum = Numeric->Pnum ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Lip = Numeric->Lip ;
+    Uip = Numeric->Uip ;
+    Llen = Numeric->Llen ;
+    Ulen = Numeric->Ulen ;
+
+    nb = Batch->nbatch ;
+    Lxp = Batch->Lxp ;
+    Uxp = Batch->Uxp ;
+    LUx = (Entry *) Batch->LUx ;
+    Udiag = (Entry *) Batch->Udiag ;
+    Offx = (Entry *) Batch->Offx ;
+    Rs = Batch->Rs ;
+    X = (XEntry *) Batch->Xwork ;
+
+    /* ---------------------------------------------------------------------- */
+    /* scale and permute the right hand sides, X = P*(R\B) */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        i = Pnum [k] ;
+        Xk = X + nb*k ;
+        if (Rs == NULL)
+        {
+            for (b = b0 ; b < b1 ; b++)
+            {
+                Xk [b] = B [i + d*b] ;
+            }
+        }
+        else
+        {
+            Rsk = Rs + nb*k ;
+            for (b = b0 ; b < b1 ; b++)
+            {
+                SCALE_DIV_ASSIGN (Xk [b], B [i + d*b], Rsk [b]) ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve X = (L*U + Off)\X */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = nblocks-1 ; block >= 0 ; block--)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+
+        if (nk == 1)
+        {
+            Xk = X + nb*k1 ;
+            Dk = Udiag + nb*k1 ;
+            for (b = b0 ; b < b1 ; b++)
+            {
+                DIV (Xk [b], Xk [b], Dk [b]) ;
+            }
+        }
+        else
+        {
+            LU = ((Unit **) Numeric->LUbx) [block] ;
+
+            /* solve with L, as in KLU_lsolve */
+            for (k = k1 ; k < k2 ; k++)
+            {
+                Xk = X + nb*k ;
+                Li = (Int *) (LU + Lip [k]) ;
+                len = Llen [k] ;
+                Lx = LUx + nb*Lxp [k] ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Xi = X + nb*(Li [p] + k1) ;
+                    for (b = b0 ; b < b1 ; b++)
+                    {
+                        MULT_SUB (Xi [b], Lx [b], Xk [b]) ;
+                    }
+                    Lx += nb ;
+                }
+            }
+
+            /* solve with U, as in KLU_usolve */
+            for (k = k2-1 ; k >= k1 ; k--)
+            {
+                Xk = X + nb*k ;
+                Dk = Udiag + nb*k ;
+                for (b = b0 ; b < b1 ; b++)
+                {
+                    DIV (Xk [b], Xk [b], Dk [b]) ;
+                }
+                Ui = (Int *) (LU + Uip [k]) ;
+                len = Ulen [k] ;
+                Ux = LUx + nb*Uxp [k] ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Xi = X + nb*(Ui [p] + k1) ;
+                    for (b = b0 ; b < b1 ; b++)
+                    {
+                        MULT_SUB (Xi [b], Ux [b], Xk [b]) ;
+                    }
+                    Ux += nb ;
+                }
+            }
+        }
+
+        /* block back-substitution for the off-diagonal-block entries */
+        if (block > 0)
+        {
+            for (k = k1 ; k < k2 ; k++)
+            {
+                Xk = X + nb*k ;
+                pend = Offp [k+1] ;
+                for (p = Offp [k] ; p < pend ; p++)
+                {
+                    Xi = X + nb*Offi [p] ;
+                    Ox = Offx + nb*p ;
+                    for (b = b0 ; b < b1 ; b++)
+                    {
+                        MULT_SUB (Xi [b], Ox [b], Xk [b]) ;
+                    }
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute the result, B = Q*X */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        i = Q [k] ;
+        Xk = X + nb*k ;
+        for (b = b0 ; b < b1 ; b++)
+        {
+            B [i + d*b] = Xk [b] ;
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === KLU_free_batch ======================================================= */
+/* ========================================================================== */
+
+Int KLU_free_batch
+(
+    KLU_batch **BatchHandle,
+    KLU_common *Common
+)
+{
+    KLU_batch *Batch ;
+    size_t n, nb ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (BatchHandle == NULL || *BatchHandle == NULL)
+    {
+        return (TRUE) ;
+    }
+
+    Batch = *BatchHandle ;
+    n = Batch->n ;
+    nb = Batch->nbatch ;
+
+    KLU_free (Batch->Lxp, n, sizeof (Int), Common) ;
+    KLU_free (Batch->Uxp, n, sizeof (Int), Common) ;
+    KLU_free (Batch->LUx, Batch->nlu * nb, sizeof (Entry), Common) ;
+    KLU_free (Batch->Udiag, n * nb, sizeof (Entry), Common) ;
+    KLU_free (Batch->Offx, Batch->nzoff * nb, sizeof (Entry), Common) ;
+    KLU_free (Batch->Rs, n * nb, sizeof (double), Common) ;
+    KLU_free (Batch->Rank, nb, sizeof (Int), Common) ;
+    KLU_free (Batch->Xwork, n * nb, sizeof (XEntry), Common) ;
+    KLU_free (Batch, 1, sizeof (KLU_batch), Common) ;
+
+    *BatchHandle = NULL ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_refactor_batch =================================================== */
+/* ========================================================================== */
+
+Int KLU_refactor_batch      /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz*nbatch */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+
+    /* input/output */
+    KLU_batch *Batch,
+    KLU_common *Common
+)
+{
+    XEntry *Az ;
+    Entry *X ;
+    double *Rs, *W ;
+    Int *Pnum, *Rank ;
+    size_t wsize ;
+    Int n, nz, nb, scale, nthreads, width, nslices, s, k, i, b, brank ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    if (Symbolic == NULL || Numeric == NULL || Batch == NULL || Ap == NULL
+        || Ai == NULL || Ax == NULL || Batch->n != Symbolic->n
+        || Batch->generation != Numeric->generation)
+    {
+        /* invalid inputs, or the pattern of the template has changed */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    Common->numerical_rank = EMPTY ;
+    Common->singular_col = EMPTY ;
+
+    n = Symbolic->n ;
+    nz = Ap [n] ;
+    nb = Batch->nbatch ;
+    Az = (XEntry *) Ax ;
+    Pnum = Numeric->Pnum ;
+    Rank = Batch->Rank ;
+    X = (Entry *) Batch->Xwork ;
+    W = (double *) Batch->Xwork ;
+    wsize = ((size_t) n) * nb ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate or free the scale factors, as in KLU_refactor */
+    /* ---------------------------------------------------------------------- */
+
+    scale = Common->scale ;
+    if (scale > 0)
+    {
+        if (Batch->Rs == NULL)
+        {
+            Batch->Rs = KLU_malloc (wsize, sizeof (double), Common) ;
+            if (Common->status < KLU_OK)
+            {
+                Common->status = KLU_OUT_OF_MEMORY ;
+                return (FALSE) ;
+            }
+        }
+    }
+    else
+    {
+        Batch->Rs = KLU_free (Batch->Rs, wsize, sizeof (double), Common) ;
+    }
+    Rs = Batch->Rs ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check the input matrices and compute the row scale factors, Rs */
+    /* ---------------------------------------------------------------------- */
+
+    if (scale == 0)
+    {
+        /* the pattern is the same for all matrices; check it just once */
+        if (!KLU_scale (0, n, Ap, Ai, Ax, NULL, NULL, Common))
+        {
+            return (FALSE) ;
+        }
+    }
+    else if (scale > 0)
+    {
+        /* Rs (i,b) is the scale factor of row i of matrix b, in W [i] */
+        for (b = 0 ; b < nb ; b++)
+        {
+            if (!KLU_scale (scale, n, Ap, Ai, (double *) (Az + nz*b), W, NULL,
+                Common))
+            {
+                return (FALSE) ;
+            }
+            for (i = 0 ; i < n ; i++)
+            {
+                Rs [nb*i + b] = W [i] ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* clear workspace X, then refactorize each slice of the batch */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < (Int) wsize ; k++)
+    {
+        /* X [k] = 0 */
+        CLEAR (X [k]) ;
+    }
+
+    nthreads = KLU_threads (Common) ;
+    width = slice_width (nb, nthreads) ;
+    nslices = (nb + width - 1) / width ;
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static) \
+        if(nslices > 1)
+#endif
+    for (s = 0 ; s < nslices ; s++)
+    {
+        refactor_slice (s*width, MIN (nb, (s+1)*width), Ap, Ai, Az, Symbolic,
+            Numeric, scale, Batch) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute scale factors Rs according to pivotal row order */
+    /* ---------------------------------------------------------------------- */
+
+    if (scale > 0)
+    {
+        for (k = 0 ; k < n ; k++)
+        {
+            i = Pnum [k] ;
+            for (b = 0 ; b < nb ; b++)
+            {
+                W [nb*k + b] = Rs [nb*i + b] ;
+            }
+        }
+        for (k = 0 ; k < (Int) wsize ; k++)
+        {
+            Rs [k] = W [k] ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* find the smallest rank in the batch */
+    /* ---------------------------------------------------------------------- */
+
+    brank = n ;
+    for (b = 0 ; b < nb ; b++)
+    {
+        brank = MIN (brank, Rank [b]) ;
+    }
+    Common->numerical_rank = brank ;
+    if (brank < n)
+    {
+        /* at least one matrix is numerically singular */
+        Common->status = KLU_SINGULAR ;
+        Common->singular_col = Symbolic->Q [brank] ;
+    }
+    else
+    {
+        Common->singular_col = n ;
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_factor_batch ===================================================== */
+/* ========================================================================== */
+
+KLU_batch *KLU_factor_batch     /* returns NULL if error */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz*nbatch */
+    Int nbatch,         /* number of matrices */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    KLU_batch *Batch ;
+    size_t nlu, wsize, lusize, offsize ;
+    Int *R ;
+    Int n, nblocks, block, k, nk, status, ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (NULL) ;
+    }
+    Common->status = KLU_OK ;
+
+    if (Symbolic == NULL || Numeric == NULL || Ap == NULL || Ai == NULL
+        || Ax == NULL || nbatch <= 0 || Numeric->n != Symbolic->n)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    n = Symbolic->n ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the Batch object */
+    /* ---------------------------------------------------------------------- */
+
+    Batch = KLU_malloc (1, sizeof (KLU_batch), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        return (NULL) ;
+    }
+    Batch->n = n ;
+    Batch->nbatch = nbatch ;
+    Batch->nzoff = Symbolic->nzoff ;
+    Batch->LUx = NULL ;
+    Batch->Udiag = NULL ;
+    Batch->Offx = NULL ;
+    Batch->Rs = NULL ;
+    Batch->Rank = NULL ;
+    Batch->Xwork = NULL ;
+    Batch->generation = Numeric->generation ;
+
+    /* L(:,k) and U(:,k) of each block are held one after the other in LUx */
+    Batch->Lxp = KLU_malloc (n, sizeof (Int), Common) ;
+    Batch->Uxp = KLU_malloc (n, sizeof (Int), Common) ;
+    nlu = 0 ;
+    if (Common->status == KLU_OK)
+    {
+        for (block = 0 ; block < nblocks ; block++)
+        {
+            nk = R [block+1] - R [block] ;
+            for (k = R [block] ; k < R [block+1] ; k++)
+            {
+                Batch->Lxp [k] = nlu ;
+                nlu += (nk == 1) ? 0 : Numeric->Llen [k] ;
+                Batch->Uxp [k] = nlu ;
+                nlu += (nk == 1) ? 0 : Numeric->Ulen [k] ;
+            }
+        }
+    }
+    Batch->nlu = nlu ;
+
+    lusize  = KLU_mult_size_t (nlu, nbatch, &ok) ;
+    wsize   = KLU_mult_size_t (n, nbatch, &ok) ;
+    offsize = KLU_mult_size_t (Batch->nzoff, nbatch, &ok) ;
+    if (!ok)
+    {
+        /* problem is too large */
+        Batch->nbatch = 0 ;
+        KLU_free_batch (&Batch, Common) ;
+        Common->status = KLU_TOO_LARGE ;
+        return (NULL) ;
+    }
+
+    Batch->LUx = KLU_malloc (lusize, sizeof (Entry), Common) ;
+    Batch->Udiag = KLU_malloc (wsize, sizeof (Entry), Common) ;
+    Batch->Offx = KLU_malloc (offsize, sizeof (Entry), Common) ;
+    Batch->Rank = KLU_malloc (nbatch, sizeof (Int), Common) ;
+    Batch->Xwork = KLU_malloc (wsize, sizeof (XEntry), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free_batch (&Batch, Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the batch */
+    /* ---------------------------------------------------------------------- */
+
+    if (!KLU_refactor_batch (Ap, Ai, Ax, Symbolic, Numeric, Batch, Common))
+    {
+        status = Common->status ;
+        KLU_free_batch (&Batch, Common) ;
+        Common->status = status ;
+        return (NULL) ;
+    }
+    return (Batch) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_solve_batch ====================================================== */
+/* ========================================================================== */
+
+Int KLU_solve_batch
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    KLU_batch *Batch,
+    Int d,              /* leading dimension of B */
+
+    /* right-hand-sides on input, overwritten with solutions to Ax=b on output*/
+    double B [ ],       /* size n*nbatch, in column-oriented form, with
+                         * leading dimension d. */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    XEntry *Bz ;
+    Int nb, nthreads, width, nslices, s ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Symbolic == NULL || Numeric == NULL || Batch == NULL || B == NULL
+        || Batch->n != Symbolic->n || d < Symbolic->n
+        || Batch->generation != Numeric->generation)
+    {
+        /* invalid inputs, or the pattern of the template has changed */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    Bz = (XEntry *) B ;
+    nb = Batch->nbatch ;
+
+    /* ---------------------------------------------------------------------- */
+    /* solve each slice of the batch */
+    /* ---------------------------------------------------------------------- */
+
+    nthreads = KLU_threads (Common) ;
+    width = slice_width (nb, nthreads) ;
+    nslices = (nb + width - 1) / width ;
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static) \
+        if(nslices > 1)
+#endif
+    for (s = 0 ; s < nslices ; s++)
+    {
+        solve_slice (s*width, MIN (nb, (s+1)*width), Symbolic, Numeric, Batch,
+            d, Bz) ;
+    }
+
+    return (TRUE) ;
+}
@@ -30,6 +30,11 @@ Int KLU_defaults
                                  * 0: none, but check for errors,
                                  * 1: sum, 2: max */
     Common->halt_if_singular = TRUE ;   /* quick halt if matrix is singular */
+    Common->nthreads = 1 ;      /* factorize the BTF blocks in one thread */
+    Common->dense = 0 ;         /* always use the sparse LU kernel */
+    Common->irstep = 10 ;       /* at most 10 steps of refinement in
+                                 * KLU_refine */
+    Common->repivot = 0 ;       /* KLU_refactor never re-pivots */
 
     /* user ordering function and optional argument */
     Common->user_order = NULL ;
@@ -38,6 +43,7 @@ Int KLU_defaults
     /* statistics */
     Common->status = KLU_OK ;
     Common->nrealloc = 0 ;
+    Common->nrepivot = 0 ;
     Common->structural_rank = EMPTY ;
     Common->numerical_rank = EMPTY ;
     Common->noffdiag = EMPTY ;
@@ -46,6 +52,7 @@ Int KLU_defaults
     Common->condest = EMPTY ;
     Common->rgrowth = EMPTY ;
     Common->work = 0 ;          /* work done by btf_order */
+    Common->berr = EMPTY ;
 
     Common->memusage = 0 ;
     Common->mempeak = 0 ;
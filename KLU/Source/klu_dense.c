@@ -0,0 +1,414 @@
+/* ========================================================================== */
+/* === KLU_dense_factor ===================================================== */
+/* ========================================================================== */
+
+/* Factorizes one diagonal block of the BTF form with a dense LU kernel.  This
+ * is used by KLU_factor in place of KLU_kernel_factor for blocks whose
+ * factors are expected to be fairly dense (see Common->dense).  Not user
+ * callable.
+ *
+ * The block is scattered into an nk-by-nk dense matrix F, and factorized by
+ * a right-looking LU with partial pivoting, KLU_DENSE_PANEL columns at a time:
+ * the columns of a panel are factorized one after the other, and then all the
+ * columns to the right of the panel are updated with the whole panel, which
+ * stays in cache while they are updated.  The pivot rule is the same as in
+ * KLU_kernel (the diagonal is preferred if its magnitude is at least
+ * Common->tol times the largest entry in the column, see lpivot).
+ *
+ * Alongside F, the nonzero pattern of the factors is kept in a boolean matrix
+ * S, and only the entries of F in this pattern are used to update other
+ * columns and to choose the pivots.  This is the same pattern that the
+ * Gilbert-Peierls kernel finds with its depth-first searches, for the same
+ * pivot sequence.  The factors are returned with exactly that pattern, in the
+ * packed form used by KLU_kernel_factor (with U in ascending order), so that
+ * KLU_refactor, KLU_solve and all other functions work on them unchanged.
+ * Entries that happen to be numerically zero are kept, just as in KLU_kernel.
+ *
+ * The off-diagonal part (entries of A to the left of the block) and the row
+ * scaling are handled as in KLU_kernel.  If the dense workspace cannot be
+ * allocated, the block is factorized by KLU_kernel_factor instead.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === dense_update ========================================================= */
+/* ========================================================================== */
+
+/* Update column c of F with columns j1 to j2-1 of L:
+ * F (j+1:n-1,c) -= L (j+1:n-1,j) * U (j,c), for each j = j1 to j2-1 with
+ * U (j,c) in the pattern.  The pattern of column c is updated too. */
+
+static void dense_update
+(
+    Int n,
+    Int c,
+    Int j1,
+    Int j2,
+    Entry F [ ],
+    unsigned char S [ ]
+)
+{
+    Entry ujc, *Fc, *Fj ;
+    unsigned char *Sc, *Sj ;
+    Int i, j ;
+
+    Fc = F + c*n ;
+    Sc = S + c*n ;
+    for (j = j1 ; j < j2 ; j++)
+    {
+        if (!Sc [j])
+        {
+            /* U (j,c) is not in the pattern */
+            continue ;
+        }
+        ujc = Fc [j] ;
+        Fj = F + j*n ;
+        Sj = S + j*n ;
+        for (i = j+1 ; i < n ; i++)
+        {
+            /* F (i,c) -= L (i,j) * U (j,c) ; */
+            MULT_SUB (Fc [i], Fj [i], ujc) ;
+            Sc [i] |= Sj [i] ;
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === KLU_dense_factor ===================================================== */
+/* ========================================================================== */
+
+size_t KLU_dense_factor             /* 0 if failure, size of LU if OK */
+(
+    /* inputs, not modified */
+    Int n,          /* A is n-by-n. n must be > 0. */
+    Int Ap [ ],     /* size n+1, column pointers for A */
+    Int Ai [ ],     /* size nz = Ap [n], row indices for A */
+    XEntry Ax [ ],  /* size nz, values of A */
+    Int Q [ ],      /* size n, optional column permutation */
+    double Lsize,   /* estimate of number of nonzeros in L */
+
+    /* outputs, not defined on input */
+    Unit **p_LU,        /* row indices and values of L and U */
+    Entry Udiag [ ],    /* size n, diagonal of U */
+    Int Llen [ ],       /* size n, column length of L */
+    Int Ulen [ ],       /* size n, column length of U */
+    Int Lip [ ],        /* size n, column pointers for L */
+    Int Uip [ ],        /* size n, column pointers for U */
+    Int P [ ],          /* row permutation, size n */
+    Int *lnz,           /* size of L */
+    Int *unz,           /* size of U */
+
+    /* workspace, undefined on input */
+    Entry *X,       /* size n double's, zero on output */
+    Int *Work,      /* size 5n Int's */
+
+    /* inputs, not modified on output */
+    Int k1,             /* the block of A is from k1 to k2-1 */
+    Int PSinv [ ],      /* inverse of P from symbolic factorization */
+    double Rs [ ],      /* scale factors for A */
+
+    /* inputs, modified on output */
+    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offi [ ],
+    Entry Offx [ ],
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    XEntry aik ;
+    Entry pivot, t, *F, *Fk, *Lx, *Ux ;
+    double abs_pivot, xabs, tol, dunits ;
+    unsigned char *S, *Sk, st ;
+    Unit *LU ;
+    Int *Li, *Ui ;
+    Int i, k, p, c, j1, j2, pend, oldcol, oldrow, kglobal, poff, pivrow,
+        lastrow, scale, llen, ulen, lup, len, status ;
+    size_t nn, lusize ;
+
+    ASSERT (Common != NULL) ;
+    scale = Common->scale ;
+    tol = Common->tol ;
+    *lnz = 0 ;
+    *unz = 0 ;
+    *p_LU = (Unit *) NULL ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the dense workspace, or use the sparse kernel instead */
+    /* ---------------------------------------------------------------------- */
+
+    F = NULL ;
+    S = NULL ;
+    nn = ((size_t) n) * ((size_t) n) ;
+    status = Common->status ;
+    if (((double) n) * ((double) n) < (double) Int_MAX)
+    {
+        F = KLU_malloc (nn, sizeof (Entry), Common) ;
+        S = KLU_malloc (nn, sizeof (unsigned char), Common) ;
+    }
+    if (F == NULL || S == NULL)
+    {
+        KLU_free (F, nn, sizeof (Entry), Common) ;
+        KLU_free (S, nn, sizeof (unsigned char), Common) ;
+        Common->status = status ;
+        return (KLU_kernel_factor (n, Ap, Ai, Ax, Q, Lsize, p_LU, Udiag,
+            Llen, Ulen, Lip, Uip, P, lnz, unz, X, Work, k1, PSinv, Rs,
+            Offp, Offi, Offx, Common)) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* scatter the block into F and S, and construct the off-diagonal part */
+    /* ---------------------------------------------------------------------- */
+
+    for (p = 0 ; p < (Int) nn ; p++)
+    {
+        CLEAR (F [p]) ;
+        S [p] = 0 ;
+    }
+
+    for (k = 0 ; k < n ; k++)
+    {
+        Fk = F + k*n ;
+        Sk = S + k*n ;
+        kglobal = k + k1 ;
+        poff = Offp [kglobal] ;
+        oldcol = Q [kglobal] ;
+        pend = Ap [oldcol+1] ;
+        for (p = Ap [oldcol] ; p < pend ; p++)
+        {
+            oldrow = Ai [p] ;
+            i = PSinv [oldrow] - k1 ;
+            aik = Ax [p] ;
+            if (scale > 0)
+            {
+                SCALE_DIV (aik, Rs [oldrow]) ;
+            }
+            if (i < 0)
+            {
+                /* this is an entry in the off-diagonal part */
+                Offi [poff] = oldrow ;
+                CONVERT (Offx [poff], aik) ;
+                poff++ ;
+            }
+            else
+            {
+                CONVERT (Fk [i], aik) ;
+                Sk [i] = 1 ;
+            }
+        }
+        Offp [kglobal+1] = poff ;
+        P [k] = k ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize F, one panel of columns j1 to j2-1 at a time */
+    /* ---------------------------------------------------------------------- */
+
+    for (j1 = 0 ; j1 < n ; j1 = j2)
+    {
+        j2 = MIN (n, j1 + KLU_DENSE_PANEL) ;
+
+        for (k = j1 ; k < j2 ; k++)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* update column k with the prior columns of the panel */
+            /* -------------------------------------------------------------- */
+
+            dense_update (n, k, j1, k, F, S) ;
+            Fk = F + k*n ;
+            Sk = S + k*n ;
+
+            /* -------------------------------------------------------------- */
+            /* partial pivoting with diagonal preference */
+            /* -------------------------------------------------------------- */
+
+            /* row k is the "diagonal" of column k, as in KLU_kernel, since
+             * rows are swapped into place as the pivots are chosen */
+            pivrow = EMPTY ;
+            lastrow = EMPTY ;
+            abs_pivot = EMPTY ;
+            for (i = k ; i < n ; i++)
+            {
+                if (Sk [i])
+                {
+                    ABS (xabs, Fk [i]) ;
+                    if (xabs > abs_pivot)
+                    {
+                        abs_pivot = xabs ;
+                        pivrow = i ;
+                    }
+                    lastrow = i ;
+                }
+            }
+            if (pivrow == EMPTY)
+            {
+                /* no entries in the pattern, or all of them are NaN */
+                pivrow = lastrow ;
+            }
+            if (Sk [k])
+            {
+                ABS (xabs, Fk [k]) ;
+                if (xabs >= tol * abs_pivot)
+                {
+                    /* the diagonal is large enough */
+                    pivrow = k ;
+                }
+            }
+
+            if (pivrow == EMPTY || IS_ZERO (Fk [pivrow]))
+            {
+                /* matrix is structurally or numerically singular */
+                Common->status = KLU_SINGULAR ;
+                if (Common->numerical_rank == EMPTY)
+                {
+                    Common->numerical_rank = k+k1 ;
+                    Common->singular_col = Q [k+k1] ;
+                }
+                if (Common->halt_if_singular)
+                {
+                    /* do not continue the factorization */
+                    KLU_free (F, nn, sizeof (Entry), Common) ;
+                    KLU_free (S, nn, sizeof (unsigned char), Common) ;
+                    return (0) ;
+                }
+                if (pivrow == EMPTY)
+                {
+                    /* column k is empty; U (k,k) is zero */
+                    pivrow = k ;
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* swap rows k and pivrow of F and S, and divide L by the pivot */
+            /* -------------------------------------------------------------- */
+
+            if (pivrow != k)
+            {
+                /* an off-diagonal pivot has been chosen */
+                Common->noffdiag++ ;
+                for (c = 0 ; c < n ; c++)
+                {
+                    t = F [k + c*n] ;
+                    F [k + c*n] = F [pivrow + c*n] ;
+                    F [pivrow + c*n] = t ;
+                    st = S [k + c*n] ;
+                    S [k + c*n] = S [pivrow + c*n] ;
+                    S [pivrow + c*n] = st ;
+                }
+                i = P [k] ;
+                P [k] = P [pivrow] ;
+                P [pivrow] = i ;
+            }
+
+            pivot = Fk [k] ;
+            for (i = k+1 ; i < n ; i++)
+            {
+                if (Sk [i])
+                {
+                    /* Fk [i] /= pivot ; */
+                    DIV (Fk [i], Fk [i], pivot) ;
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* update the columns to the right of the panel */
+        /* ------------------------------------------------------------------ */
+
+        for (c = j2 ; c < n ; c++)
+        {
+            dense_update (n, c, j1, j2, F, S) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the LU factors */
+    /* ---------------------------------------------------------------------- */
+
+    dunits = 0 ;
+    for (k = 0 ; k < n ; k++)
+    {
+        Sk = S + k*n ;
+        ulen = 0 ;
+        for (i = 0 ; i < k ; i++)
+        {
+            ulen += Sk [i] ;
+        }
+        llen = 0 ;
+        for (i = k+1 ; i < n ; i++)
+        {
+            llen += Sk [i] ;
+        }
+        Llen [k] = llen ;
+        Ulen [k] = ulen ;
+        dunits += DUNITS (Int, llen) + DUNITS (Entry, llen) +
+                  DUNITS (Int, ulen) + DUNITS (Entry, ulen) ;
+    }
+    dunits = MAX (dunits, 1) ;
+    lusize = (size_t) dunits ;
+    LU = INT_OVERFLOW (dunits) ? NULL :
+        KLU_malloc (lusize, sizeof (Unit), Common) ;
+    if (LU == NULL)
+    {
+        /* out of memory, or problem too large */
+        if (Common->status >= KLU_OK)
+        {
+            Common->status = KLU_TOO_LARGE ;
+        }
+        KLU_free (F, nn, sizeof (Entry), Common) ;
+        KLU_free (S, nn, sizeof (unsigned char), Common) ;
+        return (0) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* copy the factors into LU */
+    /* ---------------------------------------------------------------------- */
+
+    lup = 0 ;
+    for (k = 0 ; k < n ; k++)
+    {
+        Fk = F + k*n ;
+        Sk = S + k*n ;
+
+        /* L (k+1:n-1,k), with row indices in the pivotal order */
+        Lip [k] = lup ;
+        GET_POINTER (LU, Lip, Llen, Li, Lx, k, len) ;
+        for (p = 0, i = k+1 ; i < n ; i++)
+        {
+            if (Sk [i])
+            {
+                Li [p] = i ;
+                Lx [p] = Fk [i] ;
+                p++ ;
+            }
+        }
+        lup += UNITS (Int, len) + UNITS (Entry, len) ;
+
+        /* U (0:k-1,k), in ascending order */
+        Uip [k] = lup ;
+        GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, len) ;
+        for (p = 0, i = 0 ; i < k ; i++)
+        {
+            if (Sk [i])
+            {
+                Ui [p] = i ;
+                Ux [p] = Fk [i] ;
+                p++ ;
+            }
+        }
+        lup += UNITS (Int, len) + UNITS (Entry, len) ;
+
+        /* U(k,k) = pivot */
+        Udiag [k] = Fk [k] ;
+        *lnz += Llen [k] + 1 ; /* 1 added to lnz for diagonal */
+        *unz += Ulen [k] + 1 ; /* 1 added to unz for diagonal */
+    }
+    ASSERT ((size_t) lup <= lusize) ;
+
+    KLU_free (F, nn, sizeof (Entry), Common) ;
+    KLU_free (S, nn, sizeof (unsigned char), Common) ;
+    *p_LU = LU ;
+    return (lusize) ;
+}
@@ -33,10 +33,10 @@ Int KLU_rgrowth         /* return TRUE if successful, FALSE otherwise */
 )
 {
     double temp, max_ai, max_ui, min_block_rgrowth ;
-    Entry aik ;
+    XEntry aik, *Aentry ;
     Int *Q, *Ui, *Uip, *Ulen, *Pinv ;
     Unit *LU ;
-    Entry *Aentry, *Ux, *Ukk ;
+    Entry *Ux, *Ukk ;
     double *Rs ;
     Int i, newrow, oldrow, k1, k2, nk, j, oldcol, k, pend, len ;
 
@@ -68,7 +68,7 @@ Int KLU_rgrowth         /* return TRUE if successful, FALSE otherwise */
     /* compute the reciprocal pivot growth */
     /* ---------------------------------------------------------------------- */
 
-    Aentry = (Entry *) Ax ;
+    Aentry = (XEntry *) Ax ;
     Pinv = Numeric->Pinv ;
     Rs = Numeric->Rs ;
     Q = Symbolic->Q ;
@@ -179,7 +179,8 @@ Int KLU_condest         /* return TRUE if successful, FALSE otherwise */
 )
 {
     double xj, Xmax, csum, anorm, ainv_norm, est_old, est_new, abs_value ;
-    Entry *Udiag, *Aentry, *X, *S ;
+    XEntry *Aentry, *X, *S ;
+    Entry *Udiag ;
     Int i, j, jmax, jnew, pend, n ;
 #ifndef COMPLEX
     Int unchanged ;
@@ -235,7 +236,7 @@ Int KLU_condest         /* return TRUE if successful, FALSE otherwise */
     /* ---------------------------------------------------------------------- */
 
     anorm =  0.0 ;
-    Aentry = (Entry *) Ax ;
+    Aentry = (XEntry *) Ax ;
     for (i = 0 ; i < n ; i++)
     {
         pend = Ap [i + 1] ;
@@ -255,7 +256,7 @@ Int KLU_condest         /* return TRUE if successful, FALSE otherwise */
     /* compute estimate of 1-norm of inv (A) */
     /* ---------------------------------------------------------------------- */
 
-    /* get workspace (size 2*n Entry's) */
+    /* get workspace (size 2*n XEntry's) */
     X = Numeric->Xwork ;            /* size n space used in KLU_solve, tsolve */
     X += n ;                        /* X is size n */
     S = X + n ;                     /* S is size n */
@@ -7,46 +7,60 @@
  */
 
 #include "klu_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* ========================================================================== */
-/* === KLU_factor2 ========================================================== */
+/* === factor_block ========================================================= */
 /* ========================================================================== */
 
-static void factor2
+/* Factorize a single diagonal block of the BTF form, and copy the entries of
+ * A to its left into the off-diagonal part.  Offp [k1] must already be
+ * defined on input.  Different blocks can be factorized at the same time,
+ * each with its own X, Iwork, and Common. */
+
+static void factor_block
 (
     /* inputs, not modified */
+    Int block,          /* the block to factorize */
     Int Ap [ ],         /* size n+1, column pointers */
     Int Ai [ ],         /* size nz, row indices */
-    Entry Ax [ ],
+    XEntry Ax [ ],
     KLU_symbolic *Symbolic,
 
     /* inputs, modified on output: */
     KLU_numeric *Numeric,
+
+    /* workspace, undefined on input */
+    Entry *X,           /* size maxblock */
+    Int *Iwork,         /* size 6*maxblock */
+
+    /* statistics, updated on output */
+    Int *lnz,
+    Int *unz,
+    Int *max_lnz_block,
+    Int *max_unz_block,
     KLU_common *Common
 )
 {
     double lsize ;
     double *Lnz, *Rs ;
-    Int *P, *Q, *R, *Pnum, *Offp, *Offi, *Pblock, *Pinv, *Iwork,
-        *Lip, *Uip, *Llen, *Ulen ;
-    Entry *Offx, *X, s, *Udiag ;
+    Int *P, *Q, *R, *Pnum, *Offp, *Offi, *Pblock, *Pinv, *Lip, *Uip, *Llen,
+        *Ulen ;
+    Entry *Offx, s, *Udiag ;
     Unit **LUbx ;
-    Int k1, k2, nk, k, block, oldcol, pend, oldrow, n, lnz, unz, p, newrow,
-        nblocks, poff, nzoff, lnz_block, unz_block, scale, max_lnz_block,
-        max_unz_block ;
+    Int k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, poff, lnz_block,
+        unz_block, scale ;
 
     /* ---------------------------------------------------------------------- */
-    /* initializations */
+    /* get the contents of the Symbolic and Numeric objects */
     /* ---------------------------------------------------------------------- */
 
-    /* get the contents of the Symbolic object */
-    n = Symbolic->n ;
     P = Symbolic->P ;
     Q = Symbolic->Q ;
     R = Symbolic->R ;
     Lnz = Symbolic->Lnz ;
-    nblocks = Symbolic->nblocks ;
-    nzoff = Symbolic->nzoff ;
 
     Pnum = Numeric->Pnum ;
     Offp = Numeric->Offp ;
@@ -60,12 +74,445 @@ static void factor2
     LUbx = (Unit **) Numeric->LUbx ;
     Udiag = Numeric->Udiag ;
 
+    Rs = Numeric->Rs ;
+    Pinv = Numeric->Pinv ;
+    Pblock = Iwork + 5*((size_t) Symbolic->maxblock) ;
+    scale = Common->scale ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the block is from rows/columns k1 to k2-1 */
+    /* ---------------------------------------------------------------------- */
+
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    PRINTF (("FACTOR BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1,k2-1,nk)) ;
+
+    if (nk == 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* singleton case */
+        /* ------------------------------------------------------------------ */
+
+        poff = Offp [k1] ;
+        oldcol = Q [k1] ;
+        pend = Ap [oldcol+1] ;
+        CLEAR (s) ;
+
+        if (scale <= 0)
+        {
+            /* no scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] ;
+                if (newrow < k1)
+                {
+                    Offi [poff] = oldrow ;
+                    CONVERT (Offx [poff], Ax [p]) ;
+                    poff++ ;
+                }
+                else
+                {
+                    ASSERT (newrow == k1) ;
+                    PRINTF (("singleton block %d", block)) ;
+                    PRINT_ENTRY (Ax [p]) ;
+                    CONVERT (s, Ax [p]) ;
+                }
+            }
+        }
+        else
+        {
+            /* row scaling.  NOTE: scale factors are not yet permuted
+             * according to the pivot row permutation, so Rs [oldrow] is
+             * used below.  When the factorization is done, the scale
+             * factors are permuted, so that Rs [newrow] will be used in
+             * klu_solve, klu_tsolve, and klu_rgrowth */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] ;
+                if (newrow < k1)
+                {
+                    Offi [poff] = oldrow ;
+                    /* Offx [poff] = Ax [p] / Rs [oldrow] ; */
+                    SCALE_DIV_ASSIGN (Offx [poff], Ax [p], Rs [oldrow]) ;
+                    poff++ ;
+                }
+                else
+                {
+                    ASSERT (newrow == k1) ;
+                    PRINTF (("singleton block %d ", block)) ;
+                    PRINT_ENTRY (Ax[p]) ;
+                    SCALE_DIV_ASSIGN (s, Ax [p], Rs [oldrow]) ;
+                }
+            }
+        }
+
+        Udiag [k1] = s ;
+
+        if (IS_ZERO (s))
+        {
+            /* singular singleton */
+            Common->status = KLU_SINGULAR ;
+            if (Common->numerical_rank == EMPTY)
+            {
+                Common->numerical_rank = k1 ;
+                Common->singular_col = oldcol ;
+            }
+            if (Common->halt_if_singular)
+            {
+                return ;
+            }
+        }
+
+        Offp [k1+1] = poff ;
+        Pnum [k1] = P [k1] ;
+        (*lnz)++ ;
+        (*unz)++ ;
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* construct and factorize the kth block */
+        /* ------------------------------------------------------------------ */
+
+        if (Lnz [block] < 0)
+        {
+            /* COLAMD was used - no estimate of fill-in */
+            /* use 10 times the nnz in A, plus n */
+            lsize = -(Common->initmem) ;
+        }
+        else
+        {
+            lsize = Common->initmem_amd * Lnz [block] + nk ;
+        }
+
+        /* allocates 1 arrays: LUbx [block] */
+        if (Common->dense > 0 && nk >= KLU_DENSE_MIN && Lnz [block] >= 0 &&
+            2 * Lnz [block] - nk >= Common->dense * ((double) nk) * nk)
+        {
+            /* L and U are expected to be fairly dense */
+            Numeric->LUsize [block] = KLU_dense_factor (nk, Ap, Ai, Ax, Q,
+                lsize, &LUbx [block], Udiag + k1, Llen + k1, Ulen + k1,
+                Lip + k1, Uip + k1, Pblock, &lnz_block, &unz_block,
+                X, Iwork, k1, Pinv, Rs, Offp, Offi, Offx, Common) ;
+        }
+        else
+        {
+            Numeric->LUsize [block] = KLU_kernel_factor (nk, Ap, Ai, Ax, Q,
+                lsize, &LUbx [block], Udiag + k1, Llen + k1, Ulen + k1,
+                Lip + k1, Uip + k1, Pblock, &lnz_block, &unz_block,
+                X, Iwork, k1, Pinv, Rs, Offp, Offi, Offx, Common) ;
+        }
+
+        if (Common->status < KLU_OK ||
+           (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+        {
+            /* out of memory, invalid inputs, or singular */
+            return ;
+        }
+
+        PRINTF (("\n----------------------- L %d:\n", block)) ;
+        ASSERT (KLU_valid_LU (nk, TRUE, Lip+k1, Llen+k1, LUbx [block])) ;
+        PRINTF (("\n----------------------- U %d:\n", block)) ;
+        ASSERT (KLU_valid_LU (nk, FALSE, Uip+k1, Ulen+k1, LUbx [block])) ;
+
+        /* ------------------------------------------------------------------ */
+        /* get statistics */
+        /* ------------------------------------------------------------------ */
+
+        (*lnz) += lnz_block ;
+        (*unz) += unz_block ;
+        (*max_lnz_block) = MAX (*max_lnz_block, lnz_block) ;
+        (*max_unz_block) = MAX (*max_unz_block, unz_block) ;
+
+        if (Lnz [block] == EMPTY)
+        {
+            /* revise estimate for subsequent factorization */
+            Lnz [block] = MAX (lnz_block, unz_block) ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* combine the klu row ordering with the symbolic pre-ordering */
+        /* ------------------------------------------------------------------ */
+
+        PRINTF (("Pnum, 1-based:\n")) ;
+        for (k = 0 ; k < nk ; k++)
+        {
+            ASSERT (k + k1 < Symbolic->n) ;
+            ASSERT (Pblock [k] + k1 < Symbolic->n) ;
+            Pnum [k + k1] = P [Pblock [k] + k1] ;
+            PRINTF (("Pnum (%d + %d + 1 = %d) = %d + 1 = %d\n",
+                k, k1, k+k1+1, Pnum [k+k1], Pnum [k+k1]+1)) ;
+        }
+
+        /* the local pivot row permutation Pblock is no longer needed */
+    }
+}
+
+
+#ifdef _OPENMP
+/* ========================================================================== */
+/* === factor_parallel ====================================================== */
+/* ========================================================================== */
+
+/* Factorize the blocks in parallel, in the order given by KLU_schedule.  Each
+ * thread has its own copy of Common and its own workspace; thread 0 uses
+ * Numeric->Xwork and Numeric->Iwork.  The statistics in the copies of Common
+ * are combined when all blocks are done, so that the result is the same as
+ * the sequential factorization, regardless of the number of threads (except
+ * for nrealloc, noffdiag, and the memory usage if the factorization halts
+ * early on a singular matrix).
+ * Returns FALSE if the workspace cannot be allocated, in which case nothing
+ * has been done. */
+
+static Int factor_parallel
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    XEntry Ax [ ],
+    KLU_symbolic *Symbolic,
+    Int nthreads,       /* # of threads to use */
+    Int Order [ ],      /* size nblocks, the block schedule */
+
+    /* inputs, modified on output: */
+    KLU_numeric *Numeric,
+
+    /* statistics, updated on output */
+    Int *lnz,
+    Int *unz,
+    Int *max_lnz_block,
+    Int *max_unz_block,
+    KLU_common *Common
+)
+{
+    KLU_common *Tcommon, *T ;
+    XEntry *Twork ;
+    Entry *X ;
+    Int *Q, *R, *Offp, *Pinv, *Iwork ;
+    size_t wsize, memusage, mempeak ;
+    Int b, tid, nblocks, maxblock, halt, status, block, k1, k2, k, poff,
+        oldcol, pend, p, ok = TRUE ;
+    Int tlnz, tunz, tmax_lnz_block, tmax_unz_block, rank, col ;
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+    Offp = Numeric->Offp ;
+    Pinv = Numeric->Pinv ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the workspace for threads 1 to nthreads-1 */
+    /* ---------------------------------------------------------------------- */
+
+    /* each thread needs maxblock Entry's for X and 6*maxblock Int's for Iwork,
+     * rounded up to a whole number of XEntry's so that X and Iwork stay
+     * aligned, as they are in Numeric->Xwork */
+    wsize = maxblock + ((6 * ((size_t) maxblock) * sizeof (Int))
+        + sizeof (XEntry) - 1) / sizeof (XEntry) ;
+    wsize = KLU_mult_size_t (wsize, nthreads - 1, &ok) ;
+    status = Common->status ;
+    Tcommon = KLU_malloc (nthreads, sizeof (KLU_common), Common) ;
+    Twork = ok ? KLU_malloc (wsize, sizeof (XEntry), Common) : NULL ;
+    if (Tcommon == NULL || Twork == NULL)
+    {
+        KLU_free (Tcommon, nthreads, sizeof (KLU_common), Common) ;
+        KLU_free (Twork, wsize, sizeof (XEntry), Common) ;
+        Common->status = status ;
+        return (FALSE) ;
+    }
+    wsize /= (nthreads - 1) ;
+
+    for (tid = 0 ; tid < nthreads ; tid++)
+    {
+        T = &Tcommon [tid] ;
+        *T = *Common ;
+        T->status = KLU_OK ;
+        T->nrealloc = 0 ;
+        T->noffdiag = 0 ;
+        T->numerical_rank = EMPTY ;
+        T->singular_col = EMPTY ;
+        T->memusage = 0 ;
+        T->mempeak = 0 ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* find where each column of the off-diagonal part starts */
+    /* ---------------------------------------------------------------------- */
+
+    /* Offp [0] = 0 is already set */
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            poff = Offp [k] ;
+            oldcol = Q [k] ;
+            pend = Ap [oldcol+1] ;
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                if (Pinv [Ai [p]] < k1)
+                {
+                    poff++ ;
+                }
+            }
+            Offp [k+1] = poff ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the blocks */
+    /* ---------------------------------------------------------------------- */
+
+    tlnz = 0 ;
+    tunz = 0 ;
+    tmax_lnz_block = 1 ;
+    tmax_unz_block = 1 ;
+    halt = FALSE ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+        private(T, X, Iwork, tid, rank, col) \
+        reduction(+:tlnz,tunz) reduction(max:tmax_lnz_block,tmax_unz_block)
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        Int stop ;
+        #pragma omp atomic read
+        stop = halt ;
+        if (stop)
+        {
+            /* another thread has failed; do not start any more blocks */
+            continue ;
+        }
+
+        tid = omp_get_thread_num ( ) ;
+        T = &Tcommon [tid] ;
+        if (tid == 0)
+        {
+            X = (Entry *) Numeric->Xwork ;
+            Iwork = Numeric->Iwork ;
+        }
+        else
+        {
+            X = (Entry *) (Twork + (tid - 1) * wsize) ;
+            Iwork = (Int *) (Twork + (tid - 1) * wsize + maxblock) ;
+        }
+
+        /* blocks are not done in order, so keep the singular column of the
+         * leftmost singular block seen by this thread */
+        rank = T->numerical_rank ;
+        col = T->singular_col ;
+        T->numerical_rank = EMPTY ;
+        factor_block (Order [b], Ap, Ai, Ax, Symbolic, Numeric, X, Iwork,
+            &tlnz, &tunz, &tmax_lnz_block, &tmax_unz_block, T) ;
+        if (T->numerical_rank == EMPTY ||
+           (rank != EMPTY && rank < T->numerical_rank))
+        {
+            T->numerical_rank = rank ;
+            T->singular_col = col ;
+        }
+
+        if (T->status < KLU_OK ||
+           (T->status == KLU_SINGULAR && T->halt_if_singular))
+        {
+            #pragma omp atomic write
+            halt = TRUE ;
+        }
+    }
+
+    (*lnz) += tlnz ;
+    (*unz) += tunz ;
+    (*max_lnz_block) = MAX (*max_lnz_block, tmax_lnz_block) ;
+    (*max_unz_block) = MAX (*max_unz_block, tmax_unz_block) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* combine the statistics of each thread */
+    /* ---------------------------------------------------------------------- */
+
+    memusage = 0 ;
+    mempeak = 0 ;
+    for (tid = 0 ; tid < nthreads ; tid++)
+    {
+        T = &Tcommon [tid] ;
+        if (T->status < KLU_OK && Common->status >= KLU_OK)
+        {
+            /* out of memory or problem too large */
+            Common->status = T->status ;
+        }
+        else if (T->status == KLU_SINGULAR && Common->status == KLU_OK)
+        {
+            Common->status = KLU_SINGULAR ;
+        }
+        if (T->numerical_rank != EMPTY && (Common->numerical_rank == EMPTY
+            || T->numerical_rank < Common->numerical_rank))
+        {
+            Common->numerical_rank = T->numerical_rank ;
+            Common->singular_col = T->singular_col ;
+        }
+        Common->nrealloc += T->nrealloc ;
+        Common->noffdiag += T->noffdiag ;
+        memusage += T->memusage ;
+        mempeak += T->mempeak ;
+    }
+    Common->mempeak = MAX (Common->mempeak, Common->memusage + mempeak) ;
+    Common->memusage += memusage ;
+
+    KLU_free (Tcommon, nthreads, sizeof (KLU_common), Common) ;
+    KLU_free (Twork, wsize * (nthreads - 1), sizeof (XEntry), Common) ;
+    return (TRUE) ;
+}
+#endif
+
+
+/* ========================================================================== */
+/* === KLU_factor2 ========================================================== */
+/* ========================================================================== */
+
+static void factor2
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    XEntry Ax [ ],
+    KLU_symbolic *Symbolic,
+
+    /* inputs, modified on output: */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    double *Rs, *W ;
+    Int *P, *R, *Pnum, *Offp, *Offi, *Pinv, *Iwork, *Order ;
+    Entry *X ;
+    Int k, block, n, lnz, unz, p, nblocks, nzoff, scale, max_lnz_block,
+        max_unz_block, nthreads ;
+
+    /* ---------------------------------------------------------------------- */
+    /* initializations */
+    /* ---------------------------------------------------------------------- */
+
+    /* get the contents of the Symbolic object */
+    n = Symbolic->n ;
+    P = Symbolic->P ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    nzoff = Symbolic->nzoff ;
+
+    Pnum = Numeric->Pnum ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+
     Rs = Numeric->Rs ;
     Pinv = Numeric->Pinv ;
     X = (Entry *) Numeric->Xwork ;              /* X is of size n */
     Iwork = Numeric->Iwork ;                    /* 5*maxblock for KLU_factor */
                                                 /* 1*maxblock for Pblock */
-    Pblock = Iwork + 5*((size_t) Symbolic->maxblock) ;
     Common->nrealloc = 0 ;
     scale = Common->scale ;
     max_lnz_block = 1 ;
@@ -126,171 +573,42 @@ static void factor2
     /* factor each block using klu */
     /* ---------------------------------------------------------------------- */
 
-    for (block = 0 ; block < nblocks ; block++)
-    {
-
-        /* ------------------------------------------------------------------ */
-        /* the block is from rows/columns k1 to k2-1 */
-        /* ------------------------------------------------------------------ */
-
-        k1 = R [block] ;
-        k2 = R [block+1] ;
-        nk = k2 - k1 ;
-        PRINTF (("FACTOR BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1,k2-1,nk)) ;
+    nthreads = KLU_schedule (nblocks, R, Symbolic->maxblock, &Order, Common) ;
 
-        if (nk == 1)
+#ifdef _OPENMP
+    if (nthreads > 1)
+    {
+        if (!factor_parallel (Ap, Ai, Ax, Symbolic, nthreads, Order, Numeric,
+            &lnz, &unz, &max_lnz_block, &max_unz_block, Common))
         {
-
-            /* -------------------------------------------------------------- */
-            /* singleton case */
-            /* -------------------------------------------------------------- */
-
-            poff = Offp [k1] ;
-            oldcol = Q [k1] ;
-            pend = Ap [oldcol+1] ;
-            CLEAR (s) ;
-
-            if (scale <= 0)
-            {
-                /* no scaling */
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] ;
-                    if (newrow < k1)
-                    {
-                        Offi [poff] = oldrow ;
-                        Offx [poff] = Ax [p] ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        ASSERT (newrow == k1) ;
-                        PRINTF (("singleton block %d", block)) ;
-                        PRINT_ENTRY (Ax [p]) ;
-                        s = Ax [p] ;
-                    }
-                }
-            }
-            else
-            {
-                /* row scaling.  NOTE: scale factors are not yet permuted
-                 * according to the pivot row permutation, so Rs [oldrow] is
-                 * used below.  When the factorization is done, the scale
-                 * factors are permuted, so that Rs [newrow] will be used in
-                 * klu_solve, klu_tsolve, and klu_rgrowth */
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] ;
-                    if (newrow < k1)
-                    {
-                        Offi [poff] = oldrow ;
-                        /* Offx [poff] = Ax [p] / Rs [oldrow] ; */
-                        SCALE_DIV_ASSIGN (Offx [poff], Ax [p], Rs [oldrow]) ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        ASSERT (newrow == k1) ;
-                        PRINTF (("singleton block %d ", block)) ;
-                        PRINT_ENTRY (Ax[p]) ;
-                        SCALE_DIV_ASSIGN (s, Ax [p], Rs [oldrow]) ;
-                    }
-                }
-            }
-
-            Udiag [k1] = s ;
-
-            if (IS_ZERO (s))
-            {
-                /* singular singleton */
-                Common->status = KLU_SINGULAR ;
-                Common->numerical_rank = k1 ;
-                Common->singular_col = oldcol ;
-                if (Common->halt_if_singular)
-                {
-                    return ;
-                }
-            }
-
-            Offp [k1+1] = poff ;
-            Pnum [k1] = P [k1] ;
-            lnz++ ;
-            unz++ ;
-
+            /* out of memory; factorize the blocks one at a time instead */
+            nthreads = 1 ;
         }
-        else
-        {
-
-            /* -------------------------------------------------------------- */
-            /* construct and factorize the kth block */
-            /* -------------------------------------------------------------- */
-
-            if (Lnz [block] < 0)
-            {
-                /* COLAMD was used - no estimate of fill-in */
-                /* use 10 times the nnz in A, plus n */
-                lsize = -(Common->initmem) ;
-            }
-            else
-            {
-                lsize = Common->initmem_amd * Lnz [block] + nk ;
-            }
-
-            /* allocates 1 arrays: LUbx [block] */
-            Numeric->LUsize [block] = KLU_kernel_factor (nk, Ap, Ai, Ax, Q,
-                    lsize, &LUbx [block], Udiag + k1, Llen + k1, Ulen + k1,
-                    Lip + k1, Uip + k1, Pblock, &lnz_block, &unz_block,
-                    X, Iwork, k1, Pinv, Rs, Offp, Offi, Offx, Common) ;
-
-            if (Common->status < KLU_OK ||
-               (Common->status == KLU_SINGULAR && Common->halt_if_singular))
-            {
-                /* out of memory, invalid inputs, or singular */
-                return ;
-            }
-
-            PRINTF (("\n----------------------- L %d:\n", block)) ;
-            ASSERT (KLU_valid_LU (nk, TRUE, Lip+k1, Llen+k1, LUbx [block])) ;
-            PRINTF (("\n----------------------- U %d:\n", block)) ;
-            ASSERT (KLU_valid_LU (nk, FALSE, Uip+k1, Ulen+k1, LUbx [block])) ;
-
-            /* -------------------------------------------------------------- */
-            /* get statistics */
-            /* -------------------------------------------------------------- */
-
-            lnz += lnz_block ;
-            unz += unz_block ;
-            max_lnz_block = MAX (max_lnz_block, lnz_block) ;
-            max_unz_block = MAX (max_unz_block, unz_block) ;
-
-            if (Lnz [block] == EMPTY)
-            {
-                /* revise estimate for subsequent factorization */
-                Lnz [block] = MAX (lnz_block, unz_block) ;
-            }
-
-            /* -------------------------------------------------------------- */
-            /* combine the klu row ordering with the symbolic pre-ordering */
-            /* -------------------------------------------------------------- */
-
-            PRINTF (("Pnum, 1-based:\n")) ;
-            for (k = 0 ; k < nk ; k++)
-            {
-                ASSERT (k + k1 < n) ;
-                ASSERT (Pblock [k] + k1 < n) ;
-                Pnum [k + k1] = P [Pblock [k] + k1] ;
-                PRINTF (("Pnum (%d + %d + 1 = %d) = %d + 1 = %d\n",
-                    k, k1, k+k1+1, Pnum [k+k1], Pnum [k+k1]+1)) ;
-            }
+        KLU_free (Order, nblocks, sizeof (Int), Common) ;
+    }
+#endif
 
-            /* the local pivot row permutation Pblock is no longer needed */
+    for (block = 0 ; nthreads == 1 && block < nblocks ; block++)
+    {
+        factor_block (block, Ap, Ai, Ax, Symbolic, Numeric, X, Iwork,
+            &lnz, &unz, &max_lnz_block, &max_unz_block, Common) ;
+        if (Common->status < KLU_OK ||
+           (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+        {
+            break ;
         }
     }
+
+    if (Common->status < KLU_OK ||
+       (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+    {
+        /* out of memory, invalid inputs, or singular */
+        return ;
+    }
+
     ASSERT (nzoff == Offp [n]) ;
     PRINTF (("\n------------------- Off diagonal entries:\n")) ;
-    ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
+    ASSERT (KLU_valid (n, Offp, Offi, (Entry *) Numeric->Offx)) ;
 
     Numeric->lnz = lnz ;
     Numeric->unz = unz ;
@@ -316,18 +634,20 @@ static void factor2
     /* permute scale factors Rs according to pivotal row order */
     if (scale > 0)
     {
+        /* use Xwork as a double array, since X may be single precision */
+        W = (double *) Numeric->Xwork ;
         for (k = 0 ; k < n ; k++)
         {
-            REAL (X [k]) = Rs [Pnum [k]] ;
+            W [k] = Rs [Pnum [k]] ;
         }
         for (k = 0 ; k < n ; k++)
         {
-            Rs [k] = REAL (X [k]) ;
+            Rs [k] = W [k] ;
         }
     }
 
     PRINTF (("\n------------------- Off diagonal entries, old:\n")) ;
-    ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
+    ASSERT (KLU_valid (n, Offp, Offi, (Entry *) Numeric->Offx)) ;
 
     /* apply the pivot row permutations to the off-diagonal entries */
     for (p = 0 ; p < nzoff ; p++)
@@ -337,12 +657,13 @@ static void factor2
     }
 
     PRINTF (("\n------------------- Off diagonal entries, new:\n")) ;
-    ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
+    ASSERT (KLU_valid (n, Offp, Offi, (Entry *) Numeric->Offx)) ;
 
 #ifndef NDEBUG
     {
         PRINTF (("\n ############# KLU_BTF_FACTOR done, nblocks %d\n",nblocks));
         Entry ss, *Udiag = Numeric->Udiag ;
+        Int k1, k2, nk ;
         for (block = 0 ; block < nblocks && Common->status == KLU_OK ; block++)
         {
             k1 = R [block] ;
@@ -451,6 +772,12 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     Numeric->n = n ;
     Numeric->nblocks = nblocks ;
     Numeric->nzoff = nzoff ;
+    Numeric->Levels = NULL ;
+    Numeric->Spwork = NULL ;
+    Numeric->Mapping = NULL ;
+    Numeric->mapping_size = 0 ;
+    Numeric->mapped = FALSE ;
+    Numeric->generation = 0 ;
     Numeric->Pnum = KLU_malloc (n, sizeof (Int), Common) ;
     Numeric->Offp = KLU_malloc (n1, sizeof (Int), Common) ;
     Numeric->Offi = KLU_malloc (nzoff1, sizeof (Int), Common) ;
@@ -489,17 +816,19 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     /* allocate permanent workspace for factorization and solve.  Note that the
      * solver will use an Xwork of size 4n, whereas the factorization codes use
      * an Xwork of size n and integer space (Iwork) of size 6n. KLU_condest
-     * uses an Xwork of size 2n.  Total size is:
+     * uses an Xwork of size 2n.  The solvers work in XEntry's, which are
+     * larger than the Entry's of the factors in the single-precision
+     * versions.  Total size is:
      *
-     *    n*sizeof(Entry) + max (6*maxblock*sizeof(Int), 3*n*sizeof(Entry))
+     *    n*sizeof(XEntry) + max (6*maxblock*sizeof(Int), 3*n*sizeof(XEntry))
      */
-    s = KLU_mult_size_t (n, sizeof (Entry), &ok) ;
-    n3 = KLU_mult_size_t (n, 3 * sizeof (Entry), &ok) ;
+    s = KLU_mult_size_t (n, sizeof (XEntry), &ok) ;
+    n3 = KLU_mult_size_t (n, 3 * sizeof (XEntry), &ok) ;
     b6 = KLU_mult_size_t (maxblock, 6 * sizeof (Int), &ok) ;
     Numeric->worksize = KLU_add_size_t (s, MAX (n3, b6), &ok) ;
     Numeric->Work = KLU_malloc (Numeric->worksize, 1, Common) ;
     Numeric->Xwork = Numeric->Work ;
-    Numeric->Iwork = (Int *) ((Entry *) Numeric->Xwork + n) ;
+    Numeric->Iwork = (Int *) ((XEntry *) Numeric->Xwork + n) ;
     if (!ok || Common->status < KLU_OK)
     {
         /* out of memory or problem too large */
@@ -512,7 +841,7 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     /* factorize the blocks */
     /* ---------------------------------------------------------------------- */
 
-    factor2 (Ap, Ai, (Entry *) Ax, Symbolic, Numeric, Common) ;
+    factor2 (Ap, Ai, (XEntry *) Ax, Symbolic, Numeric, Common) ;
 
     /* ---------------------------------------------------------------------- */
     /* return or free the Numeric object */
@@ -539,5 +868,12 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
         Common->numerical_rank = n ;
         Common->singular_col = n ;
     }
+
+    if (Numeric != NULL)
+    {
+        /* level sets for a multithreaded solve, if requested (this does not
+         * fail; the solve is done with a single thread if out of memory) */
+        (void) KLU_levels (Symbolic, Numeric, Common) ;
+    }
     return (Numeric) ;
 }
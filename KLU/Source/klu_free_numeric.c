@@ -2,9 +2,13 @@
 /* === KLU_free_numeric ===================================================== */
 /* ========================================================================== */
 
-/* Free the KLU Numeric object. */
+/* Free the KLU Numeric object.  If it was loaded by KLU_load_numeric, most of
+ * its arrays are part of a single mapping (or malloc'd copy) of the file. */
 
 #include "klu_internal.h"
+#ifndef NPOSIX
+#include <sys/mman.h>
+#endif
 
 Int KLU_free_numeric
 (
@@ -33,6 +37,32 @@ Int KLU_free_numeric
     nblocks = Numeric->nblocks ;
     LUsize = Numeric->LUsize ;
 
+    KLU_free_levels (Numeric, Common) ;
+    KLU_free (Numeric->Spwork, 3 * ((size_t) n) + 2 * ((size_t) nblocks),
+        sizeof (Int), Common) ;
+
+    if (Numeric->Mapping != NULL)
+    {
+        /* loaded by KLU_load_numeric: only LUbx itself, Rs, and Work are
+         * separate from the mapping */
+#ifndef NPOSIX
+        if (Numeric->mapped)
+        {
+            (void) munmap (Numeric->Mapping, Numeric->mapping_size) ;
+        }
+        else
+#endif
+        {
+            KLU_free (Numeric->Mapping, Numeric->mapping_size, 1, Common) ;
+        }
+        KLU_free (Numeric->LUbx, nblocks, sizeof (Unit *), Common) ;
+        KLU_free (Numeric->Rs, n, sizeof (double), Common) ;
+        KLU_free (Numeric->Work, Numeric->worksize, 1, Common) ;
+        KLU_free (Numeric, 1, sizeof (KLU_numeric), Common) ;
+        *NumericHandle = NULL ;
+        return (TRUE) ;
+    }
+
     LUbx = (Unit **) Numeric->LUbx ;
     if (LUbx != NULL)
     {
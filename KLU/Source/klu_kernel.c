@@ -211,7 +211,7 @@ static void construct_column
     Int k,          /* the column of A (or the column of the block) to get */
     Int Ap [ ],
     Int Ai [ ],
-    Entry Ax [ ],
+    XEntry Ax [ ],
     Int Q [ ],      /* column pre-ordering */
 
     /* zero on input, modified on output */
@@ -231,7 +231,7 @@ static void construct_column
     Entry Offx [ ]
 )
 {
-    Entry aik ;
+    XEntry aik ;
     Int i, p, pend, oldcol, kglobal, poff, oldrow ;
 
     /* ---------------------------------------------------------------------- */
@@ -255,13 +255,13 @@ static void construct_column
             {
                 /* this is an entry in the off-diagonal part */
                 Offi [poff] = oldrow ;
-                Offx [poff] = aik ;
+                CONVERT (Offx [poff], aik) ;
                 poff++ ;
             }
             else
             {
                 /* (i,k) is an entry in the block.  scatter into X */
-                X [i] = aik ;
+                CONVERT (X [i], aik) ;
             }
         }
     }
@@ -278,13 +278,13 @@ static void construct_column
             {
                 /* this is an entry in the off-diagonal part */
                 Offi [poff] = oldrow ;
-                Offx [poff] = aik ;
+                CONVERT (Offx [poff], aik) ;
                 poff++ ;
             }
             else
             {
                 /* (i,k) is an entry in the block.  scatter into X */
-                X [i] = aik ;
+                CONVERT (X [i], aik) ;
             }
         }
     }
@@ -630,7 +630,7 @@ size_t KLU_kernel   /* final size of LU on output */
     Int n,          /* A is n-by-n */
     Int Ap [ ],     /* size n+1, column pointers for A */
     Int Ai [ ],     /* size nz = Ap [n], row indices for A */
-    Entry Ax [ ],   /* size nz, values of A */
+    XEntry Ax [ ],  /* size nz, values of A */
     Int Q [ ],      /* size n, optional input permutation */
     size_t lusize,  /* initial size of LU on input */
 
@@ -724,8 +724,8 @@ size_t KLU_kernel   /* final size of LU on output */
         P [k] = k ;
         Pinv [k] = FLIP (k) ;   /* mark all rows as non-pivotal */
     }
-    /* initialize the construction of the off-diagonal matrix */
-    Offp [0] = 0 ;
+    /* the construction of the off-diagonal matrix is initialized by
+     * KLU_factor (Offp [0] = 0), so that blocks can be done in any order */
 
     /* P [k] = row means that UNFLIP (Pinv [row]) = k, and visa versa.
      * If row is pivotal, then Pinv [row] >= 0.  A row is initially "flipped"
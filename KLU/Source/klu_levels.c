@@ -0,0 +1,884 @@
+/* ========================================================================== */
+/* === KLU_levels =========================================================== */
+/* ========================================================================== */
+
+/* Level sets for a multithreaded KLU_solve and KLU_tsolve.  Not user-callable.
+ *
+ * KLU_solve walks the blocks of the BTF form from last to first.  For each
+ * block it subtracts the off-diagonal entries of the blocks already solved,
+ * and then solves with L and U, one column at a time.  KLU_tsolve does the
+ * same with the transposes, from the first block to the last.  Each row i of
+ * the solution is thus finalized in two steps.  For KLU_solve, the L step
+ * subtracts the off-diagonal entries and the entries of L in row i, and the U
+ * step subtracts the entries of U in row i and divides by U(i,i).  For
+ * KLU_tsolve, the U' step subtracts the off-diagonal entries and the entries
+ * of U in column i and divides by U(i,i), and the L' step subtracts the
+ * entries of L in column i.
+ *
+ * KLU_levels computes the level of each step in the dependency graph, once
+ * for each factorization.  The steps in a level are independent of each
+ * other, and can be done in parallel with a barrier between each level.  The
+ * U (or L') steps of a block are placed after all L (or U') steps of the same
+ * block, since they overwrite values that the L (or U') steps read.  Levels
+ * with fewer than KLU_LEVEL_MIN steps are merged into segments that are done
+ * by a single thread, to save the barriers.
+ *
+ * Each step reads the rows it depends on and writes only its own row.  For
+ * KLU_solve this needs the off-diagonal part and the L and U factors in row
+ * form.  KLU_levels keeps the positions of their entries in Numeric->Offx and
+ * Numeric->LUbx, not copies of the values, so the level sets remain valid
+ * after KLU_refactor.  The entries of each row are subtracted in the same
+ * order as in KLU_solve and KLU_tsolve, so the solution does not depend on
+ * the number of threads.  KLU_sort reorders L and U, and so it recomputes the
+ * level sets.
+ *
+ * KLU_factor calls KLU_levels only if KLU is compiled with OpenMP and
+ * Common->nthreads is not 1.  If KLU_levels runs out of memory,
+ * Numeric->Levels is left NULL, Common->status is left unchanged, and the
+ * solves are done in the usual way with a single thread.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === schedule ============================================================= */
+/* ========================================================================== */
+
+/* Sort the steps by level and split them into segments.  T [i] is the level
+ * of step i, and T [n+i] the level of step FLIP (i), or EMPTY if the step
+ * does not exist.  Returns FALSE if out of memory. */
+
+static Int schedule
+(
+    Int n,
+    Int nlevels,            /* levels are 0 to nlevels-1 */
+    Int T [ ],              /* size 2*n */
+    Int which,              /* 0: KLU_solve, 1: KLU_tsolve */
+    KLU_level_sets *Levels,
+    KLU_common *Common
+)
+{
+    Int *Levp, *Step, *Segp, *Segpar ;
+    Int i, t, nsteps, nseg, serial, pass ;
+
+    Levp = KLU_malloc (nlevels+1, sizeof (Int), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        return (FALSE) ;
+    }
+
+    /* count the steps in each level */
+    for (t = 0 ; t <= nlevels ; t++)
+    {
+        Levp [t] = 0 ;
+    }
+    for (i = 0 ; i < 2*n ; i++)
+    {
+        if (T [i] != EMPTY)
+        {
+            Levp [T [i] + 1]++ ;
+        }
+    }
+    for (t = 1 ; t <= nlevels ; t++)
+    {
+        Levp [t] += Levp [t-1] ;
+    }
+    nsteps = Levp [nlevels] ;
+
+    /* place the steps in level order */
+    Step = KLU_malloc (nsteps, sizeof (Int), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Levp, nlevels+1, sizeof (Int), Common) ;
+        return (FALSE) ;
+    }
+    for (i = 0 ; i < n ; i++)
+    {
+        if (T [i] != EMPTY)
+        {
+            Step [Levp [T [i]]++] = i ;
+        }
+    }
+    for (i = 0 ; i < n ; i++)
+    {
+        if (T [n+i] != EMPTY)
+        {
+            Step [Levp [T [n+i]]++] = FLIP (i) ;
+        }
+    }
+
+    /* Levp [t] is now the end of level t; shift it back to the start */
+    for (t = nlevels ; t > 0 ; t--)
+    {
+        Levp [t] = Levp [t-1] ;
+    }
+    Levp [0] = 0 ;
+
+    /* count the segments (pass 0), and then construct them (pass 1) */
+    Segp = NULL ;
+    Segpar = NULL ;
+    nseg = 0 ;
+    for (pass = 0 ; pass < 2 ; pass++)
+    {
+        nseg = 0 ;
+        serial = FALSE ;
+        for (t = 0 ; t < nlevels ; t++)
+        {
+            if (Levp [t+1] - Levp [t] >= KLU_LEVEL_MIN)
+            {
+                /* a large level, done in parallel */
+                if (pass == 1)
+                {
+                    Segp [nseg] = Levp [t] ;
+                    Segpar [nseg] = TRUE ;
+                }
+                nseg++ ;
+                serial = FALSE ;
+            }
+            else if (!serial)
+            {
+                /* start a new serial segment */
+                if (pass == 1)
+                {
+                    Segp [nseg] = Levp [t] ;
+                    Segpar [nseg] = FALSE ;
+                }
+                nseg++ ;
+                serial = TRUE ;
+            }
+        }
+        if (pass == 0)
+        {
+            Segp = KLU_malloc (nseg+1, sizeof (Int), Common) ;
+            Segpar = KLU_malloc (nseg, sizeof (Int), Common) ;
+            if (Common->status < KLU_OK)
+            {
+                KLU_free (Segp, nseg+1, sizeof (Int), Common) ;
+                KLU_free (Segpar, nseg, sizeof (Int), Common) ;
+                KLU_free (Step, nsteps, sizeof (Int), Common) ;
+                KLU_free (Levp, nlevels+1, sizeof (Int), Common) ;
+                return (FALSE) ;
+            }
+        }
+    }
+    Segp [nseg] = nsteps ;
+
+    KLU_free (Levp, nlevels+1, sizeof (Int), Common) ;
+    Levels->nsteps [which] = nsteps ;
+    Levels->nseg [which] = nseg ;
+    Levels->Step [which] = Step ;
+    Levels->Segp [which] = Segp ;
+    Levels->Segpar [which] = Segpar ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_levels =========================================================== */
+/* ========================================================================== */
+
+Int KLU_levels          /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    /* input, Numeric->Levels modified on output */
+    KLU_numeric *Numeric,
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    KLU_level_sets *Levels ;
+    Entry *Lx, *Ux ;
+    Int *R, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen, *Li, *Ui, *W, *T, *Block,
+        *Orp, *Orj, *Orx, *Lrp, *Lrj, *Lrx, *Urp, *Urj, *Urx ;
+    Unit **LUbx ;
+    Int n, nblocks, nzoff, nl, nu, block, k1, k2, nk, k, i, p, q, len, t,
+        tmax, nlevels, status, which, ok ;
+
+    KLU_free_levels (Numeric, Common) ;
+    if (KLU_threads (Common) <= 1)
+    {
+        /* KLU is not compiled with OpenMP, or threads not requested */
+        return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get the contents of the Symbolic and Numeric objects */
+    /* ---------------------------------------------------------------------- */
+
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    R = Symbolic->R ;
+    nzoff = Numeric->nzoff ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    LUbx = (Unit **) Numeric->LUbx ;
+
+    /* # of entries in L and U, excluding singletons and the diagonal */
+    nl = 0 ;
+    nu = 0 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        if (k2 - k1 > 1)
+        {
+            for (k = k1 ; k < k2 ; k++)
+            {
+                nl += Llen [k] ;
+                nu += Ulen [k] ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the level sets */
+    /* ---------------------------------------------------------------------- */
+
+    status = Common->status ;
+    Levels = KLU_malloc (1, sizeof (KLU_level_sets), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        Common->status = status ;
+        return (FALSE) ;
+    }
+    Levels->n = n ;
+    Levels->nzoff = nzoff ;
+    Levels->nl = nl ;
+    Levels->nu = nu ;
+    for (which = 0 ; which < 2 ; which++)
+    {
+        Levels->nsteps [which] = 0 ;
+        Levels->nseg [which] = 0 ;
+        Levels->Step [which] = NULL ;
+        Levels->Segp [which] = NULL ;
+        Levels->Segpar [which] = NULL ;
+    }
+    Numeric->Levels = Levels ;
+
+    Levels->Orp = KLU_malloc (n+1, sizeof (Int), Common) ;
+    Levels->Orj = KLU_malloc (nzoff, sizeof (Int), Common) ;
+    Levels->Orx = KLU_malloc (nzoff, sizeof (Int), Common) ;
+    Levels->Lrp = KLU_malloc (n+1, sizeof (Int), Common) ;
+    Levels->Lrj = KLU_malloc (nl, sizeof (Int), Common) ;
+    Levels->Lrx = KLU_malloc (nl, sizeof (Int), Common) ;
+    Levels->Urp = KLU_malloc (n+1, sizeof (Int), Common) ;
+    Levels->Urj = KLU_malloc (nu, sizeof (Int), Common) ;
+    Levels->Urx = KLU_malloc (nu, sizeof (Int), Common) ;
+    Levels->Block = KLU_malloc (n, sizeof (Int), Common) ;
+    ok = TRUE ;
+    Levels->X = KLU_malloc (KLU_mult_size_t (n, KLU_LEVEL_NRHS, &ok),
+        sizeof (XEntry), Common) ;
+    W = KLU_malloc (n, sizeof (Int), Common) ;
+    T = KLU_malloc (2*n, sizeof (Int), Common) ;
+
+    if (!ok || Common->status < KLU_OK)
+    {
+        KLU_free (W, n, sizeof (Int), Common) ;
+        KLU_free (T, 2*n, sizeof (Int), Common) ;
+        KLU_free_levels (Numeric, Common) ;
+        Common->status = status ;
+        return (FALSE) ;
+    }
+
+    Orp = Levels->Orp ; Orj = Levels->Orj ; Orx = Levels->Orx ;
+    Lrp = Levels->Lrp ; Lrj = Levels->Lrj ; Lrx = Levels->Lrx ;
+    Urp = Levels->Urp ; Urj = Levels->Urj ; Urx = Levels->Urx ;
+    Block = Levels->Block ;
+
+    /* ---------------------------------------------------------------------- */
+    /* count the entries in each row */
+    /* ---------------------------------------------------------------------- */
+
+    for (i = 0 ; i <= n ; i++)
+    {
+        Orp [i] = 0 ;
+        Lrp [i] = 0 ;
+        Urp [i] = 0 ;
+    }
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            Block [k] = block ;
+            for (p = Offp [k] ; p < Offp [k+1] ; p++)
+            {
+                Orp [Offi [p] + 1]++ ;
+            }
+            if (nk > 1)
+            {
+                GET_POINTER (LUbx [block], Lip, Llen, Li, Lx, k, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Lrp [Li [p] + k1 + 1]++ ;
+                }
+                GET_POINTER (LUbx [block], Uip, Ulen, Ui, Ux, k, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Urp [Ui [p] + k1 + 1]++ ;
+                }
+            }
+        }
+    }
+    for (i = 1 ; i <= n ; i++)
+    {
+        Orp [i] += Orp [i-1] ;
+        Lrp [i] += Lrp [i-1] ;
+        Urp [i] += Urp [i-1] ;
+    }
+    ASSERT (Orp [n] == nzoff && Lrp [n] == nl && Urp [n] == nu) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the row form of the off-diagonal part */
+    /* ---------------------------------------------------------------------- */
+
+    /* in the order used by KLU_solve: blocks from last to first, and columns
+     * in increasing order within each block */
+    for (i = 0 ; i < n ; i++)
+    {
+        W [i] = Orp [i] ;
+    }
+    for (block = nblocks-1 ; block >= 0 ; block--)
+    {
+        for (k = R [block] ; k < R [block+1] ; k++)
+        {
+            for (p = Offp [k] ; p < Offp [k+1] ; p++)
+            {
+                q = W [Offi [p]]++ ;
+                Orj [q] = k ;
+                Orx [q] = p ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the row form of L and U */
+    /* ---------------------------------------------------------------------- */
+
+    /* L in increasing column order, as used by KLU_lsolve */
+    for (i = 0 ; i < n ; i++)
+    {
+        W [i] = Lrp [i] ;
+    }
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        for (k = k1 ; k2 - k1 > 1 && k < k2 ; k++)
+        {
+            GET_POINTER (LUbx [block], Lip, Llen, Li, Lx, k, len) ;
+            for (p = 0 ; p < len ; p++)
+            {
+                q = W [Li [p] + k1]++ ;
+                Lrj [q] = k ;
+                Lrx [q] = (Int) (Lx - (Entry *) LUbx [block]) + p ;
+            }
+        }
+    }
+
+    /* U in decreasing column order, as used by KLU_usolve */
+    for (i = 0 ; i < n ; i++)
+    {
+        W [i] = Urp [i] ;
+    }
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        for (k = k2-1 ; k2 - k1 > 1 && k >= k1 ; k--)
+        {
+            GET_POINTER (LUbx [block], Uip, Ulen, Ui, Ux, k, len) ;
+            for (p = 0 ; p < len ; p++)
+            {
+                q = W [Ui [p] + k1]++ ;
+                Urj [q] = k ;
+                Urx [q] = (Int) (Ux - (Entry *) LUbx [block]) + p ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* levels for KLU_solve */
+    /* ---------------------------------------------------------------------- */
+
+    /* T [i] is the level of the L step of row i (EMPTY if row i of L and of
+     * the off-diagonal part are empty), and T [n+i] the level of its U step */
+    nlevels = 0 ;
+    for (block = nblocks-1 ; block >= 0 ; block--)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        tmax = EMPTY ;
+        for (i = k1 ; i < k2 ; i++)
+        {
+            t = EMPTY ;
+            for (p = Orp [i] ; p < Orp [i+1] ; p++)
+            {
+                t = MAX (t, T [n + Orj [p]]) ;
+            }
+            for (p = Lrp [i] ; p < Lrp [i+1] ; p++)
+            {
+                t = MAX (t, T [Lrj [p]]) ;
+            }
+            T [i] = (Orp [i+1] > Orp [i] || Lrp [i+1] > Lrp [i]) ? t+1 : EMPTY ;
+            tmax = MAX (tmax, T [i]) ;
+        }
+        for (i = k2-1 ; i >= k1 ; i--)
+        {
+            t = tmax ;
+            for (p = Urp [i] ; p < Urp [i+1] ; p++)
+            {
+                t = MAX (t, T [n + Urj [p]]) ;
+            }
+            T [n+i] = t+1 ;
+            nlevels = MAX (nlevels, t+2) ;
+        }
+    }
+    ok = schedule (n, nlevels, T, 0, Levels, Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* levels for KLU_tsolve */
+    /* ---------------------------------------------------------------------- */
+
+    /* T [k] is the level of the U' step of row k, and T [n+k] the level of
+     * its L' step (EMPTY if column k of L is empty).  W [k] is the level at
+     * which row k is final. */
+    nlevels = 0 ;
+    for (block = 0 ; ok && block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        tmax = EMPTY ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            t = EMPTY ;
+            for (p = Offp [k] ; p < Offp [k+1] ; p++)
+            {
+                t = MAX (t, W [Offi [p]]) ;
+            }
+            if (nk > 1)
+            {
+                GET_POINTER (LUbx [block], Uip, Ulen, Ui, Ux, k, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    t = MAX (t, T [Ui [p] + k1]) ;
+                }
+            }
+            T [k] = t+1 ;
+            tmax = MAX (tmax, T [k]) ;
+        }
+        for (k = k2-1 ; k >= k1 ; k--)
+        {
+            T [n+k] = EMPTY ;
+            W [k] = T [k] ;
+            if (nk > 1 && Llen [k] > 0)
+            {
+                t = tmax ;
+                GET_POINTER (LUbx [block], Lip, Llen, Li, Lx, k, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    t = MAX (t, W [Li [p] + k1]) ;
+                }
+                T [n+k] = t+1 ;
+                W [k] = t+1 ;
+            }
+            nlevels = MAX (nlevels, W [k] + 1) ;
+        }
+    }
+    ok = ok && schedule (n, nlevels, T, 1, Levels, Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* free workspace and return result */
+    /* ---------------------------------------------------------------------- */
+
+    KLU_free (W, n, sizeof (Int), Common) ;
+    KLU_free (T, 2*n, sizeof (Int), Common) ;
+    if (!ok)
+    {
+        KLU_free_levels (Numeric, Common) ;
+        Common->status = status ;
+    }
+    return (ok) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_free_levels ====================================================== */
+/* ========================================================================== */
+
+/* Free Numeric->Levels, if present, and set it to NULL */
+
+void KLU_free_levels
+(
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    KLU_level_sets *Levels ;
+    Int n, which ;
+
+    Levels = (KLU_level_sets *) Numeric->Levels ;
+    if (Levels == NULL)
+    {
+        return ;
+    }
+    n = Levels->n ;
+    KLU_free (Levels->Orp, n+1, sizeof (Int), Common) ;
+    KLU_free (Levels->Orj, Levels->nzoff, sizeof (Int), Common) ;
+    KLU_free (Levels->Orx, Levels->nzoff, sizeof (Int), Common) ;
+    KLU_free (Levels->Lrp, n+1, sizeof (Int), Common) ;
+    KLU_free (Levels->Lrj, Levels->nl, sizeof (Int), Common) ;
+    KLU_free (Levels->Lrx, Levels->nl, sizeof (Int), Common) ;
+    KLU_free (Levels->Urp, n+1, sizeof (Int), Common) ;
+    KLU_free (Levels->Urj, Levels->nu, sizeof (Int), Common) ;
+    KLU_free (Levels->Urx, Levels->nu, sizeof (Int), Common) ;
+    KLU_free (Levels->Block, n, sizeof (Int), Common) ;
+    KLU_free (Levels->X, n * KLU_LEVEL_NRHS, sizeof (XEntry), Common) ;
+    for (which = 0 ; which < 2 ; which++)
+    {
+        KLU_free (Levels->Step [which], Levels->nsteps [which], sizeof (Int),
+            Common) ;
+        KLU_free (Levels->Segp [which], Levels->nseg [which] + 1, sizeof (Int),
+            Common) ;
+        KLU_free (Levels->Segpar [which], Levels->nseg [which], sizeof (Int),
+            Common) ;
+    }
+    KLU_free (Levels, 1, sizeof (KLU_level_sets), Common) ;
+    Numeric->Levels = NULL ;
+}
+
+
+#ifdef _OPENMP
+
+/* ========================================================================== */
+/* === solve_step =========================================================== */
+/* ========================================================================== */
+
+/* Do one step of the solve with the level sets, for nr right-hand-sides held
+ * in X in row form (X [nr*i ... nr*i+nr-1] is row i) */
+
+static void solve_step
+(
+    Int step,
+    Int nr,
+    Int transpose,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    KLU_level_sets *Levels,
+    XEntry X [ ]
+)
+{
+    XEntry *x, *xj ;
+    Entry a, *LU, *Offx, *Lx, *Ux ;
+    Int *Li, *Ui ;
+    Int i, k, p, k1, len, block ;
+
+    Offx = (Entry *) Numeric->Offx ;
+    i = UNFLIP (step) ;
+    x = X + nr*i ;
+    block = Levels->Block [i] ;
+    LU = (Entry *) ((Unit **) Numeric->LUbx) [block] ;
+
+    if (!transpose && step >= 0)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* L step: subtract row i of the off-diagonal part and of L */
+        /* ------------------------------------------------------------------ */
+
+        for (p = Levels->Orp [i] ; p < Levels->Orp [i+1] ; p++)
+        {
+            a = Offx [Levels->Orx [p]] ;
+            xj = X + nr * Levels->Orj [p] ;
+            for (k = 0 ; k < nr ; k++)
+            {
+                MULT_SUB (x [k], a, xj [k]) ;
+            }
+        }
+        for (p = Levels->Lrp [i] ; p < Levels->Lrp [i+1] ; p++)
+        {
+            a = LU [Levels->Lrx [p]] ;
+            xj = X + nr * Levels->Lrj [p] ;
+            for (k = 0 ; k < nr ; k++)
+            {
+                MULT_SUB (x [k], a, xj [k]) ;
+            }
+        }
+
+    }
+    else if (!transpose)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* U step: subtract row i of U and divide by U(i,i) */
+        /* ------------------------------------------------------------------ */
+
+        for (p = Levels->Urp [i] ; p < Levels->Urp [i+1] ; p++)
+        {
+            a = LU [Levels->Urx [p]] ;
+            xj = X + nr * Levels->Urj [p] ;
+            for (k = 0 ; k < nr ; k++)
+            {
+                MULT_SUB (x [k], a, xj [k]) ;
+            }
+        }
+        a = ((Entry *) Numeric->Udiag) [i] ;
+        for (k = 0 ; k < nr ; k++)
+        {
+            DIV (x [k], x [k], a) ;
+        }
+
+    }
+    else if (step >= 0)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* U' step: subtract column i of the off-diagonal part and of U */
+        /* ------------------------------------------------------------------ */
+
+        for (p = Numeric->Offp [i] ; p < Numeric->Offp [i+1] ; p++)
+        {
+#ifdef COMPLEX
+            if (conj_solve)
+            {
+                CONJ (a, Offx [p]) ;
+            }
+            else
+#endif
+            {
+                a = Offx [p] ;
+            }
+            xj = X + nr * Numeric->Offi [p] ;
+            for (k = 0 ; k < nr ; k++)
+            {
+                MULT_SUB (x [k], a, xj [k]) ;
+            }
+        }
+        k1 = Symbolic->R [block] ;
+        if (Symbolic->R [block+1] - k1 > 1)
+        {
+            GET_POINTER (((Unit *) LU), Numeric->Uip, Numeric->Ulen, Ui, Ux, i,
+                len) ;
+            for (p = 0 ; p < len ; p++)
+            {
+#ifdef COMPLEX
+                if (conj_solve)
+                {
+                    CONJ (a, Ux [p]) ;
+                }
+                else
+#endif
+                {
+                    a = Ux [p] ;
+                }
+                xj = X + nr * (Ui [p] + k1) ;
+                for (k = 0 ; k < nr ; k++)
+                {
+                    MULT_SUB (x [k], a, xj [k]) ;
+                }
+            }
+        }
+#ifdef COMPLEX
+        if (conj_solve)
+        {
+            CONJ (a, ((Entry *) Numeric->Udiag) [i]) ;
+        }
+        else
+#endif
+        {
+            a = ((Entry *) Numeric->Udiag) [i] ;
+        }
+        for (k = 0 ; k < nr ; k++)
+        {
+            DIV (x [k], x [k], a) ;
+        }
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* L' step: subtract column i of L */
+        /* ------------------------------------------------------------------ */
+
+        k1 = Symbolic->R [block] ;
+        GET_POINTER (((Unit *) LU), Numeric->Lip, Numeric->Llen, Li, Lx, i,
+            len) ;
+        for (p = 0 ; p < len ; p++)
+        {
+#ifdef COMPLEX
+            if (conj_solve)
+            {
+                CONJ (a, Lx [p]) ;
+            }
+            else
+#endif
+            {
+                a = Lx [p] ;
+            }
+            xj = X + nr * (Li [p] + k1) ;
+            for (k = 0 ; k < nr ; k++)
+            {
+                MULT_SUB (x [k], a, xj [k]) ;
+            }
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === KLU_level_solve ====================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b (transpose FALSE) or A'x=b (transpose TRUE) with the level sets
+ * in Numeric->Levels, using nthreads threads.  The inputs have already been
+ * checked by KLU_solve or KLU_tsolve.  Uses Levels->X as workspace, and
+ * solves KLU_LEVEL_NRHS right-hand-sides at a time. */
+
+void KLU_level_solve
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,                  /* leading dimension of B */
+    Int nrhs,               /* number of right-hand-sides */
+    /* right-hand-side on input, overwritten with solution on output */
+    double B [ ],           /* size n*nrhs, in column-oriented form, with
+                             * leading dimension d. */
+    Int transpose,          /* TRUE: solve A'x=b, FALSE: solve Ax=b */
+#ifdef COMPLEX
+    Int conj_solve,         /* TRUE: solve A^Hx=b (if transpose is TRUE) */
+#endif
+    Int nthreads
+)
+{
+    KLU_level_sets *Levels ;
+    XEntry *X, *Bz ;
+    double *Rs ;
+    Int *Pnum, *Q, *Pin, *Pout, *Step, *Segp, *Segpar ;
+    Int n, chunk, nr, nseg, which ;
+#ifdef COMPLEX
+    Int cj ;
+#endif
+
+    Levels = (KLU_level_sets *) Numeric->Levels ;
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    Pnum = Numeric->Pnum ;
+    Rs = Numeric->Rs ;
+    X = Levels->X ;
+    which = transpose ? 1 : 0 ;
+    Step = Levels->Step [which] ;
+    Segp = Levels->Segp [which] ;
+    Segpar = Levels->Segpar [which] ;
+    nseg = Levels->nseg [which] ;
+#ifdef COMPLEX
+    cj = transpose && conj_solve ;
+#endif
+
+    /* Ax=b:  X = P*(R\B), and B = Q*X on output.
+     * A'x=b: X = Q'*B, and B = P'*(R\X) on output. */
+    Pin  = transpose ? Q : Pnum ;
+    Pout = transpose ? Pnum : Q ;
+
+    /* nthreads is only used in the pragma below, which the Tcov build strips
+     * from the preprocessed source */
+    (void) nthreads ;
+
+    for (chunk = 0 ; chunk < nrhs ; chunk += KLU_LEVEL_NRHS)
+    {
+        nr = MIN (nrhs - chunk, KLU_LEVEL_NRHS) ;
+        Bz = ((XEntry *) B) + d*chunk ;
+
+        #pragma omp parallel num_threads(nthreads)
+        {
+            Int k, i, j, s, q ;
+
+            /* -------------------------------------------------------------- */
+            /* permute (and scale) the right-hand-side into X */
+            /* -------------------------------------------------------------- */
+
+            #pragma omp for schedule(static)
+            for (k = 0 ; k < n ; k++)
+            {
+                i = Pin [k] ;
+                for (j = 0 ; j < nr ; j++)
+                {
+                    if (Rs != NULL && !transpose)
+                    {
+                        SCALE_DIV_ASSIGN (X [nr*k + j], Bz [i + d*j], Rs [k]) ;
+                    }
+                    else
+                    {
+                        X [nr*k + j] = Bz [i + d*j] ;
+                    }
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* solve, one segment at a time */
+            /* -------------------------------------------------------------- */
+
+            for (s = 0 ; s < nseg ; s++)
+            {
+                if (Segpar [s])
+                {
+                    #pragma omp for schedule(guided)
+                    for (q = Segp [s] ; q < Segp [s+1] ; q++)
+                    {
+                        solve_step (Step [q], nr, transpose,
+#ifdef COMPLEX
+                            cj,
+#endif
+                            Symbolic, Numeric, Levels, X) ;
+                    }
+                }
+                else
+                {
+                    #pragma omp single
+                    for (q = Segp [s] ; q < Segp [s+1] ; q++)
+                    {
+                        solve_step (Step [q], nr, transpose,
+#ifdef COMPLEX
+                            cj,
+#endif
+                            Symbolic, Numeric, Levels, X) ;
+                    }
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* permute (and scale) the result back into B */
+            /* -------------------------------------------------------------- */
+
+            #pragma omp for schedule(static)
+            for (k = 0 ; k < n ; k++)
+            {
+                i = Pout [k] ;
+                for (j = 0 ; j < nr ; j++)
+                {
+                    if (Rs != NULL && transpose)
+                    {
+                        SCALE_DIV_ASSIGN (Bz [i + d*j], X [nr*k + j], Rs [k]) ;
+                    }
+                    else
+                    {
+                        Bz [i + d*j] = X [nr*k + j] ;
+                    }
+                }
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,356 @@
+/* ========================================================================== */
+/* === KLU_partial_refactor ================================================= */
+/* ========================================================================== */
+
+/* Refactor the matrix, like KLU_refactor, but only recompute the columns of
+ * L and U that are affected by the columns of A that have changed since the
+ * last KLU_factor or KLU_refactor.  The pattern of A must be identical to the
+ * pattern given to KLU_factor, and no pivoting is done.
+ *
+ * Column k of L and U (in the permuted order) is computed from column k of A
+ * and from the columns j of L for which U(j,k) is nonzero.  Column k is thus
+ * affected if column Q [k] of A has changed, or if any of those columns j is
+ * affected.  Since j < k, one pass over the columns in order finds all the
+ * affected columns, and they are recomputed in the same pass, exactly as
+ * KLU_refactor would (the result is the same, bit for bit).  The entries of
+ * the off-diagonal part are only copied for the affected columns.
+ *
+ * If the rows of A are scaled (Common->scale > 0), the scale factors are
+ * recomputed from all of A, and a column of A is treated as changed if any of
+ * its rows has a new scale factor.  A change in the scaling method
+ * (Common->scale <= 0 versus > 0) causes all columns to be recomputed.
+ *
+ * The changed columns of A are given by Changed [j] != 0, or if Changed is
+ * NULL, they are found by comparing Ax and Axold, entry by entry.
+ *
+ * Common->status is KLU_SINGULAR if any diagonal entry of U is zero, whether
+ * or not its column was recomputed.  The blocks are done one at a time, with
+ * no threads; Common->nthreads is ignored.
+ *
+ * Uses Numeric->Xwork as workspace (the first n entries for X, the next n for
+ * the new scale factors, and the next n for the flags of the changed columns).
+ */
+
+#include "klu_internal.h"
+
+Int KLU_partial_refactor    /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],
+    Int Changed [ ],    /* size n, Changed [j] nonzero if A(:,j) changed */
+    double Axold [ ],   /* prior values of A, if Changed is NULL */
+    KLU_symbolic *Symbolic,
+
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common  *Common
+)
+{
+    Entry ukk, ujk ;
+    XEntry *Az ;
+    Entry *X, *Offx, *Lx, *Ux, *Udiag ;
+    double *Rs, *Rnew ;
+    Int *Q, *R, *Pnum, *Pinv, *Offp, *Mark, *Ui, *Li, *Lip, *Uip, *Llen,
+        *Ulen ;
+    Unit *LU ;
+    Int k, k1, k2, nk, block, n, scale, nblocks, maxblock, oldcol, oldrow,
+        newrow, p, pend, poff, i, j, up, ulen, llen, nd, all ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    if (Numeric == NULL || (Changed == NULL && Axold == NULL))
+    {
+        /* invalid Numeric object, or no way to find the changed columns */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    Common->numerical_rank = EMPTY ;
+    Common->singular_col = EMPTY ;
+
+    Az = (XEntry *) Ax ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the contents of the Symbolic and Numeric objects */
+    /* ---------------------------------------------------------------------- */
+
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+
+    Pnum = Numeric->Pnum ;
+    Pinv = Numeric->Pinv ;
+    Offp = Numeric->Offp ;
+    Offx = (Entry *) Numeric->Offx ;
+    Udiag = (Entry *) Numeric->Udiag ;
+
+    /* Xwork holds at least 4n XEntry's */
+    X = (Entry *) Numeric->Xwork ;
+    Rnew = (double *) (((XEntry *) Numeric->Xwork) + n) ;
+    Mark = (Int *) (((XEntry *) Numeric->Xwork) + 2*((size_t) n)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate or free the scale factors, as in KLU_refactor */
+    /* ---------------------------------------------------------------------- */
+
+    all = FALSE ;
+    scale = Common->scale ;
+    if (scale > 0)
+    {
+        if (Numeric->Rs == NULL)
+        {
+            /* factorization was not scaled, but refactorization is scaled */
+            Numeric->Rs = KLU_malloc (n, sizeof (double), Common) ;
+            if (Common->status < KLU_OK)
+            {
+                Common->status = KLU_OUT_OF_MEMORY ;
+                return (FALSE) ;
+            }
+            all = TRUE ;
+        }
+    }
+    else if (Numeric->Rs != NULL)
+    {
+        /* factorization was scaled, but refactorization is not */
+        Numeric->Rs = KLU_free (Numeric->Rs, n, sizeof (double), Common) ;
+        all = TRUE ;
+    }
+    Rs = Numeric->Rs ;
+    Common->nrealloc = 0 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check the input matrix and compute the new row scale factors, Rnew */
+    /* ---------------------------------------------------------------------- */
+
+    if (scale >= 0)
+    {
+        /* check for out-of-range indices, but do not check for duplicates */
+        if (!KLU_scale (scale, n, Ap, Ai, Ax, (scale > 0) ? Rnew : NULL,
+            NULL, Common))
+        {
+            return (FALSE) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* find the columns of A that have changed */
+    /* ---------------------------------------------------------------------- */
+
+    /* # of doubles in each entry */
+    nd = sizeof (XEntry) / sizeof (double) ;
+
+    for (j = 0 ; j < n ; j++)
+    {
+        Mark [j] = all ;
+        pend = Ap [j+1] ;
+        if (all)
+        {
+            continue ;
+        }
+        else if (Changed != NULL)
+        {
+            Mark [j] = (Changed [j] != 0) ;
+        }
+        else
+        {
+            for (p = nd * Ap [j] ; !Mark [j] && p < nd * pend ; p++)
+            {
+                Mark [j] = (Ax [p] != Axold [p]) ;
+            }
+        }
+        if (scale > 0)
+        {
+            /* A(:,j) also changes if any of its rows has a new scale factor.
+             * Note that Rs is in the pivotal order. */
+            for (p = Ap [j] ; !Mark [j] && p < pend ; p++)
+            {
+                i = Ai [p] ;
+                Mark [j] = (Rnew [i] != Rs [Pinv [i]]) ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* clear workspace X */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < maxblock ; k++)
+    {
+        /* X [k] = 0 */
+        CLEAR (X [k]) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* recompute the affected columns of each block */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        Lip  = Numeric->Lip  + k1 ;
+        Llen = Numeric->Llen + k1 ;
+        Uip  = Numeric->Uip  + k1 ;
+        Ulen = Numeric->Ulen + k1 ;
+        LU = (nk == 1) ? NULL : ((Unit **) Numeric->LUbx) [block] ;
+
+        for (k = 0 ; k < nk ; k++)
+        {
+            oldcol = Q [k+k1] ;
+
+            /* -------------------------------------------------------------- */
+            /* determine if column k is affected by a changed column */
+            /* -------------------------------------------------------------- */
+
+            if (!Mark [oldcol] && nk > 1)
+            {
+                GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
+                for (up = 0 ; up < ulen ; up++)
+                {
+                    if (Mark [Q [Ui [up] + k1]])
+                    {
+                        Mark [oldcol] = TRUE ;
+                        break ;
+                    }
+                }
+            }
+
+            if (Mark [oldcol])
+            {
+
+                /* ---------------------------------------------------------- */
+                /* scatter kth column of the block into workspace X */
+                /* ---------------------------------------------------------- */
+
+                poff = Offp [k+k1] ;
+                pend = Ap [oldcol+1] ;
+                for (p = Ap [oldcol] ; p < pend ; p++)
+                {
+                    oldrow = Ai [p] ;
+                    newrow = Pinv [oldrow] - k1 ;
+                    if (newrow < 0)
+                    {
+                        /* entry in off-diagonal part */
+                        if (scale > 0)
+                        {
+                            SCALE_DIV_ASSIGN (Offx [poff], Az [p],
+                                Rnew [oldrow]) ;
+                        }
+                        else
+                        {
+                            CONVERT (Offx [poff], Az [p]) ;
+                        }
+                        poff++ ;
+                    }
+                    else
+                    {
+                        /* (newrow,k) is an entry in the block */
+                        if (scale > 0)
+                        {
+                            SCALE_DIV_ASSIGN (X [newrow], Az [p],
+                                Rnew [oldrow]) ;
+                        }
+                        else
+                        {
+                            CONVERT (X [newrow], Az [p]) ;
+                        }
+                    }
+                }
+                ASSERT (poff == Offp [k+k1+1]) ;
+
+                /* ---------------------------------------------------------- */
+                /* compute kth column of U, and update kth column of A */
+                /* ---------------------------------------------------------- */
+
+                if (nk > 1)
+                {
+                    GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
+                    for (up = 0 ; up < ulen ; up++)
+                    {
+                        j = Ui [up] ;
+                        ujk = X [j] ;
+                        /* X [j] = 0 */
+                        CLEAR (X [j]) ;
+                        Ux [up] = ujk ;
+                        GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
+                        for (p = 0 ; p < llen ; p++)
+                        {
+                            /* X [Li [p]] -= Lx [p] * ujk */
+                            MULT_SUB (X [Li [p]], Lx [p], ujk) ;
+                        }
+                    }
+                }
+
+                /* get the diagonal entry of U */
+                ukk = X [k] ;
+                /* X [k] = 0 */
+                CLEAR (X [k]) ;
+                Udiag [k+k1] = ukk ;
+            }
+
+            /* -------------------------------------------------------------- */
+            /* check the diagonal, whether or not it was recomputed */
+            /* -------------------------------------------------------------- */
+
+            if (IS_ZERO (Udiag [k+k1]))
+            {
+                /* matrix is numerically singular */
+                Common->status = KLU_SINGULAR ;
+                if (Common->numerical_rank == EMPTY)
+                {
+                    Common->numerical_rank = k+k1 ;
+                    Common->singular_col = oldcol ;
+                }
+                if (Common->halt_if_singular)
+                {
+                    /* do not continue the factorization */
+                    return (FALSE) ;
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* gather and divide by pivot to get kth column of L */
+            /* -------------------------------------------------------------- */
+
+            if (Mark [oldcol] && nk > 1)
+            {
+                ukk = Udiag [k+k1] ;
+                GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
+                for (p = 0 ; p < llen ; p++)
+                {
+                    i = Li [p] ;
+                    DIV (Lx [p], X [i], ukk) ;
+                    CLEAR (X [i]) ;
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute the new scale factors Rnew according to pivotal row order */
+    /* ---------------------------------------------------------------------- */
+
+    if (scale > 0)
+    {
+        for (k = 0 ; k < n ; k++)
+        {
+            Rs [k] = Rnew [Pnum [k]] ;
+        }
+    }
+
+    ASSERT (Symbolic->nzoff == Offp [n]) ;
+    return (TRUE) ;
+}
@@ -6,9 +6,662 @@
  * factoring it once with KLU_factor.  This routine cannot do any numerical
  * pivoting.  The pattern of the input matrix (Ap, Ai) must be identical to
  * the pattern given to KLU_factor.
+ *
+ * If Common->repivot > 0, the reciprocal pivot growth of each diagonal block
+ * is checked as soon as it is refactorized (see KLU_rgrowth).  A block whose
+ * pivot growth is below Common->repivot, or that has a zero pivot, is then
+ * factorized again with partial pivoting, as KLU_factor would, while all other
+ * blocks keep the pivot order of the prior factorization.  The number of such
+ * blocks is returned in Common->nrepivot.  The blocks are done one at a time,
+ * in order, and Common->nthreads is ignored.  A Numeric object from
+ * KLU_load_numeric cannot be re-pivoted, and is refactorized as usual.
  */
 
 #include "klu_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/* ========================================================================== */
+/* === refactor_block ======================================================= */
+/* ========================================================================== */
+
+/* Refactorize a single diagonal block of the BTF form, with the same pivot
+ * ordering and pattern as the prior KLU_factor, and copy the entries of A to
+ * its left into the off-diagonal part.  Different blocks can be refactorized
+ * at the same time, each with its own workspace X.  Returns the first column
+ * k (in the range R [block] to R [block+1]-1) for which U(k,k) is zero, or
+ * EMPTY if there is none.  If halt_if_singular is true, the block is only
+ * partially refactorized in that case, and X is not cleared. */
+
+static Int refactor_block
+(
+    /* inputs, not modified */
+    Int block,          /* the block to refactorize */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    XEntry Az [ ],
+    KLU_symbolic *Symbolic,
+    Int scale,
+    Int halt_if_singular,
+
+    /* input/output */
+    KLU_numeric *Numeric,
+
+    /* workspace */
+    Entry X [ ]         /* size maxblock, zero on input and output */
+)
+{
+    Entry ukk, ujk, s ;
+    Entry *Offx, *Lx, *Ux, *Udiag ;
+    double *Rs ;
+    Int *Q, *R, *Ui, *Li, *Pinv, *Lip, *Uip, *Llen, *Ulen ;
+    Unit *LU ;
+    Int k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, poff, i, j, up, ulen,
+        llen, nzoff, singular ;
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nzoff = Symbolic->nzoff ;
+    Offx = (Entry *) Numeric->Offx ;
+    Udiag = Numeric->Udiag ;
+    Rs = Numeric->Rs ;
+    Pinv = Numeric->Pinv ;
+    singular = EMPTY ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the block is from rows/columns k1 to k2-1 */
+    /* ---------------------------------------------------------------------- */
+
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    poff = Numeric->Offp [k1] ;
+
+    if (nk == 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* singleton case */
+        /* ------------------------------------------------------------------ */
+
+        oldcol = Q [k1] ;
+        pend = Ap [oldcol+1] ;
+        CLEAR (s) ;
+        if (scale <= 0)
+        {
+            /* no scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                newrow = Pinv [Ai [p]] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal block */
+                    CONVERT (Offx [poff], Az [p]) ;
+                    poff++ ;
+                }
+                else
+                {
+                    /* singleton */
+                    CONVERT (s, Az [p]) ;
+                }
+            }
+        }
+        else
+        {
+            /* scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal block */
+                    /* Offx [poff] = Az [p] / Rs [oldrow] */
+                    SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
+                    poff++ ;
+                }
+                else
+                {
+                    /* singleton */
+                    /* s = Az [p] / Rs [oldrow] */
+                    SCALE_DIV_ASSIGN (s, Az [p], Rs [oldrow]) ;
+                }
+            }
+        }
+        Udiag [k1] = s ;
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* construct and factor the kth block */
+        /* ------------------------------------------------------------------ */
+
+        Lip  = Numeric->Lip  + k1 ;
+        Llen = Numeric->Llen + k1 ;
+        Uip  = Numeric->Uip  + k1 ;
+        Ulen = Numeric->Ulen + k1 ;
+        LU = ((Unit **) Numeric->LUbx) [block] ;
+
+        for (k = 0 ; k < nk ; k++)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* scatter kth column of the block into workspace X */
+            /* -------------------------------------------------------------- */
+
+            oldcol = Q [k+k1] ;
+            pend = Ap [oldcol+1] ;
+            if (scale <= 0)
+            {
+                /* no scaling */
+                for (p = Ap [oldcol] ; p < pend ; p++)
+                {
+                    newrow = Pinv [Ai [p]] - k1 ;
+                    if (newrow < 0 && poff < nzoff)
+                    {
+                        /* entry in off-diagonal block */
+                        CONVERT (Offx [poff], Az [p]) ;
+                        poff++ ;
+                    }
+                    else
+                    {
+                        /* (newrow,k) is an entry in the block */
+                        CONVERT (X [newrow], Az [p]) ;
+                    }
+                }
+            }
+            else
+            {
+                /* scaling */
+                for (p = Ap [oldcol] ; p < pend ; p++)
+                {
+                    oldrow = Ai [p] ;
+                    newrow = Pinv [oldrow] - k1 ;
+                    if (newrow < 0 && poff < nzoff)
+                    {
+                        /* entry in off-diagonal part */
+                        /* Offx [poff] = Az [p] / Rs [oldrow] */
+                        SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]);
+                        poff++ ;
+                    }
+                    else
+                    {
+                        /* (newrow,k) is an entry in the block */
+                        /* X [newrow] = Az [p] / Rs [oldrow] */
+                        SCALE_DIV_ASSIGN (X [newrow], Az [p], Rs [oldrow]) ;
+                    }
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* compute kth column of U, and update kth column of A */
+            /* -------------------------------------------------------------- */
+
+            GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
+            for (up = 0 ; up < ulen ; up++)
+            {
+                j = Ui [up] ;
+                ujk = X [j] ;
+                /* X [j] = 0 */
+                CLEAR (X [j]) ;
+                Ux [up] = ujk ;
+                GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
+                for (p = 0 ; p < llen ; p++)
+                {
+                    /* X [Li [p]] -= Lx [p] * ujk */
+                    MULT_SUB (X [Li [p]], Lx [p], ujk) ;
+                }
+            }
+            /* get the diagonal entry of U */
+            ukk = X [k] ;
+            /* X [k] = 0 */
+            CLEAR (X [k]) ;
+            /* singular case */
+            if (IS_ZERO (ukk))
+            {
+                /* matrix is numerically singular */
+                if (singular == EMPTY)
+                {
+                    singular = k+k1 ;
+                }
+                if (halt_if_singular)
+                {
+                    /* do not continue the factorization */
+                    return (singular) ;
+                }
+            }
+            Udiag [k+k1] = ukk ;
+            /* gather and divide by pivot to get kth column of L */
+            GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
+            for (p = 0 ; p < llen ; p++)
+            {
+                i = Li [p] ;
+                DIV (Lx [p], X [i], ukk) ;
+                CLEAR (X [i]) ;
+            }
+        }
+    }
+
+    ASSERT (poff == Numeric->Offp [k2]) ;
+    return (singular) ;
+}
+
+
+/* ========================================================================== */
+/* === block_rgrowth ======================================================== */
+/* ========================================================================== */
+
+/* Return the reciprocal pivot growth of a single diagonal block (larger than
+ * 1-by-1) that has just been refactorized, computed as in KLU_rgrowth.  The
+ * scale factors are not yet permuted, so Rs [oldrow] is used. */
+
+static double block_rgrowth
+(
+    /* inputs, not modified */
+    Int block,          /* the block to check */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    XEntry Az [ ],
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric
+)
+{
+    double temp, max_ai, max_ui, rgrowth ;
+    XEntry aik ;
+    Entry *Ux, *Udiag ;
+    double *Rs ;
+    Int *Q, *Uip, *Ulen, *Pinv ;
+    Unit *LU ;
+    Int k1, k2, nk, j, oldcol, oldrow, p, pend, len ;
+
+    Q = Symbolic->Q ;
+    Rs = Numeric->Rs ;
+    Pinv = Numeric->Pinv ;
+    k1 = Symbolic->R [block] ;
+    k2 = Symbolic->R [block+1] ;
+    nk = k2 - k1 ;
+    LU = ((Unit **) Numeric->LUbx) [block] ;
+    Uip = Numeric->Uip + k1 ;
+    Ulen = Numeric->Ulen + k1 ;
+    Udiag = ((Entry *) Numeric->Udiag) + k1 ;
+    rgrowth = 1 ;
+
+    for (j = 0 ; j < nk ; j++)
+    {
+        max_ai = 0 ;
+        max_ui = 0 ;
+        oldcol = Q [j + k1] ;
+        pend = Ap [oldcol + 1] ;
+        for (p = Ap [oldcol] ; p < pend ; p++)
+        {
+            oldrow = Ai [p] ;
+            if (Pinv [oldrow] < k1)
+            {
+                continue ;      /* skip entry outside the block */
+            }
+            if (Rs != NULL)
+            {
+                /* aik = Az [p] / Rs [oldrow] */
+                SCALE_DIV_ASSIGN (aik, Az [p], Rs [oldrow]) ;
+            }
+            else
+            {
+                aik = Az [p] ;
+            }
+            /* temp = ABS (aik) */
+            ABS (temp, aik) ;
+            if (temp > max_ai)
+            {
+                max_ai = temp ;
+            }
+        }
+
+        GET_X_POINTER (LU, Uip, Ulen, Ux, j) ;
+        len = Ulen [j] ;
+        for (p = 0 ; p < len ; p++)
+        {
+            /* temp = ABS (Ux [p]) */
+            ABS (temp, Ux [p]) ;
+            if (temp > max_ui)
+            {
+                max_ui = temp ;
+            }
+        }
+        /* consider the diagonal element */
+        ABS (temp, Udiag [j]) ;
+        if (temp > max_ui)
+        {
+            max_ui = temp ;
+        }
+
+        /* if max_ui is 0, skip the column */
+        if (SCALAR_IS_ZERO (max_ui))
+        {
+            continue ;
+        }
+        temp = max_ai / max_ui ;
+        if (temp < rgrowth)
+        {
+            rgrowth = temp ;
+        }
+    }
+    return (rgrowth) ;
+}
+
+
+/* ========================================================================== */
+/* === repivot_block ======================================================== */
+/* ========================================================================== */
+
+/* Factorize a single diagonal block (larger than 1-by-1) again, with partial
+ * pivoting as in KLU_factor, replacing its L and U factors and the pivot
+ * order of its rows.  Pnum and Pinv are updated for the rows of the block, and
+ * so are the row indices of the off-diagonal part: those in the columns of the
+ * block are recomputed, and those in the columns to the right of the block
+ * that refer to its rows are renumbered.  The blocks to the left must already
+ * be final, and the scale factors must not yet be permuted.  Uses Xwork and
+ * Iwork as workspace.  Returns FALSE if out of memory, or if the block is
+ * singular and Common->halt_if_singular is true.  The new factors are built
+ * apart from the Numeric object, so in that case it still holds the prior
+ * factors and pivot order of the block, and can be refactorized again. */
+
+static Int repivot_block
+(
+    /* inputs, not modified */
+    Int block,          /* the block to factorize */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    XEntry Az [ ],
+    KLU_symbolic *Symbolic,
+
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    double lsize ;
+    double *Lnz ;
+    Entry *Udiag, *Offx, *Ework, *Unew, *Offx_old ;
+    Int *Q, *Pnum, *Pinv, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen, *Iwork,
+        *Pblock, *Pold, *Newpos, *Work, *Lipnew, *Uipnew, *Llennew, *Ulennew,
+        *Offi_old ;
+    Unit **LUbx, *LU ;
+    size_t lusize ;
+    Int k1, k2, nk, k, p, i, n, maxblock, lnz_block, unz_block, old_lnz,
+        old_unz, poff, noff, status ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the contents of the Symbolic and Numeric objects */
+    /* ---------------------------------------------------------------------- */
+
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    Lnz = Symbolic->Lnz ;
+    maxblock = Symbolic->maxblock ;
+
+    Pnum = Numeric->Pnum ;
+    Pinv = Numeric->Pinv ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Offx = (Entry *) Numeric->Offx ;
+    Lip = Numeric->Lip ;
+    Uip = Numeric->Uip ;
+    Llen = Numeric->Llen ;
+    Ulen = Numeric->Ulen ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    Udiag = Numeric->Udiag ;
+    Iwork = Numeric->Iwork ;
+    Pblock = Iwork + 5*((size_t) maxblock) ;
+
+    k1 = Symbolic->R [block] ;
+    k2 = Symbolic->R [block+1] ;
+    nk = k2 - k1 ;
+    poff = Offp [k1] ;
+    noff = Offp [k2] - poff ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate space for the new factors of the block */
+    /* ---------------------------------------------------------------------- */
+
+    /* Lip, Uip, Llen, Ulen and Udiag of the block are computed in Work and
+     * Ework.  The kernel fills in the off-diagonal part of the columns of the
+     * block in place, so those are saved in Work and Ework first. */
+    status = Common->status ;
+    Work = KLU_malloc (4*nk + noff, sizeof (Int), Common) ;
+    Ework = KLU_malloc (nk + noff, sizeof (Entry), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Work, 4*nk + noff, sizeof (Int), Common) ;
+        KLU_free (Ework, nk + noff, sizeof (Entry), Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (FALSE) ;
+    }
+    Common->status = status ;
+    Lipnew = Work ;
+    Uipnew = Work + nk ;
+    Llennew = Work + 2*nk ;
+    Ulennew = Work + 3*nk ;
+    Offi_old = Work + 4*nk ;
+    Unew = Ework ;
+    Offx_old = Ework + nk ;
+    for (p = 0 ; p < noff ; p++)
+    {
+        Offi_old [p] = Offi [poff + p] ;
+        Offx_old [p] = Offx [poff + p] ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the block, as in KLU_factor */
+    /* ---------------------------------------------------------------------- */
+
+    /* The current pivot order of the rows (Pinv) takes the place of the
+     * symbolic pre-ordering, and Rs [oldrow] is used for the scale factors. */
+    if (Lnz [block] < 0)
+    {
+        lsize = -(Common->initmem) ;
+    }
+    else
+    {
+        lsize = Common->initmem_amd * Lnz [block] + nk ;
+    }
+    if (Common->dense > 0 && nk >= KLU_DENSE_MIN && Lnz [block] >= 0 &&
+        2 * Lnz [block] - nk >= Common->dense * ((double) nk) * nk)
+    {
+        lusize = KLU_dense_factor (nk, Ap, Ai, Az, Q, lsize, &LU, Unew,
+            Llennew, Ulennew, Lipnew, Uipnew, Pblock, &lnz_block, &unz_block,
+            (Entry *) Numeric->Xwork, Iwork, k1, Pinv, Numeric->Rs, Offp,
+            Offi, Offx, Common) ;
+    }
+    else
+    {
+        lusize = KLU_kernel_factor (nk, Ap, Ai, Az, Q, lsize, &LU, Unew,
+            Llennew, Ulennew, Lipnew, Uipnew, Pblock, &lnz_block, &unz_block,
+            (Entry *) Numeric->Xwork, Iwork, k1, Pinv, Numeric->Rs, Offp,
+            Offi, Offx, Common) ;
+    }
+
+    if (Common->status < KLU_OK ||
+       (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+    {
+        /* out of memory, or singular; keep the prior factors of the block */
+        KLU_free (LU, lusize, sizeof (Unit), Common) ;
+        for (p = 0 ; p < noff ; p++)
+        {
+            Offi [poff + p] = Offi_old [p] ;
+            Offx [poff + p] = Offx_old [p] ;
+        }
+        KLU_free (Work, 4*nk + noff, sizeof (Int), Common) ;
+        KLU_free (Ework, nk + noff, sizeof (Entry), Common) ;
+        return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* replace the prior factors of the block with the new ones */
+    /* ---------------------------------------------------------------------- */
+
+    old_lnz = nk ;
+    old_unz = nk ;
+    for (k = 0 ; k < nk ; k++)
+    {
+        old_lnz += Llen [k + k1] ;
+        old_unz += Ulen [k + k1] ;
+        Lip [k + k1] = Lipnew [k] ;
+        Uip [k + k1] = Uipnew [k] ;
+        Llen [k + k1] = Llennew [k] ;
+        Ulen [k + k1] = Ulennew [k] ;
+        Udiag [k + k1] = Unew [k] ;
+    }
+    KLU_free (LUbx [block], Numeric->LUsize [block], sizeof (Unit), Common) ;
+    LUbx [block] = LU ;
+    Numeric->LUsize [block] = lusize ;
+    KLU_free (Work, 4*nk + noff, sizeof (Int), Common) ;
+    KLU_free (Ework, nk + noff, sizeof (Entry), Common) ;
+
+    Numeric->lnz += lnz_block - old_lnz ;
+    Numeric->unz += unz_block - old_unz ;
+    Numeric->max_lnz_block = MAX (Numeric->max_lnz_block, lnz_block) ;
+    Numeric->max_unz_block = MAX (Numeric->max_unz_block, unz_block) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* combine the new local row ordering with the prior one */
+    /* ---------------------------------------------------------------------- */
+
+    Pold = Iwork ;                  /* size nk, the prior Pnum of the block */
+    Newpos = Iwork + maxblock ;     /* size nk, new position of prior row k */
+    for (k = 0 ; k < nk ; k++)
+    {
+        Pold [k] = Pnum [k + k1] ;
+    }
+    for (k = 0 ; k < nk ; k++)
+    {
+        Pnum [k + k1] = Pold [Pblock [k]] ;
+        Pinv [Pnum [k + k1]] = k + k1 ;
+        Newpos [Pblock [k]] = k + k1 ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* update the row indices of the off-diagonal part */
+    /* ---------------------------------------------------------------------- */
+
+    /* the columns of the block hold the original row indices */
+    for (p = Offp [k1] ; p < Offp [k2] ; p++)
+    {
+        Offi [p] = Pinv [Offi [p]] ;
+    }
+
+    /* renumber the rows of the block in the columns to its right */
+    for (p = Offp [k2] ; p < Offp [n] ; p++)
+    {
+        i = Offi [p] ;
+        if (i >= k1 && i < k2)
+        {
+            Offi [p] = Newpos [i - k1] ;
+        }
+    }
+    return (TRUE) ;
+}
+
+
+#ifdef _OPENMP
+/* ========================================================================== */
+/* === refactor_parallel ==================================================== */
+/* ========================================================================== */
+
+/* Refactorize the blocks in parallel, in the order given by KLU_schedule.
+ * Thread 0 uses Numeric->Xwork as its workspace, which must be zero on input.
+ * Returns the first column k for which U(k,k) is zero, or n if there is
+ * none.  If halt_if_singular is true, the blocks after a singular block may
+ * or may not have been refactorized.  Returns EMPTY if the workspace cannot
+ * be allocated, in which case nothing has been done. */
+
+static Int refactor_parallel
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    XEntry Az [ ],
+    KLU_symbolic *Symbolic,
+    Int scale,
+    Int nthreads,       /* # of threads to use */
+    Int Order [ ],      /* size nblocks, the block schedule */
+
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    Entry *Twork, *X ;
+    size_t wsize ;
+    Int b, k, tid, n, nblocks, maxblock, halt, halt_if_singular, singular,
+        status, ok = TRUE ;
+
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+    halt_if_singular = Common->halt_if_singular ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate and clear the workspace for threads 1 to nthreads-1 */
+    /* ---------------------------------------------------------------------- */
+
+    wsize = KLU_mult_size_t (maxblock, nthreads - 1, &ok) ;
+    status = Common->status ;
+    Twork = ok ? KLU_malloc (wsize, sizeof (Entry), Common) : NULL ;
+    if (Twork == NULL)
+    {
+        Common->status = status ;
+        return (EMPTY) ;
+    }
+    for (k = 0 ; k < (Int) wsize ; k++)
+    {
+        /* Twork [k] = 0 */
+        CLEAR (Twork [k]) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* refactorize the blocks */
+    /* ---------------------------------------------------------------------- */
+
+    singular = n ;
+    halt = FALSE ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+        private(X, k, tid) reduction(min:singular)
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        Int stop ;
+        #pragma omp atomic read
+        stop = halt ;
+        if (stop)
+        {
+            /* a singular block has been found; do not start any more */
+            continue ;
+        }
+
+        tid = omp_get_thread_num ( ) ;
+        X = (tid == 0) ? ((Entry *) Numeric->Xwork) :
+            (Twork + (tid - 1) * ((size_t) maxblock)) ;
+        k = refactor_block (Order [b], Ap, Ai, Az, Symbolic, scale,
+            halt_if_singular, Numeric, X) ;
+        if (k != EMPTY)
+        {
+            singular = MIN (singular, k) ;
+            if (halt_if_singular)
+            {
+                #pragma omp atomic write
+                halt = TRUE ;
+            }
+        }
+    }
+
+    KLU_free (Twork, wsize, sizeof (Entry), Common) ;
+    return (singular) ;
+}
+#endif
 
 
 /* ========================================================================== */
@@ -28,14 +681,11 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     KLU_common  *Common
 )
 {
-    Entry ukk, ujk, s ;
-    Entry *Offx, *Lx, *Ux, *X, *Az, *Udiag ;
-    double *Rs ;
-    Int *Q, *R, *Pnum, *Ui, *Li, *Pinv, *Lip, *Uip, *Llen, *Ulen ;
-    Unit **LUbx ;
-    Unit *LU ;
-    Int k1, k2, nk, k, block, oldcol, pend, oldrow, n, p, newrow, scale,
-        nblocks, poff, i, j, up, ulen, llen, maxblock, nzoff ;
+    XEntry *Az ;
+    Entry *X ;
+    double *Rs, *W ;
+    Int *Q, *R, *Pnum, *Order ;
+    Int k, block, n, scale, nblocks, maxblock, nthreads, singular, repivot ;
 
     /* ---------------------------------------------------------------------- */
     /* check inputs */
@@ -57,7 +707,7 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     Common->numerical_rank = EMPTY ;
     Common->singular_col = EMPTY ;
 
-    Az = (Entry *) Ax ;
+    Az = (XEntry *) Ax ;
 
     /* ---------------------------------------------------------------------- */
     /* get the contents of the Symbolic object */
@@ -74,9 +724,6 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     /* ---------------------------------------------------------------------- */
 
     Pnum = Numeric->Pnum ;
-    Offx = (Entry *) Numeric->Offx ;
-
-    LUbx = (Unit **) Numeric->LUbx ;
 
     scale = Common->scale ;
     if (scale > 0)
@@ -100,11 +747,12 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     }
     Rs = Numeric->Rs ;
 
-    Pinv = Numeric->Pinv ;
     X = (Entry *) Numeric->Xwork ;
     Common->nrealloc = 0 ;
-    Udiag = Numeric->Udiag ;
-    nzoff = Symbolic->nzoff ;
+    Common->nrepivot = 0 ;
+
+    /* the factors of a loaded Numeric object are not separately allocated */
+    repivot = (Common->repivot > 0 && Numeric->Mapping == NULL) ;
 
     /* ---------------------------------------------------------------------- */
     /* check the input matrix compute the row scale factors, Rs */
@@ -130,316 +778,108 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
         CLEAR (X [k]) ;
     }
 
-    poff = 0 ;
-
     /* ---------------------------------------------------------------------- */
     /* factor each block */
     /* ---------------------------------------------------------------------- */
 
-    if (scale <= 0)
-    {
-
-        /* ------------------------------------------------------------------ */
-        /* no scaling */
-        /* ------------------------------------------------------------------ */
+    nthreads = repivot ? 1 : KLU_schedule (nblocks, R, maxblock, &Order,
+        Common) ;
+    singular = EMPTY ;
 
-        for (block = 0 ; block < nblocks ; block++)
+#ifdef _OPENMP
+    if (nthreads > 1)
+    {
+        singular = refactor_parallel (Ap, Ai, Az, Symbolic, scale, nthreads,
+            Order, Numeric, Common) ;
+        if (singular == EMPTY)
         {
+            /* out of memory; refactorize the blocks one at a time instead */
+            nthreads = 1 ;
+        }
+        else if (singular < n)
+        {
+            /* matrix is numerically singular */
+            Common->status = KLU_SINGULAR ;
+            Common->numerical_rank = singular ;
+            Common->singular_col = Q [singular] ;
+        }
+        KLU_free (Order, nblocks, sizeof (Int), Common) ;
+    }
+#endif
 
-            /* -------------------------------------------------------------- */
-            /* the block is from rows/columns k1 to k2-1 */
-            /* -------------------------------------------------------------- */
-
-            k1 = R [block] ;
-            k2 = R [block+1] ;
-            nk = k2 - k1 ;
-
-            if (nk == 1)
-            {
-
-                /* ---------------------------------------------------------- */
-                /* singleton case */
-                /* ---------------------------------------------------------- */
-
-                oldcol = Q [k1] ;
-                pend = Ap [oldcol+1] ;
-                CLEAR (s) ;
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    newrow = Pinv [Ai [p]] - k1 ;
-                    if (newrow < 0 && poff < nzoff)
-                    {
-                        /* entry in off-diagonal block */
-                        Offx [poff] = Az [p] ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        /* singleton */
-                        s = Az [p] ;
-                    }
-                }
-                Udiag [k1] = s ;
-
-            }
-            else
+    for (block = 0 ; nthreads == 1 && block < nblocks ; block++)
+    {
+        singular = refactor_block (block, Ap, Ai, Az, Symbolic, scale,
+            Common->halt_if_singular, Numeric, X) ;
+        if (repivot && R [block+1] - R [block] > 1 && (singular != EMPTY ||
+            block_rgrowth (block, Ap, Ai, Az, Symbolic, Numeric)
+            < Common->repivot))
+        {
+            /* the prior pivots are unstable; factorize the block again */
+            if (!repivot_block (block, Ap, Ai, Az, Symbolic, Numeric, Common))
             {
-
-                /* ---------------------------------------------------------- */
-                /* construct and factor the kth block */
-                /* ---------------------------------------------------------- */
-
-                Lip  = Numeric->Lip  + k1 ;
-                Llen = Numeric->Llen + k1 ;
-                Uip  = Numeric->Uip  + k1 ;
-                Ulen = Numeric->Ulen + k1 ;
-                LU = LUbx [block] ;
-
-                for (k = 0 ; k < nk ; k++)
-                {
-
-                    /* ------------------------------------------------------ */
-                    /* scatter kth column of the block into workspace X */
-                    /* ------------------------------------------------------ */
-
-                    oldcol = Q [k+k1] ;
-                    pend = Ap [oldcol+1] ;
-                    for (p = Ap [oldcol] ; p < pend ; p++)
-                    {
-                        newrow = Pinv [Ai [p]] - k1 ;
-                        if (newrow < 0 && poff < nzoff)
-                        {
-                            /* entry in off-diagonal block */
-                            Offx [poff] = Az [p] ;
-                            poff++ ;
-                        }
-                        else
-                        {
-                            /* (newrow,k) is an entry in the block */
-                            X [newrow] = Az [p] ;
-                        }
-                    }
-
-                    /* ------------------------------------------------------ */
-                    /* compute kth column of U, and update kth column of A */
-                    /* ------------------------------------------------------ */
-
-                    GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
-                    for (up = 0 ; up < ulen ; up++)
-                    {
-                        j = Ui [up] ;
-                        ujk = X [j] ;
-                        /* X [j] = 0 */
-                        CLEAR (X [j]) ;
-                        Ux [up] = ujk ;
-                        GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
-                        for (p = 0 ; p < llen ; p++)
-                        {
-                            /* X [Li [p]] -= Lx [p] * ujk */
-                            MULT_SUB (X [Li [p]], Lx [p], ujk) ;
-                        }
-                    }
-                    /* get the diagonal entry of U */
-                    ukk = X [k] ;
-                    /* X [k] = 0 */
-                    CLEAR (X [k]) ;
-                    /* singular case */
-                    if (IS_ZERO (ukk))
-                    {
-                        /* matrix is numerically singular */
-                        Common->status = KLU_SINGULAR ;
-                        if (Common->numerical_rank == EMPTY)
-                        {
-                            Common->numerical_rank = k+k1 ;
-                            Common->singular_col = Q [k+k1] ;
-                        }
-                        if (Common->halt_if_singular)
-                        {
-                            /* do not continue the factorization */
-                            return (FALSE) ;
-                        }
-                    }
-                    Udiag [k+k1] = ukk ;
-                    /* gather and divide by pivot to get kth column of L */
-                    GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
-                    for (p = 0 ; p < llen ; p++)
-                    {
-                        i = Li [p] ;
-                        DIV (Lx [p], X [i], ukk) ;
-                        CLEAR (X [i]) ;
-                    }
-
-                }
+                /* out of memory, or singular */
+                return (FALSE) ;
             }
+            /* any Batch object made from Numeric is no longer valid */
+            Numeric->generation++ ;
+            Common->nrepivot++ ;
         }
-
-    }
-    else
-    {
-
-        /* ------------------------------------------------------------------ */
-        /* scaling */
-        /* ------------------------------------------------------------------ */
-
-        for (block = 0 ; block < nblocks ; block++)
+        else if (singular != EMPTY)
         {
-
-            /* -------------------------------------------------------------- */
-            /* the block is from rows/columns k1 to k2-1 */
-            /* -------------------------------------------------------------- */
-
-            k1 = R [block] ;
-            k2 = R [block+1] ;
-            nk = k2 - k1 ;
-
-            if (nk == 1)
+            /* matrix is numerically singular */
+            Common->status = KLU_SINGULAR ;
+            if (Common->numerical_rank == EMPTY)
             {
-
-                /* ---------------------------------------------------------- */
-                /* singleton case */
-                /* ---------------------------------------------------------- */
-
-                oldcol = Q [k1] ;
-                pend = Ap [oldcol+1] ;
-                CLEAR (s) ;
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] - k1 ;
-                    if (newrow < 0 && poff < nzoff)
-                    {
-                        /* entry in off-diagonal block */
-                        /* Offx [poff] = Az [p] / Rs [oldrow] */
-                        SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        /* singleton */
-                        /* s = Az [p] / Rs [oldrow] */
-                        SCALE_DIV_ASSIGN (s, Az [p], Rs [oldrow]) ;
-                    }
-                }
-                Udiag [k1] = s ;
-
+                Common->numerical_rank = singular ;
+                Common->singular_col = Q [singular] ;
             }
-            else
+            if (Common->halt_if_singular)
             {
-
-                /* ---------------------------------------------------------- */
-                /* construct and factor the kth block */
-                /* ---------------------------------------------------------- */
-
-                Lip  = Numeric->Lip  + k1 ;
-                Llen = Numeric->Llen + k1 ;
-                Uip  = Numeric->Uip  + k1 ;
-                Ulen = Numeric->Ulen + k1 ;
-                LU = LUbx [block] ;
-
-                for (k = 0 ; k < nk ; k++)
-                {
-
-                    /* ------------------------------------------------------ */
-                    /* scatter kth column of the block into workspace X */
-                    /* ------------------------------------------------------ */
-
-                    oldcol = Q [k+k1] ;
-                    pend = Ap [oldcol+1] ;
-                    for (p = Ap [oldcol] ; p < pend ; p++)
-                    {
-                        oldrow = Ai [p] ;
-                        newrow = Pinv [oldrow] - k1 ;
-                        if (newrow < 0 && poff < nzoff)
-                        {
-                            /* entry in off-diagonal part */
-                            /* Offx [poff] = Az [p] / Rs [oldrow] */
-                            SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]);
-                            poff++ ;
-                        }
-                        else
-                        {
-                            /* (newrow,k) is an entry in the block */
-                            /* X [newrow] = Az [p] / Rs [oldrow] */
-                            SCALE_DIV_ASSIGN (X [newrow], Az [p], Rs [oldrow]) ;
-                        }
-                    }
-
-                    /* ------------------------------------------------------ */
-                    /* compute kth column of U, and update kth column of A */
-                    /* ------------------------------------------------------ */
-
-                    GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
-                    for (up = 0 ; up < ulen ; up++)
-                    {
-                        j = Ui [up] ;
-                        ujk = X [j] ;
-                        /* X [j] = 0 */
-                        CLEAR (X [j]) ;
-                        Ux [up] = ujk ;
-                        GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
-                        for (p = 0 ; p < llen ; p++)
-                        {
-                            /* X [Li [p]] -= Lx [p] * ujk */
-                            MULT_SUB (X [Li [p]], Lx [p], ujk) ;
-                        }
-                    }
-                    /* get the diagonal entry of U */
-                    ukk = X [k] ;
-                    /* X [k] = 0 */
-                    CLEAR (X [k]) ;
-                    /* singular case */
-                    if (IS_ZERO (ukk))
-                    {
-                        /* matrix is numerically singular */
-                        Common->status = KLU_SINGULAR ;
-                        if (Common->numerical_rank == EMPTY)
-                        {
-                            Common->numerical_rank = k+k1 ;
-                            Common->singular_col = Q [k+k1] ;
-                        }
-                        if (Common->halt_if_singular)
-                        {
-                            /* do not continue the factorization */
-                            return (FALSE) ;
-                        }
-                    }
-                    Udiag [k+k1] = ukk ;
-                    /* gather and divide by pivot to get kth column of L */
-                    GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
-                    for (p = 0 ; p < llen ; p++)
-                    {
-                        i = Li [p] ;
-                        DIV (Lx [p], X [i], ukk) ;
-                        CLEAR (X [i]) ;
-                    }
-                }
+                break ;
             }
         }
     }
 
+    if (Common->status == KLU_SINGULAR && Common->halt_if_singular)
+    {
+        /* do not continue the factorization */
+        return (FALSE) ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* permute scale factors Rs according to pivotal row order */
     /* ---------------------------------------------------------------------- */
 
     if (scale > 0)
     {
+        /* use Xwork as a double array, since X may be single precision */
+        W = (double *) Numeric->Xwork ;
         for (k = 0 ; k < n ; k++)
         {
-            REAL (X [k]) = Rs [Pnum [k]] ;
+            W [k] = Rs [Pnum [k]] ;
         }
         for (k = 0 ; k < n ; k++)
         {
-            Rs [k] = REAL (X [k]) ;
+            Rs [k] = W [k] ;
         }
     }
 
+    /* the level sets refer to the prior L and U of any re-pivoted blocks */
+    if (Common->nrepivot > 0 && Numeric->Levels != NULL)
+    {
+        (void) KLU_levels (Symbolic, Numeric, Common) ;
+    }
+
 #ifndef NDEBUG
-    ASSERT (Numeric->Offp [n] == poff) ;
-    ASSERT (Symbolic->nzoff == poff) ;
+    ASSERT (Symbolic->nzoff == Numeric->Offp [n]) ;
     PRINTF (("\n------------------- Off diagonal entries, new:\n")) ;
-    ASSERT (KLU_valid (n, Numeric->Offp, Numeric->Offi, Offx)) ;
+    ASSERT (KLU_valid (n, Numeric->Offp, Numeric->Offi,
+        (Entry *) Numeric->Offx)) ;
     if (Common->status == KLU_OK)
     {
+        Int k1, k2, nk, *Lip, *Uip, *Llen, *Ulen ;
+        Unit *LU ;
         PRINTF (("\n ########### KLU_BTF_REFACTOR done, nblocks %d\n",nblocks));
         for (block = 0 ; block < nblocks ; block++)
         {
@@ -452,7 +892,7 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
             if (nk == 1)
             {
                 PRINTF (("singleton  ")) ;
-                PRINT_ENTRY (Udiag [k1]) ;
+                PRINT_ENTRY (((Entry *) Numeric->Udiag) [k1]) ;
             }
             else
             {
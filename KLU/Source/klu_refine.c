@@ -0,0 +1,189 @@
+/* ========================================================================== */
+/* === KLU_refine =========================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b with iterative refinement, using the Symbolic and Numeric objects
+ * from KLU_analyze and KLU_factor (or KLU_refactor).  The residual r = b-A*x
+ * is computed in double precision from the original matrix A, so that the
+ * solution is accurate to double precision even if the factors are held in
+ * single precision (klu_s_factor and its variants), as long as A is not too
+ * ill-conditioned.  B is not modified; the solution is returned in X.
+ *
+ * For each right-hand-side, x = A\b is computed with KLU_solve, and then at
+ * most Common->irstep steps of refinement are done.  Refinement stops early
+ * once the componentwise backward error,
+ *
+ *      berr = max_i |b-A*x|_i / (|b| + |A|*|x|)_i
+ *
+ * falls to the machine epsilon of a double, or fails to drop by at least a
+ * factor of two in one step.  In the latter case the step is discarded, and
+ * x is the solution before that step.  The largest berr of all the
+ * right-hand-sides is returned in Common->berr.
+ *
+ * Returns FALSE if KLU_solve fails.  Common->status is then as set by
+ * KLU_solve, and X is undefined.
+ *
+ * Uses Numeric->Xwork (via KLU_solve) plus 2*n XEntry's and n double's of
+ * workspace allocated here.
+ */
+
+#include "klu_internal.h"
+#include <float.h>
+
+Int KLU_refine          /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    Int Ap [ ],             /* size n+1, column pointers */
+    Int Ai [ ],             /* size nz, row indices */
+    double Ax [ ],
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,                  /* leading dimension of B and X */
+    Int nrhs,               /* number of right-hand-sides */
+    double B [ ],           /* size n*nrhs, in column-oriented form, with
+                             * leading dimension d. */
+
+    /* output */
+    double X [ ],           /* size n*nrhs, solution to Ax=b */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    double berr, lastberr, maxberr, xabs, aabs, *W ;
+    XEntry xj, *Az, *Bz, *Xz, *Rz, *Xlast, *b, *x ;
+    Int i, j, k, p, n, step, irstep, ok ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Symbolic == NULL || Numeric == NULL || Ap == NULL || Ai == NULL ||
+        Ax == NULL || B == NULL || X == NULL || d < Symbolic->n || nrhs < 0)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+    Common->berr = 0 ;
+
+    n = Symbolic->n ;
+    irstep = Common->irstep ;
+    Az = (XEntry *) Ax ;
+    Bz = (XEntry *) B ;
+    Xz = (XEntry *) X ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace for the residual, the prior x, and |b| + |A|*|x| */
+    /* ---------------------------------------------------------------------- */
+
+    Rz = KLU_malloc (n, sizeof (XEntry), Common) ;
+    Xlast = KLU_malloc (n, sizeof (XEntry), Common) ;
+    W = KLU_malloc (n, sizeof (double), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Rz, n, sizeof (XEntry), Common) ;
+        KLU_free (Xlast, n, sizeof (XEntry), Common) ;
+        KLU_free (W, n, sizeof (double), Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve and refine each right-hand-side */
+    /* ---------------------------------------------------------------------- */
+
+    maxberr = 0 ;
+    ok = TRUE ;
+    for (k = 0 ; ok && k < nrhs ; k++)
+    {
+        b = Bz + d*k ;
+        x = Xz + d*k ;
+
+        /* x = A\b */
+        for (i = 0 ; i < n ; i++)
+        {
+            x [i] = b [i] ;
+        }
+        ok = KLU_solve (Symbolic, Numeric, n, 1, (double *) x, Common) ;
+
+        berr = 0 ;
+        lastberr = 0 ;
+        for (step = 0 ; ok ; step++)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* r = b - A*x and W = |b| + |A|*|x| */
+            /* -------------------------------------------------------------- */
+
+            for (i = 0 ; i < n ; i++)
+            {
+                Rz [i] = b [i] ;
+                ABS (W [i], b [i]) ;
+            }
+            for (j = 0 ; j < n ; j++)
+            {
+                xj = x [j] ;
+                ABS (xabs, xj) ;
+                for (p = Ap [j] ; p < Ap [j+1] ; p++)
+                {
+                    i = Ai [p] ;
+                    /* Rz [i] -= Az [p] * xj */
+                    MULT_SUB (Rz [i], Az [p], xj) ;
+                    ABS (aabs, Az [p]) ;
+                    W [i] += aabs * xabs ;
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* berr = max (|r| ./ W) */
+            /* -------------------------------------------------------------- */
+
+            berr = 0 ;
+            for (i = 0 ; i < n ; i++)
+            {
+                if (W [i] > 0)
+                {
+                    ABS (aabs, Rz [i]) ;
+                    berr = MAX (berr, aabs / W [i]) ;
+                }
+            }
+            if (step > 0 && !(berr <= lastberr / 2))
+            {
+                /* the last step did not help; go back to the prior x */
+                for (i = 0 ; i < n ; i++)
+                {
+                    x [i] = Xlast [i] ;
+                }
+                berr = lastberr ;
+                break ;
+            }
+            if (step == irstep || berr <= DBL_EPSILON)
+            {
+                break ;
+            }
+            lastberr = berr ;
+
+            /* -------------------------------------------------------------- */
+            /* x = x + A\r */
+            /* -------------------------------------------------------------- */
+
+            ok = KLU_solve (Symbolic, Numeric, n, 1, (double *) Rz, Common) ;
+            for (i = 0 ; ok && i < n ; i++)
+            {
+                Xlast [i] = x [i] ;
+                ASSEMBLE (x [i], Rz [i]) ;
+            }
+        }
+        maxberr = MAX (maxberr, berr) ;
+    }
+
+    Common->berr = ok ? maxberr : 0 ;
+    KLU_free (Rz, n, sizeof (XEntry), Common) ;
+    KLU_free (Xlast, n, sizeof (XEntry), Common) ;
+    KLU_free (W, n, sizeof (double), Common) ;
+    return (ok) ;
+}
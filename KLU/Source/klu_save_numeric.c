@@ -0,0 +1,501 @@
+/* ========================================================================== */
+/* === KLU_save_numeric ===================================================== */
+/* ========================================================================== */
+
+/* Write a Numeric object to a binary file (KLU_save_numeric), and load it
+ * back in (KLU_load_numeric).
+ *
+ * The layout of the file is described in klu_internal.h:  a header, and then
+ * each array of the Numeric object, starting at a multiple of KLU_FILE_ALIGN
+ * bytes.  KLU_load_numeric maps the file into memory and points the Numeric
+ * object into the mapping, so that loading takes little time, the pages are
+ * read from the file only when they are first used, and all processes that
+ * load the same file share a single copy of the factors in memory.  The
+ * mapping is private and writable, so KLU_refactor can still modify the
+ * factors; the pages it modifies are copied, and the file is never changed.
+ * The file must not be changed or truncated while it is mapped, however, since
+ * the pages not yet read are taken from the file when they are first used.
+ * If the file cannot be mapped (or if NPOSIX is defined), it is read into a
+ * single malloc'd block instead.
+ *
+ * Only the scale factors Rs, the array of pointers LUbx, the workspace, and the
+ * level sets (if any) are allocated separately, since KLU_refactor may free and
+ * reallocate Rs, and the rest are different for each process.
+ */
+
+/* fileno is POSIX, not ANSI C */
+#if !defined (NPOSIX) && !defined (_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "klu_internal.h"
+#include <string.h>
+#ifndef NPOSIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+/* ========================================================================== */
+/* === write_array ========================================================== */
+/* ========================================================================== */
+
+/* Pad the file with zeros up to offset, and then write nbytes bytes of X. */
+
+static Int write_array      /* returns TRUE if successful, FALSE otherwise */
+(
+    FILE *f,
+    const void *X,
+    size_t nbytes,
+    SuiteSparse_long offset,
+    SuiteSparse_long *pos       /* current position in the file */
+)
+{
+    static const char zeros [KLU_FILE_ALIGN] ;
+    size_t npad ;
+
+    npad = (size_t) (offset - *pos) ;
+    ASSERT (npad < KLU_FILE_ALIGN) ;
+    if (npad > 0 && fwrite (zeros, 1, npad, f) != npad)
+    {
+        return (FALSE) ;
+    }
+    if (nbytes > 0 && fwrite (X, 1, nbytes, f) != nbytes)
+    {
+        return (FALSE) ;
+    }
+    *pos = offset + (SuiteSparse_long) nbytes ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === numeric_sizes ======================================================== */
+/* ========================================================================== */
+
+/* Size in bytes of the first KLU_FILE_NOBJECTS-1 arrays in the file, in the
+ * order they appear (Rs is empty if the matrix was not scaled). */
+
+static void numeric_sizes
+(
+    Int n,
+    Int nblocks,
+    Int nzoff,
+    Int scaled,
+    SuiteSparse_long nbytes [ ]
+)
+{
+    Int k ;
+    for (k = 0 ; k < 6 ; k++)
+    {
+        /* Pnum, Pinv, Lip, Uip, Llen, and Ulen */
+        nbytes [k] = ((SuiteSparse_long) n) * sizeof (Int) ;
+    }
+    nbytes [6]  = ((SuiteSparse_long) nblocks) * sizeof (size_t) ;
+    nbytes [7]  = ((SuiteSparse_long) n) * sizeof (Entry) ;
+    nbytes [8]  = scaled ? (((SuiteSparse_long) n) * sizeof (double)) : 0 ;
+    nbytes [9]  = ((SuiteSparse_long) n+1) * sizeof (Int) ;
+    nbytes [10] = ((SuiteSparse_long) nzoff) * sizeof (Int) ;
+    nbytes [11] = ((SuiteSparse_long) nzoff) * sizeof (Entry) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_save_numeric ===================================================== */
+/* ========================================================================== */
+
+Int KLU_save_numeric        /* returns TRUE if successful, FALSE otherwise */
+(
+    KLU_numeric *Numeric,
+    const char *filename,
+    KLU_common *Common
+)
+{
+    KLU_numeric_header Header ;
+    SuiteSparse_long nbytes [KLU_FILE_NOBJECTS], pos ;
+    void *Object [KLU_FILE_NOBJECTS] ;
+    Unit **LUbx ;
+    size_t lusize ;
+    Int k, block, n, nblocks, ok ;
+    FILE *f ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Numeric == NULL || filename == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    n = Numeric->n ;
+    nblocks = Numeric->nblocks ;
+    LUbx = (Unit **) Numeric->LUbx ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the header, and find the offset of each array */
+    /* ---------------------------------------------------------------------- */
+
+    memset (&Header, 0, sizeof (KLU_numeric_header)) ;
+    strncpy (Header.id, KLU_NUMERIC_ID, 16) ;
+    Header.sizeof_int = sizeof (Int) ;
+    Header.sizeof_entry = sizeof (Entry) ;
+    Header.sizeof_unit = sizeof (Unit) ;
+    Header.n = n ;
+    Header.nblocks = nblocks ;
+    Header.nzoff = Numeric->nzoff ;
+    Header.lnz = Numeric->lnz ;
+    Header.unz = Numeric->unz ;
+    Header.max_lnz_block = Numeric->max_lnz_block ;
+    Header.max_unz_block = Numeric->max_unz_block ;
+
+    numeric_sizes (n, nblocks, Numeric->nzoff, Numeric->Rs != NULL, nbytes) ;
+    Object [0]  = Numeric->Pnum ;
+    Object [1]  = Numeric->Pinv ;
+    Object [2]  = Numeric->Lip ;
+    Object [3]  = Numeric->Uip ;
+    Object [4]  = Numeric->Llen ;
+    Object [5]  = Numeric->Ulen ;
+    Object [6]  = NULL ;            /* LUsize is written below */
+    Object [7]  = Numeric->Udiag ;
+    Object [8]  = Numeric->Rs ;
+    Object [9]  = Numeric->Offp ;
+    Object [10] = Numeric->Offi ;
+    Object [11] = Numeric->Offx ;
+
+    pos = sizeof (KLU_numeric_header) ;
+    for (k = 0 ; k < KLU_FILE_NOBJECTS-1 ; k++)
+    {
+        if (k == 8 && Numeric->Rs == NULL)
+        {
+            /* the matrix was not scaled */
+            Header.offset [k] = EMPTY ;
+            continue ;
+        }
+        Header.offset [k] = KLU_FILE_ROUNDUP (pos) ;
+        pos = Header.offset [k] + nbytes [k] ;
+    }
+
+    /* LUbx [block] is NULL for a block of size 1, whose LUsize is not set */
+    Header.offset [KLU_FILE_NOBJECTS-1] = KLU_FILE_ROUNDUP (pos) ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        if (LUbx [block] != NULL)
+        {
+            pos = KLU_FILE_ROUNDUP (pos) +
+                Numeric->LUsize [block] * sizeof (Unit) ;
+        }
+    }
+    Header.file_size = pos ;
+
+    /* ---------------------------------------------------------------------- */
+    /* write the file */
+    /* ---------------------------------------------------------------------- */
+
+    f = fopen (filename, "wb") ;
+    if (f == NULL)
+    {
+        Common->status = KLU_FILE_IO ;
+        return (FALSE) ;
+    }
+
+    pos = 0 ;
+    ok = write_array (f, &Header, sizeof (KLU_numeric_header), 0, &pos) ;
+    for (k = 0 ; ok && k < KLU_FILE_NOBJECTS-1 ; k++)
+    {
+        if (k == 6)
+        {
+            /* LUsize, with zero for each block of size 1 */
+            ok = write_array (f, NULL, 0, Header.offset [k], &pos) ;
+            for (block = 0 ; ok && block < nblocks ; block++)
+            {
+                lusize = (LUbx [block] == NULL) ? 0 : Numeric->LUsize [block] ;
+                ok = (fwrite (&lusize, sizeof (size_t), 1, f) == 1) ;
+            }
+            pos += nbytes [k] ;
+        }
+        else if (Header.offset [k] != EMPTY)
+        {
+            ok = write_array (f, Object [k], (size_t) nbytes [k],
+                Header.offset [k], &pos) ;
+        }
+    }
+    for (block = 0 ; ok && block < nblocks ; block++)
+    {
+        if (LUbx [block] != NULL)
+        {
+            ok = write_array (f, LUbx [block],
+                Numeric->LUsize [block] * sizeof (Unit),
+                KLU_FILE_ROUNDUP (pos), &pos) ;
+        }
+    }
+    ASSERT (!ok || pos == Header.file_size) ;
+
+    if (fclose (f) != 0 || !ok)
+    {
+        Common->status = KLU_FILE_IO ;
+        return (FALSE) ;
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_load_numeric ===================================================== */
+/* ========================================================================== */
+
+KLU_numeric *KLU_load_numeric   /* returns NULL if error */
+(
+    const char *filename,
+    KLU_symbolic *Symbolic,
+    KLU_common *Common
+)
+{
+    KLU_numeric_header Header ;
+    KLU_numeric *Numeric ;
+    SuiteSparse_long nbytes [KLU_FILE_NOBJECTS], offset ;
+    size_t s, n3, b6, nunits, *LUsize ;
+    void *Mapping ;
+    char *base ;
+    Int k, block, n, nblocks, maxblock, mapped, ok ;
+    FILE *f ;
+#ifndef NPOSIX
+    struct stat st ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (NULL) ;
+    }
+    if (Symbolic == NULL || filename == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+    Common->status = KLU_OK ;
+
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+
+    /* ---------------------------------------------------------------------- */
+    /* read and check the file header */
+    /* ---------------------------------------------------------------------- */
+
+    f = fopen (filename, "rb") ;
+    if (f == NULL)
+    {
+        Common->status = KLU_FILE_IO ;
+        return (NULL) ;
+    }
+    if (fread (&Header, sizeof (KLU_numeric_header), 1, f) != 1)
+    {
+        fclose (f) ;
+        Common->status = KLU_FILE_IO ;
+        return (NULL) ;
+    }
+
+    if (strncmp (Header.id, KLU_NUMERIC_ID, 16) != 0
+        || Header.sizeof_int != sizeof (Int)
+        || Header.sizeof_entry != sizeof (Entry)
+        || Header.sizeof_unit != sizeof (Unit)
+        || Header.n != n || Header.nblocks != nblocks
+        || Header.nzoff != Symbolic->nzoff
+        || Header.offset [0] != KLU_FILE_ROUNDUP (sizeof (KLU_numeric_header))
+        || Header.file_size < Header.offset [0])
+    {
+        /* not a Numeric object of this kind, for this Symbolic object */
+        fclose (f) ;
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* map the file into memory, or read it in if it cannot be mapped */
+    /* ---------------------------------------------------------------------- */
+
+    Mapping = NULL ;
+    mapped = FALSE ;
+
+#ifndef NPOSIX
+    if (fstat (fileno (f), &st) == 0 && st.st_size == Header.file_size)
+    {
+        Mapping = mmap (NULL, (size_t) Header.file_size,
+            PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno (f), 0) ;
+        mapped = (Mapping != MAP_FAILED) ;
+        if (!mapped)
+        {
+            Mapping = NULL ;
+        }
+    }
+#endif
+
+    nunits = (((size_t) Header.file_size) + sizeof (Unit) - 1) / sizeof (Unit);
+    if (!mapped)
+    {
+        Mapping = KLU_malloc (nunits, sizeof (Unit), Common) ;
+        if (Common->status < KLU_OK)
+        {
+            fclose (f) ;
+            return (NULL) ;
+        }
+        base = (char *) Mapping ;
+        memcpy (base, &Header, sizeof (KLU_numeric_header)) ;
+        s = ((size_t) Header.file_size) - sizeof (KLU_numeric_header) ;
+        if (fread (base + sizeof (KLU_numeric_header), 1, s, f) != s)
+        {
+            KLU_free (Mapping, nunits, sizeof (Unit), Common) ;
+            fclose (f) ;
+            Common->status = KLU_FILE_IO ;
+            return (NULL) ;
+        }
+    }
+
+    /* the file is no longer needed (a mapping persists after fclose) */
+    fclose (f) ;
+    base = (char *) Mapping ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the Numeric object */
+    /* ---------------------------------------------------------------------- */
+
+    Numeric = KLU_malloc (1, sizeof (KLU_numeric), Common) ;
+    if (Common->status < KLU_OK)
+    {
+#ifndef NPOSIX
+        if (mapped)
+        {
+            (void) munmap (Mapping, (size_t) Header.file_size) ;
+        }
+        else
+#endif
+        {
+            KLU_free (Mapping, nunits, sizeof (Unit), Common) ;
+        }
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    memset (Numeric, 0, sizeof (KLU_numeric)) ;
+    Numeric->n = n ;
+    Numeric->nblocks = nblocks ;
+    Numeric->nzoff = Header.nzoff ;
+    Numeric->lnz = Header.lnz ;
+    Numeric->unz = Header.unz ;
+    Numeric->max_lnz_block = Header.max_lnz_block ;
+    Numeric->max_unz_block = Header.max_unz_block ;
+    Numeric->Mapping = Mapping ;
+    Numeric->mapping_size = mapped ? ((size_t) Header.file_size) :
+        (nunits * sizeof (Unit)) ;
+    Numeric->mapped = mapped ;
+
+    /* KLU_free_numeric can now be safely called if an error occurs */
+
+    /* ---------------------------------------------------------------------- */
+    /* check the location of each array, and point to it in the file */
+    /* ---------------------------------------------------------------------- */
+
+    numeric_sizes (n, nblocks, Header.nzoff, Header.offset [8] != EMPTY,
+        nbytes) ;
+    ok = TRUE ;
+    for (k = 0 ; ok && k < KLU_FILE_NOBJECTS-1 ; k++)
+    {
+        offset = Header.offset [k] ;
+        ok = (k == 8 && offset == EMPTY) || (offset > 0
+            && offset % KLU_FILE_ALIGN == 0
+            && offset + nbytes [k] <= Header.file_size) ;
+    }
+
+    /* the blocks of LU follow the other arrays */
+    LUsize = (size_t *) (base + Header.offset [6]) ;
+    offset = Header.offset [KLU_FILE_NOBJECTS-1] ;
+    ok = ok && offset == KLU_FILE_ROUNDUP (Header.offset [11] + nbytes [11]) ;
+    for (block = 0 ; ok && block < nblocks ; block++)
+    {
+        if (LUsize [block] > 0)
+        {
+            offset = KLU_FILE_ROUNDUP (offset) ;
+            ok = (LUsize [block] < (size_t) Int_MAX) &&
+                (offset + (SuiteSparse_long) (LUsize [block] * sizeof (Unit))
+                <= Header.file_size) ;
+            offset += LUsize [block] * sizeof (Unit) ;
+        }
+    }
+
+    if (!ok)
+    {
+        /* the file is truncated or corrupted */
+        KLU_free_numeric (&Numeric, Common) ;
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    Numeric->Pnum   = (Int *) (base + Header.offset [0]) ;
+    Numeric->Pinv   = (Int *) (base + Header.offset [1]) ;
+    Numeric->Lip    = (Int *) (base + Header.offset [2]) ;
+    Numeric->Uip    = (Int *) (base + Header.offset [3]) ;
+    Numeric->Llen   = (Int *) (base + Header.offset [4]) ;
+    Numeric->Ulen   = (Int *) (base + Header.offset [5]) ;
+    Numeric->LUsize = LUsize ;
+    Numeric->Udiag  = (void *) (base + Header.offset [7]) ;
+    Numeric->Offp   = (Int *) (base + Header.offset [9]) ;
+    Numeric->Offi   = (Int *) (base + Header.offset [10]) ;
+    Numeric->Offx   = (void *) (base + Header.offset [11]) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate LUbx, Rs, and the workspace, as in KLU_factor */
+    /* ---------------------------------------------------------------------- */
+
+    Numeric->LUbx = KLU_malloc (nblocks, sizeof (Unit *), Common) ;
+    if (Header.offset [8] != EMPTY)
+    {
+        Numeric->Rs = KLU_malloc (n, sizeof (double), Common) ;
+    }
+    ok = TRUE ;
+    s = KLU_mult_size_t (n, sizeof (XEntry), &ok) ;
+    n3 = KLU_mult_size_t (n, 3 * sizeof (XEntry), &ok) ;
+    b6 = KLU_mult_size_t (maxblock, 6 * sizeof (Int), &ok) ;
+    Numeric->worksize = KLU_add_size_t (s, MAX (n3, b6), &ok) ;
+    Numeric->Work = KLU_malloc (Numeric->worksize, 1, Common) ;
+    Numeric->Xwork = Numeric->Work ;
+    Numeric->Iwork = (Int *) ((XEntry *) Numeric->Xwork + n) ;
+    if (!ok || Common->status < KLU_OK)
+    {
+        /* out of memory or problem too large */
+        KLU_free_numeric (&Numeric, Common) ;
+        Common->status = ok ? KLU_OUT_OF_MEMORY : KLU_TOO_LARGE ;
+        return (NULL) ;
+    }
+
+    offset = Header.offset [KLU_FILE_NOBJECTS-1] ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        if (LUsize [block] > 0)
+        {
+            offset = KLU_FILE_ROUNDUP (offset) ;
+            Numeric->LUbx [block] = (void *) (base + offset) ;
+            offset += LUsize [block] * sizeof (Unit) ;
+        }
+        else
+        {
+            Numeric->LUbx [block] = NULL ;
+        }
+    }
+    if (Numeric->Rs != NULL)
+    {
+        memcpy (Numeric->Rs, base + Header.offset [8], n * sizeof (double)) ;
+    }
+
+    /* level sets for a multithreaded solve, if requested, as in KLU_factor */
+    (void) KLU_levels (Symbolic, Numeric, Common) ;
+    return (Numeric) ;
+}
@@ -0,0 +1,184 @@
+/* ========================================================================== */
+/* === KLU_save_symbolic ==================================================== */
+/* ========================================================================== */
+
+/* Write a Symbolic object to a binary file (KLU_save_symbolic), and read it
+ * back in (KLU_load_symbolic).  The file holds an id string, the sizes of an
+ * Int and of the Symbolic object, the Symbolic object itself (whose pointers
+ * are ignored when it is read back in), and then the arrays P, Q, R, and Lnz.
+ * A Symbolic object is small compared with the Numeric object, so it is read
+ * into malloc'd space rather than being mapped into memory.
+ */
+
+#include "klu_internal.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* === KLU_save_symbolic ==================================================== */
+/* ========================================================================== */
+
+Int KLU_save_symbolic       /* returns TRUE if successful, FALSE otherwise */
+(
+    KLU_symbolic *Symbolic,
+    const char *filename,
+    KLU_common *Common
+)
+{
+    char id [16] ;
+    Int sizes [2], n, ok ;
+    FILE *f ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Symbolic == NULL || filename == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    f = fopen (filename, "wb") ;
+    if (f == NULL)
+    {
+        Common->status = KLU_FILE_IO ;
+        return (FALSE) ;
+    }
+
+    memset (id, 0, 16) ;
+    strncpy (id, KLU_SYMBOLIC_ID, 16) ;
+    sizes [0] = sizeof (Int) ;
+    sizes [1] = sizeof (KLU_symbolic) ;
+    n = Symbolic->n ;
+    ok = fwrite (id, 1, 16, f) == 16
+        && fwrite (sizes, sizeof (Int), 2, f) == 2
+        && fwrite (Symbolic, sizeof (KLU_symbolic), 1, f) == 1
+        && fwrite (Symbolic->P, sizeof (Int), n, f) == (size_t) n
+        && fwrite (Symbolic->Q, sizeof (Int), n, f) == (size_t) n
+        && fwrite (Symbolic->R, sizeof (Int), n+1, f) == (size_t) (n+1)
+        && fwrite (Symbolic->Lnz, sizeof (double), n, f) == (size_t) n ;
+
+    if (fclose (f) != 0 || !ok)
+    {
+        Common->status = KLU_FILE_IO ;
+        return (FALSE) ;
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_load_symbolic ==================================================== */
+/* ========================================================================== */
+
+KLU_symbolic *KLU_load_symbolic     /* returns NULL if error */
+(
+    const char *filename,
+    KLU_common *Common
+)
+{
+    char id [16] ;
+    KLU_symbolic *Symbolic ;
+    Int sizes [2], n, nblocks, ok ;
+    FILE *f ;
+
+    if (Common == NULL)
+    {
+        return (NULL) ;
+    }
+    if (filename == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+    Common->status = KLU_OK ;
+
+    f = fopen (filename, "rb") ;
+    if (f == NULL)
+    {
+        Common->status = KLU_FILE_IO ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* read and check the id and the sizes */
+    /* ---------------------------------------------------------------------- */
+
+    if (fread (id, 1, 16, f) != 16 || fread (sizes, sizeof (Int), 2, f) != 2)
+    {
+        fclose (f) ;
+        Common->status = KLU_FILE_IO ;
+        return (NULL) ;
+    }
+    if (strncmp (id, KLU_SYMBOLIC_ID, 16) != 0 || sizes [0] != sizeof (Int)
+        || sizes [1] != sizeof (KLU_symbolic))
+    {
+        /* not a Symbolic object written by this version of KLU */
+        fclose (f) ;
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* read the Symbolic object */
+    /* ---------------------------------------------------------------------- */
+
+    Symbolic = KLU_malloc (1, sizeof (KLU_symbolic), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        fclose (f) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    ok = (fread (Symbolic, sizeof (KLU_symbolic), 1, f) == 1) ;
+
+    /* none of the pointers in the file are valid */
+    Symbolic->P = NULL ;
+    Symbolic->Q = NULL ;
+    Symbolic->R = NULL ;
+    Symbolic->Lnz = NULL ;
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+
+    if (!ok || n <= 0 || nblocks <= 0 || nblocks > n
+        || Symbolic->maxblock <= 0 || Symbolic->maxblock > n)
+    {
+        /* truncated file, or corrupted Symbolic object */
+        KLU_free (Symbolic, 1, sizeof (KLU_symbolic), Common) ;
+        fclose (f) ;
+        Common->status = ok ? KLU_INVALID : KLU_FILE_IO ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* read the arrays */
+    /* ---------------------------------------------------------------------- */
+
+    /* KLU_free_symbolic can now be safely called if an error occurs */
+    Symbolic->P = KLU_malloc (n, sizeof (Int), Common) ;
+    Symbolic->Q = KLU_malloc (n, sizeof (Int), Common) ;
+    Symbolic->R = KLU_malloc (n+1, sizeof (Int), Common) ;
+    Symbolic->Lnz = KLU_malloc (n, sizeof (double), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free_symbolic (&Symbolic, Common) ;
+        fclose (f) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+
+    ok = fread (Symbolic->P, sizeof (Int), n, f) == (size_t) n
+        && fread (Symbolic->Q, sizeof (Int), n, f) == (size_t) n
+        && fread (Symbolic->R, sizeof (Int), n+1, f) == (size_t) (n+1)
+        && fread (Symbolic->Lnz, sizeof (double), n, f) == (size_t) n ;
+    fclose (f) ;
+
+    if (!ok || Symbolic->R [0] != 0 || Symbolic->R [nblocks] != n)
+    {
+        KLU_free_symbolic (&Symbolic, Common) ;
+        Common->status = ok ? KLU_INVALID : KLU_FILE_IO ;
+        return (NULL) ;
+    }
+    return (Symbolic) ;
+}
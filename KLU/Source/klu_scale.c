@@ -33,7 +33,7 @@ Int KLU_scale           /* return TRUE if successful, FALSE otherwise */
 )
 {
     double a ;
-    Entry *Az ;
+    XEntry *Az ;
     Int row, col, p, pend, check_duplicates ;
 
     /* ---------------------------------------------------------------------- */
@@ -53,7 +53,7 @@ Int KLU_scale           /* return TRUE if successful, FALSE otherwise */
         return (TRUE) ;
     }
 
-    Az = (Entry *) Ax ;
+    Az = (XEntry *) Ax ;
 
     if (n <= 0 || Ap == NULL || Ai == NULL || Az == NULL ||
         (scale > 0 && Rs == NULL))
@@ -0,0 +1,148 @@
+/* ========================================================================== */
+/* === KLU_schedule ========================================================= */
+/* ========================================================================== */
+
+/* Determine how many threads KLU_factor and KLU_refactor should use to
+ * factorize the diagonal blocks of the BTF form, and the order in which the
+ * blocks are handed out to the threads.  Not user callable.
+ *
+ * The diagonal blocks are independent of each other, once the off-diagonal
+ * entries have been set aside, so they can be factorized in any order.  The
+ * blocks are sorted by decreasing size (largest first), so that the largest
+ * blocks start early and the many small blocks (and singletons) fill in the
+ * gaps at the end.  The sort is stable, so blocks of the same size keep their
+ * BTF order.
+ *
+ * Returns the number of threads to use.  If this is 1, *p_Order is NULL and
+ * the blocks should be factorized in BTF order, as usual.  Otherwise,
+ * *p_Order is an array of size nblocks containing the block schedule, which
+ * the caller must free with KLU_free.  A threaded factorization is not used
+ * if KLU is not compiled with OpenMP, if Common->nthreads is 1, if fewer
+ * than two blocks are larger than 1-by-1, or if the workspace cannot be
+ * allocated (in which case Common->status is left unchanged).
+ */
+
+#include "klu_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* ========================================================================== */
+/* === KLU_threads ========================================================== */
+/* ========================================================================== */
+
+/* Returns the number of threads requested by Common->nthreads:  the value
+ * itself if positive, or the OpenMP default if zero or negative.  Always 1 if
+ * KLU is not compiled with OpenMP. */
+
+Int KLU_threads
+(
+    KLU_common *Common
+)
+{
+    Int nthreads ;
+    nthreads = Common->nthreads ;
+#ifdef _OPENMP
+    if (nthreads <= 0)
+    {
+        nthreads = omp_get_max_threads ( ) ;
+    }
+#else
+    /* KLU is not compiled with OpenMP */
+    nthreads = 1 ;
+#endif
+    return (MAX (nthreads, 1)) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_schedule ========================================================= */
+/* ========================================================================== */
+
+Int KLU_schedule        /* returns # of threads to use */
+(
+    /* inputs, not modified */
+    Int nblocks,        /* # of blocks in the BTF form */
+    Int R [ ],          /* size nblocks+1, block boundaries */
+    Int maxblock,       /* size of the largest block */
+    /* output */
+    Int **p_Order,      /* size nblocks, block schedule (if threads used) */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    Int *Order, *Head ;
+    Int nthreads, nbig, block, nk, k, status ;
+
+    *p_Order = NULL ;
+
+    /* ---------------------------------------------------------------------- */
+    /* determine the number of threads to use */
+    /* ---------------------------------------------------------------------- */
+
+    nthreads = KLU_threads (Common) ;
+    if (nthreads <= 1)
+    {
+        return (1) ;
+    }
+
+    /* singletons are too cheap to be worth a thread on their own */
+    nbig = 0 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        if (R [block+1] - R [block] > 1)
+        {
+            nbig++ ;
+        }
+    }
+    nthreads = MIN (nthreads, nbig) ;
+    if (nthreads <= 1)
+    {
+        return (1) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* sort the blocks by decreasing size */
+    /* ---------------------------------------------------------------------- */
+
+    status = Common->status ;
+    Order = KLU_malloc (nblocks, sizeof (Int), Common) ;
+    Head = KLU_malloc (maxblock+2, sizeof (Int), Common) ;
+    if (Order == NULL || Head == NULL)
+    {
+        /* out of memory; use a single thread instead */
+        KLU_free (Order, nblocks, sizeof (Int), Common) ;
+        KLU_free (Head, maxblock+2, sizeof (Int), Common) ;
+        Common->status = status ;
+        return (1) ;
+    }
+
+    /* count the blocks of each size, largest size first */
+    for (k = 0 ; k <= maxblock+1 ; k++)
+    {
+        Head [k] = 0 ;
+    }
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        nk = R [block+1] - R [block] ;
+        ASSERT (nk >= 1 && nk <= maxblock) ;
+        Head [maxblock - nk + 1]++ ;
+    }
+
+    /* cumulative sum: Head [maxblock-nk] is where blocks of size nk start */
+    for (k = 1 ; k <= maxblock+1 ; k++)
+    {
+        Head [k] += Head [k-1] ;
+    }
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        nk = R [block+1] - R [block] ;
+        Order [Head [maxblock - nk]++] = block ;
+    }
+
+    KLU_free (Head, maxblock+2, sizeof (Int), Common) ;
+    *p_Order = Order ;
+
+    return (nthreads) ;
+}
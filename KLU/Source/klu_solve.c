@@ -5,8 +5,9 @@
 /* Solve Ax=b using the symbolic and numeric objects from KLU_analyze
  * (or KLU_analyze_given) and KLU_factor.  Note that no iterative refinement is
  * performed.  Uses Numeric->Xwork as workspace (undefined on input and output),
- * of size 4n Entry's (note that columns 2 to 4 of Xwork overlap with
- * Numeric->Iwork).
+ * of size 4n XEntry's (note that columns 2 to 4 of Xwork overlap with
+ * Numeric->Iwork).  If KLU_factor computed level sets (Common->nthreads not
+ * 1), the solve is done in parallel with KLU_level_solve instead.
  */
 
 #include "klu_internal.h"
@@ -26,9 +27,11 @@ Int KLU_solve
     KLU_common *Common
 )
 {
-    Entry x [4], offik, s ;
+    XEntry x [4] ;
+    Entry offik, s ;
     double rs, *Rs ;
-    Entry *Offx, *X, *Bz, *Udiag ;
+    XEntry *X, *Bz ;
+    Entry *Offx, *Udiag ;
     Int *Q, *R, *Pnum, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen ;
     Unit **LUbx ;
     Int k1, k2, nk, k, block, pend, n, p, nblocks, chunk, nr, i ;
@@ -49,11 +52,27 @@ Int KLU_solve
     }
     Common->status = KLU_OK ;
 
+#ifdef _OPENMP
+    /* ---------------------------------------------------------------------- */
+    /* solve with the level sets in parallel, if KLU_factor computed them */
+    /* ---------------------------------------------------------------------- */
+
+    if (Numeric->Levels != NULL && KLU_threads (Common) > 1)
+    {
+        KLU_level_solve (Symbolic, Numeric, d, nrhs, B, FALSE,
+#ifdef COMPLEX
+            FALSE,
+#endif
+            KLU_threads (Common)) ;
+        return (TRUE) ;
+    }
+#endif
+
     /* ---------------------------------------------------------------------- */
     /* get the contents of the Symbolic object */
     /* ---------------------------------------------------------------------- */
 
-    Bz = (Entry *) B ;
+    Bz = (XEntry *) B ;
     n = Symbolic->n ;
     nblocks = Symbolic->nblocks ;
     Q = Symbolic->Q ;
@@ -77,7 +96,7 @@ Int KLU_solve
     Udiag = Numeric->Udiag ;
 
     Rs = Numeric->Rs ;
-    X = (Entry *) Numeric->Xwork ;
+    X = (XEntry *) Numeric->Xwork ;
 
     ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
 
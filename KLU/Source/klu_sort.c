@@ -152,5 +152,16 @@ Int KLU_sort
     KLU_free (Tp, m1, sizeof (Int), Common) ;
     KLU_free (Ti, nz, sizeof (Int), Common) ;
     KLU_free (Tx, nz, sizeof (Entry), Common) ;
+
+    /* the level sets refer to the old positions of the entries of L and U,
+     * and so does any Batch object made from Numeric */
+    if (Common->status == KLU_OK)
+    {
+        Numeric->generation++ ;
+        if (Numeric->Levels != NULL)
+        {
+            (void) KLU_levels (Symbolic, Numeric, Common) ;
+        }
+    }
     return (Common->status == KLU_OK) ;
 }
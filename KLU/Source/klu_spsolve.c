@@ -0,0 +1,437 @@
+/* ========================================================================== */
+/* === KLU_spsolve ========================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b where b is sparse, returning x as a sparse vector, using the
+ * Symbolic and Numeric objects from KLU_analyze and KLU_factor.  Only the
+ * parts of the factors needed to compute the nonzeros of x are used.
+ *
+ * The permuted system is solved one block of the BTF form at a time, from the
+ * last block to the first, just as in KLU_solve.  A block is needed if a
+ * nonzero of b lies in it, or if it is updated through the off-diagonal part
+ * by a block that is needed.  Each diagonal block of the BTF form is
+ * irreducible, so the solution of a needed block is (structurally) nonzero in
+ * every row, and every column of the off-diagonal part in that block is used.
+ * The needed blocks are thus found by a depth-first search of the graph of
+ * the blocks, which also gives an order in which to solve them.  Within each
+ * needed block, the nonzero pattern of L\b is found by a depth-first search in
+ * the graph of L, and the pattern of U\(L\b) by a search in the graph of U,
+ * as in the Gilbert/Peierls left-looking LU (see klu_kernel.c).  This also
+ * handles the case where BTF is not used, and A is a single block that need
+ * not be irreducible.
+ *
+ * Uses Numeric->Xwork as workspace (the first n XEntry's for x, and 3n
+ * integers in Numeric->Iwork), and Numeric->Spwork, of size 3n+2*nblocks
+ * integers, which is allocated by the first call.  Part of Spwork (the block
+ * of each row, the Mark and the Head arrays) is kept from one call to the
+ * next, and Mark and Head are restored to their initial state on return.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === dfs ================================================================== */
+/* ========================================================================== */
+
+/* Depth-first search from node j (local to the block that starts at k1) in
+ * the graph of L or U.  The nodes of the block with Mark [k1+i] < mark have
+ * not yet been visited; visited nodes are marked with mark.  A node new to
+ * the pattern of x (Mark 0) has its entry in X cleared.  The nodes are placed
+ * in Out [nout ...] in postorder, as global indices.  Returns the new nout. */
+
+static Int dfs
+(
+    Int j,              /* node to start the search at */
+    Int k1,             /* first row of the block */
+    Int mark,           /* 2 for the search in L, 3 for U */
+    Unit *LU,           /* LU factors of the block */
+    Int Xip [ ],        /* Lip or Uip for the block */
+    Int Xlen [ ],       /* Llen or Ulen for the block */
+    XEntry X [ ],
+    Int Mark [ ],
+    Int Stack [ ],      /* size nk, workspace */
+    Int Pos [ ],        /* size nk, workspace */
+    Int Out [ ],        /* output */
+    Int nout
+)
+{
+    Int i, p, head, len, done, *Xi ;
+
+    head = 0 ;
+    Stack [0] = j ;
+    while (head >= 0)
+    {
+        j = Stack [head] ;
+        if (Mark [k1+j] < mark)
+        {
+            /* first time that j has been visited */
+            if (Mark [k1+j] == 0)
+            {
+                /* X [k1+j] = 0 */
+                CLEAR (X [k1+j]) ;
+            }
+            Mark [k1+j] = mark ;
+            Pos [j] = 0 ;
+        }
+        GET_I_POINTER (LU, Xip, Xi, j) ;
+        len = Xlen [j] ;
+        done = TRUE ;
+        for (p = Pos [j] ; p < len ; p++)
+        {
+            i = Xi [p] ;
+            if (Mark [k1+i] < mark)
+            {
+                /* descend to node i, and continue with node j later */
+                Pos [j] = p+1 ;
+                Stack [++head] = i ;
+                done = FALSE ;
+                break ;
+            }
+        }
+        if (done)
+        {
+            /* all descendants of j have been visited */
+            head-- ;
+            Out [nout++] = k1+j ;
+        }
+    }
+    return (nout) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_spsolve ========================================================== */
+/* ========================================================================== */
+
+Int KLU_spsolve         /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int bnz,                /* number of entries in b */
+    Int Bi [ ],             /* size bnz, row indices of b */
+    double Bx [ ],          /* size bnz, numerical values of b */
+
+    /* outputs */
+    Int *xnz,               /* number of entries in x */
+    Int Xi [ ],             /* size n, row indices of x */
+    double Xx [ ],          /* size n, numerical values of x */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    XEntry xk, t, *X, *Bz, *Xz ;
+    Entry *Offx, *Udiag, *Lx, *Ux ;
+    double *Rs ;
+    Int *Q, *R, *Pinv, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen, *Li, *Ui,
+        *Block, *Mark, *Head, *Order, *Pos, *Next, *Lreach, *Stack ;
+    Unit *LU ;
+    Int n, nblocks, k, k1, k2, nk, block, c, top, head, done, i, j, p, pend,
+        nreach, nx, nx1, kk, len ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Numeric == NULL || Symbolic == NULL || bnz < 0 || xnz == NULL ||
+        Xi == NULL || Xx == NULL || (bnz > 0 && (Bi == NULL || Bx == NULL)))
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    n = Symbolic->n ;
+    for (p = 0 ; p < bnz ; p++)
+    {
+        if (Bi [p] < 0 || Bi [p] >= n)
+        {
+            /* row index out of range */
+            Common->status = KLU_INVALID ;
+            return (FALSE) ;
+        }
+    }
+    Common->status = KLU_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the contents of the Symbolic and Numeric objects */
+    /* ---------------------------------------------------------------------- */
+
+    nblocks = Symbolic->nblocks ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+
+    Pinv = Numeric->Pinv ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Offx = (Entry *) Numeric->Offx ;
+    Udiag = (Entry *) Numeric->Udiag ;
+    Rs = Numeric->Rs ;
+
+    Bz = (XEntry *) Bx ;
+    Xz = (XEntry *) Xx ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate and initialize Numeric->Spwork, if this is the first call */
+    /* ---------------------------------------------------------------------- */
+
+    if (Numeric->Spwork == NULL)
+    {
+        Numeric->Spwork = KLU_malloc (
+            3 * ((size_t) n) + 2 * ((size_t) nblocks), sizeof (Int), Common) ;
+        if (Common->status < KLU_OK)
+        {
+            Common->status = KLU_OUT_OF_MEMORY ;
+            return (FALSE) ;
+        }
+        Block = Numeric->Spwork ;
+        Mark = Block + n ;
+        Head = Mark + n ;
+        for (block = 0 ; block < nblocks ; block++)
+        {
+            for (k = R [block] ; k < R [block+1] ; k++)
+            {
+                Block [k] = block ;
+                Mark [k] = 0 ;
+            }
+            Head [block] = EMPTY ;
+        }
+    }
+
+    /* kept from one call to the next */
+    Block = Numeric->Spwork ;       /* size n, Block [k] is the block of row k */
+    Mark  = Block + n ;             /* size n, zero on input and output */
+    Head  = Mark + n ;              /* size nblocks, EMPTY on input/output */
+
+    /* workspace, undefined on input and output */
+    Order = Head + nblocks ;        /* size nblocks */
+    Pos   = Order + nblocks ;       /* size n */
+    X = (XEntry *) Numeric->Xwork ; /* size n */
+    Next   = Numeric->Iwork ;       /* size n */
+    Lreach = Next + n ;             /* size n */
+    Stack  = Lreach + n ;           /* size n */
+
+    /* ---------------------------------------------------------------------- */
+    /* find the blocks that are needed, in the order that they are solved */
+    /* ---------------------------------------------------------------------- */
+
+    /* Depth-first search of the graph of the blocks, with an edge from block c
+     * to each block updated by the off-diagonal part in block c.  A visited
+     * block is flagged with Head [c] = 0.  Order [0..head] is the stack, and
+     * the blocks are placed in Order [top..nblocks-1] in reverse postorder,
+     * which is a topological order.  Pos [c] is the position in Offi at which
+     * the search of block c continues. */
+
+    top = nblocks ;
+    for (p = 0 ; p < bnz ; p++)
+    {
+        block = Block [Pinv [Bi [p]]] ;
+        if (Head [block] != EMPTY)
+        {
+            continue ;
+        }
+        head = 0 ;
+        Order [0] = block ;
+        while (head >= 0)
+        {
+            c = Order [head] ;
+            if (Head [c] == EMPTY)
+            {
+                /* first time that block c has been visited */
+                Head [c] = 0 ;
+                Pos [c] = Offp [R [c]] ;
+            }
+            done = TRUE ;
+            pend = Offp [R [c+1]] ;
+            for (i = Pos [c] ; i < pend ; i++)
+            {
+                j = Block [Offi [i]] ;
+                if (Head [j] == EMPTY)
+                {
+                    /* descend to block j, and continue with block c later */
+                    Pos [c] = i+1 ;
+                    Order [++head] = j ;
+                    done = FALSE ;
+                    break ;
+                }
+            }
+            if (done)
+            {
+                /* all blocks updated by block c have been visited */
+                head-- ;
+                Order [--top] = c ;
+            }
+        }
+    }
+
+    /* Head [c] is now the head of a linked list of the rows of block c that
+     * are nonzero in the right-hand side of that block, linked by Next */
+    for (i = top ; i < nblocks ; i++)
+    {
+        Head [Order [i]] = EMPTY ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* scale and permute the right-hand side, X = P*(R\b) */
+    /* ---------------------------------------------------------------------- */
+
+    /* Mark [k] is 1 if row k is in the pattern of X (and X [k] is defined),
+     * 2 once it has been visited in L, and 3 once visited in U */
+    for (p = 0 ; p < bnz ; p++)
+    {
+        k = Pinv [Bi [p]] ;
+        if (Mark [k] == 0)
+        {
+            /* X [k] = 0, and place row k in the list of its block */
+            Mark [k] = 1 ;
+            CLEAR (X [k]) ;
+            block = Block [k] ;
+            Next [k] = Head [block] ;
+            Head [block] = k ;
+        }
+        if (Rs == NULL)
+        {
+            /* X [k] += b [i] */
+            ASSEMBLE (X [k], Bz [p]) ;
+        }
+        else
+        {
+            /* X [k] += b [i] / Rs [k] */
+            SCALE_DIV_ASSIGN (t, Bz [p], Rs [k]) ;
+            ASSEMBLE (X [k], t) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve X = (L*U + Off)\X, using only the blocks that are needed */
+    /* ---------------------------------------------------------------------- */
+
+    nx = 0 ;
+    for ( ; top < nblocks ; top++)
+    {
+        block = Order [top] ;
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        nx1 = nx ;
+
+        if (nk == 1)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* singleton block */
+            /* -------------------------------------------------------------- */
+
+            if (Head [block] != EMPTY)
+            {
+                DIV (X [k1], X [k1], Udiag [k1]) ;
+                Xi [nx++] = k1 ;
+            }
+
+        }
+        else
+        {
+
+            /* -------------------------------------------------------------- */
+            /* find the pattern of L\b and solve with L */
+            /* -------------------------------------------------------------- */
+
+            LU = ((Unit **) Numeric->LUbx) [block] ;
+            Lip  = Numeric->Lip  + k1 ;
+            Llen = Numeric->Llen + k1 ;
+            Uip  = Numeric->Uip  + k1 ;
+            Ulen = Numeric->Ulen + k1 ;
+            nreach = 0 ;
+            for (k = Head [block] ; k != EMPTY ; k = Next [k])
+            {
+                if (Mark [k] < 2)
+                {
+                    nreach = dfs (k - k1, k1, 2, LU, Lip, Llen, X,
+                        Mark, Stack, Pos, Lreach, nreach) ;
+                }
+            }
+            for (kk = nreach-1 ; kk >= 0 ; kk--)
+            {
+                j = Lreach [kk] - k1 ;
+                xk = X [k1+j] ;
+                GET_POINTER (LU, Lip, Llen, Li, Lx, j, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    /* X [Li [p]] -= Lx [p] * xk */
+                    MULT_SUB (X [k1 + Li [p]], Lx [p], xk) ;
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* find the pattern of U\(L\b) and solve with U */
+            /* -------------------------------------------------------------- */
+
+            /* the pattern of this block of x is placed in Xi [nx1..nx-1] */
+            for (kk = 0 ; kk < nreach ; kk++)
+            {
+                k = Lreach [kk] ;
+                if (Mark [k] < 3)
+                {
+                    nx = dfs (k - k1, k1, 3, LU, Uip, Ulen, X, Mark,
+                        Stack, Pos, Xi, nx) ;
+                }
+            }
+            for (kk = nx-1 ; kk >= nx1 ; kk--)
+            {
+                k = Xi [kk] ;
+                j = k - k1 ;
+                DIV (X [k], X [k], Udiag [k]) ;
+                xk = X [k] ;
+                GET_POINTER (LU, Uip, Ulen, Ui, Ux, j, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    /* X [Ui [p]] -= Ux [p] * xk */
+                    MULT_SUB (X [k1 + Ui [p]], Ux [p], xk) ;
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* block back-substitution for the off-diagonal-block entries */
+        /* ------------------------------------------------------------------ */
+
+        for (kk = nx1 ; kk < nx ; kk++)
+        {
+            k = Xi [kk] ;
+            xk = X [k] ;
+            pend = Offp [k+1] ;
+            for (p = Offp [k] ; p < pend ; p++)
+            {
+                i = Offi [p] ;
+                if (Mark [i] == 0)
+                {
+                    /* X [i] = 0, and place row i in the list of its block */
+                    Mark [i] = 1 ;
+                    CLEAR (X [i]) ;
+                    c = Block [i] ;
+                    Next [i] = Head [c] ;
+                    Head [c] = i ;
+                }
+                /* X [i] -= Offx [p] * xk */
+                MULT_SUB (X [i], Offx [p], xk) ;
+            }
+        }
+        Head [block] = EMPTY ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute the result, x = Q*X, and clear Mark */
+    /* ---------------------------------------------------------------------- */
+
+    for (kk = 0 ; kk < nx ; kk++)
+    {
+        k = Xi [kk] ;
+        Mark [k] = 0 ;
+        Xz [kk] = X [k] ;
+        Xi [kk] = Q [k] ;
+    }
+    *xnz = nx ;
+    return (TRUE) ;
+}
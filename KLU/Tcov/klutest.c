@@ -38,6 +38,23 @@
 #define klu_z_extract klu_zl_extract
 #define klu_z_condest klu_zl_condest
 #define klu_z_flops klu_zl_flops
+#define klu_z_factor_batch klu_zl_factor_batch
+#define klu_z_refactor_batch klu_zl_refactor_batch
+#define klu_z_solve_batch klu_zl_solve_batch
+#define klu_z_free_batch klu_zl_free_batch
+#define klu_z_sort klu_zl_sort
+#define klu_z_partial_refactor klu_zl_partial_refactor
+#define klu_z_save_numeric klu_zl_save_numeric
+#define klu_z_load_numeric klu_zl_load_numeric
+#define klu_z_refine klu_zl_refine
+#define klu_z_spsolve klu_zl_spsolve
+#define klu_c_factor klu_cl_factor
+#define klu_c_refactor klu_cl_refactor
+#define klu_c_solve klu_cl_solve
+#define klu_c_tsolve klu_cl_tsolve
+#define klu_c_refine klu_cl_refine
+#define klu_c_condest klu_cl_condest
+#define klu_c_free_numeric klu_cl_free_numeric
 
 #define klu_scale klu_l_scale
 #define klu_solve klu_l_solve
@@ -55,6 +72,25 @@
 #define klu_extract klu_l_extract
 #define klu_condest klu_l_condest
 #define klu_flops klu_l_flops
+#define klu_factor_batch klu_l_factor_batch
+#define klu_refactor_batch klu_l_refactor_batch
+#define klu_solve_batch klu_l_solve_batch
+#define klu_free_batch klu_l_free_batch
+#define klu_sort klu_l_sort
+#define klu_partial_refactor klu_l_partial_refactor
+#define klu_save_numeric klu_l_save_numeric
+#define klu_load_numeric klu_l_load_numeric
+#define klu_save_symbolic klu_l_save_symbolic
+#define klu_load_symbolic klu_l_load_symbolic
+#define klu_refine klu_l_refine
+#define klu_spsolve klu_l_spsolve
+#define klu_s_factor klu_sl_factor
+#define klu_s_refactor klu_sl_refactor
+#define klu_s_solve klu_sl_solve
+#define klu_s_tsolve klu_sl_tsolve
+#define klu_s_refine klu_sl_refine
+#define klu_s_condest klu_sl_condest
+#define klu_s_free_numeric klu_sl_free_numeric
 
 #define klu_analyze klu_l_analyze
 #define klu_analyze_given klu_l_analyze_given
@@ -382,6 +418,1017 @@ static Int *randperm (Int n, Int seed)
 }
 
 
+/* ========================================================================== */
+/* === do_batch ============================================================= */
+/* ========================================================================== */
+
+/* Factorize a batch of three matrices (A, A2, and A again) with the pivot
+ * ordering of Numeric, solve with each one, and compare with klu_refactor
+ * and klu_solve of each matrix on its own.  The results should be identical.
+ * Numeric is refactorized on output.  Returns 1 if the results differ, or
+ * zero if they are the same. */
+
+static double do_batch (Int *Ap, Int *Ai, double *Ax, double *Ax2, Int isreal,
+    KLU_symbolic *Symbolic, KLU_numeric *Numeric, KLU_common *Common)
+{
+    KLU_batch *Batch = NULL ;
+    double *Vx, *Bx, *B1, err = 0 ;
+    Int n, nz, e, b, k, tries, halt, scale ;
+
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    nz = Ap [n] * e ;
+    Vx = malloc (3 * nz * sizeof (double)) ;
+    Bx = malloc (3 * n * e * sizeof (double)) ;
+    B1 = malloc (n * e * sizeof (double)) ;
+    OK (Vx && Bx && B1) ;
+    for (k = 0 ; k < nz ; k++)
+    {
+        Vx [k] = Ax [k] ;
+        Vx [nz+k] = Ax2 [k] ;
+        Vx [2*nz+k] = Ax [k] ;
+    }
+
+    /* factorize the batch */
+    my_tries = 0 ;
+    for (tries = 0 ; Batch == NULL && my_tries == 0 ; tries++)
+    {
+        my_tries = tries ;
+        if (isreal)
+        {
+            Batch = klu_factor_batch (Ap, Ai, Vx, 3, Symbolic, Numeric,
+                Common) ;
+        }
+        else
+        {
+            Batch = klu_z_factor_batch (Ap, Ai, Vx, 3, Symbolic, Numeric,
+                Common) ;
+        }
+    }
+    my_tries = -1 ;
+    printf ("batch try "ID" status "ID" rank "ID"\n", tries, Common->status,
+        Common->numerical_rank) ;
+    OK (Batch) ;
+
+    /* solve with each matrix of the batch */
+    for (k = 0 ; k < 3*n*e ; k++)
+    {
+        Bx [k] = 1 + (k % 7) ;
+    }
+    if (isreal)
+    {
+        OK (klu_solve_batch (Symbolic, Numeric, Batch, n, Bx, Common)) ;
+        FAIL (klu_solve_batch (Symbolic, Numeric, Batch, n-1, Bx, Common)) ;
+    }
+    else
+    {
+        OK (klu_z_solve_batch (Symbolic, Numeric, Batch, n, Bx, Common)) ;
+        FAIL (klu_z_solve_batch (Symbolic, Numeric, Batch, n-1, Bx, Common)) ;
+    }
+
+    /* compare with each matrix on its own */
+    halt = Common->halt_if_singular ;
+    Common->halt_if_singular = FALSE ;
+    for (b = 0 ; b < 3 ; b++)
+    {
+        for (k = 0 ; k < n*e ; k++)
+        {
+            B1 [k] = 1 + ((b*n*e + k) % 7) ;
+        }
+        if (isreal)
+        {
+            klu_refactor (Ap, Ai, Vx + b*nz, Symbolic, Numeric, Common) ;
+            klu_solve (Symbolic, Numeric, n, 1, B1, Common) ;
+        }
+        else
+        {
+            klu_z_refactor (Ap, Ai, Vx + b*nz, Symbolic, Numeric, Common) ;
+            klu_z_solve (Symbolic, Numeric, n, 1, B1, Common) ;
+        }
+        if (memcmp (B1, Bx + b*n*e, n * e * sizeof (double)) != 0)
+        {
+            printf ("batch "ID" differs\n", b) ;
+            err = 1 ;
+        }
+    }
+    Common->halt_if_singular = halt ;
+
+    /* refactorize the batch, without scaling */
+    scale = Common->scale ;
+    if (scale > 0)
+    {
+        Common->scale = -1 ;
+        if (isreal)
+        {
+            OK (klu_refactor_batch (Ap, Ai, Vx, Symbolic, Numeric, Batch,
+                Common)) ;
+        }
+        else
+        {
+            OK (klu_z_refactor_batch (Ap, Ai, Vx, Symbolic, Numeric, Batch,
+                Common)) ;
+        }
+        Common->scale = scale ;
+    }
+
+    /* the batch is not valid once the pattern of the template changes */
+    if (isreal)
+    {
+        OK (klu_sort (Symbolic, Numeric, Common)) ;
+        FAIL (klu_solve_batch (Symbolic, Numeric, Batch, n, Bx, Common)) ;
+        OK (Common->status == KLU_INVALID) ;
+        FAIL (klu_refactor_batch (Ap, Ai, Vx, Symbolic, Numeric, Batch,
+            Common)) ;
+        OK (Common->status == KLU_INVALID) ;
+    }
+    else
+    {
+        OK (klu_z_sort (Symbolic, Numeric, Common)) ;
+        FAIL (klu_z_solve_batch (Symbolic, Numeric, Batch, n, Bx, Common)) ;
+        OK (Common->status == KLU_INVALID) ;
+        FAIL (klu_z_refactor_batch (Ap, Ai, Vx, Symbolic, Numeric, Batch,
+            Common)) ;
+        OK (Common->status == KLU_INVALID) ;
+    }
+
+    if (isreal)
+    {
+        OK (klu_free_batch (&Batch, Common)) ;
+    }
+    else
+    {
+        OK (klu_z_free_batch (&Batch, Common)) ;
+    }
+    free (Vx) ;
+    free (Bx) ;
+    free (B1) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_partial =========================================================== */
+/* ========================================================================== */
+
+/* Refactorize with klu_partial_refactor, finding the changed columns by
+ * comparing A with A2, and then given the changed columns, and compare with
+ * klu_refactor.  The solutions should be identical.  Returns 1 if they
+ * differ, or zero if they are the same. */
+
+static Int partial_refactor (Int *Ap, Int *Ai, double *Ax, Int *Changed,
+    double *Axold, Int isreal, KLU_symbolic *Symbolic, KLU_numeric *Numeric,
+    KLU_common *Common)
+{
+    if (isreal)
+    {
+        return (klu_partial_refactor (Ap, Ai, Ax, Changed, Axold, Symbolic,
+            Numeric, Common)) ;
+    }
+    else
+    {
+        return (klu_z_partial_refactor (Ap, Ai, Ax, Changed, Axold, Symbolic,
+            Numeric, Common)) ;
+    }
+}
+
+static double do_partial (Int *Ap, Int *Ai, double *Ax, double *Ax2,
+    Int isreal, KLU_symbolic *Symbolic, KLU_numeric *Numeric,
+    KLU_common *Common)
+{
+    double *Vx, *B1, *B2, err = 0 ;
+    Int *Changed, n, nz, e, k, t, halt, scale ;
+
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    nz = Ap [n] * e ;
+    Vx = malloc (nz * sizeof (double)) ;
+    B1 = malloc (n * e * sizeof (double)) ;
+    B2 = malloc (n * e * sizeof (double)) ;
+    Changed = malloc (n * sizeof (Int)) ;
+    OK (Vx && B1 && B2 && Changed) ;
+
+    /* only the last column of A changes */
+    for (k = 0 ; k < nz ; k++)
+    {
+        Vx [k] = (k >= Ap [n-1] * e) ? Ax2 [k] : Ax [k] ;
+    }
+    for (k = 0 ; k < n ; k++)
+    {
+        Changed [k] = (k == n-1) ;
+    }
+
+    halt = Common->halt_if_singular ;
+    Common->halt_if_singular = FALSE ;
+    for (t = 0 ; t <= 1 ; t++)
+    {
+        /* A to A2 by comparing values, and then A to V given Changed */
+        if (isreal)
+        {
+            klu_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common) ;
+        }
+        else
+        {
+            klu_z_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common) ;
+        }
+        OK (partial_refactor (Ap, Ai, t ? Vx : Ax2, t ? Changed : NULL,
+            Ax, isreal, Symbolic, Numeric, Common)) ;
+        for (k = 0 ; k < n*e ; k++)
+        {
+            B1 [k] = B2 [k] = 1 + (k % 7) ;
+        }
+        if (isreal)
+        {
+            klu_solve (Symbolic, Numeric, n, 1, B1, Common) ;
+            klu_refactor (Ap, Ai, t ? Vx : Ax2, Symbolic, Numeric, Common) ;
+            klu_solve (Symbolic, Numeric, n, 1, B2, Common) ;
+        }
+        else
+        {
+            klu_z_solve (Symbolic, Numeric, n, 1, B1, Common) ;
+            klu_z_refactor (Ap, Ai, t ? Vx : Ax2, Symbolic, Numeric, Common) ;
+            klu_z_solve (Symbolic, Numeric, n, 1, B2, Common) ;
+        }
+        if (memcmp (B1, B2, n * e * sizeof (double)) != 0)
+        {
+            printf ("partial refactor "ID" differs\n", t) ;
+            err = 1 ;
+        }
+    }
+
+    /* turn the scaling off and on again, which recomputes all columns */
+    scale = Common->scale ;
+    if (scale > 0)
+    {
+        Common->scale = 0 ;
+        OK (partial_refactor (Ap, Ai, Ax, NULL, Vx, isreal, Symbolic,
+            Numeric, Common)) ;
+        Common->scale = scale ;
+        OK (partial_refactor (Ap, Ai, Ax, Changed, NULL, isreal, Symbolic,
+            Numeric, Common)) ;
+    }
+    Common->halt_if_singular = TRUE ;
+    if (!partial_refactor (Ap, Ai, Vx, Changed, NULL, isreal, Symbolic,
+        Numeric, Common))
+    {
+        OK (Common->status == KLU_SINGULAR) ;
+    }
+    Common->halt_if_singular = halt ;
+
+    /* invalid inputs */
+    FAIL (partial_refactor (Ap, Ai, Ax, NULL, NULL, isreal, Symbolic,
+        Numeric, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (partial_refactor (Ap, Ai, Ax, Changed, NULL, isreal, Symbolic,
+        NULL, Common)) ;
+    FAIL (partial_refactor (Ap, Ai, Ax, Changed, NULL, isreal, Symbolic,
+        Numeric, NULL)) ;
+
+    free (Vx) ;
+    free (B1) ;
+    free (B2) ;
+    free (Changed) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_save ============================================================== */
+/* ========================================================================== */
+
+/* Save the Symbolic and Numeric objects to files, load them back in, and solve
+ * with the loaded objects:  as mapped from the file, after klu_refactor, and
+ * with the file read into memory instead of mapped.  Returns 1 if any solution
+ * differs from the solution with the original objects, or zero if they are all
+ * the same.  Also tests corrupted and missing files. */
+
+static Int save_numeric (KLU_numeric *Numeric, const char *filename,
+    Int isreal, KLU_common *Common)
+{
+    if (isreal)
+    {
+        return (klu_save_numeric (Numeric, filename, Common)) ;
+    }
+    else
+    {
+        return (klu_z_save_numeric (Numeric, filename, Common)) ;
+    }
+}
+
+static KLU_numeric *load_numeric (const char *filename, KLU_symbolic *Symbolic,
+    Int isreal, KLU_common *Common)
+{
+    if (isreal)
+    {
+        return (klu_load_numeric (filename, Symbolic, Common)) ;
+    }
+    else
+    {
+        return (klu_z_load_numeric (filename, Symbolic, Common)) ;
+    }
+}
+
+static Int solve_differs (KLU_symbolic *Symbolic, KLU_numeric *Numeric,
+    double *B1, double *B2, Int isreal, KLU_common *Common)
+{
+    Int k, n, e ;
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    for (k = 0 ; k < n*e ; k++)
+    {
+        B2 [k] = 1 + (k % 7) ;
+    }
+    if (isreal)
+    {
+        klu_solve (Symbolic, Numeric, n, 1, B2, Common) ;
+    }
+    else
+    {
+        klu_z_solve (Symbolic, Numeric, n, 1, B2, Common) ;
+    }
+    return (memcmp (B1, B2, n * e * sizeof (double)) != 0) ;
+}
+
+static double do_save (Int *Ap, Int *Ai, double *Ax, Int isreal,
+    KLU_symbolic *Symbolic, KLU_numeric *Numeric, KLU_common *Common)
+{
+    KLU_symbolic *S2 = NULL ;
+    KLU_numeric *N2 = NULL, *N3 ;
+    KLU_numeric_header *Header ;
+    double *B1, *B2, err = 0 ;
+    char *image ;
+    long size, len ;
+    Int n, e, k, tries ;
+    FILE *f ;
+
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    B1 = malloc (n * e * sizeof (double)) ;
+    B2 = malloc (n * e * sizeof (double)) ;
+    OK (B1 && B2) ;
+
+    /* solve with the factors of A */
+    for (k = 0 ; k < n*e ; k++)
+    {
+        B1 [k] = 1 + (k % 7) ;
+    }
+    if (isreal)
+    {
+        klu_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common) ;
+        klu_solve (Symbolic, Numeric, n, 1, B1, Common) ;
+    }
+    else
+    {
+        klu_z_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common) ;
+        klu_z_solve (Symbolic, Numeric, n, 1, B1, Common) ;
+    }
+
+    /* save and load, with malloc failures */
+    OK (klu_save_symbolic (Symbolic, "klu_symbolic.tmp", Common)) ;
+    OK (save_numeric (Numeric, "klu_numeric.tmp", isreal, Common)) ;
+    my_tries = 0 ;
+    for (tries = 0 ; S2 == NULL && my_tries == 0 ; tries++)
+    {
+        my_tries = tries ;
+        S2 = klu_load_symbolic ("klu_symbolic.tmp", Common) ;
+    }
+    my_tries = 0 ;
+    for (tries = 0 ; N2 == NULL && my_tries == 0 ; tries++)
+    {
+        my_tries = tries ;
+        N2 = load_numeric ("klu_numeric.tmp", S2, isreal, Common) ;
+    }
+    my_tries = -1 ;
+    OK (S2 && N2 && N2->mapped) ;
+
+    /* solve with the mapped factors, and again after refactorizing them */
+    if (solve_differs (S2, N2, B1, B2, isreal, Common))
+    {
+        printf ("mapped factors differ\n") ;
+        err = 1 ;
+    }
+    if (isreal)
+    {
+        klu_refactor (Ap, Ai, Ax, S2, N2, Common) ;
+    }
+    else
+    {
+        klu_z_refactor (Ap, Ai, Ax, S2, N2, Common) ;
+    }
+    if (solve_differs (S2, N2, B1, B2, isreal, Common))
+    {
+        printf ("refactorized mapped factors differ\n") ;
+        err = 1 ;
+    }
+
+    /* save the loaded object (to another file, since the first one is still
+     * mapped), with an extra byte so that the file is read in */
+    OK (save_numeric (N2, "klu_numeric2.tmp", isreal, Common)) ;
+    f = fopen ("klu_numeric2.tmp", "ab") ;
+    OK (f && fputc (0, f) == 0 && fclose (f) == 0) ;
+    N3 = load_numeric ("klu_numeric2.tmp", S2, isreal, Common) ;
+    OK (N3 && !N3->mapped) ;
+    if (solve_differs (S2, N3, B1, B2, isreal, Common))
+    {
+        printf ("loaded factors differ\n") ;
+        err = 1 ;
+    }
+    klu_free_numeric (&N3, Common) ;
+    my_tries = 0 ;
+    OK (load_numeric ("klu_numeric2.tmp", S2, isreal, Common) == NULL) ;
+    my_tries = -1 ;
+    OK (Common->status == KLU_OUT_OF_MEMORY) ;
+
+    /* the wrong kind of file */
+    OK (load_numeric ("klu_numeric2.tmp", S2, !isreal, Common) == NULL) ;
+    OK (Common->status == KLU_INVALID) ;
+    OK (load_numeric ("klu_symbolic.tmp", S2, isreal, Common) == NULL) ;
+    /* a small Symbolic file is shorter than the header of a Numeric file */
+    OK (Common->status == KLU_INVALID || Common->status == KLU_FILE_IO) ;
+    OK (klu_load_symbolic ("klu_numeric2.tmp", Common) == NULL) ;
+    OK (Common->status == KLU_INVALID) ;
+
+    /* a corrupted file, and a truncated file */
+    f = fopen ("klu_numeric2.tmp", "rb") ;
+    OK (f && fseek (f, 0, SEEK_END) == 0) ;
+    size = ftell (f) - 1 ;
+    image = malloc (size) ;
+    OK (image && fseek (f, 0, SEEK_SET) == 0) ;
+    OK (fread (image, 1, size, f) == (size_t) size && fclose (f) == 0) ;
+    Header = (KLU_numeric_header *) image ;
+    Header->offset [1]++ ;
+    f = fopen ("klu_numeric2.tmp", "wb") ;
+    OK (f && fwrite (image, 1, size, f) == (size_t) size && fclose (f) == 0) ;
+    OK (load_numeric ("klu_numeric2.tmp", S2, isreal, Common) == NULL) ;
+    OK (Common->status == KLU_INVALID) ;
+    f = fopen ("klu_numeric2.tmp", "wb") ;
+    OK (f && fwrite (image, 1, size/2, f) == (size_t) (size/2)) ;
+    OK (fclose (f) == 0) ;
+    OK (load_numeric ("klu_numeric2.tmp", S2, isreal, Common) == NULL) ;
+    OK (Common->status == KLU_FILE_IO) ;
+    free (image) ;
+
+    /* truncated Symbolic files, ending in the object and in the arrays */
+    f = fopen ("klu_symbolic.tmp", "rb") ;
+    size = 16 + 2 * sizeof (Int) + sizeof (KLU_symbolic) + n * sizeof (Int) ;
+    image = malloc (size) ;
+    OK (f && image && fread (image, 1, size, f) == (size_t) size) ;
+    OK (fclose (f) == 0) ;
+    for (k = 0 ; k <= 1 ; k++)
+    {
+        len = k ? size : (long) (16 + 2 * sizeof (Int) + 8) ;
+        f = fopen ("klu_symbolic.tmp", "wb") ;
+        OK (f && fwrite (image, 1, len, f) == (size_t) len) ;
+        OK (fclose (f) == 0) ;
+        OK (klu_load_symbolic ("klu_symbolic.tmp", Common) == NULL) ;
+        OK (Common->status == KLU_FILE_IO) ;
+    }
+    free (image) ;
+
+    /* missing files, and invalid inputs */
+    OK (klu_load_symbolic ("klu_missing.tmp", Common) == NULL) ;
+    OK (Common->status == KLU_FILE_IO) ;
+    OK (load_numeric ("klu_missing.tmp", S2, isreal, Common) == NULL) ;
+    OK (Common->status == KLU_FILE_IO) ;
+    FAIL (klu_save_symbolic (S2, "klu_missing/klu_symbolic.tmp", Common)) ;
+    OK (Common->status == KLU_FILE_IO) ;
+    FAIL (save_numeric (N2, "klu_missing/klu_numeric.tmp", isreal, Common)) ;
+    OK (Common->status == KLU_FILE_IO) ;
+    FAIL (save_numeric (NULL, "klu_numeric2.tmp", isreal, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (klu_save_symbolic (NULL, "klu_symbolic.tmp", Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    OK (load_numeric ("klu_numeric2.tmp", NULL, isreal, Common) == NULL) ;
+    OK (Common->status == KLU_INVALID) ;
+    OK (klu_load_symbolic (NULL, Common) == NULL) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (save_numeric (N2, "klu_numeric2.tmp", isreal, NULL)) ;
+    FAIL (klu_save_symbolic (S2, "klu_symbolic.tmp", NULL)) ;
+    OK (load_numeric ("klu_numeric2.tmp", S2, isreal, NULL) == NULL) ;
+    OK (klu_load_symbolic ("klu_symbolic.tmp", NULL) == NULL) ;
+
+    remove ("klu_symbolic.tmp") ;
+    remove ("klu_numeric.tmp") ;
+    remove ("klu_numeric2.tmp") ;
+    klu_free_symbolic (&S2, Common) ;
+    klu_free_numeric (&N2, Common) ;
+    free (B1) ;
+    free (B2) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_refine ============================================================ */
+/* ========================================================================== */
+
+/* Solve Ax=b with klu_refine, with the double-precision factors in Numeric and
+ * then with single-precision factors from klu_s_factor.  Returns 1 if the
+ * refined solution with the single-precision factors does not have a small
+ * backward error, for a well-conditioned matrix.  Also tests the other
+ * single-precision solves, malloc failures, and invalid inputs. */
+
+static Int refine (Int *Ap, Int *Ai, double *Ax, KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric, Int d, Int nrhs, double *B, double *X, Int isreal,
+    Int single, KLU_common *Common)
+{
+    if (isreal)
+    {
+        return (single ?
+            klu_s_refine (Ap, Ai, Ax, Symbolic, Numeric, d, nrhs, B, X, Common):
+            klu_refine (Ap, Ai, Ax, Symbolic, Numeric, d, nrhs, B, X, Common)) ;
+    }
+    else
+    {
+        return (single ?
+            klu_c_refine (Ap, Ai, Ax, Symbolic, Numeric, d, nrhs, B, X, Common):
+            klu_z_refine (Ap, Ai, Ax, Symbolic, Numeric, d, nrhs, B, X, Common)) ;
+    }
+}
+
+static double do_refine (Int *Ap, Int *Ai, double *Ax, Int isreal,
+    KLU_symbolic *Symbolic, KLU_numeric *Numeric, KLU_common *Common)
+{
+    KLU_numeric *N1 = NULL ;
+    double *B, *X, berr, berr1, rcond, err = 0 ;
+    Int n, e, k, tries, irstep ;
+
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    B = malloc (2 * n * e * sizeof (double)) ;
+    X = malloc (2 * n * e * sizeof (double)) ;
+    OK (B && X) ;
+    for (k = 0 ; k < 2*n*e ; k++)
+    {
+        B [k] = 1 + (k % 7) ;
+    }
+
+    /* refine with the double-precision factors */
+    if (isreal)
+    {
+        klu_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common) ;
+        klu_condest (Ap, Ax, Symbolic, Numeric, Common) ;
+    }
+    else
+    {
+        klu_z_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common) ;
+        klu_z_condest (Ap, Ax, Symbolic, Numeric, Common) ;
+    }
+    rcond = 1 / Common->condest ;
+    OK (refine (Ap, Ai, Ax, Symbolic, Numeric, n, 2, B, X, isreal, FALSE,
+        Common)) ;
+    berr = Common->berr ;
+
+    /* factorize in single precision, with malloc failures */
+    my_tries = 0 ;
+    for (tries = 0 ; N1 == NULL && my_tries == 0 ; tries++)
+    {
+        my_tries = tries ;
+        if (isreal)
+        {
+            N1 = klu_s_factor (Ap, Ai, Ax, Symbolic, Common) ;
+        }
+        else
+        {
+            N1 = klu_c_factor (Ap, Ai, Ax, Symbolic, Common) ;
+        }
+    }
+    my_tries = -1 ;
+    if (N1 == NULL || Common->status != KLU_OK)
+    {
+        /* singular, or singular in single precision */
+        if (isreal)
+        {
+            klu_s_free_numeric (&N1, Common) ;
+        }
+        else
+        {
+            klu_c_free_numeric (&N1, Common) ;
+        }
+        free (B) ;
+        free (X) ;
+        return (0) ;
+    }
+
+    /* solve with the single-precision factors, and refine */
+    if (isreal)
+    {
+        OK (klu_s_refactor (Ap, Ai, Ax, Symbolic, N1, Common)) ;
+        OK (klu_s_condest (Ap, Ax, Symbolic, N1, Common)) ;
+        OK (klu_s_solve (Symbolic, N1, n, 1, X, Common)) ;
+        OK (klu_s_tsolve (Symbolic, N1, n, 1, X, Common)) ;
+    }
+    else
+    {
+        OK (klu_c_refactor (Ap, Ai, Ax, Symbolic, N1, Common)) ;
+        OK (klu_c_condest (Ap, Ax, Symbolic, N1, Common)) ;
+        OK (klu_c_solve (Symbolic, N1, n, 1, X, Common)) ;
+        OK (klu_c_tsolve (Symbolic, N1, n, 1, X, 0, Common)) ;
+    }
+    OK (refine (Ap, Ai, Ax, Symbolic, N1, n, 2, B, X, isreal, TRUE, Common)) ;
+    printf ("refine berr: double %g single %g rcond %g\n", berr,
+        Common->berr, rcond) ;
+    if (rcond > 1e-4 && Common->berr > 1e-13)
+    {
+        printf ("single-precision refinement failed\n") ;
+        err = 1 ;
+    }
+
+    /* no refinement at all; a step that does not help is discarded, so
+     * refinement never does worse than this */
+    berr1 = Common->berr ;
+    irstep = Common->irstep ;
+    Common->irstep = 0 ;
+    OK (refine (Ap, Ai, Ax, Symbolic, N1, n, 2, B, X, isreal, TRUE, Common)) ;
+    Common->irstep = irstep ;
+    OK (berr1 <= Common->berr) ;
+
+    /* malloc failure, and invalid inputs */
+    my_tries = 0 ;
+    FAIL (refine (Ap, Ai, Ax, Symbolic, N1, n, 1, B, X, isreal, TRUE, Common)) ;
+    my_tries = -1 ;
+    OK (Common->status == KLU_OUT_OF_MEMORY) ;
+    FAIL (refine (Ap, Ai, Ax, Symbolic, N1, n-1, 1, B, X, isreal, TRUE,
+        Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (refine (Ap, Ai, Ax, Symbolic, NULL, n, 1, B, X, isreal, TRUE,
+        Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (refine (Ap, Ai, Ax, Symbolic, N1, n, 1, B, NULL, isreal, TRUE,
+        Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (refine (Ap, Ai, Ax, Symbolic, N1, n, 1, B, X, isreal, TRUE, NULL)) ;
+
+    if (isreal)
+    {
+        klu_s_free_numeric (&N1, Common) ;
+    }
+    else
+    {
+        klu_c_free_numeric (&N1, Common) ;
+    }
+    free (B) ;
+    free (X) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_spsolve =========================================================== */
+/* ========================================================================== */
+
+/* Solve with sparse right-hand sides with klu_spsolve, and compare with
+ * klu_solve.  Returns the largest relative difference.  Also tests malloc
+ * failures and invalid inputs. */
+
+static Int spsolve (KLU_symbolic *Symbolic, KLU_numeric *Numeric, Int bnz,
+    Int *Bi, double *Bx, Int *xnz, Int *Xi, double *Xx, Int isreal,
+    KLU_common *Common)
+{
+    if (isreal)
+    {
+        return (klu_spsolve (Symbolic, Numeric, bnz, Bi, Bx, xnz, Xi, Xx,
+            Common)) ;
+    }
+    else
+    {
+        return (klu_z_spsolve (Symbolic, Numeric, bnz, Bi, Bx, xnz, Xi, Xx,
+            Common)) ;
+    }
+}
+
+static double do_spsolve (Int isreal, KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric, KLU_common *Common)
+{
+    double *B, *Xx, *W, xnorm, diff, err = 0 ;
+    Int Bi [3], *Xi, n, e, i, k, p, trial, tries, bnz, xnz, ok ;
+    double Bx [6] ;
+
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    B = malloc (n * e * sizeof (double)) ;
+    W = malloc (n * e * sizeof (double)) ;
+    Xx = malloc (n * e * sizeof (double)) ;
+    Xi = malloc (n * sizeof (Int)) ;
+    OK (B && W && Xx && Xi) ;
+
+    for (trial = 0 ; trial < 8 ; trial++)
+    {
+        /* b has one entry, or two entries with a duplicate in rows i and k */
+        i = (trial * 7) % n ;
+        k = (trial < 4) ? (n-1-i) : i ;
+        bnz = (trial % 2 == 0) ? 1 : 3 ;
+        Bi [0] = i ; Bi [1] = k ; Bi [2] = i ;
+        for (p = 0 ; p < 3*e ; p++)
+        {
+            Bx [p] = 1 + p ;
+        }
+
+        /* x = A\b with klu_spsolve, with malloc failures the first time */
+        ok = FALSE ;
+        my_tries = 0 ;
+        for (tries = 0 ; !ok && my_tries == 0 ; tries++)
+        {
+            my_tries = tries ;
+            ok = spsolve (Symbolic, Numeric, bnz, Bi, Bx, &xnz, Xi, Xx,
+                isreal, Common) ;
+        }
+        my_tries = -1 ;
+        OK (ok && xnz >= 1 && xnz <= n) ;
+
+        /* x = A\b with klu_solve */
+        for (p = 0 ; p < n*e ; p++)
+        {
+            B [p] = 0 ;
+        }
+        for (p = 0 ; p < bnz*e ; p++)
+        {
+            B [Bi [p/e] * e + (p%e)] += Bx [p] ;
+        }
+        if (isreal)
+        {
+            klu_solve (Symbolic, Numeric, n, 1, B, Common) ;
+        }
+        else
+        {
+            klu_z_solve (Symbolic, Numeric, n, 1, B, Common) ;
+        }
+
+        /* compare */
+        for (p = 0 ; p < n*e ; p++)
+        {
+            W [p] = 0 ;
+        }
+        for (p = 0 ; p < xnz*e ; p++)
+        {
+            W [Xi [p/e] * e + (p%e)] = Xx [p] ;
+        }
+        xnorm = 0 ;
+        diff = 0 ;
+        for (p = 0 ; p < n*e ; p++)
+        {
+            xnorm = MAX (xnorm, fabs (B [p])) ;
+            diff = MAX (diff, fabs (B [p] - W [p])) ;
+        }
+        if (xnorm > 0 && !SCALAR_IS_NAN (diff))
+        {
+            err = MAX (err, diff / xnorm) ;
+        }
+        printf ("spsolve bnz "ID" xnz "ID" of "ID" diff %g\n", bnz, xnz, n,
+            diff) ;
+    }
+
+    /* invalid inputs */
+    Bi [0] = n ;
+    FAIL (spsolve (Symbolic, Numeric, 1, Bi, Bx, &xnz, Xi, Xx, isreal,
+        Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (spsolve (Symbolic, Numeric, -1, Bi, Bx, &xnz, Xi, Xx, isreal,
+        Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (spsolve (Symbolic, Numeric, 1, NULL, Bx, &xnz, Xi, Xx, isreal,
+        Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (spsolve (Symbolic, NULL, 1, Bi, Bx, &xnz, Xi, Xx, isreal, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (spsolve (Symbolic, Numeric, 1, Bi, Bx, &xnz, Xi, Xx, isreal, NULL)) ;
+
+    /* an empty right-hand side */
+    OK (spsolve (Symbolic, Numeric, 0, NULL, NULL, &xnz, Xi, Xx, isreal,
+        Common)) ;
+    OK (xnz == 0) ;
+
+    free (B) ;
+    free (W) ;
+    free (Xx) ;
+    free (Xi) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_repivot =========================================================== */
+/* ========================================================================== */
+
+/* Refactorize with Common->repivot > 0, first for a matrix A2 whose prior
+ * pivots have been made tiny, and then for A with all blocks re-pivoted.
+ * Returns the largest relative residual of the solutions.  Also tests malloc
+ * failures, and that the Numeric object can still be used after one. */
+
+static Int refactor (Int *Ap, Int *Ai, double *Ax, KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric, Int isreal, KLU_common *Common)
+{
+    if (isreal)
+    {
+        return (klu_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common)) ;
+    }
+    else
+    {
+        return (klu_z_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common)) ;
+    }
+}
+
+static double resid (Int *Ap, Int *Ai, double *Ax, KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric, double *X, double *R, Int isreal,
+    KLU_common *Common)
+{
+    double anorm, xnorm, rnorm, colnorm ;
+    Int n, e, i, j, p ;
+
+    /* x = A\b, with b = 1+(k%7), and R = b - A*x */
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    for (i = 0 ; i < n*e ; i++)
+    {
+        X [i] = R [i] = 1 + (i % 7) ;
+    }
+    if (isreal)
+    {
+        klu_solve (Symbolic, Numeric, n, 1, X, Common) ;
+    }
+    else
+    {
+        klu_z_solve (Symbolic, Numeric, n, 1, X, Common) ;
+    }
+    anorm = 0 ;
+    xnorm = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        colnorm = 0 ;
+        for (p = Ap [j] ; p < Ap [j+1] ; p++)
+        {
+            i = Ai [p] ;
+            if (isreal)
+            {
+                R [i] -= Ax [p] * X [j] ;
+                colnorm += fabs (Ax [p]) ;
+            }
+            else
+            {
+                R [2*i  ] -= Ax [2*p] * X [2*j  ] - Ax [2*p+1] * X [2*j+1] ;
+                R [2*i+1] -= Ax [2*p] * X [2*j+1] + Ax [2*p+1] * X [2*j  ] ;
+                colnorm += fabs (Ax [2*p]) + fabs (Ax [2*p+1]) ;
+            }
+        }
+        anorm = MAX (anorm, colnorm) ;
+    }
+    rnorm = 0 ;
+    for (i = 0 ; i < n*e ; i++)
+    {
+        xnorm = MAX (xnorm, fabs (X [i])) ;
+        rnorm = MAX (rnorm, fabs (R [i])) ;
+    }
+    return (rnorm / (anorm * xnorm + 7)) ;
+}
+
+static double do_repivot (Int *Ap, Int *Ai, double *Ax, Int isreal,
+    KLU_symbolic *Symbolic, KLU_common *Common)
+{
+    KLU_numeric *N1 = NULL ;
+    double *Ax2, *X, *R, r0, r1, r2, err = 0 ;
+    Int *Q, *Pnum, n, e, k, p, block, nbig, tries, ok, halt, generation ;
+
+    n = Symbolic->n ;
+    e = isreal ? 1 : 2 ;
+    Q = Symbolic->Q ;
+    Ax2 = malloc (Ap [n] * e * sizeof (double)) ;
+    X = malloc (n * e * sizeof (double)) ;
+    R = malloc (n * e * sizeof (double)) ;
+    OK (Ax2 && X && R) ;
+    halt = Common->halt_if_singular ;
+    Common->halt_if_singular = FALSE ;
+
+    /* factorize A, and skip the test if A is singular */
+    Common->repivot = 0 ;
+    N1 = isreal ? klu_factor (Ap, Ai, Ax, Symbolic, Common) :
+        klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+    ok = (N1 != NULL && Common->status == KLU_OK) ;
+    if (ok)
+    {
+        ok = isreal ? klu_rcond (Symbolic, N1, Common) :
+            klu_z_rcond (Symbolic, N1, Common) ;
+        ok = ok && Common->rcond > 0 ;
+    }
+
+    /* A2 is A with each pivot of the blocks larger than 1-by-1 scaled by
+     * a tiny number, so that those pivots are unstable */
+    nbig = 0 ;
+    for (p = 0 ; ok && p < Ap [n] * e ; p++)
+    {
+        Ax2 [p] = Ax [p] ;
+    }
+    for (block = 0 ; ok && block < Symbolic->nblocks ; block++)
+    {
+        if (Symbolic->R [block+1] - Symbolic->R [block] == 1) continue ;
+        nbig++ ;
+        Pnum = N1->Pnum ;
+        for (k = Symbolic->R [block] ; k < Symbolic->R [block+1] ; k++)
+        {
+            for (p = Ap [Q [k]] ; p < Ap [Q [k] + 1] ; p++)
+            {
+                if (Ai [p] == Pnum [k])
+                {
+                    Ax2 [e*p] *= 1e-12 ;
+                    if (!isreal) Ax2 [e*p+1] *= 1e-12 ;
+                }
+            }
+        }
+    }
+
+    /* refactorize A2 with re-pivoting, with malloc failures.  N1 is used
+     * again after each failure, which must leave it in a consistent state. */
+    for (tries = 0 ; ok ; tries++)
+    {
+        /* fixed pivots, for comparison */
+        Common->repivot = 0 ;
+        OK (refactor (Ap, Ai, Ax2, Symbolic, N1, isreal, Common)) ;
+        OK (Common->nrepivot == 0) ;
+        r0 = resid (Ap, Ai, Ax2, Symbolic, N1, X, R, isreal, Common) ;
+
+        Common->repivot = 1e-8 ;
+        my_tries = tries ;
+        ok = refactor (Ap, Ai, Ax2, Symbolic, N1, isreal, Common) ;
+        my_tries = -1 ;
+        if (!ok)
+        {
+            OK (Common->status == KLU_OUT_OF_MEMORY) ;
+            for (k = 0 ; k < n ; k++)
+            {
+                OK (N1->Pinv [N1->Pnum [k]] == k) ;
+            }
+            ok = TRUE ;
+            continue ;
+        }
+        OK (Common->nrepivot > 0 || nbig == 0) ;
+        r1 = resid (Ap, Ai, Ax2, Symbolic, N1, X, R, isreal, Common) ;
+        OK (isreal ? klu_rcond (Symbolic, N1, Common) :
+            klu_z_rcond (Symbolic, N1, Common)) ;
+        if (Common->rcond > 0)
+        {
+            /* A2 is not singular, so the new pivots must be stable */
+            OK (!SCALAR_IS_NAN (r1) && r1 < 1e-12) ;
+            if (SCALAR_IS_NAN (r0) || r0 > 1e-12)
+            {
+                /* the fixed pivots were unstable */
+                OK (r1 < 1e-3 * r0 || SCALAR_IS_NAN (r0)) ;
+            }
+        }
+
+        /* re-pivot all blocks larger than 1-by-1, back to A */
+        Common->repivot = 2 ;
+        generation = N1->generation ;
+        OK (refactor (Ap, Ai, Ax, Symbolic, N1, isreal, Common)) ;
+        OK (Common->nrepivot == nbig) ;
+        OK (N1->generation == generation + nbig) ;
+        r2 = resid (Ap, Ai, Ax, Symbolic, N1, X, R, isreal, Common) ;
+        printf ("repivot "ID" of "ID": resid %g (fixed pivots: %g), %g\n",
+            Common->nrepivot, nbig, r1, r0, r2) ;
+        OK (!SCALAR_IS_NAN (r2)) ;
+        err = (Common->rcond > 0) ? MAX (r1, r2) : r2 ;
+
+        /* a block that is singular cannot be re-pivoted if halt_if_singular
+         * is true.  N1 keeps the pivots of that block, and still works. */
+        for (block = 0 ; block < Symbolic->nblocks ; block++)
+        {
+            if (Symbolic->R [block+1] - Symbolic->R [block] > 1) break ;
+        }
+        if (block < Symbolic->nblocks)
+        {
+            k = Symbolic->R [block] ;
+            for (p = Ap [Q [k]] * e ; p < Ap [Q [k] + 1] * e ; p++)
+            {
+                Ax2 [p] = 0 ;
+            }
+            Common->halt_if_singular = TRUE ;
+            Common->repivot = 1e-8 ;
+            generation = N1->generation ;
+            FAIL (refactor (Ap, Ai, Ax2, Symbolic, N1, isreal, Common)) ;
+            OK (Common->status == KLU_SINGULAR) ;
+            OK (N1->generation == generation) ;
+            Common->halt_if_singular = FALSE ;
+            Common->repivot = 0 ;
+            OK (refactor (Ap, Ai, Ax, Symbolic, N1, isreal, Common)) ;
+            OK (resid (Ap, Ai, Ax, Symbolic, N1, X, R, isreal, Common) == r2) ;
+        }
+        break ;
+    }
+
+    if (isreal)
+    {
+        klu_free_numeric (&N1, Common) ;
+    }
+    else
+    {
+        klu_z_free_numeric (&N1, Common) ;
+    }
+    Common->repivot = 0 ;
+    Common->halt_if_singular = halt ;
+    free (Ax2) ;
+    free (X) ;
+    free (R) ;
+    return (err) ;
+}
+
+
 /* ========================================================================== */
 /* === do_1_solve =========================================================== */
 /* ========================================================================== */
@@ -401,10 +1448,11 @@ static double do_1_solve (cholmod_sparse *A, cholmod_dense *B,
     Int i, j, nrhs2, isreal, n, nrhs, transpose, step, k, save, tries ;
 
     printf ("\ndo_1_solve: btf "ID" maxwork %g scale "ID" ordering "ID" user: "
-        ID" P,Q: %d halt: "ID"\n",
+        ID" P,Q: %d halt: "ID" threads: "ID"\n",
         Common->btf, Common->maxwork, Common->scale, Common->ordering,
         Common->user_data ?  (*((Int *) Common->user_data)) : -1,
-        (Puser != NULL || Quser != NULL), Common->halt_if_singular) ;
+        (Puser != NULL || Quser != NULL), Common->halt_if_singular,
+        Common->nthreads) ;
     fflush (stdout) ;
     fflush (stderr) ;
 
@@ -503,6 +1551,19 @@ static double do_1_solve (cholmod_sparse *A, cholmod_dense *B,
                 {
                     Numeric = klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
                 }
+                if (Numeric != NULL && Numeric->Levels == NULL &&
+                    Common->nthreads != 1 && my_tries == 0)
+                {
+                    /* the level sets ran out of memory; try again */
+                    if (isreal)
+                    {
+                        klu_free_numeric (&Numeric, Common) ;
+                    }
+                    else
+                    {
+                        klu_z_free_numeric (&Numeric, Common) ;
+                    }
+                }
             }
             printf ("num try "ID" btf "ID"\n", tries, Common->btf) ;
             my_tries = -1 ;
@@ -742,6 +1803,24 @@ static double do_1_solve (cholmod_sparse *A, cholmod_dense *B,
         }
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* factorize and solve a batch of matrices */
+    /* ---------------------------------------------------------------------- */
+
+    if (Numeric != NULL && Common->status >= KLU_OK)
+    {
+        err = MAX (err, do_batch (Ap, Ai, Ax, Ax2, isreal, Symbolic, Numeric,
+            Common)) ;
+        err = MAX (err, do_partial (Ap, Ai, Ax, Ax2, isreal, Symbolic,
+            Numeric, Common)) ;
+        err = MAX (err, do_save (Ap, Ai, Ax, isreal, Symbolic, Numeric,
+            Common)) ;
+        err = MAX (err, do_refine (Ap, Ai, Ax, isreal, Symbolic, Numeric,
+            Common)) ;
+        err = MAX (err, do_spsolve (isreal, Symbolic, Numeric, Common)) ;
+        err = MAX (err, do_repivot (Ap, Ai, Ax, isreal, Symbolic, Common)) ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* free factorization and temporary matrices, and return */
     /* ---------------------------------------------------------------------- */
@@ -764,6 +1843,59 @@ static double do_1_solve (cholmod_sparse *A, cholmod_dense *B,
 }
 
 
+/* ========================================================================== */
+/* === do_dense_singular ==================================================== */
+/* ========================================================================== */
+
+/* Factorize singular 20-by-20 matrices with the dense kernel:  a numerically
+ * singular matrix of all ones (of rank 1), and a matrix whose 5th column is
+ * empty.  BTF is not used, so that each is a single block. */
+
+static void do_dense_singular (KLU_common *Common)
+{
+    Int Ap [21], Ai [400] ;
+    double Ax [400] ;
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric ;
+    Int i, j, k, nz, n = 20 ;
+
+    Common->btf = FALSE ;
+    Common->dense = 1e-6 ;
+    for (k = 0 ; k <= 1 ; k++)
+    {
+        nz = 0 ;
+        for (j = 0 ; j < n ; j++)
+        {
+            Ap [j] = nz ;
+            for (i = 0 ; i < n ; i++)
+            {
+                if (k == 1 && j == 4) continue ;
+                Ai [nz] = i ;
+                Ax [nz] = (k == 0) ? 1 : (1 + i + i*j*j) ;
+                nz++ ;
+            }
+        }
+        Ap [n] = nz ;
+        Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+        OK (Symbolic) ;
+        for (Common->halt_if_singular = 0 ; Common->halt_if_singular <= 1 ;
+            Common->halt_if_singular++)
+        {
+            Numeric = klu_factor (Ap, Ai, Ax, Symbolic, Common) ;
+            OK (Common->status == KLU_SINGULAR) ;
+            OK (Common->numerical_rank >= 0 && Common->numerical_rank < n) ;
+            OK (Common->halt_if_singular ? (Numeric == NULL) :
+                (Numeric != NULL)) ;
+            klu_free_numeric (&Numeric, Common) ;
+        }
+        klu_free_symbolic (&Symbolic, Common) ;
+    }
+    Common->btf = TRUE ;
+    Common->dense = 0 ;
+    Common->halt_if_singular = TRUE ;
+}
+
+
 /* ========================================================================== */
 /* === do_solves ============================================================ */
 /* ========================================================================== */
@@ -774,7 +1906,7 @@ static double do_solves (cholmod_sparse *A, cholmod_dense *B, cholmod_dense *X,
     Int *Puser, Int *Quser, KLU_common *Common, cholmod_common *ch, Int *isnan)
 {
     double err, maxerr = 0 ;
-    Int n = A->nrow, sflag ;
+    Int n = A->nrow, sflag, scale ;
     *isnan = FALSE ;
 
     /* ---------------------------------------------------------------------- */
@@ -783,6 +1915,39 @@ static double do_solves (cholmod_sparse *A, cholmod_dense *B, cholmod_dense *X,
 
     maxerr = do_1_solve (A, B, X, NULL, NULL, Common, ch, isnan) ;
 
+    /* ---------------------------------------------------------------------- */
+    /* factorize the blocks of the BTF form in parallel */
+    /* ---------------------------------------------------------------------- */
+
+    Common->nthreads = 4 ;
+    for (Common->halt_if_singular = 0 ; Common->halt_if_singular <= 1 ;
+        Common->halt_if_singular++)
+    {
+        err = do_1_solve (A, B, X, NULL, NULL, Common, ch, isnan) ;
+        maxerr = MAX (maxerr, err) ;
+    }
+    Common->halt_if_singular = TRUE ;
+    Common->nthreads = 1 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize all blocks of size 16 or more with the dense kernel */
+    /* ---------------------------------------------------------------------- */
+
+    scale = Common->scale ;
+    Common->dense = 1e-6 ;
+    for (Common->halt_if_singular = 0 ; Common->halt_if_singular <= 1 ;
+        Common->halt_if_singular++)
+    {
+        for (Common->scale = 0 ; Common->scale <= 2 ; Common->scale++)
+        {
+            err = do_1_solve (A, B, X, NULL, NULL, Common, ch, isnan) ;
+            maxerr = MAX (maxerr, err) ;
+        }
+    }
+    Common->halt_if_singular = TRUE ;
+    Common->scale = scale ;
+    Common->dense = 0 ;
+
     /* ---------------------------------------------------------------------- */
     /* test with non-default options */
     /* ---------------------------------------------------------------------- */
@@ -1034,6 +2199,30 @@ int main (void)
     FAIL (klu_z_tsolve (NULL, NULL, 0, 0, NULL, 0, NULL)) ;
     FAIL (klu_z_tsolve (NULL, NULL, 0, 0, NULL, 0, &Common)) ;
 
+    FAIL (klu_factor_batch (NULL, NULL, NULL, 0, NULL, NULL, NULL)) ;
+    FAIL (klu_factor_batch (NULL, NULL, NULL, 0, NULL, NULL, &Common)) ;
+
+    FAIL (klu_z_factor_batch (NULL, NULL, NULL, 0, NULL, NULL, NULL)) ;
+    FAIL (klu_z_factor_batch (NULL, NULL, NULL, 0, NULL, NULL, &Common)) ;
+
+    FAIL (klu_refactor_batch (NULL, NULL, NULL, NULL, NULL, NULL, NULL)) ;
+    FAIL (klu_refactor_batch (NULL, NULL, NULL, NULL, NULL, NULL, &Common)) ;
+
+    FAIL (klu_z_refactor_batch (NULL, NULL, NULL, NULL, NULL, NULL, NULL)) ;
+    FAIL (klu_z_refactor_batch (NULL, NULL, NULL, NULL, NULL, NULL, &Common)) ;
+
+    FAIL (klu_solve_batch (NULL, NULL, NULL, 0, NULL, NULL)) ;
+    FAIL (klu_solve_batch (NULL, NULL, NULL, 0, NULL, &Common)) ;
+
+    FAIL (klu_z_solve_batch (NULL, NULL, NULL, 0, NULL, NULL)) ;
+    FAIL (klu_z_solve_batch (NULL, NULL, NULL, 0, NULL, &Common)) ;
+
+    FAIL (klu_free_batch (NULL, NULL)) ;
+    OK (klu_free_batch (NULL, &Common)) ;
+
+    FAIL (klu_z_free_batch (NULL, NULL)) ;
+    OK (klu_z_free_batch (NULL, &Common)) ;
+
     FAIL (klu_malloc (0, 0, NULL)) ;
     FAIL (klu_malloc (0, 0, &Common)) ;
     FAIL (klu_malloc (Int_MAX, 1, &Common)) ;
@@ -1171,6 +2360,8 @@ int main (void)
     /* tests with valid symbolic factorization */
     /* ---------------------------------------------------------------------- */
 
+    do_dense_singular (&Common) ;
+
     Common.halt_if_singular = FALSE ;
     Common.scale = 0 ;
     Numeric = NULL ;
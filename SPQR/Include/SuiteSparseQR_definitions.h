@@ -24,6 +24,14 @@
  * tried.  If there is a high fill-in with AMD then try METIS(A'A) and take
  * the best of AMD and METIS.  METIS is not tried if it isn't installed. */
 
+/* scheduler for the task tree of the numeric factorization, given by
+ * Common->SPQR_scheduler.  The one used is returned in Common->SPQR_istat [8].
+ * If the one requested is not available, the default is used. */
+#define SPQR_SCHEDULE_DEFAULT 0     /* TBB, else OpenMP, else serial */
+#define SPQR_SCHEDULE_SERIAL 1      /* do the tasks one at a time */
+#define SPQR_SCHEDULE_TBB 2         /* TBB tasks (if compiled with HAVE_TBB) */
+#define SPQR_SCHEDULE_OPENMP 3      /* OpenMP tasks (if compiled with OpenMP) */
+
 /* tol options */
 #define SPQR_DEFAULT_TOL (-2)       /* if tol <= -2, the default tol is used */
 #define SPQR_NO_TOL (-1)            /* if -2 < tol < 0, then no tol is used */
@@ -308,11 +308,13 @@ cholmod_c_src = {
     '../../CHOLMOD/Check/cholmod_check', ...
     '../../CHOLMOD/Check/cholmod_read', ...
     '../../CHOLMOD/Check/cholmod_write', ...
+    '../../CHOLMOD/Check/cholmod_save', ...
     '../../CHOLMOD/Cholesky/cholmod_amd', ...
     '../../CHOLMOD/Cholesky/cholmod_analyze', ...
     '../../CHOLMOD/Cholesky/cholmod_colamd', ...
     '../../CHOLMOD/Cholesky/cholmod_etree', ...
     '../../CHOLMOD/Cholesky/cholmod_factorize', ...
+    '../../CHOLMOD/Cholesky/cholmod_ichol', ...
     '../../CHOLMOD/Cholesky/cholmod_postorder', ...
     '../../CHOLMOD/Cholesky/cholmod_rcond', ...
     '../../CHOLMOD/Cholesky/cholmod_resymbol', ...
@@ -491,23 +491,16 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
 
     if (ntasks == 1)
     {
-        // Just one task, with or without TBB installed: don't use TBB
+        // Just one task: don't use TBB or OpenMP
+        cc->SPQR_istat [8] = SPQR_SCHEDULE_SERIAL ;
         spqr_kernel (0, &Blob) ;        // sequential case
     }
     else
     {
-#ifdef HAVE_TBB
-        // parallel case: TBB is installed, and there is more than one task
+        // more than one task: use TBB, OpenMP, or do them one at a time,
+        // as selected by cc->SPQR_scheduler
         int nthreads = MAX (0, cc->SPQR_nthreads) ;
         spqr_parallel (ntasks, nthreads, &Blob) ;
-#else
-        // TBB not installed, but the work is still split into multiple tasks.
-        // do tasks 0 to ntasks-2 (skip the placeholder root task id = ntasks-1)
-        for (Long id = 0 ; id < ntasks-1 ; id++)
-        {
-            spqr_kernel (id, &Blob) ;
-        }
-#endif
     }
 
     PR (("] did the kernel\n")) ;
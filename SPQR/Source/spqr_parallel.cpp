@@ -2,11 +2,17 @@
 // === spqr_parallel ===========================================================
 // =============================================================================
 
-// Factorize all the tasks in parallel with TBB.
-// The GPU is not used.
+// Factorize all the tasks of the task tree, with TBB tasks, OpenMP tasks, or
+// one at a time, as selected by cc->SPQR_scheduler.  Each task is done only
+// after all of its children in the tree, since it assembles their
+// contribution blocks.  The GPU is not used.
 
-#ifdef HAVE_TBB
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef HAVE_TBB
 #include <tbb/task_scheduler_init.h>
 #include <tbb/task.h>
 
@@ -77,10 +83,10 @@ template <typename Entry> class spqr_zippy: public task
 
 
 // =============================================================================
-// === spqr_parallel ===========================================================
+// === spqr_tbb ================================================================
 // =============================================================================
 
-template <typename Entry> void spqr_parallel
+template <typename Entry> void spqr_tbb
 (
     Long ntasks,
     int nthreads,
@@ -94,6 +100,108 @@ template <typename Entry> void spqr_parallel
         spqr_zippy <Entry> (ntasks-1, Blob) ;
     task::spawn_root_and_wait (a) ;
 }
+#endif
+
+#ifdef _OPENMP
+// =============================================================================
+// === spqr_omp_subtree ========================================================
+// =============================================================================
+
+// Do all the tasks in the subtree rooted at task id: the same traversal as
+// spqr_zippy, with an OpenMP task for each child.
+
+template <typename Entry> void spqr_omp_subtree
+(
+    Long id,
+    spqr_blob <Entry> *Blob
+)
+{
+    Long *TaskChildp = Blob->QRsym->TaskChildp ;
+    Long *TaskChild  = Blob->QRsym->TaskChild ;
+
+    // do each child subtree as its own task, and wait for all of them
+    for (Long p = TaskChildp [id] ; p < TaskChildp [id+1] ; p++)
+    {
+        Long child = TaskChild [p] ;
+        #pragma omp task firstprivate (child)
+        spqr_omp_subtree (child, Blob) ;
+    }
+    #pragma omp taskwait
+
+    // children are done, do my own task
+    spqr_kernel (id, Blob) ;
+}
+#endif
+
+// =============================================================================
+// === spqr_parallel ===========================================================
+// =============================================================================
+
+template <typename Entry> void spqr_parallel
+(
+    Long ntasks,
+    int nthreads,
+    spqr_blob <Entry> *Blob
+)
+{
+
+    // -------------------------------------------------------------------------
+    // determine the scheduler to use
+    // -------------------------------------------------------------------------
+
+    cholmod_common *cc = Blob->cc ;
+    int scheduler = cc->SPQR_scheduler ;
+#ifndef HAVE_TBB
+    if (scheduler == SPQR_SCHEDULE_TBB) scheduler = SPQR_SCHEDULE_DEFAULT ;
+#endif
+#ifndef _OPENMP
+    if (scheduler == SPQR_SCHEDULE_OPENMP) scheduler = SPQR_SCHEDULE_DEFAULT ;
+#endif
+    if (scheduler != SPQR_SCHEDULE_SERIAL && scheduler != SPQR_SCHEDULE_TBB &&
+        scheduler != SPQR_SCHEDULE_OPENMP)
+    {
+#if defined (HAVE_TBB)
+        scheduler = SPQR_SCHEDULE_TBB ;
+#elif defined (_OPENMP)
+        scheduler = SPQR_SCHEDULE_OPENMP ;
+#else
+        scheduler = SPQR_SCHEDULE_SERIAL ;
+#endif
+    }
+    cc->SPQR_istat [8] = scheduler ;
+
+    // -------------------------------------------------------------------------
+    // do the tasks
+    // -------------------------------------------------------------------------
+
+#ifdef HAVE_TBB
+    if (scheduler == SPQR_SCHEDULE_TBB)
+    {
+        spqr_tbb (ntasks, nthreads, Blob) ;
+        return ;
+    }
+#endif
+
+#ifdef _OPENMP
+    if (scheduler == SPQR_SCHEDULE_OPENMP)
+    {
+        // one thread starts at the root id = ntasks-1; the others take the
+        // tasks it creates
+        if (nthreads <= 0) nthreads = omp_get_max_threads ( ) ;
+        #pragma omp parallel num_threads (nthreads)
+        #pragma omp single
+        spqr_omp_subtree (ntasks-1, Blob) ;
+        return ;
+    }
+#endif
+
+    // do tasks 0 to ntasks-2 (skip the placeholder root task id = ntasks-1).
+    // Each child task has a smaller id than its parent.
+    for (Long id = 0 ; id < ntasks-1 ; id++)
+    {
+        spqr_kernel (id, Blob) ;
+    }
+}
 
 // =============================================================================
 
@@ -110,5 +218,3 @@ template void spqr_parallel <Complex>
     int nthreads,
     spqr_blob <Complex> *Blob
 ) ;
-
-#endif
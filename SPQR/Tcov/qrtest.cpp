@@ -2600,6 +2600,93 @@ template <typename Entry> void qrtest
 }
 
 
+// =============================================================================
+// === do_scheduler ============================================================
+// =============================================================================
+
+// Factorize A with the task tree (cc->SPQR_grain > 1), once with the serial
+// scheduler and once with OpenMP, and check that R and E are identical and
+// that SPQR_istat [8] reports the scheduler that was used.  Returns 1 if the
+// test fails, 0 otherwise.
+
+template <typename Entry> int do_scheduler2
+(
+    cholmod_sparse *A,
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *R [2] ;
+    Long *E [2], used [2], expected [2] ;
+    int scheduler [2] = { SPQR_SCHEDULE_SERIAL, SPQR_SCHEDULE_OPENMP } ;
+    Long m = A->nrow ;
+    Long n = A->ncol ;
+    int ok = TRUE ;
+
+    // use the task tree even for tiny matrices
+    double small = cc->SPQR_small ;
+    cc->SPQR_small = 1 ;
+    for (int k = 0 ; k < 2 ; k++)
+    {
+        cc->SPQR_scheduler = scheduler [k] ;
+        SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL, m, A,
+            &R [k], &E [k], cc) ;
+        used [k] = cc->SPQR_istat [8] ;
+        // a single task is always done in serial.  A scheduler that is not
+        // compiled in falls back to TBB, else OpenMP, else serial.
+        expected [k] = SPQR_SCHEDULE_SERIAL ;
+        if (scheduler [k] == SPQR_SCHEDULE_OPENMP && cc->SPQR_istat [3] > 1)
+        {
+            #if defined (_OPENMP)
+            expected [k] = SPQR_SCHEDULE_OPENMP ;
+            #elif defined (HAVE_TBB)
+            expected [k] = SPQR_SCHEDULE_TBB ;
+            #endif
+        }
+        ok = ok && (R [k] != NULL) && (used [k] == expected [k]) ;
+    }
+    cc->SPQR_scheduler = SPQR_SCHEDULE_DEFAULT ;
+    cc->SPQR_small = small ;
+
+    // R and E must be bitwise identical
+    if (ok)
+    {
+        Long rnz = ((Long *) R [0]->p) [n] ;
+        ok = (R [0]->nrow == R [1]->nrow) && (R [0]->ncol == R [1]->ncol) &&
+            memcmp (R [0]->p, R [1]->p, (n+1) * sizeof (Long)) == 0 ;
+        ok = ok && memcmp (R [0]->i, R [1]->i, rnz * sizeof (Long)) == 0 &&
+            memcmp (R [0]->x, R [1]->x, rnz * sizeof (Entry)) == 0 ;
+        ok = ok && ((E [0] == NULL && E [1] == NULL) ||
+            (E [0] != NULL && E [1] != NULL &&
+            memcmp (E [0], E [1], n * sizeof (Long)) == 0)) ;
+    }
+
+    printf ("scheduler: serial %ld openmp %ld (ntasks %ld) : %s\n",
+        used [0], used [1], cc->SPQR_istat [3], ok ? "OK" : "FAIL") ;
+    for (int k = 0 ; k < 2 ; k++)
+    {
+        cholmod_l_free_sparse (&R [k], cc) ;
+        cholmod_l_free (n, sizeof (Long), E [k], cc) ;
+    }
+    return (ok ? 0 : 1) ;
+}
+
+int do_scheduler (cholmod_sparse *A, cholmod_common *cc)
+{
+    int nfail = 0 ;
+    if (A->xtype == CHOLMOD_COMPLEX && A->stype == 0)
+    {
+        nfail = do_scheduler2 <Complex> (A, cc) ;
+    }
+    else if (A->xtype == CHOLMOD_REAL)
+    {
+        cholmod_sparse *A1 = cholmod_l_copy (A, 0, 1, cc) ;
+        nfail = do_scheduler2 <double> (A1, cc) ;
+        cholmod_l_free_sparse (&A1, cc) ;
+    }
+    return (nfail) ;
+}
+
+
 // =============================================================================
 // === do_matrix ===============================================================
 // =============================================================================
@@ -2647,6 +2734,14 @@ int do_matrix (int kind, FILE *file, cholmod_common *cc)
     // non-defaults to test TBB, if installed (will not use the GPU)
     cc->SPQR_grain = 4 ;         // grain size relative to total work
     nfail2 = do_matrix2 (kind, A, cc) ;
+
+    // the same task tree, with the tasks done one at a time
+    cc->SPQR_scheduler = SPQR_SCHEDULE_SERIAL ;
+    nfail2 += do_matrix2 (kind, A, cc) ;
+    cc->SPQR_scheduler = SPQR_SCHEDULE_DEFAULT ;
+
+    // the serial and OpenMP schedulers must give the same R and E
+    nfail2 += do_scheduler (A, cc) ;
     cc->SPQR_grain = 1 ;         // no parallel analysis
     printf ("\nCPU tests done ]\n") ;
 
@@ -304,6 +304,8 @@ SUITESPARSE_VERSION = 5.6.0
     # -DNSUPERNODAL do not include the Supernodal module.
     #
     # -DNPRINT      do not print anything.
+    # -DNMMAP       do not use mmap to read Matrix Market files in parallel
+    #               in cholmod_read (reads with fscanf-style parsing instead).
     # -D'LONGBLAS=long' or -DLONGBLAS='long long' defines the integers used by
     #               LAPACK and the BLAS (defaults to 'int')
     # -DNSUNPERF    for Solaris only.  If defined, do not use the Sun
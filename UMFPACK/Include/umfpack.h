@@ -11,8 +11,30 @@
     This is the umfpack.h include file, and should be included in all user code
     that uses UMFPACK.  Do not include any of the umf_* header files in user
     code.  All routines in UMFPACK starting with "umfpack_" are user-callable.
-    All other routines are prefixed "umf_XY_", (where X is d or z, and Y is
-    i or l) and are not user-callable.
+    All other routines are prefixed "umf_XY_", (where X is d, z, s, or c, and
+    Y is i or l) and are not user-callable.
+
+    Most user-callable routines come in eight versions.  The umfpack_di_*,
+    umfpack_dl_*, umfpack_zi_*, and umfpack_zl_* routines are for real and
+    complex matrices, with int or SuiteSparse_long integers.  The
+    umfpack_si_*, umfpack_sl_*, umfpack_ci_*, and umfpack_cl_* routines have
+    exactly the same arguments as their umfpack_di_*, umfpack_dl_*,
+    umfpack_zi_*, and umfpack_zl_* counterparts (A, X, B, and all other
+    floating-point arguments are double), but they compute and store the LU
+    factors in single precision (float, or complex float).  This halves the
+    memory used for the numerical values of the LU factors and the frontal
+    matrices, and the factorization uses the faster single precision BLAS.
+    Forward/backsolves and iterative refinement are done in double precision,
+    with the residual computed from the double precision matrix A, so
+    umfpack_*_solve with iterative refinement (Control [UMFPACK_IRSTEP]) can
+    recover a solution with a double precision backward error if A is not
+    too ill-conditioned (roughly, if cond(A) is much less than 1/FLT_EPSILON,
+    or about 1e7).  Each step of iterative refinement reduces the error by a
+    factor of about cond(A)*FLT_EPSILON, so more steps than the default may be
+    needed.  Systems that do not use iterative refinement (such as
+    UMFPACK_L or UMFPACK_Pt_L) are solved only to single precision accuracy.
+    The Symbolic and Numeric objects of each version can be used only by
+    routines of the same version.
 */
 
 #ifndef UMFPACK_H
@@ -45,6 +67,7 @@ extern "C" {
 /* Primary routines: */
 #include "umfpack_symbolic.h"
 #include "umfpack_numeric.h"
+#include "umfpack_renumeric.h"
 #include "umfpack_solve.h"
 #include "umfpack_free_symbolic.h"
 #include "umfpack_free_numeric.h"
@@ -53,6 +76,11 @@ extern "C" {
 #include "umfpack_defaults.h"
 #include "umfpack_qsymbolic.h"
 #include "umfpack_wsolve.h"
+#include "umfpack_msolve.h"
+#include "umfpack_refactor.h"
+#include "umfpack_queue.h"
+#include "umfpack_qsolve.h"
+#include "umfpack_free_queue.h"
 
 /* Matrix manipulation routines: */
 #include "umfpack_triplet_to_col.h"
@@ -66,6 +94,8 @@ extern "C" {
 #include "umfpack_get_symbolic.h"
 #include "umfpack_save_numeric.h"
 #include "umfpack_load_numeric.h"
+#include "umfpack_save_numeric_mmap.h"
+#include "umfpack_load_numeric_mmap.h"
 #include "umfpack_save_symbolic.h"
 #include "umfpack_load_symbolic.h"
 #include "umfpack_get_determinant.h"
@@ -159,7 +189,7 @@ extern "C" {
 #define UMFPACK_SIZE_OF_INT 4		/* sizeof (int) */
 #define UMFPACK_SIZE_OF_LONG 5		/* sizeof (SuiteSparse_long) */
 #define UMFPACK_SIZE_OF_POINTER 6	/* sizeof (void *) */
-#define UMFPACK_SIZE_OF_ENTRY 7		/* sizeof (Entry), real or complex */
+#define UMFPACK_SIZE_OF_ENTRY 7		/* sizeof (Entry) of the LU factors */
 #define UMFPACK_NDENSE_ROW 8		/* number of dense rows */
 #define UMFPACK_NEMPTY_ROW 9		/* number of empty rows */
 #define UMFPACK_NDENSE_COL 10		/* number of dense rows */
@@ -183,7 +213,13 @@ extern "C" {
 #define UMFPACK_SYMMETRIC_NDENSE 38	/* # of "dense" rows/cols in S+S' */
 #define UMFPACK_SYMMETRIC_DMAX 39	/* max nz in cols of L, for AMD */
 
-/* 51:55 unused */
+/* computed in UMFPACK_refactor: */
+#define UMFPACK_REFACTORED 51		/* 1 if prior pivots were reused */
+
+/* computed in UMFPACK_numeric: */
+#define UMFPACK_NUMERIC_DEFRAG_TIME 52	/* realloc & garbage collection time */
+
+/* 53:55 unused */
 
 /* statistcs for singleton pruning */
 #define UMFPACK_COL_SINGLETONS 56	/* # of column singletons */
@@ -249,7 +285,10 @@ extern "C" {
 #define UMFPACK_SOLVE_TIME 85	    /* solve time (seconds) */
 #define UMFPACK_SOLVE_WALLTIME 86   /* solve time (wall clock, seconds) */
 
-/* Info [87, 88, 89] unused */
+/* computed in UMFPACK_qsolve: */
+#define UMFPACK_QSOLVE_NRHS 87	    /* # of rhs solved in the same block */
+
+/* Info [88, 89] unused */
 
 /* Unused parts of Info may be used in future versions of UMFPACK. */
 
@@ -334,6 +373,9 @@ extern "C" {
 #define UMFPACK_DEFAULT_ORDERING UMFPACK_ORDERING_AMD
 #define UMFPACK_DEFAULT_SINGLETONS TRUE
 
+/* default block size for umfpack_*_queue (not a Control parameter): */
+#define UMFPACK_DEFAULT_QUEUE_NRHS 64
+
 /* default values of Control may change in future versions of UMFPACK. */
 
 /* -------------------------------------------------------------------------- */
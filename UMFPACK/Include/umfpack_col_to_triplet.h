@@ -35,6 +35,34 @@ SuiteSparse_long umfpack_zl_col_to_triplet
     SuiteSparse_long Tj [ ]
 ) ;
 
+int umfpack_si_col_to_triplet
+(
+    int n_col,
+    const int Ap [ ],
+    int Tj [ ]
+) ;
+
+SuiteSparse_long umfpack_sl_col_to_triplet
+(
+    SuiteSparse_long n_col,
+    const SuiteSparse_long Ap [ ],
+    SuiteSparse_long Tj [ ]
+) ;
+
+int umfpack_ci_col_to_triplet
+(
+    int n_col,
+    const int Ap [ ],
+    int Tj [ ]
+) ;
+
+SuiteSparse_long umfpack_cl_col_to_triplet
+(
+    SuiteSparse_long n_col,
+    const SuiteSparse_long Ap [ ],
+    SuiteSparse_long Tj [ ]
+) ;
+
 /*
 double int Syntax:
 
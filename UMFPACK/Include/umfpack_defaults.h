@@ -27,6 +27,26 @@ void umfpack_zl_defaults
     double Control [UMFPACK_CONTROL]
 ) ;
 
+void umfpack_si_defaults
+(
+    double Control [UMFPACK_CONTROL]
+) ;
+
+void umfpack_sl_defaults
+(
+    double Control [UMFPACK_CONTROL]
+) ;
+
+void umfpack_ci_defaults
+(
+    double Control [UMFPACK_CONTROL]
+) ;
+
+void umfpack_cl_defaults
+(
+    double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
@@ -27,6 +27,26 @@ void umfpack_zl_free_numeric
     void **Numeric
 ) ;
 
+void umfpack_si_free_numeric
+(
+    void **Numeric
+) ;
+
+void umfpack_sl_free_numeric
+(
+    void **Numeric
+) ;
+
+void umfpack_ci_free_numeric
+(
+    void **Numeric
+) ;
+
+void umfpack_cl_free_numeric
+(
+    void **Numeric
+) ;
+
 /*
 double int Syntax:
 
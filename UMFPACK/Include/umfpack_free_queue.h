@@ -0,0 +1,87 @@
+/* ========================================================================== */
+/* === umfpack_free_queue =================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+void umfpack_di_free_queue
+(
+    void **Queue
+) ;
+
+void umfpack_dl_free_queue
+(
+    void **Queue
+) ;
+
+void umfpack_zi_free_queue
+(
+    void **Queue
+) ;
+
+void umfpack_zl_free_queue
+(
+    void **Queue
+) ;
+
+void umfpack_si_free_queue
+(
+    void **Queue
+) ;
+
+void umfpack_sl_free_queue
+(
+    void **Queue
+) ;
+
+void umfpack_ci_free_queue
+(
+    void **Queue
+) ;
+
+void umfpack_cl_free_queue
+(
+    void **Queue
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    umfpack_di_free_queue (&Queue) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    umfpack_dl_free_queue (&Queue) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    umfpack_zi_free_queue (&Queue) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    umfpack_zl_free_queue (&Queue) ;
+
+Purpose:
+
+    Deallocates the Queue object and sets the Queue handle to NULL.  The
+    Numeric object used by the Queue is not free'd.  No thread may be using
+    the Queue (in umfpack_*_qsolve) when it is free'd.
+
+Arguments:
+
+    void **Queue ;	    Input argument, set to (void *) NULL on output.
+
+	Queue points to a valid Queue object, computed by umfpack_*_queue.
+	No action is taken if Queue is a (void *) NULL pointer.
+*/
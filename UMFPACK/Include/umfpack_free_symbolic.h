@@ -27,6 +27,26 @@ void umfpack_zl_free_symbolic
     void **Symbolic
 ) ;
 
+void umfpack_si_free_symbolic
+(
+    void **Symbolic
+) ;
+
+void umfpack_sl_free_symbolic
+(
+    void **Symbolic
+) ;
+
+void umfpack_ci_free_symbolic
+(
+    void **Symbolic
+) ;
+
+void umfpack_cl_free_symbolic
+(
+    void **Symbolic
+) ;
+
 /*
 double int Syntax:
 
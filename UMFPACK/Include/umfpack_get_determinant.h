@@ -41,6 +41,40 @@ SuiteSparse_long umfpack_zl_get_determinant
     double User_Info [UMFPACK_INFO]
 ) ;
 
+int umfpack_si_get_determinant
+(
+    double *Mx,
+    double *Ex,
+    void *NumericHandle,
+    double User_Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_sl_get_determinant
+(
+    double *Mx,
+    double *Ex,
+    void *NumericHandle,
+    double User_Info [UMFPACK_INFO]
+) ;
+
+int umfpack_ci_get_determinant
+(
+    double *Mx,
+    double *Mz,
+    double *Ex,
+    void *NumericHandle,
+    double User_Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_cl_get_determinant
+(
+    double *Mx,
+    double *Mz,
+    double *Ex,
+    void *NumericHandle,
+    double User_Info [UMFPACK_INFO]
+) ;
+
 /*
 double int Syntax:
 
@@ -47,6 +47,46 @@ SuiteSparse_long umfpack_zl_get_lunz
     void *Numeric
 ) ;
 
+int umfpack_si_get_lunz
+(
+    int *lnz,
+    int *unz,
+    int *n_row,
+    int *n_col,
+    int *nz_udiag,
+    void *Numeric
+) ;
+
+SuiteSparse_long umfpack_sl_get_lunz
+(
+    SuiteSparse_long *lnz,
+    SuiteSparse_long *unz,
+    SuiteSparse_long *n_row,
+    SuiteSparse_long *n_col,
+    SuiteSparse_long *nz_udiag,
+    void *Numeric
+) ;
+
+int umfpack_ci_get_lunz
+(
+    int *lnz,
+    int *unz,
+    int *n_row,
+    int *n_col,
+    int *nz_udiag,
+    void *Numeric
+) ;
+
+SuiteSparse_long umfpack_cl_get_lunz
+(
+    SuiteSparse_long *lnz,
+    SuiteSparse_long *unz,
+    SuiteSparse_long *n_row,
+    SuiteSparse_long *n_col,
+    SuiteSparse_long *nz_udiag,
+    void *Numeric
+) ;
+
 /*
 double int Syntax:
 
@@ -71,6 +71,70 @@ SuiteSparse_long umfpack_zl_get_numeric
     void *Numeric
 ) ;
 
+int umfpack_si_get_numeric
+(
+    int Lp [ ],
+    int Lj [ ],
+    double Lx [ ],
+    int Up [ ],
+    int Ui [ ],
+    double Ux [ ],
+    int P [ ],
+    int Q [ ],
+    double Dx [ ],
+    int *do_recip,
+    double Rs [ ],
+    void *Numeric
+) ;
+
+SuiteSparse_long umfpack_sl_get_numeric
+(
+    SuiteSparse_long Lp [ ],
+    SuiteSparse_long Lj [ ],
+    double Lx [ ],
+    SuiteSparse_long Up [ ],
+    SuiteSparse_long Ui [ ],
+    double Ux [ ],
+    SuiteSparse_long P [ ],
+    SuiteSparse_long Q [ ],
+    double Dx [ ],
+    SuiteSparse_long *do_recip,
+    double Rs [ ],
+    void *Numeric
+) ;
+
+int umfpack_ci_get_numeric
+(
+    int Lp [ ],
+    int Lj [ ],
+    double Lx [ ], double Lz [ ],
+    int Up [ ],
+    int Ui [ ],
+    double Ux [ ], double Uz [ ],
+    int P [ ],
+    int Q [ ],
+    double Dx [ ], double Dz [ ],
+    int *do_recip,
+    double Rs [ ],
+    void *Numeric
+) ;
+
+SuiteSparse_long umfpack_cl_get_numeric
+(
+    SuiteSparse_long Lp [ ],
+    SuiteSparse_long Lj [ ],
+    double Lx [ ], double Lz [ ],
+    SuiteSparse_long Up [ ],
+    SuiteSparse_long Ui [ ],
+    double Ux [ ], double Uz [ ],
+    SuiteSparse_long P [ ],
+    SuiteSparse_long Q [ ],
+    double Dx [ ], double Dz [ ],
+    SuiteSparse_long *do_recip,
+    double Rs [ ],
+    void *Numeric
+) ;
+
 /*
 double int Syntax:
 
@@ -87,6 +87,86 @@ SuiteSparse_long umfpack_zl_get_symbolic
     void *Symbolic
 ) ;
 
+int umfpack_si_get_symbolic
+(
+    int *n_row,
+    int *n_col,
+    int *n1,
+    int *nz,
+    int *nfr,
+    int *nchains,
+    int P [ ],
+    int Q [ ],
+    int Front_npivcol [ ],
+    int Front_parent [ ],
+    int Front_1strow [ ],
+    int Front_leftmostdesc [ ],
+    int Chain_start [ ],
+    int Chain_maxrows [ ],
+    int Chain_maxcols [ ],
+    void *Symbolic
+) ;
+
+SuiteSparse_long umfpack_sl_get_symbolic
+(
+    SuiteSparse_long *n_row,
+    SuiteSparse_long *n_col,
+    SuiteSparse_long *n1,
+    SuiteSparse_long *nz,
+    SuiteSparse_long *nfr,
+    SuiteSparse_long *nchains,
+    SuiteSparse_long P [ ],
+    SuiteSparse_long Q [ ],
+    SuiteSparse_long Front_npivcol [ ],
+    SuiteSparse_long Front_parent [ ],
+    SuiteSparse_long Front_1strow [ ],
+    SuiteSparse_long Front_leftmostdesc [ ],
+    SuiteSparse_long Chain_start [ ],
+    SuiteSparse_long Chain_maxrows [ ],
+    SuiteSparse_long Chain_maxcols [ ],
+    void *Symbolic
+) ;
+
+int umfpack_ci_get_symbolic
+(
+    int *n_row,
+    int *n_col,
+    int *n1,
+    int *nz,
+    int *nfr,
+    int *nchains,
+    int P [ ],
+    int Q [ ],
+    int Front_npivcol [ ],
+    int Front_parent [ ],
+    int Front_1strow [ ],
+    int Front_leftmostdesc [ ],
+    int Chain_start [ ],
+    int Chain_maxrows [ ],
+    int Chain_maxcols [ ],
+    void *Symbolic
+) ;
+
+SuiteSparse_long umfpack_cl_get_symbolic
+(
+    SuiteSparse_long *n_row,
+    SuiteSparse_long *n_col,
+    SuiteSparse_long *n1,
+    SuiteSparse_long *nz,
+    SuiteSparse_long *nfr,
+    SuiteSparse_long *nchains,
+    SuiteSparse_long P [ ],
+    SuiteSparse_long Q [ ],
+    SuiteSparse_long Front_npivcol [ ],
+    SuiteSparse_long Front_parent [ ],
+    SuiteSparse_long Front_1strow [ ],
+    SuiteSparse_long Front_leftmostdesc [ ],
+    SuiteSparse_long Chain_start [ ],
+    SuiteSparse_long Chain_maxrows [ ],
+    SuiteSparse_long Chain_maxcols [ ],
+    void *Symbolic
+) ;
+
 /*
 
 double int Syntax:
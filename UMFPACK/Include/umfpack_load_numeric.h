@@ -31,6 +31,30 @@ SuiteSparse_long umfpack_zl_load_numeric
     char *filename
 ) ;
 
+int umfpack_si_load_numeric
+(
+    void **Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_sl_load_numeric
+(
+    void **Numeric,
+    char *filename
+) ;
+
+int umfpack_ci_load_numeric
+(
+    void **Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_cl_load_numeric
+(
+    void **Numeric,
+    char *filename
+) ;
+
 /*
 double int Syntax:
 
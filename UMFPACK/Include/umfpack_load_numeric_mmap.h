@@ -0,0 +1,139 @@
+/* ========================================================================== */
+/* === umfpack_load_numeric_mmap ============================================ */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+int umfpack_di_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_dl_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+int umfpack_zi_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_zl_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+int umfpack_si_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_sl_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+int umfpack_ci_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_cl_load_numeric_mmap
+(
+    void **Numeric,
+    char *filename
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    int status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_di_load_numeric_mmap (&Numeric, filename) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    SuiteSparse_long status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_dl_load_numeric_mmap (&Numeric, filename) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    int status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_zi_load_numeric_mmap (&Numeric, filename) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    SuiteSparse_long status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_zl_load_numeric_mmap (&Numeric, filename) ;
+
+Purpose:
+
+    Loads a Numeric object from a file created by umfpack_*_save_numeric_mmap,
+    without copying the LU factors.  The file is mapped into memory with
+    mmap, and the Numeric object refers to the arrays in the mapped file.
+    Only a small header of the Numeric object is allocated.  Loading is thus
+    nearly instantaneous, and the pages of the file are read on demand, the
+    first time the Numeric object is used.  If several processes load the
+    same file, they all share a single copy of it in the operating system's
+    page cache.
+
+    The mapping is private:  if the Numeric object is modified (only
+    umfpack_*_refactor does this), the modified pages are copied first, and
+    the file itself is never changed.  The file must not be modified or
+    truncated while the Numeric object is in use.  The mapping is released by
+    umfpack_*_free_numeric.
+
+    If the file cannot be mapped, or if UMFPACK is compiled with -DNPOSIX
+    (which is the default for Microsoft Windows), the file is read into a
+    single block of memory instead.
+
+    The Numeric handle passed to this routine is overwritten with the new
+    object.  If that object exists prior to calling this routine, a memory
+    leak will occur.  The contents of Numeric are ignored on input.
+
+Returns:
+
+    UMFPACK_OK if successful.
+    UMFPACK_ERROR_out_of_memory if not enough memory is available.
+    UMFPACK_ERROR_file_IO if an I/O error occurred.
+    UMFPACK_ERROR_invalid_Numeric_object if the file was not created by
+	umfpack_*_save_numeric_mmap, was created by a different version of
+	UMFPACK, or is truncated or corrupted.
+
+Arguments:
+
+    void **Numeric ;	    Output argument.
+
+	**Numeric is the address of a (void *) pointer variable in the user's
+	calling routine (see Syntax, above).  On input, the contents of this
+	variable are not defined.  On output, this variable holds a (void *)
+	pointer to the Numeric object (if successful), or (void *) NULL if
+	a failure occurred.
+
+    char *filename ;	    Input argument, not modified.
+
+	A string that contains the filename from which to read the Numeric
+	object.
+*/
@@ -31,6 +31,30 @@ SuiteSparse_long umfpack_zl_load_symbolic
     char *filename
 ) ;
 
+int umfpack_si_load_symbolic
+(
+    void **Symbolic,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_sl_load_symbolic
+(
+    void **Symbolic,
+    char *filename
+) ;
+
+int umfpack_ci_load_symbolic
+(
+    void **Symbolic,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_cl_load_symbolic
+(
+    void **Symbolic,
+    char *filename
+) ;
+
 /*
 double int Syntax:
 
@@ -0,0 +1,231 @@
+/* ========================================================================== */
+/* === umfpack_msolve ======================================================= */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+int umfpack_di_msolve
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    int nrhs,
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_dl_msolve
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    SuiteSparse_long nrhs,
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_zi_msolve
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    int nrhs,
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_zl_msolve
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    SuiteSparse_long nrhs,
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_si_msolve
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    int nrhs,
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_sl_msolve
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    SuiteSparse_long nrhs,
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_ci_msolve
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    int nrhs,
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_cl_msolve
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    SuiteSparse_long nrhs,
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int status, *Ap, *Ai, sys, nrhs ;
+    double *B, *X, *Ax, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    status = umfpack_di_msolve (sys, Ap, Ai, Ax, nrhs, X, B, Numeric,
+	Control, Info) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    SuiteSparse_long status, *Ap, *Ai, sys, nrhs ;
+    double *B, *X, *Ax, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    status = umfpack_dl_msolve (sys, Ap, Ai, Ax, nrhs, X, B, Numeric,
+	Control, Info) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int status, *Ap, *Ai, sys, nrhs ;
+    double *Bx, *Bz, *Xx, *Xz, *Ax, *Az, Info [UMFPACK_INFO],
+	Control [UMFPACK_CONTROL] ;
+    status = umfpack_zi_msolve (sys, Ap, Ai, Ax, Az, nrhs, Xx, Xz, Bx, Bz,
+	Numeric, Control, Info) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    SuiteSparse_long status, *Ap, *Ai, sys, nrhs ;
+    double *Bx, *Bz, *Xx, *Xz, *Ax, *Az, Info [UMFPACK_INFO],
+	Control [UMFPACK_CONTROL] ;
+    status = umfpack_zl_msolve (sys, Ap, Ai, Ax, Az, nrhs, Xx, Xz, Bx, Bz,
+	Numeric, Control, Info) ;
+
+packed complex Syntax:
+
+    Same as above, except Az, Xz, and Bz are NULL.
+
+Purpose:
+
+    Given LU factors computed by umfpack_*_numeric (PAQ=LU), solve a linear
+    system for nrhs right-hand sides at once.  The result is the same as
+    calling umfpack_*_solve once for each column of B, but for Ax=b the
+    right-hand sides are solved together in blocks of 16, so that each
+    column of L and row of U is read from memory once per block rather than
+    once per right-hand side.  If UMFPACK is compiled with OpenMP, the blocks
+    are solved in parallel.  Iterative refinement, if requested, is done
+    separately for each right-hand side.
+
+    For the other systems (A'x=b, Lx=b, and so on), the columns of B are
+    solved one at a time with the same method as umfpack_*_solve.
+
+Returns:
+
+    The status code is returned.  See Info [UMFPACK_STATUS], below.
+
+Arguments:
+
+    Int sys ;		Input argument, not modified.
+    Int Ap [n+1] ;	Input argument, not modified.
+    Int Ai [nz] ;	Input argument, not modified.
+    double Ax [nz] ;	Input argument, not modified.
+			Size 2*nz in packed complex case.
+    void *Numeric ;	Input argument, not modified.
+    double Control [UMFPACK_CONTROL] ;	Input argument, not modified.
+
+	Identical to umfpack_*_solve.
+
+    Int nrhs ;		Input argument, not modified.
+
+	The number of right-hand sides (columns of B and X).  If nrhs is zero,
+	X is not accessed.  nrhs must not be negative.
+
+    double X [n*nrhs] ;	Output argument.
+    double B [n*nrhs] ;	Input argument, not modified.
+
+	X and B are n-by-nrhs dense matrices, stored in column-major order.
+	Column j of B is in B [j*n ... (j+1)*n-1], and column j of X is
+	computed from it exactly as umfpack_*_solve would.
+
+    for complex versions:
+    double Az [nz] ;	Input argument, not modified, imaginary part
+    double Xx [n*nrhs] ; Output argument, real part.
+			Size 2*n*nrhs in packed complex case.
+    double Xz [n*nrhs] ; Output argument, imaginary part
+    double Bx [n*nrhs] ; Input argument, not modified, real part.
+			Size 2*n*nrhs in packed complex case.
+    double Bz [n*nrhs] ; Input argument, not modified, imaginary part
+
+	In the packed complex case, column j of X is in Xx [2*j*n ...
+	2*(j+1)*n-1], with real and imaginary parts interleaved, and likewise
+	for B.
+
+    double Info [UMFPACK_INFO] ;	Output argument.
+
+	Identical to umfpack_*_solve, except for the following.
+	Info [UMFPACK_STATUS] is UMFPACK_ERROR_n_nonpositive if nrhs < 0.
+	Info [UMFPACK_SOLVE_FLOPS] is the total flop count for all right-hand
+	sides.  Info [UMFPACK_IR_TAKEN], Info [UMFPACK_IR_ATTEMPTED],
+	Info [UMFPACK_OMEGA1], and Info [UMFPACK_OMEGA2] are the largest values
+	for any single right-hand side.
+
+    Workspace of size O(t*n*16) is allocated, where t is the number of OpenMP
+    threads used (at most one per block of 16 right-hand sides).
+*/
@@ -51,6 +51,50 @@ SuiteSparse_long umfpack_zl_numeric
     double Info [UMFPACK_INFO]
 ) ;
 
+int umfpack_si_numeric
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_sl_numeric
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_ci_numeric
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_cl_numeric
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
 /*
 double int Syntax:
 
@@ -474,6 +518,13 @@ Arguments:
 	    memory space is fragmented, then the number of "costly" realloc's
 	    will be equal to Info [UMFPACK_NUMERIC_REALLOC].
 
+	Info [UMFPACK_NUMERIC_DEFRAG_TIME]:  The wall clock time, in seconds,
+	    spent enlarging and compacting the variable-sized workspace (the
+	    reallocations and garbage collections counted above, including
+	    the time to rebuild the internal lists of elements afterwards).
+	    See umfpack_*_renumeric for a way to avoid this cost when many
+	    matrices are factorized.
+
 	Info [UMFPACK_COMPRESSED_PATTERN]:  The number of integers used to
 	    represent the pattern of L and U.
 
@@ -0,0 +1,184 @@
+/* ========================================================================== */
+/* === umfpack_qsolve ======================================================= */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+int umfpack_di_qsolve
+(
+    double X [ ],
+    const double B [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_dl_qsolve
+(
+    double X [ ],
+    const double B [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_zi_qsolve
+(
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_zl_qsolve
+(
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_si_qsolve
+(
+    double X [ ],
+    const double B [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_sl_qsolve
+(
+    double X [ ],
+    const double B [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_ci_qsolve
+(
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_cl_qsolve
+(
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Queue,
+    double Info [UMFPACK_INFO]
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    int status ;
+    double *B, *X, Info [UMFPACK_INFO] ;
+    status = umfpack_di_qsolve (X, B, Queue, Info) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    SuiteSparse_long status ;
+    double *B, *X, Info [UMFPACK_INFO] ;
+    status = umfpack_dl_qsolve (X, B, Queue, Info) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    int status ;
+    double *Bx, *Bz, *Xx, *Xz, Info [UMFPACK_INFO] ;
+    status = umfpack_zi_qsolve (Xx, Xz, Bx, Bz, Queue, Info) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Queue ;
+    SuiteSparse_long status ;
+    double *Bx, *Bz, *Xx, *Xz, Info [UMFPACK_INFO] ;
+    status = umfpack_zl_qsolve (Xx, Xz, Bx, Bz, Queue, Info) ;
+
+packed complex Syntax:
+
+    Same as above, except Xz and Bz are NULL.
+
+Purpose:
+
+    Solves the system given to umfpack_*_queue for one right-hand side b,
+    and returns when x has been computed.  Any number of threads may call
+    umfpack_*_qsolve with the same Queue at the same time; this is the
+    intended use.  No thread is created.  Instead, while one calling thread
+    solves a block of right-hand sides with umfpack_*_msolve, the requests
+    of the other callers accumulate in the Queue.  When the block is done,
+    one of the waiting callers takes the next block of up to max_nrhs
+    requests, in the order they arrived, and solves them.  With many
+    concurrent callers, the blocks fill up, and the throughput approaches
+    that of umfpack_*_msolve.  With a single caller, each right-hand side is
+    solved on its own, at about the cost of umfpack_*_solve.
+
+    The solution x is computed by umfpack_*_msolve, and agrees with that of
+    umfpack_*_solve for the same b to within roundoff.
+
+    If UMFPACK is compiled with -DNPOSIX, there are no locks, and each call
+    solves its own right-hand side with umfpack_*_msolve.  Calling
+    umfpack_*_qsolve from many threads is still safe.
+
+    The Numeric object must not be modified (by umfpack_*_refactor, for
+    example) or free'd while any thread is using the Queue.
+
+Returns:
+
+    The status code is returned.  See Info [UMFPACK_STATUS], below.
+
+Arguments:
+
+    double X [n] ;	Output argument.
+    double B [n] ;	Input argument, not modified.
+
+	The solution vector x and right-hand side b, of size n, where the
+	Numeric object is n-by-n.
+
+    for complex versions:
+    double Xx [n or 2n] ; Output argument, real part
+			  Size 2*n in packed complex case.
+    double Xz [n] ;	  Output argument, imaginary part.
+    double Bx [n or 2n] ; Input argument, not modified, real part.
+			  Size 2*n in packed complex case.
+    double Bz [n] ;	  Input argument, not modified, imaginary part.
+
+	As in umfpack_*_solve.  Each caller may use either the split or the
+	packed form.
+
+    void *Queue ;	Input argument, not modified.
+
+	The Queue object created by umfpack_*_queue.  Its contents are
+	modified while the call is in progress, but they are restored when it
+	returns.
+
+    double Info [UMFPACK_INFO] ;	Output argument.
+
+	Info may be a (double *) NULL pointer, in which case it is ignored.
+	Otherwise, the entries set by umfpack_*_msolve for the block in which b
+	was solved are returned (Info [UMFPACK_STATUS], Info [UMFPACK_NROW],
+	Info [UMFPACK_NCOL], and Info [UMFPACK_IR_TAKEN] through
+	Info [UMFPACK_SOLVE_WALLTIME]).  The flop count and the times are
+	those of the whole block, which may include other callers' right-hand
+	sides.  In addition:
+
+	Info [UMFPACK_QSOLVE_NRHS]: the number of right-hand sides solved in
+	    that block, including this one.
+
+	Info [UMFPACK_STATUS] is UMFPACK_ERROR_invalid_Numeric_object if Queue
+	is not a valid Queue object, and UMFPACK_ERROR_argument_missing if X or
+	B is NULL.  Otherwise it is the status returned by umfpack_*_msolve.
+	Since Info is the same for all right-hand sides in a block, the caller
+	should not use the same Info array in two threads at once.
+
+    Workspace is allocated by umfpack_*_msolve for each block.
+*/
@@ -0,0 +1,211 @@
+/* ========================================================================== */
+/* === umfpack_queue ======================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+int umfpack_di_queue
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    int max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_dl_queue
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    SuiteSparse_long max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_zi_queue
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    int max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_zl_queue
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    SuiteSparse_long max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_si_queue
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    int max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_sl_queue
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    SuiteSparse_long max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_ci_queue
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    int max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_cl_queue
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    SuiteSparse_long max_nrhs,
+    void *Numeric,
+    void **Queue,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    void *Numeric, *Queue ;
+    int status, *Ap, *Ai, sys, max_nrhs ;
+    double *Ax, Control [UMFPACK_CONTROL] ;
+    status = umfpack_di_queue (sys, Ap, Ai, Ax, max_nrhs, Numeric, &Queue,
+	Control) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Numeric, *Queue ;
+    SuiteSparse_long status, *Ap, *Ai, sys, max_nrhs ;
+    double *Ax, Control [UMFPACK_CONTROL] ;
+    status = umfpack_dl_queue (sys, Ap, Ai, Ax, max_nrhs, Numeric, &Queue,
+	Control) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    void *Numeric, *Queue ;
+    int status, *Ap, *Ai, sys, max_nrhs ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL] ;
+    status = umfpack_zi_queue (sys, Ap, Ai, Ax, Az, max_nrhs, Numeric, &Queue,
+	Control) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Numeric, *Queue ;
+    SuiteSparse_long status, *Ap, *Ai, sys, max_nrhs ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL] ;
+    status = umfpack_zl_queue (sys, Ap, Ai, Ax, Az, max_nrhs, Numeric, &Queue,
+	Control) ;
+
+packed complex Syntax:
+
+    Same as above, except Az is NULL.
+
+Purpose:
+
+    Creates a Queue object for solving many linear systems with the LU
+    factors in a Numeric object, one right-hand side at a time, from any
+    number of threads at once.  Each thread calls umfpack_*_qsolve with its
+    own b and x.  Right-hand sides that are submitted at about the same time
+    are solved together, in blocks of up to max_nrhs, by umfpack_*_msolve.
+    This gives much higher throughput than calling umfpack_*_solve from each
+    thread, since the LU factors are read from memory once per block rather
+    than once per right-hand side.  See umfpack_qsolve.h for details.
+
+    The Numeric object, and Ap, Ai, Ax, and Az, if given, are not copied.
+    They must not be modified or free'd until the Queue has been free'd by
+    umfpack_*_free_queue.  Control is copied.
+
+Returns:
+
+    UMFPACK_OK if successful.
+    UMFPACK_ERROR_argument_missing if Queue is NULL.
+    UMFPACK_ERROR_invalid_Numeric_object if Numeric is not valid.
+    UMFPACK_ERROR_invalid_system if the matrix is not square.
+    UMFPACK_ERROR_out_of_memory if out of memory.
+
+Arguments:
+
+    Int sys ;		Input argument, not modified.
+    Int Ap [n+1] ;	Input argument, not modified.
+    Int Ai [nz] ;	Input argument, not modified.
+    double Ax [nz] ;	Input argument, not modified.
+			Size 2*nz in packed complex case.
+    double Az [nz] ;	Input argument, not modified, for complex versions.
+
+	The system to solve, and the matrix A, exactly as in umfpack_*_solve.
+	The same system is solved for all right-hand sides submitted to this
+	Queue.  A is only needed for iterative refinement; Ap, Ai, and Ax may
+	be NULL if Control [UMFPACK_IRSTEP] is zero or sys is not one of
+	UMFPACK_A, UMFPACK_At, or UMFPACK_Aat.
+
+    Int max_nrhs ;	Input argument, not modified.
+
+	The largest number of right-hand sides solved together.  If max_nrhs
+	is zero or negative, UMFPACK_DEFAULT_QUEUE_NRHS (64) is used.
+
+    void *Numeric ;	Input argument, not modified.
+
+	Numeric must point to a valid Numeric object, computed by
+	umfpack_*_numeric.  The Queue keeps a pointer to it.
+
+    void **Queue ;	Output argument.
+
+	**Queue is the address of a (void *) pointer variable in the user's
+	calling routine (see Syntax, above).  On input, the contents of this
+	variable are not defined.  On output, this variable holds a (void *)
+	pointer to the Queue object (if successful), or (void *) NULL if a
+	failure occurred.
+
+    double Control [UMFPACK_CONTROL] ;	Input argument, not modified.
+
+	If a (double *) NULL pointer is passed, then the default control
+	settings are used.  Only Control [UMFPACK_IRSTEP] is used, as in
+	umfpack_*_solve.
+
+    Workspace of size 2*n*max_nrhs*sizeof(double) (twice that in the complex
+    case) is allocated, and kept in the Queue object.
+*/
@@ -0,0 +1,265 @@
+/* ========================================================================== */
+/* === umfpack_refactor ===================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+int umfpack_di_refactor
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_dl_refactor
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_zi_refactor
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_zl_refactor
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_si_refactor
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_sl_refactor
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_ci_refactor
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_cl_refactor
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int *Ap, *Ai, status ;
+    double *Ax, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    status = umfpack_di_refactor (Ap, Ai, Ax, Symbolic, &Numeric, Control,
+	Info) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    SuiteSparse_long *Ap, *Ai, status ;
+    double *Ax, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    status = umfpack_dl_refactor (Ap, Ai, Ax, Symbolic, &Numeric, Control,
+	Info) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int *Ap, *Ai, status ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    status = umfpack_zi_refactor (Ap, Ai, Ax, Az, Symbolic, &Numeric,
+	Control, Info) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    SuiteSparse_long *Ap, *Ai, status ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    status = umfpack_zl_refactor (Ap, Ai, Ax, Az, Symbolic, &Numeric,
+	Control, Info) ;
+
+packed complex Syntax:
+
+    Same as above, except that Az is NULL.
+
+Purpose:
+
+    Given a Numeric object computed by umfpack_*_numeric for a matrix A, this
+    routine computes the LU factors of a new matrix with the same nonzero
+    pattern as A but different numerical values, such as the Jacobian of a
+    nonlinear system at successive Newton steps, or the matrix of a circuit
+    simulation at successive time steps.  If possible, the row and column
+    permutations, and the nonzero pattern of L and U, are reused from the
+    prior factorization, and only the numerical values of L, U, and the row
+    scale factors are recomputed.  This is much faster than umfpack_*_numeric,
+    since no pivot search, frontal matrix assembly, or memory management is
+    performed.
+
+    The prior pivot sequence is reused only if the prior factorization was
+    square and nonsingular, and only if each pivot in the new factorization
+    is nonzero and passes the same partial pivoting threshold test that
+    umfpack_*_numeric used when it chose that pivot (Control
+    [UMFPACK_PIVOT_TOLERANCE], or Control [UMFPACK_SYM_PIVOT_TOLERANCE] for
+    diagonal pivots with the symmetric strategy, from the call to
+    umfpack_*_numeric).  It also fails if a nonzero entry in the new matrix,
+    or in its LU factors, falls outside the pattern of the prior L and U
+    (other than an entry that is negligible because of cancellation).  This
+    can occur if an entry in the prior L or U was exactly zero, since
+    umfpack_*_numeric may discard such entries.  In any of these cases, the
+    matrix is factorized from scratch with umfpack_*_renumeric, with a new
+    pivot sequence, recycling the memory of the prior Numeric object.
+    Info [UMFPACK_REFACTORED] reports which method was used.
+
+    The first call to umfpack_*_refactor for a given Numeric object
+    constructs a column-oriented map of the LU factors, which is kept in the
+    Numeric object and reused by subsequent calls.  This map is not saved by
+    umfpack_*_save_numeric.
+
+Returns:
+
+    The status code is returned.  See Info [UMFPACK_STATUS], below.
+
+Arguments:
+
+    Int Ap [n_col+1] ;	Input argument, not modified.
+    Int Ai [nz] ;	Input argument, not modified.
+    double Ax [nz] ;	Input argument, not modified.
+			Size 2*nz for packed complex case.
+    double Az [nz] ;	Input argument, not modified, for complex versions.
+
+	The new matrix A, in the same form as for umfpack_*_numeric.  Its
+	pattern must be the same as the matrix given to umfpack_*_symbolic or
+	umfpack_*_qsymbolic (and umfpack_*_numeric).  Unlike those routines,
+	no check is made that the pattern of A is the same as the matrix
+	analyzed by umfpack_*_*symbolic, except that if the prior pivot
+	sequence cannot be used, the check made by umfpack_*_numeric applies.
+
+    void *Symbolic ;	Input argument, not modified.
+
+	The Symbolic object used by umfpack_*_numeric to compute the prior
+	Numeric object.
+
+    void **Numeric ;	Input and output argument.
+
+	On input, *Numeric is the Numeric object computed by
+	umfpack_*_numeric (or a prior call to umfpack_*_refactor), for the
+	same Symbolic object.  On output, it holds the factorization of the new
+	matrix.  If the prior pivot sequence is reused, *Numeric is not
+	changed, and the LU factors it contains are overwritten.  Otherwise, the
+	prior Numeric object is freed, and *Numeric is set to the new object
+	returned by umfpack_*_renumeric (which is (void *) NULL if
+	umfpack_*_renumeric fails).
+
+    double Control [UMFPACK_CONTROL] ;	Input argument, not modified.
+
+	Used only if the matrix must be factorized from scratch, in which case
+	it is passed to umfpack_*_numeric.  If the pivot sequence is reused,
+	the pivot tolerances and the scaling method of the prior factorization
+	are used instead.
+
+    double Info [UMFPACK_INFO] ;	Output argument.
+
+	If the matrix is factorized from scratch, Info is returned exactly as
+	by umfpack_*_numeric, with Info [UMFPACK_REFACTORED] set to zero.
+	Otherwise, the following are set, and the remaining entries that
+	umfpack_*_numeric would set are set to -1.
+
+	Info [UMFPACK_STATUS]: status code.  This is also the return value,
+	    whether or not the Info array is present.
+
+	    UMFPACK_OK
+
+		The prior pivot sequence was reused, or umfpack_*_numeric was
+		successful.
+
+	    UMFPACK_WARNING_singular_matrix
+
+		The ratio of the smallest and largest entries on the diagonal of
+		U underflowed to zero, or umfpack_*_numeric found the matrix to
+		be singular.
+
+	    UMFPACK_ERROR_invalid_Symbolic_object
+	    UMFPACK_ERROR_argument_missing
+
+		As for umfpack_*_numeric.
+
+	    UMFPACK_ERROR_invalid_Numeric_object
+
+		*Numeric is not a valid Numeric object, or its dimensions do not
+		match the Symbolic object.
+
+	    UMFPACK_ERROR_invalid_matrix
+
+		The column pointers, Ap, or row indices, Ai, are invalid.
+
+	    Any error returned by umfpack_*_numeric, if the matrix had to be
+	    factorized from scratch.
+
+	Info [UMFPACK_REFACTORED]: 1 if the prior pivot sequence was reused,
+	    0 if the matrix was factorized by umfpack_*_numeric.
+
+	Info [UMFPACK_NROW], Info [UMFPACK_NCOL], Info [UMFPACK_NZ],
+	Info [UMFPACK_SIZE_OF_UNIT], Info [UMFPACK_NUMERIC_SIZE],
+	Info [UMFPACK_FLOPS], Info [UMFPACK_LNZ], Info [UMFPACK_UNZ],
+	Info [UMFPACK_LU_ENTRIES], Info [UMFPACK_UDIAG_NZ],
+	Info [UMFPACK_RSMIN], Info [UMFPACK_RSMAX], Info [UMFPACK_WAS_SCALED],
+	Info [UMFPACK_UMIN], Info [UMFPACK_UMAX], Info [UMFPACK_RCOND],
+	Info [UMFPACK_NUMERIC_TIME], Info [UMFPACK_NUMERIC_WALLTIME]:
+
+	    As for umfpack_*_numeric.  Info [UMFPACK_FLOPS] is the flop count
+	    of the refactorization.
+*/
@@ -0,0 +1,227 @@
+/* ========================================================================== */
+/* === umfpack_renumeric ==================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+int umfpack_di_renumeric
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_dl_renumeric
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_zi_renumeric
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_zl_renumeric
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_si_renumeric
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_sl_renumeric
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_ci_renumeric
+(
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+SuiteSparse_long umfpack_cl_renumeric
+(
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int *Ap, *Ai, status ;
+    double *Ax, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    Numeric = (void *) NULL ;
+    for (each matrix A with the same pattern)
+    {
+	status = umfpack_di_renumeric (Ap, Ai, Ax, Symbolic, &Numeric,
+	    Control, Info) ;
+	...
+    }
+    umfpack_di_free_numeric (&Numeric) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    SuiteSparse_long *Ap, *Ai, status ;
+    double *Ax, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    status = umfpack_dl_renumeric (Ap, Ai, Ax, Symbolic, &Numeric, Control,
+	Info) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int *Ap, *Ai, status ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    status = umfpack_zi_renumeric (Ap, Ai, Ax, Az, Symbolic, &Numeric,
+	Control, Info) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    SuiteSparse_long *Ap, *Ai, status ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    status = umfpack_zl_renumeric (Ap, Ai, Ax, Az, Symbolic, &Numeric,
+	Control, Info) ;
+
+packed complex Syntax:
+
+    Same as above, except that Az is NULL.
+
+Purpose:
+
+    Identical to umfpack_*_numeric, except that the Numeric object from a
+    prior factorization can be passed in, and its memory is recycled for the
+    new factorization.  This is useful when many matrices are factorized in
+    sequence, such as the Jacobians of a nonlinear system at successive
+    Newton steps.
+
+    During factorization, umfpack_*_numeric uses a single variable-sized
+    workspace that holds the LU factors and the frontal matrices.  It starts
+    at an estimated size, and whenever it runs out of space it compacts the
+    workspace (garbage collection) and enlarges it with realloc.  When done,
+    it reduces the workspace to hold just the LU factors.  This routine
+    differs in two ways:
+
+    (1) If *Numeric is a Numeric object on input, its workspace becomes the
+	workspace of the new factorization, with no call to malloc, provided
+	it is at least as large as the workspace that the prior factorization
+	ended with.  Otherwise it is replaced with a block of that size.
+	Either way, a factorization similar to the prior one starts with
+	about as much memory as it needs.  Since fewer garbage collections
+	leave the workspace more fragmented, a call or two may be needed
+	before the workspace is large enough that no reallocations or
+	garbage collections occur at all.  The rest of the prior Numeric
+	object is freed.
+
+    (2) The workspace is not reduced at the end of the factorization, so
+	that it can be recycled in turn.  The Numeric object thus holds the
+	peak amount of memory used during the factorization, rather than just
+	the LU factors.  Use umfpack_*_numeric instead if memory space is more
+	important than the time to allocate it.
+
+    The number of garbage collections and reallocations, and the time spent
+    in them, are returned in Info [UMFPACK_NUMERIC_DEFRAG],
+    Info [UMFPACK_NUMERIC_REALLOC], and Info [UMFPACK_NUMERIC_DEFRAG_TIME].
+
+    umfpack_*_refactor uses this routine when it cannot reuse the prior
+    pivot sequence.
+
+    To size the workspace without a prior Numeric object, use
+    Control [UMFPACK_ALLOC_INIT] with umfpack_*_numeric or this routine.  If
+    negative, -Control [UMFPACK_ALLOC_INIT] is the initial size of the
+    workspace, in Units (see Info [UMFPACK_SIZE_OF_UNIT]).
+
+Returns:
+
+    As for umfpack_*_numeric.  In addition:
+
+    UMFPACK_ERROR_invalid_Numeric_object
+
+	*Numeric is not NULL, and not a valid Numeric object.  It is not
+	modified.
+
+Arguments:
+
+    Int Ap [n_col+1] ;	Input argument, not modified.
+    Int Ai [nz] ;	Input argument, not modified.
+    double Ax [nz] ;	Input argument, not modified.
+			Size 2*nz for packed complex case.
+    double Az [nz] ;	Input argument, not modified, for complex versions.
+    void *Symbolic ;	Input argument, not modified.
+    double Control [UMFPACK_CONTROL] ;	Input argument, not modified.
+
+	As for umfpack_*_numeric.
+
+    void **Numeric ;	Input and output argument.
+
+	On input, *Numeric is either (void *) NULL, or a valid Numeric object
+	computed by umfpack_*_numeric, umfpack_*_renumeric,
+	umfpack_*_refactor, umfpack_*_load_numeric, or
+	umfpack_*_load_numeric_mmap (the memory of a mapped Numeric object is
+	not recycled, however).  It need not come from the same Symbolic
+	object.  It is always freed (unless UMFPACK_ERROR_invalid_Numeric_object
+	is returned).  On output, *Numeric holds the new Numeric object, or
+	(void *) NULL if an error occurred.
+
+    double Info [UMFPACK_INFO] ;	Output argument.
+
+	As for umfpack_*_numeric.  Info [UMFPACK_NUMERIC_SIZE] and
+	Info [UMFPACK_VARIABLE_FINAL] give the space used by the LU factors,
+	not the total size of the workspace held in the Numeric object, which
+	is Info [UMFPACK_VARIABLE_PEAK] or more.
+*/
@@ -27,6 +27,26 @@ void umfpack_zl_report_control
     const double Control [UMFPACK_CONTROL]
 ) ;
 
+void umfpack_si_report_control
+(
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+void umfpack_sl_report_control
+(
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+void umfpack_ci_report_control
+(
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+void umfpack_cl_report_control
+(
+    const double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
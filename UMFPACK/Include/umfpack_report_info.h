@@ -31,6 +31,30 @@ void umfpack_zl_report_info
     const double Info [UMFPACK_INFO]
 ) ;
 
+void umfpack_si_report_info
+(
+    const double Control [UMFPACK_CONTROL],
+    const double Info [UMFPACK_INFO]
+) ;
+
+void umfpack_sl_report_info
+(
+    const double Control [UMFPACK_CONTROL],
+    const double Info [UMFPACK_INFO]
+) ;
+
+void umfpack_ci_report_info
+(
+    const double Control [UMFPACK_CONTROL],
+    const double Info [UMFPACK_INFO]
+) ;
+
+void umfpack_cl_report_info
+(
+    const double Control [UMFPACK_CONTROL],
+    const double Info [UMFPACK_INFO]
+) ;
+
 /*
 double int Syntax:
 
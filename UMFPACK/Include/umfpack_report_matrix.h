@@ -51,6 +51,50 @@ SuiteSparse_long umfpack_zl_report_matrix
     const double Control [UMFPACK_CONTROL]
 ) ;
 
+int umfpack_si_report_matrix
+(
+    int n_row,
+    int n_col,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    int col_form,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_sl_report_matrix
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    SuiteSparse_long col_form,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_ci_report_matrix
+(
+    int n_row,
+    int n_col,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    int col_form,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_cl_report_matrix
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    SuiteSparse_long col_form,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
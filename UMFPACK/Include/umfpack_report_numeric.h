@@ -31,6 +31,30 @@ SuiteSparse_long umfpack_zl_report_numeric
     const double Control [UMFPACK_CONTROL]
 ) ;
 
+int umfpack_si_report_numeric
+(
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_sl_report_numeric
+(
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_ci_report_numeric
+(
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_cl_report_numeric
+(
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
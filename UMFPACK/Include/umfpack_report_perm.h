@@ -35,6 +35,34 @@ SuiteSparse_long umfpack_zl_report_perm
     const double Control [UMFPACK_CONTROL]
 ) ;
 
+int umfpack_si_report_perm
+(
+    int np,
+    const int Perm [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_sl_report_perm
+(
+    SuiteSparse_long np,
+    const SuiteSparse_long Perm [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_ci_report_perm
+(
+    int np,
+    const int Perm [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_cl_report_perm
+(
+    SuiteSparse_long np,
+    const SuiteSparse_long Perm [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
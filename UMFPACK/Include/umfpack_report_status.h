@@ -31,6 +31,30 @@ void umfpack_zl_report_status
     SuiteSparse_long status
 ) ;
 
+void umfpack_si_report_status
+(
+    const double Control [UMFPACK_CONTROL],
+    int status
+) ;
+
+void umfpack_sl_report_status
+(
+    const double Control [UMFPACK_CONTROL],
+    SuiteSparse_long status
+) ;
+
+void umfpack_ci_report_status
+(
+    const double Control [UMFPACK_CONTROL],
+    int status
+) ;
+
+void umfpack_cl_report_status
+(
+    const double Control [UMFPACK_CONTROL],
+    SuiteSparse_long status
+) ;
+
 /*
 double int Syntax:
 
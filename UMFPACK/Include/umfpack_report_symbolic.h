@@ -31,6 +31,30 @@ SuiteSparse_long umfpack_zl_report_symbolic
     const double Control [UMFPACK_CONTROL]
 ) ;
 
+int umfpack_si_report_symbolic
+(
+    void *Symbolic,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_sl_report_symbolic
+(
+    void *Symbolic,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_ci_report_symbolic
+(
+    void *Symbolic,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_cl_report_symbolic
+(
+    void *Symbolic,
+    const double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
@@ -51,6 +51,50 @@ SuiteSparse_long umfpack_zl_report_triplet
     const double Control [UMFPACK_CONTROL]
 ) ;
 
+int umfpack_si_report_triplet
+(
+    int n_row,
+    int n_col,
+    int nz,
+    const int Ti [ ],
+    const int Tj [ ],
+    const double Tx [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_sl_report_triplet
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    SuiteSparse_long nz,
+    const SuiteSparse_long Ti [ ],
+    const SuiteSparse_long Tj [ ],
+    const double Tx [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_ci_report_triplet
+(
+    int n_row,
+    int n_col,
+    int nz,
+    const int Ti [ ],
+    const int Tj [ ],
+    const double Tx [ ], const double Tz [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_cl_report_triplet
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    SuiteSparse_long nz,
+    const SuiteSparse_long Ti [ ],
+    const SuiteSparse_long Tj [ ],
+    const double Tx [ ], const double Tz [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
@@ -35,6 +35,34 @@ SuiteSparse_long umfpack_zl_report_vector
     const double Control [UMFPACK_CONTROL]
 ) ;
 
+int umfpack_si_report_vector
+(
+    int n,
+    const double X [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_sl_report_vector
+(
+    SuiteSparse_long n,
+    const double X [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+int umfpack_ci_report_vector
+(
+    int n,
+    const double Xx [ ], const double Xz [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
+SuiteSparse_long umfpack_cl_report_vector
+(
+    SuiteSparse_long n,
+    const double Xx [ ], const double Xz [ ],
+    const double Control [UMFPACK_CONTROL]
+) ;
+
 /*
 double int Syntax:
 
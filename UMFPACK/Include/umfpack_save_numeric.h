@@ -31,6 +31,30 @@ SuiteSparse_long umfpack_zl_save_numeric
     char *filename
 ) ;
 
+int umfpack_si_save_numeric
+(
+    void *Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_sl_save_numeric
+(
+    void *Numeric,
+    char *filename
+) ;
+
+int umfpack_ci_save_numeric
+(
+    void *Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_cl_save_numeric
+(
+    void *Numeric,
+    char *filename
+) ;
+
 /*
 double int Syntax:
 
@@ -0,0 +1,122 @@
+/* ========================================================================== */
+/* === umfpack_save_numeric_mmap ============================================ */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+int umfpack_di_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_dl_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+int umfpack_zi_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_zl_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+int umfpack_si_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_sl_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+int umfpack_ci_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_cl_save_numeric_mmap
+(
+    void *Numeric,
+    char *filename
+) ;
+
+/*
+double int Syntax:
+
+    #include "umfpack.h"
+    int status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_di_save_numeric_mmap (Numeric, filename) ;
+
+double SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    SuiteSparse_long status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_dl_save_numeric_mmap (Numeric, filename) ;
+
+complex int Syntax:
+
+    #include "umfpack.h"
+    int status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_zi_save_numeric_mmap (Numeric, filename) ;
+
+complex SuiteSparse_long Syntax:
+
+    #include "umfpack.h"
+    SuiteSparse_long status ;
+    char *filename ;
+    void *Numeric ;
+    status = umfpack_zl_save_numeric_mmap (Numeric, filename) ;
+
+Purpose:
+
+    Saves a Numeric object to a file, which can later be mapped into memory
+    by umfpack_*_load_numeric_mmap.  The file holds the same information as
+    the file written by umfpack_*_save_numeric, but each array (the LU
+    factors, the permutations, and so on) starts on a 4096-byte boundary, so
+    that it can be used in place, without being copied, when the file is
+    mapped.  The two file formats are not interchangeable:  a file written by
+    umfpack_*_save_numeric_mmap can only be read by
+    umfpack_*_load_numeric_mmap, with the same version (di, dl, zi, zl, si,
+    sl, ci, or cl) of UMFPACK, on the same kind of computer.  The Numeric
+    object is not modified.
+
+Returns:
+
+    UMFPACK_OK if successful.
+    UMFPACK_ERROR_invalid_Numeric_object if Numeric is not valid.
+    UMFPACK_ERROR_file_IO if an I/O error occurred.
+
+Arguments:
+
+    void *Numeric ;	    Input argument, not modified.
+
+	Numeric must point to a valid Numeric object, computed by
+	umfpack_*_numeric or loaded by umfpack_*_load_numeric or
+	umfpack_*_load_numeric_mmap.
+
+    char *filename ;	    Input argument, not modified.
+
+	A string that contains the filename to which the Numeric
+	object is written.
+*/
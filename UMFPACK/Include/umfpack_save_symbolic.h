@@ -31,6 +31,30 @@ SuiteSparse_long umfpack_zl_save_symbolic
     char *filename
 ) ;
 
+int umfpack_si_save_symbolic
+(
+    void *Symbolic,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_sl_save_symbolic
+(
+    void *Symbolic,
+    char *filename
+) ;
+
+int umfpack_ci_save_symbolic
+(
+    void *Symbolic,
+    char *filename
+) ;
+
+SuiteSparse_long umfpack_cl_save_symbolic
+(
+    void *Symbolic,
+    char *filename
+) ;
+
 /*
 double int Syntax:
 
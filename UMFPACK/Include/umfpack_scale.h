@@ -35,6 +35,34 @@ SuiteSparse_long umfpack_zl_scale
     void *Numeric
 ) ;
 
+int umfpack_si_scale
+(
+    double X [ ],
+    const double B [ ],
+    void *Numeric
+) ;
+
+SuiteSparse_long umfpack_sl_scale
+(
+    double X [ ],
+    const double B [ ],
+    void *Numeric
+) ;
+
+int umfpack_ci_scale
+(
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric
+) ;
+
+SuiteSparse_long umfpack_cl_scale
+(
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric
+) ;
+
 /*
 double int Syntax:
 
@@ -65,6 +65,64 @@ SuiteSparse_long umfpack_zl_transpose
     SuiteSparse_long do_conjugate
 ) ;
 
+int umfpack_si_transpose
+(
+    int n_row,
+    int n_col,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    const int P [ ],
+    const int Q [ ],
+    int Rp [ ],
+    int Ri [ ],
+    double Rx [ ]
+) ;
+
+SuiteSparse_long umfpack_sl_transpose
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    const SuiteSparse_long P [ ],
+    const SuiteSparse_long Q [ ],
+    SuiteSparse_long Rp [ ],
+    SuiteSparse_long Ri [ ],
+    double Rx [ ]
+) ;
+
+int umfpack_ci_transpose
+(
+    int n_row,
+    int n_col,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    const int P [ ],
+    const int Q [ ],
+    int Rp [ ],
+    int Ri [ ],
+    double Rx [ ], double Rz [ ],
+    int do_conjugate
+) ;
+
+SuiteSparse_long umfpack_cl_transpose
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    const SuiteSparse_long P [ ],
+    const SuiteSparse_long Q [ ],
+    SuiteSparse_long Rp [ ],
+    SuiteSparse_long Ri [ ],
+    double Rx [ ], double Rz [ ],
+    SuiteSparse_long do_conjugate
+) ;
+
 /*
 double int Syntax:
 
@@ -115,6 +173,11 @@ Purpose:
     A' or A.', by solving with the sys argument UMFPACK_At or UMFPACK_Aat,
     respectively, in umfpack_*_*solve.
 
+    If UMFPACK is compiled with OpenMP, large matrices (with at least 131072
+    entries) are transposed in parallel, using up to omp_get_max_threads ( )
+    threads.  The output is the same for any number of threads.  The
+    transposes computed by umfpack_*_*symbolic are done the same way.
+
 Returns:
 
     UMFPACK_OK if successful.
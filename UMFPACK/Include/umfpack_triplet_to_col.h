@@ -63,6 +63,62 @@ SuiteSparse_long umfpack_zl_triplet_to_col
     SuiteSparse_long Map [ ]
 ) ;
 
+int umfpack_si_triplet_to_col
+(
+    int n_row,
+    int n_col,
+    int nz,
+    const int Ti [ ],
+    const int Tj [ ],
+    const double Tx [ ],
+    int Ap [ ],
+    int Ai [ ],
+    double Ax [ ],
+    int Map [ ]
+) ;
+
+SuiteSparse_long umfpack_sl_triplet_to_col
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    SuiteSparse_long nz,
+    const SuiteSparse_long Ti [ ],
+    const SuiteSparse_long Tj [ ],
+    const double Tx [ ],
+    SuiteSparse_long Ap [ ],
+    SuiteSparse_long Ai [ ],
+    double Ax [ ],
+    SuiteSparse_long Map [ ]
+) ;
+
+int umfpack_ci_triplet_to_col
+(
+    int n_row,
+    int n_col,
+    int nz,
+    const int Ti [ ],
+    const int Tj [ ],
+    const double Tx [ ], const double Tz [ ],
+    int Ap [ ],
+    int Ai [ ],
+    double Ax [ ], double Az [ ],
+    int Map [ ]
+) ;
+
+SuiteSparse_long umfpack_cl_triplet_to_col
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    SuiteSparse_long nz,
+    const SuiteSparse_long Ti [ ],
+    const SuiteSparse_long Tj [ ],
+    const double Tx [ ], const double Tz [ ],
+    SuiteSparse_long Ap [ ],
+    SuiteSparse_long Ai [ ],
+    double Ax [ ], double Az [ ],
+    SuiteSparse_long Map [ ]
+) ;
+
 /*
 double int Syntax:
 
@@ -147,6 +203,10 @@ Purpose:
     You can print the input triplet form with umfpack_*_report_triplet, and
     the output matrix with umfpack_*_report_matrix.
 
+    If UMFPACK is compiled with OpenMP, large matrices (with at least 131072
+    triplets) are converted in parallel, using up to omp_get_max_threads ( )
+    threads.  The output is the same for any number of threads.
+
     The matrix may be singular (nz can be zero, and empty rows and/or columns
     may exist).  It may also be rectangular and/or complex.
 
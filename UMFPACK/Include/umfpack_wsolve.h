@@ -67,6 +67,66 @@ SuiteSparse_long umfpack_zl_wsolve
     double W [ ]
 ) ;
 
+int umfpack_si_wsolve
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ],
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int Wi [ ],
+    double W [ ]
+) ;
+
+SuiteSparse_long umfpack_sl_wsolve
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ],
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    SuiteSparse_long Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_ci_wsolve
+(
+    int sys,
+    const int Ap [ ],
+    const int Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int Wi [ ],
+    double W [ ]
+) ;
+
+SuiteSparse_long umfpack_cl_wsolve
+(
+    SuiteSparse_long sys,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    double Xx [ ],	 double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    SuiteSparse_long Wi [ ],
+    double W [ ]
+) ;
+
 /*
 double int Syntax:
 
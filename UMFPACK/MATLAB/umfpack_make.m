@@ -134,12 +134,12 @@ umfch = { 'assemble', 'blas3_update', ...
         'set_stats', 'solve', 'symbolic_usage', 'transpose', ...
         'tuple_lengths', 'usolve', 'utsolve', 'valid_numeric', ...
         'valid_symbolic', 'grow_front', 'start_front', ...
-	'store_lu', 'scale' } ;
+	'store_lu', 'scale', 'msolve', 'refactor' } ;
 
 % non-user-callable umf_*.[ch] files, int versions only (no real/complex):
 umfint = { 'analyze', 'apply_order', 'colamd', 'free', 'fsize', ...
         'is_permutation', 'malloc', 'realloc', 'report_perm', ...
-	'singletons', 'cholmod' } ;
+	'singletons', 'cholmod', 'cumsum' } ;
 
 % non-user-callable and user-callable amd_*.[ch] files (int versions only):
 amdsrc = { 'aat', '1', '2', 'dump', 'postorder', 'post_tree', 'defaults', ...
@@ -154,7 +154,9 @@ user = { 'col_to_triplet', 'defaults', 'free_numeric', ...
         'report_symbolic', 'report_triplet', ...
         'report_vector', 'solve', 'symbolic', ...
         'transpose', 'triplet_to_col', 'scale' ...
-	'load_numeric', 'save_numeric', 'load_symbolic', 'save_symbolic' } ;
+	'load_numeric', 'save_numeric', 'load_symbolic', 'save_symbolic', ...
+	'msolve', 'refactor', 'load_numeric_mmap', 'save_numeric_mmap', ...
+	'queue', 'qsolve', 'free_queue' } ;
 
 % user-callable umfpack_*.[ch], only one version
 generic = { 'timer', 'tictoc', 'global' } ;
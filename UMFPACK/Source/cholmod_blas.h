@@ -95,6 +95,20 @@
 #define BLAS_ZSCAL zscal_64_
 #define LAPACK_ZPOTRF zpotrf_64_
 
+#define BLAS_STRSV strsv_64_
+#define BLAS_SGEMV sgemv_64_
+#define BLAS_STRSM strsm_64_
+#define BLAS_SGEMM sgemm_64_
+#define BLAS_SGER  sger_64_
+#define BLAS_SSCAL sscal_64_
+
+#define BLAS_CTRSV ctrsv_64_
+#define BLAS_CGEMV cgemv_64_
+#define BLAS_CTRSM ctrsm_64_
+#define BLAS_CGEMM cgemm_64_
+#define BLAS_CGER  cgeru_64_
+#define BLAS_CSCAL cscal_64_
+
 #elif defined (BLAS_NO_UNDERSCORE)
 
 #define BLAS_DTRSV dtrsv
@@ -115,6 +129,20 @@
 #define BLAS_ZSCAL zscal
 #define LAPACK_ZPOTRF zpotrf
 
+#define BLAS_STRSV strsv
+#define BLAS_SGEMV sgemv
+#define BLAS_STRSM strsm
+#define BLAS_SGEMM sgemm
+#define BLAS_SGER  sger
+#define BLAS_SSCAL sscal
+
+#define BLAS_CTRSV ctrsv
+#define BLAS_CGEMV cgemv
+#define BLAS_CTRSM ctrsm
+#define BLAS_CGEMM cgemm
+#define BLAS_CGER  cgeru
+#define BLAS_CSCAL cscal
+
 #else
 
 #define BLAS_DTRSV dtrsv_
@@ -135,6 +163,20 @@
 #define BLAS_ZSCAL zscal_
 #define LAPACK_ZPOTRF zpotrf_
 
+#define BLAS_STRSV strsv_
+#define BLAS_SGEMV sgemv_
+#define BLAS_STRSM strsm_
+#define BLAS_SGEMM sgemm_
+#define BLAS_SGER  sger_
+#define BLAS_SSCAL sscal_
+
+#define BLAS_CTRSV ctrsv_
+#define BLAS_CGEMV cgemv_
+#define BLAS_CTRSM ctrsm_
+#define BLAS_CGEMM cgemm_
+#define BLAS_CGER  cgeru_
+#define BLAS_CSCAL cscal_
+
 #endif
 
 /* ========================================================================== */
@@ -444,4 +486,219 @@ void BLAS_ZGER (BLAS_INT *m, BLAS_INT *n, double *alpha,
     } \
 }
 
+/* ========================================================================== */
+/* === single precision BLAS ================================================ */
+/* ========================================================================== */
+
+/* These are used only by the single-precision versions of UMFPACK
+ * (umfpack_si_*, umfpack_sl_*, umfpack_ci_*, and umfpack_cl_*). */
+
+void BLAS_SGEMV (char *trans, BLAS_INT *m, BLAS_INT *n, float *alpha,
+	float *A, BLAS_INT *lda, float *X, BLAS_INT *incx, float *beta,
+	float *Y, BLAS_INT *incy) ;
+
+#define BLAS_sgemv(trans,m,n,alpha,A,lda,X,incx,beta,Y,incy) \
+{ \
+    BLAS_INT M = m, N = n, LDA = lda, INCX = incx, INCY = incy ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && \
+        EQ (INCX,incx) && EQ (INCY,incy))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_SGEMV (trans, &M, &N, alpha, A, &LDA, X, &INCX, beta, Y, &INCY) ; \
+    } \
+}
+
+void BLAS_CGEMV (char *trans, BLAS_INT *m, BLAS_INT *n, float *alpha,
+	float *A, BLAS_INT *lda, float *X, BLAS_INT *incx, float *beta,
+	float *Y, BLAS_INT *incy) ;
+
+#define BLAS_cgemv(trans,m,n,alpha,A,lda,X,incx,beta,Y,incy) \
+{ \
+    BLAS_INT M = m, N = n, LDA = lda, INCX = incx, INCY = incy ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && \
+        EQ (INCX,incx) && EQ (INCY,incy))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_CGEMV (trans, &M, &N, alpha, A, &LDA, X, &INCX, beta, Y, &INCY) ; \
+    } \
+}
+
+void BLAS_STRSV (char *uplo, char *trans, char *diag, BLAS_INT *n, float *A,
+	BLAS_INT *lda, float *X, BLAS_INT *incx) ;
+
+#define BLAS_strsv(uplo,trans,diag,n,A,lda,X,incx) \
+{ \
+    BLAS_INT N = n, LDA = lda, INCX = incx ; \
+    if (CHECK_BLAS_INT && !(EQ (N,n) && EQ (LDA,lda) && EQ (INCX,incx))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_STRSV (uplo, trans, diag, &N, A, &LDA, X, &INCX) ; \
+    } \
+}
+
+void BLAS_CTRSV (char *uplo, char *trans, char *diag, BLAS_INT *n, float *A,
+	BLAS_INT *lda, float *X, BLAS_INT *incx) ;
+
+#define BLAS_ctrsv(uplo,trans,diag,n,A,lda,X,incx) \
+{ \
+    BLAS_INT N = n, LDA = lda, INCX = incx ; \
+    if (CHECK_BLAS_INT && !(EQ (N,n) && EQ (LDA,lda) && EQ (INCX,incx))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_CTRSV (uplo, trans, diag, &N, A, &LDA, X, &INCX) ; \
+    } \
+}
+
+void BLAS_STRSM (char *side, char *uplo, char *transa, char *diag, BLAS_INT *m,
+	BLAS_INT *n, float *alpha, float *A, BLAS_INT *lda, float *B,
+	BLAS_INT *ldb) ;
+
+#define BLAS_strsm(side,uplo,transa,diag,m,n,alpha,A,lda,B,ldb) \
+{ \
+    BLAS_INT M = m, N = n, LDA = lda, LDB = ldb ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && \
+        EQ (LDB,ldb))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_STRSM (side, uplo, transa, diag, &M, &N, alpha, A, &LDA, B, &LDB);\
+    } \
+}
+
+void BLAS_CTRSM (char *side, char *uplo, char *transa, char *diag, BLAS_INT *m,
+	BLAS_INT *n, float *alpha, float *A, BLAS_INT *lda, float *B,
+	BLAS_INT *ldb) ;
+
+#define BLAS_ctrsm(side,uplo,transa,diag,m,n,alpha,A,lda,B,ldb) \
+{ \
+    BLAS_INT M = m, N = n, LDA = lda, LDB = ldb ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && \
+        EQ (LDB,ldb))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_CTRSM (side, uplo, transa, diag, &M, &N, alpha, A, &LDA, B, &LDB);\
+    } \
+}
+
+void BLAS_SGEMM (char *transa, char *transb, BLAS_INT *m, BLAS_INT *n,
+	BLAS_INT *k, float *alpha, float *A, BLAS_INT *lda, float *B,
+	BLAS_INT *ldb, float *beta, float *C, BLAS_INT *ldc) ;
+
+#define BLAS_sgemm(transa,transb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc) \
+{ \
+    BLAS_INT M = m, N = n, K = k, LDA = lda, LDB = ldb, LDC = ldc ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (K,k) && \
+        EQ (LDA,lda) && EQ (LDB,ldb) && EQ (LDC,ldc))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_SGEMM (transa, transb, &M, &N, &K, alpha, A, &LDA, B, &LDB, beta, \
+	    C, &LDC) ; \
+    } \
+}
+
+void BLAS_CGEMM (char *transa, char *transb, BLAS_INT *m, BLAS_INT *n,
+	BLAS_INT *k, float *alpha, float *A, BLAS_INT *lda, float *B,
+	BLAS_INT *ldb, float *beta, float *C, BLAS_INT *ldc) ;
+
+#define BLAS_cgemm(transa,transb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc) \
+{ \
+    BLAS_INT M = m, N = n, K = k, LDA = lda, LDB = ldb, LDC = ldc ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (K,k) && \
+        EQ (LDA,lda) && EQ (LDB,ldb) && EQ (LDC,ldc))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_CGEMM (transa, transb, &M, &N, &K, alpha, A, &LDA, B, &LDB, beta, \
+	    C, &LDC) ; \
+    } \
+}
+
+void BLAS_SSCAL (BLAS_INT *n, float *alpha, float *Y, BLAS_INT *incy) ;
+
+#define BLAS_sscal(n,alpha,Y,incy) \
+{ \
+    BLAS_INT N = n, INCY = incy ; \
+    if (CHECK_BLAS_INT && !(EQ (N,n) && EQ (INCY,incy))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_SSCAL (&N, alpha, Y, &INCY) ; \
+    } \
+}
+
+void BLAS_CSCAL (BLAS_INT *n, float *alpha, float *Y, BLAS_INT *incy) ;
+
+#define BLAS_cscal(n,alpha,Y,incy) \
+{ \
+    BLAS_INT N = n, INCY = incy ; \
+    if (CHECK_BLAS_INT && !(EQ (N,n) && EQ (INCY,incy))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_CSCAL (&N, alpha, Y, &INCY) ; \
+    } \
+}
+
+void BLAS_SGER (BLAS_INT *m, BLAS_INT *n, float *alpha,
+	float *X, BLAS_INT *incx, float *Y, BLAS_INT *incy,
+	float *A, BLAS_INT *lda) ;
+
+#define BLAS_sger(m,n,alpha,X,incx,Y,incy,A,lda) \
+{ \
+    BLAS_INT M = m, N = n, LDA = lda, INCX = incx, INCY = incy ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && \
+          EQ (INCX,incx) && EQ (INCY,incy))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_SGER (&M, &N, alpha, X, &INCX, Y, &INCY, A, &LDA) ; \
+    } \
+}
+
+void BLAS_CGER (BLAS_INT *m, BLAS_INT *n, float *alpha,
+	float *X, BLAS_INT *incx, float *Y, BLAS_INT *incy,
+	float *A, BLAS_INT *lda) ;
+
+#define BLAS_cgeru(m,n,alpha,X,incx,Y,incy,A,lda) \
+{ \
+    BLAS_INT M = m, N = n, LDA = lda, INCX = incx, INCY = incy ; \
+    if (CHECK_BLAS_INT && !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && \
+          EQ (INCX,incx) && EQ (INCY,incy))) \
+    { \
+	BLAS_OK = FALSE ; \
+    } \
+    if (!CHECK_BLAS_INT || BLAS_OK) \
+    { \
+	BLAS_CGER (&M, &N, alpha, X, &INCX, Y, &INCY, A, &LDA) ; \
+    } \
+}
+
 #endif
@@ -67,6 +67,12 @@
 	    If the pivot is zero, and this flag is set, then no divide-by-zero
 	    occurs.
 
+	-DNPOSIX
+
+	    If set, umfpack_*_load_numeric_mmap reads the file into a malloc'd
+	    block instead of mapping it into memory with the POSIX mmap.  This
+	    flag is set automatically on Microsoft Windows (see below).
+
     The following options are controlled by amd_internal.h:
 
 	-DMATLAB_MEX_FILE
@@ -151,13 +157,26 @@
  * A is m-by-k with leading dimension ldac
  * B is k-by-n with leading dimension ldb
  * C is m-by-n with leading dimension ldac */
-#ifdef COMPLEX
+#if defined (COMPLEX) && defined (SINGLE)
+#define BLAS_GEMM(m,n,k,A,B,ldb,C,ldac) \
+{ \
+    float alpha [2] = {-1,0}, beta [2] = {1,0} ; \
+    BLAS_cgemm ("N", "T", m, n, k, alpha, (float *) A, ldac, \
+	(float *) B, ldb, beta, (float *) C, ldac) ; \
+}
+#elif defined (COMPLEX)
 #define BLAS_GEMM(m,n,k,A,B,ldb,C,ldac) \
 { \
     double alpha [2] = {-1,0}, beta [2] = {1,0} ; \
     BLAS_zgemm ("N", "T", m, n, k, alpha, (double *) A, ldac, \
 	(double *) B, ldb, beta, (double *) C, ldac) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_GEMM(m,n,k,A,B,ldb,C,ldac) \
+{ \
+    float alpha = -1, beta = 1 ; \
+    BLAS_sgemm ("N", "T", m, n, k, &alpha, A, ldac, B, ldb, &beta, C, ldac) ; \
+}
 #else
 #define BLAS_GEMM(m,n,k,A,B,ldb,C,ldac) \
 { \
@@ -175,13 +194,26 @@
  * A is m-by-n with leading dimension d
    x is a column vector with stride 1
    y is a column vector with stride 1 */
-#ifdef COMPLEX
+#if defined (COMPLEX) && defined (SINGLE)
+#define BLAS_GER(m,n,x,y,A,d) \
+{ \
+    float alpha [2] = {-1,0} ; \
+    BLAS_cgeru (m, n, alpha, (float *) x, 1, (float *) y, 1, \
+	(float *) A, d) ; \
+}
+#elif defined (COMPLEX)
 #define BLAS_GER(m,n,x,y,A,d) \
 { \
     double alpha [2] = {-1,0} ; \
     BLAS_zgeru (m, n, alpha, (double *) x, 1, (double *) y, 1, \
 	(double *) A, d) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_GER(m,n,x,y,A,d) \
+{ \
+    float alpha = -1 ; \
+    BLAS_sger (m, n, &alpha, x, 1, y, 1, A, d) ; \
+}
 #else
 #define BLAS_GER(m,n,x,y,A,d) \
 { \
@@ -198,13 +230,26 @@
 /* y = y - A*x, where A is m-by-n with leading dimension d,
    x is a column vector with stride 1
    y is a column vector with stride 1 */
-#ifdef COMPLEX
+#if defined (COMPLEX) && defined (SINGLE)
+#define BLAS_GEMV(m,n,A,x,y,d) \
+{ \
+    float alpha [2] = {-1,0}, beta [2] = {1,0} ; \
+    BLAS_cgemv ("N", m, n, alpha, (float *) A, d, (float *) x, 1, beta, \
+	(float *) y, 1) ; \
+}
+#elif defined (COMPLEX)
 #define BLAS_GEMV(m,n,A,x,y,d) \
 { \
     double alpha [2] = {-1,0}, beta [2] = {1,0} ; \
     BLAS_zgemv ("N", m, n, alpha, (double *) A, d, (double *) x, 1, beta, \
 	(double *) y, 1) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_GEMV(m,n,A,x,y,d) \
+{ \
+    float alpha = -1, beta = 1 ; \
+    BLAS_sgemv ("N", m, n, &alpha, A, d, x, 1, &beta, y, 1) ; \
+}
 #else
 #define BLAS_GEMV(m,n,A,x,y,d) \
 { \
@@ -221,11 +266,21 @@
 /* solve Lx=b, where:
  * B is a column vector (m-by-1) with leading dimension d
  * A is m-by-m with leading dimension d */
-#ifdef COMPLEX
+#if defined (COMPLEX) && defined (SINGLE)
+#define BLAS_TRSV(m,A,b,d) \
+{ \
+    BLAS_ctrsv ("L", "N", "U", m, (float *) A, d, (float *) b, 1) ; \
+}
+#elif defined (COMPLEX)
 #define BLAS_TRSV(m,A,b,d) \
 { \
     BLAS_ztrsv ("L", "N", "U", m, (double *) A, d, (double *) b, 1) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_TRSV(m,A,b,d) \
+{ \
+    BLAS_strsv ("L", "N", "U", m, A, d, b, 1) ; \
+}
 #else
 #define BLAS_TRSV(m,A,b,d) \
 { \
@@ -241,13 +296,26 @@
 /* solve XL'=B where:
  * B is m-by-n with leading dimension ldb
  * A is n-by-n with leading dimension lda */
-#ifdef COMPLEX
+#if defined (COMPLEX) && defined (SINGLE)
+#define BLAS_TRSM_RIGHT(m,n,A,lda,B,ldb) \
+{ \
+    float alpha [2] = {1,0} ; \
+    BLAS_ctrsm ("R", "L", "T", "U", m, n, alpha, (float *) A, lda, \
+	(float *) B, ldb) ; \
+}
+#elif defined (COMPLEX)
 #define BLAS_TRSM_RIGHT(m,n,A,lda,B,ldb) \
 { \
     double alpha [2] = {1,0} ; \
     BLAS_ztrsm ("R", "L", "T", "U", m, n, alpha, (double *) A, lda, \
 	(double *) B, ldb) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_TRSM_RIGHT(m,n,A,lda,B,ldb) \
+{ \
+    float alpha = 1 ; \
+    BLAS_strsm ("R", "L", "T", "U", m, n, &alpha, A, lda, B, ldb) ; \
+}
 #else
 #define BLAS_TRSM_RIGHT(m,n,A,lda,B,ldb) \
 { \
@@ -262,7 +330,15 @@
 /* -------------------------------------------------------------------------- */
 
 /* x = s*x, where x is a stride-1 vector of length n */
-#ifdef COMPLEX
+#if defined (COMPLEX) && defined (SINGLE)
+#define BLAS_SCAL(n,s,x) \
+{ \
+    float alpha [2] ; \
+    alpha [0] = REAL_COMPONENT (s) ; \
+    alpha [1] = IMAG_COMPONENT (s) ; \
+    BLAS_cscal (n, alpha, (float *) x, 1) ; \
+}
+#elif defined (COMPLEX)
 #define BLAS_SCAL(n,s,x) \
 { \
     double alpha [2] ; \
@@ -270,6 +346,12 @@
     alpha [1] = IMAG_COMPONENT (s) ; \
     BLAS_zscal (n, alpha, (double *) x, 1) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_SCAL(n,s,x) \
+{ \
+    float alpha = REAL_COMPONENT (s) ; \
+    BLAS_sscal (n, &alpha, (float *) x, 1) ; \
+}
 #else
 #define BLAS_SCAL(n,s,x) \
 { \
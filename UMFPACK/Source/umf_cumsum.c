@@ -0,0 +1,61 @@
+/* ========================================================================== */
+/* === UMF_cumsum =========================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/* On input, W [t*nn + i] is the number of entries that thread t found in row
+ * (or column) i, for i = 0 to n-1.  On output, Cp [0..n] holds the cumulative
+ * sum of the counts of all threads, and W [t*nn + i] is the position where
+ * thread t places its first entry of row i.  Used by UMF_triplet. */
+
+#include "umf_internal.h"
+#include "umf_cumsum.h"
+
+GLOBAL void UMF_cumsum
+(
+    Int n,		/* number of rows (or columns) */
+    Int Cp [ ],		/* output, size n+1 */
+    Int W [ ],		/* input/output, size nthreads*nn */
+    Int nn,		/* size of the workspace of each thread, nn >= n */
+    Int nthreads	/* number of threads that counted the entries */
+)
+{
+    Int i ;
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static)
+#endif
+    for (i = 0 ; i < n ; i++)
+    {
+	Int t, c, cnt = 0 ;
+	for (t = 0 ; t < nthreads ; t++)
+	{
+	    c = W [t*nn + i] ;
+	    W [t*nn + i] = cnt ;
+	    cnt += c ;
+	}
+	Cp [i+1] = cnt ;
+    }
+
+    Cp [0] = 0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+	Cp [i+1] += Cp [i] ;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static)
+#endif
+    for (i = 0 ; i < n ; i++)
+    {
+	Int t ;
+	for (t = 0 ; t < nthreads ; t++)
+	{
+	    W [t*nn + i] += Cp [i] ;
+	}
+    }
+}
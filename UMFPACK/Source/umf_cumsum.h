@@ -0,0 +1,13 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+GLOBAL void UMF_cumsum
+(
+    Int n,
+    Int Cp [ ],
+    Int W [ ],
+    Int nn,
+    Int nthreads
+) ;
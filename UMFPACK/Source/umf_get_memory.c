@@ -33,11 +33,13 @@ GLOBAL Int UMF_get_memory
     Int do_Fcpos
 )
 {
-    double nsize, bsize, tsize ;
+    double nsize, bsize, tsize, stats [2] ;
     Int i, minsize, newsize, newmem, costly, row, col, *Row_tlen, *Col_tlen,
-	n_row, n_col, *Row_degree, *Col_degree ;
+	n_row, n_col, *Row_degree, *Col_degree, ok ;
     Unit *mnew, *p ;
 
+    umfpack_tic (stats) ;
+
     /* ---------------------------------------------------------------------- */
     /* get and check parameters */
     /* ---------------------------------------------------------------------- */
@@ -218,5 +220,10 @@ GLOBAL Int UMF_get_memory
     /* rebuild the tuples */
     /* ---------------------------------------------------------------------- */
 
-    return (UMF_build_tuples (Numeric, Work)) ;
+    ok = UMF_build_tuples (Numeric, Work) ;
+
+    /* time spent in realloc, garbage collection, and rebuilding the tuples */
+    umfpack_toc (stats) ;
+    Numeric->defrag_time += stats [0] ;
+    return (ok) ;
 }
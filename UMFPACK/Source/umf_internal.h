@@ -257,9 +257,10 @@ typedef union Unit_union Unit ;
     first defense against corrupted *Symbolic or *Numeric pointers passed to an
     UMFPACK routine.  They also ensure that the objects are used only by the
     same version that created them (umfpack_di_*, umfpack_dl_*, umfpack_zi_*,
-    or umfpack_zl_*).  The values have also been changed since prior releases of
-    the code to ensure that all routines that operate on the objects are of the
-    same release.  The values themselves are purely arbitrary.  The are less
+    umfpack_zl_*, umfpack_si_*, umfpack_sl_*, umfpack_ci_*, or umfpack_cl_*).
+    The values have also been changed since prior releases of the code to
+    ensure that all routines that operate on the objects are of the same
+    release.  The values themselves are purely arbitrary.  The are less
     than the ANSI C required minimums of INT_MAX and LONG_MAX, respectively.
 */
 
@@ -279,6 +280,22 @@ typedef union Unit_union Unit ;
 #define NUMERIC_VALID  129987754
 #define SYMBOLIC_VALID 110291734
 #endif
+#ifdef SINT
+#define NUMERIC_VALID  16987
+#define SYMBOLIC_VALID 42917
+#endif
+#ifdef SLONG
+#define NUMERIC_VALID  377859127
+#define SYMBOLIC_VALID 386119207
+#endif
+#ifdef CINT
+#define NUMERIC_VALID  18937
+#define SYMBOLIC_VALID 39917
+#endif
+#ifdef CLONG
+#define NUMERIC_VALID  143098811
+#define SYMBOLIC_VALID 121870973
+#endif
 
 typedef struct	/* NumericType */
 {
@@ -293,7 +310,8 @@ typedef struct	/* NumericType */
 	rsmax,		/* largest row sum  */
 	min_udiag,	/* smallest abs value on diagonal of D */
 	max_udiag,	/* smallest abs value on diagonal of D */
-	rcond ;		/* min (D) / max (D) */
+	rcond,		/* min (D) / max (D) */
+	defrag_time ;	/* time spent in UMF_get_memory */
 
     Int
 	scale ;
@@ -308,7 +326,10 @@ typedef struct	/* NumericType */
 	itail,		/* pointer to top of elements & tuples,  */
 			/* in Numeric->Memory */
 	ibig,		/* pointer to largest free block seen in tail */
-	size ;		/* size of Memory, in Units */
+	size,		/* size of Memory, in Units */
+	capacity,	/* Units allocated for Memory (size, or more if */
+			/* created by UMFPACK_renumeric) */
+	max_size ;	/* size of Memory at the end of UMF_kernel */
 
     Int
 	*Rperm,		/* pointer to row perm array, size: n+1 */
@@ -365,8 +386,60 @@ typedef struct	/* NumericType */
 
     Int maxnrows, maxncols ;	/* not the same as Symbolic->maxnrows/cols* */
 
+    /* Map from the compressed L and U chains in Numeric->Memory to a
+     * column-oriented form, built by UMF_refactor the first time it is called
+     * and reused thereafter.  Not saved by UMFPACK_save_numeric. */
+    Int
+	*Rf_Lp,		/* size n+1, column pointers for Rf_Li */
+	*Rf_Li,		/* row indices of L, in the order of its values */
+	*Rf_Lx,		/* size n, offset of the values of L(:,k) */
+	*Rf_Up,		/* size n+1, column pointers for Rf_Ui and Rf_Ux */
+	*Rf_Ui,		/* row indices of U (excl. diagonal), ascending */
+	*Rf_Ux,		/* offset of each value of U */
+	*Rf_Rinv ;	/* size n, inverse of Rperm */
+
+    /* If the Numeric object was loaded by UMFPACK_load_numeric_mmap, then
+     * D, Rperm, Cperm, Lpos, Lilen, Lip, Upos, Uilen, Uip, Rs, Upattern, and
+     * Memory all point into a single block, Mapping, of mapping_size bytes,
+     * and are not free'd individually.  Mapping is a private (copy-on-write)
+     * mapping of the file if mapped is TRUE, or a malloc'd copy of the file
+     * otherwise.  Mapping is NULL for all other Numeric objects. */
+    void *Mapping ;
+    size_t mapping_size ;
+    Int mapped ;
+
 } NumericType ;
 
+/* -------------------------------------------------------------------------- */
+/* Numeric object file header, for UMFPACK_[save,load]_numeric_mmap */
+/* -------------------------------------------------------------------------- */
+
+/* A file written by UMFPACK_save_numeric_mmap starts with this header.  It is
+ * followed by the NumericType struct and then the arrays D, Rperm, Cperm,
+ * Lpos, Lilen, Lip, Upos, Uilen, Uip, Rs, Upattern, and Memory, in that
+ * order.  Each of these 13 objects starts at a multiple of UMF_MMAP_ALIGN
+ * bytes from the start of the file, so that each can be used in place when
+ * the file is mapped into memory.  offset [k] is -1 if object k is not
+ * present (Rs if the matrix was not scaled, Upattern if ulen is zero). */
+
+#define UMF_MMAP_ID "UMFPACK mmap 1"
+#define UMF_MMAP_ALIGN 4096
+#define UMF_MMAP_NOBJECTS 13
+#define UMF_MMAP_ROUNDUP(x) \
+    ((((x) + UMF_MMAP_ALIGN - 1) / UMF_MMAP_ALIGN) * UMF_MMAP_ALIGN)
+
+typedef struct	/* NumericFileHeader */
+{
+    char id [16] ;	/* UMF_MMAP_ID, zero padded */
+    Int valid ;		/* NUMERIC_VALID of the version that wrote the file */
+    Int sizeof_numeric, sizeof_entry, sizeof_unit, sizeof_int ;
+    SuiteSparse_long
+	align,		/* UMF_MMAP_ALIGN */
+	file_size,	/* total size of the file, in bytes */
+	offset [UMF_MMAP_NOBJECTS] ;	/* offset of each object, in bytes */
+
+} NumericFileHeader ;
+
 
 
 /* -------------------------------------------------------------------------- */
@@ -693,6 +766,61 @@ typedef struct	/* SymbolicType */
 } SymbolicType ;
 
 
+/* -------------------------------------------------------------------------- */
+/* Queue */
+/* -------------------------------------------------------------------------- */
+
+/*
+    This is constructed by UMFPACK_queue.  Right-hand sides submitted by
+    UMFPACK_qsolve are linked into a FIFO list of QueueRequests, each of which
+    lives on the stack of the thread that submitted it.  One thread at a time
+    (the one that finds the queue idle) removes up to max_nrhs requests from
+    the head of the list and solves them with a single call to UMFPACK_msolve;
+    the others wait until their request is done.  The B and X blocks are in
+    packed form (real and imaginary parts interleaved, in the complex case).
+*/
+
+#ifndef NPOSIX
+#include <pthread.h>
+#endif
+
+#define QUEUE_VALID (NUMERIC_VALID + 1)
+
+typedef struct QueueRequest_struct	/* QueueRequest */
+{
+    double *Xx, *Xz ;		/* solution, from the caller of UMFPACK_qsolve */
+    const double *Bx, *Bz ;	/* right-hand side, from the caller */
+    double *Info ;		/* caller's Info, may be NULL */
+    Int status ;		/* result of UMFPACK_msolve */
+    Int done ;			/* TRUE when Xx and Xz have been computed */
+    struct QueueRequest_struct *next ;
+
+} QueueRequest ;
+
+typedef struct	/* QueueType */
+{
+    Int valid,			/* set to QUEUE_VALID, for validity check */
+	sys,			/* system to solve, as in UMFPACK_solve */
+	n,			/* Numeric is n-by-n */
+	max_nrhs,		/* max number of rhs per call to UMFPACK_msolve */
+	busy ;			/* TRUE if a thread is solving a block */
+
+    const Int *Ap, *Ai ;	/* A, for iterative refinement only */
+    const double *Ax, *Az ;
+    void *Numeric ;		/* the LU factors, not modified */
+    double Control [UMFPACK_CONTROL] ;
+
+    double *B, *X ;		/* size n*max_nrhs (2*n*max_nrhs if complex) */
+    QueueRequest *head, *tail ;	/* pending requests, head is the oldest */
+
+#ifndef NPOSIX
+    pthread_mutex_t lock ;	/* protects busy, head, tail, and done flags */
+    pthread_cond_t finished ;	/* signalled when a block has been solved */
+#endif
+
+} QueueType ;
+
+
 /* -------------------------------------------------------------------------- */
 /* for debugging only: */
 /* -------------------------------------------------------------------------- */
@@ -373,7 +373,7 @@ GLOBAL Int UMF_kernel_init
 	    }
 	    for (p = p1 ; p < p2 ; p++)
 	    {
-		Entry aij ;
+		XEntry aij ;
 		double value ;
 		row = Ai [p] ;
 		if (row <= ilast || row >= n_row)
@@ -17,11 +17,11 @@
 GLOBAL double UMF_lsolve
 (
     NumericType *Numeric,
-    Entry X [ ],		/* b on input, solution x on output */
+    XEntry X [ ],		/* b on input, solution x on output */
     Int Pattern [ ]		/* a work array of size n */
 )
 {
-    Entry xk ;
+    XEntry xk ;
     Entry *xp, *Lval ;
     Int k, deg, *ip, j, row, *Lpos, *Lilen, *Lip, llen, lp, newLchain,
 	pos, npiv, n1, *Li ;
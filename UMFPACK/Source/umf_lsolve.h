@@ -6,6 +6,6 @@
 GLOBAL double UMF_lsolve
 (
     NumericType *Numeric,
-    Entry X [ ],
+    XEntry X [ ],
     Int Pattern [ ]
 ) ;
@@ -22,11 +22,11 @@ UMF_ltsolve			/* solve L.'x=b (array transpose) */
 #endif
 (
     NumericType *Numeric,
-    Entry X [ ],		/* b on input, solution x on output */
+    XEntry X [ ],		/* b on input, solution x on output */
     Int Pattern [ ]		/* a work array of size n */
 )
 {
-    Entry xk ;
+    XEntry xk ;
     Entry *xp, *Lval ;
     Int k, deg, *ip, j, row, *Lpos, *Lilen, kstart, kend, *Lip, llen,
 	lp, pos, npiv, n1, *Li ;
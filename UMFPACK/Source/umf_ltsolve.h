@@ -6,13 +6,13 @@
 GLOBAL double UMF_ltsolve
 (
     NumericType *Numeric,
-    Entry X [ ],
+    XEntry X [ ],
     Int Pattern [ ]
 ) ;
 
 GLOBAL double UMF_lhsolve
 (
     NumericType *Numeric,
-    Entry X [ ],
+    XEntry X [ ],
     Int Pattern [ ]
 ) ;
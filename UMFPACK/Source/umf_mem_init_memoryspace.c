@@ -29,6 +29,7 @@ GLOBAL void UMF_mem_init_memoryspace
     Numeric->ngarbage = 0 ;
     Numeric->nrealloc = 0 ;
     Numeric->ncostly = 0 ;
+    Numeric->defrag_time = 0 ;
     Numeric->ibig = EMPTY ;
     Numeric->ihead = 0 ;
     Numeric->itail = Numeric->size ;
@@ -0,0 +1,873 @@
+/* ========================================================================== */
+/* === UMF_msolve =========================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    Not user-callable.  Solves A X = B for a block of nb right-hand sides
+    (1 <= nb <= UMF_MSOLVE_NB) using the numerical factorization computed by
+    UMFPACK_numeric, with optional iterative refinement.  No workspace is
+    dynamically allocated.
+
+    B and X are held in interleaved form:  entry (i,r) is in B [i*nb+r].
+    Each column of L and row of U is thus read from Numeric->Memory once per
+    block, and applied to all nb right-hand sides while it is in cache,
+    rather than once per right-hand side as in UMF_lsolve and UMF_usolve.
+
+    Iterative refinement is done separately for each right-hand side, using
+    the same sparse backward error test as UMF_solve (Arioli, Demmel, and
+    Duff).  A right-hand side that has converged is left unchanged by later
+    steps.  Y [i] must hold the 1-norm of row i of R A, where R is the row
+    scaling; Y is only used if irstep > 0.
+
+    On output, Stats [0] is the flop count.  If irstep > 0, Stats [1] and
+    Stats [2] are the largest omega1 and omega2 of any right-hand side, and
+    Stats [3] and Stats [4] are the largest number of iterative refinement
+    steps taken and attempted for any right-hand side.
+
+    Returns UMFPACK_OK, or UMFPACK_WARNING_singular_matrix if A is singular
+    (in which case iterative refinement is not done).
+*/
+
+#include "umf_internal.h"
+#include "umf_msolve.h"
+
+PRIVATE double lsolve_block
+(
+    NumericType *Numeric,
+    XEntry X [ ],
+    Int nb,
+    Int Pattern [ ]
+) ;
+
+PRIVATE double usolve_block
+(
+    NumericType *Numeric,
+    XEntry X [ ],
+    Int nb,
+    Int Pattern [ ]
+) ;
+
+PRIVATE Int do_step
+(
+    double omega [3],
+    double Colstats [4],
+    Int step,
+    Int r,
+    Int nb,
+    const double B2 [ ],
+    XEntry X [ ],
+    const XEntry W [ ],
+    const double Y [ ],
+    const double Z2 [ ],
+    XEntry S [ ],
+    Int n
+) ;
+
+/* ========================================================================== */
+/* === UMF_msolve =========================================================== */
+/* ========================================================================== */
+
+GLOBAL Int UMF_msolve
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    NumericType *Numeric,
+    Int nb,			/* number of right-hand sides in B and X */
+    Int irstep,			/* max # of iterative refinement steps */
+    const double Y [ ],		/* size n, if irstep > 0 */
+    const XEntry B [ ],		/* size n*nb, interleaved */
+    XEntry X [ ],		/* size n*nb, interleaved */
+    double Stats [5],
+    Int Pattern [ ],		/* size n */
+    double SolveWork [ ]	/* if irstep>0 real:  size 5*n*nb. complex:8*n*nb */
+				/* otherwise   real:  size   n*nb. complex:2*n*nb */
+)
+{
+    /* ---------------------------------------------------------------------- */
+    /* local variables */
+    /* ---------------------------------------------------------------------- */
+
+    XEntry axx, aij, xj ;
+    XEntry *W, *Z, *S, *Xj, *Zi ;
+    double omega [3*UMF_MSOLVE_NB], Colstats [4*UMF_MSOLVE_NB], d, flops ;
+    double *Z2, *B2, *Rs, *Z2i ;
+    Int active [UMF_MSOLVE_NB] ;
+    Int *Rperm, *Cperm, i, k, n, nnb, p, p2, r, step, j, nz, status, do_scale,
+	nactive ;
+#ifdef COMPLEX
+    Int AXsplit ;
+#endif
+#ifndef NRECIPROCAL
+    Int do_recip = Numeric->do_recip ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* initializations */
+    /* ---------------------------------------------------------------------- */
+
+    ASSERT (Numeric && B && X && Pattern && SolveWork && Stats) ;
+    ASSERT (nb >= 1 && nb <= UMF_MSOLVE_NB) ;
+    ASSERT (Numeric->n_row == Numeric->n_col) ;
+
+    n = Numeric->n_row ;
+    nnb = n * nb ;
+    Rperm = Numeric->Rperm ;
+    Cperm = Numeric->Cperm ;
+    Rs = Numeric->Rs ;		/* row scale factors */
+    do_scale = (Rs != (double *) NULL) ;
+    flops = 0 ;
+
+    if (Numeric->nnzpiv < n
+	|| SCALAR_IS_ZERO (Numeric->rcond) || SCALAR_IS_NAN (Numeric->rcond))
+    {
+	status = UMFPACK_WARNING_singular_matrix ;
+	irstep = 0 ;
+    }
+    else
+    {
+	status = UMFPACK_OK ;
+    }
+    irstep = MAX (0, irstep) ;
+
+    for (r = 0 ; r < nb ; r++)
+    {
+	omega [3*r] = 0. ;
+	omega [3*r+1] = 0. ;
+	omega [3*r+2] = 0. ;
+	Colstats [4*r] = 0. ;
+	Colstats [4*r+1] = 0. ;
+	Colstats [4*r+2] = 0. ;
+	Colstats [4*r+3] = 0. ;
+	active [r] = TRUE ;
+    }
+
+    W = (XEntry *) SolveWork ;		/* XEntry W [0..n*nb-1] */
+    Z = (XEntry *) NULL ;		/* unused if no iterative refinement */
+    S = (XEntry *) NULL ;
+    Z2 = (double *) NULL ;
+    B2 = (double *) NULL ;
+    nz = 0 ;
+#ifdef COMPLEX
+    AXsplit = FALSE ;
+#endif
+
+    if (irstep > 0)
+    {
+	if (!Ap || !Ai || !Ax || !Y)
+	{
+	    return (UMFPACK_ERROR_argument_missing) ;
+	}
+#ifdef COMPLEX
+	AXsplit = SPLIT (Az) ;
+#endif
+	Z = W + nnb ;			/* XEntry Z [0..n*nb-1] */
+	S = Z + nnb ;			/* XEntry S [0..n*nb-1] */
+	Z2 = (double *) (S + nnb) ;	/* double Z2 [0..n*nb-1] */
+	B2 = Z2 + nnb ;			/* double B2 [0..n*nb-1] */
+	nz = Ap [n] ;
+
+	/* B2 = R abs (B) */
+	flops += ABS_FLOPS * nnb ;
+	for (i = 0 ; i < nnb ; i++)
+	{
+	    ABS (B2 [i], B [i]) ;
+	}
+	if (do_scale)
+	{
+#ifndef NRECIPROCAL
+	    if (do_recip)
+	    {
+		/* multiply by the scale factors */
+		for (i = 0 ; i < n ; i++)
+		{
+		    for (r = 0 ; r < nb ; r++)
+		    {
+			B2 [i*nb+r] *= Rs [i] ;
+		    }
+		}
+	    }
+	    else
+#endif
+	    {
+		/* divide by the scale factors */
+		for (i = 0 ; i < n ; i++)
+		{
+		    for (r = 0 ; r < nb ; r++)
+		    {
+			B2 [i*nb+r] /= Rs [i] ;
+		    }
+		}
+	    }
+	    flops += nnb ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve A X = B, and refine each column of X */
+    /* ---------------------------------------------------------------------- */
+
+    for (step = 0 ; step <= irstep ; step++)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* Solve A X = B (step 0): */
+	/*  X = Q (U \ (L \ (P R B))) */
+	/* and then perform iterative refinement (step > 0): */
+	/*  X = X + Q (U \ (L \ (P Z))) where Z = R (B - A X) from last step */
+	/* ------------------------------------------------------------------ */
+
+	for (k = 0 ; k < n ; k++)
+	{
+	    i = Rperm [k] ;
+	    if (step == 0)
+	    {
+		for (r = 0 ; r < nb ; r++)
+		{
+		    W [k*nb+r] = B [i*nb+r] ;
+		}
+		if (do_scale)
+		{
+#ifndef NRECIPROCAL
+		    if (do_recip)
+		    {
+			for (r = 0 ; r < nb ; r++)
+			{
+			    SCALE (W [k*nb+r], Rs [i]) ;
+			}
+		    }
+		    else
+#endif
+		    {
+			for (r = 0 ; r < nb ; r++)
+			{
+			    SCALE_DIV (W [k*nb+r], Rs [i]) ;
+			}
+		    }
+		}
+	    }
+	    else
+	    {
+		/* Z is already scaled; converged columns are not refined */
+		for (r = 0 ; r < nb ; r++)
+		{
+		    if (active [r])
+		    {
+			W [k*nb+r] = Z [i*nb+r] ;
+		    }
+		    else
+		    {
+			CLEAR (W [k*nb+r]) ;
+		    }
+		}
+	    }
+	}
+	if (step == 0 && do_scale)
+	{
+	    flops += SCALE_FLOPS * nnb ;
+	}
+
+	flops += lsolve_block (Numeric, W, nb, Pattern) ;
+	flops += usolve_block (Numeric, W, nb, Pattern) ;
+
+	if (step == 0)
+	{
+	    for (k = 0 ; k < n ; k++)
+	    {
+		Xj = X + Cperm [k] * nb ;
+		for (r = 0 ; r < nb ; r++)
+		{
+		    Xj [r] = W [k*nb+r] ;
+		}
+	    }
+	}
+	else
+	{
+	    flops += ASSEMBLE_FLOPS * nnb ;
+	    for (k = 0 ; k < n ; k++)
+	    {
+		Xj = X + Cperm [k] * nb ;
+		for (r = 0 ; r < nb ; r++)
+		{
+		    if (active [r])
+		    {
+			/* X [Cperm [k]] += W [k] ; */
+			ASSEMBLE (Xj [r], W [k*nb+r]) ;
+		    }
+		}
+	    }
+	}
+
+	if (irstep == 0)
+	{
+	    break ;
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* sparse backward error estimate */
+	/* ------------------------------------------------------------------ */
+
+	/* Z (i) = R (b - A x)_i, residual */
+	/* Z2 (i) = R (|A||x|)_i */
+	for (i = 0 ; i < nnb ; i++)
+	{
+	    Z [i] = B [i] ;
+	    Z2 [i] = 0. ;
+	}
+	flops += (MULT_FLOPS + DECREMENT_FLOPS + ABS_FLOPS + 1) * nz * nb ;
+	for (j = 0 ; j < n ; j++)
+	{
+	    Xj = X + j * nb ;
+	    p2 = Ap [j+1] ;
+	    for (p = Ap [j] ; p < p2 ; p++)
+	    {
+		i = Ai [p] ;
+		Zi = Z + i * nb ;
+		Z2i = Z2 + i * nb ;
+		ASSIGN (aij, Ax, Az, p, AXsplit) ;
+		for (r = 0 ; r < nb ; r++)
+		{
+		    /* axx = Ax [p] * xj ; */
+		    xj = Xj [r] ;
+		    MULT (axx, aij, xj) ;
+		    /* Z [i] -= axx ; */
+		    DECREMENT (Zi [r], axx) ;
+		    /* Z2 [i] += ABS (axx) ; */
+		    ABS (d, axx) ;
+		    Z2i [r] += d ;
+		}
+	    }
+	}
+
+	/* scale Z and Z2 */
+	if (do_scale)
+	{
+#ifndef NRECIPROCAL
+	    if (do_recip)
+	    {
+		/* multiply by the scale factors */
+		for (i = 0 ; i < n ; i++)
+		{
+		    for (r = 0 ; r < nb ; r++)
+		    {
+			SCALE (Z [i*nb+r], Rs [i]) ;
+			Z2 [i*nb+r] *= Rs [i] ;
+		    }
+		}
+	    }
+	    else
+#endif
+	    {
+		/* divide by the scale factors */
+		for (i = 0 ; i < n ; i++)
+		{
+		    for (r = 0 ; r < nb ; r++)
+		    {
+			SCALE_DIV (Z [i*nb+r], Rs [i]) ;
+			Z2 [i*nb+r] /= Rs [i] ;
+		    }
+		}
+	    }
+	    flops += (SCALE_FLOPS + 1) * nnb ;
+	}
+
+	flops += (2*ABS_FLOPS + 5) * nnb ;
+	nactive = 0 ;
+	for (r = 0 ; r < nb ; r++)
+	{
+	    if (active [r])
+	    {
+		if (do_step (omega + 3*r, Colstats + 4*r, step, r, nb, B2, X, Z,
+		    Y, Z2, S, n))
+		{
+		    /* iterative refinement is done for this column */
+		    active [r] = FALSE ;
+		}
+		else
+		{
+		    nactive++ ;
+		}
+	    }
+	}
+	if (nactive == 0)
+	{
+	    break ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* return the statistics */
+    /* ---------------------------------------------------------------------- */
+
+    Stats [0] = flops ;
+    Stats [1] = 0. ;
+    Stats [2] = 0. ;
+    Stats [3] = 0. ;
+    Stats [4] = 0. ;
+    for (r = 0 ; r < nb ; r++)
+    {
+	for (k = 0 ; k < 4 ; k++)
+	{
+	    /* propagate NaN's, as do_step does for a single column */
+	    d = Colstats [4*r+k] ;
+	    if (SCALAR_IS_NAN (d) || d > Stats [k+1])
+	    {
+		Stats [k+1] = d ;
+	    }
+	}
+    }
+
+    return (status) ;
+}
+
+
+/* ========================================================================== */
+/* === lsolve_block ========================================================= */
+/* ========================================================================== */
+
+/* Solves L X = B for nb interleaved right-hand sides, as UMF_lsolve does for
+ * one.  Returns the floating point operation count. */
+
+PRIVATE double lsolve_block
+(
+    NumericType *Numeric,
+    XEntry X [ ],		/* B on input, solution X on output */
+    Int nb,
+    Int Pattern [ ]		/* a work array of size n */
+)
+{
+    XEntry xk [UMF_MSOLVE_NB] ;
+    XEntry *Xi ;
+    Entry *xp, *Lval ;
+    Int k, deg, *ip, j, r, row, *Lpos, *Lilen, *Lip, llen, lp, newLchain,
+	pos, npiv, n1, *Li ;
+
+    npiv = Numeric->npiv ;
+    Lpos = Numeric->Lpos ;
+    Lilen = Numeric->Lilen ;
+    Lip = Numeric->Lip ;
+    n1 = Numeric->n1 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* singletons */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n1 ; k++)
+    {
+	deg = Lilen [k] ;
+	if (deg > 0)
+	{
+	    lp = Lip [k] ;
+	    Li = (Int *) (Numeric->Memory + lp) ;
+	    lp += UNITS (Int, deg) ;
+	    Lval = (Entry *) (Numeric->Memory + lp) ;
+	    for (r = 0 ; r < nb ; r++)
+	    {
+		xk [r] = X [k*nb+r] ;
+	    }
+	    for (j = 0 ; j < deg ; j++)
+	    {
+		Xi = X + Li [j] * nb ;
+		for (r = 0 ; r < nb ; r++)
+		{
+		    /* X [Li [j]] -= xk * Lval [j] ; */
+		    MULT_SUB (Xi [r], xk [r], Lval [j]) ;
+		}
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* rest of L */
+    /* ---------------------------------------------------------------------- */
+
+    deg = 0 ;
+
+    for (k = n1 ; k < npiv ; k++)
+    {
+
+	/* make column of L in Pattern [0..deg-1] */
+	lp = Lip [k] ;
+	newLchain = (lp < 0) ;
+	if (newLchain)
+	{
+	    lp = -lp ;
+	    deg = 0 ;
+	}
+
+	/* remove pivot row */
+	pos = Lpos [k] ;
+	if (pos != EMPTY)
+	{
+	    ASSERT (!newLchain) ;
+	    ASSERT (deg > 0) ;
+	    ASSERT (pos >= 0 && pos < deg) ;
+	    ASSERT (Pattern [pos] == k) ;
+	    Pattern [pos] = Pattern [--deg] ;
+	}
+
+	/* concatenate the pattern */
+	ip = (Int *) (Numeric->Memory + lp) ;
+	llen = Lilen [k] ;
+	for (j = 0 ; j < llen ; j++)
+	{
+	    row = *ip++ ;
+	    ASSERT (row > k) ;
+	    Pattern [deg++] = row ;
+	}
+
+	/* use column k of L */
+	for (r = 0 ; r < nb ; r++)
+	{
+	    xk [r] = X [k*nb+r] ;
+	}
+	xp = (Entry *) (Numeric->Memory + lp + UNITS (Int, llen)) ;
+	for (j = 0 ; j < deg ; j++)
+	{
+	    Xi = X + Pattern [j] * nb ;
+	    for (r = 0 ; r < nb ; r++)
+	    {
+		/* X [Pattern [j]] -= xk * (*xp) ; */
+		MULT_SUB (Xi [r], xk [r], *xp) ;
+	    }
+	    xp++ ;
+	}
+    }
+
+    return (MULTSUB_FLOPS * ((double) Numeric->lnz) * nb) ;
+}
+
+
+/* ========================================================================== */
+/* === usolve_block ========================================================= */
+/* ========================================================================== */
+
+/* Solves U X = B for nb interleaved right-hand sides, as UMF_usolve does for
+ * one.  Returns the floating point operation count. */
+
+PRIVATE double usolve_block
+(
+    NumericType *Numeric,
+    XEntry X [ ],		/* B on input, solution X on output */
+    Int nb,
+    Int Pattern [ ]		/* a work array of size n */
+)
+{
+    XEntry xk [UMF_MSOLVE_NB] ;
+    XEntry *Xj ;
+    Entry *xp, *D, *Uval ;
+    Int k, deg, j, r, *ip, col, *Upos, *Uilen, pos,
+	*Uip, n, ulen, up, newUchain, npiv, n1, *Ui ;
+
+    n = Numeric->n_row ;
+    npiv = Numeric->npiv ;
+    Upos = Numeric->Upos ;
+    Uilen = Numeric->Uilen ;
+    Uip = Numeric->Uip ;
+    D = Numeric->D ;
+    n1 = Numeric->n1 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* singular case */
+    /* ---------------------------------------------------------------------- */
+
+#ifndef NO_DIVIDE_BY_ZERO
+    /* handle the singular part of D, up to just before the last pivot */
+    for (k = n-1 ; k >= npiv ; k--)
+    {
+	/* This is an *** intentional *** divide-by-zero, to get Inf or Nan,
+	 * as appropriate.  It is not a bug. */
+	for (r = 0 ; r < nb ; r++)
+	{
+	    xk [r] = X [k*nb+r] ;
+	    DIV (X [k*nb+r], xk [r], D [k]) ;
+	}
+    }
+#endif
+
+    deg = Numeric->ulen ;
+    for (j = 0 ; j < deg ; j++)
+    {
+	/* :: make last pivot row of U (singular matrices only) :: */
+	Pattern [j] = Numeric->Upattern [j] ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* nonsingletons */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = npiv-1 ; k >= n1 ; k--)
+    {
+
+	/* use row k of U */
+	up = Uip [k] ;
+	ulen = Uilen [k] ;
+	newUchain = (up < 0) ;
+	if (newUchain)
+	{
+	    up = -up ;
+	    xp = (Entry *) (Numeric->Memory + up + UNITS (Int, ulen)) ;
+	}
+	else
+	{
+	    xp = (Entry *) (Numeric->Memory + up) ;
+	}
+
+	for (r = 0 ; r < nb ; r++)
+	{
+	    xk [r] = X [k*nb+r] ;
+	}
+	for (j = 0 ; j < deg ; j++)
+	{
+	    Xj = X + Pattern [j] * nb ;
+	    for (r = 0 ; r < nb ; r++)
+	    {
+		/* xk -= X [Pattern [j]] * (*xp) ; */
+		MULT_SUB (xk [r], Xj [r], *xp) ;
+	    }
+	    xp++ ;
+	}
+
+#ifndef NO_DIVIDE_BY_ZERO
+	/* Go ahead and divide by zero if D [k] is zero */
+	for (r = 0 ; r < nb ; r++)
+	{
+	    DIV (X [k*nb+r], xk [r], D [k]) ;
+	}
+#else
+	/* Do not divide by zero */
+	if (IS_NONZERO (D [k]))
+	{
+	    for (r = 0 ; r < nb ; r++)
+	    {
+		DIV (X [k*nb+r], xk [r], D [k]) ;
+	    }
+	}
+#endif
+
+	/* make row k-1 of U in Pattern [0..deg-1] */
+	if (k == n1) break ;
+
+	if (newUchain)
+	{
+	    /* next row is a new Uchain */
+	    deg = ulen ;
+	    ip = (Int *) (Numeric->Memory + up) ;
+	    for (j = 0 ; j < deg ; j++)
+	    {
+		col = *ip++ ;
+		ASSERT (k <= col) ;
+		Pattern [j] = col ;
+	    }
+	}
+	else
+	{
+	    deg -= ulen ;
+	    ASSERT (deg >= 0) ;
+	    pos = Upos [k] ;
+	    if (pos != EMPTY)
+	    {
+		/* add the pivot column */
+		ASSERT (pos >= 0 && pos <= deg) ;
+		Pattern [deg++] = Pattern [pos] ;
+		Pattern [pos] = k ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* singletons */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = n1 - 1 ; k >= 0 ; k--)
+    {
+	deg = Uilen [k] ;
+	for (r = 0 ; r < nb ; r++)
+	{
+	    xk [r] = X [k*nb+r] ;
+	}
+	if (deg > 0)
+	{
+	    up = Uip [k] ;
+	    Ui = (Int *) (Numeric->Memory + up) ;
+	    up += UNITS (Int, deg) ;
+	    Uval = (Entry *) (Numeric->Memory + up) ;
+	    for (j = 0 ; j < deg ; j++)
+	    {
+		Xj = X + Ui [j] * nb ;
+		for (r = 0 ; r < nb ; r++)
+		{
+		    /* xk -= X [Ui [j]] * Uval [j] ; */
+		    MULT_SUB (xk [r], Xj [r], Uval [j]) ;
+		}
+	    }
+	}
+
+#ifndef NO_DIVIDE_BY_ZERO
+	for (r = 0 ; r < nb ; r++)
+	{
+	    DIV (X [k*nb+r], xk [r], D [k]) ;
+	}
+#else
+	if (IS_NONZERO (D [k]))
+	{
+	    for (r = 0 ; r < nb ; r++)
+	    {
+		DIV (X [k*nb+r], xk [r], D [k]) ;
+	    }
+	}
+#endif
+
+    }
+
+    return ((DIV_FLOPS * ((double) n) + MULTSUB_FLOPS * ((double) Numeric->unz))
+	* nb) ;
+}
+
+
+/* ========================================================================== */
+/* === do_step ============================================================== */
+/* ========================================================================== */
+
+/* Does one step of iterative refinement for column r of the interleaved X,
+ * exactly as do_step in umf_solve.c does for a single right-hand side.
+ * Colstats [0..3] holds omega1, omega2, and the number of steps taken and
+ * attempted, for this column.  Returns TRUE if iterative refinement is done
+ * for this column. */
+
+PRIVATE Int do_step
+(
+    double omega [3],
+    double Colstats [4],
+    Int step,
+    Int r,
+    Int nb,
+    const double B2 [ ],
+    XEntry X [ ],
+    const XEntry W [ ],
+    const double Y [ ],
+    const double Z2 [ ],
+    XEntry S [ ],
+    Int n
+)
+{
+    double last_omega [3], tau, nctau, d1, wd1, d2, wd2, xi, yix, wi, xnorm ;
+    Int i, ir ;
+
+    nctau = 1000 * n * DBL_EPSILON ;
+
+    /* save the last iteration in case we need to reinstate it */
+    last_omega [0] = omega [0] ;
+    last_omega [1] = omega [1] ;
+    last_omega [2] = omega [2] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compute sparse backward errors: omega [1] and omega [2] */
+    /* ---------------------------------------------------------------------- */
+
+    /* xnorm = ||x|| maxnorm */
+    xnorm = 0.0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+	/* xi = ABS (X [i]) ; */
+	ABS (xi, X [i*nb+r]) ;
+	if (SCALAR_IS_NAN (xi))
+	{
+	    xnorm = xi ;
+	    break ;
+	}
+	/* no NaN's to consider here: */
+	xnorm = MAX (xnorm, xi) ;
+    }
+
+    omega [1] = 0. ;
+    omega [2] = 0. ;
+    for (i = 0 ; i < n ; i++)
+    {
+	ir = i*nb+r ;
+	yix = Y [i] * xnorm ;
+	tau = (yix + B2 [ir]) * nctau ;
+	d1 = Z2 [ir] + B2 [ir] ;
+	/* wi = ABS (W [i]) ; */
+	ABS (wi, W [ir]) ;
+	if (SCALAR_IS_NAN (d1))
+	{
+	    omega [1] = d1 ;
+	    omega [2] = d1 ;
+	    break ;
+	}
+	if (SCALAR_IS_NAN (tau))
+	{
+	    omega [1] = tau ;
+	    omega [2] = tau ;
+	    break ;
+	}
+	if (d1 > tau)		/* a double relop, but no NaN's here */
+	{
+	    wd1 = wi / d1 ;
+	    omega [1] = MAX (omega [1], wd1) ;
+	}
+	else if (tau > 0.0)	/* a double relop, but no NaN's here */
+	{
+	    d2 = Z2 [ir] + yix ;
+	    wd2 = wi / d2 ;
+	    omega [2] = MAX (omega [2], wd2) ;
+	}
+    }
+
+    omega [0] = omega [1] + omega [2] ;
+    Colstats [0] = omega [1] ;
+    Colstats [1] = omega [2] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* stop the iterations if the backward error is small, or NaN */
+    /* ---------------------------------------------------------------------- */
+
+    Colstats [2] = step ;
+    Colstats [3] = step ;
+
+    if (SCALAR_IS_NAN (omega [0]) || omega [0] < DBL_EPSILON)
+    {
+	return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* stop if insufficient decrease in omega */
+    /* ---------------------------------------------------------------------- */
+
+    /* double relop, but no NaN case here: */
+    if (step > 0 && omega [0] > last_omega [0] / 2)
+    {
+	if (omega [0] > last_omega [0])
+	{
+	    /* last iteration better than this one, reinstate it */
+	    for (i = 0 ; i < n ; i++)
+	    {
+		X [i*nb+r] = S [i*nb+r] ;
+	    }
+	    Colstats [0] = last_omega [1] ;
+	    Colstats [1] = last_omega [2] ;
+	}
+	Colstats [2] = step - 1 ;
+	return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* save current solution in case we need to reinstate */
+    /* ---------------------------------------------------------------------- */
+
+    for (i = 0 ; i < n ; i++)
+    {
+	S [i*nb+r] = X [i*nb+r] ;
+    }
+
+    return (FALSE) ;
+}
@@ -0,0 +1,26 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/* maximum number of right-hand sides solved together by UMF_msolve */
+#define UMF_MSOLVE_NB 16
+
+GLOBAL Int UMF_msolve
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    NumericType *Numeric,
+    Int nb,
+    Int irstep,
+    const double Y [ ],
+    const XEntry B [ ],
+    XEntry X [ ],
+    double Stats [5],
+    Int Pattern [ ],
+    double SolveWork [ ]
+) ;
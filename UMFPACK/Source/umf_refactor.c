@@ -0,0 +1,785 @@
+/* ========================================================================== */
+/* === UMF_refactor ========================================================= */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    Not user-callable.  Recomputes the numerical values of the LU factors in
+    an existing Numeric object, for a matrix A with the same nonzero pattern
+    as the one originally factorized, but new numerical values.  The row and
+    column permutations, the row scaling method, and the pattern of L and U
+    are all kept.  Only square nonsingular factorizations can be refactorized.
+
+    The factors are recomputed in place with a left-looking method, one
+    column of L and U at a time.  There is no frontal matrix, no assembly
+    tree, and no memory management.  The compressed row-oriented form of U
+    in Numeric->Memory is not suitable for this, so a column-oriented map of
+    L and U (Numeric->Rf_*) is constructed the first time UMF_refactor is
+    called for a given Numeric object, and reused in subsequent calls.
+
+    The frozen pivot sequence is only used if it remains numerically
+    acceptable.  Each pivot must be nonzero and not NaN, and (except for
+    singletons) must pass the same threshold test used by UMFPACK_numeric:
+    Numeric->relpt times the largest entry in its column of L (or
+    Numeric->relpt2, for a diagonal pivot if prefer_diagonal is true).  If an
+    entry of A, or a fill-in created by the factorization, falls outside the
+    pattern of L and U (an entry that was exactly zero in the original
+    factorization may have been discarded from L or U), and is not negligible
+    (see factorize, below), then the refactorization also fails.
+
+    Returns TRUE if successful, FALSE if the refactorization failed or ran
+    out of memory.  If FALSE is returned, the numerical values in Numeric
+    are no longer valid, and the caller must discard or recompute them.
+    The matrix must have already been checked with AMD_valid.
+
+    Dynamic memory usage:  the map requires 2*(n+1) + 2*n integers, plus
+    one integer for each entry in L and two for each off-diagonal entry in
+    U.  This space is kept in the Numeric object.  Workspace of size n Entry's,
+    n doubles, and 2*n integers is allocated and freed on each call.
+*/
+
+#include "umf_internal.h"
+#include "umf_refactor.h"
+#include "umf_scale.h"
+#include "umf_malloc.h"
+#include "umf_free.h"
+
+/* Offsets in Numeric->Memory are in units of the real part of an Entry
+ * (float in the single precision versions, double otherwise), since a complex
+ * Entry need not be aligned on a multiple of its own size. */
+#ifdef SINGLE
+#define RF_Real float
+#define RF_EPSILON FLT_EPSILON
+#else
+#define RF_Real double
+#define RF_EPSILON DBL_EPSILON
+#endif
+
+/* offset of a value in Numeric->Memory */
+#define RF_OFFSET(x) \
+    ((Int) (((RF_Real *) (x)) - ((RF_Real *) Numeric->Memory)))
+
+/* value in Numeric->Memory at a given offset */
+#define RF_ENTRY(off) ((Entry *) (((RF_Real *) Numeric->Memory) + (off)))
+
+/* an entry outside the pattern of L and U is negligible if it is no larger
+ * than this, relative to the sum of the magnitudes of the terms it was
+ * computed from */
+#define RF_CANCEL_TOLERANCE (64 * RF_EPSILON)
+
+/* ========================================================================== */
+/* === walk_l =============================================================== */
+/* ========================================================================== */
+
+/* Traverses the columns of L in the same manner as UMF_lsolve.  If Li is
+ * NULL, Lp [k] is set to the number of entries in column k of L.  Otherwise,
+ * the row indices of column k of L are placed in Li [Lp [k] ... Lp [k+1]-1],
+ * in the same order as its values, and the offset of its first value is
+ * placed in Lx [k]. */
+
+PRIVATE void walk_l
+(
+    NumericType *Numeric,
+    Int Lp [ ],
+    Int Li [ ],
+    Int Lx [ ],
+    Int Pattern [ ]
+)
+{
+    Int k, j, deg, lp, llen, pos, n1, npiv, *Lpos, *Lilen, *Lip, *ip ;
+
+    npiv = Numeric->npiv ;
+    n1 = Numeric->n1 ;
+    Lpos = Numeric->Lpos ;
+    Lilen = Numeric->Lilen ;
+    Lip = Numeric->Lip ;
+
+    /* singletons */
+    for (k = 0 ; k < n1 ; k++)
+    {
+	deg = Lilen [k] ;
+	if (Li == (Int *) NULL)
+	{
+	    Lp [k] = deg ;
+	}
+	else if (deg > 0)
+	{
+	    lp = Lip [k] ;
+	    ip = (Int *) (Numeric->Memory + lp) ;
+	    for (j = 0 ; j < deg ; j++)
+	    {
+		Li [Lp [k] + j] = ip [j] ;
+	    }
+	    Lx [k] = RF_OFFSET (Numeric->Memory + lp + UNITS (Int, deg)) ;
+	}
+	else
+	{
+	    /* column k of L is empty */
+	    Lx [k] = 0 ;
+	}
+    }
+
+    /* rest of L */
+    deg = 0 ;
+    for (k = n1 ; k < npiv ; k++)
+    {
+	lp = Lip [k] ;
+	if (lp < 0)
+	{
+	    /* start of a new Lchain */
+	    lp = -lp ;
+	    deg = 0 ;
+	}
+	pos = Lpos [k] ;
+	if (pos != EMPTY)
+	{
+	    /* remove pivot row */
+	    Pattern [pos] = Pattern [--deg] ;
+	}
+	ip = (Int *) (Numeric->Memory + lp) ;
+	llen = Lilen [k] ;
+	for (j = 0 ; j < llen ; j++)
+	{
+	    Pattern [deg++] = *ip++ ;
+	}
+	if (Li == (Int *) NULL)
+	{
+	    Lp [k] = deg ;
+	}
+	else
+	{
+	    for (j = 0 ; j < deg ; j++)
+	    {
+		Li [Lp [k] + j] = Pattern [j] ;
+	    }
+	    Lx [k] = RF_OFFSET (Numeric->Memory + lp + UNITS (Int, llen)) ;
+	}
+    }
+}
+
+
+/* ========================================================================== */
+/* === walk_u =============================================================== */
+/* ========================================================================== */
+
+/* Traverses the rows of U in the same manner as UMF_usolve (from the last
+ * row to the first).  If Ui is NULL, Up [j] is incremented for each entry in
+ * column j of U.  Otherwise, each entry U (k,j) is placed at position
+ * p = --Up [j], with Ui [p] = k and Ux [p] holding the offset of its value.
+ * Since the rows are traversed in descending order, the row indices in each
+ * column come out in ascending order. */
+
+PRIVATE void walk_u
+(
+    NumericType *Numeric,
+    Int Up [ ],
+    Int Ui [ ],
+    Int Ux [ ],
+    Int Pattern [ ]
+)
+{
+    Entry *xp ;
+    Int k, j, p, deg, up, ulen, pos, n1, npiv, newUchain, *Upos, *Uilen,
+	*Uip, *ip ;
+
+    npiv = Numeric->npiv ;
+    n1 = Numeric->n1 ;
+    Upos = Numeric->Upos ;
+    Uilen = Numeric->Uilen ;
+    Uip = Numeric->Uip ;
+
+    /* nonsingletons.  The matrix is nonsingular, so the last row of U is
+     * empty (Numeric->ulen is zero). */
+    deg = 0 ;
+    for (k = npiv-1 ; k >= n1 ; k--)
+    {
+	up = Uip [k] ;
+	ulen = Uilen [k] ;
+	newUchain = (up < 0) ;
+	if (newUchain)
+	{
+	    up = -up ;
+	    xp = (Entry *) (Numeric->Memory + up + UNITS (Int, ulen)) ;
+	}
+	else
+	{
+	    xp = (Entry *) (Numeric->Memory + up) ;
+	}
+
+	/* row k of U is in Pattern [0..deg-1] */
+	for (j = 0 ; j < deg ; j++)
+	{
+	    if (Ui == (Int *) NULL)
+	    {
+		Up [Pattern [j]]++ ;
+	    }
+	    else
+	    {
+		p = --Up [Pattern [j]] ;
+		Ui [p] = k ;
+		Ux [p] = RF_OFFSET (xp + j) ;
+	    }
+	}
+
+	/* make row k-1 of U in Pattern [0..deg-1] */
+	if (k == n1) break ;
+	if (newUchain)
+	{
+	    deg = ulen ;
+	    ip = (Int *) (Numeric->Memory + up) ;
+	    for (j = 0 ; j < deg ; j++)
+	    {
+		Pattern [j] = *ip++ ;
+	    }
+	}
+	else
+	{
+	    deg -= ulen ;
+	    pos = Upos [k] ;
+	    if (pos != EMPTY)
+	    {
+		/* add the pivot column */
+		Pattern [deg++] = Pattern [pos] ;
+		Pattern [pos] = k ;
+	    }
+	}
+    }
+
+    /* singletons */
+    for (k = n1 - 1 ; k >= 0 ; k--)
+    {
+	deg = Uilen [k] ;
+	if (deg > 0)
+	{
+	    up = Uip [k] ;
+	    ip = (Int *) (Numeric->Memory + up) ;
+	    xp = (Entry *) (Numeric->Memory + up + UNITS (Int, deg)) ;
+	    for (j = 0 ; j < deg ; j++)
+	    {
+		if (Ui == (Int *) NULL)
+		{
+		    Up [ip [j]]++ ;
+		}
+		else
+		{
+		    p = --Up [ip [j]] ;
+		    Ui [p] = k ;
+		    Ux [p] = RF_OFFSET (xp + j) ;
+		}
+	    }
+	}
+    }
+}
+
+
+/* ========================================================================== */
+/* === build_map ============================================================ */
+/* ========================================================================== */
+
+/* Construct the column-oriented map of L and U.  Returns FALSE if out of
+ * memory (any parts allocated are freed by UMFPACK_free_numeric). */
+
+PRIVATE Int build_map
+(
+    NumericType *Numeric,
+    Int Pattern [ ]
+)
+{
+    Int n, k, p, lnz, unz, *Lp, *Up, *Rinv ;
+
+    n = Numeric->n_row ;
+
+    Numeric->Rf_Lp = (Int *) UMF_malloc (n+1, sizeof (Int)) ;
+    Numeric->Rf_Lx = (Int *) UMF_malloc (n, sizeof (Int)) ;
+    Numeric->Rf_Up = (Int *) UMF_malloc (n+1, sizeof (Int)) ;
+    Numeric->Rf_Rinv = (Int *) UMF_malloc (n, sizeof (Int)) ;
+    if (!Numeric->Rf_Lp || !Numeric->Rf_Lx || !Numeric->Rf_Up
+	|| !Numeric->Rf_Rinv)
+    {
+	return (FALSE) ;
+    }
+    Lp = Numeric->Rf_Lp ;
+    Up = Numeric->Rf_Up ;
+    Rinv = Numeric->Rf_Rinv ;
+
+    /* ---------------------------------------------------------------------- */
+    /* inverse row permutation */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+	Rinv [Numeric->Rperm [k]] = k ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* count the entries in each column of L and U */
+    /* ---------------------------------------------------------------------- */
+
+    walk_l (Numeric, Lp, (Int *) NULL, (Int *) NULL, Pattern) ;
+    for (k = 0 ; k <= n ; k++)
+    {
+	Up [k] = 0 ;
+    }
+    walk_u (Numeric, Up, (Int *) NULL, (Int *) NULL, Pattern) ;
+
+    /* Lp becomes the column pointers of L.  Up [k] becomes the end of column
+     * k of U, and is then decremented back to its start by walk_u. */
+    lnz = 0 ;
+    unz = 0 ;
+    for (k = 0 ; k < n ; k++)
+    {
+	p = Lp [k] ;
+	Lp [k] = lnz ;
+	lnz += p ;
+	unz += Up [k] ;
+	Up [k] = unz ;
+    }
+    Lp [n] = lnz ;
+    Up [n] = unz ;
+
+    /* ---------------------------------------------------------------------- */
+    /* fill the row indices and value offsets */
+    /* ---------------------------------------------------------------------- */
+
+    Numeric->Rf_Li = (Int *) UMF_malloc (lnz+1, sizeof (Int)) ;
+    Numeric->Rf_Ui = (Int *) UMF_malloc (unz+1, sizeof (Int)) ;
+    Numeric->Rf_Ux = (Int *) UMF_malloc (unz+1, sizeof (Int)) ;
+    if (!Numeric->Rf_Li || !Numeric->Rf_Ui || !Numeric->Rf_Ux)
+    {
+	return (FALSE) ;
+    }
+
+    walk_l (Numeric, Lp, Numeric->Rf_Li, Numeric->Rf_Lx, Pattern) ;
+    walk_u (Numeric, Up, Numeric->Rf_Ui, Numeric->Rf_Ux, Pattern) ;
+    ASSERT (Up [0] == 0) ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === scale_factors ======================================================== */
+/* ========================================================================== */
+
+/* Recompute the row scale factors for the new values of A, in the same
+ * manner as UMF_kernel_init. */
+
+PRIVATE void scale_factors
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    NumericType *Numeric
+)
+{
+    XEntry aij ;
+    double value, rs, rsmin, rsmax, *Rs ;
+    Int n, row, col, p, do_max ;
+#ifdef COMPLEX
+    Int split = SPLIT (Az) ;
+#endif
+
+    n = Numeric->n_row ;
+    Rs = Numeric->Rs ;
+
+    if (Numeric->scale == UMFPACK_SCALE_NONE)
+    {
+	Numeric->rsmin = -1 ;
+	Numeric->rsmax = -1 ;
+	Numeric->do_recip = FALSE ;
+	return ;
+    }
+
+    do_max = (Numeric->scale == UMFPACK_SCALE_MAX) ;
+    for (row = 0 ; row < n ; row++)
+    {
+	Rs [row] = 0.0 ;
+    }
+    for (col = 0 ; col < n ; col++)
+    {
+	for (p = Ap [col] ; p < Ap [col+1] ; p++)
+	{
+	    row = Ai [p] ;
+	    ASSIGN (aij, Ax, Az, p, split) ;
+	    APPROX_ABS (value, aij) ;
+	    rs = Rs [row] ;
+	    if (!SCALAR_IS_NAN (rs))
+	    {
+		if (SCALAR_IS_NAN (value))
+		{
+		    Rs [row] = value ;
+		}
+		else if (do_max)
+		{
+		    Rs [row] = MAX (rs, value) ;
+		}
+		else
+		{
+		    Rs [row] += value ;
+		}
+	    }
+	}
+    }
+    for (row = 0 ; row < n ; row++)
+    {
+	rs = Rs [row] ;
+	if (SCALAR_IS_ZERO (rs) || SCALAR_IS_NAN (rs))
+	{
+	    /* don't scale a completely zero row, or one with NaN's */
+	    Rs [row] = 1.0 ;
+	}
+    }
+    rsmin = Rs [0] ;
+    rsmax = Rs [0] ;
+    for (row = 0 ; row < n ; row++)
+    {
+	rsmin = MIN (rsmin, Rs [row]) ;
+	rsmax = MAX (rsmax, Rs [row]) ;
+    }
+    Numeric->rsmin = rsmin ;
+    Numeric->rsmax = rsmax ;
+
+#ifndef NRECIPROCAL
+    /* multiply by the reciprocal if Rs is not too small */
+    Numeric->do_recip = (rsmin >= RECIPROCAL_TOLERANCE) ;
+    if (Numeric->do_recip)
+    {
+	for (row = 0 ; row < n ; row++)
+	{
+	    Rs [row] = 1.0 / Rs [row] ;
+	}
+    }
+#else
+    Numeric->do_recip = FALSE ;
+#endif
+}
+
+
+/* ========================================================================== */
+/* === factorize ============================================================ */
+/* ========================================================================== */
+
+/* Left-looking LU factorization with the pivot sequence and the pattern of
+ * L and U held fixed.  X [0..n-1] and W [0..n-1] must be zero, and
+ * Mark [0..n-1] must be EMPTY, on input, and are restored on output if TRUE
+ * is returned.  Returns FALSE if the pivot sequence cannot be reused.
+ *
+ * UMFPACK_numeric does not store entries of L and U that are exactly zero
+ * when they start a new L or U chain.  Some of these are the result of exact
+ * cancellation (x - x), which need not be exact when the same entry is
+ * computed here in a different order.  Updates to rows outside the pattern of
+ * column k are thus kept in X, with Mark [i] = OUTSIDE (k), and the sum of the
+ * magnitudes of the terms is kept in W [i].  When column k is complete, each
+ * such entry must be negligible relative to W [i], and is discarded. */
+
+#define OUTSIDE(k) (-(k)-2)
+
+PRIVATE Int factorize
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    NumericType *Numeric,
+    Int prefer_diagonal,
+    Entry X [ ],
+    double W [ ],
+    Int Mark [ ],
+    Int Fill [ ]
+)
+{
+    Entry aij, ujk, pivot, *Lval, *D ;
+    double *Rs, d, dl, maxval, toler, flops ;
+    Int n, n1, k, j, i, p, q, row, col, llen, do_scale, do_recip, nfill, ok,
+	*Rperm, *Cperm, *Rinv, *Lp, *Li, *Lx, *Up, *Ui, *Ux ;
+#ifdef COMPLEX
+    Int split = SPLIT (Az) ;
+#endif
+
+    n = Numeric->n_row ;
+    n1 = Numeric->n1 ;
+    D = Numeric->D ;
+    Rperm = Numeric->Rperm ;
+    Cperm = Numeric->Cperm ;
+    Rs = Numeric->Rs ;
+    do_scale = (Numeric->scale != UMFPACK_SCALE_NONE) ;
+    do_recip = Numeric->do_recip ;
+    Rinv = Numeric->Rf_Rinv ;
+    Lp = Numeric->Rf_Lp ;
+    Li = Numeric->Rf_Li ;
+    Lx = Numeric->Rf_Lx ;
+    Up = Numeric->Rf_Up ;
+    Ui = Numeric->Rf_Ui ;
+    Ux = Numeric->Rf_Ux ;
+    flops = 0 ;
+
+    for (k = 0 ; k < n ; k++)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* mark the pattern of column k of U and L */
+	/* ------------------------------------------------------------------ */
+
+	for (p = Up [k] ; p < Up [k+1] ; p++)
+	{
+	    Mark [Ui [p]] = k ;
+	}
+	Mark [k] = k ;
+	for (p = Lp [k] ; p < Lp [k+1] ; p++)
+	{
+	    Mark [Li [p]] = k ;
+	}
+	nfill = 0 ;
+
+	/* ------------------------------------------------------------------ */
+	/* scatter the scaled and permuted column of A into X */
+	/* ------------------------------------------------------------------ */
+
+	col = Cperm [k] ;
+	for (p = Ap [col] ; p < Ap [col+1] ; p++)
+	{
+	    row = Ai [p] ;
+	    ASSIGN (aij, Ax, Az, p, split) ;
+	    if (do_scale)
+	    {
+		if (do_recip)
+		{
+		    /* multiply by the reciprocal */
+		    SCALE (aij, Rs [row]) ;
+		}
+		else
+		{
+		    /* divide instead */
+		    SCALE_DIV (aij, Rs [row]) ;
+		}
+	    }
+	    i = Rinv [row] ;
+	    X [i] = aij ;
+	    if (Mark [i] != k)
+	    {
+		/* A (i,k) is not in the pattern of L or U */
+		Mark [i] = OUTSIDE (k) ;
+		Fill [nfill++] = i ;
+		APPROX_ABS (W [i], aij) ;
+	    }
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* compute column k of U, and update X with the columns of L */
+	/* ------------------------------------------------------------------ */
+
+	for (p = Up [k] ; p < Up [k+1] ; p++)
+	{
+	    j = Ui [p] ;
+	    ujk = X [j] ;
+	    *RF_ENTRY (Ux [p]) = ujk ;
+	    if (IS_NONZERO (ujk))
+	    {
+		Lval = RF_ENTRY (Lx [j]) ;
+		llen = Lp [j+1] - Lp [j] ;
+		for (q = 0 ; q < llen ; q++)
+		{
+		    i = Li [Lp [j] + q] ;
+		    /* X [i] -= ujk * Lval [q] ; */
+		    MULT_SUB (X [i], ujk, Lval [q]) ;
+		    if (Mark [i] != k)
+		    {
+			/* fill-in outside the pattern of L and U */
+			if (Mark [i] != OUTSIDE (k))
+			{
+			    Mark [i] = OUTSIDE (k) ;
+			    Fill [nfill++] = i ;
+			}
+			APPROX_ABS (d, ujk) ;
+			APPROX_ABS (dl, Lval [q]) ;
+			W [i] += d * dl ;
+		    }
+		}
+		flops += MULTSUB_FLOPS * llen ;
+	    }
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* discard entries outside the pattern, if they cancelled */
+	/* ------------------------------------------------------------------ */
+
+	ok = TRUE ;
+	for (p = 0 ; p < nfill ; p++)
+	{
+	    i = Fill [p] ;
+	    APPROX_ABS (d, X [i]) ;
+	    if (!(d <= RF_CANCEL_TOLERANCE * W [i]))
+	    {
+		DEBUGm4 (("refactor: entry ("ID","ID") not in L or U\n", i, k)) ;
+		ok = FALSE ;
+	    }
+	    CLEAR (X [i]) ;
+	    W [i] = 0 ;
+	    Mark [i] = EMPTY ;
+	}
+	if (!ok)
+	{
+	    return (FALSE) ;
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* gather column k of L and check the pivot */
+	/* ------------------------------------------------------------------ */
+
+	Lval = RF_ENTRY (Lx [k]) ;
+	llen = Lp [k+1] - Lp [k] ;
+	maxval = 0 ;
+	for (q = 0 ; q < llen ; q++)
+	{
+	    Lval [q] = X [Li [Lp [k] + q]] ;
+	    APPROX_ABS (d, Lval [q]) ;
+	    if (SCALAR_IS_NAN (d))
+	    {
+		return (FALSE) ;
+	    }
+	    maxval = MAX (maxval, d) ;
+	}
+
+	pivot = X [k] ;
+	APPROX_ABS (d, pivot) ;
+	if (SCALAR_IS_ZERO (d) || SCALAR_IS_NAN (d))
+	{
+	    DEBUGm4 (("refactor: zero pivot "ID"\n", k)) ;
+	    return (FALSE) ;
+	}
+	if (k >= n1)
+	{
+	    /* singletons need no threshold test */
+	    toler = (prefer_diagonal && Rperm [k] == Cperm [k]) ?
+		Numeric->relpt2 : Numeric->relpt ;
+	    if (d < toler * maxval)
+	    {
+		DEBUGm4 (("refactor: pivot "ID" too small\n", k)) ;
+		return (FALSE) ;
+	    }
+	}
+	D [k] = pivot ;
+	UMF_scale (llen, pivot, Lval) ;
+	flops += DIV_FLOPS * llen ;
+
+	/* ------------------------------------------------------------------ */
+	/* clear X */
+	/* ------------------------------------------------------------------ */
+
+	for (p = Up [k] ; p < Up [k+1] ; p++)
+	{
+	    CLEAR (X [Ui [p]]) ;
+	}
+	CLEAR (X [k]) ;
+	for (p = Lp [k] ; p < Lp [k+1] ; p++)
+	{
+	    CLEAR (X [Li [p]]) ;
+	}
+    }
+
+    Numeric->flops = flops ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === UMF_refactor ========================================================= */
+/* ========================================================================== */
+
+GLOBAL Int UMF_refactor
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    NumericType *Numeric,
+    Int prefer_diagonal
+)
+{
+    Entry *X ;
+    double d, *W ;
+    Int n, k, ok, *Mark, *Fill ;
+
+    n = Numeric->n_row ;
+    if (n != Numeric->n_col || Numeric->npiv != n || Numeric->nnzpiv != n
+	|| Numeric->ulen != 0)
+    {
+	/* only square nonsingular factorizations can be refactorized */
+	return (FALSE) ;
+    }
+
+    X = (Entry *) UMF_malloc (n, sizeof (Entry)) ;
+    W = (double *) UMF_malloc (n, sizeof (double)) ;
+    Mark = (Int *) UMF_malloc (n, sizeof (Int)) ;
+    Fill = (Int *) UMF_malloc (n, sizeof (Int)) ;
+    ok = (X && W && Mark && Fill) ;
+
+    /* construct the map of L and U, if not already done */
+    if (ok && !Numeric->Rf_Lp)
+    {
+	/* Mark is used as workspace for the pattern of L and U */
+	ok = build_map (Numeric, Mark) ;
+    }
+
+    if (ok)
+    {
+	for (k = 0 ; k < n ; k++)
+	{
+	    CLEAR (X [k]) ;
+	    W [k] = 0 ;
+	    Mark [k] = EMPTY ;
+	}
+	scale_factors (Ap, Ai, Ax,
+#ifdef COMPLEX
+	    Az,
+#endif
+	    Numeric) ;
+	ok = factorize (Ap, Ai, Ax,
+#ifdef COMPLEX
+	    Az,
+#endif
+	    Numeric, prefer_diagonal, X, W, Mark, Fill) ;
+    }
+
+    (void) UMF_free ((void *) X) ;
+    (void) UMF_free ((void *) W) ;
+    (void) UMF_free ((void *) Mark) ;
+    (void) UMF_free ((void *) Fill) ;
+
+    if (!ok)
+    {
+	return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* find the smallest and largest entries in D */
+    /* ---------------------------------------------------------------------- */
+
+    /* all pivots are nonzero and not NaN, as checked by factorize */
+    for (k = 0 ; k < n ; k++)
+    {
+	ABS (d, Numeric->D [k]) ;
+	if (k == 0)
+	{
+	    Numeric->min_udiag = d ;
+	    Numeric->max_udiag = d ;
+	}
+	else
+	{
+	    Numeric->min_udiag = MIN (Numeric->min_udiag, d) ;
+	    Numeric->max_udiag = MAX (Numeric->max_udiag, d) ;
+	}
+    }
+    Numeric->rcond = Numeric->min_udiag / Numeric->max_udiag ;
+    return (TRUE) ;
+}
@@ -22,8 +22,8 @@ PRIVATE void print_value
     Int scalar		    /* if true, then print real part only */
 )
 {
-    Entry xi ;
-    /* if Xz is null, then X is in "merged" format (compatible with Entry, */
+    XEntry xi ;
+    /* if Xz is null, then X is in "merged" format (compatible with XEntry, */
     /* and ANSI C99 double _Complex type). */
     PRINTF (("    "ID" :", INDEX (i))) ;
     if (scalar)
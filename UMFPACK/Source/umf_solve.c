@@ -38,11 +38,11 @@ PRIVATE Int do_step
     double omega [3],
     Int step,
     const double B2 [ ],
-    Entry X [ ],
-    const Entry W [ ],
+    XEntry X [ ],
+    const XEntry W [ ],
     const double Y [ ],
     const double Z2 [ ],
-    Entry S [ ],
+    XEntry S [ ],
     Int n,
     double Info [UMFPACK_INFO]
 ) ;
@@ -76,9 +76,9 @@ GLOBAL Int UMF_solve
     /* local variables */
     /* ---------------------------------------------------------------------- */
 
-    Entry axx, wi, xj, zi, xi, aij, bi ;
+    XEntry axx, wi, xj, zi, xi, aij, bi ;
     double omega [3], d, z2i, yi, flops ;
-    Entry *W, *Z, *S, *X ;
+    XEntry *W, *Z, *S, *X ;
     double *Z2, *Y, *B2, *Rs ;
     Int *Rperm, *Cperm, i, n, p, step, j, nz, status, p2, do_scale ;
 #ifdef COMPLEX
@@ -129,10 +129,10 @@ GLOBAL Int UMF_solve
     }
     irstep = MAX (0, irstep) ;			/* make sure irstep is >= 0 */
 
-    W = (Entry *) SolveWork ;			/* Entry W [0..n-1] */
+    W = (XEntry *) SolveWork ;			/* XEntry W [0..n-1] */
 
-    Z = (Entry *) NULL ;	/* unused if no iterative refinement */
-    S = (Entry *) NULL ;
+    Z = (XEntry *) NULL ;	/* unused if no iterative refinement */
+    S = (XEntry *) NULL ;
     Y = (double *) NULL ;
     Z2 = (double *) NULL ;
     B2 = (double *) NULL ;
@@ -146,8 +146,8 @@ GLOBAL Int UMF_solve
 	}
 	/* A, B, and X in split format if Az, Bz, and Xz present */
 	AXsplit = SPLIT (Az) || SPLIT(Xz);
-	Z = (Entry *) (SolveWork + 4*n) ;	/* Entry Z [0..n-1] */
-	S = (Entry *) (SolveWork + 6*n) ;	/* Entry S [0..n-1] */
+	Z = (XEntry *) (SolveWork + 4*n) ;	/* XEntry Z [0..n-1] */
+	S = (XEntry *) (SolveWork + 6*n) ;	/* XEntry S [0..n-1] */
 	Y = (double *) (SolveWork + 8*n) ;	/* double Y [0..n-1] */
 	B2 = (double *) (SolveWork + 9*n) ;	/* double B2 [0..n-1] */
 	Z2 = (double *) Z ;		/* double Z2 [0..n-1], equiv. to Z */
@@ -161,22 +161,22 @@ GLOBAL Int UMF_solve
 
     if (AXsplit)
     {
-	X = (Entry *) (SolveWork + 2*n) ;	/* Entry X [0..n-1] */
+	X = (XEntry *) (SolveWork + 2*n) ;	/* XEntry X [0..n-1] */
     }
     else
     {
-	X = (Entry *) Xx ;			/* Entry X [0..n-1] */
+	X = (XEntry *) Xx ;			/* XEntry X [0..n-1] */
     }
 #else
-    X = (Entry *) Xx ;				/* Entry X [0..n-1] */
+    X = (XEntry *) Xx ;				/* XEntry X [0..n-1] */
     if (irstep > 0)
     {
 	if (!Ap || !Ai || !Ax)
 	{
 	    return (UMFPACK_ERROR_argument_missing) ;
 	}
-	Z = (Entry *) (SolveWork + n) ;		/* Entry Z [0..n-1] */
-	S = (Entry *) (SolveWork + 2*n) ;	/* Entry S [0..n-1] */
+	Z = (XEntry *) (SolveWork + n) ;		/* XEntry Z [0..n-1] */
+	S = (XEntry *) (SolveWork + 2*n) ;	/* XEntry S [0..n-1] */
 	Y = (double *) (SolveWork + 3*n) ;	/* double Y [0..n-1] */
 	B2 = (double *) (SolveWork + 4*n) ;	/* double B2 [0..n-1] */
 	Z2 = (double *) Z ;		/* double Z2 [0..n-1], equiv. to Z */
@@ -1211,7 +1211,7 @@ GLOBAL Int UMF_solve
     }
 
 #ifdef COMPLEX
-    /* copy the solution back, from Entry X [ ] to double Xx [ ] and Xz [ ] */
+    /* copy the solution back, from XEntry X [ ] to double Xx [ ] and Xz [ ] */
     if (AXsplit)
     {
 	for (i = 0 ; i < n ; i++)
@@ -1240,11 +1240,11 @@ PRIVATE Int do_step		/* return TRUE if iterative refinement done */
     double omega [3],
     Int step,			/* which step of iterative refinement to do */
     const double B2 [ ],	/* abs (B) */
-    Entry X [ ],
-    const Entry W [ ],
+    XEntry X [ ],
+    const XEntry W [ ],
     const double Y [ ],
     const double Z2 [ ],
-    Entry S [ ],
+    XEntry S [ ],
     Int n,
     double Info [UMFPACK_INFO]
 )
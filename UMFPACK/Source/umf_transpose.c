@@ -15,182 +15,85 @@
 	Uses Gustavson's method (Two Fast Algorithms for Sparse Matrices:
 	Multiplication and Permuted Transposition, ACM Trans. on Math. Softw.,
 	vol 4, no 3, pp. 250-269).
+
+	If compiled with OpenMP, and A is large, the columns of A are split into
+	one contiguous range per thread.  Each thread counts the entries in each
+	row of its own range, and then scatters its range into R starting at the
+	position in each row just past the entries of all prior threads.  R is
+	thus identical to the result computed with a single thread.
+
+	Dynamic memory usage:  if more than one thread is used, workspace of size
+	(nthreads * (n_row+1) + 1) * sizeof (Int) is allocated via UMF_malloc,
+	and free'd on return.  If that fails, a single thread is used.
 */
 
 #include "umf_internal.h"
 #include "umf_transpose.h"
 #include "umf_is_permutation.h"
+#include "umf_malloc.h"
+#include "umf_free.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
-GLOBAL Int UMF_transpose
-(
-    Int n_row,			/* A is n_row-by-n_col */
-    Int n_col,
-    const Int Ap [ ],		/* size n_col+1 */
-    const Int Ai [ ],		/* size nz = Ap [n_col] */
-    const double Ax [ ],	/* size nz if present */
-
-    const Int P [ ],	/* P [k] = i means original row i is kth row in A(P,Q)*/
-			/* P is identity if not present */
-			/* size n_row, if present */
-
-    const Int Q [ ],	/* Q [k] = j means original col j is kth col in A(P,Q)*/
-			/* Q is identity if not present */
-			/* size nq, if present */
-    Int nq,		/* size of Q, ignored if Q is (Int *) NULL */
-
-			/* output matrix: Rp, Ri, Rx, and Rz: */
-    Int Rp [ ],		/* size n_row+1 */
-    Int Ri [ ],		/* size nz */
-    double Rx [ ],	/* size nz, if present */
+/* ========================================================================== */
+/* === transpose_count ====================================================== */
+/* ========================================================================== */
 
-    Int W [ ],		/* size max (n_row,n_col) workspace */
+/* Wt [i] += the number of entries in row i of A (:,Q(j1:j2-1)) */
 
-    Int check		/* if true, then check inputs */
-#ifdef COMPLEX
-    , const double Az [ ]	/* size nz */
-    , double Rz [ ]		/* size nz */
-    , Int do_conjugate		/* if true, then do conjugate transpose */
-				/* otherwise, do array transpose */
-#endif
+PRIVATE void transpose_count
+(
+    Int j1,
+    Int j2,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const Int Q [ ],
+    Int Wt [ ]
 )
 {
-
-    /* ---------------------------------------------------------------------- */
-    /* local variables */
-    /* ---------------------------------------------------------------------- */
-
-    Int i, j, k, p, bp, newj, do_values ;
-#ifdef COMPLEX
-    Int split ;
-#endif
-
-    /* ---------------------------------------------------------------------- */
-    /* check inputs */
-    /* ---------------------------------------------------------------------- */
-
-#ifndef NDEBUG
-    Int nz ;
-    ASSERT (n_col >= 0) ;
-    nz = (Ap != (Int *) NULL) ? Ap [n_col] : 0 ;
-    DEBUG2 (("UMF_transpose: "ID"-by-"ID" nz "ID"\n", n_row, n_col, nz)) ;
-#endif
-
-    if (check)
+    Int j, newj, p ;
+    for (newj = j1 ; newj < j2 ; newj++)
     {
-	/* UMFPACK_symbolic skips this check */
-	/* UMFPACK_transpose always does this check */
-	if (!Ai || !Ap || !Ri || !Rp || !W)
-	{
-	    return (UMFPACK_ERROR_argument_missing) ;
-	}
-	if (n_row <= 0 || n_col <= 0)		/* n_row,n_col must be > 0 */
-	{
-	    return (UMFPACK_ERROR_n_nonpositive) ;
-	}
-	if (!UMF_is_permutation (P, W, n_row, n_row) ||
-	    !UMF_is_permutation (Q, W, nq, nq))
+	j = (Q != (Int *) NULL) ? Q [newj] : newj ;
+	for (p = Ap [j] ; p < Ap [j+1] ; p++)
 	{
-	    return (UMFPACK_ERROR_invalid_permutation) ;
-	}
-	if (AMD_valid (n_row, n_col, Ap, Ai) != AMD_OK)
-	{
-	    return (UMFPACK_ERROR_invalid_matrix) ;
+	    Wt [Ai [p]]++ ;
 	}
     }
+}
 
-#ifndef NDEBUG
-    DEBUG2 (("UMF_transpose, input matrix:\n")) ;
-    UMF_dump_col_matrix (Ax,
-#ifdef COMPLEX
-	Az,
-#endif
-	Ai, Ap, n_row, n_col, nz) ;
-#endif
-
-    /* ---------------------------------------------------------------------- */
-    /* count the entries in each row of A */
-    /* ---------------------------------------------------------------------- */
-
-    /* use W as workspace for RowCount */
-
-    for (i = 0 ; i < n_row ; i++)
-    {
-	W [i] = 0 ;
-	Rp [i] = 0 ;
-    }
-
-    if (Q != (Int *) NULL)
-    {
-	for (newj = 0 ; newj < nq ; newj++)
-	{
-	    j = Q [newj] ;
-	    ASSERT (j >= 0 && j < n_col) ;
-	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
-	    {
-		i = Ai [p] ;
-		ASSERT (i >= 0 && i < n_row) ;
-		W [i]++ ;
-	    }
-	}
-    }
-    else
-    {
-	for (j = 0 ; j < n_col ; j++)
-	{
-	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
-	    {
-		i = Ai [p] ;
-		ASSERT (i >= 0 && i < n_row) ;
-		W [i]++ ;
-	    }
-	}
-    }
-
-    /* ---------------------------------------------------------------------- */
-    /* compute the row pointers for R = A (P,Q) */
-    /* ---------------------------------------------------------------------- */
-
-    if (P != (Int *) NULL)
-    {
-	Rp [0] = 0 ;
-	for (k = 0 ; k < n_row ; k++)
-	{
-	    i = P [k] ;
-	    ASSERT (i >= 0 && i < n_row) ;
-	    Rp [k+1] = Rp [k] + W [i] ;
-	}
-	for (k = 0 ; k < n_row ; k++)
-	{
-	    i = P [k] ;
-	    ASSERT (i >= 0 && i < n_row) ;
-	    W [i] = Rp [k] ;
-	}
-    }
-    else
-    {
-	Rp [0] = 0 ;
-	for (i = 0 ; i < n_row ; i++)
-	{
-	    Rp [i+1] = Rp [i] + W [i] ;
-	}
-	for (i = 0 ; i < n_row ; i++)
-	{
-	    W [i] = Rp [i] ;
-	}
-    }
-    ASSERT (Rp [n_row] <= Ap [n_col]) ;
-
-    /* at this point, W holds the permuted row pointers */
-
-    /* ---------------------------------------------------------------------- */
-    /* construct the row form of B */
-    /* ---------------------------------------------------------------------- */
+/* ========================================================================== */
+/* === transpose_scatter ==================================================== */
+/* ========================================================================== */
 
-    do_values = Ax && Rx ;
+/* Scatter A (P,Q(j1:j2-1)) into R.  Wt [i] is the position in Ri where the
+ * next entry in row i goes. */
 
+PRIVATE void transpose_scatter
+(
+    Int j1,
+    Int j2,
+    Int n_col,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+    const Int Q [ ],
+    Int Ri [ ],
+    double Rx [ ],
+    Int Wt [ ],
+    Int do_values
 #ifdef COMPLEX
-    split = SPLIT (Az) && SPLIT (Rz) ;
+    , const double Az [ ]
+    , double Rz [ ]
+    , Int do_conjugate
+    , Int split
+#endif
+)
+{
+    Int j, newj, p, bp ;
 
+#ifdef COMPLEX
     if (do_conjugate && do_values)
     {
 	if (Q != (Int *) NULL)
@@ -198,13 +101,13 @@ GLOBAL Int UMF_transpose
 	    if (split)
 	    {
 		/* R = A (P,Q)' */
-		for (newj = 0 ; newj < nq ; newj++)
+		for (newj = j1 ; newj < j2 ; newj++)
 		{
 		    j = Q [newj] ;
 		    ASSERT (j >= 0 && j < n_col) ;
 		    for (p = Ap [j] ; p < Ap [j+1] ; p++)
 		    {
-			bp = W [Ai [p]]++ ;
+			bp = Wt [Ai [p]]++ ;
 			Ri [bp] = newj ;
 			Rx [bp] = Ax [p] ;
 			Rz [bp] = -Az [p] ;
@@ -214,13 +117,13 @@ GLOBAL Int UMF_transpose
 	    else
 	    {
 		/* R = A (P,Q)' (merged complex values) */
-		for (newj = 0 ; newj < nq ; newj++)
+		for (newj = j1 ; newj < j2 ; newj++)
 		{
 		    j = Q [newj] ;
 		    ASSERT (j >= 0 && j < n_col) ;
 		    for (p = Ap [j] ; p < Ap [j+1] ; p++)
 		    {
-			bp = W [Ai [p]]++ ;
+			bp = Wt [Ai [p]]++ ;
 			Ri [bp] = newj ;
 			Rx [2*bp] = Ax [2*p] ;
 			Rx [2*bp+1] = -Ax [2*p+1] ;
@@ -233,11 +136,11 @@ GLOBAL Int UMF_transpose
 	    if (split)
 	    {
 		/* R = A (P,:)' */
-		for (j = 0 ; j < n_col ; j++)
+		for (j = j1 ; j < j2 ; j++)
 		{
 		    for (p = Ap [j] ; p < Ap [j+1] ; p++)
 		    {
-			bp = W [Ai [p]]++ ;
+			bp = Wt [Ai [p]]++ ;
 			Ri [bp] = j ;
 			Rx [bp] = Ax [p] ;
 			Rz [bp] = -Az [p] ;
@@ -247,11 +150,11 @@ GLOBAL Int UMF_transpose
 	    else
 	    {
 		/* R = A (P,:)' (merged complex values) */
-		for (j = 0 ; j < n_col ; j++)
+		for (j = j1 ; j < j2 ; j++)
 		{
 		    for (p = Ap [j] ; p < Ap [j+1] ; p++)
 		    {
-			bp = W [Ai [p]]++ ;
+			bp = Wt [Ai [p]]++ ;
 			Ri [bp] = j ;
 			Rx [2*bp] = Ax [2*p] ;
 			Rx [2*bp+1] = -Ax [2*p+1] ;
@@ -272,13 +175,13 @@ GLOBAL Int UMF_transpose
 #endif
 		{
 		    /* R = A (P,Q).' */
-		    for (newj = 0 ; newj < nq ; newj++)
+		    for (newj = j1 ; newj < j2 ; newj++)
 		    {
 			j = Q [newj] ;
 			ASSERT (j >= 0 && j < n_col) ;
 			for (p = Ap [j] ; p < Ap [j+1] ; p++)
 			{
-			    bp = W [Ai [p]]++ ;
+			    bp = Wt [Ai [p]]++ ;
 			    Ri [bp] = newj ;
 			    Rx [bp] = Ax [p] ;
 #ifdef COMPLEX
@@ -291,13 +194,13 @@ GLOBAL Int UMF_transpose
 		else
 		{
 		    /* R = A (P,Q).' (merged complex values) */
-		    for (newj = 0 ; newj < nq ; newj++)
+		    for (newj = j1 ; newj < j2 ; newj++)
 		    {
 			j = Q [newj] ;
 			ASSERT (j >= 0 && j < n_col) ;
 			for (p = Ap [j] ; p < Ap [j+1] ; p++)
 			{
-			    bp = W [Ai [p]]++ ;
+			    bp = Wt [Ai [p]]++ ;
 			    Ri [bp] = newj ;
 			    Rx [2*bp] = Ax [2*p] ;
 			    Rx [2*bp+1] = Ax [2*p+1] ;
@@ -309,13 +212,13 @@ GLOBAL Int UMF_transpose
 	    else
 	    {
 		/* R = pattern of A (P,Q).' */
-		for (newj = 0 ; newj < nq ; newj++)
+		for (newj = j1 ; newj < j2 ; newj++)
 		{
 		    j = Q [newj] ;
 		    ASSERT (j >= 0 && j < n_col) ;
 		    for (p = Ap [j] ; p < Ap [j+1] ; p++)
 		    {
-			Ri [W [Ai [p]]++] = newj ;
+			Ri [Wt [Ai [p]]++] = newj ;
 		    }
 		}
 	    }
@@ -329,11 +232,11 @@ GLOBAL Int UMF_transpose
 #endif
 		{
 		    /* R = A (P,:).' */
-		    for (j = 0 ; j < n_col ; j++)
+		    for (j = j1 ; j < j2 ; j++)
 		    {
 			for (p = Ap [j] ; p < Ap [j+1] ; p++)
 			{
-			    bp = W [Ai [p]]++ ;
+			    bp = Wt [Ai [p]]++ ;
 			    Ri [bp] = j ;
 			    Rx [bp] = Ax [p] ;
 #ifdef COMPLEX
@@ -346,11 +249,11 @@ GLOBAL Int UMF_transpose
 		else
 		{
 		    /* R = A (P,:).' (merged complex values) */
-		    for (j = 0 ; j < n_col ; j++)
+		    for (j = j1 ; j < j2 ; j++)
 		    {
 			for (p = Ap [j] ; p < Ap [j+1] ; p++)
 			{
-			    bp = W [Ai [p]]++ ;
+			    bp = Wt [Ai [p]]++ ;
 			    Ri [bp] = j ;
 			    Rx [2*bp] = Ax [2*p] ;
 			    Rx [2*bp+1] = Ax [2*p+1] ;
@@ -362,16 +265,310 @@ GLOBAL Int UMF_transpose
 	    else
 	    {
 		/* R = pattern of A (P,:).' */
-		for (j = 0 ; j < n_col ; j++)
+		for (j = j1 ; j < j2 ; j++)
 		{
 		    for (p = Ap [j] ; p < Ap [j+1] ; p++)
 		    {
-			Ri [W [Ai [p]]++] = j ;
+			Ri [Wt [Ai [p]]++] = j ;
 		    }
 		}
 	    }
 	}
     }
+}
+
+/* ========================================================================== */
+/* === UMF_transpose ======================================================== */
+/* ========================================================================== */
+
+GLOBAL Int UMF_transpose
+(
+    Int n_row,			/* A is n_row-by-n_col */
+    Int n_col,
+    const Int Ap [ ],		/* size n_col+1 */
+    const Int Ai [ ],		/* size nz = Ap [n_col] */
+    const double Ax [ ],	/* size nz if present */
+
+    const Int P [ ],	/* P [k] = i means original row i is kth row in A(P,Q)*/
+			/* P is identity if not present */
+			/* size n_row, if present */
+
+    const Int Q [ ],	/* Q [k] = j means original col j is kth col in A(P,Q)*/
+			/* Q is identity if not present */
+			/* size nq, if present */
+    Int nq,		/* size of Q, ignored if Q is (Int *) NULL */
+
+			/* output matrix: Rp, Ri, Rx, and Rz: */
+    Int Rp [ ],		/* size n_row+1 */
+    Int Ri [ ],		/* size nz */
+    double Rx [ ],	/* size nz, if present */
+
+    Int W [ ],		/* size max (n_row,n_col) workspace */
+
+    Int check		/* if true, then check inputs */
+#ifdef COMPLEX
+    , const double Az [ ]	/* size nz */
+    , double Rz [ ]		/* size nz */
+    , Int do_conjugate		/* if true, then do conjugate transpose */
+				/* otherwise, do array transpose */
+#endif
+)
+{
+
+    /* ---------------------------------------------------------------------- */
+    /* local variables */
+    /* ---------------------------------------------------------------------- */
+
+    Int i, j, k, t, do_values, ncols, anz, nthreads, *Work, *Jstart ;
+#ifdef COMPLEX
+    Int split ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+#ifndef NDEBUG
+    Int nz ;
+    ASSERT (n_col >= 0) ;
+    nz = (Ap != (Int *) NULL) ? Ap [n_col] : 0 ;
+    DEBUG2 (("UMF_transpose: "ID"-by-"ID" nz "ID"\n", n_row, n_col, nz)) ;
+#endif
+
+    if (check)
+    {
+	/* UMFPACK_symbolic skips this check */
+	/* UMFPACK_transpose always does this check */
+	if (!Ai || !Ap || !Ri || !Rp || !W)
+	{
+	    return (UMFPACK_ERROR_argument_missing) ;
+	}
+	if (n_row <= 0 || n_col <= 0)		/* n_row,n_col must be > 0 */
+	{
+	    return (UMFPACK_ERROR_n_nonpositive) ;
+	}
+	if (!UMF_is_permutation (P, W, n_row, n_row) ||
+	    !UMF_is_permutation (Q, W, nq, nq))
+	{
+	    return (UMFPACK_ERROR_invalid_permutation) ;
+	}
+	if (AMD_valid (n_row, n_col, Ap, Ai) != AMD_OK)
+	{
+	    return (UMFPACK_ERROR_invalid_matrix) ;
+	}
+    }
+
+#ifndef NDEBUG
+    DEBUG2 (("UMF_transpose, input matrix:\n")) ;
+    UMF_dump_col_matrix (Ax,
+#ifdef COMPLEX
+	Az,
+#endif
+	Ai, Ap, n_row, n_col, nz) ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* determine the number of threads to use */
+    /* ---------------------------------------------------------------------- */
+
+    ncols = (Q != (Int *) NULL) ? nq : n_col ;
+    anz = Ap [n_col] ;
+    nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = MAX (1, MIN (omp_get_max_threads ( ),
+	anz / UMF_TRANSPOSE_CHUNK)) ;
+    /* the row counts of all threads take no more space than Ri */
+    nthreads = MAX (1, MIN (nthreads, anz / MAX (n_row, 1))) ;
+#endif
+
+    Work = (Int *) NULL ;
+    if (nthreads > 1)
+    {
+	Work = (Int *) UMF_malloc (nthreads * (n_row+1) + 1, sizeof (Int)) ;
+	if (!Work)
+	{
+	    /* not enough memory for the row counts of each thread */
+	    nthreads = 1 ;
+	}
+    }
+
+    Jstart = (Int *) NULL ;
+    if (nthreads > 1)
+    {
+	/* split the columns of A (P,Q) into nthreads contiguous ranges, of
+	 * about anz/nthreads entries each, or ncols/nthreads columns each if
+	 * Q is present.  Thread t handles columns Jstart [t] to
+	 * Jstart [t+1]-1. */
+	Jstart = Work + nthreads * n_row ;
+	if (Q != (Int *) NULL)
+	{
+	    for (t = 0 ; t <= nthreads ; t++)
+	    {
+		Jstart [t] = (Int) ((((double) t) * ncols) / nthreads) ;
+	    }
+	}
+	else
+	{
+	    t = 0 ;
+	    for (j = 0 ; j < ncols ; j++)
+	    {
+		while (t < nthreads &&
+		    (double) Ap [j] >= (((double) t) * anz) / nthreads)
+		{
+		    Jstart [t++] = j ;
+		}
+	    }
+	    while (t <= nthreads)
+	    {
+		Jstart [t++] = ncols ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* count the entries in each row of A */
+    /* ---------------------------------------------------------------------- */
+
+    /* use W as workspace for RowCount */
+
+    for (i = 0 ; i < n_row ; i++)
+    {
+	W [i] = 0 ;
+	Rp [i] = 0 ;
+    }
+
+    if (nthreads == 1)
+    {
+	transpose_count (0, ncols, Ap, Ai, Q, W) ;
+    }
+    else
+    {
+	/* each thread counts the entries in its range in Work [t*n_row...] */
+#ifdef _OPENMP
+	#pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+	for (t = 0 ; t < nthreads ; t++)
+	{
+	    Int *Wt = Work + t * n_row ;
+	    Int i2 ;
+	    for (i2 = 0 ; i2 < n_row ; i2++)
+	    {
+		Wt [i2] = 0 ;
+	    }
+	    transpose_count (Jstart [t], Jstart [t+1], Ap, Ai, Q, Wt) ;
+	}
+
+	/* W [i] = total count of row i, and Work [t*n_row+i] = the number of
+	 * entries in row i in the ranges of threads 0 to t-1 */
+#ifdef _OPENMP
+	#pragma omp parallel for num_threads(nthreads) schedule(static)
+#endif
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    Int t2, c, cnt = 0 ;
+	    for (t2 = 0 ; t2 < nthreads ; t2++)
+	    {
+		c = Work [t2 * n_row + i] ;
+		Work [t2 * n_row + i] = cnt ;
+		cnt += c ;
+	    }
+	    W [i] = cnt ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the row pointers for R = A (P,Q) */
+    /* ---------------------------------------------------------------------- */
+
+    if (P != (Int *) NULL)
+    {
+	Rp [0] = 0 ;
+	for (k = 0 ; k < n_row ; k++)
+	{
+	    i = P [k] ;
+	    ASSERT (i >= 0 && i < n_row) ;
+	    Rp [k+1] = Rp [k] + W [i] ;
+	}
+	for (k = 0 ; k < n_row ; k++)
+	{
+	    i = P [k] ;
+	    ASSERT (i >= 0 && i < n_row) ;
+	    W [i] = Rp [k] ;
+	}
+    }
+    else
+    {
+	Rp [0] = 0 ;
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    Rp [i+1] = Rp [i] + W [i] ;
+	}
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    W [i] = Rp [i] ;
+	}
+    }
+    ASSERT (Rp [n_row] <= Ap [n_col]) ;
+
+    /* at this point, W holds the permuted row pointers */
+
+    if (nthreads > 1)
+    {
+	/* Work [t*n_row+i] = where thread t places its first entry of row i */
+#ifdef _OPENMP
+	#pragma omp parallel for num_threads(nthreads) schedule(static)
+#endif
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    Int t2 ;
+	    for (t2 = 0 ; t2 < nthreads ; t2++)
+	    {
+		Work [t2 * n_row + i] += W [i] ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the row form of B */
+    /* ---------------------------------------------------------------------- */
+
+    do_values = Ax && Rx ;
+
+#ifdef COMPLEX
+    split = SPLIT (Az) && SPLIT (Rz) ;
+#endif
+
+    if (nthreads == 1)
+    {
+	transpose_scatter (0, ncols, n_col, Ap, Ai, Ax, Q, Ri, Rx, W, do_values
+#ifdef COMPLEX
+	    , Az, Rz, do_conjugate, split
+#endif
+	    ) ;
+    }
+    else
+    {
+#ifdef _OPENMP
+	#pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+	for (t = 0 ; t < nthreads ; t++)
+	{
+	    transpose_scatter (Jstart [t], Jstart [t+1], n_col, Ap, Ai, Ax, Q,
+		Ri, Rx, Work + t * n_row, do_values
+#ifdef COMPLEX
+		, Az, Rz, do_conjugate, split
+#endif
+		) ;
+	}
+#ifndef NDEBUG
+	/* the last thread advanced its positions to the end of each row */
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    W [i] = Work [(nthreads-1) * n_row + i] ;
+	}
+#endif
+	(void) UMF_free ((void *) Work) ;
+    }
 
 #ifndef NDEBUG
     for (k = 0 ; k < n_row ; k++)
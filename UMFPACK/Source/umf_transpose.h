@@ -3,6 +3,9 @@
 /* All Rights Reserved.  See ../Doc/License.txt for License.                  */
 /* -------------------------------------------------------------------------- */
 
+/* minimum number of entries of A per thread in UMF_transpose */
+#define UMF_TRANSPOSE_CHUNK 65536
+
 GLOBAL Int UMF_transpose
 (
     Int n_row,
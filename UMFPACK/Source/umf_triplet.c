@@ -15,10 +15,17 @@
 
     Compiled into four different routines for each version (di, dl, zi, zl),
     for a total of 16 different routines.
+
+    If nthreads > 1, the triplets are split into one contiguous range per
+    thread, as are the rows of the row form.  Each thread counts the entries
+    in its range in its own part of W, and then scatters them starting at the
+    position just past the entries of all prior threads.  The result is
+    identical to the result computed with a single thread.
 */
 
 #include "umf_internal.h"
 #include "umf_triplet.h"
+#include "umf_cumsum.h"
 
 #ifdef DO_MAP
 #ifdef DO_VALUES
@@ -43,8 +50,10 @@ GLOBAL Int UMF_triplet_nomap_nox
     Int Ai [ ],			/* size nz */
     Int Rp [ ],			/* size n_row + 1 */
     Int Rj [ ],			/* size nz */
-    Int W [ ],			/* size max (n_row, n_col) */
-    Int RowCount [ ]		/* size n_row */
+    Int W [ ],			/* size nthreads * max (n_row, n_col)
+				 * + 2 * (nthreads+1) */
+    Int RowCount [ ],		/* size n_row */
+    Int nthreads		/* number of threads to use */
 #ifdef DO_VALUES
     , const double Tx [ ]	/* size nz */
     , double Ax [ ]		/* size nz */
@@ -66,9 +75,17 @@ GLOBAL Int UMF_triplet_nomap_nox
     /* local variables */
     /* ---------------------------------------------------------------------- */
 
-    Int i, j, k, p, cp, p1, p2, pdest, pj ;
+    Int i, t, nn, invalid, *Kstart, *Istart ;
 #ifdef DO_MAP
-    Int duplicates ;
+    Int k, duplicates ;
+#endif
+#ifndef NDEBUG
+    Int j ;
+#ifdef DO_MAP
+    Int p ;
+#else
+    Int k ;
+#endif
 #endif
 #ifdef DO_VALUES
 #ifdef COMPLEX
@@ -77,85 +94,121 @@ GLOBAL Int UMF_triplet_nomap_nox
 #endif
 
     /* ---------------------------------------------------------------------- */
-    /* count the entries in each row (also counting duplicates) */
+    /* split the triplets into nthreads ranges */
     /* ---------------------------------------------------------------------- */
 
-    /* use W as workspace for row counts (including duplicates) */
-    for (i = 0 ; i < n_row ; i++)
+    /* thread t uses W [t*nn ... (t+1)*nn-1] as its workspace */
+    nn = MAX (n_row, n_col) ;
+
+    /* thread t handles triplets Kstart [t] to Kstart [t+1]-1 */
+    Kstart = W + nthreads * nn ;
+    for (t = 0 ; t <= nthreads ; t++)
     {
-	W [i] = 0 ;
+	Kstart [t] = (Int) ((((double) t) * nz) / nthreads) ;
     }
 
-    for (k = 0 ; k < nz ; k++)
+    /* ---------------------------------------------------------------------- */
+    /* count the entries in each row (also counting duplicates) */
+    /* ---------------------------------------------------------------------- */
+
+    /* use W as workspace for row counts (including duplicates) */
+    invalid = FALSE ;
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+	reduction(||:invalid)
+#endif
+    for (t = 0 ; t < nthreads ; t++)
     {
-	i = Ti [k] ;
-	j = Tj [k] ;
-	if (i < 0 || i >= n_row || j < 0 || j >= n_col)
+	Int *Wt = W + t*nn, i, j, k ;
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    Wt [i] = 0 ;
+	}
+	for (k = Kstart [t] ; k < Kstart [t+1] ; k++)
 	{
-	    return (UMFPACK_ERROR_invalid_matrix) ;
+	    i = Ti [k] ;
+	    j = Tj [k] ;
+	    if (i < 0 || i >= n_row || j < 0 || j >= n_col)
+	    {
+		invalid = TRUE ;
+		break ;
+	    }
+	    Wt [i]++ ;
 	}
-	W [i]++ ;
+    }
+
+    if (invalid)
+    {
+	return (UMFPACK_ERROR_invalid_matrix) ;
+    }
+
 #ifndef NDEBUG
-	DEBUG1 ((ID " triplet: "ID" "ID" ", k, i, j)) ;
+    for (k = 0 ; k < nz ; k++)
+    {
+	DEBUG1 ((ID " triplet: "ID" "ID" ", k, Ti [k], Tj [k])) ;
 #ifdef DO_VALUES
 	{
-	    Entry tt ;
+	    XEntry tt ;
 	    ASSIGN (tt, Tx, Tz, k, split) ;
 	    EDEBUG2 (tt) ;
 	    DEBUG1 (("\n")) ;
 	}
-#endif
 #endif
     }
+#endif
 
     /* ---------------------------------------------------------------------- */
     /* compute the row pointers */
     /* ---------------------------------------------------------------------- */
 
-    Rp [0] = 0 ;
-    for (i = 0 ; i < n_row ; i++)
-    {
-	Rp [i+1] = Rp [i] + W [i] ;
-	W [i] = Rp [i] ;
-    }
+    UMF_cumsum (n_row, Rp, W, nn, nthreads) ;
 
-    /* W is now equal to the row pointers */
+    /* W is now equal to the row pointers (offset for each thread) */
 
     /* ---------------------------------------------------------------------- */
     /* construct the row form */
     /* ---------------------------------------------------------------------- */
 
-    for (k = 0 ; k < nz ; k++)
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (t = 0 ; t < nthreads ; t++)
     {
-	p = W [Ti [k]]++ ;
+	Int *Wt = W + t*nn, k, p ;
+	for (k = Kstart [t] ; k < Kstart [t+1] ; k++)
+	{
+	    p = Wt [Ti [k]]++ ;
 #ifdef DO_MAP
-	Map [k] = p ;
+	    Map [k] = p ;
 #endif
-	Rj [p] = Tj [k] ;
+	    Rj [p] = Tj [k] ;
 #ifdef DO_VALUES
 #ifdef COMPLEX
-	if (split)
-	{
-	    Rx [p] = Tx [k] ;
-	    Rz [p] = Tz [k] ;
-	}
-	else
-	{
-	    Rx [2*p  ] = Tx [2*k  ] ;
-	    Rx [2*p+1] = Tx [2*k+1] ;
-	}
+	    if (split)
+	    {
+		Rx [p] = Tx [k] ;
+		Rz [p] = Tz [k] ;
+	    }
+	    else
+	    {
+		Rx [2*p  ] = Tx [2*k  ] ;
+		Rx [2*p+1] = Tx [2*k+1] ;
+	    }
 #else
-	Rx [p] = Tx [k] ;
+	    Rx [p] = Tx [k] ;
 #endif
 #endif
+	}
     }
 
-    /* Rp stays the same, but W [i] is advanced to the start of row i+1 */
+    /* Rp stays the same, but W [i] of the last thread is advanced to the
+     * start of row i+1 */
 
 #ifndef NDEBUG
     for (i = 0 ; i < n_row ; i++)
     {
-	ASSERT (W [i] == Rp [i+1]) ;
+	ASSERT (W [(nthreads-1)*nn + i] == Rp [i+1]) ;
     }
 #ifdef DO_MAP
     for (k = 0 ; k < nz ; k++)
@@ -172,101 +225,136 @@ GLOBAL Int UMF_triplet_nomap_nox
 #endif
 
     /* ---------------------------------------------------------------------- */
-    /* sum up duplicates */
+    /* split the rows into nthreads ranges */
     /* ---------------------------------------------------------------------- */
 
-    /* use W [j] to hold position in Ri/Rx/Rz of a_ij, for row i [ */
-
-    for (j = 0 ; j < n_col ; j++)
+    /* thread t handles rows Istart [t] to Istart [t+1]-1, which hold about
+     * nz/nthreads triplets */
+    Istart = Kstart + nthreads + 1 ;
+    t = 0 ;
+    for (i = 0 ; i < n_row ; i++)
+    {
+	while (t < nthreads && (double) Rp [i] >= (((double) t) * nz) / nthreads)
+	{
+	    Istart [t++] = i ;
+	}
+    }
+    while (t <= nthreads)
     {
-	W [j] = EMPTY ;
+	Istart [t++] = n_row ;
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* sum up duplicates */
+    /* ---------------------------------------------------------------------- */
+
+    /* use W [j] to hold position in Ri/Rx/Rz of a_ij, for row i [ */
+
 #ifdef DO_MAP
     duplicates = FALSE ;
 #endif
 
-    for (i = 0 ; i < n_row ; i++)
+#ifdef _OPENMP
+#ifdef DO_MAP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+	reduction(||:duplicates)
+#else
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+#endif
+    for (t = 0 ; t < nthreads ; t++)
     {
-	p1 = Rp [i] ;
-	p2 = Rp [i+1] ;
-	pdest = p1 ;
-	/* At this point, W [j] < p1 holds true for all columns j, */
-	/* because Ri/Rx/Rz is stored in row oriented order. */
-#ifndef NDEBUG
-	if (UMF_debug >= -2)
+	Int *Wt = W + t*nn, i, j, p, p1, p2, pj, pdest ;
+
+	for (j = 0 ; j < n_col ; j++)
 	{
-	    for (j = 0 ; j < n_col ; j++)
-	    {
-		ASSERT (W [j] < p1) ;
-	    }
+	    Wt [j] = EMPTY ;
 	}
-#endif
-	for (p = p1 ; p < p2 ; p++)
+
+	for (i = Istart [t] ; i < Istart [t+1] ; i++)
 	{
-	    j = Rj [p] ;
-	    ASSERT (j >= 0 && j < n_col) ;
-	    pj = W [j] ;
-	    if (pj >= p1)
+	    p1 = Rp [i] ;
+	    p2 = Rp [i+1] ;
+	    pdest = p1 ;
+	    /* At this point, Wt [j] < p1 holds true for all columns j, */
+	    /* because Ri/Rx/Rz is stored in row oriented order. */
+#ifndef NDEBUG
+	    if (UMF_debug >= -2)
 	    {
-		/* this column index, j, is already in row i, at position pj */
-		ASSERT (pj < p) ;
-		ASSERT (Rj [pj] == j) ;
-#ifdef DO_MAP
-		Map2 [p] = pj ;
-		duplicates = TRUE ;
-#endif
-#ifdef DO_VALUES
-		/* sum the entry */
-#ifdef COMPLEX
-		if (split)
+		for (j = 0 ; j < n_col ; j++)
 		{
-		    Rx [pj] += Rx [p] ;
-		    Rz [pj] += Rz [p] ;
+		    ASSERT (Wt [j] < p1) ;
 		}
-		else
-		{
-		    Rx[2*pj  ] += Rx[2*p  ] ;
-		    Rx[2*pj+1] += Rx[2*p+1] ;
-		}
-#else
-		Rx [pj] += Rx [p] ;
-#endif
-#endif
 	    }
-	    else
+#endif
+	    for (p = p1 ; p < p2 ; p++)
 	    {
-		/* keep the entry */
-		/* also keep track in W[j] of position of a_ij for case above */
-		W [j] = pdest ;
+		j = Rj [p] ;
+		ASSERT (j >= 0 && j < n_col) ;
+		pj = Wt [j] ;
+		if (pj >= p1)
+		{
+		    /* this column index, j, is already in row i, at position
+		     * pj */
+		    ASSERT (pj < p) ;
+		    ASSERT (Rj [pj] == j) ;
 #ifdef DO_MAP
-		Map2 [p] = pdest ;
+		    Map2 [p] = pj ;
+		    duplicates = TRUE ;
 #endif
-		/* no need to move the entry if pdest is equal to p */
-		if (pdest != p)
-		{
-		    Rj [pdest] = j ;
 #ifdef DO_VALUES
+		    /* sum the entry */
 #ifdef COMPLEX
 		    if (split)
 		    {
-			Rx [pdest] = Rx [p] ;
-			Rz [pdest] = Rz [p] ;
+			Rx [pj] += Rx [p] ;
+			Rz [pj] += Rz [p] ;
 		    }
 		    else
 		    {
-			Rx [2*pdest  ] = Rx [2*p  ] ;
-			Rx [2*pdest+1] = Rx [2*p+1] ;
+			Rx[2*pj  ] += Rx[2*p  ] ;
+			Rx[2*pj+1] += Rx[2*p+1] ;
 		    }
 #else
-		    Rx [pdest] = Rx [p] ;
+		    Rx [pj] += Rx [p] ;
+#endif
+#endif
+		}
+		else
+		{
+		    /* keep the entry */
+		    /* also keep track in Wt [j] of position of a_ij for case
+		     * above */
+		    Wt [j] = pdest ;
+#ifdef DO_MAP
+		    Map2 [p] = pdest ;
+#endif
+		    /* no need to move the entry if pdest is equal to p */
+		    if (pdest != p)
+		    {
+			Rj [pdest] = j ;
+#ifdef DO_VALUES
+#ifdef COMPLEX
+			if (split)
+			{
+			    Rx [pdest] = Rx [p] ;
+			    Rz [pdest] = Rz [p] ;
+			}
+			else
+			{
+			    Rx [2*pdest  ] = Rx [2*p  ] ;
+			    Rx [2*pdest+1] = Rx [2*p+1] ;
+			}
+#else
+			Rx [pdest] = Rx [p] ;
 #endif
 #endif
+		    }
+		    pdest++ ;
 		}
-		pdest++ ;
 	    }
+	    RowCount [i] = pdest - p1 ;
 	}
-	RowCount [i] = pdest - p1 ;
     }
 
     /* done using W for position of a_ij ] */
@@ -278,6 +366,9 @@ GLOBAL Int UMF_triplet_nomap_nox
 #ifdef DO_MAP
     if (duplicates)
     {
+#ifdef _OPENMP
+	#pragma omp parallel for num_threads(nthreads) schedule(static)
+#endif
 	for (k = 0 ; k < nz ; k++)
 	{
 	    Map [k] = Map2 [Map [k]] ;
@@ -312,18 +403,25 @@ GLOBAL Int UMF_triplet_nomap_nox
     /* ---------------------------------------------------------------------- */
 
     /* [ use W as work space for column counts of A */
-    for (j = 0 ; j < n_col ; j++)
-    {
-	W [j] = 0 ;
-    }
 
-    for (i = 0 ; i < n_row ; i++)
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (t = 0 ; t < nthreads ; t++)
     {
-	for (p = Rp [i] ; p < Rp [i] + RowCount [i] ; p++)
+	Int *Wt = W + t*nn, i, j, p ;
+	for (j = 0 ; j < n_col ; j++)
 	{
-	    j = Rj [p] ;
-	    ASSERT (j >= 0 && j < n_col) ;
-	    W [j]++ ;
+	    Wt [j] = 0 ;
+	}
+	for (i = Istart [t] ; i < Istart [t+1] ; i++)
+	{
+	    for (p = Rp [i] ; p < Rp [i] + RowCount [i] ; p++)
+	    {
+		j = Rj [p] ;
+		ASSERT (j >= 0 && j < n_col) ;
+		Wt [j]++ ;
+	    }
 	}
     }
 
@@ -331,47 +429,46 @@ GLOBAL Int UMF_triplet_nomap_nox
     /* create the column pointers */
     /* ---------------------------------------------------------------------- */
 
-    Ap [0] = 0 ;
-    for (j = 0 ; j < n_col ; j++)
-    {
-	Ap [j+1] = Ap [j] + W [j] ;
-    }
-    /* done using W as workspace for column counts of A ] */
+    UMF_cumsum (n_col, Ap, W, nn, nthreads) ;
 
-    for (j = 0 ; j < n_col ; j++)
-    {
-	W [j] = Ap [j] ;
-    }
+    /* done using W as workspace for column counts of A ] */
 
     /* ---------------------------------------------------------------------- */
     /* construct the column form */
     /* ---------------------------------------------------------------------- */
 
-    for (i = 0 ; i < n_row ; i++)
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (t = 0 ; t < nthreads ; t++)
     {
-	for (p = Rp [i] ; p < Rp [i] + RowCount [i] ; p++)
+	Int *Wt = W + t*nn, i, p, cp ;
+	for (i = Istart [t] ; i < Istart [t+1] ; i++)
 	{
-	    cp = W [Rj [p]]++ ;
+	    for (p = Rp [i] ; p < Rp [i] + RowCount [i] ; p++)
+	    {
+		cp = Wt [Rj [p]]++ ;
 #ifdef DO_MAP
-	    Map2 [p] = cp ;
+		Map2 [p] = cp ;
 #endif
-	    Ai [cp] = i ;
+		Ai [cp] = i ;
 #ifdef DO_VALUES
 #ifdef COMPLEX
-	    if (split)
-	    {
-		Ax [cp] = Rx [p] ;
-		Az [cp] = Rz [p] ;
-	    }
-	    else
-	    {
-		Ax [2*cp  ] = Rx [2*p  ] ;
-		Ax [2*cp+1] = Rx [2*p+1] ;
-	    }
+		if (split)
+		{
+		    Ax [cp] = Rx [p] ;
+		    Az [cp] = Rz [p] ;
+		}
+		else
+		{
+		    Ax [2*cp  ] = Rx [2*p  ] ;
+		    Ax [2*cp+1] = Rx [2*p+1] ;
+		}
 #else
-	    Ax [cp] = Rx [p] ;
+		Ax [cp] = Rx [p] ;
 #endif
 #endif
+	    }
 	}
     }
 
@@ -380,6 +477,9 @@ GLOBAL Int UMF_triplet_nomap_nox
     /* ---------------------------------------------------------------------- */
 
 #ifdef DO_MAP
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(static)
+#endif
     for (k = 0 ; k < nz ; k++)
     {
 	Map [k] = Map2 [Map [k]] ;
@@ -391,7 +491,7 @@ GLOBAL Int UMF_triplet_nomap_nox
 #ifndef NDEBUG
     for (j = 0 ; j < n_col ; j++)
     {
-	ASSERT (W [j] == Ap [j+1]) ;
+	ASSERT (W [(nthreads-1)*nn + j] == Ap [j+1]) ;
     }
 
     UMF_dump_col_matrix (
@@ -3,6 +3,9 @@
 /* All Rights Reserved.  See ../Doc/License.txt for License.                  */
 /* -------------------------------------------------------------------------- */
 
+/* minimum number of triplets per thread in UMF_triplet_* */
+#define UMF_TRIPLET_CHUNK 65536
+
 GLOBAL Int UMF_triplet_map_x
 (
     Int n_row,
@@ -15,7 +18,8 @@ GLOBAL Int UMF_triplet_map_x
     Int Rp [ ],
     Int Rj [ ],
     Int W [ ],
-    Int RowCount [ ]
+    Int RowCount [ ],
+    Int nthreads
     , const double Tx [ ]
     , double Ax [ ]
     , double Rx [ ]
@@ -40,7 +44,8 @@ GLOBAL Int UMF_triplet_map_nox
     Int Rp [ ],
     Int Rj [ ],
     Int W [ ],
-    Int RowCount [ ]
+    Int RowCount [ ],
+    Int nthreads
     , Int Map [ ]
     , Int Map2 [ ]
 ) ;
@@ -57,7 +62,8 @@ GLOBAL Int UMF_triplet_nomap_x
     Int Rp [ ],
     Int Rj [ ],
     Int W [ ],
-    Int RowCount [ ]
+    Int RowCount [ ],
+    Int nthreads
     , const double Tx [ ]
     , double Ax [ ]
     , double Rx [ ]
@@ -80,5 +86,6 @@ GLOBAL Int UMF_triplet_nomap_nox
     Int Rp [ ],
     Int Rj [ ],
     Int W [ ],
-    Int RowCount [ ]
+    Int RowCount [ ],
+    Int nthreads
 ) ;
@@ -17,7 +17,7 @@
 GLOBAL double UMF_usolve
 (
     NumericType *Numeric,
-    Entry X [ ],		/* b on input, solution x on output */
+    XEntry X [ ],		/* b on input, solution x on output */
     Int Pattern [ ]		/* a work array of size n */
 )
 {
@@ -25,7 +25,7 @@ GLOBAL double UMF_usolve
     /* local variables */
     /* ---------------------------------------------------------------------- */
 
-    Entry xk ;
+    XEntry xk ;
     Entry *xp, *D, *Uval ;
     Int k, deg, j, *ip, col, *Upos, *Uilen, pos,
 	*Uip, n, ulen, up, newUchain, npiv, n1, *Ui ;
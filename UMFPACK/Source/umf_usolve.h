@@ -6,6 +6,6 @@
 GLOBAL double UMF_usolve
 (
     NumericType *Numeric,
-    Entry X [ ],
+    XEntry X [ ],
     Int Pattern [ ]
 ) ;
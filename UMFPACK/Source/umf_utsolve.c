@@ -22,7 +22,7 @@ UMF_utsolve			/* solve U.'x=b (array transpose) */
 #endif
 (
     NumericType *Numeric,
-    Entry X [ ],		/* b on input, solution x on output */
+    XEntry X [ ],		/* b on input, solution x on output */
     Int Pattern [ ]		/* a work array of size n */
 )
 {
@@ -30,7 +30,7 @@ UMF_utsolve			/* solve U.'x=b (array transpose) */
     /* local variables */
     /* ---------------------------------------------------------------------- */
 
-    Entry xk ;
+    XEntry xk ;
     Entry *xp, *D, *Uval ;
     Int k, deg, j, *ip, col, *Upos, *Uilen, kstart, kend, up,
 	*Uip, n, uhead, ulen, pos, npiv, n1, *Ui ;
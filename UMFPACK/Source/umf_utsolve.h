@@ -6,7 +6,7 @@
 GLOBAL double UMF_utsolve
 (
     NumericType *Numeric,
-    Entry X [ ],
+    XEntry X [ ],
     Int Pattern [ ]
 ) ;
 
@@ -14,6 +14,6 @@ GLOBAL double UMF_utsolve
 GLOBAL double UMF_uhsolve
 (
     NumericType *Numeric,
-    Entry X [ ],
+    XEntry X [ ],
     Int Pattern [ ]
 ) ;
@@ -14,23 +14,40 @@
    DLONG:	double precision, SuiteSparse_long's as integers
    ZLONG:	complex double precision, SuiteSparse_long's as integers
    ZINT:	complex double precision, int's as integers
+   SINT:	single precision LU factors, int's as integers
+   SLONG:	single precision LU factors, SuiteSparse_long's as integers
+   CINT:	complex single precision LU factors, int's as integers
+   CLONG:	complex single precision LU factors, SuiteSparse_long's as
+		integers
+
+   The single precision versions (SINT, SLONG, CINT, and CLONG) have the same
+   double precision user interface as the DINT, DLONG, ZINT, and ZLONG
+   versions, respectively.  Only the LU factors (and the frontal matrices
+   used to compute them) are held in single precision.  The forward/backsolves
+   and iterative refinement are done in double precision.
 */
 
 /* Set DINT as the default, if nothing is defined */
-#if !defined (DLONG) && !defined (DINT) && !defined (ZLONG) && !defined (ZINT)
+#if !defined (DLONG) && !defined (DINT) && !defined (ZLONG) && !defined (ZINT) \
+ && !defined (SLONG) && !defined (SINT) && !defined (CLONG) && !defined (CINT)
 #define DINT
 #endif
 
 /* Determine if this is a real or complex version */
-#if defined (ZLONG) || defined (ZINT)
+#if defined (ZLONG) || defined (ZINT) || defined (CLONG) || defined (CINT)
 #define COMPLEX
 #endif
 
+/* Determine if the LU factors are held in single precision */
+#if defined (SLONG) || defined (SINT) || defined (CLONG) || defined (CINT)
+#define SINGLE
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* integer type (Int is int or SuiteSparse_long) defined in amd_internal.h */
 /* -------------------------------------------------------------------------- */
 
-#if defined (DLONG) || defined (ZLONG)
+#if defined (DLONG) || defined (ZLONG) || defined (SLONG) || defined (CLONG)
 #define LONG_INTEGER
 #endif
 
@@ -106,9 +123,23 @@ SCALAR_IS_LTZERO(x):
 /* Real floating-point arithmetic */
 /* -------------------------------------------------------------------------- */
 
+/*
+    Entry is the type of the LU factors and the frontal matrices.  XEntry is
+    the type of the vectors x and b in the forward/backsolves and iterative
+    refinement, and of the matrix A and the vectors x and b passed by the
+    user.  They differ only in the single precision versions, where Entry is
+    float (or FloatComplex) and XEntry is double (or DoubleComplex).  All of
+    the macros below can be applied to either type, or to a mix of the two.
+*/
+
 #ifndef COMPLEX
 
+#ifdef SINGLE
+#define Entry float
+#else
 #define Entry double
+#endif
+#define XEntry double
 
 #define SPLIT(s)    		    (1)
 #define REAL_COMPONENT(c)	    (c)
@@ -179,7 +210,23 @@ typedef struct
 
 } DoubleComplex ;
 
+#ifdef SINGLE
+
+typedef struct
+{
+    float component [2] ;	/* real and imaginary parts */
+
+} FloatComplex ;
+
+#define Entry FloatComplex
+
+#else
+
 #define Entry DoubleComplex
+
+#endif
+
+#define XEntry DoubleComplex
 #define Real component [0]
 #define Imag component [1]
 
@@ -220,7 +267,8 @@ typedef struct
     }  \
     else \
     { \
- 	(c) = ((Entry *)(s1))[p] ; \
+ 	(c).Real = ((XEntry *)(s1))[p].Real ; \
+ 	(c).Imag = ((XEntry *)(s1))[p].Imag ; \
     }  \
 }
 
@@ -349,12 +397,15 @@ typedef struct
 
 /* -------------------------------------------------------------------------- */
 
-/* c = a/b, using function pointer */
+/* c = a/b, using function pointer.  divcomplex_func returns its result in
+ * double precision, so a float c is assigned via double temporaries. */
 #define DIV(c,a,b) \
 { \
+    double c_real, c_imag ; \
     (void) SuiteSparse_config.divcomplex_func \
-        ((a).Real, (a).Imag, (b).Real, (b).Imag, \
-	&((c).Real), &((c).Imag)) ; \
+        ((a).Real, (a).Imag, (b).Real, (b).Imag, &c_real, &c_imag) ; \
+    (c).Real = c_real ; \
+    (c).Imag = c_imag ; \
 }
 
 /* -------------------------------------------------------------------------- */
@@ -362,9 +413,11 @@ typedef struct
 /* c = a/conjugate(b), using function pointer */
 #define DIV_CONJ(c,a,b) \
 { \
+    double c_real, c_imag ; \
     (void) SuiteSparse_config.divcomplex_func \
-        ((a).Real, (a).Imag, (b).Real, (-(b).Imag), \
-	&((c).Real), &((c).Imag)) ; \
+        ((a).Real, (a).Imag, (b).Real, (-(b).Imag), &c_real, &c_imag) ; \
+    (c).Real = c_real ; \
+    (c).Imag = c_imag ; \
 }
 
 /* -------------------------------------------------------------------------- */
@@ -430,6 +483,7 @@ typedef struct
 #define UMF_colamd		 umf_i_colamd
 #define UMF_colamd_set_defaults	 umf_i_colamd_set_defaults
 #define UMF_create_element	 umfdi_create_element
+#define UMF_cumsum		 umf_i_cumsum
 #define UMF_extend_front	 umfdi_extend_front
 #define UMF_free		 umf_i_free
 #define UMF_fsize		 umf_i_fsize
@@ -461,6 +515,8 @@ typedef struct
 #define UMF_set_stats		 umf_i_set_stats
 #define UMF_singletons		 umf_i_singletons
 #define UMF_solve		 umfdi_solve
+#define UMF_msolve		 umfdi_msolve
+#define UMF_refactor		 umfdi_refactor
 #define UMF_start_front		 umfdi_start_front
 #define UMF_store_lu		 umfdi_store_lu
 #define UMF_store_lu_drop	 umfdi_store_lu_drop
@@ -487,6 +543,7 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_di_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_di_get_determinant
 #define UMFPACK_numeric		 umfpack_di_numeric
+#define UMFPACK_renumeric	 umfpack_di_renumeric
 #define UMFPACK_qsymbolic	 umfpack_di_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_di_fsymbolic
 #define UMFPACK_report_control	 umfpack_di_report_control
@@ -501,6 +558,8 @@ typedef struct
 #define UMFPACK_save_numeric	 umfpack_di_save_numeric
 #define UMFPACK_save_symbolic	 umfpack_di_save_symbolic
 #define UMFPACK_load_numeric	 umfpack_di_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_di_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_di_load_numeric_mmap
 #define UMFPACK_load_symbolic	 umfpack_di_load_symbolic
 #define UMFPACK_scale		 umfpack_di_scale
 #define UMFPACK_solve		 umfpack_di_solve
@@ -508,6 +567,11 @@ typedef struct
 #define UMFPACK_transpose	 umfpack_di_transpose
 #define UMFPACK_triplet_to_col	 umfpack_di_triplet_to_col
 #define UMFPACK_wsolve		 umfpack_di_wsolve
+#define UMFPACK_msolve		 umfpack_di_msolve
+#define UMFPACK_queue		 umfpack_di_queue
+#define UMFPACK_qsolve		 umfpack_di_qsolve
+#define UMFPACK_free_queue	 umfpack_di_free_queue
+#define UMFPACK_refactor	 umfpack_di_refactor
 
 /* for debugging only: */
 #define UMF_malloc_count	 umf_i_malloc_count
@@ -546,6 +610,7 @@ typedef struct
 #define UMF_colamd		 umf_l_colamd
 #define UMF_colamd_set_defaults	 umf_l_colamd_set_defaults
 #define UMF_create_element	 umfdl_create_element
+#define UMF_cumsum		 umf_l_cumsum
 #define UMF_extend_front	 umfdl_extend_front
 #define UMF_free		 umf_l_free
 #define UMF_fsize		 umf_l_fsize
@@ -577,6 +642,8 @@ typedef struct
 #define UMF_set_stats		 umf_l_set_stats
 #define UMF_singletons		 umf_l_singletons
 #define UMF_solve		 umfdl_solve
+#define UMF_msolve		 umfdl_msolve
+#define UMF_refactor		 umfdl_refactor
 #define UMF_start_front		 umfdl_start_front
 #define UMF_store_lu		 umfdl_store_lu
 #define UMF_store_lu_drop	 umfdl_store_lu_drop
@@ -603,6 +670,7 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_dl_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_dl_get_determinant
 #define UMFPACK_numeric		 umfpack_dl_numeric
+#define UMFPACK_renumeric	 umfpack_dl_renumeric
 #define UMFPACK_qsymbolic	 umfpack_dl_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_dl_fsymbolic
 #define UMFPACK_report_control	 umfpack_dl_report_control
@@ -617,6 +685,8 @@ typedef struct
 #define UMFPACK_save_numeric	 umfpack_dl_save_numeric
 #define UMFPACK_save_symbolic	 umfpack_dl_save_symbolic
 #define UMFPACK_load_numeric	 umfpack_dl_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_dl_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_dl_load_numeric_mmap
 #define UMFPACK_load_symbolic	 umfpack_dl_load_symbolic
 #define UMFPACK_scale		 umfpack_dl_scale
 #define UMFPACK_solve		 umfpack_dl_solve
@@ -624,6 +694,11 @@ typedef struct
 #define UMFPACK_transpose	 umfpack_dl_transpose
 #define UMFPACK_triplet_to_col	 umfpack_dl_triplet_to_col
 #define UMFPACK_wsolve		 umfpack_dl_wsolve
+#define UMFPACK_msolve		 umfpack_dl_msolve
+#define UMFPACK_queue		 umfpack_dl_queue
+#define UMFPACK_qsolve		 umfpack_dl_qsolve
+#define UMFPACK_free_queue	 umfpack_dl_free_queue
+#define UMFPACK_refactor	 umfpack_dl_refactor
 
 /* for debugging only: */
 #define UMF_malloc_count	 umf_l_malloc_count
@@ -662,6 +737,7 @@ typedef struct
 #define UMF_colamd		 umf_i_colamd
 #define UMF_colamd_set_defaults	 umf_i_colamd_set_defaults
 #define UMF_create_element	 umfzi_create_element
+#define UMF_cumsum		 umf_i_cumsum
 #define UMF_extend_front	 umfzi_extend_front
 #define UMF_free		 umf_i_free
 #define UMF_fsize		 umf_i_fsize
@@ -693,6 +769,8 @@ typedef struct
 #define UMF_set_stats		 umfzi_set_stats
 #define UMF_singletons		 umf_i_singletons
 #define UMF_solve		 umfzi_solve
+#define UMF_msolve		 umfzi_msolve
+#define UMF_refactor		 umfzi_refactor
 #define UMF_start_front		 umfzi_start_front
 #define UMF_store_lu		 umfzi_store_lu
 #define UMF_store_lu_drop	 umfzi_store_lu_drop
@@ -719,6 +797,7 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_zi_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_zi_get_determinant
 #define UMFPACK_numeric		 umfpack_zi_numeric
+#define UMFPACK_renumeric	 umfpack_zi_renumeric
 #define UMFPACK_qsymbolic	 umfpack_zi_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_zi_fsymbolic
 #define UMFPACK_report_control	 umfpack_zi_report_control
@@ -733,6 +812,8 @@ typedef struct
 #define UMFPACK_save_numeric	 umfpack_zi_save_numeric
 #define UMFPACK_save_symbolic	 umfpack_zi_save_symbolic
 #define UMFPACK_load_numeric	 umfpack_zi_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_zi_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_zi_load_numeric_mmap
 #define UMFPACK_load_symbolic	 umfpack_zi_load_symbolic
 #define UMFPACK_scale		 umfpack_zi_scale
 #define UMFPACK_solve		 umfpack_zi_solve
@@ -740,6 +821,11 @@ typedef struct
 #define UMFPACK_transpose	 umfpack_zi_transpose
 #define UMFPACK_triplet_to_col	 umfpack_zi_triplet_to_col
 #define UMFPACK_wsolve		 umfpack_zi_wsolve
+#define UMFPACK_msolve		 umfpack_zi_msolve
+#define UMFPACK_queue		 umfpack_zi_queue
+#define UMFPACK_qsolve		 umfpack_zi_qsolve
+#define UMFPACK_free_queue	 umfpack_zi_free_queue
+#define UMFPACK_refactor	 umfpack_zi_refactor
 
 /* for debugging only: */
 #define UMF_malloc_count	 umf_i_malloc_count
@@ -778,6 +864,7 @@ typedef struct
 #define UMF_colamd		 umf_l_colamd
 #define UMF_colamd_set_defaults	 umf_l_colamd_set_defaults
 #define UMF_create_element	 umfzl_create_element
+#define UMF_cumsum		 umf_l_cumsum
 #define UMF_extend_front	 umfzl_extend_front
 #define UMF_free		 umf_l_free
 #define UMF_fsize		 umf_l_fsize
@@ -809,6 +896,8 @@ typedef struct
 #define UMF_set_stats		 umfzl_set_stats
 #define UMF_singletons		 umf_l_singletons
 #define UMF_solve		 umfzl_solve
+#define UMF_msolve		 umfzl_msolve
+#define UMF_refactor		 umfzl_refactor
 #define UMF_start_front		 umfzl_start_front
 #define UMF_store_lu		 umfzl_store_lu
 #define UMF_store_lu_drop	 umfzl_store_lu_drop
@@ -835,6 +924,7 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_zl_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_zl_get_determinant
 #define UMFPACK_numeric		 umfpack_zl_numeric
+#define UMFPACK_renumeric	 umfpack_zl_renumeric
 #define UMFPACK_qsymbolic	 umfpack_zl_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_zl_fsymbolic
 #define UMFPACK_report_control	 umfpack_zl_report_control
@@ -849,6 +939,8 @@ typedef struct
 #define UMFPACK_save_numeric	 umfpack_zl_save_numeric
 #define UMFPACK_save_symbolic	 umfpack_zl_save_symbolic
 #define UMFPACK_load_numeric	 umfpack_zl_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_zl_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_zl_load_numeric_mmap
 #define UMFPACK_load_symbolic	 umfpack_zl_load_symbolic
 #define UMFPACK_scale		 umfpack_zl_scale
 #define UMFPACK_solve		 umfpack_zl_solve
@@ -856,6 +948,11 @@ typedef struct
 #define UMFPACK_transpose	 umfpack_zl_transpose
 #define UMFPACK_triplet_to_col	 umfpack_zl_triplet_to_col
 #define UMFPACK_wsolve		 umfpack_zl_wsolve
+#define UMFPACK_msolve		 umfpack_zl_msolve
+#define UMFPACK_queue		 umfpack_zl_queue
+#define UMFPACK_qsolve		 umfpack_zl_qsolve
+#define UMFPACK_free_queue	 umfpack_zl_free_queue
+#define UMFPACK_refactor	 umfpack_zl_refactor
 
 /* for debugging only: */
 #define UMF_malloc_count	 umf_l_malloc_count
@@ -877,3 +974,511 @@ typedef struct
 #define UMF_dump_diagonal_map	 umfzl_dump_diagonal_map
 
 #endif
+
+/* -------------------------------------------------------------------------- */
+/* Single precision LU factors, with int's as integers */
+/* -------------------------------------------------------------------------- */
+
+#ifdef SINT
+
+#define UMF_analyze		 umf_i_analyze
+#define UMF_apply_order		 umf_i_apply_order
+#define UMF_assemble		 umfsi_assemble
+#define UMF_assemble_fixq	 umfsi_assemble_fixq
+#define UMF_blas3_update	 umfsi_blas3_update
+#define UMF_build_tuples	 umfsi_build_tuples
+#define UMF_build_tuples_usage	 umfsi_build_tuples_usage
+#define UMF_colamd		 umf_i_colamd
+#define UMF_colamd_set_defaults	 umf_i_colamd_set_defaults
+#define UMF_create_element	 umfsi_create_element
+#define UMF_cumsum		 umf_i_cumsum
+#define UMF_extend_front	 umfsi_extend_front
+#define UMF_free		 umf_i_free
+#define UMF_fsize		 umf_i_fsize
+#define UMF_garbage_collection	 umfsi_garbage_collection
+#define UMF_get_memory		 umfsi_get_memory
+#define UMF_grow_front		 umfsi_grow_front
+#define UMF_init_front		 umfsi_init_front
+#define UMF_is_permutation	 umf_i_is_permutation
+#define UMF_kernel		 umfsi_kernel
+#define UMF_kernel_init		 umfsi_kernel_init
+#define UMF_kernel_init_usage	 umfsi_kernel_init_usage
+#define UMF_kernel_wrapup	 umfsi_kernel_wrapup
+#define UMF_local_search	 umfsi_local_search
+#define UMF_lsolve		 umfsi_lsolve
+#define UMF_ltsolve		 umfsi_ltsolve
+#define UMF_lhsolve		 umfsi_lhsolve
+#define UMF_malloc		 umf_i_malloc
+#define UMF_mem_alloc_element	 umfsi_mem_alloc_element
+#define UMF_mem_alloc_head_block umfsi_mem_alloc_head_block
+#define UMF_mem_alloc_tail_block umfsi_mem_alloc_tail_block
+#define UMF_mem_free_tail_block	 umfsi_mem_free_tail_block
+#define UMF_mem_init_memoryspace umfsi_mem_init_memoryspace
+#define UMF_realloc		 umf_i_realloc
+#define UMF_report_perm		 umf_i_report_perm
+#define UMF_report_vector	 umfsi_report_vector
+#define UMF_row_search		 umfsi_row_search
+#define UMF_scale		 umfsi_scale
+#define UMF_scale_column	 umfsi_scale_column
+#define UMF_set_stats		 umfsi_set_stats
+#define UMF_singletons		 umf_i_singletons
+#define UMF_solve		 umfsi_solve
+#define UMF_msolve		 umfsi_msolve
+#define UMF_refactor		 umfsi_refactor
+#define UMF_start_front		 umfsi_start_front
+#define UMF_store_lu		 umfsi_store_lu
+#define UMF_store_lu_drop	 umfsi_store_lu_drop
+#define UMF_symbolic_usage	 umfsi_symbolic_usage
+#define UMF_transpose		 umfsi_transpose
+#define UMF_tuple_lengths	 umfsi_tuple_lengths
+#define UMF_usolve		 umfsi_usolve
+#define UMF_utsolve		 umfsi_utsolve
+#define UMF_uhsolve		 umfsi_uhsolve
+#define UMF_valid_numeric	 umfsi_valid_numeric
+#define UMF_valid_symbolic	 umfsi_valid_symbolic
+#define UMF_triplet_map_x	 umfsi_triplet_map_x
+#define UMF_triplet_map_nox	 umfsi_triplet_map_nox
+#define UMF_triplet_nomap_x	 umfsi_triplet_nomap_x
+#define UMF_triplet_nomap_nox	 umfsi_triplet_nomap_nox
+#define UMF_cholmod		 umf_i_cholmod
+
+#define UMFPACK_col_to_triplet	 umfpack_si_col_to_triplet
+#define UMFPACK_defaults	 umfpack_si_defaults
+#define UMFPACK_free_numeric	 umfpack_si_free_numeric
+#define UMFPACK_free_symbolic	 umfpack_si_free_symbolic
+#define UMFPACK_get_lunz	 umfpack_si_get_lunz
+#define UMFPACK_get_numeric	 umfpack_si_get_numeric
+#define UMFPACK_get_symbolic	 umfpack_si_get_symbolic
+#define UMFPACK_get_determinant	 umfpack_si_get_determinant
+#define UMFPACK_numeric		 umfpack_si_numeric
+#define UMFPACK_renumeric	 umfpack_si_renumeric
+#define UMFPACK_qsymbolic	 umfpack_si_qsymbolic
+#define UMFPACK_fsymbolic	 umfpack_si_fsymbolic
+#define UMFPACK_report_control	 umfpack_si_report_control
+#define UMFPACK_report_info	 umfpack_si_report_info
+#define UMFPACK_report_matrix	 umfpack_si_report_matrix
+#define UMFPACK_report_numeric	 umfpack_si_report_numeric
+#define UMFPACK_report_perm	 umfpack_si_report_perm
+#define UMFPACK_report_status	 umfpack_si_report_status
+#define UMFPACK_report_symbolic	 umfpack_si_report_symbolic
+#define UMFPACK_report_triplet	 umfpack_si_report_triplet
+#define UMFPACK_report_vector	 umfpack_si_report_vector
+#define UMFPACK_save_numeric	 umfpack_si_save_numeric
+#define UMFPACK_save_symbolic	 umfpack_si_save_symbolic
+#define UMFPACK_load_numeric	 umfpack_si_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_si_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_si_load_numeric_mmap
+#define UMFPACK_load_symbolic	 umfpack_si_load_symbolic
+#define UMFPACK_scale		 umfpack_si_scale
+#define UMFPACK_solve		 umfpack_si_solve
+#define UMFPACK_symbolic	 umfpack_si_symbolic
+#define UMFPACK_transpose	 umfpack_si_transpose
+#define UMFPACK_triplet_to_col	 umfpack_si_triplet_to_col
+#define UMFPACK_wsolve		 umfpack_si_wsolve
+#define UMFPACK_msolve		 umfpack_si_msolve
+#define UMFPACK_queue		 umfpack_si_queue
+#define UMFPACK_qsolve		 umfpack_si_qsolve
+#define UMFPACK_free_queue	 umfpack_si_free_queue
+#define UMFPACK_refactor	 umfpack_si_refactor
+
+/* for debugging only: */
+#define UMF_malloc_count	 umf_i_malloc_count
+#define UMF_debug		 umfsi_debug
+#define UMF_allocfail		 umfsi_allocfail
+#define UMF_gprob		 umfsi_gprob
+#define UMF_dump_dense		 umfsi_dump_dense
+#define UMF_dump_element	 umfsi_dump_element
+#define UMF_dump_rowcol		 umfsi_dump_rowcol
+#define UMF_dump_matrix		 umfsi_dump_matrix
+#define UMF_dump_current_front	 umfsi_dump_current_front
+#define UMF_dump_lu		 umfsi_dump_lu
+#define UMF_dump_memory		 umfsi_dump_memory
+#define UMF_dump_packed_memory	 umfsi_dump_packed_memory
+#define UMF_dump_col_matrix	 umfsi_dump_col_matrix
+#define UMF_dump_chain		 umfsi_dump_chain
+#define UMF_dump_start		 umfsi_dump_start
+#define UMF_dump_rowmerge	 umfsi_dump_rowmerge
+#define UMF_dump_diagonal_map	 umfsi_dump_diagonal_map
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* Single precision LU factors, with SuiteSparse_long's as integers */
+/* -------------------------------------------------------------------------- */
+
+#ifdef SLONG
+
+#define UMF_analyze		 umf_l_analyze
+#define UMF_apply_order		 umf_l_apply_order
+#define UMF_assemble		 umfsl_assemble
+#define UMF_assemble_fixq	 umfsl_assemble_fixq
+#define UMF_blas3_update	 umfsl_blas3_update
+#define UMF_build_tuples	 umfsl_build_tuples
+#define UMF_build_tuples_usage	 umfsl_build_tuples_usage
+#define UMF_colamd		 umf_l_colamd
+#define UMF_colamd_set_defaults	 umf_l_colamd_set_defaults
+#define UMF_create_element	 umfsl_create_element
+#define UMF_cumsum		 umf_l_cumsum
+#define UMF_extend_front	 umfsl_extend_front
+#define UMF_free		 umf_l_free
+#define UMF_fsize		 umf_l_fsize
+#define UMF_garbage_collection	 umfsl_garbage_collection
+#define UMF_get_memory		 umfsl_get_memory
+#define UMF_grow_front		 umfsl_grow_front
+#define UMF_init_front		 umfsl_init_front
+#define UMF_is_permutation	 umf_l_is_permutation
+#define UMF_kernel		 umfsl_kernel
+#define UMF_kernel_init		 umfsl_kernel_init
+#define UMF_kernel_init_usage	 umfsl_kernel_init_usage
+#define UMF_kernel_wrapup	 umfsl_kernel_wrapup
+#define UMF_local_search	 umfsl_local_search
+#define UMF_lsolve		 umfsl_lsolve
+#define UMF_ltsolve		 umfsl_ltsolve
+#define UMF_lhsolve		 umfsl_lhsolve
+#define UMF_malloc		 umf_l_malloc
+#define UMF_mem_alloc_element	 umfsl_mem_alloc_element
+#define UMF_mem_alloc_head_block umfsl_mem_alloc_head_block
+#define UMF_mem_alloc_tail_block umfsl_mem_alloc_tail_block
+#define UMF_mem_free_tail_block	 umfsl_mem_free_tail_block
+#define UMF_mem_init_memoryspace umfsl_mem_init_memoryspace
+#define UMF_realloc		 umf_l_realloc
+#define UMF_report_perm		 umf_l_report_perm
+#define UMF_report_vector	 umfsl_report_vector
+#define UMF_row_search		 umfsl_row_search
+#define UMF_scale		 umfsl_scale
+#define UMF_scale_column	 umfsl_scale_column
+#define UMF_set_stats		 umfsl_set_stats
+#define UMF_singletons		 umf_l_singletons
+#define UMF_solve		 umfsl_solve
+#define UMF_msolve		 umfsl_msolve
+#define UMF_refactor		 umfsl_refactor
+#define UMF_start_front		 umfsl_start_front
+#define UMF_store_lu		 umfsl_store_lu
+#define UMF_store_lu_drop	 umfsl_store_lu_drop
+#define UMF_symbolic_usage	 umfsl_symbolic_usage
+#define UMF_transpose		 umfsl_transpose
+#define UMF_tuple_lengths	 umfsl_tuple_lengths
+#define UMF_usolve		 umfsl_usolve
+#define UMF_utsolve		 umfsl_utsolve
+#define UMF_uhsolve		 umfsl_uhsolve
+#define UMF_valid_numeric	 umfsl_valid_numeric
+#define UMF_valid_symbolic	 umfsl_valid_symbolic
+#define UMF_triplet_map_x	 umfsl_triplet_map_x
+#define UMF_triplet_map_nox	 umfsl_triplet_map_nox
+#define UMF_triplet_nomap_x	 umfsl_triplet_nomap_x
+#define UMF_triplet_nomap_nox	 umfsl_triplet_nomap_nox
+#define UMF_cholmod		 umf_l_cholmod
+
+#define UMFPACK_col_to_triplet	 umfpack_sl_col_to_triplet
+#define UMFPACK_defaults	 umfpack_sl_defaults
+#define UMFPACK_free_numeric	 umfpack_sl_free_numeric
+#define UMFPACK_free_symbolic	 umfpack_sl_free_symbolic
+#define UMFPACK_get_lunz	 umfpack_sl_get_lunz
+#define UMFPACK_get_numeric	 umfpack_sl_get_numeric
+#define UMFPACK_get_symbolic	 umfpack_sl_get_symbolic
+#define UMFPACK_get_determinant	 umfpack_sl_get_determinant
+#define UMFPACK_numeric		 umfpack_sl_numeric
+#define UMFPACK_renumeric	 umfpack_sl_renumeric
+#define UMFPACK_qsymbolic	 umfpack_sl_qsymbolic
+#define UMFPACK_fsymbolic	 umfpack_sl_fsymbolic
+#define UMFPACK_report_control	 umfpack_sl_report_control
+#define UMFPACK_report_info	 umfpack_sl_report_info
+#define UMFPACK_report_matrix	 umfpack_sl_report_matrix
+#define UMFPACK_report_numeric	 umfpack_sl_report_numeric
+#define UMFPACK_report_perm	 umfpack_sl_report_perm
+#define UMFPACK_report_status	 umfpack_sl_report_status
+#define UMFPACK_report_symbolic	 umfpack_sl_report_symbolic
+#define UMFPACK_report_triplet	 umfpack_sl_report_triplet
+#define UMFPACK_report_vector	 umfpack_sl_report_vector
+#define UMFPACK_save_numeric	 umfpack_sl_save_numeric
+#define UMFPACK_save_symbolic	 umfpack_sl_save_symbolic
+#define UMFPACK_load_numeric	 umfpack_sl_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_sl_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_sl_load_numeric_mmap
+#define UMFPACK_load_symbolic	 umfpack_sl_load_symbolic
+#define UMFPACK_scale		 umfpack_sl_scale
+#define UMFPACK_solve		 umfpack_sl_solve
+#define UMFPACK_symbolic	 umfpack_sl_symbolic
+#define UMFPACK_transpose	 umfpack_sl_transpose
+#define UMFPACK_triplet_to_col	 umfpack_sl_triplet_to_col
+#define UMFPACK_wsolve		 umfpack_sl_wsolve
+#define UMFPACK_msolve		 umfpack_sl_msolve
+#define UMFPACK_queue		 umfpack_sl_queue
+#define UMFPACK_qsolve		 umfpack_sl_qsolve
+#define UMFPACK_free_queue	 umfpack_sl_free_queue
+#define UMFPACK_refactor	 umfpack_sl_refactor
+
+/* for debugging only: */
+#define UMF_malloc_count	 umf_l_malloc_count
+#define UMF_debug		 umfsl_debug
+#define UMF_allocfail		 umfsl_allocfail
+#define UMF_gprob		 umfsl_gprob
+#define UMF_dump_dense		 umfsl_dump_dense
+#define UMF_dump_element	 umfsl_dump_element
+#define UMF_dump_rowcol		 umfsl_dump_rowcol
+#define UMF_dump_matrix		 umfsl_dump_matrix
+#define UMF_dump_current_front	 umfsl_dump_current_front
+#define UMF_dump_lu		 umfsl_dump_lu
+#define UMF_dump_memory		 umfsl_dump_memory
+#define UMF_dump_packed_memory	 umfsl_dump_packed_memory
+#define UMF_dump_col_matrix	 umfsl_dump_col_matrix
+#define UMF_dump_chain		 umfsl_dump_chain
+#define UMF_dump_start		 umfsl_dump_start
+#define UMF_dump_rowmerge	 umfsl_dump_rowmerge
+#define UMF_dump_diagonal_map	 umfsl_dump_diagonal_map
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* Complex single precision LU factors, with int's as integers */
+/* -------------------------------------------------------------------------- */
+
+#ifdef CINT
+
+#define UMF_analyze		 umf_i_analyze
+#define UMF_apply_order		 umf_i_apply_order
+#define UMF_assemble		 umfci_assemble
+#define UMF_assemble_fixq	 umfci_assemble_fixq
+#define UMF_blas3_update	 umfci_blas3_update
+#define UMF_build_tuples	 umfci_build_tuples
+#define UMF_build_tuples_usage	 umfci_build_tuples_usage
+#define UMF_colamd		 umf_i_colamd
+#define UMF_colamd_set_defaults	 umf_i_colamd_set_defaults
+#define UMF_create_element	 umfci_create_element
+#define UMF_cumsum		 umf_i_cumsum
+#define UMF_extend_front	 umfci_extend_front
+#define UMF_free		 umf_i_free
+#define UMF_fsize		 umf_i_fsize
+#define UMF_garbage_collection	 umfci_garbage_collection
+#define UMF_get_memory		 umfci_get_memory
+#define UMF_grow_front		 umfci_grow_front
+#define UMF_init_front		 umfci_init_front
+#define UMF_is_permutation	 umf_i_is_permutation
+#define UMF_kernel		 umfci_kernel
+#define UMF_kernel_init		 umfci_kernel_init
+#define UMF_kernel_init_usage	 umfci_kernel_init_usage
+#define UMF_kernel_wrapup	 umfci_kernel_wrapup
+#define UMF_local_search	 umfci_local_search
+#define UMF_lsolve		 umfci_lsolve
+#define UMF_ltsolve		 umfci_ltsolve
+#define UMF_lhsolve		 umfci_lhsolve
+#define UMF_malloc		 umf_i_malloc
+#define UMF_mem_alloc_element	 umfci_mem_alloc_element
+#define UMF_mem_alloc_head_block umfci_mem_alloc_head_block
+#define UMF_mem_alloc_tail_block umfci_mem_alloc_tail_block
+#define UMF_mem_free_tail_block	 umfci_mem_free_tail_block
+#define UMF_mem_init_memoryspace umfci_mem_init_memoryspace
+#define UMF_realloc		 umf_i_realloc
+#define UMF_report_perm		 umf_i_report_perm
+#define UMF_report_vector	 umfci_report_vector
+#define UMF_row_search		 umfci_row_search
+#define UMF_scale		 umfci_scale
+#define UMF_scale_column	 umfci_scale_column
+#define UMF_set_stats		 umfci_set_stats
+#define UMF_singletons		 umf_i_singletons
+#define UMF_solve		 umfci_solve
+#define UMF_msolve		 umfci_msolve
+#define UMF_refactor		 umfci_refactor
+#define UMF_start_front		 umfci_start_front
+#define UMF_store_lu		 umfci_store_lu
+#define UMF_store_lu_drop	 umfci_store_lu_drop
+#define UMF_symbolic_usage	 umfci_symbolic_usage
+#define UMF_transpose		 umfci_transpose
+#define UMF_tuple_lengths	 umfci_tuple_lengths
+#define UMF_usolve		 umfci_usolve
+#define UMF_utsolve		 umfci_utsolve
+#define UMF_uhsolve		 umfci_uhsolve
+#define UMF_valid_numeric	 umfci_valid_numeric
+#define UMF_valid_symbolic	 umfci_valid_symbolic
+#define UMF_triplet_map_x	 umfci_triplet_map_x
+#define UMF_triplet_map_nox	 umfci_triplet_map_nox
+#define UMF_triplet_nomap_x	 umfci_triplet_nomap_x
+#define UMF_triplet_nomap_nox	 umfci_triplet_nomap_nox
+#define UMF_cholmod		 umf_i_cholmod
+
+#define UMFPACK_col_to_triplet	 umfpack_ci_col_to_triplet
+#define UMFPACK_defaults	 umfpack_ci_defaults
+#define UMFPACK_free_numeric	 umfpack_ci_free_numeric
+#define UMFPACK_free_symbolic	 umfpack_ci_free_symbolic
+#define UMFPACK_get_lunz	 umfpack_ci_get_lunz
+#define UMFPACK_get_numeric	 umfpack_ci_get_numeric
+#define UMFPACK_get_symbolic	 umfpack_ci_get_symbolic
+#define UMFPACK_get_determinant	 umfpack_ci_get_determinant
+#define UMFPACK_numeric		 umfpack_ci_numeric
+#define UMFPACK_renumeric	 umfpack_ci_renumeric
+#define UMFPACK_qsymbolic	 umfpack_ci_qsymbolic
+#define UMFPACK_fsymbolic	 umfpack_ci_fsymbolic
+#define UMFPACK_report_control	 umfpack_ci_report_control
+#define UMFPACK_report_info	 umfpack_ci_report_info
+#define UMFPACK_report_matrix	 umfpack_ci_report_matrix
+#define UMFPACK_report_numeric	 umfpack_ci_report_numeric
+#define UMFPACK_report_perm	 umfpack_ci_report_perm
+#define UMFPACK_report_status	 umfpack_ci_report_status
+#define UMFPACK_report_symbolic	 umfpack_ci_report_symbolic
+#define UMFPACK_report_triplet	 umfpack_ci_report_triplet
+#define UMFPACK_report_vector	 umfpack_ci_report_vector
+#define UMFPACK_save_numeric	 umfpack_ci_save_numeric
+#define UMFPACK_save_symbolic	 umfpack_ci_save_symbolic
+#define UMFPACK_load_numeric	 umfpack_ci_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_ci_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_ci_load_numeric_mmap
+#define UMFPACK_load_symbolic	 umfpack_ci_load_symbolic
+#define UMFPACK_scale		 umfpack_ci_scale
+#define UMFPACK_solve		 umfpack_ci_solve
+#define UMFPACK_symbolic	 umfpack_ci_symbolic
+#define UMFPACK_transpose	 umfpack_ci_transpose
+#define UMFPACK_triplet_to_col	 umfpack_ci_triplet_to_col
+#define UMFPACK_wsolve		 umfpack_ci_wsolve
+#define UMFPACK_msolve		 umfpack_ci_msolve
+#define UMFPACK_queue		 umfpack_ci_queue
+#define UMFPACK_qsolve		 umfpack_ci_qsolve
+#define UMFPACK_free_queue	 umfpack_ci_free_queue
+#define UMFPACK_refactor	 umfpack_ci_refactor
+
+/* for debugging only: */
+#define UMF_malloc_count	 umf_i_malloc_count
+#define UMF_debug		 umfci_debug
+#define UMF_allocfail		 umfci_allocfail
+#define UMF_gprob		 umfci_gprob
+#define UMF_dump_dense		 umfci_dump_dense
+#define UMF_dump_element	 umfci_dump_element
+#define UMF_dump_rowcol		 umfci_dump_rowcol
+#define UMF_dump_matrix		 umfci_dump_matrix
+#define UMF_dump_current_front	 umfci_dump_current_front
+#define UMF_dump_lu		 umfci_dump_lu
+#define UMF_dump_memory		 umfci_dump_memory
+#define UMF_dump_packed_memory	 umfci_dump_packed_memory
+#define UMF_dump_col_matrix	 umfci_dump_col_matrix
+#define UMF_dump_chain		 umfci_dump_chain
+#define UMF_dump_start		 umfci_dump_start
+#define UMF_dump_rowmerge	 umfci_dump_rowmerge
+#define UMF_dump_diagonal_map	 umfci_dump_diagonal_map
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* Complex single precision LU factors, with SuiteSparse_long's as integers */
+/* -------------------------------------------------------------------------- */
+
+#ifdef CLONG
+
+#define UMF_analyze		 umf_l_analyze
+#define UMF_apply_order		 umf_l_apply_order
+#define UMF_assemble		 umfcl_assemble
+#define UMF_assemble_fixq	 umfcl_assemble_fixq
+#define UMF_blas3_update	 umfcl_blas3_update
+#define UMF_build_tuples	 umfcl_build_tuples
+#define UMF_build_tuples_usage	 umfcl_build_tuples_usage
+#define UMF_colamd		 umf_l_colamd
+#define UMF_colamd_set_defaults	 umf_l_colamd_set_defaults
+#define UMF_create_element	 umfcl_create_element
+#define UMF_cumsum		 umf_l_cumsum
+#define UMF_extend_front	 umfcl_extend_front
+#define UMF_free		 umf_l_free
+#define UMF_fsize		 umf_l_fsize
+#define UMF_garbage_collection	 umfcl_garbage_collection
+#define UMF_get_memory		 umfcl_get_memory
+#define UMF_grow_front		 umfcl_grow_front
+#define UMF_init_front		 umfcl_init_front
+#define UMF_is_permutation	 umf_l_is_permutation
+#define UMF_kernel		 umfcl_kernel
+#define UMF_kernel_init		 umfcl_kernel_init
+#define UMF_kernel_init_usage	 umfcl_kernel_init_usage
+#define UMF_kernel_wrapup	 umfcl_kernel_wrapup
+#define UMF_local_search	 umfcl_local_search
+#define UMF_lsolve		 umfcl_lsolve
+#define UMF_ltsolve		 umfcl_ltsolve
+#define UMF_lhsolve		 umfcl_lhsolve
+#define UMF_malloc		 umf_l_malloc
+#define UMF_mem_alloc_element	 umfcl_mem_alloc_element
+#define UMF_mem_alloc_head_block umfcl_mem_alloc_head_block
+#define UMF_mem_alloc_tail_block umfcl_mem_alloc_tail_block
+#define UMF_mem_free_tail_block	 umfcl_mem_free_tail_block
+#define UMF_mem_init_memoryspace umfcl_mem_init_memoryspace
+#define UMF_realloc		 umf_l_realloc
+#define UMF_report_perm		 umf_l_report_perm
+#define UMF_report_vector	 umfcl_report_vector
+#define UMF_row_search		 umfcl_row_search
+#define UMF_scale		 umfcl_scale
+#define UMF_scale_column	 umfcl_scale_column
+#define UMF_set_stats		 umfcl_set_stats
+#define UMF_singletons		 umf_l_singletons
+#define UMF_solve		 umfcl_solve
+#define UMF_msolve		 umfcl_msolve
+#define UMF_refactor		 umfcl_refactor
+#define UMF_start_front		 umfcl_start_front
+#define UMF_store_lu		 umfcl_store_lu
+#define UMF_store_lu_drop	 umfcl_store_lu_drop
+#define UMF_symbolic_usage	 umfcl_symbolic_usage
+#define UMF_transpose		 umfcl_transpose
+#define UMF_tuple_lengths	 umfcl_tuple_lengths
+#define UMF_usolve		 umfcl_usolve
+#define UMF_utsolve		 umfcl_utsolve
+#define UMF_uhsolve		 umfcl_uhsolve
+#define UMF_valid_numeric	 umfcl_valid_numeric
+#define UMF_valid_symbolic	 umfcl_valid_symbolic
+#define UMF_triplet_map_x	 umfcl_triplet_map_x
+#define UMF_triplet_map_nox	 umfcl_triplet_map_nox
+#define UMF_triplet_nomap_x	 umfcl_triplet_nomap_x
+#define UMF_triplet_nomap_nox	 umfcl_triplet_nomap_nox
+#define UMF_cholmod		 umf_l_cholmod
+
+#define UMFPACK_col_to_triplet	 umfpack_cl_col_to_triplet
+#define UMFPACK_defaults	 umfpack_cl_defaults
+#define UMFPACK_free_numeric	 umfpack_cl_free_numeric
+#define UMFPACK_free_symbolic	 umfpack_cl_free_symbolic
+#define UMFPACK_get_lunz	 umfpack_cl_get_lunz
+#define UMFPACK_get_numeric	 umfpack_cl_get_numeric
+#define UMFPACK_get_symbolic	 umfpack_cl_get_symbolic
+#define UMFPACK_get_determinant	 umfpack_cl_get_determinant
+#define UMFPACK_numeric		 umfpack_cl_numeric
+#define UMFPACK_renumeric	 umfpack_cl_renumeric
+#define UMFPACK_qsymbolic	 umfpack_cl_qsymbolic
+#define UMFPACK_fsymbolic	 umfpack_cl_fsymbolic
+#define UMFPACK_report_control	 umfpack_cl_report_control
+#define UMFPACK_report_info	 umfpack_cl_report_info
+#define UMFPACK_report_matrix	 umfpack_cl_report_matrix
+#define UMFPACK_report_numeric	 umfpack_cl_report_numeric
+#define UMFPACK_report_perm	 umfpack_cl_report_perm
+#define UMFPACK_report_status	 umfpack_cl_report_status
+#define UMFPACK_report_symbolic	 umfpack_cl_report_symbolic
+#define UMFPACK_report_triplet	 umfpack_cl_report_triplet
+#define UMFPACK_report_vector	 umfpack_cl_report_vector
+#define UMFPACK_save_numeric	 umfpack_cl_save_numeric
+#define UMFPACK_save_symbolic	 umfpack_cl_save_symbolic
+#define UMFPACK_load_numeric	 umfpack_cl_load_numeric
+#define UMFPACK_save_numeric_mmap umfpack_cl_save_numeric_mmap
+#define UMFPACK_load_numeric_mmap umfpack_cl_load_numeric_mmap
+#define UMFPACK_load_symbolic	 umfpack_cl_load_symbolic
+#define UMFPACK_scale		 umfpack_cl_scale
+#define UMFPACK_solve		 umfpack_cl_solve
+#define UMFPACK_symbolic	 umfpack_cl_symbolic
+#define UMFPACK_transpose	 umfpack_cl_transpose
+#define UMFPACK_triplet_to_col	 umfpack_cl_triplet_to_col
+#define UMFPACK_wsolve		 umfpack_cl_wsolve
+#define UMFPACK_msolve		 umfpack_cl_msolve
+#define UMFPACK_queue		 umfpack_cl_queue
+#define UMFPACK_qsolve		 umfpack_cl_qsolve
+#define UMFPACK_free_queue	 umfpack_cl_free_queue
+#define UMFPACK_refactor	 umfpack_cl_refactor
+
+/* for debugging only: */
+#define UMF_malloc_count	 umf_l_malloc_count
+#define UMF_debug		 umfcl_debug
+#define UMF_allocfail		 umfcl_allocfail
+#define UMF_gprob		 umfcl_gprob
+#define UMF_dump_dense		 umfcl_dump_dense
+#define UMF_dump_element	 umfcl_dump_element
+#define UMF_dump_rowcol		 umfcl_dump_rowcol
+#define UMF_dump_matrix		 umfcl_dump_matrix
+#define UMF_dump_current_front	 umfcl_dump_current_front
+#define UMF_dump_lu		 umfcl_dump_lu
+#define UMF_dump_memory		 umfcl_dump_memory
+#define UMF_dump_packed_memory	 umfcl_dump_packed_memory
+#define UMF_dump_col_matrix	 umfcl_dump_col_matrix
+#define UMF_dump_chain		 umfcl_dump_chain
+#define UMF_dump_start		 umfcl_dump_start
+#define UMF_dump_rowmerge	 umfcl_dump_rowmerge
+#define UMF_dump_diagonal_map	 umfcl_dump_diagonal_map
+
+#endif
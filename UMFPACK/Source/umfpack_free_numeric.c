@@ -8,11 +8,16 @@
 /* -------------------------------------------------------------------------- */
 
 /*  User-callable.  Free the entire Numeric object (consists of 11 to 13
- *  malloc'd objects.  See UMFPACK_free_numeric.h for details.
+ *  malloc'd objects, plus 7 more if UMFPACK_refactor has been called, or
+ *  the header and a single file mapping if it was loaded by
+ *  UMFPACK_load_numeric_mmap).  See UMFPACK_free_numeric.h for details.
  */
 
 #include "umf_internal.h"
 #include "umf_free.h"
+#ifndef NPOSIX
+#include <sys/mman.h>
+#endif
 
 GLOBAL void UMFPACK_free_numeric
 (
@@ -31,6 +36,34 @@ GLOBAL void UMFPACK_free_numeric
 	return ;
     }
 
+    /* these 7 objects exist only if UMFPACK_refactor has been called */
+    (void) UMF_free ((void *) Numeric->Rf_Lp) ;
+    (void) UMF_free ((void *) Numeric->Rf_Li) ;
+    (void) UMF_free ((void *) Numeric->Rf_Lx) ;
+    (void) UMF_free ((void *) Numeric->Rf_Up) ;
+    (void) UMF_free ((void *) Numeric->Rf_Ui) ;
+    (void) UMF_free ((void *) Numeric->Rf_Ux) ;
+    (void) UMF_free ((void *) Numeric->Rf_Rinv) ;
+
+    if (Numeric->Mapping != (void *) NULL)
+    {
+	/* loaded by UMFPACK_load_numeric_mmap: the 12 arrays below are all
+	 * part of a single mapped (or malloc'd) copy of the file */
+#ifndef NPOSIX
+	if (Numeric->mapped)
+	{
+	    (void) munmap (Numeric->Mapping, Numeric->mapping_size) ;
+	}
+	else
+#endif
+	{
+	    (void) UMF_free (Numeric->Mapping) ;
+	}
+	(void) UMF_free ((void *) Numeric) ;
+	*NumericHandle = (void *) NULL ;
+	return ;
+    }
+
     /* these 9 objects always exist */
     (void) UMF_free ((void *) Numeric->D) ;
     (void) UMF_free ((void *) Numeric->Rperm) ;
@@ -0,0 +1,44 @@
+/* ========================================================================== */
+/* === UMFPACK_free_queue =================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*  User-callable.  Free the Queue object (3 malloc'd objects).  The Numeric
+ *  object it refers to is not free'd.  See umfpack_free_queue.h for details.
+ */
+
+#include "umf_internal.h"
+#include "umf_free.h"
+
+GLOBAL void UMFPACK_free_queue
+(
+    void **QueueHandle
+)
+{
+
+    QueueType *Queue ;
+    if (!QueueHandle)
+    {
+	return ;
+    }
+    Queue = *((QueueType **) QueueHandle) ;
+    if (!Queue)
+    {
+	return ;
+    }
+
+#ifndef NPOSIX
+    (void) pthread_cond_destroy (&(Queue->finished)) ;
+    (void) pthread_mutex_destroy (&(Queue->lock)) ;
+#endif
+
+    Queue->valid = 0 ;
+    (void) UMF_free ((void *) Queue->B) ;
+    (void) UMF_free ((void *) Queue->X) ;
+    (void) UMF_free ((void *) Queue) ;
+    *QueueHandle = (void *) NULL ;
+}
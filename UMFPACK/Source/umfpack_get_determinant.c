@@ -34,7 +34,7 @@
 
 PRIVATE Int rescale_determinant
 (
-    Entry *d_mantissa,
+    XEntry *d_mantissa,
     double *d_exponent
 )
 {
@@ -91,7 +91,7 @@ GLOBAL Int UMFPACK_get_determinant
     /* local variables */
     /* ---------------------------------------------------------------------- */
 
-    Entry d_mantissa, d_tmp ;
+    XEntry d_mantissa, d_tmp ;
     double d_exponent, Info2 [UMFPACK_INFO], one [2] = {1.0, 0.0}, d_sign ;
     Entry *D ;
     double *Info, *Rs ;
@@ -169,7 +169,7 @@ GLOBAL Int UMFPACK_get_determinant
     do_recip = Numeric->do_recip ;
 #endif
 
-    d_mantissa = ((Entry *) one) [0] ;
+    d_mantissa = ((XEntry *) one) [0] ;
     d_exponent = 0.0 ;
     D = Numeric->D ;
 
@@ -119,6 +119,17 @@ GLOBAL Int UMFPACK_load_numeric
     Numeric->Rs       = (double *) NULL ;
     Numeric->Memory   = (Unit *) NULL ;
     Numeric->Upattern = (Int *) NULL ;
+    Numeric->Rf_Lp    = (Int *) NULL ;
+    Numeric->Rf_Li    = (Int *) NULL ;
+    Numeric->Rf_Lx    = (Int *) NULL ;
+    Numeric->Rf_Up    = (Int *) NULL ;
+    Numeric->Rf_Ui    = (Int *) NULL ;
+    Numeric->Rf_Ux    = (Int *) NULL ;
+    Numeric->Rf_Rinv  = (Int *) NULL ;
+    Numeric->Mapping  = (void *) NULL ;
+    Numeric->mapping_size = 0 ;
+    Numeric->mapped   = FALSE ;
+    Numeric->capacity = Numeric->size ;
 
     /* umfpack_free_numeric can now be safely called if an error occurs */
 
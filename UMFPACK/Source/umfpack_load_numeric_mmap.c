@@ -0,0 +1,274 @@
+/* ========================================================================== */
+/* === UMFPACK_load_numeric_mmap ============================================ */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    User-callable.  Loads a Numeric object from a file created by
+    umfpack_*_save_numeric_mmap.  The file is mapped into memory, and the
+    arrays of the Numeric object (including Numeric->Memory and the
+    permutation vectors) are used in place.  Only the NumericType header is
+    copied.  If the file cannot be mapped (or if NPOSIX is defined), it is
+    read into a single malloc'd block instead.
+
+    Dynamic memory allocation:  the NumericType header, plus either the
+    mapping of the file or a malloc'd copy of it.  Both are free'd by
+    UMFPACK_free_numeric.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_numeric.h"
+#include "umf_malloc.h"
+#include "umf_free.h"
+#ifndef NPOSIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+/* ========================================================================== */
+/* === UMFPACK_load_numeric_mmap ============================================ */
+/* ========================================================================== */
+
+GLOBAL Int UMFPACK_load_numeric_mmap
+(
+    void **NumericHandle,
+    char *user_filename
+)
+{
+    NumericFileHeader Header ;
+    NumericType *Numeric ;
+    SuiteSparse_long nbytes [UMF_MMAP_NOBJECTS], offset ;
+    Int k, n_inner, npiv, nrs, nup, nunits, ok ;
+    void *Mapping ;
+    char *filename, *base ;
+    FILE *f ;
+#ifndef NPOSIX
+    struct stat st ;
+#endif
+
+    *NumericHandle = (void *) NULL ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the filename, or use the default name if filename is NULL */
+    /* ---------------------------------------------------------------------- */
+
+    if (user_filename == (char *) NULL)
+    {
+	filename = "numeric.umf" ;
+    }
+    else
+    {
+	filename = user_filename ;
+    }
+    f = fopen (filename, "rb") ;
+    if (!f)
+    {
+	return (UMFPACK_ERROR_file_IO) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* read and check the file header */
+    /* ---------------------------------------------------------------------- */
+
+    if (fread (&Header, sizeof (NumericFileHeader), 1, f) != 1 || ferror (f))
+    {
+	fclose (f) ;
+	return (UMFPACK_ERROR_file_IO) ;
+    }
+
+    if (strncmp (Header.id, UMF_MMAP_ID, 16) != 0
+	|| Header.valid != NUMERIC_VALID
+	|| Header.sizeof_numeric != sizeof (NumericType)
+	|| Header.sizeof_entry != sizeof (Entry)
+	|| Header.sizeof_unit != sizeof (Unit)
+	|| Header.sizeof_int != sizeof (Int)
+	|| Header.align != UMF_MMAP_ALIGN
+	|| Header.offset [0] != UMF_MMAP_ROUNDUP (sizeof (NumericFileHeader))
+	|| Header.file_size < Header.offset [0] + (SuiteSparse_long)
+	    sizeof (NumericType))
+    {
+	/* not a Numeric object file written by this version of UMFPACK */
+	fclose (f) ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* map the file into memory, or read it in if it cannot be mapped */
+    /* ---------------------------------------------------------------------- */
+
+    Mapping = (void *) NULL ;
+    ok = FALSE ;
+
+#ifndef NPOSIX
+    /* The mapping is private and writable, so that pages are shared with the
+     * page cache (and with other processes that map the same file) until
+     * they are modified.  Only UMFPACK_refactor modifies them. */
+    if (fstat (fileno (f), &st) == 0 && st.st_size == Header.file_size)
+    {
+	Mapping = mmap (NULL, (size_t) Header.file_size,
+	    PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno (f), 0) ;
+	ok = (Mapping != MAP_FAILED) ;
+	if (!ok)
+	{
+	    Mapping = (void *) NULL ;
+	}
+    }
+#endif
+
+    if (!ok)
+    {
+	if (INT_OVERFLOW (((double) Header.file_size) / sizeof (Unit) + 1))
+	{
+	    fclose (f) ;
+	    return (UMFPACK_ERROR_out_of_memory) ;
+	}
+	nunits = (Int) ((Header.file_size + sizeof (Unit) - 1) / sizeof (Unit)) ;
+	Mapping = UMF_malloc (nunits, sizeof (Unit)) ;
+	if (Mapping == (void *) NULL)
+	{
+	    fclose (f) ;
+	    return (UMFPACK_ERROR_out_of_memory) ;
+	}
+	base = (char *) Mapping ;
+	memcpy (base, &Header, sizeof (NumericFileHeader)) ;
+	offset = sizeof (NumericFileHeader) ;
+	if (fread (base + offset, 1, (size_t) (Header.file_size - offset), f)
+	    != (size_t) (Header.file_size - offset) || ferror (f))
+	{
+	    (void) UMF_free (Mapping) ;
+	    fclose (f) ;
+	    return (UMFPACK_ERROR_file_IO) ;
+	}
+    }
+
+    /* the file is no longer needed (a mapping persists after fclose) */
+    fclose (f) ;
+    base = (char *) Mapping ;
+
+    /* ---------------------------------------------------------------------- */
+    /* copy the Numeric header */
+    /* ---------------------------------------------------------------------- */
+
+    Numeric = (NumericType *) UMF_malloc (1, sizeof (NumericType)) ;
+    if (Numeric == (NumericType *) NULL)
+    {
+#ifndef NPOSIX
+	if (ok)
+	{
+	    (void) munmap (Mapping, (size_t) Header.file_size) ;
+	}
+	else
+#endif
+	{
+	    (void) UMF_free (Mapping) ;
+	}
+	return (UMFPACK_ERROR_out_of_memory) ;
+    }
+    memcpy (Numeric, base + Header.offset [0], sizeof (NumericType)) ;
+
+    /* none of the pointers in the file are valid */
+    Numeric->D        = (Entry *) NULL ;
+    Numeric->Rperm    = (Int *) NULL ;
+    Numeric->Cperm    = (Int *) NULL ;
+    Numeric->Lpos     = (Int *) NULL ;
+    Numeric->Lilen    = (Int *) NULL ;
+    Numeric->Lip      = (Int *) NULL ;
+    Numeric->Upos     = (Int *) NULL ;
+    Numeric->Uilen    = (Int *) NULL ;
+    Numeric->Uip      = (Int *) NULL ;
+    Numeric->Rs       = (double *) NULL ;
+    Numeric->Memory   = (Unit *) NULL ;
+    Numeric->Upattern = (Int *) NULL ;
+    Numeric->Rf_Lp    = (Int *) NULL ;
+    Numeric->Rf_Li    = (Int *) NULL ;
+    Numeric->Rf_Lx    = (Int *) NULL ;
+    Numeric->Rf_Up    = (Int *) NULL ;
+    Numeric->Rf_Ui    = (Int *) NULL ;
+    Numeric->Rf_Ux    = (Int *) NULL ;
+    Numeric->Rf_Rinv  = (Int *) NULL ;
+    Numeric->Mapping  = Mapping ;
+    Numeric->mapping_size = (size_t) Header.file_size ;
+    Numeric->mapped   = ok ;
+    Numeric->capacity = Numeric->size ;
+
+    /* umfpack_free_numeric can now be safely called if an error occurs */
+
+    if (Numeric->valid != NUMERIC_VALID || Numeric->n_row <= 0 ||
+	Numeric->n_col <= 0 || Numeric->npiv < 0 || Numeric->ulen < 0 ||
+	Numeric->size <= 0)
+    {
+	/* Numeric does not point to a NumericType object */
+	UMFPACK_free_numeric ((void **) &Numeric) ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* check the location of each array, and point to it in the file */
+    /* ---------------------------------------------------------------------- */
+
+    /* same objects and sizes as UMFPACK_save_numeric_mmap */
+    n_inner = MIN (Numeric->n_row, Numeric->n_col) ;
+    npiv = Numeric->npiv ;
+    nrs = (Numeric->scale != UMFPACK_SCALE_NONE) ? Numeric->n_row : 0 ;
+    nup = (Numeric->ulen > 0) ? (Numeric->ulen + 1) : 0 ;
+
+    nbytes [0]  = sizeof (NumericType) ;
+    nbytes [1]  = ((SuiteSparse_long) n_inner+1) * sizeof (Entry) ;
+    nbytes [2]  = ((SuiteSparse_long) Numeric->n_row+1) * sizeof (Int) ;
+    nbytes [3]  = ((SuiteSparse_long) Numeric->n_col+1) * sizeof (Int) ;
+    for (k = 4 ; k <= 9 ; k++)
+    {
+	/* Lpos, Lilen, Lip, Upos, Uilen, and Uip */
+	nbytes [k] = ((SuiteSparse_long) npiv+1) * sizeof (Int) ;
+    }
+    nbytes [10] = ((SuiteSparse_long) nrs) * sizeof (double) ;
+    nbytes [11] = ((SuiteSparse_long) nup) * sizeof (Int) ;
+    nbytes [12] = ((SuiteSparse_long) Numeric->size) * sizeof (Unit) ;
+
+    for (k = 0 ; k < UMF_MMAP_NOBJECTS ; k++)
+    {
+	offset = Header.offset [k] ;
+	if (nbytes [k] == 0 ? (offset != EMPTY) :
+	    (offset <= 0 || offset % UMF_MMAP_ALIGN != 0
+	    || offset + nbytes [k] > Header.file_size))
+	{
+	    /* the file is truncated or corrupted */
+	    UMFPACK_free_numeric ((void **) &Numeric) ;
+	    return (UMFPACK_ERROR_invalid_Numeric_object) ;
+	}
+    }
+
+    Numeric->D      = (Entry *) (base + Header.offset [1]) ;
+    Numeric->Rperm  = (Int *)   (base + Header.offset [2]) ;
+    Numeric->Cperm  = (Int *)   (base + Header.offset [3]) ;
+    Numeric->Lpos   = (Int *)   (base + Header.offset [4]) ;
+    Numeric->Lilen  = (Int *)   (base + Header.offset [5]) ;
+    Numeric->Lip    = (Int *)   (base + Header.offset [6]) ;
+    Numeric->Upos   = (Int *)   (base + Header.offset [7]) ;
+    Numeric->Uilen  = (Int *)   (base + Header.offset [8]) ;
+    Numeric->Uip    = (Int *)   (base + Header.offset [9]) ;
+    if (nrs > 0)
+    {
+	Numeric->Rs = (double *) (base + Header.offset [10]) ;
+    }
+    if (nup > 0)
+    {
+	Numeric->Upattern = (Int *) (base + Header.offset [11]) ;
+    }
+    Numeric->Memory = (Unit *) (base + Header.offset [12]) ;
+
+    /* make sure the Numeric object is valid */
+    if (!UMF_valid_numeric (Numeric))
+    {
+	UMFPACK_free_numeric ((void **) &Numeric) ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    *NumericHandle = (void *) Numeric ;
+    return (UMFPACK_OK) ;
+}
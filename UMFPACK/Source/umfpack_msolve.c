@@ -0,0 +1,456 @@
+/* ========================================================================== */
+/* === UMFPACK_msolve ======================================================= */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    User-callable.  Solves a linear system with multiple right-hand sides
+    using the numerical factorization computed by UMFPACK_numeric.  See
+    umfpack_msolve.h for more details.
+
+    For Ax=b, the right-hand sides are solved in blocks of UMF_MSOLVE_NB by
+    UMF_msolve, and the blocks are solved in parallel if UMFPACK is compiled
+    with OpenMP.  Each thread has its own workspace.  All other systems are
+    solved one column at a time by UMF_solve.
+
+    Dynamic memory usage:  for Ax=b, UMFPACK_msolve calls UMF_malloc three
+    times (four if iterative refinement is requested) for workspace of size
+    t*(c*n*nb*sizeof(double) + n*sizeof(Int)), where t is the number of
+    threads used, nb = UMF_MSOLVE_NB, and c is 3 for the real version and 6
+    for the complex version (7 and 12 with iterative refinement).  For other
+    systems, the workspace is the same as for UMFPACK_solve.  On return, all
+    of this workspace is free'd via UMF_free.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_numeric.h"
+#include "umf_solve.h"
+#include "umf_msolve.h"
+#include "umf_malloc.h"
+#include "umf_free.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+GLOBAL Int UMFPACK_msolve
+(
+    Int sys,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    Int nrhs,
+    double Xx [ ],
+#ifdef COMPLEX
+    double Xz [ ],
+#endif
+    const double Bx [ ],
+#ifdef COMPLEX
+    const double Bz [ ],
+#endif
+    void *NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO]
+)
+{
+    /* ---------------------------------------------------------------------- */
+    /* local variables */
+    /* ---------------------------------------------------------------------- */
+
+    XEntry aij ;
+    double Info2 [UMFPACK_INFO], Info1 [UMFPACK_INFO], stats [2], d, a ;
+    double *Info, *W, *Y, *Stats, *Rs, *xx ;
+    const double *bx ;
+    NumericType *Numeric ;
+    Int n, i, j, p, irstep, status, wsize, nblocks, nthreads, tid, block,
+	*Pattern ;
+#ifdef COMPLEX
+    double *xz ;
+    const double *bz ;
+    Int Xsplit, Bsplit, AXsplit ;
+#endif
+#ifndef NRECIPROCAL
+    Int do_recip ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* get the amount of time used by the process so far */
+    /* ---------------------------------------------------------------------- */
+
+    umfpack_tic (stats) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get parameters */
+    /* ---------------------------------------------------------------------- */
+
+    irstep = GET_CONTROL (UMFPACK_IRSTEP, UMFPACK_DEFAULT_IRSTEP) ;
+
+    if (User_Info != (double *) NULL)
+    {
+	/* return Info in user's array */
+	Info = User_Info ;
+	/* clear the parts of Info that are set by UMFPACK_msolve */
+	for (i = UMFPACK_IR_TAKEN ; i <= UMFPACK_SOLVE_TIME ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+    }
+    else
+    {
+	/* no Info array passed - use local one instead */
+	Info = Info2 ;
+	for (i = 0 ; i < UMFPACK_INFO ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+    }
+
+    Info [UMFPACK_STATUS] = UMFPACK_OK ;
+    Info [UMFPACK_SOLVE_FLOPS] = 0 ;
+
+    Numeric = (NumericType *) NumericHandle ;
+    if (!UMF_valid_numeric (Numeric))
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_Numeric_object ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    Info [UMFPACK_NROW] = Numeric->n_row ;
+    Info [UMFPACK_NCOL] = Numeric->n_col ;
+
+    if (Numeric->n_row != Numeric->n_col)
+    {
+	/* only square systems can be handled */
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_system ;
+	return (UMFPACK_ERROR_invalid_system) ;
+    }
+    n = Numeric->n_row ;
+    if (Numeric->nnzpiv < n
+	|| SCALAR_IS_ZERO (Numeric->rcond) || SCALAR_IS_NAN (Numeric->rcond))
+    {
+	/* turn off iterative refinement if A is singular */
+	/* or if U has NaN's on the diagonal. */
+	irstep = 0 ;
+	status = UMFPACK_WARNING_singular_matrix ;
+    }
+    else
+    {
+	status = UMFPACK_OK ;
+    }
+    irstep = MAX (0, irstep) ;
+
+    if (!Xx || !Bx)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_argument_missing ;
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+
+    if (nrhs < 0)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_n_nonpositive ;
+	return (UMFPACK_ERROR_n_nonpositive) ;
+    }
+
+    if (sys >= UMFPACK_Pt_L)
+    {
+	/* no iterative refinement except for nonsingular Ax=b, A'x=b, A.'x=b */
+	irstep = 0 ;
+    }
+
+#ifdef COMPLEX
+    Xsplit = SPLIT (Xz) ;
+    Bsplit = SPLIT (Bz) ;
+#endif
+
+    if (sys != UMFPACK_A)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* solve the other systems one column at a time */
+	/* ------------------------------------------------------------------ */
+
+#ifdef COMPLEX
+	wsize = (irstep > 0) ? (10*n) : (4*n) ;
+#else
+	wsize = (irstep > 0) ? (5*n) : n ;
+#endif
+	Pattern = (Int *) UMF_malloc (n, sizeof (Int)) ;
+	W = (double *) UMF_malloc (wsize, sizeof (double)) ;
+	if (!W || !Pattern)
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_out_of_memory ;
+	    (void) UMF_free ((void *) W) ;
+	    (void) UMF_free ((void *) Pattern) ;
+	    return (UMFPACK_ERROR_out_of_memory) ;
+	}
+
+	d = 0 ;
+	for (j = 0 ; j < nrhs ; j++)
+	{
+#ifdef COMPLEX
+	    xx = Xx + (Xsplit ? n : 2*n) * j ;
+	    xz = Xsplit ? (Xz + n*j) : (double *) NULL ;
+	    bx = Bx + (Bsplit ? n : 2*n) * j ;
+	    bz = Bsplit ? (Bz + n*j) : (double *) NULL ;
+#else
+	    xx = Xx + n*j ;
+	    bx = Bx + n*j ;
+#endif
+	    Info1 [UMFPACK_IR_TAKEN] = 0 ;
+	    Info1 [UMFPACK_IR_ATTEMPTED] = 0 ;
+	    status = UMF_solve (sys, Ap, Ai, Ax, xx, bx,
+#ifdef COMPLEX
+		Az, xz, bz,
+#endif
+		Numeric, irstep, Info1, Pattern, W) ;
+	    if (status < 0)
+	    {
+		break ;
+	    }
+	    d += Info1 [UMFPACK_SOLVE_FLOPS] ;
+	    if (j == 0)
+	    {
+		Info [UMFPACK_IR_TAKEN] = Info1 [UMFPACK_IR_TAKEN] ;
+		Info [UMFPACK_IR_ATTEMPTED] = Info1 [UMFPACK_IR_ATTEMPTED] ;
+	    }
+	    else
+	    {
+		Info [UMFPACK_IR_TAKEN] =
+		    MAX (Info [UMFPACK_IR_TAKEN], Info1 [UMFPACK_IR_TAKEN]) ;
+		Info [UMFPACK_IR_ATTEMPTED] =
+		    MAX (Info [UMFPACK_IR_ATTEMPTED], Info1[UMFPACK_IR_ATTEMPTED]);
+	    }
+	    if (irstep > 0)
+	    {
+		Info [UMFPACK_NZ] = Info1 [UMFPACK_NZ] ;
+		Info [UMFPACK_OMEGA1] = (j == 0) ? Info1 [UMFPACK_OMEGA1] :
+		    MAX (Info [UMFPACK_OMEGA1], Info1 [UMFPACK_OMEGA1]) ;
+		Info [UMFPACK_OMEGA2] = (j == 0) ? Info1 [UMFPACK_OMEGA2] :
+		    MAX (Info [UMFPACK_OMEGA2], Info1 [UMFPACK_OMEGA2]) ;
+	    }
+	}
+	Info [UMFPACK_SOLVE_FLOPS] = d ;
+
+	(void) UMF_free ((void *) W) ;
+	(void) UMF_free ((void *) Pattern) ;
+
+    }
+    else if (nrhs > 0)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* solve A X = B in blocks of UMF_MSOLVE_NB right-hand sides */
+	/* ------------------------------------------------------------------ */
+
+	if (irstep > 0 && (!Ap || !Ai || !Ax))
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_argument_missing ;
+	    return (UMFPACK_ERROR_argument_missing) ;
+	}
+
+	nblocks = (nrhs + UMF_MSOLVE_NB - 1) / UMF_MSOLVE_NB ;
+	nthreads = 1 ;
+#ifdef _OPENMP
+	nthreads = MAX (1, MIN (omp_get_max_threads ( ), nblocks)) ;
+#endif
+
+	/* per thread: B and X blocks, then the UMF_msolve workspace */
+	d = ((double) n) * UMF_MSOLVE_NB *
+	    ((2 + ((irstep > 0) ? 3 : 1)) * (sizeof (XEntry) / sizeof (double))
+	    + ((irstep > 0) ? 2 : 0)) ;
+	if (d * nthreads * sizeof (double) >= (double) Int_MAX)
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_out_of_memory ;
+	    return (UMFPACK_ERROR_out_of_memory) ;
+	}
+	wsize = (Int) d ;
+
+	Pattern = (Int *) UMF_malloc (nthreads * n, sizeof (Int)) ;
+	W = (double *) UMF_malloc (nthreads * wsize, sizeof (double)) ;
+	Stats = (double *) UMF_malloc (5 * nblocks, sizeof (double)) ;
+	Y = (irstep > 0) ? ((double *) UMF_malloc (n, sizeof (double))) :
+	    ((double *) NULL) ;
+	if (!W || !Pattern || !Stats || (irstep > 0 && !Y))
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_out_of_memory ;
+	    (void) UMF_free ((void *) W) ;
+	    (void) UMF_free ((void *) Pattern) ;
+	    (void) UMF_free ((void *) Stats) ;
+	    (void) UMF_free ((void *) Y) ;
+	    return (UMFPACK_ERROR_out_of_memory) ;
+	}
+
+	d = 0 ;
+	if (irstep > 0)
+	{
+	    /* Y (i) = ||R A_i||, 1-norm of row i of R A, shared by all blocks */
+#ifdef COMPLEX
+	    AXsplit = SPLIT (Az) ;
+#endif
+	    Info [UMFPACK_NZ] = Ap [n] ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		Y [i] = 0. ;
+	    }
+	    d += (ABS_FLOPS + 1) * Ap [n] ;
+	    for (p = 0 ; p < Ap [n] ; p++)
+	    {
+		/* Y [Ai [p]] += ABS (Ax [p]) ; */
+		ASSIGN (aij, Ax, Az, p, AXsplit) ;
+		ABS (a, aij) ;
+		Y [Ai [p]] += a ;
+	    }
+	    Rs = Numeric->Rs ;
+	    if (Rs != (double *) NULL)
+	    {
+#ifndef NRECIPROCAL
+		do_recip = Numeric->do_recip ;
+		if (do_recip)
+		{
+		    for (i = 0 ; i < n ; i++)
+		    {
+			Y [i] *= Rs [i] ;
+		    }
+		}
+		else
+#endif
+		{
+		    for (i = 0 ; i < n ; i++)
+		    {
+			Y [i] /= Rs [i] ;
+		    }
+		}
+		d += n ;
+	    }
+	}
+
+	/* each thread takes every nthreads-th block, with its own workspace */
+#ifdef _OPENMP
+	#pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+	for (tid = 0 ; tid < nthreads ; tid++)
+	{
+	    XEntry bij, xij, *Bt, *Xt ;
+	    double *xx ;
+	    const double *bx ;
+	    Int block, j1, nb, r, j, i, *Pt ;
+#ifdef COMPLEX
+	    double *xz ;
+	    const double *bz ;
+#endif
+
+	    Pt = Pattern + tid * n ;
+	    Bt = (XEntry *) (W + tid * wsize) ;
+	    Xt = Bt + n * UMF_MSOLVE_NB ;
+	    for (block = tid ; block < nblocks ; block += nthreads)
+	    {
+		j1 = block * UMF_MSOLVE_NB ;
+		nb = MIN (UMF_MSOLVE_NB, nrhs - j1) ;
+
+		/* gather B (:,j1:j1+nb-1) into the interleaved block Bt */
+		for (r = 0 ; r < nb ; r++)
+		{
+		    j = j1 + r ;
+#ifdef COMPLEX
+		    bx = Bx + (Bsplit ? n : 2*n) * j ;
+		    bz = Bsplit ? (Bz + n*j) : (double *) NULL ;
+#else
+		    bx = Bx + n*j ;
+#endif
+		    for (i = 0 ; i < n ; i++)
+		    {
+			ASSIGN (bij, bx, bz, i, Bsplit) ;
+			Bt [i*nb+r] = bij ;
+		    }
+		}
+
+		(void) UMF_msolve (Ap, Ai, Ax,
+#ifdef COMPLEX
+		    Az,
+#endif
+		    Numeric, nb, irstep, Y, Bt, Xt, Stats + 5*block, Pt,
+		    (double *) (Xt + n * UMF_MSOLVE_NB)) ;
+
+		/* scatter the interleaved block Xt into X (:,j1:j1+nb-1) */
+		for (r = 0 ; r < nb ; r++)
+		{
+		    j = j1 + r ;
+#ifdef COMPLEX
+		    xx = Xx + (Xsplit ? n : 2*n) * j ;
+		    xz = Xsplit ? (Xz + n*j) : (double *) NULL ;
+		    for (i = 0 ; i < n ; i++)
+		    {
+			xij = Xt [i*nb+r] ;
+			if (Xsplit)
+			{
+			    xx [i] = REAL_COMPONENT (xij) ;
+			    xz [i] = IMAG_COMPONENT (xij) ;
+			}
+			else
+			{
+			    ((XEntry *) xx) [i] = xij ;
+			}
+		    }
+#else
+		    xx = Xx + n*j ;
+		    for (i = 0 ; i < n ; i++)
+		    {
+			xij = Xt [i*nb+r] ;
+			xx [i] = xij ;
+		    }
+#endif
+		}
+	    }
+	}
+
+	/* combine the statistics of all blocks */
+	for (block = 0 ; block < nblocks ; block++)
+	{
+	    d += Stats [5*block] ;
+	}
+	Info [UMFPACK_IR_TAKEN] = 0 ;
+	Info [UMFPACK_IR_ATTEMPTED] = 0 ;
+	if (irstep > 0)
+	{
+	    Info [UMFPACK_OMEGA1] = 0 ;
+	    Info [UMFPACK_OMEGA2] = 0 ;
+	    for (block = 0 ; block < nblocks ; block++)
+	    {
+		Info [UMFPACK_OMEGA1] =
+		    MAX (Info [UMFPACK_OMEGA1], Stats [5*block+1]) ;
+		Info [UMFPACK_OMEGA2] =
+		    MAX (Info [UMFPACK_OMEGA2], Stats [5*block+2]) ;
+		Info [UMFPACK_IR_TAKEN] =
+		    MAX (Info [UMFPACK_IR_TAKEN], Stats [5*block+3]) ;
+		Info [UMFPACK_IR_ATTEMPTED] =
+		    MAX (Info [UMFPACK_IR_ATTEMPTED], Stats [5*block+4]) ;
+	    }
+	}
+	Info [UMFPACK_SOLVE_FLOPS] = d ;
+
+	(void) UMF_free ((void *) W) ;
+	(void) UMF_free ((void *) Pattern) ;
+	(void) UMF_free ((void *) Stats) ;
+	(void) UMF_free ((void *) Y) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get the time used by UMFPACK_msolve */
+    /* ---------------------------------------------------------------------- */
+
+    Info [UMFPACK_STATUS] = status ;
+    if (status >= 0)
+    {
+	umfpack_toc (stats) ;
+	Info [UMFPACK_SOLVE_WALLTIME] = stats [0] ;
+	Info [UMFPACK_SOLVE_TIME] = stats [1] ;
+    }
+
+    return (status) ;
+}
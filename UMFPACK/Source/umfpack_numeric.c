@@ -10,7 +10,9 @@
 /*
     User-callable.  Factorizes A into its LU factors, given a symbolic
     pre-analysis computed by UMFPACK_symbolic.  See umfpack_numeric.h for a
-    description.
+    description.  UMFPACK_renumeric is identical, except that it recycles the
+    variable-sized memory block (Numeric->Memory) of a prior Numeric object.
+    See umfpack_renumeric.h for a description.
 
     Dynamic memory allocation:  substantial.  See comments (1) through (7),
     below.  If an error occurs, all allocated space is free'd by UMF_free.
@@ -20,6 +22,7 @@
 
 #include "umf_internal.h"
 #include "umf_valid_symbolic.h"
+#include "umf_valid_numeric.h"
 #include "umf_set_stats.h"
 #include "umf_kernel.h"
 #include "umf_malloc.h"
@@ -46,7 +49,10 @@ PRIVATE Int numeric_alloc
     NumericType **NumericHandle,
     SymbolicType *Symbolic,
     double alloc_init,
-    Int scale
+    Int scale,
+    Unit **Recycled,
+    Int recycled_size,
+    Int prior_max_size
 ) ;
 
 PRIVATE void error
@@ -55,6 +61,23 @@ PRIVATE void error
     WorkType *Work
 ) ;
 
+PRIVATE Int numeric
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    void *SymbolicHandle,
+    void **NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO],
+    Unit **Recycled,
+    Int recycled_size,
+    Int prior_max_size
+) ;
+
 
 /* ========================================================================== */
 /* === UMFPACK_numeric ====================================================== */
@@ -73,6 +96,114 @@ GLOBAL Int UMFPACK_numeric
     const double Control [UMFPACK_CONTROL],
     double User_Info [UMFPACK_INFO]
 )
+{
+    return (numeric (Ap, Ai, Ax,
+#ifdef COMPLEX
+	Az,
+#endif
+	SymbolicHandle, NumericHandle, Control, User_Info,
+	(Unit **) NULL, 0, 0)) ;
+}
+
+
+/* ========================================================================== */
+/* === UMFPACK_renumeric ==================================================== */
+/* ========================================================================== */
+
+GLOBAL Int UMFPACK_renumeric
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    void *SymbolicHandle,
+    void **NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO]
+)
+{
+    NumericType *Prior ;
+    Unit *Recycled ;
+    Int status, recycled_size, prior_max_size ;
+
+    /* ---------------------------------------------------------------------- */
+    /* free the prior Numeric object, except for its memory block */
+    /* ---------------------------------------------------------------------- */
+
+    Recycled = (Unit *) NULL ;
+    recycled_size = 0 ;
+    prior_max_size = 0 ;
+    if (NumericHandle != (void **) NULL)
+    {
+	Prior = (NumericType *) (*NumericHandle) ;
+	if (Prior != (NumericType *) NULL)
+	{
+	    if (!UMF_valid_numeric (Prior))
+	    {
+		if (User_Info != (double *) NULL)
+		{
+		    User_Info [UMFPACK_STATUS] =
+			UMFPACK_ERROR_invalid_Numeric_object ;
+		}
+		return (UMFPACK_ERROR_invalid_Numeric_object) ;
+	    }
+	    if (Prior->Mapping == (void *) NULL)
+	    {
+		/* a mapped file cannot be recycled */
+		Recycled = Prior->Memory ;
+		recycled_size = Prior->capacity ;
+		prior_max_size = Prior->max_size ;
+		Prior->Memory = (Unit *) NULL ;
+	    }
+	    UMFPACK_free_numeric (NumericHandle) ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize, recycling the memory block if possible */
+    /* ---------------------------------------------------------------------- */
+
+    status = numeric (Ap, Ai, Ax,
+#ifdef COMPLEX
+	Az,
+#endif
+	SymbolicHandle, NumericHandle, Control, User_Info,
+	&Recycled, recycled_size, prior_max_size) ;
+
+    /* free the block if the factorization failed before it could be used */
+    (void) UMF_free ((void *) Recycled) ;
+    return (status) ;
+}
+
+
+/* ========================================================================== */
+/* === numeric ============================================================== */
+/* ========================================================================== */
+
+/* Numerical factorization.  Recycled is NULL for UMFPACK_numeric.  For
+ * UMFPACK_renumeric, *Recycled is the memory block of a prior Numeric object,
+ * of size recycled_size (or NULL if there is none).  It becomes
+ * Numeric->Memory if it is large enough, or is free'd otherwise, and
+ * *Recycled is then set to NULL. */
+
+PRIVATE Int numeric
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    void *SymbolicHandle,
+    void **NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO],
+    Unit **Recycled,
+    Int recycled_size,
+    Int prior_max_size
+)
 {
 
     /* ---------------------------------------------------------------------- */
@@ -100,7 +231,9 @@ GLOBAL Int UMFPACK_numeric
 
 #ifndef NDEBUG
     UMF_dump_start ( ) ;
-    init_count = UMF_malloc_count ;
+    /* a recycled block is already counted */
+    init_count = UMF_malloc_count -
+	(Recycled != (Unit **) NULL && *Recycled != (Unit *) NULL) ;
     DEBUGm4 (("\nUMFPACK numeric: U transpose version\n")) ;
 #endif
 
@@ -141,6 +274,7 @@ GLOBAL Int UMFPACK_numeric
 	{
 	    Info [i] = EMPTY ;
 	}
+	Info [UMFPACK_NUMERIC_DEFRAG_TIME] = EMPTY ;
     }
     else
     {
@@ -244,7 +378,8 @@ GLOBAL Int UMFPACK_numeric
      * factorization.  * This request is reduced if it fails.
      */
 
-    if (!numeric_alloc (&Numeric, Symbolic, alloc_init, scale))
+    if (!numeric_alloc (&Numeric, Symbolic, alloc_init, scale,
+	Recycled, recycled_size, prior_max_size))
     {
 	DEBUGm4 (("out of memory: initial numeric\n")) ;
 	Info [UMFPACK_STATUS] = UMFPACK_ERROR_out_of_memory ;
@@ -410,19 +545,34 @@ GLOBAL Int UMFPACK_numeric
 
     /* (7) The variable-sized block (Numeric->Memory) is reduced to hold just L
      * and U, via a call to UMF_realloc, since the frontal matrices are no
-     * longer needed.
+     * longer needed.  UMFPACK_renumeric does not reduce the block, but keeps
+     * all of it (Numeric->capacity Units) so that it can be recycled by the
+     * next call to UMFPACK_renumeric without any reallocation.
      */
 
+    Numeric->max_size = Numeric->size ;
+    Numeric->capacity = Numeric->size ;
     newsize = Numeric->ihead ;
     if (newsize < Numeric->size)
     {
-	mnew = (Unit *) UMF_realloc (Numeric->Memory, newsize, sizeof (Unit)) ;
-	if (mnew)
+	if (Recycled != (Unit **) NULL)
 	{
-	    /* realloc succeeded (how can it fail since the size is reduced?) */
-	    Numeric->Memory = mnew ;
+	    /* keep the whole block, but only the LU factors are in use */
 	    Numeric->size = newsize ;
 	}
+	else
+	{
+	    mnew = (Unit *) UMF_realloc (Numeric->Memory, newsize,
+		sizeof (Unit)) ;
+	    if (mnew)
+	    {
+		/* realloc succeeded (how can it fail since the size is
+		 * reduced?) */
+		Numeric->Memory = mnew ;
+		Numeric->size = newsize ;
+		Numeric->capacity = newsize ;
+	    }
+	}
     }
     Numeric->ihead = Numeric->size ;
     Numeric->itail = Numeric->ihead ;
@@ -455,6 +605,7 @@ GLOBAL Int UMFPACK_numeric
     Info [UMFPACK_NUMERIC_DEFRAG] = Numeric->ngarbage ;
     Info [UMFPACK_NUMERIC_REALLOC] = Numeric->nrealloc ;
     Info [UMFPACK_NUMERIC_COSTLY_REALLOC] = Numeric->ncostly ;
+    Info [UMFPACK_NUMERIC_DEFRAG_TIME] = Numeric->defrag_time ;
     Info [UMFPACK_COMPRESSED_PATTERN] = Numeric->isize ;
     Info [UMFPACK_LU_ENTRIES] = Numeric->nLentries + Numeric->nUentries +
 	    Numeric->npiv ;
@@ -526,14 +677,18 @@ GLOBAL Int UMFPACK_numeric
 /* === numeric_alloc ======================================================== */
 /* ========================================================================== */
 
-/* Allocate the Numeric object */
+/* Allocate the Numeric object.  If *Recycled is a prior memory block, it is
+ * used for Numeric->Memory if it is large enough. */
 
 PRIVATE Int numeric_alloc
 (
     NumericType **NumericHandle,
     SymbolicType *Symbolic,
     double alloc_init,
-    Int scale
+    Int scale,
+    Unit **Recycled,
+    Int recycled_size,
+    Int prior_max_size
 )
 {
     double nsize, bsize ;
@@ -558,6 +713,11 @@ PRIVATE Int numeric_alloc
     Numeric->valid = 0 ;
     *NumericHandle = Numeric ;
 
+    /* not a view of a file loaded by UMFPACK_load_numeric_mmap */
+    Numeric->Mapping = (void *) NULL ;
+    Numeric->mapping_size = 0 ;
+    Numeric->mapped = FALSE ;
+
     /* 9 allocations:  accounted for in UMF_set_stats (num_On_size1),
      * free'd in umfpack_free_numeric */
     Numeric->D = (Entry *) UMF_malloc (n_inner+1, sizeof (Entry)) ;
@@ -592,6 +752,15 @@ PRIVATE Int numeric_alloc
      * Numeric->Upattern is free'd in umfpack_free_numeric. */
     Numeric->Upattern = (Int *) NULL ;	/* used for singular matrices only */
 
+    /* The map used by UMFPACK_refactor is built on its first call. */
+    Numeric->Rf_Lp = (Int *) NULL ;
+    Numeric->Rf_Li = (Int *) NULL ;
+    Numeric->Rf_Lx = (Int *) NULL ;
+    Numeric->Rf_Up = (Int *) NULL ;
+    Numeric->Rf_Ui = (Int *) NULL ;
+    Numeric->Rf_Ux = (Int *) NULL ;
+    Numeric->Rf_Rinv = (Int *) NULL ;
+
     if (!Numeric->D || !Numeric->Rperm || !Numeric->Cperm || !Numeric->Upos ||
 	!Numeric->Lpos || !Numeric->Lilen || !Numeric->Uilen || !Numeric->Lip ||
 	!Numeric->Uip || (scale != UMFPACK_SCALE_NONE && !Numeric->Rs))
@@ -629,6 +798,28 @@ PRIVATE Int numeric_alloc
     DEBUG0 (("Num init %g usage_est %g numsize "ID" minusage "ID"\n",
 	alloc_init, Symbolic->num_mem_usage_est, Numeric->size, min_usage)) ;
 
+    if (Recycled != (Unit **) NULL && *Recycled != (Unit *) NULL)
+    {
+	/* Start with at least as much memory as the prior factorization
+	 * ended with, so that a similar factorization does not need to
+	 * reallocate Numeric->Memory, and rarely needs garbage collection. */
+	nsize = MAX (nsize, (double) prior_max_size) ;
+	nsize = MIN (nsize, bsize) ;
+	if (recycled_size >= (Int) nsize)
+	{
+	    /* use the entire prior block */
+	    DEBUG0 (("Recycled Numeric->size: "ID"\n", recycled_size)) ;
+	    Numeric->Memory = *Recycled ;
+	    Numeric->size = recycled_size ;
+	    *Recycled = (Unit *) NULL ;
+	    return (TRUE) ;
+	}
+	/* the prior block is too small; replace it with a larger one */
+	(void) UMF_free ((void *) *Recycled) ;
+	*Recycled = (Unit *) NULL ;
+	Numeric->size = (Int) nsize ;
+    }
+
     /* allocates 1 object: */
     /* keep trying until successful, or memory request is too small */
     trying = TRUE ;
@@ -0,0 +1,330 @@
+/* ========================================================================== */
+/* === UMFPACK_qsolve ======================================================= */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    User-callable.  Solves a linear system for one right-hand side, through a
+    Queue object created by UMFPACK_queue.  Any number of threads may call
+    UMFPACK_qsolve at the same time with the same Queue.  See umfpack_qsolve.h
+    for more details.
+
+    The requests are combined as follows.  Each caller links its request into
+    the Queue.  If no other thread is solving a block, the caller removes up
+    to max_nrhs requests from the head of the Queue (its own, and any that
+    arrived earlier or at the same time) and solves them with a single call
+    to UMFPACK_msolve.  Otherwise, it waits until a block has been solved, and
+    then checks again.  Requests that arrive while a block is being solved
+    thus accumulate in the Queue, and are solved together in the next block.
+    No thread is created, and a thread that calls UMFPACK_qsolve returns as
+    soon as its own request has been solved.
+
+    If UMFPACK is compiled with -DNPOSIX, there are no locks, and each
+    right-hand side is solved on its own by UMFPACK_msolve, directly from the
+    caller's arrays.  This is safe, since the solve does not modify the
+    Numeric object.
+
+    Dynamic memory usage:  the same as UMFPACK_msolve, for each block.
+*/
+
+#include "umf_internal.h"
+
+/* ========================================================================== */
+/* === copy_info ============================================================ */
+/* ========================================================================== */
+
+/* Copy the parts of Info set by UMFPACK_msolve into the caller's Info */
+
+PRIVATE void copy_info
+(
+    double Info [ ],
+    const double Info1 [ ],
+    Int nb
+)
+{
+    Int i ;
+    if (Info == (double *) NULL)
+    {
+	return ;
+    }
+    Info [UMFPACK_STATUS] = Info1 [UMFPACK_STATUS] ;
+    Info [UMFPACK_NROW] = Info1 [UMFPACK_NROW] ;
+    Info [UMFPACK_NCOL] = Info1 [UMFPACK_NCOL] ;
+    if (Info1 [UMFPACK_NZ] != EMPTY)
+    {
+	Info [UMFPACK_NZ] = Info1 [UMFPACK_NZ] ;
+    }
+    for (i = UMFPACK_IR_TAKEN ; i <= UMFPACK_SOLVE_WALLTIME ; i++)
+    {
+	Info [i] = Info1 [i] ;
+    }
+    Info [UMFPACK_QSOLVE_NRHS] = nb ;
+}
+
+
+#ifndef NPOSIX
+
+/* ========================================================================== */
+/* === solve_block ========================================================== */
+/* ========================================================================== */
+
+/* Solve the nb requests in the list starting at First, in one block.  Only
+ * one thread at a time calls solve_block for a given Queue, without holding
+ * the lock, so it has exclusive use of Queue->B and Queue->X. */
+
+PRIVATE void solve_block
+(
+    QueueType *Queue,
+    QueueRequest *First,
+    Int nb
+)
+{
+    QueueRequest *Req ;
+    double Info1 [UMFPACK_INFO], *b, *x ;
+    Int i, k, r, n, nx, status ;
+
+    n = Queue->n ;
+    nx = n * (sizeof (XEntry) / sizeof (double)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* gather the right-hand sides into B, in packed form */
+    /* ---------------------------------------------------------------------- */
+
+    for (Req = First, r = 0 ; r < nb ; Req = Req->next, r++)
+    {
+	b = Queue->B + r * nx ;
+#ifdef COMPLEX
+	if (SPLIT (Req->Bz))
+	{
+	    for (i = 0 ; i < n ; i++)
+	    {
+		b [2*i  ] = Req->Bx [i] ;
+		b [2*i+1] = Req->Bz [i] ;
+	    }
+	}
+	else
+#endif
+	{
+	    for (k = 0 ; k < nx ; k++)
+	    {
+		b [k] = Req->Bx [k] ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve all nb systems at once */
+    /* ---------------------------------------------------------------------- */
+
+    for (i = 0 ; i < UMFPACK_INFO ; i++)
+    {
+	Info1 [i] = EMPTY ;
+    }
+    status = UMFPACK_msolve (Queue->sys, Queue->Ap, Queue->Ai, Queue->Ax,
+#ifdef COMPLEX
+	Queue->Az,
+#endif
+	nb, Queue->X,
+#ifdef COMPLEX
+	(double *) NULL,
+#endif
+	Queue->B,
+#ifdef COMPLEX
+	(double *) NULL,
+#endif
+	Queue->Numeric, Queue->Control, Info1) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* scatter the solutions back to each caller */
+    /* ---------------------------------------------------------------------- */
+
+    for (Req = First, r = 0 ; r < nb ; Req = Req->next, r++)
+    {
+	Req->status = status ;
+	copy_info (Req->Info, Info1, nb) ;
+	if (status < 0)
+	{
+	    continue ;
+	}
+	x = Queue->X + r * nx ;
+#ifdef COMPLEX
+	if (SPLIT (Req->Xz))
+	{
+	    for (i = 0 ; i < n ; i++)
+	    {
+		Req->Xx [i] = x [2*i  ] ;
+		Req->Xz [i] = x [2*i+1] ;
+	    }
+	}
+	else
+#endif
+	{
+	    for (k = 0 ; k < nx ; k++)
+	    {
+		Req->Xx [k] = x [k] ;
+	    }
+	}
+    }
+}
+#endif
+
+
+/* ========================================================================== */
+/* === UMFPACK_qsolve ======================================================= */
+/* ========================================================================== */
+
+GLOBAL Int UMFPACK_qsolve
+(
+    double Xx [ ],
+#ifdef COMPLEX
+    double Xz [ ],
+#endif
+    const double Bx [ ],
+#ifdef COMPLEX
+    const double Bz [ ],
+#endif
+    void *QueueHandle,
+    double Info [UMFPACK_INFO]
+)
+{
+    QueueType *Queue ;
+#ifdef NPOSIX
+    double Info1 [UMFPACK_INFO] ;
+    Int i, status ;
+#else
+    QueueRequest Request, *First, *Last, *Req, *Next ;
+    Int nb ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    Queue = (QueueType *) QueueHandle ;
+    if (Queue == (QueueType *) NULL || Queue->valid != QUEUE_VALID)
+    {
+	if (Info != (double *) NULL)
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_Numeric_object ;
+	}
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+    if (!Xx || !Bx)
+    {
+	if (Info != (double *) NULL)
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_argument_missing ;
+	}
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+
+#ifdef NPOSIX
+
+    /* ---------------------------------------------------------------------- */
+    /* no locks: solve this right-hand side on its own */
+    /* ---------------------------------------------------------------------- */
+
+    for (i = 0 ; i < UMFPACK_INFO ; i++)
+    {
+	Info1 [i] = EMPTY ;
+    }
+    status = UMFPACK_msolve (Queue->sys, Queue->Ap, Queue->Ai, Queue->Ax,
+#ifdef COMPLEX
+	Queue->Az,
+#endif
+	1, Xx,
+#ifdef COMPLEX
+	Xz,
+#endif
+	Bx,
+#ifdef COMPLEX
+	Bz,
+#endif
+	Queue->Numeric, Queue->Control, Info1) ;
+    copy_info (Info, Info1, 1) ;
+    return (status) ;
+
+#else
+
+    /* ---------------------------------------------------------------------- */
+    /* add this request to the tail of the Queue */
+    /* ---------------------------------------------------------------------- */
+
+    Request.Xx = Xx ;
+    Request.Bx = Bx ;
+#ifdef COMPLEX
+    Request.Xz = Xz ;
+    Request.Bz = Bz ;
+#else
+    Request.Xz = (double *) NULL ;
+    Request.Bz = (double *) NULL ;
+#endif
+    Request.Info = Info ;
+    Request.status = UMFPACK_OK ;
+    Request.done = FALSE ;
+    Request.next = (QueueRequest *) NULL ;
+
+    pthread_mutex_lock (&(Queue->lock)) ;
+    if (Queue->tail == (QueueRequest *) NULL)
+    {
+	Queue->head = &Request ;
+    }
+    else
+    {
+	Queue->tail->next = &Request ;
+    }
+    Queue->tail = &Request ;
+
+    /* ---------------------------------------------------------------------- */
+    /* solve blocks of requests until this one is done */
+    /* ---------------------------------------------------------------------- */
+
+    while (!Request.done)
+    {
+	if (Queue->busy)
+	{
+	    /* another thread is solving a block; wait for it to finish */
+	    pthread_cond_wait (&(Queue->finished), &(Queue->lock)) ;
+	    continue ;
+	}
+
+	/* remove up to max_nrhs requests from the head of the Queue */
+	Queue->busy = TRUE ;
+	First = Queue->head ;
+	Last = First ;
+	for (nb = 1 ; nb < Queue->max_nrhs && Last->next != NULL ; nb++)
+	{
+	    Last = Last->next ;
+	}
+	Queue->head = Last->next ;
+	if (Queue->head == (QueueRequest *) NULL)
+	{
+	    Queue->tail = (QueueRequest *) NULL ;
+	}
+	Last->next = (QueueRequest *) NULL ;
+
+	/* solve them, while other threads add new requests to the Queue */
+	pthread_mutex_unlock (&(Queue->lock)) ;
+	solve_block (Queue, First, nb) ;
+	pthread_mutex_lock (&(Queue->lock)) ;
+
+	/* each request lives on the stack of its caller, which may return as
+	 * soon as the lock is released */
+	for (Req = First ; Req != (QueueRequest *) NULL ; Req = Next)
+	{
+	    Next = Req->next ;
+	    Req->done = TRUE ;
+	}
+	Queue->busy = FALSE ;
+	pthread_cond_broadcast (&(Queue->finished)) ;
+    }
+
+    pthread_mutex_unlock (&(Queue->lock)) ;
+    return (Request.status) ;
+
+#endif
+}
@@ -2101,7 +2101,7 @@ PRIVATE Int symbolic_analysis
 	    DEBUG3 (("oldcol "ID" newcol "ID":\n", oldcol, newcol)) ;
 	    for (p = Ap [oldcol] ; p < Ap [oldcol+1] ; p++)
 	    {
-		Entry aij ;
+		XEntry aij ;
 		CLEAR (aij) ;
 		oldrow = Ai [p] ;
 		newrow = Ci [oldrow] ;
@@ -0,0 +1,154 @@
+/* ========================================================================== */
+/* === UMFPACK_queue ======================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    User-callable.  Creates a Queue object, through which many threads can
+    solve systems with a single Numeric object.  See umfpack_queue.h for
+    details.
+
+    Dynamic memory usage:  UMFPACK_queue calls UMF_malloc three times, for the
+    QueueType header and for the B and X blocks, of size
+    n*max_nrhs*sizeof(double) each (twice that in the complex case).  All
+    three are free'd by UMFPACK_free_queue.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_numeric.h"
+#include "umf_malloc.h"
+#include "umf_free.h"
+
+GLOBAL Int UMFPACK_queue
+(
+    Int sys,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    Int max_nrhs,
+    void *NumericHandle,
+    void **QueueHandle,
+    const double Control [UMFPACK_CONTROL]
+)
+{
+    QueueType *Queue ;
+    NumericType *Numeric ;
+    double d ;
+    Int i, n ;
+
+    if (!QueueHandle)
+    {
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+    *QueueHandle = (void *) NULL ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check the Numeric object and max_nrhs */
+    /* ---------------------------------------------------------------------- */
+
+    Numeric = (NumericType *) NumericHandle ;
+    if (!UMF_valid_numeric (Numeric))
+    {
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+    if (Numeric->n_row != Numeric->n_col)
+    {
+	/* only square systems can be handled */
+	return (UMFPACK_ERROR_invalid_system) ;
+    }
+    n = Numeric->n_row ;
+
+    if (max_nrhs <= 0)
+    {
+	max_nrhs = UMFPACK_DEFAULT_QUEUE_NRHS ;
+    }
+
+    /* the B and X blocks must be addressable with an Int */
+    d = ((double) n) * max_nrhs * (sizeof (XEntry) / sizeof (double)) ;
+    if (INT_OVERFLOW (d * sizeof (double)))
+    {
+	return (UMFPACK_ERROR_out_of_memory) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the Queue object */
+    /* ---------------------------------------------------------------------- */
+
+    Queue = (QueueType *) UMF_malloc (1, sizeof (QueueType)) ;
+    if (!Queue)
+    {
+	return (UMFPACK_ERROR_out_of_memory) ;
+    }
+    Queue->B = (double *) UMF_malloc ((Int) d, sizeof (double)) ;
+    Queue->X = (double *) UMF_malloc ((Int) d, sizeof (double)) ;
+    Queue->valid = 0 ;
+
+#ifndef NPOSIX
+    if (Queue->B && Queue->X)
+    {
+	if (pthread_mutex_init (&(Queue->lock), NULL) != 0)
+	{
+	    (void) UMF_free ((void *) Queue->X) ;
+	    Queue->X = (double *) NULL ;
+	}
+	else if (pthread_cond_init (&(Queue->finished), NULL) != 0)
+	{
+	    (void) pthread_mutex_destroy (&(Queue->lock)) ;
+	    (void) UMF_free ((void *) Queue->X) ;
+	    Queue->X = (double *) NULL ;
+	}
+    }
+#endif
+
+    if (!Queue->B || !Queue->X)
+    {
+	(void) UMF_free ((void *) Queue->B) ;
+	(void) UMF_free ((void *) Queue->X) ;
+	(void) UMF_free ((void *) Queue) ;
+	return (UMFPACK_ERROR_out_of_memory) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* initialize the Queue object */
+    /* ---------------------------------------------------------------------- */
+
+    Queue->sys = sys ;
+    Queue->n = n ;
+    Queue->max_nrhs = max_nrhs ;
+    Queue->busy = FALSE ;
+    Queue->Ap = Ap ;
+    Queue->Ai = Ai ;
+    Queue->Ax = Ax ;
+#ifdef COMPLEX
+    Queue->Az = Az ;
+#else
+    Queue->Az = (double *) NULL ;
+#endif
+    Queue->Numeric = NumericHandle ;
+    Queue->head = (QueueRequest *) NULL ;
+    Queue->tail = (QueueRequest *) NULL ;
+
+    /* keep a copy of Control (or of the defaults, if Control is NULL) */
+    if (Control != (double *) NULL)
+    {
+	for (i = 0 ; i < UMFPACK_CONTROL ; i++)
+	{
+	    Queue->Control [i] = Control [i] ;
+	}
+    }
+    else
+    {
+	UMFPACK_defaults (Queue->Control) ;
+    }
+
+    Queue->valid = QUEUE_VALID ;
+    *QueueHandle = (void *) Queue ;
+    return (UMFPACK_OK) ;
+}
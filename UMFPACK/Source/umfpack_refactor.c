@@ -0,0 +1,189 @@
+/* ========================================================================== */
+/* === UMFPACK_refactor ===================================================== */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    User-callable.  Recomputes the LU factors of a matrix with the same
+    pattern as a prior call to UMFPACK_numeric, reusing its pivot sequence if
+    that sequence is still numerically acceptable.  Otherwise, the matrix is
+    factorized from scratch with UMFPACK_renumeric.  See umfpack_refactor.h
+    for a description.
+
+    Dynamic memory allocation:  the first call for a given Numeric object
+    allocates 7 objects (held in the Numeric object and free'd by
+    UMFPACK_free_numeric) for the map used by UMF_refactor.  Workspace of size
+    n Entry's, n doubles, and 2*n integers is allocated and free'd on each
+    call.  If the pivot sequence cannot be reused, the Numeric object is
+    free'd (except for its memory block, which is recycled) and a new one is
+    allocated by UMFPACK_renumeric.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_symbolic.h"
+#include "umf_valid_numeric.h"
+#include "umf_refactor.h"
+
+GLOBAL Int UMFPACK_refactor
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    void *SymbolicHandle,
+    void **NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO]
+)
+{
+
+    /* ---------------------------------------------------------------------- */
+    /* local variables */
+    /* ---------------------------------------------------------------------- */
+
+    double Info2 [UMFPACK_INFO], stats [2] ;
+    double *Info ;
+    NumericType *Numeric ;
+    SymbolicType *Symbolic ;
+    Int n, i, status ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the amount of time used by the process so far */
+    /* ---------------------------------------------------------------------- */
+
+    umfpack_tic (stats) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* initialize and check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (User_Info != (double *) NULL)
+    {
+	/* return Info in user's array */
+	Info = User_Info ;
+	/* clear the parts of Info that are set by UMFPACK_numeric */
+	for (i = UMFPACK_NUMERIC_SIZE ; i <= UMFPACK_MAX_FRONT_NCOLS ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+	for (i = UMFPACK_NUMERIC_DEFRAG ; i < UMFPACK_IR_TAKEN ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+	Info [UMFPACK_REFACTORED] = EMPTY ;
+	Info [UMFPACK_NUMERIC_DEFRAG_TIME] = EMPTY ;
+    }
+    else
+    {
+	/* no Info array passed - use local one instead */
+	Info = Info2 ;
+	for (i = 0 ; i < UMFPACK_INFO ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+    }
+
+    Symbolic = (SymbolicType *) SymbolicHandle ;
+    if (!UMF_valid_symbolic (Symbolic))
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_Symbolic_object ;
+	return (UMFPACK_ERROR_invalid_Symbolic_object) ;
+    }
+
+    if (!Ap || !Ai || !Ax || !NumericHandle)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_argument_missing ;
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+
+    Numeric = (NumericType *) (*NumericHandle) ;
+    if (!UMF_valid_numeric (Numeric) || Numeric->n_row != Symbolic->n_row
+	|| Numeric->n_col != Symbolic->n_col)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_Numeric_object ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    n = Numeric->n_row ;
+    Info [UMFPACK_NROW] = Numeric->n_row ;
+    Info [UMFPACK_NCOL] = Numeric->n_col ;
+    Info [UMFPACK_SIZE_OF_UNIT] = (double) (sizeof (Unit)) ;
+    Info [UMFPACK_NZ] = Ap [Numeric->n_col] ;
+
+    if (AMD_valid (Numeric->n_row, Numeric->n_col, Ap, Ai) != AMD_OK)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_matrix ;
+	return (UMFPACK_ERROR_invalid_matrix) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* refactorize with the prior pivot sequence, if possible */
+    /* ---------------------------------------------------------------------- */
+
+    if (!UMF_refactor (Ap, Ai, Ax,
+#ifdef COMPLEX
+	Az,
+#endif
+	Numeric, Symbolic->prefer_diagonal))
+    {
+	/* The pivot sequence is no longer acceptable (or the prior
+	 * factorization was singular, or there was not enough memory for the
+	 * map).  The values in Numeric are no longer valid, so factorize the
+	 * matrix from scratch with a new pivot sequence, recycling the memory
+	 * of the prior Numeric object. */
+	DEBUGm4 (("refactor failed, calling renumeric\n")) ;
+	status = UMFPACK_renumeric (Ap, Ai, Ax,
+#ifdef COMPLEX
+	    Az,
+#endif
+	    SymbolicHandle, NumericHandle, Control, User_Info) ;
+	if (User_Info != (double *) NULL)
+	{
+	    User_Info [UMFPACK_REFACTORED] = 0 ;
+	}
+	return (status) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* report the results */
+    /* ---------------------------------------------------------------------- */
+
+    status = UMFPACK_OK ;
+    if (SCALAR_IS_ZERO (Numeric->rcond))
+    {
+	/* D has no zeros, but min (D) / max (D) has underflowed */
+	status = UMFPACK_WARNING_singular_matrix ;
+    }
+
+    Info [UMFPACK_STATUS] = status ;
+    Info [UMFPACK_REFACTORED] = 1 ;
+    Info [UMFPACK_NUMERIC_SIZE] = Numeric->size ;
+    Info [UMFPACK_FLOPS] = Numeric->flops ;
+    Info [UMFPACK_LNZ] = (double) Numeric->lnz + n ;
+    Info [UMFPACK_UNZ] = (double) Numeric->unz + Numeric->nnzpiv ;
+    Info [UMFPACK_LU_ENTRIES] = Numeric->nLentries + Numeric->nUentries +
+	    Numeric->npiv ;
+    Info [UMFPACK_UDIAG_NZ] = Numeric->nnzpiv ;
+    Info [UMFPACK_RSMIN] = Numeric->rsmin ;
+    Info [UMFPACK_RSMAX] = Numeric->rsmax ;
+    Info [UMFPACK_WAS_SCALED] = Numeric->scale ;
+    Info [UMFPACK_UMIN] = Numeric->min_udiag ;
+    Info [UMFPACK_UMAX] = Numeric->max_udiag ;
+    Info [UMFPACK_RCOND] = Numeric->rcond ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the time used by UMFPACK_refactor */
+    /* ---------------------------------------------------------------------- */
+
+    umfpack_toc (stats) ;
+    Info [UMFPACK_NUMERIC_WALLTIME] = stats [0] ;
+    Info [UMFPACK_NUMERIC_TIME] = stats [1] ;
+
+    return (status) ;
+}
@@ -470,6 +470,8 @@ GLOBAL void UMFPACK_report_info
 	Info [UMFPACK_ALL_UNZ]) ;
     PRINT_INFO ("    number of small entries dropped                %.0f\n",
 	Info [UMFPACK_NZDROPPED]) ;
+    PRINT_INFO ("    prior pivot sequence reused (refactor):        %.0f\n",
+	Info [UMFPACK_REFACTORED]) ;
     PRINT_INFO ("    nonzeros on diagonal of U:                     %.0f\n",
 	Info [UMFPACK_UDIAG_NZ]) ;
     PRINT_INFO ("    min abs. value on diagonal of U:               %.2e\n",
@@ -488,6 +490,8 @@ GLOBAL void UMFPACK_report_info
 	Info [UMFPACK_NUMERIC_REALLOC]) ;
     PRINT_INFO ("    costly numeric factorization reallocations:    %.0f\n",
 	Info [UMFPACK_NUMERIC_COSTLY_REALLOC]) ;
+    PRINT_INFO ("    realloc and defragmentation time (sec):        %.2f\n",
+	Info [UMFPACK_NUMERIC_DEFRAG_TIME]) ;
     PRINT_INFO ("    numeric factorization wallclock time (sec):    %.2f\n",
 	twnum) ;
 
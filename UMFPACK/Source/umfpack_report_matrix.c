@@ -28,7 +28,7 @@ GLOBAL Int UMFPACK_report_matrix
     const double Control [UMFPACK_CONTROL]
 )
 {
-    Entry a ;
+    XEntry a ;
     Int prl, i, k, length, ilast, p, nz, prl1, p1, p2, n, n_i, do_values ;
     char *vector_kind, *index_kind ;
 #ifdef COMPLEX
@@ -28,7 +28,7 @@ GLOBAL Int UMFPACK_report_triplet
     const double Control [UMFPACK_CONTROL]
 )
 {
-    Entry t ;
+    XEntry t ;
     Int prl, prl1, k, i, j, do_values ;
 #ifdef COMPLEX
     Int split = SPLIT (Tz) ;
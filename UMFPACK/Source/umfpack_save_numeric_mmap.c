@@ -0,0 +1,175 @@
+/* ========================================================================== */
+/* === UMFPACK_save_numeric_mmap ============================================ */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* Copyright (c) 2005-2012 by Timothy A. Davis, http://www.suitesparse.com.   */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/*
+    User-callable.  Saves a Numeric object to a file in which each array
+    starts on a page boundary, so that it can later be mapped into memory and
+    used in place by umfpack_*_load_numeric_mmap.  See NumericFileHeader in
+    umf_internal.h for the file layout.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_numeric.h"
+
+/* pad the file with zeros up to the given offset, then write the object */
+#define WRITE(object,type,n,k) \
+{ \
+    if (n > 0) \
+    { \
+	ASSERT (object != (type *) NULL) ; \
+	while (pos < Header.offset [k]) \
+	{ \
+	    len = (size_t) MIN (Header.offset [k] - pos, UMF_MMAP_ALIGN) ; \
+	    if (fwrite (zeros, 1, len, f) != len) \
+	    { \
+		fclose (f) ; \
+		return (UMFPACK_ERROR_file_IO) ; \
+	    } \
+	    pos += len ; \
+	} \
+	if (fwrite (object, sizeof (type), n, f) != (size_t) n) \
+	{ \
+	    fclose (f) ; \
+	    return (UMFPACK_ERROR_file_IO) ; \
+	} \
+	pos += ((SuiteSparse_long) n) * sizeof (type) ; \
+    } \
+}
+
+/* ========================================================================== */
+/* === UMFPACK_save_numeric_mmap ============================================ */
+/* ========================================================================== */
+
+GLOBAL Int UMFPACK_save_numeric_mmap
+(
+    void *NumericHandle,
+    char *user_filename
+)
+{
+    static char zeros [UMF_MMAP_ALIGN] ;
+    NumericFileHeader Header ;
+    NumericType *Numeric ;
+    SuiteSparse_long pos, nbytes [UMF_MMAP_NOBJECTS] ;
+    Int k, n_inner, npiv, nrs, nup ;
+    size_t len ;
+    char *filename ;
+    FILE *f ;
+
+    /* get the Numeric object */
+    Numeric = (NumericType *) NumericHandle ;
+
+    /* make sure the Numeric object is valid */
+    if (!UMF_valid_numeric (Numeric))
+    {
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* determine the file layout */
+    /* ---------------------------------------------------------------------- */
+
+    /* same objects and sizes as UMFPACK_save_numeric */
+    n_inner = MIN (Numeric->n_row, Numeric->n_col) ;
+    npiv = Numeric->npiv ;
+    nrs = (Numeric->scale != UMFPACK_SCALE_NONE) ? Numeric->n_row : 0 ;
+    nup = (Numeric->ulen > 0) ? (Numeric->ulen + 1) : 0 ;
+
+    nbytes [0]  = sizeof (NumericType) ;
+    nbytes [1]  = ((SuiteSparse_long) n_inner+1) * sizeof (Entry) ;
+    nbytes [2]  = ((SuiteSparse_long) Numeric->n_row+1) * sizeof (Int) ;
+    nbytes [3]  = ((SuiteSparse_long) Numeric->n_col+1) * sizeof (Int) ;
+    for (k = 4 ; k <= 9 ; k++)
+    {
+	/* Lpos, Lilen, Lip, Upos, Uilen, and Uip */
+	nbytes [k] = ((SuiteSparse_long) npiv+1) * sizeof (Int) ;
+    }
+    nbytes [10] = ((SuiteSparse_long) nrs) * sizeof (double) ;
+    nbytes [11] = ((SuiteSparse_long) nup) * sizeof (Int) ;
+    nbytes [12] = ((SuiteSparse_long) Numeric->size) * sizeof (Unit) ;
+
+    memset (&Header, 0, sizeof (NumericFileHeader)) ;
+    strncpy (Header.id, UMF_MMAP_ID, 16) ;
+    Header.valid = NUMERIC_VALID ;
+    Header.sizeof_numeric = sizeof (NumericType) ;
+    Header.sizeof_entry = sizeof (Entry) ;
+    Header.sizeof_unit = sizeof (Unit) ;
+    Header.sizeof_int = sizeof (Int) ;
+    Header.align = UMF_MMAP_ALIGN ;
+
+    pos = sizeof (NumericFileHeader) ;
+    for (k = 0 ; k < UMF_MMAP_NOBJECTS ; k++)
+    {
+	if (nbytes [k] == 0)
+	{
+	    Header.offset [k] = EMPTY ;
+	}
+	else
+	{
+	    pos = UMF_MMAP_ROUNDUP (pos) ;
+	    Header.offset [k] = pos ;
+	    pos += nbytes [k] ;
+	}
+    }
+    Header.file_size = pos ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the filename, or use the default name if filename is NULL */
+    /* ---------------------------------------------------------------------- */
+
+    if (user_filename == (char *) NULL)
+    {
+	filename = "numeric.umf" ;
+    }
+    else
+    {
+	filename = user_filename ;
+    }
+    f = fopen (filename, "wb") ;
+    if (!f)
+    {
+	return (UMFPACK_ERROR_file_IO) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write the Numeric object to the file, in binary */
+    /* ---------------------------------------------------------------------- */
+
+    if (fwrite (&Header, sizeof (NumericFileHeader), 1, f) != 1)
+    {
+	fclose (f) ;
+	return (UMFPACK_ERROR_file_IO) ;
+    }
+    pos = sizeof (NumericFileHeader) ;
+
+    WRITE (Numeric,           NumericType, 1,             0) ;
+    WRITE (Numeric->D,        Entry,       n_inner+1,     1) ;
+    WRITE (Numeric->Rperm,    Int,         Numeric->n_row+1, 2) ;
+    WRITE (Numeric->Cperm,    Int,         Numeric->n_col+1, 3) ;
+    WRITE (Numeric->Lpos,     Int,         npiv+1,        4) ;
+    WRITE (Numeric->Lilen,    Int,         npiv+1,        5) ;
+    WRITE (Numeric->Lip,      Int,         npiv+1,        6) ;
+    WRITE (Numeric->Upos,     Int,         npiv+1,        7) ;
+    WRITE (Numeric->Uilen,    Int,         npiv+1,        8) ;
+    WRITE (Numeric->Uip,      Int,         npiv+1,        9) ;
+    WRITE (Numeric->Rs,       double,      nrs,           10) ;
+    WRITE (Numeric->Upattern, Int,         nup,           11) ;
+    /* It is possible that some parts of Numeric->Memory are
+       unitialized and unused; this is OK, but it can generate
+       a valgrind warning. */
+    WRITE (Numeric->Memory,   Unit,        Numeric->size, 12) ;
+    ASSERT (pos == Header.file_size) ;
+
+    /* close the file */
+    if (fclose (f) != 0)
+    {
+	return (UMFPACK_ERROR_file_IO) ;
+    }
+
+    return (UMFPACK_OK) ;
+}
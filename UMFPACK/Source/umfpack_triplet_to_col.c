@@ -25,8 +25,13 @@
 	If numerical values are present, then one (two for complex version)
 	workspace of size (nz+1)*sizeof(double) is allocated via UMF_malloc.
 	Next, 4 calls to UMF_malloc are made to obtain workspace of size
-	((nz+1) + (n_row+1) + n_row + MAX (n_row,n_col)) * sizeof(Int).  All of
-	this workspace (4 to 6 objects) are free'd via UMF_free on return.
+	((nz+1) + (n_row+1) + n_row + t*MAX (n_row,n_col) + 2*t+2) * sizeof(Int),
+	where t is the number of threads used.  All of this workspace (4 to 6
+	objects) are free'd via UMF_free on return.
+
+	If compiled with OpenMP, t is at most omp_get_max_threads ( ), with at
+	least UMF_TRIPLET_CHUNK triplets per thread, and t*MAX (n_row,n_col) is
+	at most nz.  Otherwise, or if there is not enough memory for t > 1, t is 1.
 
 	For the complex version, additional space is allocated.
 
@@ -37,6 +42,9 @@
 #include "umf_malloc.h"
 #include "umf_free.h"
 #include "umf_triplet.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifndef NDEBUG
 PRIVATE Int init_count ;
@@ -69,7 +77,8 @@ GLOBAL Int UMFPACK_triplet_to_col
     /* local variables */
     /* ---------------------------------------------------------------------- */
 
-    Int *RowCount, *Rp, *Rj, *W, nn, do_values, do_map, *Map2, status ;
+    Int *RowCount, *Rp, *Rj, *W, nn, do_values, do_map, *Map2, status,
+	nthreads ;
     double *Rx ;
 #ifdef COMPLEX
     double *Rz ;
@@ -102,6 +111,14 @@ GLOBAL Int UMFPACK_triplet_to_col
 
     nn = MAX (n_row, n_col) ;
 
+    /* determine the number of threads to use */
+    nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = MAX (1, MIN (omp_get_max_threads ( ), nz / UMF_TRIPLET_CHUNK)) ;
+    /* the counts of all threads take no more space than Rj */
+    nthreads = MAX (1, MIN (nthreads, nz / nn)) ;
+#endif
+
     /* ---------------------------------------------------------------------- */
     /* allocate workspace */
     /* ---------------------------------------------------------------------- */
@@ -152,7 +169,13 @@ GLOBAL Int UMFPACK_triplet_to_col
     Rj = (Int *) UMF_malloc (nz+1, sizeof (Int)) ;
     Rp = (Int *) UMF_malloc (n_row+1, sizeof (Int)) ;
     RowCount = (Int *) UMF_malloc (n_row, sizeof (Int)) ;
-    W = (Int *) UMF_malloc (nn, sizeof (Int)) ;
+    W = (Int *) UMF_malloc (nthreads * nn + 2 * (nthreads+1), sizeof (Int)) ;
+    if (!W && nthreads > 1)
+    {
+	/* not enough memory for the counts of each thread */
+	nthreads = 1 ;
+	W = (Int *) UMF_malloc (nn + 4, sizeof (Int)) ;
+    }
     if (!Rj || !Rp || !RowCount || !W)
     {
 	DEBUGm4 (("out of memory: triplet work (int)\n")) ;
@@ -178,7 +201,7 @@ GLOBAL Int UMFPACK_triplet_to_col
 	if (do_values)
 	{
 	    status = UMF_triplet_map_x (n_row, n_col, nz, Ti, Tj, Ap, Ai, Rp,
-		Rj, W, RowCount, Tx, Ax, Rx
+		Rj, W, RowCount, nthreads, Tx, Ax, Rx
 #ifdef COMPLEX
 		, Tz, Az, Rz
 #endif
@@ -187,7 +210,7 @@ GLOBAL Int UMFPACK_triplet_to_col
 	else
 	{
 	    status = UMF_triplet_map_nox (n_row, n_col, nz, Ti, Tj, Ap, Ai, Rp,
-		Rj, W, RowCount, Map, Map2) ;
+		Rj, W, RowCount, nthreads, Map, Map2) ;
 	}
     }
     else
@@ -195,7 +218,7 @@ GLOBAL Int UMFPACK_triplet_to_col
 	if (do_values)
 	{
 	    status = UMF_triplet_nomap_x (n_row, n_col, nz, Ti, Tj, Ap, Ai, Rp,
-		Rj, W, RowCount , Tx, Ax, Rx
+		Rj, W, RowCount, nthreads, Tx, Ax, Rx
 #ifdef COMPLEX
 		, Tz, Az, Rz
 #endif
@@ -204,7 +227,7 @@ GLOBAL Int UMFPACK_triplet_to_col
 	else
 	{
 	    status = UMF_triplet_nomap_nox (n_row, n_col, nz, Ti, Tj, Ap, Ai,
-		Rp, Rj, W, RowCount) ;
+		Rp, Rj, W, RowCount, nthreads) ;
 	}
     }
 
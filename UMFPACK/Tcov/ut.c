@@ -30,6 +30,10 @@
 #include "umf_free.h"
 #include "umf_malloc.h"
 #include "umf_cholmod.h"
+#include "umf_triplet.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /*
 #if defined (UMF_MALLOC_COUNT) || !defined (NDEBUG)
@@ -912,6 +916,187 @@ static double do_solvers
 	maxrnorm = MAX (rnorm, maxrnorm) ;
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* msolve Ax=b and A'x=b, one right-hand side */
+    /* ---------------------------------------------------------------------- */
+
+    for (s1 = 0 ; s1 <= 1 ; s1++)
+    {
+	s2 = (s1 == 0) ? UMFPACK_A : UMFPACK_At ;
+	if (prl >= 2) printf ("2: do solve: sys "ID" (msolve) \n", s2) ;
+	status = UMFPACK_msolve (s2, Ap, Ai, CARG(Ax,Az), 1, CARG(x,xz), CARG(b,bz), Numeric, Control, Info) ;
+	if (status == UMFPACK_WARNING_singular_matrix)
+	{
+	    if (prl >= 2) printf ("msolve singular\n") ;
+	}
+	else if (status != UMFPACK_OK)
+	{
+	    dump_mat ("A", n, n, Ap, Ai, CARG(Ax,Az)) ;
+	    error ("msolve failure\n", 0.) ;
+	}
+	else
+	{
+	    rnorm = resid (n, Ap, Ai, Ax, Az, x, xz, b, bz, r, rz, s2, noP, noQ, Wx) ;
+	    if (prl >= 2) printf ("4: rnorm msolve is %g\n", rnorm) ;
+	    if (check_tol && rnorm > TOL)
+	    {
+		dump_mat ("A", n, n, Ap, Ai, CARG(Ax,Az)) ;
+		error ("msolve inaccurate %g\n", rnorm) ;
+	    }
+	    maxrnorm = MAX (rnorm, maxrnorm) ;
+	}
+    }
+
+    /* no right-hand sides */
+    status = UMFPACK_msolve (UMFPACK_A, Ap, Ai, CARG(Ax,Az), 0, CARG(x,xz), CARG(b,bz), Numeric, Control, Info) ;
+    if (status != UMFPACK_OK && status != UMFPACK_WARNING_singular_matrix) error ("msolve nrhs=0 failure\n", 0.) ;
+    status = UMFPACK_msolve (UMFPACK_A, Ap, Ai, CARG(Ax,Az), -1, CARG(x,xz), CARG(b,bz), Numeric, Control, Info) ;
+    if (status != UMFPACK_ERROR_n_nonpositive) error ("msolve nrhs=-1 not detected\n", 0.) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* msolve with 37 right-hand sides must match solve, column by column */
+    /* ---------------------------------------------------------------------- */
+
+    /* 37 = two full blocks of 16 plus a partial block of 5 */
+    {
+	double *Bm, *Bmz, *Xm, *Xmz, *Xc, *Xcz, *bj, *bjz, *xj, *xjz ;
+	Int j, k, cs, ir, nrhs = 37, statm, statc, sp ;
+
+#ifdef COMPLEX
+	sp = split ;
+	cs = sp ? n : 2*n ;
+#else
+	sp = FALSE ;
+	cs = n ;
+#endif
+	Bm = (double *) malloc ((2*n*nrhs) * sizeof (double)) ;	/* [ */
+	Xm = (double *) calloc ( 2*n*nrhs,   sizeof (double)) ;	/* [ */
+	Xc = (double *) calloc ( 2*n*nrhs,   sizeof (double)) ;	/* [ */
+	if (!Bm || !Xm || !Xc) error ("out of memory (msolve)", 0.) ;
+	for (k = 0 ; k < 2*n*nrhs ; k++)
+	{
+	    Bm [k] = xrand ( ) - 0.5 ;
+	}
+	Bmz = sp ? (Bm + n*nrhs) : DNULL ;
+	Xmz = sp ? (Xm + n*nrhs) : DNULL ;
+	Xcz = sp ? (Xc + n*nrhs) : DNULL ;
+
+	for (ir = 0 ; ir <= 2 ; ir += 2)
+	{
+	    /* without and with iterative refinement */
+	    if (Control)
+	    {
+		for (i = 0 ; i < UMFPACK_CONTROL ; i++) Con [i] = Control [i] ;
+	    }
+	    else
+	    {
+		UMFPACK_defaults (Con) ;
+	    }
+	    Con [UMFPACK_PRL] = prl ;
+	    Con [UMFPACK_IRSTEP] = ir ;
+
+	    for (s1 = 0 ; s1 <= 1 ; s1++)
+	    {
+		s2 = (s1 == 0) ? UMFPACK_A : UMFPACK_At ;
+		if (prl >= 2) printf ("2: msolve sys "ID" nrhs "ID" irstep "ID"\n", s2, nrhs, ir) ;
+		statm = UMFPACK_msolve (s2, Ap, Ai, CARG(Ax,Az), nrhs, CARG(Xm,Xmz), CARG(Bm,Bmz), Numeric, Con, Info) ;
+		if (statm != UMFPACK_OK && statm != UMFPACK_WARNING_singular_matrix) error ("msolve nrhs=37 failure\n", 0.) ;
+		for (j = 0 ; j < nrhs ; j++)
+		{
+		    bj  = Bm + j*cs ;
+		    xj  = Xc + j*cs ;
+		    bjz = sp ? (Bmz + j*n) : DNULL ;
+		    xjz = sp ? (Xcz + j*n) : DNULL ;
+		    statc = UMFPACK_solve (s2, Ap, Ai, CARG(Ax,Az), CARG(xj,xjz), CARG(bj,bjz), Numeric, Con, Info) ;
+		    if (statc != statm) error ("msolve status differs from solve\n", 0.) ;
+		}
+		if (memcmp (Xm, Xc, (cs*nrhs) * sizeof (double)) != 0
+		|| (sp && memcmp (Xmz, Xcz, (n*nrhs) * sizeof (double)) != 0))
+		{
+		    error ("msolve nrhs=37 differs from solve\n", 0.) ;
+		}
+	    }
+	}
+
+	free (Xc) ;	/* ] */
+	free (Xm) ;	/* ] */
+	free (Bm) ;	/* ] */
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* qsolve Ax=b, several right-hand sides at once from several threads */
+    /* ---------------------------------------------------------------------- */
+
+    {
+	void *Queue, *Queue2 ;
+	double *Xq, Infoq [UMFPACK_INFO] ;
+	Int k, nq = 8, statq [8] ;
+
+	status = UMFPACK_queue (UMFPACK_A, Ap, Ai, CARG(Ax,Az), 3, (void *) NULL, &Queue2, Control) ;
+	if (status != UMFPACK_ERROR_invalid_Numeric_object || Queue2) error ("queue bad Numeric", 0.) ;
+	status = UMFPACK_queue (UMFPACK_A, Ap, Ai, CARG(Ax,Az), 3, Numeric, (void **) NULL, Control) ;
+	if (status != UMFPACK_ERROR_argument_missing) error ("queue no handle", 0.) ;
+	status = UMFPACK_queue (UMFPACK_A, Ap, Ai, CARG(Ax,Az), 3, Numeric, &Queue, Control) ;
+	if (status != UMFPACK_OK) error ("queue failure", 0.) ;
+	status = UMFPACK_queue (UMFPACK_A, Ap, Ai, CARG(Ax,Az), 0, Numeric, &Queue2, (double *) NULL) ;
+	if (status != UMFPACK_OK) error ("queue default failure", 0.) ;
+
+	Xq = (double *) malloc (2*n*nq * sizeof (double)) ;	/* [ */
+	if (!Xq) error ("out of memory (qsolve)", 0.) ;
+
+#ifdef _OPENMP
+	#pragma omp parallel for num_threads(4) schedule(static,1)
+#endif
+	for (k = 0 ; k < nq ; k++)
+	{
+	    double *xk = Xq + 2*n*k ;
+	    statq [k] = UMFPACK_qsolve (CARG(xk, split ? (xk+n) : DNULL), CARG(b,bz), Queue, (double *) NULL) ;
+	}
+
+	for (k = 0 ; k < nq ; k++)
+	{
+	    double *xk = Xq + 2*n*k ;
+	    if (statq [k] == UMFPACK_WARNING_singular_matrix)
+	    {
+		if (prl >= 2) printf ("qsolve singular\n") ;
+	    }
+	    else if (statq [k] != UMFPACK_OK)
+	    {
+		error ("qsolve failure\n", (double) statq [k]) ;
+	    }
+	    else
+	    {
+		rnorm = resid (n, Ap, Ai, Ax, Az, xk, split ? (xk+n) : DNULL, b, bz, r, rz, UMFPACK_A, noP, noQ, Wx) ;
+		if (prl >= 2) printf ("4: rnorm qsolve is %g\n", rnorm) ;
+		if (check_tol && rnorm > TOL)
+		{
+		    error ("qsolve inaccurate %g\n", rnorm) ;
+		}
+		maxrnorm = MAX (rnorm, maxrnorm) ;
+	    }
+	}
+
+	/* one right-hand side on its own, with Info */
+	status = UMFPACK_qsolve (CARG(x,xz), CARG(b,bz), Queue2, Infoq) ;
+	if (status != statq [0] || Infoq [UMFPACK_STATUS] != status) error ("qsolve Info status", 0.) ;
+	if (Infoq [UMFPACK_QSOLVE_NRHS] != 1) error ("qsolve Info nrhs", 0.) ;
+
+	/* error handling */
+	status = UMFPACK_qsolve (CARG(DNULL,DNULL), CARG(b,bz), Queue, Infoq) ;
+	if (status != UMFPACK_ERROR_argument_missing || Infoq [UMFPACK_STATUS] != status) error ("qsolve no x", 0.) ;
+	status = UMFPACK_qsolve (CARG(x,xz), CARG(b,bz), (void *) NULL, Infoq) ;
+	if (status != UMFPACK_ERROR_invalid_Numeric_object) error ("qsolve no Queue", 0.) ;
+	status = UMFPACK_qsolve (CARG(x,xz), CARG(b,bz), Numeric, (double *) NULL) ;
+	if (status != UMFPACK_ERROR_invalid_Numeric_object) error ("qsolve bad Queue", 0.) ;
+
+	free (Xq) ;	/* ] */
+	UMFPACK_free_queue (&Queue) ;
+	UMFPACK_free_queue (&Queue2) ;
+	if (Queue || Queue2) error ("free queue", 0.) ;
+	UMFPACK_free_queue (&Queue) ;
+	UMFPACK_free_queue ((void **) NULL) ;
+    }
+
     if (Control) Control [UMFPACK_IRSTEP] = orig ;
 
     /* ---------------------------------------------------------------------- */
@@ -2061,6 +2246,58 @@ static double do_symnum
 
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* test save and load with a mapped file */
+    /* ---------------------------------------------------------------------- */
+
+    /* the rest of this test uses the mapped Numeric object */
+    status = UMFPACK_save_numeric_mmap (Numeric, "nm.umf") ;
+    if (status != UMFPACK_OK)
+    {
+	error ("save numeric mmap failed\n", 0.) ;
+    }
+    UMFPACK_free_numeric (&Numeric) ;
+    status = UMFPACK_load_numeric_mmap (&Numeric, "n.umf") ;
+    if (status != UMFPACK_ERROR_invalid_Numeric_object || Numeric)
+    {
+	error ("load numeric mmap of wrong format should fail\n", 0.) ;
+    }
+    status = UMFPACK_load_numeric_mmap (&Numeric, "file_not_found") ;
+    if (status != UMFPACK_ERROR_file_IO || Numeric)
+    {
+	error ("load numeric mmap of missing file should fail\n", 0.) ;
+    }
+    if (n < 15)
+    {
+	int umf_fail_save [3] ;
+	umf_fail_save [0] = umf_fail ;
+	umf_fail_save [1] = umf_fail_lo ;
+	umf_fail_save [2] = umf_fail_hi ;
+	umf_fail = 1 ;
+	umf_fail_lo = 0 ;
+	umf_fail_hi = 0 ;
+	status = UMFPACK_load_numeric_mmap (&Numeric, "nm.umf") ;
+	if (status != UMFPACK_ERROR_out_of_memory || Numeric)
+	{
+	    error ("load numeric mmap should have failed\n", 0.) ;
+	}
+	umf_fail    = umf_fail_save [0] ;
+	umf_fail_lo = umf_fail_save [1] ;
+	umf_fail_hi = umf_fail_save [2] ;
+    }
+    status = UMFPACK_load_numeric_mmap (&Numeric, "nm.umf") ;
+    if (status != UMFPACK_OK)
+    {
+	error ("load numeric mmap failed\n", 0.) ;
+    }
+    Num = (NumericType *) Numeric ;
+    if (Num->Mapping == (void *) NULL
+	|| (char *) Num->Memory < (char *) Num->Mapping
+	|| ((char *) Num->Memory - (char *) Num->Mapping) % UMF_MMAP_ALIGN != 0)
+    {
+	error ("Numeric object not mapped\n", 0.) ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* get the LU factorization */
     /* ---------------------------------------------------------------------- */
@@ -3506,6 +3743,125 @@ static void test_col
     free (Ci) ;		/* ] */
 }
 
+
+/* ========================================================================== */
+/* test_threads */
+/* ========================================================================== */
+
+/* Convert a large triplet matrix, transpose it, and analyze it, with one
+ * thread and with several.  The results must be identical. */
+
+static void test_threads (void)
+{
+    Int *Ti, *Tj, *Ap [2], *Ai [2], *Map [2], *Rp [2], *Ri [2], *P, *Q,
+	n, nz, k, t, s, nnz, nthreads ;
+    double *Tx, *Tz, *Ax [2], *Az [2], *Rx [2], *Rz [2], Info [2][UMFPACK_INFO] ;
+    void *Symbolic ;
+
+    printf ("\n\n===== test triplet->col and transpose with threads\n") ;
+
+    nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads ( ) ;
+#endif
+
+    n = 2000 ;
+    nz = 4 * UMF_TRIPLET_CHUNK + 1000 ;
+    Ti = (Int *) malloc (nz * sizeof (Int)) ;			/* [ */
+    Tj = (Int *) malloc (nz * sizeof (Int)) ;			/* [ */
+    Tx = (double *) malloc (2 * nz * sizeof (double)) ;	/* [ */
+    P = (Int *) malloc (n * sizeof (Int)) ;			/* [ */
+    Q = (Int *) malloc (n * sizeof (Int)) ;			/* [ */
+    if (!Ti || !Tj || !Tx || !P || !Q) error ("out of memory (threads)",0.) ;
+    Tz = Tx + nz ;
+
+    /* a random matrix with a full diagonal and many duplicates */
+    for (k = 0 ; k < nz ; k++)
+    {
+	Ti [k] = irand (n) ;
+	Tj [k] = (k % 10 == 0) ? Ti [k] : irand (n) ;
+	Tx [k] = xrand ( ) ;
+	Tz [k] = xrand ( ) ;
+    }
+    for (k = 1 ; k < nz ; k += 5)
+    {
+	Ti [k] = Ti [k-1] ;
+	Tj [k] = Tj [k-1] ;
+    }
+    randperm (n, P) ;
+    randperm (n, Q) ;
+
+    for (t = 0 ; t < 2 ; t++)
+    {
+	Ap [t] = (Int *) malloc ((n+1) * sizeof (Int)) ;	/* [ */
+	Ai [t] = (Int *) malloc (nz * sizeof (Int)) ;		/* [ */
+	Map [t] = (Int *) malloc (nz * sizeof (Int)) ;		/* [ */
+	Rp [t] = (Int *) malloc ((n+1) * sizeof (Int)) ;	/* [ */
+	Ri [t] = (Int *) malloc (nz * sizeof (Int)) ;		/* [ */
+	Ax [t] = (double *) malloc (2 * nz * sizeof (double)) ;	/* [ */
+	Rx [t] = (double *) malloc (2 * nz * sizeof (double)) ;	/* [ */
+	if (!Ap [t] || !Ai [t] || !Map [t] || !Rp [t] || !Ri [t] || !Ax [t]
+	    || !Rx [t]) error ("out of memory (threads)",0.) ;
+	Az [t] = Ax [t] + nz ;
+	Rz [t] = Rx [t] + nz ;
+
+#ifdef _OPENMP
+	omp_set_num_threads ((t == 0) ? 1 : 4) ;
+#endif
+	s = UMFPACK_triplet_to_col (n, n, nz, Ti, Tj, CARG(Tx,Tz), Ap [t], Ai [t], CARG(Ax [t],Az [t]), Map [t]) ;
+	if (s != UMFPACK_OK) error ("threads t->col",0.) ;
+	s = UMFPACK_transpose (n, n, Ap [t], Ai [t], CARG(Ax [t],Az [t]), P, Q, Rp [t], Ri [t], CARG(Rx [t],Rz [t]) C1ARG(1)) ;
+	if (s != UMFPACK_OK) error ("threads transpose",0.) ;
+	s = UMFPACK_symbolic (n, n, Ap [t], Ai [t], CARG(Ax [t],Az [t]), &Symbolic, DNULL, Info [t]) ;
+	if (s != UMFPACK_OK) error ("threads symbolic",0.) ;
+	UMFPACK_free_symbolic (&Symbolic) ;
+    }
+#ifdef _OPENMP
+    omp_set_num_threads (nthreads) ;
+#endif
+
+    nnz = Ap [0][n] ;
+    for (k = 0 ; k <= n ; k++)
+    {
+	if (Ap [0][k] != Ap [1][k] || Rp [0][k] != Rp [1][k]) error ("threads Ap",0.) ;
+    }
+    for (k = 0 ; k < nnz ; k++)
+    {
+	if (Ai [0][k] != Ai [1][k] || Ri [0][k] != Ri [1][k]) error ("threads Ai",0.) ;
+	if (Ax [0][k] != Ax [1][k] || Rx [0][k] != Rx [1][k]) error ("threads Ax",0.) ;
+#ifdef COMPLEX
+	if (Az [0][k] != Az [1][k] || Rz [0][k] != Rz [1][k]) error ("threads Az",0.) ;
+#endif
+    }
+    for (k = 0 ; k < nz ; k++)
+    {
+	if (Map [0][k] != Map [1][k]) error ("threads Map",0.) ;
+    }
+    if (Info [0][UMFPACK_LNZ_ESTIMATE] != Info [1][UMFPACK_LNZ_ESTIMATE] ||
+	Info [0][UMFPACK_FLOPS_ESTIMATE] != Info [1][UMFPACK_FLOPS_ESTIMATE])
+    {
+	error ("threads symbolic",0.) ;
+    }
+    printf ("threads: nz "ID" nnz "ID" lnz %g\n", nz, nnz,
+	Info [0][UMFPACK_LNZ_ESTIMATE]) ;
+
+    for (t = 0 ; t < 2 ; t++)
+    {
+	free (Rx [t]) ;		/* ] */
+	free (Ax [t]) ;		/* ] */
+	free (Ri [t]) ;		/* ] */
+	free (Rp [t]) ;		/* ] */
+	free (Map [t]) ;	/* ] */
+	free (Ai [t]) ;		/* ] */
+	free (Ap [t]) ;		/* ] */
+    }
+    free (Q) ;	/* ] */
+    free (P) ;	/* ] */
+    free (Tx) ;	/* ] */
+    free (Tj) ;	/* ] */
+    free (Ti) ;	/* ] */
+}
+
 /* ========================================================================== */
 /* matgen_compaction: generate a matrix to test umf_symbolic compaction */
 /* ========================================================================== */
@@ -4517,6 +4873,50 @@ static double do_file
     return (maxrnorm) ;
 }
 
+/* ========================================================================== */
+/* refactor_resid:  solve Ax=b with a Numeric object, return the residual */
+/* ========================================================================== */
+
+/* b is set to a random vector, and ||Ax-b|| / ||b|| is returned (max norm) */
+
+static double refactor_resid
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],	double Az [ ],
+    void *Numeric,
+    double Control [ ]
+)
+{
+    double *b, *bz, *x, *xz, *r, *rz, *Wx, bnorm, rnorm, Info [UMFPACK_INFO] ;
+    Int i, status ;
+
+    b  = (double *) malloc (8 * n * sizeof (double)) ;	/* [ */
+    if (!b) error ("out of memory (refactor_resid)", 0.) ;
+    bz = b  + n ;
+    x  = bz + n ;
+    xz = x  + n ;
+    r  = xz + n ;
+    rz = r  + n ;
+    Wx = rz + n ;	/* size 2*n */
+    bnorm = 0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+	b  [i] = xrand ( ) - 0.5 ;
+	bz [i] = xrand ( ) - 0.5 ;
+	bnorm = MAX (bnorm, SCALAR_ABS (b [i])) ;
+#ifdef COMPLEX
+	bnorm = MAX (bnorm, SCALAR_ABS (bz [i])) ;
+#endif
+    }
+    status = UMFPACK_solve (UMFPACK_A, Ap, Ai, CARG(Ax,Az), CARG(x,xz), CARG(b,bz), Numeric, Control, Info) ;
+    if (status != UMFPACK_OK) error ("refactor_resid solve", 0.) ;
+    rnorm = resid (n, Ap, Ai, Ax, Az, x, xz, b, bz, r, rz, UMFPACK_A, INULL, INULL, Wx) ;
+    free (b) ;		/* ] */
+    return (rnorm / bnorm) ;
+}
+
 /* ========================================================================== */
 /* main */
 /* ========================================================================== */
@@ -5131,6 +5531,242 @@ int main (int argc, char **argv)
     UMFPACK_report_info (Control, Info) ;
     UMFPACK_report_status (Control, s) ;
     if (s2 != UMFPACK_OK) error ("p1d",0.) ;
+
+    /* refactorize with the same values, then with A scaled by 2 */
+    {
+	double Mx2, Mz2, Exp2 ;
+	s = UMFPACK_get_determinant (CARG (&Mx, &Mz), &Exp, Numeric, Info) ;
+	if (s != UMFPACK_OK) error ("p1r det",0.) ;
+	s = UMFPACK_refactor (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	UMFPACK_report_status (Control, s) ;
+	UMFPACK_report_info (Control, Info) ;
+	if (!Numeric || s != UMFPACK_OK || Info [UMFPACK_REFACTORED] != 1) error ("p1r",0.) ;
+	for (i = 0 ; i < Ap [n_col] ; i++) Ax [i] *= 2 ;
+#ifdef COMPLEX
+	for (i = 0 ; i < Ap [n_col] ; i++) Az [i] *= 2 ;
+#endif
+	s = UMFPACK_refactor (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, DNULL) ;
+	if (!Numeric || s != UMFPACK_OK) error ("p1r2",0.) ;
+	for (i = 0 ; i < Ap [n_col] ; i++) Ax [i] /= 2 ;
+#ifdef COMPLEX
+	for (i = 0 ; i < Ap [n_col] ; i++) Az [i] /= 2 ;
+#endif
+	s = UMFPACK_get_determinant (CARG (&Mx2, &Mz2), &Exp2, Numeric, Info) ;
+	if (s != UMFPACK_OK) error ("p1r2 det",0.) ;
+	Mx2 = Mx2 * pow (10.0, Exp2 - Exp) / pow (2.0, (double) n_row) ;
+	if (SCALAR_ABS (Mx2 - Mx) > 1e-10 * SCALAR_ABS (Mx)) error ("p1r2 det",0.) ;
+	s = UMFPACK_refactor (Ap, Ai, CARG(Ax,Az), (void *) NULL, &Numeric, Control, Info) ;
+	if (s != UMFPACK_ERROR_invalid_Symbolic_object) error ("p1r3",0.) ;
+	s = UMFPACK_refactor (Ap, Ai, CARG(Ax,Az), Symbolic, (void **) NULL, Control, Info) ;
+	if (s != UMFPACK_ERROR_argument_missing) error ("p1r4",0.) ;
+	c = Ai [1] ;
+	Ai [1] = -1 ;
+	s = UMFPACK_refactor (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	if (!Numeric || s != UMFPACK_ERROR_invalid_matrix) error ("p1r5",0.) ;
+	Ai [1] = c ;
+    }
+
+    /* refactorize with values perturbed by a different factor in each entry */
+    {
+	double *Axsave, rn ;
+
+	nz = Ap [n_col] ;
+	Axsave = (double *) malloc (2 * nz * sizeof (double)) ;	/* [ */
+	if (!Axsave) error ("out of memory (refactor)", 0.) ;
+	for (p = 0 ; p < nz ; p++)
+	{
+	    Axsave [p] = Ax [p] ;
+	    Ax [p] *= 1 + 0.02 * (xrand ( ) - 0.5) ;
+#ifdef COMPLEX
+	    Axsave [nz + p] = Az [p] ;
+	    Az [p] *= 1 + 0.02 * (xrand ( ) - 0.5) ;
+#endif
+	}
+	s = UMFPACK_refactor (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	if (!Numeric || s != UMFPACK_OK || Info [UMFPACK_REFACTORED] != 1) error ("p1f",0.) ;
+	rn = refactor_resid (n_row, Ap, Ai, Ax, Az, Numeric, Control) ;
+	printf ("refactor, perturbed values: resid %g\n", rn) ;
+	if (rn > 1e-12) error ("p1f resid", rn) ;
+	for (p = 0 ; p < nz ; p++)
+	{
+	    Ax [p] = Axsave [p] ;
+#ifdef COMPLEX
+	    Az [p] = Axsave [nz + p] ;
+#endif
+	}
+	free (Axsave) ;	/* ] */
+    }
+
+    /* make a prior pivot tiny, so that the pivot sequence fails the threshold
+     * test and refactor must factorize the matrix again.  A dense matrix has
+     * no singletons, so the first pivot is the entry A (P [0], Q [0]) itself
+     * (as scaled), and the rest of its column is the first column of L. */
+    {
+	double Dx [25], Dz [25], rn ;
+	Int Dp [6], Di [25], P1 [5], Q1 [5], piv ;
+	void *Dsymbolic, *Dnumeric ;
+
+	for (j = 0 ; j < 5 ; j++)
+	{
+	    Dp [j] = 5*j ;
+	    for (i = 0 ; i < 5 ; i++)
+	    {
+		Di [5*j+i] = i ;
+		Dx [5*j+i] = xrand ( ) + ((i == j) ? 4 : 0) ;
+		Dz [5*j+i] = xrand ( ) - 0.5 ;
+	    }
+	}
+	Dp [5] = 25 ;
+	s = UMFPACK_symbolic (5, 5, Dp, Di, CARG(Dx,Dz), &Dsymbolic, Control, Info) ;
+	if (!Dsymbolic || s != UMFPACK_OK) error ("p1g",0.) ;
+	s = UMFPACK_numeric (Dp, Di, CARG(Dx,Dz), Dsymbolic, &Dnumeric, Control, Info) ;
+	if (!Dnumeric || s != UMFPACK_OK) error ("p1g1",0.) ;
+	if (((NumericType *) Dnumeric)->n1 != 0) error ("p1g1 singletons",0.) ;
+	s = UMFPACK_get_numeric (INULL, INULL, CARG(DNULL,DNULL), INULL, INULL,
+	    CARG(DNULL,DNULL), P1, Q1, CARG(DNULL,DNULL), &do_recip, DNULL,
+	    Dnumeric) ;
+	if (s != UMFPACK_OK) error ("p1g2",0.) ;
+	piv = 5 * Q1 [0] + P1 [0] ;
+	Dx [piv] *= 1e-12 ;
+	Dz [piv] *= 1e-12 ;
+	s = UMFPACK_refactor (Dp, Di, CARG(Dx,Dz), Dsymbolic, &Dnumeric, Control, Info) ;
+	UMFPACK_report_info (Control, Info) ;
+	if (!Dnumeric || s != UMFPACK_OK || Info [UMFPACK_REFACTORED] != 0) error ("p1g3",0.) ;
+	rn = refactor_resid (5, Dp, Di, Dx, Dz, Dnumeric, Control) ;
+	printf ("refactor, tiny pivot: resid %g\n", rn) ;
+	if (rn > 1e-12) error ("p1g3 resid", rn) ;
+	/* the new pivot sequence can be reused */
+	s = UMFPACK_refactor (Dp, Di, CARG(Dx,Dz), Dsymbolic, &Dnumeric, Control, Info) ;
+	if (!Dnumeric || s != UMFPACK_OK || Info [UMFPACK_REFACTORED] != 1) error ("p1g4",0.) ;
+	rn = refactor_resid (5, Dp, Di, Dx, Dz, Dnumeric, Control) ;
+	if (rn > 1e-12) error ("p1g4 resid", rn) ;
+	UMFPACK_free_numeric (&Dnumeric) ;
+	UMFPACK_free_symbolic (&Dsymbolic) ;
+    }
+
+    /* refactorize from scratch, recycling the memory of the prior Numeric */
+    {
+	double Mx2, Mz2, Exp2, alloc_init ;
+	void *Bad ;
+	/* start with a tiny workspace, so that the first factorization must
+	 * reallocate it */
+	UMFPACK_free_numeric (&Numeric) ;
+	alloc_init = Control [UMFPACK_ALLOC_INIT] ;
+	Control [UMFPACK_ALLOC_INIT] = -1 ;
+	s = UMFPACK_renumeric (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	Control [UMFPACK_ALLOC_INIT] = alloc_init ;
+	UMFPACK_report_info (Control, Info) ;
+	if (!Numeric || s != UMFPACK_OK) error ("p1n",0.) ;
+	if (Info [UMFPACK_NUMERIC_REALLOC] <= 0) error ("p1n realloc",0.) ;
+	if (Info [UMFPACK_NUMERIC_DEFRAG_TIME] < 0) error ("p1n time",0.) ;
+	s = UMFPACK_get_determinant (CARG (&Mx, &Mz), &Exp, Numeric, Info) ;
+	if (s != UMFPACK_OK) error ("p1n det",0.) ;
+	for (k = 0 ; k < 3 ; k++)
+	{
+	    s = UMFPACK_renumeric (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	    if (!Numeric || s != UMFPACK_OK) error ("p1n2",0.) ;
+	    if (k > 0 && (Info [UMFPACK_NUMERIC_REALLOC] != 0 || Info [UMFPACK_NUMERIC_DEFRAG] != 0)) error ("p1n2 realloc",0.) ;
+	    s = UMFPACK_get_determinant (CARG (&Mx2, &Mz2), &Exp2, Numeric, Info) ;
+	    if (s != UMFPACK_OK) error ("p1n2 det",0.) ;
+	    Mx2 = Mx2 * pow (10.0, Exp2 - Exp) ;
+	    if (SCALAR_ABS (Mx2 - Mx) > 1e-10 * SCALAR_ABS (Mx)) error ("p1n2 det",0.) ;
+	}
+	/* the result can be refactorized, saved, and loaded */
+	s = UMFPACK_refactor (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	if (!Numeric || s != UMFPACK_OK || Info [UMFPACK_REFACTORED] != 1) error ("p1n3",0.) ;
+	s = UMFPACK_save_numeric (Numeric, "nr.umf") ;
+	if (s != UMFPACK_OK) error ("p1n4",0.) ;
+	UMFPACK_free_numeric (&Numeric) ;
+	s = UMFPACK_load_numeric (&Numeric, "nr.umf") ;
+	if (!Numeric || s != UMFPACK_OK) error ("p1n5",0.) ;
+	s = UMFPACK_renumeric (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	if (!Numeric || s != UMFPACK_OK) error ("p1n6",0.) ;
+	/* a Symbolic object is not a Numeric object, and is not freed */
+	Bad = Symbolic ;
+	s = UMFPACK_renumeric (Ap, Ai, CARG(Ax,Az), Symbolic, &Bad, Control, Info) ;
+	if (s != UMFPACK_ERROR_invalid_Numeric_object || Bad != Symbolic) error ("p1n7",0.) ;
+	s = UMFPACK_renumeric (Ap, Ai, CARG(Ax,Az), Symbolic, (void **) NULL, Control, Info) ;
+	if (s != UMFPACK_ERROR_argument_missing) error ("p1n8",0.) ;
+	/* the prior Numeric object is freed if the factorization fails */
+	s = UMFPACK_renumeric (Ap, Ai, CARG(Ax,Az), (void *) NULL, &Numeric, Control, Info) ;
+	if (Numeric || s != UMFPACK_ERROR_invalid_Symbolic_object) error ("p1n9",0.) ;
+	s = UMFPACK_renumeric (Ap, Ai, CARG(Ax,Az), Symbolic, &Numeric, Control, Info) ;
+	if (!Numeric || s != UMFPACK_OK) error ("p1n10",0.) ;
+    }
+
+#if defined (DINT) || defined (ZINT)
+    /* factorize in single precision, and refine in double precision */
+    {
+#ifdef DINT
+#define UMFPACK_S(name) umfpack_si_ ## name
+#else
+#define UMFPACK_S(name) umfpack_ci_ ## name
+#endif
+	void *Ssymbolic, *Snumeric ;
+	double Scontrol [UMFPACK_CONTROL], *xt, *bx, *bz, *xx, *xz, err ;
+	Int j, p ;
+	xt = (double *) malloc (4 * n_row * sizeof (double)) ;	/* [ */
+	xx = (double *) malloc (2 * n_row * sizeof (double)) ;	/* [ */
+	bx = (double *) malloc (2 * n_row * sizeof (double)) ;	/* [ */
+	if (!xt || !xx || !bx) error ("out of memory (single)", 0.) ;
+	xz = xx + n_row ;
+	bz = bx + n_row ;
+	/* b = A*xt */
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    xt [i] = 1 + (i % 3) ;
+	    xt [n_row + i] = (i % 2) - 0.5 ;
+	    bx [i] = 0 ;
+	    bz [i] = 0 ;
+	}
+	for (j = 0 ; j < n_col ; j++)
+	{
+	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	    {
+		bx [Ai [p]] += Ax [p] * xt [j] ;
+#ifdef COMPLEX
+		bx [Ai [p]] -= Az [p] * xt [n_row + j] ;
+		bz [Ai [p]] += Az [p] * xt [j] + Ax [p] * xt [n_row + j] ;
+#endif
+	    }
+	}
+	UMFPACK_S (defaults) (Scontrol) ;
+	Scontrol [UMFPACK_IRSTEP] = 10 ;
+	s = UMFPACK_S (symbolic) (n_row, n_col, Ap, Ai, CARG(Ax,Az), &Ssymbolic, Scontrol, Info) ;
+	if (!Ssymbolic || s != UMFPACK_OK) error ("single symbolic",0.) ;
+	s = UMFPACK_S (numeric) (Ap, Ai, CARG(Ax,Az), Ssymbolic, &Snumeric, Scontrol, Info) ;
+	UMFPACK_S (report_info) (Control, Info) ;
+	if (!Snumeric || s != UMFPACK_OK) error ("single numeric",0.) ;
+#ifdef COMPLEX
+	if (Info [UMFPACK_SIZE_OF_ENTRY] != 2 * sizeof (float)) error ("single Entry",0.) ;
+#else
+	if (Info [UMFPACK_SIZE_OF_ENTRY] != sizeof (float)) error ("single Entry",0.) ;
+#endif
+	/* a double precision Numeric object cannot be used */
+	s = UMFPACK_S (solve) (UMFPACK_A, Ap, Ai, CARG(Ax,Az), CARG(xx,xz), CARG(bx,bz), Numeric, Scontrol, Info) ;
+	if (s != UMFPACK_ERROR_invalid_Numeric_object) error ("single solve 1",0.) ;
+	s = UMFPACK_S (solve) (UMFPACK_A, Ap, Ai, CARG(Ax,Az), CARG(xx,xz), CARG(bx,bz), Snumeric, Scontrol, Info) ;
+	UMFPACK_S (report_info) (Control, Info) ;
+	if (s != UMFPACK_OK) error ("single solve 2",0.) ;
+	if (Info [UMFPACK_OMEGA1] + Info [UMFPACK_OMEGA2] > 1e-14) error ("single omega",Info [UMFPACK_OMEGA1]) ;
+	err = 0 ;
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    err = MAX (err, SCALAR_ABS (xx [i] - xt [i])) ;
+#ifdef COMPLEX
+	    err = MAX (err, SCALAR_ABS (xz [i] - xt [n_row + i])) ;
+#endif
+	}
+	printf ("single precision factorization, error %g\n", err) ;
+	if (err > 1e-10) error ("single error",err) ;
+	UMFPACK_S (free_numeric) (&Snumeric) ;
+	UMFPACK_S (free_symbolic) (&Ssymbolic) ;
+	free (bx) ;	/* ] */
+	free (xx) ;	/* ] */
+	free (xt) ;	/* ] */
+#undef UMFPACK_S
+    }
+#endif
     UMFPACK_free_numeric (&Numeric) ;
 
     /* corrupted Ap (negative degree) */
@@ -7528,6 +8164,9 @@ int main (int argc, char **argv)
 	printf ("\n]]]]\n\n\n") ;
     }
 
+    /* test triplet->col and transpose with more than one thread */
+    test_threads ( ) ;
+
     /* ---------------------------------------------------------------------- */
     /* reset rand ( ) */
     /* ---------------------------------------------------------------------- */
@@ -8,6 +8,11 @@
 \version\verbatim $Id: random.c 11793 2012-04-04 21:03:02Z karypis $ \endverbatim
 */
 
+/* SuiteSparse: random_r and initstate_r are glibc extensions */
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include <GKlib.h>
 
 
@@ -65,6 +70,45 @@ GK_MKRANDOM(gk_z,   size_t, ssize_t)
 static uint64_t mt[NN]; 
 /* mti==NN+1 means mt[NN] is not initialized */
 static int mti=NN+1; 
+#else
+
+/* -------------------------------------------------------------------------- */
+/* Added for SuiteSparse, so that METIS can be called from several threads at
+   once (CHOLMOD partitions independent subgraphs in parallel) with the same
+   results as when it is called from one thread.  The state of rand is shared
+   by all threads, so each thread gets its own generator instead.  With glibc,
+   random_r with a 128-byte state gives the same sequence as srand/rand. */
+#if defined(__GLIBC__)
+static __thread struct random_data gk_rdata;
+static __thread char gk_rstate[128];
+static __thread int gk_rinit = 0;
+
+static void gk_srand(unsigned int seed)
+{
+  memset(&gk_rdata, 0, sizeof(gk_rdata));
+  initstate_r(seed, gk_rstate, sizeof(gk_rstate), &gk_rdata);
+  gk_rinit = 1;
+}
+
+static int gk_rand(void)
+{
+  int32_t x;
+  if (!gk_rinit)
+    gk_srand(1);
+  random_r(&gk_rdata, &x);
+  return (int) x;
+}
+#elif defined(_WIN32)
+/* the state of rand is already private to each thread */
+#define gk_srand(seed) srand(seed)
+#define gk_rand() rand()
+#else
+static __thread unsigned int gk_rseed = 1;
+#define gk_srand(seed) (gk_rseed = (seed))
+#define gk_rand() rand_r(&gk_rseed)
+#endif
+/* -------------------------------------------------------------------------- */
+
 #endif /* USE_GKRAND */
 
 /* initializes mt[NN] with a seed */
@@ -75,7 +119,7 @@ void gk_randinit(uint64_t seed)
   for (mti=1; mti<NN; mti++) 
     mt[mti] = (6364136223846793005ULL * (mt[mti-1] ^ (mt[mti-1] >> 62)) + mti);
 #else
-  srand((unsigned int) seed);
+  gk_srand((unsigned int) seed);
 #endif
 }
 
@@ -117,7 +161,7 @@ uint64_t gk_randint64(void)
 
   return x & 0x7FFFFFFFFFFFFFFF;
 #else
-  return (uint64_t)(((uint64_t) rand()) << 32 | ((uint64_t) rand()));
+  return (uint64_t)(((uint64_t) gk_rand()) << 32 | ((uint64_t) gk_rand()));
 #endif
 }
 
@@ -127,7 +171,7 @@ uint32_t gk_randint32(void)
 #ifdef USE_GKRAND
   return (uint32_t)(gk_randint64() & 0x7FFFFFFF);
 #else
-  return (uint32_t)rand();
+  return (uint32_t)gk_rand();
 #endif
 }
 